@@ -0,0 +1,607 @@
+#include "Engine/Core/ConsoleCommandTable.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+//------------------------------------------------------------------------------------------------------------------
+// Argument text is copied here before handing it to the SetFromText/ato* parsers so nothing is allocated per token.
+constexpr int CONSOLE_ARG_PARSE_BUFFER_SIZE = 256;
+
+//------------------------------------------------------------------------------------------------------------------
+static bool IsConsoleWhitespace(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static char const* SkipConsoleWhitespace(char const* cursor, char const* end)
+{
+	while(cursor < end && IsConsoleWhitespace(*cursor))
+	{
+		++cursor;
+	}
+
+	return cursor;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Reads one key=value token starting at cursor. Values may be double quoted to contain spaces.
+// Returns the position after the token; out_valueStart is null for a bare key.
+static char const* ReadConsoleArgToken(char const* cursor, char const* end, char const*& out_keyStart, int& out_keyLength, char const*& out_valueStart, int& out_valueLength)
+{
+	out_keyStart = cursor;
+	out_valueStart = nullptr;
+	out_valueLength = 0;
+
+	while(cursor < end && *cursor != '=' && !IsConsoleWhitespace(*cursor))
+	{
+		++cursor;
+	}
+
+	out_keyLength = static_cast<int>(cursor - out_keyStart);
+
+	if(cursor >= end || *cursor != '=')
+	{
+		return cursor;
+	}
+
+	++cursor;
+
+	if(cursor < end && *cursor == '"')
+	{
+		++cursor;
+		out_valueStart = cursor;
+
+		while(cursor < end && *cursor != '"')
+		{
+			++cursor;
+		}
+
+		out_valueLength = static_cast<int>(cursor - out_valueStart);
+
+		return cursor < end ? cursor + 1 : cursor;
+	}
+
+	out_valueStart = cursor;
+
+	while(cursor < end && !IsConsoleWhitespace(*cursor))
+	{
+		++cursor;
+	}
+
+	out_valueLength = static_cast<int>(cursor - out_valueStart);
+
+	return cursor;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int ConsoleCommandArgs::GetNumArgs() const
+{
+	return m_numValues;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool ConsoleCommandArgs::IsSet(int slot) const
+{
+	GUARANTEE_OR_DIE(slot >= 0 && slot < m_numValues, "Console command argument slot out of range");
+
+	return m_values[slot].m_isSet;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+ConsoleArgValue const& ConsoleCommandArgs::GetValue(int slot, ConsoleArgType type) const
+{
+	GUARANTEE_OR_DIE(slot >= 0 && slot < m_numValues, "Console command argument slot out of range");
+	GUARANTEE_OR_DIE(m_values[slot].m_type == type, Stringf("Console command argument %d is %s, not %s", slot, GetConsoleArgTypeName(m_values[slot].m_type), GetConsoleArgTypeName(type)));
+
+	return m_values[slot];
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool ConsoleCommandArgs::GetBool(int slot) const
+{
+	return GetValue(slot, ConsoleArgType::BOOL).m_bool;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int ConsoleCommandArgs::GetInt(int slot) const
+{
+	return GetValue(slot, ConsoleArgType::INT).m_int;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+float ConsoleCommandArgs::GetFloat(int slot) const
+{
+	return GetValue(slot, ConsoleArgType::FLOAT).m_float;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+Vec2 ConsoleCommandArgs::GetVec2(int slot) const
+{
+	Vec3 const& value = GetValue(slot, ConsoleArgType::VEC2).m_vec3;
+
+	return Vec2(value.x, value.y);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+Vec3 ConsoleCommandArgs::GetVec3(int slot) const
+{
+	return GetValue(slot, ConsoleArgType::VEC3).m_vec3;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+Rgba8 ConsoleCommandArgs::GetColor(int slot) const
+{
+	return GetValue(slot, ConsoleArgType::RGBA8).m_color;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+std::string const& ConsoleCommandArgs::GetString(int slot) const
+{
+	static const std::string s_emptyString;
+
+	ConsoleArgValue const& value = GetValue(slot, ConsoleArgType::STRING);
+
+	if(value.m_stringIndex < 0)
+	{
+		return s_emptyString;
+	}
+
+	return (*m_strings)[value.m_stringIndex];
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void ConsoleScript::Clear()
+{
+	m_commands.clear();
+	m_argValues.clear();
+	m_strings.clear();
+	m_eventNames.clear();
+	m_eventArgs.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool ConsoleScript::IsEmpty() const
+{
+	return m_commands.empty();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int ConsoleScript::GetNumCommands() const
+{
+	return static_cast<int>(m_commands.size());
+}
+
+//------------------------------------------------------------------------------------------------------------------
+ConsoleCommandId ConsoleCommandTable::RegisterCommand(std::string const& name, ConsoleCommandFunction function, std::vector<ConsoleArgDefinition> const& argDefinitions, std::string const& description)
+{
+	if(!function)
+	{
+		ERROR_AND_DIE("Invalid Function Pointer when registering a console command");
+	}
+
+	ConsoleCommandId commandId = FindCommandId(name);
+
+	if(commandId == INVALID_CONSOLE_COMMAND_ID)
+	{
+		commandId = static_cast<ConsoleCommandId>(m_commands.size());
+		m_commands.emplace_back();
+		m_commandIdsByName[name] = commandId;
+	}
+
+	ConsoleCommandDefinition& definition = m_commands[commandId];
+	definition.m_name = name;
+	definition.m_description = description;
+	definition.m_function = function;
+	definition.m_argDefinitions = argDefinitions;
+	definition.m_defaultValues.clear();
+
+	// defaults are parsed once here; string defaults keep their text in the definition itself
+	for(int slot = 0; slot < static_cast<int>(argDefinitions.size()); ++slot)
+	{
+		ConsoleArgDefinition const& argDefinition = argDefinitions[slot];
+
+		ConsoleArgValue defaultValue;
+		defaultValue.m_type = argDefinition.m_type;
+
+		if(!argDefinition.m_defaultText.empty() && argDefinition.m_type != ConsoleArgType::STRING)
+		{
+			std::vector<std::string> unusedStringPool;
+
+			if(!ParseConsoleArgValue(argDefinition.m_type, argDefinition.m_defaultText.c_str(), static_cast<int>(argDefinition.m_defaultText.length()), defaultValue, unusedStringPool))
+			{
+				ERROR_RECOVERABLE(Stringf("Console command '%s' has an invalid default for '%s'", name.c_str(), argDefinition.m_name.c_str()));
+			}
+
+			defaultValue.m_isSet = false;
+		}
+
+		definition.m_defaultValues.push_back(defaultValue);
+	}
+
+	return commandId;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void ConsoleCommandTable::UnregisterCommand(std::string const& name)
+{
+	auto result = m_commandIdsByName.find(name);
+
+	if(result == m_commandIdsByName.end())
+	{
+		return;
+	}
+
+	// ids stay stable for scripts that were already compiled; the slot just stops resolving
+	m_commands[result->second].m_function = nullptr;
+	m_commandIdsByName.erase(result);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+ConsoleCommandId ConsoleCommandTable::FindCommandId(char const* name, int nameLength) const
+{
+	for(int commandId = 0; commandId < static_cast<int>(m_commands.size()); ++commandId)
+	{
+		ConsoleCommandDefinition const& definition = m_commands[commandId];
+
+		if(definition.m_function && static_cast<int>(definition.m_name.length()) == nameLength && memcmp(definition.m_name.data(), name, nameLength) == 0)
+		{
+			return commandId;
+		}
+	}
+
+	return INVALID_CONSOLE_COMMAND_ID;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+ConsoleCommandId ConsoleCommandTable::FindCommandId(std::string const& name) const
+{
+	auto result = m_commandIdsByName.find(name);
+
+	if(result == m_commandIdsByName.end())
+	{
+		return INVALID_CONSOLE_COMMAND_ID;
+	}
+
+	return result->second;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+ConsoleCommandDefinition const* ConsoleCommandTable::GetCommandDefinition(ConsoleCommandId commandId) const
+{
+	if(commandId < 0 || commandId >= static_cast<int>(m_commands.size()) || !m_commands[commandId].m_function)
+	{
+		return nullptr;
+	}
+
+	return &m_commands[commandId];
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int ConsoleCommandTable::GetNumCommands() const
+{
+	return static_cast<int>(m_commands.size());
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int ConsoleCommandTable::FindArgSlot(ConsoleCommandDefinition const& definition, char const* name, int nameLength) const
+{
+	for(int slot = 0; slot < static_cast<int>(definition.m_argDefinitions.size()); ++slot)
+	{
+		std::string const& argName = definition.m_argDefinitions[slot].m_name;
+
+		if(static_cast<int>(argName.length()) == nameLength && memcmp(argName.data(), name, nameLength) == 0)
+		{
+			return slot;
+		}
+	}
+
+	return -1;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool ConsoleCommandTable::Compile(std::string const& scriptText, ConsoleScript& out_script, Strings& out_errors) const
+{
+	bool wasSuccessful = true;
+
+	char const* cursor = scriptText.data();
+	char const* scriptEnd = cursor + scriptText.length();
+
+	while(cursor < scriptEnd)
+	{
+		char const* lineStart = cursor;
+		char const* lineEnd = static_cast<char const*>(memchr(cursor, '\n', scriptEnd - cursor));
+
+		if(!lineEnd)
+		{
+			lineEnd = scriptEnd;
+		}
+
+		cursor = lineEnd + 1;
+
+		char const* nameStart = SkipConsoleWhitespace(lineStart, lineEnd);
+
+		// blank lines and # comments
+		if(nameStart == lineEnd || *nameStart == '#')
+		{
+			continue;
+		}
+
+		char const* nameEnd = nameStart;
+
+		while(nameEnd < lineEnd && !IsConsoleWhitespace(*nameEnd))
+		{
+			++nameEnd;
+		}
+
+		int nameLength = static_cast<int>(nameEnd - nameStart);
+
+		ConsoleCommandId commandId = FindCommandId(nameStart, nameLength);
+
+		if(commandId == INVALID_CONSOLE_COMMAND_ID)
+		{
+			CompileEventLine(nameStart, nameLength, nameEnd, lineEnd, out_script);
+		}
+		else if(!CompileCommandLine(commandId, nameStart, lineEnd, nameEnd, out_script, out_errors))
+		{
+			wasSuccessful = false;
+		}
+	}
+
+	return wasSuccessful;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool ConsoleCommandTable::CompileCommandLine(ConsoleCommandId commandId, char const* lineStart, char const* lineEnd, char const* argsStart, ConsoleScript& out_script, Strings& out_errors) const
+{
+	ConsoleCommandDefinition const& definition = m_commands[commandId];
+
+	int numArgs = static_cast<int>(definition.m_argDefinitions.size());
+	int firstArgIndex = static_cast<int>(out_script.m_argValues.size());
+	int firstStringIndex = static_cast<int>(out_script.m_strings.size());
+
+	out_script.m_argValues.insert(out_script.m_argValues.end(), definition.m_defaultValues.begin(), definition.m_defaultValues.end());
+
+	ConsoleArgValue* argValues = out_script.m_argValues.data() + firstArgIndex;
+
+	std::string errorText;
+	char const* cursor = SkipConsoleWhitespace(argsStart, lineEnd);
+
+	while(cursor < lineEnd && errorText.empty())
+	{
+		char const* keyStart = nullptr;
+		char const* valueStart = nullptr;
+		int keyLength = 0;
+		int valueLength = 0;
+
+		cursor = ReadConsoleArgToken(cursor, lineEnd, keyStart, keyLength, valueStart, valueLength);
+		cursor = SkipConsoleWhitespace(cursor, lineEnd);
+
+		int slot = FindArgSlot(definition, keyStart, keyLength);
+
+		if(slot < 0)
+		{
+			errorText = Stringf("'%s' has no argument '%.*s'", definition.m_name.c_str(), keyLength, keyStart);
+		}
+		else if(!valueStart)
+		{
+			// a bare key sets a bool argument to true
+			if(definition.m_argDefinitions[slot].m_type == ConsoleArgType::BOOL)
+			{
+				argValues[slot].m_bool = true;
+				argValues[slot].m_isSet = true;
+			}
+			else
+			{
+				errorText = Stringf("'%s' argument '%.*s' needs a value", definition.m_name.c_str(), keyLength, keyStart);
+			}
+		}
+		else if(!ParseConsoleArgValue(definition.m_argDefinitions[slot].m_type, valueStart, valueLength, argValues[slot], out_script.m_strings))
+		{
+			errorText = Stringf("'%s' argument '%.*s' expects %s, got '%.*s'", definition.m_name.c_str(), keyLength, keyStart,
+								GetConsoleArgTypeName(definition.m_argDefinitions[slot].m_type), valueLength, valueStart);
+		}
+	}
+
+	for(int slot = 0; slot < numArgs && errorText.empty(); ++slot)
+	{
+		ConsoleArgDefinition const& argDefinition = definition.m_argDefinitions[slot];
+
+		if(argValues[slot].m_isSet)
+		{
+			continue;
+		}
+
+		if(argDefinition.m_isRequired)
+		{
+			errorText = Stringf("'%s' is missing required argument '%s'", definition.m_name.c_str(), argDefinition.m_name.c_str());
+		}
+		else if(argDefinition.m_type == ConsoleArgType::STRING && !argDefinition.m_defaultText.empty())
+		{
+			argValues[slot].m_stringIndex = static_cast<int>(out_script.m_strings.size());
+			out_script.m_strings.push_back(argDefinition.m_defaultText);
+		}
+	}
+
+	if(!errorText.empty())
+	{
+		out_errors.push_back(Stringf("%s (in \"%.*s\")", errorText.c_str(), static_cast<int>(lineEnd - lineStart), lineStart));
+
+		out_script.m_argValues.resize(firstArgIndex);
+		out_script.m_strings.resize(firstStringIndex);
+		return false;
+	}
+
+	ConsoleScriptCommand command;
+	command.m_commandId = commandId;
+	command.m_firstArgIndex = firstArgIndex;
+	command.m_numArgs = numArgs;
+
+	out_script.m_commands.push_back(command);
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void ConsoleCommandTable::CompileEventLine(char const* nameStart, int nameLength, char const* argsStart, char const* lineEnd, ConsoleScript& out_script) const
+{
+	ConsoleScriptCommand command;
+	command.m_eventIndex = static_cast<int>(out_script.m_eventNames.size());
+
+	out_script.m_eventNames.emplace_back(nameStart, nameLength);
+	out_script.m_eventArgs.emplace_back();
+
+	EventArgs& args = out_script.m_eventArgs.back();
+	char const* cursor = SkipConsoleWhitespace(argsStart, lineEnd);
+
+	while(cursor < lineEnd)
+	{
+		char const* keyStart = nullptr;
+		char const* valueStart = nullptr;
+		int keyLength = 0;
+		int valueLength = 0;
+
+		cursor = ReadConsoleArgToken(cursor, lineEnd, keyStart, keyLength, valueStart, valueLength);
+		cursor = SkipConsoleWhitespace(cursor, lineEnd);
+
+		args.SetValue(std::string(keyStart, keyLength), valueStart ? std::string(valueStart, valueLength) : std::string("true"));
+	}
+
+	out_script.m_commands.push_back(command);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void ConsoleCommandTable::Execute(ConsoleScript const& script) const
+{
+	for(int commandIndex = 0; commandIndex < static_cast<int>(script.m_commands.size()); ++commandIndex)
+	{
+		ConsoleScriptCommand const& command = script.m_commands[commandIndex];
+
+		if(command.m_eventIndex >= 0)
+		{
+			// event handlers take mutable args, so each firing gets its own copy of the prebuilt set
+			EventArgs args = script.m_eventArgs[command.m_eventIndex];
+			FireEvent(script.m_eventNames[command.m_eventIndex], args);
+			continue;
+		}
+
+		ConsoleCommandDefinition const* definition = GetCommandDefinition(command.m_commandId);
+
+		if(!definition)
+		{
+			continue;
+		}
+
+		ConsoleCommandArgs args;
+		args.m_values = script.m_argValues.data() + command.m_firstArgIndex;
+		args.m_numValues = command.m_numArgs;
+		args.m_strings = &script.m_strings;
+
+		definition->m_function(args);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+char const* GetConsoleArgTypeName(ConsoleArgType type)
+{
+	switch(type)
+	{
+		case ConsoleArgType::STRING:	return "string";
+		case ConsoleArgType::BOOL:		return "bool";
+		case ConsoleArgType::INT:		return "int";
+		case ConsoleArgType::FLOAT:		return "float";
+		case ConsoleArgType::VEC2:		return "Vec2";
+		case ConsoleArgType::VEC3:		return "Vec3";
+		case ConsoleArgType::RGBA8:		return "Rgba8";
+		default:						return "unknown";
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool ParseConsoleArgValue(ConsoleArgType type, char const* text, int textLength, ConsoleArgValue& out_value, std::vector<std::string>& stringPool)
+{
+	out_value.m_type = type;
+
+	if(type == ConsoleArgType::STRING)
+	{
+		out_value.m_stringIndex = static_cast<int>(stringPool.size());
+		out_value.m_isSet = true;
+		stringPool.emplace_back(text, textLength);
+		return true;
+	}
+
+	if(textLength <= 0 || textLength >= CONSOLE_ARG_PARSE_BUFFER_SIZE)
+	{
+		return false;
+	}
+
+	char buffer[CONSOLE_ARG_PARSE_BUFFER_SIZE];
+	memcpy(buffer, text, textLength);
+	buffer[textLength] = '\0';
+
+	char* parseEnd = nullptr;
+
+	switch(type)
+	{
+		case ConsoleArgType::BOOL:
+		{
+			if(strcmp(buffer, "true") == 0 || strcmp(buffer, "1") == 0)
+			{
+				out_value.m_bool = true;
+			}
+			else if(strcmp(buffer, "false") == 0 || strcmp(buffer, "0") == 0)
+			{
+				out_value.m_bool = false;
+			}
+			else
+			{
+				return false;
+			}
+			break;
+		}
+		case ConsoleArgType::INT:
+		{
+			out_value.m_int = static_cast<int>(strtol(buffer, &parseEnd, 10));
+
+			if(parseEnd != buffer + textLength)
+			{
+				return false;
+			}
+			break;
+		}
+		case ConsoleArgType::FLOAT:
+		{
+			out_value.m_float = strtof(buffer, &parseEnd);
+
+			if(parseEnd != buffer + textLength)
+			{
+				return false;
+			}
+			break;
+		}
+		case ConsoleArgType::VEC2:
+		{
+			Vec2 value;
+			value.SetFromText(buffer);
+			out_value.m_vec3 = Vec3(value.x, value.y, 0.f);
+			break;
+		}
+		case ConsoleArgType::VEC3:
+		{
+			out_value.m_vec3.SetFromText(buffer);
+			break;
+		}
+		case ConsoleArgType::RGBA8:
+		{
+			out_value.m_color.SetFromText(buffer);
+			break;
+		}
+		default:
+			return false;
+	}
+
+	out_value.m_isSet = true;
+	return true;
+}
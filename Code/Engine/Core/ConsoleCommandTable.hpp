@@ -0,0 +1,153 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------
+class ConsoleCommandArgs;
+
+typedef int ConsoleCommandId;
+typedef bool (*ConsoleCommandFunction)(ConsoleCommandArgs const& args);
+
+constexpr ConsoleCommandId INVALID_CONSOLE_COMMAND_ID = -1;
+
+//------------------------------------------------------------------------------------------------------------------
+enum class ConsoleArgType : unsigned char
+{
+	STRING,
+	BOOL,
+	INT,
+	FLOAT,
+	VEC2,
+	VEC3,
+	RGBA8
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// One named argument in a command schema. An empty default text on a required argument means it must be supplied.
+struct ConsoleArgDefinition
+{
+	std::string		m_name;
+	ConsoleArgType	m_type = ConsoleArgType::STRING;
+	std::string		m_defaultText;
+	bool			m_isRequired = false;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Parsed once at compile time. Strings live in the owning script's string pool and are referenced by index.
+struct ConsoleArgValue
+{
+	ConsoleArgType	m_type = ConsoleArgType::STRING;
+	bool			m_isSet = false;
+	bool			m_bool = false;
+	int				m_int = 0;
+	float			m_float = 0.f;
+	Vec3			m_vec3 = Vec3(0.f, 0.f, 0.f);
+	Rgba8			m_color = Rgba8::WHITE;
+	int				m_stringIndex = -1;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct ConsoleCommandDefinition
+{
+	std::string							m_name;
+	std::string							m_description;
+	ConsoleCommandFunction				m_function = nullptr;
+	std::vector<ConsoleArgDefinition>	m_argDefinitions;
+	std::vector<ConsoleArgValue>		m_defaultValues;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// What a command handler sees. Arguments are addressed by their slot in the command's schema, so handlers never look
+// anything up by name.
+class ConsoleCommandArgs
+{
+	friend class ConsoleCommandTable;
+
+public:
+	int					GetNumArgs() const;
+	bool				IsSet(int slot) const;
+
+	bool				GetBool(int slot) const;
+	int					GetInt(int slot) const;
+	float				GetFloat(int slot) const;
+	Vec2				GetVec2(int slot) const;
+	Vec3				GetVec3(int slot) const;
+	Rgba8				GetColor(int slot) const;
+	std::string const&	GetString(int slot) const;
+
+private:
+	ConsoleArgValue const&	GetValue(int slot, ConsoleArgType type) const;
+
+private:
+	ConsoleArgValue const*			m_values = nullptr;
+	int								m_numValues = 0;
+	std::vector<std::string> const*	m_strings = nullptr;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct ConsoleScriptCommand
+{
+	ConsoleCommandId	m_commandId = INVALID_CONSOLE_COMMAND_ID;
+	int					m_firstArgIndex = 0;
+	int					m_numArgs = 0;
+	int					m_eventIndex = -1;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// A console script compiled into a flat command list. Compile once, execute as many times as needed.
+// Lines naming a registered command are fully parsed and typed; any other line becomes a prebuilt event fired through
+// the EventSystem, so existing event commands keep working.
+class ConsoleScript
+{
+	friend class ConsoleCommandTable;
+
+public:
+	void	Clear();
+	bool	IsEmpty() const;
+	int		GetNumCommands() const;
+
+private:
+	std::vector<ConsoleScriptCommand>	m_commands;
+	std::vector<ConsoleArgValue>		m_argValues;
+	std::vector<std::string>			m_strings;
+	std::vector<std::string>			m_eventNames;
+	std::vector<EventArgs>				m_eventArgs;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+class ConsoleCommandTable
+{
+public:
+	ConsoleCommandId	RegisterCommand(std::string const& name, ConsoleCommandFunction function, std::vector<ConsoleArgDefinition> const& argDefinitions = {}, std::string const& description = "");
+	void				UnregisterCommand(std::string const& name);
+
+	ConsoleCommandId					FindCommandId(char const* name, int nameLength) const;
+	ConsoleCommandId					FindCommandId(std::string const& name) const;
+	ConsoleCommandDefinition const*		GetCommandDefinition(ConsoleCommandId commandId) const;
+	int									GetNumCommands() const;
+
+	// Returns false if any line failed to compile. Failed lines are left out of the script and described in out_errors.
+	bool	Compile(std::string const& scriptText, ConsoleScript& out_script, Strings& out_errors) const;
+	void	Execute(ConsoleScript const& script) const;
+
+private:
+	int		FindArgSlot(ConsoleCommandDefinition const& definition, char const* name, int nameLength) const;
+	bool	CompileCommandLine(ConsoleCommandId commandId, char const* lineStart, char const* lineEnd, char const* argsStart, ConsoleScript& out_script, Strings& out_errors) const;
+	void	CompileEventLine(char const* nameStart, int nameLength, char const* argsStart, char const* lineEnd, ConsoleScript& out_script) const;
+
+private:
+	std::vector<ConsoleCommandDefinition>				m_commands;
+	std::unordered_map<std::string, ConsoleCommandId>	m_commandIdsByName;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+char const*	GetConsoleArgTypeName(ConsoleArgType type);
+bool		ParseConsoleArgValue(ConsoleArgType type, char const* text, int textLength, ConsoleArgValue& out_value, std::vector<std::string>& stringPool);
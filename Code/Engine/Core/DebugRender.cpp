@@ -18,9 +18,11 @@
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Renderer/PipelineStateObject.hpp"
 #include "Engine/Renderer/RendererUtils.hpp"
+#include "Engine/Renderer/TextMeshCache.hpp"
 
 #include "Game/EngineBuildPreferences.hpp"
 
+#include <cfloat>
 #include <mutex>
 
 #if defined(OPAQUE)
@@ -30,719 +32,662 @@
 std::recursive_mutex g_debugMutex;
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
-struct DebugWorldObject
+// Shapes share one tessellated unit mesh each and only store a model transform. CUSTOM objects (text) keep their own verts.
+enum class DebugMeshType : unsigned char
 {
-	std::vector<Vertex_PCU> m_verts;
-
-	Vec3	m_position				= Vec3(0.f, 0.f, 0.f);
-	Mat44	m_transform				= Mat44();
-
-	Rgba8	m_startColor			= Rgba8::WHITE;
-	Rgba8	m_endColor				= Rgba8::WHITE;
-
-	Timer	m_timer;
-	float	m_duration				= 0.f;
-
-	bool	m_isText				= false;
-	bool	m_isBillboarded			= false;
-
-	DebugRenderMode m_mode			= DebugRenderMode::USE_DEPTH;
-	RasterizerMode	m_rasterMode	= RasterizerMode::SOLID_CULL_BACK;
-
-	Texture* m_texture				= nullptr;
-#if defined (USING_DX12)
-	PipelineStateObject* m_debugObjPipelineState = nullptr;
-#endif
-
+	CUSTOM,
+	UNIT_SPHERE,
+	UNIT_BOX,
+	UNIT_CYLINDER,
+	UNIT_ARROW,
+	UNIT_WIREFRAME_ARROW,
+
+	COUNT
 };
 
-struct DebugScreenObject
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// World objects stored column-wise; index i across every column is one object. Objects are unordered, so removal is a
+// swap with the last element and a pop. Expiry only touches m_expiryTimes.
+struct DebugWorldObjectList
 {
-	std::vector<Vertex_PCU> m_verts;
-
-	std::string m_text;
-
-	Rgba8		m_startColor	= Rgba8::WHITE;
-	Rgba8		m_endColor		= Rgba8::WHITE;
-
-	Timer		m_timer;
-	float		m_duration		= 0.f;
+	std::vector<DebugMeshType>				m_meshTypes;
+	std::vector<Mat44>						m_transforms;
+	std::vector<Vec3>						m_billboardPositions;
+	std::vector<Rgba8>						m_startColors;
+	std::vector<Rgba8>						m_endColors;
+	std::vector<double>						m_startTimes;
+	std::vector<double>						m_expiryTimes;
+	std::vector<float>						m_durations;
+	std::vector<DebugRenderMode>			m_modes;
+	std::vector<RasterizerMode>				m_rasterModes;
+	std::vector<Texture*>					m_textures;
+	std::vector<unsigned char>				m_isBillboarded;
+	std::vector<std::vector<Vertex_PCU>>	m_customVerts;
+
+	int		GetCount() const { return static_cast<int>(m_meshTypes.size()); }
+	int		Add(DebugMeshType meshType, Mat44 const& transform, float duration, Rgba8 const& startColor, Rgba8 const& endColor, DebugRenderMode mode, RasterizerMode rasterMode);
+	void	SwapRemove(int index);
+	void	RemoveExpired(double currentTime);
+	void	Clear();
+};
 
-	Texture*	m_texture		= nullptr;
-#if defined (USING_DX12)
-	PipelineStateObject* m_debugObjPipelineState = nullptr;
-#endif
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Screen objects and messages. Messages stack in insertion order, so their lists compact in order instead of swapping.
+struct DebugScreenObjectList
+{
+	std::vector<Rgba8>						m_startColors;
+	std::vector<Rgba8>						m_endColors;
+	std::vector<double>						m_startTimes;
+	std::vector<double>						m_expiryTimes;
+	std::vector<float>						m_durations;
+	std::vector<Texture*>					m_textures;
+	std::vector<std::vector<Vertex_PCU>>	m_verts;
+
+	int		GetCount() const { return static_cast<int>(m_startColors.size()); }
+	int		Add(float duration, Rgba8 const& startColor, Rgba8 const& endColor, Texture* texture);
+	void	SwapRemove(int index);
+	void	RemoveExpired(double currentTime, bool keepOrder);
+	void	Clear();
+
+private:
+	void	MoveElement(int fromIndex, int toIndex);
+	void	Resize(int newCount);
+};
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Everything drawn with the same state is merged into one vertex stream per frame. Batches (and their vertex capacity)
+// persist across frames, so a steady debug scene stops allocating after the first frame.
+// Zero-duration (every-frame) world objects keep their own batches: on DX11 they have always drawn alpha blended, with a
+// depth tested X_RAY fade, and they draw before the timed objects.
+struct DebugRenderBatch
+{
+	DebugRenderMode			m_mode			= DebugRenderMode::USE_DEPTH;
+	RasterizerMode			m_rasterMode	= RasterizerMode::SOLID_CULL_BACK;
+	Texture*				m_texture		= nullptr;
+	bool					m_isEveryFrame	= false;
+	std::vector<Vertex_PCU>	m_verts;
 };
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
 DegbugRenderConfig m_debugRenderConfig;
 
-std::vector<DebugWorldObject> m_debugWorldObjects;
-std::vector<DebugWorldObject> m_debugWorldObjectsEveryframe;
-std::vector<DebugScreenObject> m_debugScreenObjects;
+DebugWorldObjectList m_debugWorldObjects;
+DebugScreenObjectList m_debugScreenObjects;
 
-std::vector<DebugScreenObject> m_debugScreenFiniteMessages;
-std::vector<DebugScreenObject> m_debugScreenMessagesEveryFrame;
-std::vector<DebugScreenObject> m_debugScreenInfiniteMessages;
+DebugScreenObjectList m_debugScreenFiniteMessages;
+DebugScreenObjectList m_debugScreenMessagesEveryFrame;
+DebugScreenObjectList m_debugScreenInfiniteMessages;
 
 
 bool m_shouldRender = true;
 
-//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void DebugRenderSystemStartup(DegbugRenderConfig& config)
-{
-	m_debugRenderConfig.m_renderer = config.m_renderer;
-	m_debugRenderConfig.m_fontName = config.m_fontName;
-
-	m_debugRenderConfig.m_renderer->CreateOrGetBitmapFontWithFontName(m_debugRenderConfig.m_fontName);
-
-	SubscribeEventCallbackFunction("debugrenderclear", OnDebugRenderClear);
-	SubscribeEventCallbackFunction("debugrendertoggle", OnDebugRenderToggle);
+// every-frame messages re-add the same strings each frame, so their glyph quads are reused instead of re-laid out
+static TextMeshCache s_debugTextMeshCache;
 
-#if defined(USING_DX12)
-//	s_ringBuffer = m_debugRenderConfig.m_renderer->CreateOrGetRingBuffer("DebugRenderSystem", 16 * 1024 * 1024);
-#endif
+static std::vector<Vertex_PCU>			s_debugUnitMeshes[static_cast<int>(DebugMeshType::COUNT)];
+static std::vector<DebugRenderBatch>	s_debugWorldBatches;
+static std::vector<DebugRenderBatch>	s_debugScreenBatches;
+static std::vector<Vertex_PCU>			s_debugXRayVerts;
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static double GetDebugRenderTime()
+{
+	return Clock::GetSystemClock().GetTotalSeconds();
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void DebugRenderSystemShutdown()
+// Negative durations never expire. A zero duration lives until the next DebugRenderBeginFrame after the clock advances.
+static double GetDebugExpiryTime(double startTime, float duration)
 {
-	
-	UnsubscribeEventCallbackFunction("debugrendertoggle", OnDebugRenderToggle);
-	UnsubscribeEventCallbackFunction("debugrenderclear", OnDebugRenderClear);
-
-	m_debugWorldObjects.clear();
-	m_debugWorldObjectsEveryframe.clear();
-	m_debugScreenObjects.clear();
-
-	m_debugScreenFiniteMessages.clear();
-	m_debugScreenMessagesEveryFrame.clear();
-	m_debugScreenInfiniteMessages.clear();
+	if(duration < 0.f)
+	{
+		return DBL_MAX;
+	}
 
-	delete m_debugRenderConfig.m_renderer;
-	m_debugRenderConfig.m_renderer = nullptr;
+	return startTime + static_cast<double>(duration);
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void DebugRenderSetVisible()
+int DebugWorldObjectList::Add(DebugMeshType meshType, Mat44 const& transform, float duration, Rgba8 const& startColor, Rgba8 const& endColor, DebugRenderMode mode, RasterizerMode rasterMode)
 {
-	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
-
-	m_shouldRender = true;
+	double startTime = GetDebugRenderTime();
+
+	m_meshTypes.push_back(meshType);
+	m_transforms.push_back(transform);
+	m_billboardPositions.push_back(Vec3(0.f, 0.f, 0.f));
+	m_startColors.push_back(startColor);
+	m_endColors.push_back(endColor);
+	m_startTimes.push_back(startTime);
+	m_expiryTimes.push_back(GetDebugExpiryTime(startTime, duration));
+	m_durations.push_back(duration);
+	m_modes.push_back(mode);
+	m_rasterModes.push_back(rasterMode);
+	m_textures.push_back(nullptr);
+	m_isBillboarded.push_back(0);
+	m_customVerts.emplace_back();
+
+	return GetCount() - 1;
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void DebugRenderSetHidden()
+void DebugWorldObjectList::SwapRemove(int index)
 {
-	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
-	m_shouldRender = false;
+	int lastIndex = GetCount() - 1;
+
+	if(index != lastIndex)
+	{
+		m_meshTypes[index]			= m_meshTypes[lastIndex];
+		m_transforms[index]			= m_transforms[lastIndex];
+		m_billboardPositions[index]	= m_billboardPositions[lastIndex];
+		m_startColors[index]		= m_startColors[lastIndex];
+		m_endColors[index]			= m_endColors[lastIndex];
+		m_startTimes[index]			= m_startTimes[lastIndex];
+		m_expiryTimes[index]		= m_expiryTimes[lastIndex];
+		m_durations[index]			= m_durations[lastIndex];
+		m_modes[index]				= m_modes[lastIndex];
+		m_rasterModes[index]		= m_rasterModes[lastIndex];
+		m_textures[index]			= m_textures[lastIndex];
+		m_isBillboarded[index]		= m_isBillboarded[lastIndex];
+		m_customVerts[index].swap(m_customVerts[lastIndex]);
+	}
+
+	m_meshTypes.pop_back();
+	m_transforms.pop_back();
+	m_billboardPositions.pop_back();
+	m_startColors.pop_back();
+	m_endColors.pop_back();
+	m_startTimes.pop_back();
+	m_expiryTimes.pop_back();
+	m_durations.pop_back();
+	m_modes.pop_back();
+	m_rasterModes.pop_back();
+	m_textures.pop_back();
+	m_isBillboarded.pop_back();
+	m_customVerts.pop_back();
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void DebugRenderClear()
+void DebugWorldObjectList::RemoveExpired(double currentTime)
 {
-	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
-	m_debugWorldObjects.clear();
-	m_debugWorldObjectsEveryframe.clear();
-	m_debugScreenObjects.clear();
-
-	m_debugScreenFiniteMessages.clear();
-	m_debugScreenMessagesEveryFrame.clear();
-	m_debugScreenInfiniteMessages.clear();
+	// walk backwards so the element swapped into a removed slot has already been tested
+	for(int index = GetCount() - 1; index >= 0; --index)
+	{
+		if(currentTime > m_expiryTimes[index])
+		{
+			SwapRemove(index);
+		}
+	}
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void DebugRenderBeginFrame()
+void DebugWorldObjectList::Clear()
 {
-	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
-
-	auto worldObjRemoveStartIterator = std::remove_if(m_debugWorldObjects.begin(), m_debugWorldObjects.end(),
-													  [](DebugWorldObject& obj) -> bool { return (obj.m_duration >= 0.f && obj.m_timer.HasPeriodElapsed()); });
-
-	m_debugWorldObjects.erase(worldObjRemoveStartIterator, m_debugWorldObjects.end());
-
-
-	auto everyFrameWorldObjRemoveStartIterator = std::remove_if(m_debugWorldObjectsEveryframe.begin(), m_debugWorldObjectsEveryframe.end(),
-																[](DebugWorldObject& obj) -> bool { return (obj.m_duration >= 0.f && obj.m_timer.HasPeriodElapsed()); });
+	m_meshTypes.clear();
+	m_transforms.clear();
+	m_billboardPositions.clear();
+	m_startColors.clear();
+	m_endColors.clear();
+	m_startTimes.clear();
+	m_expiryTimes.clear();
+	m_durations.clear();
+	m_modes.clear();
+	m_rasterModes.clear();
+	m_textures.clear();
+	m_isBillboarded.clear();
+	m_customVerts.clear();
+}
 
-	m_debugWorldObjectsEveryframe.erase(everyFrameWorldObjRemoveStartIterator, m_debugWorldObjectsEveryframe.end());
-	
-	auto screenObjRemoveStartIterator = std::remove_if(m_debugScreenObjects.begin(), m_debugScreenObjects.end(),
-													   [](DebugScreenObject& obj) -> bool { return  (obj.m_duration >= 0.f && obj.m_timer.HasPeriodElapsed()); });
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int DebugScreenObjectList::Add(float duration, Rgba8 const& startColor, Rgba8 const& endColor, Texture* texture)
+{
+	double startTime = GetDebugRenderTime();
 
-	m_debugScreenObjects.erase(screenObjRemoveStartIterator, m_debugScreenObjects.end());
+	m_startColors.push_back(startColor);
+	m_endColors.push_back(endColor);
+	m_startTimes.push_back(startTime);
+	m_expiryTimes.push_back(GetDebugExpiryTime(startTime, duration));
+	m_durations.push_back(duration);
+	m_textures.push_back(texture);
+	m_verts.emplace_back();
 
-	auto frameMessageRemoveStartIterator = std::remove_if(m_debugScreenMessagesEveryFrame.begin(), m_debugScreenMessagesEveryFrame.end(),
-														  [](DebugScreenObject& obj) -> bool { return (obj.m_duration == 0.f && obj.m_timer.HasPeriodElapsed()); });
+	return GetCount() - 1;
+}
 
-	m_debugScreenMessagesEveryFrame.erase(frameMessageRemoveStartIterator, m_debugScreenMessagesEveryFrame.end());
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void DebugScreenObjectList::MoveElement(int fromIndex, int toIndex)
+{
+	m_startColors[toIndex]	= m_startColors[fromIndex];
+	m_endColors[toIndex]	= m_endColors[fromIndex];
+	m_startTimes[toIndex]	= m_startTimes[fromIndex];
+	m_expiryTimes[toIndex]	= m_expiryTimes[fromIndex];
+	m_durations[toIndex]	= m_durations[fromIndex];
+	m_textures[toIndex]		= m_textures[fromIndex];
+	m_verts[toIndex].swap(m_verts[fromIndex]);
+}
 
-	auto finiteMessageRemoveStartIterator = std::remove_if(m_debugScreenFiniteMessages.begin(), m_debugScreenFiniteMessages.end(),
-														   [](DebugScreenObject& obj) -> bool { return (obj.m_duration >= 0.f && obj.m_timer.HasPeriodElapsed());  });
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void DebugScreenObjectList::Resize(int newCount)
+{
+	m_startColors.resize(newCount);
+	m_endColors.resize(newCount);
+	m_startTimes.resize(newCount);
+	m_expiryTimes.resize(newCount);
+	m_durations.resize(newCount);
+	m_textures.resize(newCount);
+	m_verts.resize(newCount);
+}
 
-	m_debugScreenFiniteMessages.erase(finiteMessageRemoveStartIterator, m_debugScreenFiniteMessages.end());
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void DebugScreenObjectList::SwapRemove(int index)
+{
+	int lastIndex = GetCount() - 1;
 
+	if(index != lastIndex)
+	{
+		MoveElement(lastIndex, index);
+	}
 
+	Resize(lastIndex);
 }
 
-#if defined USING_DX12
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void DebugRenderWorldEveryFrame(Camera const& camera)
+void DebugScreenObjectList::RemoveExpired(double currentTime, bool keepOrder)
 {
-	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
-
-	if(m_shouldRender)
+	if(!keepOrder)
 	{
-		for(int index = 0; index < static_cast<int>(m_debugWorldObjectsEveryframe.size()); ++index)
+		for(int index = GetCount() - 1; index >= 0; --index)
 		{
-			if(m_debugWorldObjectsEveryframe[index].m_duration > 0.f)
+			if(currentTime > m_expiryTimes[index])
 			{
-				Rgba8 color = m_debugWorldObjectsEveryframe[index].m_startColor.ColorLerp(m_debugWorldObjectsEveryframe[index].m_startColor, m_debugWorldObjectsEveryframe[index].m_endColor, static_cast<float>(m_debugWorldObjectsEveryframe[index].m_timer.GetElapsedFraction()));
-
-				for(size_t vertIndex = 0; vertIndex < m_debugWorldObjectsEveryframe[index].m_verts.size(); ++vertIndex)
-				{
-					m_debugWorldObjectsEveryframe[index].m_verts[vertIndex].m_color = color;
-				}
+				SwapRemove(index);
 			}
+		}
 
-			m_debugRenderConfig.m_renderer->SetPipelineState(m_debugWorldObjectsEveryframe[index].m_debugObjPipelineState);
+		return;
+	}
 
-			if(!m_debugWorldObjectsEveryframe[index].m_isText)
-			{
-				m_debugRenderConfig.m_renderer->SetModelConstants();
-			}
-			else
-			{
-				Mat44 textTransform;
+	// single in-order compaction pass
+	int numKept = 0;
 
-				if(m_debugWorldObjectsEveryframe[index].m_isBillboarded)
-				{
-					Mat44 targetTransform = camera.m_orientation.GetAsMatrix_IFwd_JLeft_KUp();
+	for(int index = 0; index < GetCount(); ++index)
+	{
+		if(currentTime > m_expiryTimes[index])
+		{
+			continue;
+		}
 
-					textTransform = GetBillboardTransform(BillboardType::WORLD_UP_OPPOSING, targetTransform, m_debugWorldObjectsEveryframe[index].m_position);
+		if(index != numKept)
+		{
+			MoveElement(index, numKept);
+		}
 
-					textTransform.SetTranslation3D(m_debugWorldObjectsEveryframe[index].m_position);
-				}
-				else
-				{
-					textTransform = m_debugWorldObjectsEveryframe[index].m_transform;
-				}
+		++numKept;
+	}
 
-				Rgba8 color = Rgba8::StaticColorLerp(m_debugWorldObjectsEveryframe[index].m_startColor, m_debugWorldObjectsEveryframe[index].m_endColor, m_debugWorldObjectsEveryframe[index].m_timer.GetElapsedFraction());
+	Resize(numKept);
+}
 
-				m_debugRenderConfig.m_renderer->SetModelConstants(textTransform, color);
-			}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void DebugScreenObjectList::Clear()
+{
+	Resize(0);
+}
 
-			if(m_debugWorldObjectsEveryframe[index].m_mode == DebugRenderMode::X_RAY)
-			{
-				for(size_t vertIndex = 0; vertIndex < m_debugWorldObjectsEveryframe[index].m_verts.size(); ++vertIndex)
-				{
-					m_debugWorldObjectsEveryframe[index].m_verts[vertIndex].m_color.a = 100;
-				}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static void CreateDebugUnitMeshes()
+{
+	for(int meshIndex = 0; meshIndex < static_cast<int>(DebugMeshType::COUNT); ++meshIndex)
+	{
+		s_debugUnitMeshes[meshIndex].clear();
+	}
 
-				PipelineStateObject* tempPso = m_debugRenderConfig.m_renderer->CreateOrGetPipelineStateObject(nullptr, nullptr, InputLayoutType::VERTEX_PCU,
-																											  m_debugWorldObjectsEveryframe[index].m_rasterMode,
-																											  BlendMode::ALPHA, DepthMode::READ_ONLY_LESS_EQUAL);
+	// radius 1 at the origin
+	AddVertsForSphere3D(s_debugUnitMeshes[static_cast<int>(DebugMeshType::UNIT_SPHERE)], Vec3(0.f, 0.f, 0.f), 1.f, Rgba8::WHITE, AABB2::ZERO_TO_ONE, 32, 16);
 
-				m_debugRenderConfig.m_renderer->SetPipelineState(tempPso);
-				m_debugRenderConfig.m_renderer->SetModelConstants();
-				m_debugRenderConfig.m_renderer->BindTexture(m_debugWorldObjectsEveryframe[index].m_texture, RootParameters::DIFFUSE_TEXTURE_DT);
-				m_debugRenderConfig.m_renderer->DrawVertexArray(m_debugWorldObjectsEveryframe[index].m_verts);
+	// (0,0,0) to (1,1,1), scaled to the box dimensions
+	AddVertsForAABB3D(s_debugUnitMeshes[static_cast<int>(DebugMeshType::UNIT_BOX)], AABB3(Vec3(0.f, 0.f, 0.f), Vec3(1.f, 1.f, 1.f)), Rgba8::WHITE);
 
-				m_debugRenderConfig.m_renderer->SetPipelineState(m_debugWorldObjectsEveryframe[index].m_debugObjPipelineState);
+	// length 1 along +X, radius 1
+	AddVertsForCylinder3D(s_debugUnitMeshes[static_cast<int>(DebugMeshType::UNIT_CYLINDER)], 1.f, 1.f, Rgba8::WHITE, AABB2::ZERO_TO_ONE, 16);
+	AddVertsForArrow3D(s_debugUnitMeshes[static_cast<int>(DebugMeshType::UNIT_ARROW)], Vec3(0.f, 0.f, 0.f), Vec3(1.f, 0.f, 0.f), 1.f, 1.f, Rgba8::WHITE, AABB2::ZERO_TO_ONE, 16);
+	AddVertsForArrow3D(s_debugUnitMeshes[static_cast<int>(DebugMeshType::UNIT_WIREFRAME_ARROW)], Vec3(0.f, 0.f, 0.f), Vec3(1.f, 0.f, 0.f), 1.f, 1.f, Rgba8::WHITE, AABB2::ZERO_TO_ONE, 32);
+}
 
-				for(size_t vertIndex = 0; vertIndex < m_debugWorldObjectsEveryframe[index].m_verts.size(); ++vertIndex)
-				{
-					m_debugWorldObjectsEveryframe[index].m_verts[vertIndex].m_color.a = 255;
-				}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Orients the +X axis of a unit cylinder/arrow along fwdNormal and scales it to length x radius.
+static Mat44 MakeDebugAxialTransform(Vec3 const& start, Vec3 const& fwdNormal, float length, float radius)
+{
+	Mat44 transform = GetLookAtTransform(start, start + fwdNormal);
+	transform.SetTranslation3D(start);
+	transform.AppendScaleNonUniform3D(Vec3(length, radius, radius));
 
-				m_debugRenderConfig.m_renderer->SetModelConstants();
-			}
-			m_debugRenderConfig.m_renderer->BindTexture(m_debugWorldObjectsEveryframe[index].m_texture, RootParameters::DIFFUSE_TEXTURE_DT);
-			m_debugRenderConfig.m_renderer->DrawVertexArray(m_debugWorldObjectsEveryframe[index].m_verts);
-		}
-	}
+	return transform;
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void DebugRenderWorld(Camera const& camera)
+static Rgba8 GetDebugObjectColor(Rgba8 const& startColor, Rgba8 const& endColor, float duration, double startTime, double currentTime)
 {
-	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
-
-	m_debugRenderConfig.m_renderer->BeginCamera(camera);
+	if(duration > 0.f)
+	{
+		float elapsedFraction = static_cast<float>((currentTime - startTime) / static_cast<double>(duration));
+		return Rgba8::StaticColorLerp(startColor, endColor, elapsedFraction);
+	}
 
-	DebugRenderWorldEveryFrame(camera);
+	return startColor;
+}
 
-	if(m_shouldRender)
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static DebugRenderBatch& FindOrAddDebugRenderBatch(std::vector<DebugRenderBatch>& batches, DebugRenderMode mode, RasterizerMode rasterMode, Texture* texture, bool isEveryFrame)
+{
+	for(int batchIndex = 0; batchIndex < static_cast<int>(batches.size()); ++batchIndex)
 	{
-		for(int index = 0; index < static_cast<int>(m_debugWorldObjects.size()); ++index)
-		{
-			if(m_debugWorldObjects[index].m_duration > 0.f)
-			{
-				Rgba8 color = m_debugWorldObjects[index].m_startColor.ColorLerp(m_debugWorldObjects[index].m_startColor, m_debugWorldObjects[index].m_endColor, static_cast<float>(m_debugWorldObjects[index].m_timer.GetElapsedFraction()));
-
-				for(size_t vertIndex = 0; vertIndex < m_debugWorldObjects[index].m_verts.size(); ++vertIndex)
-				{
-					m_debugWorldObjects[index].m_verts[vertIndex].m_color = color;
-				}
-			}
+		DebugRenderBatch& batch = batches[batchIndex];
 
-			m_debugRenderConfig.m_renderer->SetPipelineState(m_debugWorldObjects[index].m_debugObjPipelineState);
+		if(batch.m_mode == mode && batch.m_rasterMode == rasterMode && batch.m_texture == texture && batch.m_isEveryFrame == isEveryFrame)
+		{
+			return batch;
+		}
+	}
 
-			if(!m_debugWorldObjects[index].m_isText)
-			{
-				m_debugRenderConfig.m_renderer->SetModelConstants();
-			}
-			else
-			{
-				Mat44 textTransform;
+	batches.emplace_back();
 
-				if(m_debugWorldObjects[index].m_isBillboarded)
-				{
-					Mat44 targetTransform = camera.m_orientation.GetAsMatrix_IFwd_JLeft_KUp();
+	DebugRenderBatch& newBatch = batches.back();
+	newBatch.m_mode = mode;
+	newBatch.m_rasterMode = rasterMode;
+	newBatch.m_texture = texture;
+	newBatch.m_isEveryFrame = isEveryFrame;
 
-					textTransform = GetBillboardTransform(BillboardType::WORLD_UP_OPPOSING, targetTransform, m_debugWorldObjects[index].m_position);
+	return newBatch;
+}
 
-					textTransform.SetTranslation3D(m_debugWorldObjects[index].m_position);
-				}
-				else
-				{
-					textTransform = m_debugWorldObjects[index].m_transform;
-				}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static void AppendVertsToDebugRenderBatch(DebugRenderBatch& batch, std::vector<Vertex_PCU> const& sourceVerts, Mat44 const& transform, Rgba8 const& color)
+{
+	size_t startIndex = batch.m_verts.size();
+	batch.m_verts.resize(startIndex + sourceVerts.size());
 
-				Rgba8 color = Rgba8::StaticColorLerp(m_debugWorldObjects[index].m_startColor, m_debugWorldObjects[index].m_endColor, m_debugWorldObjects[index].m_timer.GetElapsedFraction());
+	Vertex_PCU* destVerts = batch.m_verts.data() + startIndex;
 
-				m_debugRenderConfig.m_renderer->SetModelConstants(textTransform, color);
-			}
+	for(size_t vertIndex = 0; vertIndex < sourceVerts.size(); ++vertIndex)
+	{
+		destVerts[vertIndex].m_position		= transform.TransformPosition3D(sourceVerts[vertIndex].m_position);
+		destVerts[vertIndex].m_color		= color;
+		destVerts[vertIndex].m_uvTexCoords	= sourceVerts[vertIndex].m_uvTexCoords;
+	}
+}
 
-			if(m_debugWorldObjects[index].m_mode == DebugRenderMode::X_RAY)
-			{
-				for(size_t vertIndex = 0; vertIndex < m_debugWorldObjects[index].m_verts.size(); ++vertIndex)
-				{
-					m_debugWorldObjects[index].m_verts[vertIndex].m_color.a = 100;
-				}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static void AppendDebugWorldObjects(DebugWorldObjectList const& objects, Camera const& camera, double currentTime)
+{
+	Mat44 cameraTransform = camera.m_orientation.GetAsMatrix_IFwd_JLeft_KUp();
 
-				PipelineStateObject* tempPso = m_debugRenderConfig.m_renderer->CreateOrGetPipelineStateObject(nullptr, nullptr, InputLayoutType::VERTEX_PCU,
-																											  m_debugWorldObjects[index].m_rasterMode,
-																											  BlendMode::ALPHA, DepthMode::READ_ONLY_LESS_EQUAL);
+	for(int index = 0; index < objects.GetCount(); ++index)
+	{
+		Mat44 transform = objects.m_transforms[index];
 
-				m_debugRenderConfig.m_renderer->SetPipelineState(tempPso);
-				m_debugRenderConfig.m_renderer->SetModelConstants();
-				m_debugRenderConfig.m_renderer->BindTexture(m_debugWorldObjects[index].m_texture, RootParameters::DIFFUSE_TEXTURE_DT);
-				m_debugRenderConfig.m_renderer->DrawVertexArray(m_debugWorldObjects[index].m_verts);
+		if(objects.m_isBillboarded[index])
+		{
+			Vec3 const& position = objects.m_billboardPositions[index];
 
-				m_debugRenderConfig.m_renderer->SetPipelineState(m_debugWorldObjects[index].m_debugObjPipelineState);
+			transform = GetBillboardTransform(BillboardType::WORLD_UP_OPPOSING, cameraTransform, position);
+			transform.SetTranslation3D(position);
+		}
 
-				for(size_t vertIndex = 0; vertIndex < m_debugWorldObjects[index].m_verts.size(); ++vertIndex)
-				{
-					m_debugWorldObjects[index].m_verts[vertIndex].m_color.a = 255;
-				}
-				m_debugRenderConfig.m_renderer->SetModelConstants();
+		DebugMeshType meshType = objects.m_meshTypes[index];
+		std::vector<Vertex_PCU> const& sourceVerts = meshType == DebugMeshType::CUSTOM ? objects.m_customVerts[index] : s_debugUnitMeshes[static_cast<int>(meshType)];
 
-			}
+		Rgba8 color = GetDebugObjectColor(objects.m_startColors[index], objects.m_endColors[index], objects.m_durations[index], objects.m_startTimes[index], currentTime);
 
-			m_debugRenderConfig.m_renderer->BindTexture(m_debugWorldObjects[index].m_texture, RootParameters::DIFFUSE_TEXTURE_DT);
-			m_debugRenderConfig.m_renderer->DrawVertexArray(m_debugWorldObjects[index].m_verts);
-		}
+		bool isEveryFrame = objects.m_durations[index] == 0.f;
 
+		DebugRenderBatch& batch = FindOrAddDebugRenderBatch(s_debugWorldBatches, objects.m_modes[index], objects.m_rasterModes[index], objects.m_textures[index], isEveryFrame);
+		AppendVertsToDebugRenderBatch(batch, sourceVerts, transform, color);
 	}
-	m_debugRenderConfig.m_renderer->EndCamera(camera);
 }
 
-
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void DebugRenderScreen(Camera const& camera)
+// Appends back to front; each object is placed on the next message line when stackMessages is set, starting at firstLineNum.
+static int AppendDebugScreenObjects(DebugScreenObjectList const& objects, double currentTime, bool stackMessages, int firstLineNum)
 {
-	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
-
-	m_debugRenderConfig.m_renderer->BeginCamera(camera);
-
-	int textLineNum = 0;
+	int textLineNum = firstLineNum;
 
-
-	if(m_shouldRender)
+	for(int index = objects.GetCount() - 1; index >= 0; --index)
 	{
-		for(int index = 0; index < static_cast<int>(m_debugScreenObjects.size()); ++index)
-		{
-			m_debugRenderConfig.m_renderer->SetPipelineState(m_debugScreenObjects[index].m_debugObjPipelineState);
-			m_debugRenderConfig.m_renderer->SetModelConstants();
-			m_debugRenderConfig.m_renderer->BindTexture(m_debugScreenObjects[index].m_texture, RootParameters::DIFFUSE_TEXTURE_DT);
+		Mat44 transform;
 
-			m_debugRenderConfig.m_renderer->DrawVertexArray(m_debugScreenObjects[index].m_verts);
-		}
-
-		for(int index = static_cast<int>(m_debugScreenMessagesEveryFrame.size()) - 1; index >= 0; --index)
+		if(stackMessages)
 		{
-
-			Mat44 translation = Mat44::MakeTranslation3D(Vec3(10.f, 780.f - 12.f * textLineNum, 0.f));
-
+			transform = Mat44::MakeTranslation3D(Vec3(10.f, 780.f - 12.f * textLineNum, 0.f));
 			textLineNum += 1;
-
-			m_debugRenderConfig.m_renderer->SetPipelineState(nullptr);
-			m_debugRenderConfig.m_renderer->SetModelConstants(translation);
-			m_debugRenderConfig.m_renderer->BindTexture(m_debugScreenMessagesEveryFrame[index].m_texture, RootParameters::DIFFUSE_TEXTURE_DT);
-			m_debugRenderConfig.m_renderer->DrawVertexArray(m_debugScreenMessagesEveryFrame[index].m_verts);
-		}
-		textLineNum = 0;
-
- 		for(int index = static_cast<int>(m_debugScreenInfiniteMessages.size()) - 1; index >= 0.f; --index)
- 		{
- 
- 			Mat44 translation = Mat44::MakeTranslation3D(Vec3(10.f, 780.f - (12.f * textLineNum) - (12.f * static_cast<int>(m_debugScreenMessagesEveryFrame.size())), 0.f));
- 
- 			textLineNum += 1;
- 
- 			m_debugRenderConfig.m_renderer->SetModelConstants(translation);
- 			m_debugRenderConfig.m_renderer->SetPipelineState(m_debugScreenInfiniteMessages[index].m_debugObjPipelineState);
- 			m_debugRenderConfig.m_renderer->BindTexture(m_debugScreenInfiniteMessages[index].m_texture, RootParameters::DIFFUSE_TEXTURE_DT);
-			m_debugRenderConfig.m_renderer->DrawVertexArray(m_debugScreenInfiniteMessages[index].m_verts);
 		}
 
-		textLineNum = 0;
-
-		for(int index = static_cast<int>(m_debugScreenFiniteMessages.size()) - 1; index >= 0; --index)
-		{
-			Mat44 translation = Mat44::MakeTranslation3D(Vec3(10.f, 780.f - (12.f * textLineNum) - (12.f * static_cast<int>(m_debugScreenInfiniteMessages.size())) - (12.f * static_cast<int>(m_debugScreenMessagesEveryFrame.size())), 0.f));
+		Rgba8 color = GetDebugObjectColor(objects.m_startColors[index], objects.m_endColors[index], objects.m_durations[index], objects.m_startTimes[index], currentTime);
 
-			textLineNum += 1;
- 
-			m_debugRenderConfig.m_renderer->SetModelConstants(translation);
-			m_debugRenderConfig.m_renderer->SetPipelineState(m_debugScreenFiniteMessages[index].m_debugObjPipelineState);
-			m_debugRenderConfig.m_renderer->BindTexture(m_debugScreenFiniteMessages[index].m_texture, RootParameters::DIFFUSE_TEXTURE_DT);
-			m_debugRenderConfig.m_renderer->DrawVertexArray(m_debugScreenFiniteMessages[index].m_verts);
-		}
+		DebugRenderBatch& batch = FindOrAddDebugRenderBatch(s_debugScreenBatches, DebugRenderMode::ALWAYS, RasterizerMode::SOLID_CULL_BACK, objects.m_textures[index], false);
+		AppendVertsToDebugRenderBatch(batch, objects.m_verts[index], transform, color);
 	}
 
-	m_debugRenderConfig.m_renderer->EndCamera(camera);
+	return textLineNum;
 }
 
-#else
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void DebugRenderWorldEveryFrame(Camera const& camera)
+static void ClearDebugRenderBatches(std::vector<DebugRenderBatch>& batches)
 {
-// 	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
-
-	if(m_shouldRender)
+	for(int batchIndex = 0; batchIndex < static_cast<int>(batches.size()); ++batchIndex)
 	{
+		batches[batchIndex].m_verts.clear();
+	}
+}
 
-		for(int index = 0; index < static_cast<int>(m_debugWorldObjectsEveryframe.size()); ++index)
-		{
-			if(m_debugWorldObjectsEveryframe[index].m_duration > 0.f)
-			{
-				Rgba8 color = m_debugWorldObjectsEveryframe[index].m_startColor.ColorLerp(m_debugWorldObjectsEveryframe[index].m_startColor, m_debugWorldObjectsEveryframe[index].m_endColor, static_cast<float>(m_debugWorldObjectsEveryframe[index].m_timer.GetElapsedFraction()));
-
-				for(size_t vertIndex = 0; vertIndex < m_debugWorldObjectsEveryframe[index].m_verts.size(); ++vertIndex)
-				{
-					m_debugWorldObjectsEveryframe[index].m_verts[vertIndex].m_color = color;
-				}
-			}
-
-			if(m_debugWorldObjectsEveryframe[index].m_mode == DebugRenderMode::USE_DEPTH)
-			{
-				m_debugRenderConfig.m_renderer->SetDepthMode(DepthMode::READ_WRITE_LESS_EQUAL);
-
-				if(!m_debugWorldObjectsEveryframe[index].m_isText)
-				{
-					m_debugRenderConfig.m_renderer->SetModelConstants();
-				}
-				else
-				{
-					Mat44 textTransform;
-
-					if(m_debugWorldObjectsEveryframe[index].m_isBillboarded)
-					{
-						Mat44 targetTransform = camera.m_orientation.GetAsMatrix_IFwd_JLeft_KUp();
-
-						textTransform = GetBillboardTransform(BillboardType::WORLD_UP_OPPOSING, targetTransform, m_debugWorldObjectsEveryframe[index].m_position);
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void DebugRenderSystemStartup(DegbugRenderConfig& config)
+{
+	m_debugRenderConfig.m_renderer = config.m_renderer;
+	m_debugRenderConfig.m_fontName = config.m_fontName;
 
-						textTransform.SetTranslation3D(m_debugWorldObjectsEveryframe[index].m_position);
-					}
-					else
-					{
-						textTransform = m_debugWorldObjectsEveryframe[index].m_transform;
-					}
+	m_debugRenderConfig.m_renderer->CreateOrGetBitmapFontWithFontName(m_debugRenderConfig.m_fontName);
 
-					Rgba8 color = Rgba8::StaticColorLerp(m_debugWorldObjectsEveryframe[index].m_startColor, m_debugWorldObjectsEveryframe[index].m_endColor, m_debugWorldObjectsEveryframe[index].m_timer.GetElapsedFraction());
+	CreateDebugUnitMeshes();
 
-					m_debugRenderConfig.m_renderer->SetModelConstants(textTransform, color);
-				}
-			}
+	SubscribeEventCallbackFunction("debugrenderclear", OnDebugRenderClear);
+	SubscribeEventCallbackFunction("debugrendertoggle", OnDebugRenderToggle);
 
+#if defined(USING_DX12)
+//	s_ringBuffer = m_debugRenderConfig.m_renderer->CreateOrGetRingBuffer("DebugRenderSystem", 16 * 1024 * 1024);
+#endif
 
-			if(m_debugWorldObjectsEveryframe[index].m_mode == DebugRenderMode::ALWAYS)
-			{
-				m_debugRenderConfig.m_renderer->SetDepthMode(DepthMode::DISABLED);
+}
 
-				if(!m_debugWorldObjectsEveryframe[index].m_isText)
-				{
-					m_debugRenderConfig.m_renderer->SetModelConstants();
-				}
-				else
-				{
-					Mat44 textTransform;
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void DebugRenderSystemShutdown()
+{
 
-					if(m_debugWorldObjectsEveryframe[index].m_isBillboarded)
-					{
-						Mat44 targetTransform = camera.m_orientation.GetAsMatrix_IFwd_JLeft_KUp();
+	UnsubscribeEventCallbackFunction("debugrendertoggle", OnDebugRenderToggle);
+	UnsubscribeEventCallbackFunction("debugrenderclear", OnDebugRenderClear);
 
-						textTransform = GetBillboardTransform(BillboardType::WORLD_UP_OPPOSING, targetTransform, m_debugWorldObjectsEveryframe[index].m_position);
+	m_debugWorldObjects.Clear();
+	m_debugScreenObjects.Clear();
 
-						textTransform.SetTranslation3D(m_debugWorldObjectsEveryframe[index].m_position);
-					}
-					else
-					{
-						textTransform = m_debugWorldObjectsEveryframe[index].m_transform;
-					}
+	m_debugScreenFiniteMessages.Clear();
+	m_debugScreenMessagesEveryFrame.Clear();
+	m_debugScreenInfiniteMessages.Clear();
 
-					Rgba8 color = Rgba8::StaticColorLerp(m_debugWorldObjectsEveryframe[index].m_startColor, m_debugWorldObjectsEveryframe[index].m_endColor, m_debugWorldObjectsEveryframe[index].m_timer.GetElapsedFraction());
+	s_debugTextMeshCache.Clear();
+	s_debugWorldBatches.clear();
+	s_debugScreenBatches.clear();
+	s_debugXRayVerts.clear();
 
-					m_debugRenderConfig.m_renderer->SetModelConstants(textTransform, color);
-				}
-			}
+	delete m_debugRenderConfig.m_renderer;
+	m_debugRenderConfig.m_renderer = nullptr;
+}
 
-			if(m_debugWorldObjectsEveryframe[index].m_mode == DebugRenderMode::X_RAY)
-			{
-				for(size_t vertIndex = 0; vertIndex < m_debugWorldObjectsEveryframe[index].m_verts.size(); ++vertIndex)
-				{
-					m_debugWorldObjectsEveryframe[index].m_verts[vertIndex].m_color.a = 100;
-				}
-
-				m_debugRenderConfig.m_renderer->SetBlendMode(BlendMode::ALPHA);
-				m_debugRenderConfig.m_renderer->SetDepthMode(DepthMode::READ_ONLY_LESS_EQUAL);
-				m_debugRenderConfig.m_renderer->BindShader(nullptr);
-				m_debugRenderConfig.m_renderer->SetModelConstants();
-				m_debugRenderConfig.m_renderer->BindTexture(m_debugWorldObjectsEveryframe[index].m_texture);
-				m_debugRenderConfig.m_renderer->DrawVertexArray(m_debugWorldObjectsEveryframe[index].m_verts);
-
-				m_debugRenderConfig.m_renderer->SetBlendMode(BlendMode::ALPHA);
-				m_debugRenderConfig.m_renderer->SetDepthMode(DepthMode::READ_WRITE_LESS_EQUAL);
-
-				for(size_t vertIndex = 0; vertIndex < m_debugWorldObjectsEveryframe[index].m_verts.size(); ++vertIndex)
-				{
-					m_debugWorldObjectsEveryframe[index].m_verts[vertIndex].m_color.a = 255;
-				}
-
-				m_debugRenderConfig.m_renderer->SetModelConstants();
-			}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void DebugRenderSetVisible()
+{
+	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
 
-			m_debugRenderConfig.m_renderer->SetRasterizerMode(m_debugWorldObjectsEveryframe[index].m_rasterMode);
-			m_debugRenderConfig.m_renderer->SetBlendMode(BlendMode::ALPHA);
-			m_debugRenderConfig.m_renderer->BindShader(nullptr);
-			m_debugRenderConfig.m_renderer->BindTexture(m_debugWorldObjectsEveryframe[index].m_texture);
-			m_debugRenderConfig.m_renderer->DrawVertexArray(m_debugWorldObjectsEveryframe[index].m_verts);
-		}
-	}
+	m_shouldRender = true;
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void DebugRenderWorld(Camera const& camera)
+void DebugRenderSetHidden()
 {
 	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
+	m_shouldRender = false;
+}
 
-	m_debugRenderConfig.m_renderer->BeginCamera(camera);
-
-	DebugRenderWorldEveryFrame(camera);
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void DebugRenderClear()
+{
+	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
+	m_debugWorldObjects.Clear();
+	m_debugScreenObjects.Clear();
 
-	if(m_shouldRender)
-	{
+	m_debugScreenFiniteMessages.Clear();
+	m_debugScreenMessagesEveryFrame.Clear();
+	m_debugScreenInfiniteMessages.Clear();
+}
 
-		for(int index = 0; index < static_cast<int>(m_debugWorldObjects.size()); ++index)
-		{
-			if(m_debugWorldObjects[index].m_duration > 0.f)
-			{
-				Rgba8 color = m_debugWorldObjects[index].m_startColor.ColorLerp(m_debugWorldObjects[index].m_startColor, m_debugWorldObjects[index].m_endColor, static_cast<float>(m_debugWorldObjects[index].m_timer.GetElapsedFraction()));
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void DebugRenderBeginFrame()
+{
+	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
 
-				for(size_t vertIndex = 0; vertIndex < m_debugWorldObjects[index].m_verts.size(); ++vertIndex)
-				{
-					m_debugWorldObjects[index].m_verts[vertIndex].m_color = color;
-				}
-			}
+	// one clock read for the whole sweep; infinite objects and messages carry DBL_MAX and are never removed
+	double currentTime = GetDebugRenderTime();
 
-			if(m_debugWorldObjects[index].m_mode == DebugRenderMode::USE_DEPTH)
-			{
-				m_debugRenderConfig.m_renderer->SetDepthMode(DepthMode::READ_WRITE_LESS_EQUAL);
-
-				if(!m_debugWorldObjects[index].m_isText)
-				{
-					m_debugRenderConfig.m_renderer->SetModelConstants();
-				}
-				else
-				{
-					Mat44 textTransform;
-
-					if(m_debugWorldObjects[index].m_isBillboarded)
-					{
-						Mat44 targetTransform = camera.m_orientation.GetAsMatrix_IFwd_JLeft_KUp();
-
-						textTransform = GetBillboardTransform(BillboardType::WORLD_UP_OPPOSING, targetTransform, m_debugWorldObjects[index].m_position);
-
-						textTransform.SetTranslation3D(m_debugWorldObjects[index].m_position);
-					}
-					else
-					{
-						textTransform = m_debugWorldObjects[index].m_transform;
-					}
-
-					Rgba8 color = Rgba8::StaticColorLerp(m_debugWorldObjects[index].m_startColor, m_debugWorldObjects[index].m_endColor, m_debugWorldObjects[index].m_timer.GetElapsedFraction());
-
-					m_debugRenderConfig.m_renderer->SetModelConstants(textTransform, color);
-				}
-			}	
-			
-			
-			if(m_debugWorldObjects[index].m_mode == DebugRenderMode::ALWAYS)
-			{
-				m_debugRenderConfig.m_renderer->SetDepthMode(DepthMode::DISABLED);
+	m_debugWorldObjects.RemoveExpired(currentTime);
+	m_debugScreenObjects.RemoveExpired(currentTime, false);
 
-				if(!m_debugWorldObjects[index].m_isText)
-				{
-					m_debugRenderConfig.m_renderer->SetModelConstants();
-				}
-				else
-				{
-					Mat44 textTransform;
+	m_debugScreenMessagesEveryFrame.RemoveExpired(currentTime, true);
+	m_debugScreenFiniteMessages.RemoveExpired(currentTime, true);
+}
 
-					if(m_debugWorldObjects[index].m_isBillboarded)
-					{
-						Mat44 targetTransform = camera.m_orientation.GetAsMatrix_IFwd_JLeft_KUp();
+#if defined USING_DX12
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static void DrawDebugRenderBatch(DebugRenderBatch const& batch)
+{
+	DX12Renderer* renderer = m_debugRenderConfig.m_renderer;
 
-						textTransform = GetBillboardTransform(BillboardType::WORLD_UP_OPPOSING, targetTransform, m_debugWorldObjects[index].m_position);
+	if(batch.m_mode == DebugRenderMode::X_RAY)
+	{
+		// faded pass that ignores depth, then the regular depth tested pass on top
+		s_debugXRayVerts.assign(batch.m_verts.begin(), batch.m_verts.end());
 
-						textTransform.SetTranslation3D(m_debugWorldObjects[index].m_position);
-					}
-					else
-					{
-						textTransform = m_debugWorldObjects[index].m_transform;
-					}
+		for(size_t vertIndex = 0; vertIndex < s_debugXRayVerts.size(); ++vertIndex)
+		{
+			s_debugXRayVerts[vertIndex].m_color.a = 100;
+		}
 
-					Rgba8 color = Rgba8::StaticColorLerp(m_debugWorldObjects[index].m_startColor, m_debugWorldObjects[index].m_endColor, m_debugWorldObjects[index].m_timer.GetElapsedFraction());
+		PipelineStateObject* xRayPso = renderer->CreateOrGetPipelineStateObject(nullptr, nullptr, InputLayoutType::VERTEX_PCU, batch.m_rasterMode, BlendMode::ALPHA, DepthMode::READ_ONLY_LESS_EQUAL);
 
-					m_debugRenderConfig.m_renderer->SetModelConstants(textTransform, color);
-				}
-			}
+		renderer->SetPipelineState(xRayPso);
+		renderer->SetModelConstants();
+		renderer->BindTexture(batch.m_texture, RootParameters::DIFFUSE_TEXTURE_DT);
+		renderer->DrawVertexArray(s_debugXRayVerts);
+	}
 
-			if(m_debugWorldObjects[index].m_mode == DebugRenderMode::X_RAY)
-			{
-				for(size_t vertIndex = 0; vertIndex < m_debugWorldObjects[index].m_verts.size(); ++vertIndex)
-				{
-					m_debugWorldObjects[index].m_verts[vertIndex].m_color.a = 100;
-				}
+	DepthMode depthMode = batch.m_mode == DebugRenderMode::ALWAYS ? DepthMode::DISABLED : DepthMode::READ_WRITE_LESS_EQUAL;
 
-				m_debugRenderConfig.m_renderer->SetBlendMode(BlendMode::ALPHA);
-				m_debugRenderConfig.m_renderer->SetDepthMode(DepthMode::READ_ONLY_ALWAYS);
-				m_debugRenderConfig.m_renderer->SetRasterizerMode(m_debugWorldObjects[index].m_rasterMode);
-				m_debugRenderConfig.m_renderer->BindShader(nullptr);
-				m_debugRenderConfig.m_renderer->SetModelConstants();
-				m_debugRenderConfig.m_renderer->BindTexture(m_debugWorldObjects[index].m_texture);
-				m_debugRenderConfig.m_renderer->DrawVertexArray(m_debugWorldObjects[index].m_verts);
+	PipelineStateObject* pso = renderer->CreateOrGetPipelineStateObject(nullptr, nullptr, InputLayoutType::VERTEX_PCU, batch.m_rasterMode, BlendMode::OPAQUE, depthMode);
 
-				m_debugRenderConfig.m_renderer->SetBlendMode(BlendMode::OPAQUE);
-				m_debugRenderConfig.m_renderer->SetDepthMode(DepthMode::READ_WRITE_LESS_EQUAL);
+	renderer->SetPipelineState(pso);
+	renderer->SetModelConstants();
+	renderer->BindTexture(batch.m_texture, RootParameters::DIFFUSE_TEXTURE_DT);
+	renderer->DrawVertexArray(batch.m_verts);
+}
 
-				for(size_t vertIndex = 0; vertIndex < m_debugWorldObjects[index].m_verts.size(); ++vertIndex)
-				{
-					m_debugWorldObjects[index].m_verts[vertIndex].m_color.a = 255;
-				}
+#else
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static void DrawDebugRenderBatch(DebugRenderBatch const& batch)
+{
+	Renderer* renderer = m_debugRenderConfig.m_renderer;
 
-				m_debugRenderConfig.m_renderer->SetModelConstants();
+	renderer->SetModelConstants();
+	renderer->SetRasterizerMode(batch.m_rasterMode);
+	renderer->BindShader(nullptr);
+	renderer->BindTexture(batch.m_texture);
 
-			}
+	if(batch.m_mode == DebugRenderMode::X_RAY)
+	{
+		// faded pass that ignores depth, then the regular depth tested pass on top
+		s_debugXRayVerts.assign(batch.m_verts.begin(), batch.m_verts.end());
 
-			m_debugRenderConfig.m_renderer->SetRasterizerMode(m_debugWorldObjects[index].m_rasterMode);
-			m_debugRenderConfig.m_renderer->SetBlendMode(BlendMode::OPAQUE);
-			m_debugRenderConfig.m_renderer->BindShader(nullptr);
-			m_debugRenderConfig.m_renderer->BindTexture(m_debugWorldObjects[index].m_texture);
-			m_debugRenderConfig.m_renderer->DrawVertexArray(m_debugWorldObjects[index].m_verts);
+		for(size_t vertIndex = 0; vertIndex < s_debugXRayVerts.size(); ++vertIndex)
+		{
+			s_debugXRayVerts[vertIndex].m_color.a = 100;
 		}
 
+		renderer->SetBlendMode(BlendMode::ALPHA);
+		renderer->SetDepthMode(batch.m_isEveryFrame ? DepthMode::READ_ONLY_LESS_EQUAL : DepthMode::READ_ONLY_ALWAYS);
+		renderer->DrawVertexArray(s_debugXRayVerts);
 	}
 
-	m_debugRenderConfig.m_renderer->EndCamera(camera);
+	renderer->SetBlendMode(batch.m_isEveryFrame ? BlendMode::ALPHA : BlendMode::OPAQUE);
+	renderer->SetDepthMode(batch.m_mode == DebugRenderMode::ALWAYS ? DepthMode::DISABLED : DepthMode::READ_WRITE_LESS_EQUAL);
+	renderer->DrawVertexArray(batch.m_verts);
+}
+#endif
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static void DrawDebugRenderBatches(std::vector<DebugRenderBatch> const& batches, bool isEveryFrame)
+{
+	for(int batchIndex = 0; batchIndex < static_cast<int>(batches.size()); ++batchIndex)
+	{
+		if(batches[batchIndex].m_isEveryFrame == isEveryFrame && !batches[batchIndex].m_verts.empty())
+		{
+			DrawDebugRenderBatch(batches[batchIndex]);
+		}
+	}
 }
 
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void DebugRenderScreen(Camera const& camera)
+void DebugRenderWorld(Camera const& camera)
 {
 	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
 
 	m_debugRenderConfig.m_renderer->BeginCamera(camera);
 
-	int textLineNum = 0;
-
-
 	if(m_shouldRender)
 	{
-		for(int index = 0; index < static_cast<int>(m_debugScreenObjects.size()); ++index)
-		{
-			m_debugRenderConfig.m_renderer->SetModelConstants();
-			m_debugRenderConfig.m_renderer->SetBlendMode(BlendMode::OPAQUE);
-			m_debugRenderConfig.m_renderer->SetRasterizerMode(RasterizerMode::SOLID_CULL_BACK);
-			m_debugRenderConfig.m_renderer->SetDepthMode(DepthMode::READ_WRITE_LESS_EQUAL);
-			m_debugRenderConfig.m_renderer->BindShader(nullptr);
-			m_debugRenderConfig.m_renderer->BindTexture(m_debugScreenObjects[index].m_texture);
-			m_debugRenderConfig.m_renderer->DrawVertexArray(m_debugScreenObjects[index].m_verts);
-		}
-
-		for(int index = static_cast<int>(m_debugScreenMessagesEveryFrame.size()) - 1; index >= 0; --index)
-		{
-
-			Mat44 translation = Mat44::MakeTranslation3D(Vec3(10.f, 780.f - 12.f * textLineNum, 0.f));
+		ClearDebugRenderBatches(s_debugWorldBatches);
 
-			textLineNum += 1;
-
-			m_debugRenderConfig.m_renderer->SetModelConstants(translation);
-			m_debugRenderConfig.m_renderer->SetBlendMode(BlendMode::OPAQUE);
-			m_debugRenderConfig.m_renderer->SetRasterizerMode(RasterizerMode::SOLID_CULL_BACK);
-			m_debugRenderConfig.m_renderer->SetDepthMode(DepthMode::READ_WRITE_LESS_EQUAL);
-			m_debugRenderConfig.m_renderer->BindShader(nullptr);
-			m_debugRenderConfig.m_renderer->BindTexture(m_debugScreenMessagesEveryFrame[index].m_texture);
-			m_debugRenderConfig.m_renderer->DrawVertexArray(m_debugScreenMessagesEveryFrame[index].m_verts);
-		}
+		AppendDebugWorldObjects(m_debugWorldObjects, camera, GetDebugRenderTime());
 
-		textLineNum = 0;
+		DrawDebugRenderBatches(s_debugWorldBatches, true);
+		DrawDebugRenderBatches(s_debugWorldBatches, false);
+	}
 
-		for(int index = static_cast<int>(m_debugScreenInfiniteMessages.size()) - 1; index >= 0.f; --index)
-		{
+	m_debugRenderConfig.m_renderer->EndCamera(camera);
+}
 
-			Mat44 translation = Mat44::MakeTranslation3D(Vec3(10.f, 780.f - (12.f * textLineNum) - (12.f * static_cast<int>(m_debugScreenMessagesEveryFrame.size())), 0.f));
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void DebugRenderScreen(Camera const& camera)
+{
+	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
 
-			textLineNum += 1;
+	m_debugRenderConfig.m_renderer->BeginCamera(camera);
 
-			m_debugRenderConfig.m_renderer->SetModelConstants(translation);
-			m_debugRenderConfig.m_renderer->SetBlendMode(BlendMode::OPAQUE);
-			m_debugRenderConfig.m_renderer->SetRasterizerMode(RasterizerMode::SOLID_CULL_BACK);
-			m_debugRenderConfig.m_renderer->SetDepthMode(DepthMode::READ_WRITE_LESS_EQUAL);
-			m_debugRenderConfig.m_renderer->BindShader(nullptr);
-			m_debugRenderConfig.m_renderer->BindTexture(m_debugScreenInfiniteMessages[index].m_texture);
-			m_debugRenderConfig.m_renderer->DrawVertexArray(m_debugScreenInfiniteMessages[index].m_verts);
-		}
+	if(m_shouldRender)
+	{
+		ClearDebugRenderBatches(s_debugScreenBatches);
 
-		textLineNum = 0;
+		double currentTime = GetDebugRenderTime();
 
-		for(int index = static_cast<int>(m_debugScreenFiniteMessages.size()) - 1; index >= 0; --index)
-		{
-			Mat44 translation = Mat44::MakeTranslation3D(Vec3(10.f, 780.f - (12.f * textLineNum) - (12.f * static_cast<int>(m_debugScreenInfiniteMessages.size())) - (12.f * static_cast<int>(m_debugScreenMessagesEveryFrame.size())), 0.f));
+		AppendDebugScreenObjects(m_debugScreenObjects, currentTime, false, 0);
 
-			textLineNum += 1;
+		// messages stack down from the top: every-frame first, then infinite, then timed
+		int textLineNum = 0;
+		textLineNum = AppendDebugScreenObjects(m_debugScreenMessagesEveryFrame, currentTime, true, textLineNum);
+		textLineNum = AppendDebugScreenObjects(m_debugScreenInfiniteMessages, currentTime, true, textLineNum);
+		AppendDebugScreenObjects(m_debugScreenFiniteMessages, currentTime, true, textLineNum);
 
-			m_debugRenderConfig.m_renderer->SetModelConstants(translation);
-			m_debugRenderConfig.m_renderer->SetBlendMode(BlendMode::OPAQUE);
-			m_debugRenderConfig.m_renderer->SetRasterizerMode(RasterizerMode::SOLID_CULL_BACK);
-			m_debugRenderConfig.m_renderer->SetDepthMode(DepthMode::READ_WRITE_LESS_EQUAL);
-			m_debugRenderConfig.m_renderer->BindShader(nullptr);
-			m_debugRenderConfig.m_renderer->BindTexture(m_debugScreenFiniteMessages[index].m_texture);
-			m_debugRenderConfig.m_renderer->DrawVertexArray(m_debugScreenFiniteMessages[index].m_verts);
-		}
+		DrawDebugRenderBatches(s_debugScreenBatches, false);
 	}
 
 	m_debugRenderConfig.m_renderer->EndCamera(camera);
 }
-#endif
-
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void DebugRenderEndFrame()
@@ -752,35 +697,14 @@ void DebugRenderEndFrame()
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void DebugAddWorldSphere(Vec3 const& position, float radius, float duration, Rgba8 const& startColor, Rgba8 const& endColor, DebugRenderMode mode)
+void DebugAddWorldSphere(Vec3 const& center, float radius, float duration, Rgba8 const& startColor, Rgba8 const& endColor, DebugRenderMode mode)
 {
 	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
 
-	DebugWorldObject debugPointObject;
-	debugPointObject.m_mode = mode;
-	debugPointObject.m_rasterMode = RasterizerMode::SOLID_CULL_BACK;
-	debugPointObject.m_startColor = startColor;
-	debugPointObject.m_endColor = endColor;
-	debugPointObject.m_duration = duration;
-	debugPointObject.m_timer = Timer(duration, &Clock::GetSystemClock());
-	debugPointObject.m_timer.Start();
+	Mat44 transform = Mat44::MakeTranslation3D(center);
+	transform.AppendScaleUniform3D(radius);
 
-	AddVertsForSphere3D(debugPointObject.m_verts, position, radius, debugPointObject.m_startColor, AABB2::ZERO_TO_ONE, 32, 16);
-
-#if defined(USING_DX12)
-	debugPointObject.m_debugObjPipelineState = m_debugRenderConfig.m_renderer->CreateOrGetPipelineStateObject(nullptr, nullptr, InputLayoutType::VERTEX_PCU,
-																											  debugPointObject.m_rasterMode, BlendMode::OPAQUE,
-																											  DepthMode::READ_WRITE_LESS_EQUAL);
-#endif
-
-	if(debugPointObject.m_duration != 0.f)
-	{
-		m_debugWorldObjects.push_back(debugPointObject);
-	}
-	else
-	{
-		m_debugWorldObjectsEveryframe.push_back(debugPointObject);
-	}
+	m_debugWorldObjects.Add(DebugMeshType::UNIT_SPHERE, transform, duration, startColor, endColor, mode, RasterizerMode::SOLID_CULL_BACK);
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -788,32 +712,10 @@ void DebugAddWorldWireframeSphere(Vec3 const& center, float radius, float durati
 {
 	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
 
-	DebugWorldObject debugSphereObject;
-	debugSphereObject.m_mode = mode;
-	debugSphereObject.m_rasterMode = RasterizerMode::WIREFRAME_CULL_BACK;
-	debugSphereObject.m_startColor = startColor;
-	debugSphereObject.m_endColor = endColor;
-	debugSphereObject.m_duration = duration;
-	debugSphereObject.m_timer = Timer(duration, &Clock::GetSystemClock());
-	debugSphereObject.m_timer.Start();
-
-#if defined(USING_DX12)
-	debugSphereObject.m_debugObjPipelineState = m_debugRenderConfig.m_renderer->CreateOrGetPipelineStateObject(nullptr, nullptr, InputLayoutType::VERTEX_PCU,
-																												debugSphereObject.m_rasterMode, BlendMode::OPAQUE,
-																												DepthMode::READ_WRITE_LESS_EQUAL);
-#endif
-
-
-	AddVertsForSphere3D(debugSphereObject.m_verts, center, radius, debugSphereObject.m_startColor, AABB2::ZERO_TO_ONE, 32, 16);
+	Mat44 transform = Mat44::MakeTranslation3D(center);
+	transform.AppendScaleUniform3D(radius);
 
-	if(debugSphereObject.m_duration != 0.f)
-	{
-		m_debugWorldObjects.push_back(debugSphereObject);
-	}
-	else
-	{
-		m_debugWorldObjectsEveryframe.push_back(debugSphereObject);
-	}
+	m_debugWorldObjects.Add(DebugMeshType::UNIT_SPHERE, transform, duration, startColor, endColor, mode, RasterizerMode::WIREFRAME_CULL_BACK);
 }
 
 //------------------------------------------------------------------------------------------------------------------
@@ -821,31 +723,10 @@ void DebugAddWorldBox(Vec3 const& boxMins, Vec3 const& boxMaxs, float duration,
 {
 	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
 
-	DebugWorldObject debugBoxObject;
-	debugBoxObject.m_mode = mode;
-	debugBoxObject.m_rasterMode = RasterizerMode::SOLID_CULL_BACK;
-	debugBoxObject.m_startColor = startColor;
-	debugBoxObject.m_endColor = endColor;
-	debugBoxObject.m_duration = duration;
-	debugBoxObject.m_timer = Timer(duration, &Clock::GetSystemClock());
-	debugBoxObject.m_timer.Start();
-
-#if defined(USING_DX12)
-	debugBoxObject.m_debugObjPipelineState = m_debugRenderConfig.m_renderer->CreateOrGetPipelineStateObject(nullptr, nullptr, InputLayoutType::VERTEX_PCU,
-																												debugBoxObject.m_rasterMode, BlendMode::OPAQUE,
-																												DepthMode::READ_WRITE_LESS_EQUAL);
-#endif
-
-	AddVertsForAABB3D(debugBoxObject.m_verts, AABB3(boxMins, boxMaxs), startColor);
+	Mat44 transform = Mat44::MakeTranslation3D(boxMins);
+	transform.AppendScaleNonUniform3D(boxMaxs - boxMins);
 
-	if(debugBoxObject.m_duration != 0.f)
-	{
-		m_debugWorldObjects.push_back(debugBoxObject);
-	}
-	else
-	{
-		m_debugWorldObjectsEveryframe.push_back(debugBoxObject);
-	}
+	m_debugWorldObjects.Add(DebugMeshType::UNIT_BOX, transform, duration, startColor, endColor, mode, RasterizerMode::SOLID_CULL_BACK);
 }
 
 //------------------------------------------------------------------------------------------------------------------
@@ -853,31 +734,10 @@ void DebugAddWorldWireframeBox(Vec3 const& boxMins, Vec3 const& boxMaxs, float d
 {
 	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
 
-	DebugWorldObject debugBoxObject;
-	debugBoxObject.m_mode = mode;
-	debugBoxObject.m_rasterMode = RasterizerMode::WIREFRAME_CULL_BACK;
-	debugBoxObject.m_startColor = startColor;
-	debugBoxObject.m_endColor = endColor;
-	debugBoxObject.m_duration = duration;
-	debugBoxObject.m_timer = Timer(duration, &Clock::GetSystemClock());
-	debugBoxObject.m_timer.Start();
+	Mat44 transform = Mat44::MakeTranslation3D(boxMins);
+	transform.AppendScaleNonUniform3D(boxMaxs - boxMins);
 
-#if defined(USING_DX12)
-	debugBoxObject.m_debugObjPipelineState = m_debugRenderConfig.m_renderer->CreateOrGetPipelineStateObject(nullptr, nullptr, InputLayoutType::VERTEX_PCU,
-																												debugBoxObject.m_rasterMode, BlendMode::OPAQUE,
-																												DepthMode::READ_WRITE_LESS_EQUAL);
-#endif
-
-	AddVertsForAABB3D(debugBoxObject.m_verts, AABB3(boxMins, boxMaxs), startColor);
-
-	if(debugBoxObject.m_duration != 0.f)
-	{
-		m_debugWorldObjects.push_back(debugBoxObject);
-	}
-	else
-	{
-		m_debugWorldObjectsEveryframe.push_back(debugBoxObject);
-	}
+	m_debugWorldObjects.Add(DebugMeshType::UNIT_BOX, transform, duration, startColor, endColor, mode, RasterizerMode::WIREFRAME_CULL_BACK);
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -885,44 +745,9 @@ void DebugAddWorldCylinder(Vec3 const& start, float height, float radius, float
 {
 	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
 
-	DebugWorldObject debugCylinderObject;
-	debugCylinderObject.m_mode = mode;
-	debugCylinderObject.m_rasterMode = RasterizerMode::SOLID_CULL_BACK;
-	debugCylinderObject.m_startColor = startColor;
-	debugCylinderObject.m_endColor = endColor;
-	debugCylinderObject.m_duration = duration;
-	debugCylinderObject.m_timer = Timer(duration, &Clock::GetSystemClock());
-	debugCylinderObject.m_timer.Start();
-
-#if defined(USING_DX12)
-	debugCylinderObject.m_debugObjPipelineState = m_debugRenderConfig.m_renderer->CreateOrGetPipelineStateObject(nullptr, nullptr, InputLayoutType::VERTEX_PCU,
-																												 debugCylinderObject.m_rasterMode, BlendMode::OPAQUE,
-																											  DepthMode::READ_WRITE_LESS_EQUAL);
-#endif
-
-
-	AddVertsForCylinder3D(debugCylinderObject.m_verts, height, radius, debugCylinderObject.m_startColor, AABB2::ZERO_TO_ONE, 16);
-
-	Vec3 endPosition = start + height * Vec3(0.f, 0.f, 1.f);
-
-	Mat44 lookAtMatrix = GetLookAtTransform(start, endPosition);
-
-	Mat44 translationMatrix = Mat44::MakeTranslation3D(start);
-
-	lookAtMatrix.SetTranslation3D(start);
-
-	TransformVertexArray3D(debugCylinderObject.m_verts, lookAtMatrix);
-
-
-	if(debugCylinderObject.m_duration != 0.f)
-	{
-		m_debugWorldObjects.push_back(debugCylinderObject);
-	}
-	else
-	{
-		m_debugWorldObjectsEveryframe.push_back(debugCylinderObject);
-	}
+	Mat44 transform = MakeDebugAxialTransform(start, Vec3(0.f, 0.f, 1.f), height, radius);
 
+	m_debugWorldObjects.Add(DebugMeshType::UNIT_CYLINDER, transform, duration, startColor, endColor, mode, RasterizerMode::SOLID_CULL_BACK);
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -930,44 +755,9 @@ void DebugAddWorldWireframeCylinder(Vec3 const& start, float height, float radiu
 {
 	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
 
-	DebugWorldObject debugCylinderObject;
-	debugCylinderObject.m_mode = mode;
-	debugCylinderObject.m_rasterMode = RasterizerMode::WIREFRAME_CULL_BACK;
-	debugCylinderObject.m_startColor = startColor;
-	debugCylinderObject.m_endColor = endColor;
-	debugCylinderObject.m_duration = duration;
-	debugCylinderObject.m_timer = Timer(duration, &Clock::GetSystemClock());
-	debugCylinderObject.m_timer.Start();
-
-#if defined(USING_DX12)
-	debugCylinderObject.m_debugObjPipelineState = m_debugRenderConfig.m_renderer->CreateOrGetPipelineStateObject(nullptr, nullptr, InputLayoutType::VERTEX_PCU,
-																												 debugCylinderObject.m_rasterMode, BlendMode::OPAQUE,
-																												 DepthMode::READ_WRITE_LESS_EQUAL);
-#endif
-
-
-	AddVertsForCylinder3D(debugCylinderObject.m_verts, height, radius, debugCylinderObject.m_startColor, AABB2::ZERO_TO_ONE, 16);
-
-	Vec3 endPosition = start + height * Vec3(0.f, 0.f, 1.f);
-
-	Mat44 lookAtMatrix = GetLookAtTransform(start, endPosition);
-
-	Mat44 translationMatrix = Mat44::MakeTranslation3D(start);
-
-	lookAtMatrix.SetTranslation3D(start);
-
-	TransformVertexArray3D(debugCylinderObject.m_verts, lookAtMatrix);
-
-
-	if(debugCylinderObject.m_duration != 0.f)
-	{
-		m_debugWorldObjects.push_back(debugCylinderObject);
-	}
-	else
-	{
-		m_debugWorldObjectsEveryframe.push_back(debugCylinderObject);
-	}
+	Mat44 transform = MakeDebugAxialTransform(start, Vec3(0.f, 0.f, 1.f), height, radius);
 
+	m_debugWorldObjects.Add(DebugMeshType::UNIT_CYLINDER, transform, duration, startColor, endColor, mode, RasterizerMode::WIREFRAME_CULL_BACK);
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -975,42 +765,9 @@ void DebugAddWorldLine(Vec3 const& start, Vec3 const& fwdNormal, float height, f
 {
 	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
 
-	DebugWorldObject debugLineObject;
-	debugLineObject.m_mode = mode;
-	debugLineObject.m_rasterMode = RasterizerMode::SOLID_CULL_BACK;
-	debugLineObject.m_startColor = color;
-	debugLineObject.m_endColor = color;
-	debugLineObject.m_duration = duration;
-	debugLineObject.m_timer = Timer(duration, &Clock::GetSystemClock());
-	debugLineObject.m_timer.Start();
-
-#if defined(USING_DX12)
-	debugLineObject.m_debugObjPipelineState = m_debugRenderConfig.m_renderer->CreateOrGetPipelineStateObject(nullptr, nullptr, InputLayoutType::VERTEX_PCU,
-																											 debugLineObject.m_rasterMode, BlendMode::OPAQUE,
-																												DepthMode::READ_WRITE_LESS_EQUAL);
-#endif
-
-
-	AddVertsForCylinder3D(debugLineObject.m_verts, height, radius, debugLineObject.m_startColor, AABB2::ZERO_TO_ONE, 16);
-
-	Vec3 endPosition = start + height * fwdNormal;
-
-	Mat44 lookAtMatrix = GetLookAtTransform(start, endPosition);
-
-	lookAtMatrix.SetTranslation3D(start);
-
-	TransformVertexArray3D(debugLineObject.m_verts, lookAtMatrix);
-
-
-	if(debugLineObject.m_duration != 0.f)
-	{
-		m_debugWorldObjects.push_back(debugLineObject);
-	}
-	else
-	{
-		m_debugWorldObjectsEveryframe.push_back(debugLineObject);
-	}
+	Mat44 transform = MakeDebugAxialTransform(start, fwdNormal, height, radius);
 
+	m_debugWorldObjects.Add(DebugMeshType::UNIT_CYLINDER, transform, duration, color, color, mode, RasterizerMode::SOLID_CULL_BACK);
 }
 
 
@@ -1019,34 +776,9 @@ void DebugAddWorldWireframeArrow(Vec3 const& start, Vec3 const& fwdNormal, float
 {
 	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
 
-	DebugWorldObject debugArrowObject;
-	debugArrowObject.m_mode = mode;
-	debugArrowObject.m_rasterMode = RasterizerMode::WIREFRAME_CULL_BACK;
-	debugArrowObject.m_startColor = color;
-	debugArrowObject.m_endColor = color;
-	debugArrowObject.m_duration = duration;
-	debugArrowObject.m_timer = Timer(duration, &Clock::GetSystemClock());
-	debugArrowObject.m_timer.Start();
-
-#if defined(USING_DX12)
-	debugArrowObject.m_debugObjPipelineState = m_debugRenderConfig.m_renderer->CreateOrGetPipelineStateObject(nullptr, nullptr, InputLayoutType::VERTEX_PCU,
-																											  debugArrowObject.m_rasterMode, BlendMode::OPAQUE,
-																												 DepthMode::READ_WRITE_LESS_EQUAL);
-#endif
-
-
-	AddVertsForArrow3D(debugArrowObject.m_verts, start, fwdNormal, height, radius, debugArrowObject.m_startColor, AABB2::ZERO_TO_ONE, 32);
-
-
-	if(debugArrowObject.m_duration != 0.f)
-	{
-		m_debugWorldObjects.push_back(debugArrowObject);
-	}
-	else
-	{
-		m_debugWorldObjectsEveryframe.push_back(debugArrowObject);
-	}
+	Mat44 transform = MakeDebugAxialTransform(start, fwdNormal, height, radius);
 
+	m_debugWorldObjects.Add(DebugMeshType::UNIT_WIREFRAME_ARROW, transform, duration, color, color, mode, RasterizerMode::WIREFRAME_CULL_BACK);
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -1054,33 +786,9 @@ void DebugAddWorldArrow(Vec3 const& start, Vec3 const& fwdNormal, float height,
 {
 	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
 
-	DebugWorldObject debugArrowObject;
-	debugArrowObject.m_mode = mode;
-	debugArrowObject.m_rasterMode = RasterizerMode::SOLID_CULL_BACK;
-	debugArrowObject.m_startColor = color;
-	debugArrowObject.m_endColor = color;
-	debugArrowObject.m_duration = duration;
-	debugArrowObject.m_timer = Timer(duration, &Clock::GetSystemClock());
-	debugArrowObject.m_timer.Start();
-
-#if defined(USING_DX12)
-	debugArrowObject.m_debugObjPipelineState = m_debugRenderConfig.m_renderer->CreateOrGetPipelineStateObject(nullptr, nullptr, InputLayoutType::VERTEX_PCU,
-																											  debugArrowObject.m_rasterMode, BlendMode::OPAQUE,
-																											  DepthMode::READ_WRITE_LESS_EQUAL);
-#endif
-
+	Mat44 transform = MakeDebugAxialTransform(start, fwdNormal, height, radius);
 
-	AddVertsForArrow3D(debugArrowObject.m_verts, start, fwdNormal, height, radius, debugArrowObject.m_startColor, AABB2::ZERO_TO_ONE, 16);
-
-
-	if(debugArrowObject.m_duration != 0.f)
-	{
-		m_debugWorldObjects.push_back(debugArrowObject);
-	}
-	else
-	{
-		m_debugWorldObjectsEveryframe.push_back(debugArrowObject);
-	}
+	m_debugWorldObjects.Add(DebugMeshType::UNIT_ARROW, transform, duration, color, color, mode, RasterizerMode::SOLID_CULL_BACK);
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -1116,36 +824,10 @@ void DebugAddWorldText(std::string const& text, Mat44 const& transform, float te
 
 	BitmapFont* textFont = m_debugRenderConfig.m_renderer->CreateOrGetBitmapFontWithFontName(m_debugRenderConfig.m_fontName);
 
-	DebugWorldObject billboardText;
-	billboardText.m_mode = mode;
-	billboardText.m_rasterMode = RasterizerMode::SOLID_CULL_NONE;
-	billboardText.m_startColor = startColor;
-	billboardText.m_endColor = endColor;
-	billboardText.m_duration = duration;
-	billboardText.m_timer = Timer(duration, &Clock::GetSystemClock());
-	billboardText.m_timer.Start();
-	billboardText.m_isText = true;
-	billboardText.m_isBillboarded = false;
-	billboardText.m_transform = transform;
-	billboardText.m_texture = &textFont->GetTexture();
+	int index = m_debugWorldObjects.Add(DebugMeshType::CUSTOM, transform, duration, startColor, endColor, mode, RasterizerMode::SOLID_CULL_NONE);
+	m_debugWorldObjects.m_textures[index] = &textFont->GetTexture();
 
-#if defined(USING_DX12)
-	billboardText.m_debugObjPipelineState = m_debugRenderConfig.m_renderer->CreateOrGetPipelineStateObject(nullptr, nullptr, InputLayoutType::VERTEX_PCU,
-																										   billboardText.m_rasterMode, BlendMode::OPAQUE,
-																											  DepthMode::READ_WRITE_LESS_EQUAL);
-#endif
-
-
-	textFont->AddVertsForText3DAtOriginXForward(billboardText.m_verts, textHeight, text, billboardText.m_startColor, 1.f, alignment);
-
-	if(billboardText.m_duration != 0.f)
-	{
-		m_debugWorldObjects.push_back(billboardText);
-	}
-	else
-	{
-		m_debugWorldObjectsEveryframe.push_back(billboardText);
-	}
+	textFont->AddVertsForText3DAtOriginXForward(m_debugWorldObjects.m_customVerts[index], textHeight, text, startColor, 1.f, alignment);
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -1155,36 +837,12 @@ void DebugAddWorldBillboardText(std::string const& text, Vec3 const& position, f
 
 	BitmapFont* textFont = m_debugRenderConfig.m_renderer->CreateOrGetBitmapFontWithFontName(m_debugRenderConfig.m_fontName);
 
-	DebugWorldObject billboardText;
-	billboardText.m_mode = mode;
-	billboardText.m_rasterMode = RasterizerMode::SOLID_CULL_NONE;
-	billboardText.m_startColor = startColor;
-	billboardText.m_endColor = endColor;
-	billboardText.m_duration = duration;
-	billboardText.m_timer = Timer(duration, &Clock::GetSystemClock());
-	billboardText.m_timer.Start();
-	billboardText.m_isText = true;
-	billboardText.m_isBillboarded = true;
-	billboardText.m_position = position;
-	billboardText.m_texture = &textFont->GetTexture();
-
-#if defined(USING_DX12)
-	billboardText.m_debugObjPipelineState = m_debugRenderConfig.m_renderer->CreateOrGetPipelineStateObject(nullptr, nullptr, InputLayoutType::VERTEX_PCU,
-																										   billboardText.m_rasterMode, BlendMode::OPAQUE,
-																										   DepthMode::READ_WRITE_LESS_EQUAL);
-#endif
-
+	int index = m_debugWorldObjects.Add(DebugMeshType::CUSTOM, Mat44(), duration, startColor, endColor, mode, RasterizerMode::SOLID_CULL_NONE);
+	m_debugWorldObjects.m_textures[index] = &textFont->GetTexture();
+	m_debugWorldObjects.m_billboardPositions[index] = position;
+	m_debugWorldObjects.m_isBillboarded[index] = 1;
 
-	textFont->AddVertsForText3DAtOriginXForward(billboardText.m_verts, textHeight, text, billboardText.m_startColor, 1.f, alignment);
-
-	if(billboardText.m_duration != 0.f)
-	{
-		m_debugWorldObjects.push_back(billboardText);
-	}
-	else
-	{
-		m_debugWorldObjectsEveryframe.push_back(billboardText);
-	}
+	textFont->AddVertsForText3DAtOriginXForward(m_debugWorldObjects.m_customVerts[index], textHeight, text, startColor, 1.f, alignment);
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -1194,70 +852,36 @@ void DebugAddScreenText(std::string text, AABB2 textBox, float cellHeight, Vec2
 
 	BitmapFont* textFont = m_debugRenderConfig.m_renderer->CreateOrGetBitmapFontWithFontName(m_debugRenderConfig.m_fontName);
 
-	DebugScreenObject screenText;
-	screenText.m_startColor = color;
-	screenText.m_endColor = color;
-	screenText.m_texture = &textFont->GetTexture();
-	screenText.m_duration = duration;
-	screenText.m_timer = Timer(duration, &Clock::GetSystemClock());
-	screenText.m_timer.Start();
-	screenText.m_text = text;
-
-#if defined(USING_DX12)
-	screenText.m_debugObjPipelineState = m_debugRenderConfig.m_renderer->CreateOrGetPipelineStateObject(nullptr, nullptr, InputLayoutType::VERTEX_PCU,
-																										   RasterizerMode::SOLID_CULL_BACK, BlendMode::OPAQUE,
-																										   DepthMode::DISABLED);
-#endif
-
-
-	textFont->AddVertsForTextInBox2D(screenText.m_verts, text, textBox, cellHeight, color, cellAspect, alignment, SHRINK_TO_FIT);
-	
-	m_debugScreenObjects.push_back(screenText);
+	int index = m_debugScreenObjects.Add(duration, color, color, &textFont->GetTexture());
 
+	s_debugTextMeshCache.AddVertsForTextInBox2D(m_debugScreenObjects.m_verts[index], *textFont, text, textBox, cellHeight, color, cellAspect, alignment, SHRINK_TO_FIT);
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void DebugAddMessage(std::string text, float duration, Rgba8 color)
-{	
+{
 	std::scoped_lock<std::recursive_mutex> lock(g_debugMutex);
 
 	BitmapFont* textFont = m_debugRenderConfig.m_renderer->CreateOrGetBitmapFontWithFontName(m_debugRenderConfig.m_fontName);
 
-	DebugScreenObject screenText;
-	screenText.m_startColor = color;
-	screenText.m_endColor = color;
-	screenText.m_texture = &textFont->GetTexture();
-	screenText.m_text = text;
-	screenText.m_timer = Timer(duration, &Clock::GetSystemClock());
-	screenText.m_duration = duration;
-	screenText.m_timer.Start();
-
-#if defined(USING_DX12)
-	screenText.m_debugObjPipelineState = m_debugRenderConfig.m_renderer->CreateOrGetPipelineStateObject(nullptr, nullptr, InputLayoutType::VERTEX_PCU,
-																										RasterizerMode::SOLID_CULL_BACK, BlendMode::OPAQUE,
-																										DepthMode::DISABLED);
-#endif
-
-
-	float width = textFont->GetTextWidth(12.f, text);
-	AABB2 textBox;
-	textBox.m_mins = Vec2(0.f, 0.f);
-	textBox.m_maxs = Vec2(textBox.m_mins.x + width, textBox.m_mins.y + 12.f);
-	textFont->AddVertsForTextInBox2D(screenText.m_verts, text, textBox, 12.f, color, 1.f);
+	DebugScreenObjectList* messages = &m_debugScreenMessagesEveryFrame;
 
 	if(duration > 0.f)
 	{
-		m_debugScreenFiniteMessages.push_back(screenText);
+		messages = &m_debugScreenFiniteMessages;
 	}
 	if(duration < 0.f)
 	{
-		m_debugScreenInfiniteMessages.push_back(screenText);
-	}	
-	if(duration == 0.f)
-	{
-		m_debugScreenMessagesEveryFrame.push_back(screenText);
+		messages = &m_debugScreenInfiniteMessages;
 	}
 
+	int index = messages->Add(duration, color, color, &textFont->GetTexture());
+
+	float width = textFont->GetTextWidth(12.f, text);
+	AABB2 textBox;
+	textBox.m_mins = Vec2(0.f, 0.f);
+	textBox.m_maxs = Vec2(textBox.m_mins.x + width, textBox.m_mins.y + 12.f);
+	s_debugTextMeshCache.AddVertsForTextInBox2D(messages->m_verts[index], *textFont, text, textBox, 12.f, color, 1.f);
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
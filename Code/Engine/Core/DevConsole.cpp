@@ -18,6 +18,8 @@
 
 #include "Game/EngineBuildPreferences.hpp"
 
+#include <stdarg.h>
+
 //------------------------------------------------------------------------------------------------------------------
 DevConsole* g_devConsole = nullptr;
 
@@ -40,6 +42,8 @@ const Rgba8 DevConsole::TEXT_HIGHLIGHT	= Rgba8(0, 255, 150, 255);
 //------------------------------------------------------------------------------------------------------------------
 DevConsole::DevConsole(DevConsoleConfig const& config)
 	: m_config(config)
+	, m_logRing(config.m_logRingCapacity)
+	, m_minLogSeverity(config.m_minLogSeverity)
 {
 	m_commandHistory.reserve(m_config.m_maxCommandHistory);
 }
@@ -51,6 +55,10 @@ DevConsole::~DevConsole()
 //------------------------------------------------------------------------------------------------------------------
 void DevConsole::Startup()
 {
+	if(!m_config.m_logFilePath.empty())
+	{
+		m_logFileWriter.Startup(m_config.m_logFilePath, m_config.m_logFileMaxPendingBytes);
+	}
 
 	m_insertionPointBlinkTimer = new Timer(0.6);
 	m_insertionPointBlinkTimer->Start();
@@ -73,11 +81,17 @@ void DevConsole::Shutdown()
 	g_eventSystem->UnsubscribeEventCallbackFunction("Clear", DevConsole::OnClearEvent);
 	g_eventSystem->UnsubscribeEventCallbackFunction("Help", DevConsole::OnHelpEvent);
 	g_eventSystem->UnsubscribeEventCallbackFunction("Echo", DevConsole::OnEchoEvent);
+
+	FlushPendingLines();
+	m_logFileWriter.Shutdown();
 }
 
 //------------------------------------------------------------------------------------------------------------------
 void DevConsole::BeginFrame()
 {
+	FlushPendingLines();
+	m_frameNumber.fetch_add(1, std::memory_order_relaxed);
+
 	m_config.m_devConsoleCamera.m_mode = Camera::eMode_Orthographic;
 	
 	m_config.m_devConsoleCamera.m_viewportBounds.m_mins = Vec2::ZERO;
@@ -100,42 +114,210 @@ void DevConsole::Execute(std::string const& consoleCommandText)
 {
 	std::scoped_lock<std::recursive_mutex> lock(m_devConsoleMutex);
 
-	std::vector<std::string> lines = SplitStringOnDelimiter(consoleCommandText, '\n');
-	
-	for(int line = 0; line < static_cast<int>(lines.size()); ++line)
+	// the scratch script keeps its capacity between calls; a command that executes more text re-entrantly gets its own
+	if(m_executeDepth > 0)
 	{
-		
-		std::vector<std::string> words = SplitStringOnDelimiter(lines[line], ' ');
+		ConsoleScript nestedScript;
+		CompileScript(consoleCommandText, nestedScript);
+		ExecuteScript(nestedScript);
+		return;
+	}
 
-		EventArgs args;
+	m_scratchScript.Clear();
+	CompileScript(consoleCommandText, m_scratchScript);
+	ExecuteScript(m_scratchScript);
+}
 
-		for(int word = 1; word < static_cast<int>(words.size()); ++word)
-		{
+//------------------------------------------------------------------------------------------------------------------
+ConsoleCommandId DevConsole::RegisterCommand(std::string const& name, ConsoleCommandFunction function, std::vector<ConsoleArgDefinition> const& argDefinitions, std::string const& description)
+{
+	std::scoped_lock<std::recursive_mutex> lock(m_devConsoleMutex);
 
-			std::vector<std::string> keyValuePair = SplitStringOnDelimiter(words[word], '=');
-			args.SetValue(keyValuePair[0], keyValuePair[1]);
+	return m_commandTable.RegisterCommand(name, function, argDefinitions, description);
+}
 
-		}
+//------------------------------------------------------------------------------------------------------------------
+void DevConsole::UnregisterCommand(std::string const& name)
+{
+	std::scoped_lock<std::recursive_mutex> lock(m_devConsoleMutex);
+
+	m_commandTable.UnregisterCommand(name);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool DevConsole::CompileScript(std::string const& scriptText, ConsoleScript& out_script)
+{
+	std::scoped_lock<std::recursive_mutex> lock(m_devConsoleMutex);
+
+	m_scratchCompileErrors.clear();
+
+	if(m_commandTable.Compile(scriptText, out_script, m_scratchCompileErrors))
+	{
+		return true;
+	}
+
+	for(int errorIndex = 0; errorIndex < static_cast<int>(m_scratchCompileErrors.size()); ++errorIndex)
+	{
+		AddLine(ERROR, m_scratchCompileErrors[errorIndex], LogSeverity::WARNING);
+	}
 
-		FireEvent(words[0], args);
+	return false;
+}
 
+//------------------------------------------------------------------------------------------------------------------
+void DevConsole::ExecuteScript(ConsoleScript const& script)
+{
+	std::scoped_lock<std::recursive_mutex> lock(m_devConsoleMutex);
+
+	++m_executeDepth;
+	m_commandTable.Execute(script);
+	--m_executeDepth;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool DevConsole::ExecuteScriptFile(std::string const& filePath)
+{
+	std::string scriptText;
+
+	if(!FileReadToString(scriptText, filePath))
+	{
+		AddLine(ERROR, Stringf("Could not read console script %s", filePath.c_str()), LogSeverity::WARNING);
+		return false;
 	}
 
+	ConsoleScript script;
+	bool wasCompiled = CompileScript(scriptText, script);
+
+	ExecuteScript(script);
+
+	return wasCompiled;
 }
 
 //------------------------------------------------------------------------------------------------------------------
-void DevConsole::AddLine(Rgba8 const& color, std::string const& text)
+bool DevConsole::IsValidCommandLine(std::string const& commandLine) const
 {
 	std::scoped_lock<std::recursive_mutex> lock(m_devConsoleMutex);
 
-	DevConsoleLine line;
+	size_t nameStart = commandLine.find_first_not_of(" \t");
+
+	if(nameStart == std::string::npos)
+	{
+		return false;
+	}
+
+	size_t nameEnd = commandLine.find_first_of(" \t", nameStart);
+	std::string commandName = commandLine.substr(nameStart, nameEnd == std::string::npos ? std::string::npos : nameEnd - nameStart);
+
+	if(m_commandTable.FindCommandId(commandName) != INVALID_CONSOLE_COMMAND_ID)
+	{
+		return true;
+	}
+
+	return g_eventSystem->m_subscriptionListByEventName.find(commandName) != g_eventSystem->m_subscriptionListByEventName.end();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void DevConsole::AddLine(Rgba8 const& color, std::string const& text, LogSeverity severity)
+{
+	if(!IsLogSeverityEnabled(severity))
+	{
+		return;
+	}
+
+	m_logRing.TryPush(severity, color, text.c_str(), text.length(), GetCurrentTimeSeconds(), m_frameNumber.load(std::memory_order_relaxed));
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void DevConsole::AddLinef(LogSeverity severity, Rgba8 const& color, char const* format, ...)
+{
+	// filtered lines never pay for formatting
+	if(!IsLogSeverityEnabled(severity))
+	{
+		return;
+	}
+
+	char text[LOG_ENTRY_MAX_TEXT_LENGTH];
+	va_list variableArgumentList;
+	va_start(variableArgumentList, format);
+	int textLength = vsnprintf(text, LOG_ENTRY_MAX_TEXT_LENGTH, format, variableArgumentList);
+	va_end(variableArgumentList);
+
+	if(textLength < 0)
+	{
+		return;
+	}
+
+	textLength = GetMin(textLength, LOG_ENTRY_MAX_TEXT_LENGTH - 1);
+
+	m_logRing.TryPush(severity, color, text, static_cast<size_t>(textLength), GetCurrentTimeSeconds(), m_frameNumber.load(std::memory_order_relaxed));
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool DevConsole::IsLogSeverityEnabled(LogSeverity severity) const
+{
+	return severity >= m_minLogSeverity.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void DevConsole::SetMinLogSeverity(LogSeverity severity)
+{
+	m_minLogSeverity.store(severity, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Main thread only. Moves everything pushed since the last flush into the line history (and the log file, if mirroring).
+void DevConsole::FlushPendingLines()
+{
+	LogEntry entry;
+	bool addedLines = false;
+
+	while(m_logRing.TryPop(entry))
+	{
+		DevConsoleLine line;
+
+		line.m_text.assign(entry.m_text, entry.m_textLength);
+		line.m_color		= entry.m_color;
+		line.m_timestamp	= entry.m_timestamp;
+		line.m_frameNumber	= entry.m_frameNumber;
+		line.m_severity		= entry.m_severity;
+
+		m_lines.push_back(std::move(line));
+
+		if(m_logFileWriter.IsRunning())
+		{
+			m_logFileWriter.Enqueue(entry);
+		}
 
-	line.m_text = text;
-	line.m_color = color;
-	line.m_timestamp = GetCurrentTimeSeconds();
-	line.m_frameNumber = m_frameNumber;
+		addedLines = true;
+	}
+
+	unsigned int numDroppedEntries = m_logRing.ResetNumDroppedEntries();
 
-	m_lines.push_back(line);
+	if(numDroppedEntries > 0)
+	{
+		DevConsoleLine line;
+
+		line.m_text			= Stringf("[Dev Console] Log ring full, %u lines dropped", numDroppedEntries);
+		line.m_color		= WARNING;
+		line.m_timestamp	= GetCurrentTimeSeconds();
+		line.m_frameNumber	= m_frameNumber.load(std::memory_order_relaxed);
+		line.m_severity		= LogSeverity::WARNING;
+
+		m_lines.push_back(std::move(line));
+		addedLines = true;
+	}
+
+	if(!addedLines)
+	{
+		return;
+	}
+
+	if(m_config.m_maxLines > 0 && static_cast<int>(m_lines.size()) > m_config.m_maxLines)
+	{
+		m_lines.erase(m_lines.begin(), m_lines.end() - m_config.m_maxLines);
+	}
+
+	m_logFileWriter.Flush();
 
 	m_lineRenderStartIndex = static_cast<int>(m_lines.size()) - 1;
 }
@@ -342,14 +524,7 @@ bool DevConsole::OnKeyPressedEvent(EventArgs& args)
 				return true;
 			}
 
-			Rgba8 textColor = DevConsole::INFO_MAJOR;
-
-			auto result = g_eventSystem->m_subscriptionListByEventName.find(g_devConsole->m_inputText);
-
-			if(result == g_eventSystem->m_subscriptionListByEventName.end())
-			{
-				textColor = DevConsole::INVALID_INPUT;
-			}
+			Rgba8 textColor = g_devConsole->IsValidCommandLine(g_devConsole->m_inputText) ? DevConsole::INFO_MAJOR : DevConsole::INVALID_INPUT;
 
 			g_devConsole->AddLine(textColor, g_devConsole->m_inputText);
 			
@@ -447,6 +622,8 @@ bool DevConsole::OnClearEvent(EventArgs& args)
 		return false;
 	}
 
+	// anything still in flight was logged before the clear
+	g_devConsole->FlushPendingLines();
 	g_devConsole->m_lines.clear();
 	g_devConsole->m_lineRenderStartIndex = 0;
 	return true;
@@ -469,6 +646,33 @@ bool DevConsole::OnHelpEvent(EventArgs& args)
 		{
 			g_devConsole->AddLine(INFO_MINOR, g_eventSystem->m_eventList[i]);
 		}
+
+		ConsoleCommandTable const& commandTable = g_devConsole->m_commandTable;
+
+		for(int commandId = 0; commandId < commandTable.GetNumCommands(); ++commandId)
+		{
+			ConsoleCommandDefinition const* definition = commandTable.GetCommandDefinition(commandId);
+
+			if(!definition)
+			{
+				continue;
+			}
+
+			std::string usage = definition->m_name;
+
+			for(int slot = 0; slot < static_cast<int>(definition->m_argDefinitions.size()); ++slot)
+			{
+				ConsoleArgDefinition const& argDefinition = definition->m_argDefinitions[slot];
+				usage += Stringf(argDefinition.m_isRequired ? " %s=<%s>" : " [%s=<%s>]", argDefinition.m_name.c_str(), GetConsoleArgTypeName(argDefinition.m_type));
+			}
+
+			if(!definition->m_description.empty())
+			{
+				usage += " - " + definition->m_description;
+			}
+
+			g_devConsole->AddLine(INFO_MINOR, usage);
+		}
 		return true;
 	}
 
@@ -589,7 +793,7 @@ void DevConsole::Render_OpenFull(AABB2 const& bounds, DX12Renderer& renderer, Bi
 		Vec2 mins = Vec2(bounds.m_mins.x, bounds.m_mins.y + (i * m_config.m_fontSize) + m_config.m_fontSize);
 		Vec2 maxs = Vec2(bounds.m_maxs.x, mins.y + (bounds.m_maxs.y / numLinesToRender));
 
-		font.AddVertsForTextInBox2D(textVerts, currentLine.m_text, AABB2(mins, maxs), m_config.m_fontSize, currentLine.m_color, fontAspect, Vec2(0.f, 0.f), SHRINK_TO_FIT);
+		m_textMeshCache.AddVertsForTextInBox2D(textVerts, font, currentLine.m_text, AABB2(mins, maxs), m_config.m_fontSize, currentLine.m_color, fontAspect, Vec2(0.f, 0.f), SHRINK_TO_FIT);
 	}
 
 
@@ -693,7 +897,7 @@ void DevConsole::Render_OpenFull(AABB2 const& bounds, Renderer& renderer, Bitmap
 		Vec2 mins = Vec2(bounds.m_mins.x, bounds.m_mins.y + (i * m_config.m_fontSize) + m_config.m_fontSize);
 		Vec2 maxs = Vec2(bounds.m_maxs.x, mins.y + (bounds.m_maxs.y / numLinesToRender));
 
-		font.AddVertsForTextInBox2D(textVerts, currentLine.m_text, AABB2(mins, maxs), m_config.m_fontSize, currentLine.m_color, fontAspect, Vec2(0.f, 0.f), SHRINK_TO_FIT);
+		m_textMeshCache.AddVertsForTextInBox2D(textVerts, font, currentLine.m_text, AABB2(mins, maxs), m_config.m_fontSize, currentLine.m_color, fontAspect, Vec2(0.f, 0.f), SHRINK_TO_FIT);
 	}
 
 	renderer.BindTexture(&font.GetTexture());
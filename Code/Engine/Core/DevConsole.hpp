@@ -3,12 +3,16 @@
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/Clock.hpp"
+#include "Engine/Core/ConsoleCommandTable.hpp"
+#include "Engine/Core/LogRing.hpp"
 #include "Engine/Renderer/Camera.hpp"
+#include "Engine/Renderer/TextMeshCache.hpp"
 #include "Game/EngineBuildPreferences.hpp"
 
 #include <string>
 #include <vector>
 #include <mutex>
+#include <atomic>
 
 #if defined ERROR
 #undef ERROR
@@ -30,6 +34,7 @@ struct DevConsoleLine
 	double		m_timestamp;
 	int			m_frameNumber;
 	Rgba8		m_color = Rgba8::WHITE;
+	LogSeverity	m_severity = LogSeverity::INFO;
 };
 
 //------------------------------------------------------------------------------------------------------------------
@@ -47,6 +52,13 @@ struct DevConsoleConfig
 	float			m_fontSize;
 	float			m_fontAspect;
 	float			m_numLinesToRender;
+
+	// Lines from any thread go through a lock-free ring of this many entries (power of two) and are drained once per frame.
+	unsigned int	m_logRingCapacity = 1024;
+	int				m_maxLines = 4096;
+	LogSeverity		m_minLogSeverity = LogSeverity::VERBOSE;
+	std::string		m_logFilePath;
+	size_t			m_logFileMaxPendingBytes = LOG_FILE_DEFAULT_MAX_PENDING_BYTES;	// lines beyond this, while the disk is busy, are dropped
 };
 
 //------------------------------------------------------------------------------------------------------------------
@@ -69,7 +81,20 @@ public:
 	void EndFrame();
 
 	void Execute(std::string const& consoleCommandText);
-	void AddLine(Rgba8 const& color, std::string const& text);
+
+	// Typed commands bypass the EventSystem. Scripts compiled once can be replayed without any re-parsing.
+	ConsoleCommandId	RegisterCommand(std::string const& name, ConsoleCommandFunction function, std::vector<ConsoleArgDefinition> const& argDefinitions = {}, std::string const& description = "");
+	void				UnregisterCommand(std::string const& name);
+	bool				CompileScript(std::string const& scriptText, ConsoleScript& out_script);
+	void				ExecuteScript(ConsoleScript const& script);
+	bool				ExecuteScriptFile(std::string const& filePath);
+	bool				IsValidCommandLine(std::string const& commandLine) const;
+
+	void AddLine(Rgba8 const& color, std::string const& text, LogSeverity severity = LogSeverity::INFO);
+	void AddLinef(LogSeverity severity, Rgba8 const& color, char const* format, ...);
+	bool IsLogSeverityEnabled(LogSeverity severity) const;
+	void SetMinLogSeverity(LogSeverity severity);
+	void FlushPendingLines();
 
 #if defined(USING_DX12)
 	void Render(AABB2 const& bounds, DX12Renderer* rendererOverride = nullptr) const;
@@ -114,14 +139,22 @@ protected:
 	DevConsoleConfig				m_config;
 	DevConsoleMode					m_mode = HIDDEN;
 	std::vector<DevConsoleLine>		m_lines;
-	int								m_frameNumber = 0;
+	LogRing							m_logRing;
+	LogFileWriter					m_logFileWriter;
+	std::atomic<LogSeverity>		m_minLogSeverity = LogSeverity::VERBOSE;
+	std::atomic<int>				m_frameNumber = 0;
 	std::string						m_inputText;
 	Timer*							m_insertionPointBlinkTimer = nullptr;
 	int								m_insertionPointPosition = 0;
 	bool							m_insertionPointVisible = true;
 	std::vector<std::string>		m_commandHistory;
+	ConsoleCommandTable				m_commandTable;
+	ConsoleScript					m_scratchScript;
+	Strings							m_scratchCompileErrors;
+	int								m_executeDepth = 0;
 	int								m_historyIndex = -1;
 	int								m_lineRenderStartIndex = 0;
 	mutable std::recursive_mutex	m_devConsoleMutex;
+	mutable TextMeshCache			m_textMeshCache;
 
 };
\ No newline at end of file
@@ -0,0 +1,299 @@
+#include "Engine/Core/LogRing.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+#include <cstring>
+
+//------------------------------------------------------------------------------------------------------------------
+LogRing::LogRing(unsigned int capacity)
+{
+	GUARANTEE_OR_DIE(capacity >= 2 && (capacity & (capacity - 1)) == 0, "LogRing capacity must be a power of two");
+
+	m_slots = new Slot[capacity];
+	m_capacityMask = capacity - 1;
+
+	for(unsigned int slotIndex = 0; slotIndex < capacity; ++slotIndex)
+	{
+		m_slots[slotIndex].m_sequence.store(slotIndex, std::memory_order_relaxed);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+LogRing::~LogRing()
+{
+	delete[] m_slots;
+	m_slots = nullptr;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool LogRing::TryPush(LogSeverity severity, Rgba8 const& color, char const* text, size_t textLength, double timestamp, int frameNumber)
+{
+	unsigned int position = m_enqueuePosition.load(std::memory_order_relaxed);
+	Slot* slot = nullptr;
+
+	for(;;)
+	{
+		slot = &m_slots[position & m_capacityMask];
+		unsigned int sequence = slot->m_sequence.load(std::memory_order_acquire);
+		int difference = static_cast<int>(sequence - position);
+
+		if(difference == 0)
+		{
+			// slot is free for this position, claim it
+			if(m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if(difference < 0)
+		{
+			// consumer has not caught up, ring is full
+			m_numDroppedEntries.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		else
+		{
+			position = m_enqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	LogEntry& entry = slot->m_entry;
+
+	size_t numCharsToCopy = textLength < static_cast<size_t>(LOG_ENTRY_MAX_TEXT_LENGTH - 1) ? textLength : static_cast<size_t>(LOG_ENTRY_MAX_TEXT_LENGTH - 1);
+	memcpy(entry.m_text, text, numCharsToCopy);
+	entry.m_text[numCharsToCopy] = '\0';
+
+	entry.m_textLength	= static_cast<unsigned short>(numCharsToCopy);
+	entry.m_severity	= severity;
+	entry.m_color		= color;
+	entry.m_timestamp	= timestamp;
+	entry.m_frameNumber	= frameNumber;
+
+	slot->m_sequence.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool LogRing::TryPop(LogEntry& out_entry)
+{
+	unsigned int position = m_dequeuePosition.load(std::memory_order_relaxed);
+	Slot* slot = nullptr;
+
+	for(;;)
+	{
+		slot = &m_slots[position & m_capacityMask];
+		unsigned int sequence = slot->m_sequence.load(std::memory_order_acquire);
+		int difference = static_cast<int>(sequence - (position + 1));
+
+		if(difference == 0)
+		{
+			if(m_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if(difference < 0)
+		{
+			// nothing published at this position yet
+			return false;
+		}
+		else
+		{
+			position = m_dequeuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	LogEntry const& entry = slot->m_entry;
+
+	out_entry.m_timestamp	= entry.m_timestamp;
+	out_entry.m_frameNumber	= entry.m_frameNumber;
+	out_entry.m_color		= entry.m_color;
+	out_entry.m_severity	= entry.m_severity;
+	out_entry.m_textLength	= entry.m_textLength;
+	memcpy(out_entry.m_text, entry.m_text, static_cast<size_t>(entry.m_textLength) + 1);
+
+	// hand the slot back to producers one lap ahead
+	slot->m_sequence.store(position + m_capacityMask + 1, std::memory_order_release);
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+unsigned int LogRing::GetCapacity() const
+{
+	return m_capacityMask + 1;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+unsigned int LogRing::GetNumDroppedEntries() const
+{
+	return m_numDroppedEntries.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+unsigned int LogRing::ResetNumDroppedEntries()
+{
+	return m_numDroppedEntries.exchange(0, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+LogFileWriter::LogFileWriter()
+{}
+
+//------------------------------------------------------------------------------------------------------------------
+LogFileWriter::~LogFileWriter()
+{
+	Shutdown();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool LogFileWriter::Startup(std::string const& filePath, size_t maxPendingBytes)
+{
+	if(m_isRunning)
+	{
+		return true;
+	}
+
+	if(fopen_s(&m_file, filePath.c_str(), "wb") != 0 || m_file == nullptr)
+	{
+		ERROR_RECOVERABLE(Stringf("Could not open log file %s", filePath.c_str()));
+		m_file = nullptr;
+		return false;
+	}
+
+	m_maxPendingBytes = maxPendingBytes;
+	m_numUnreportedDroppedBytes = 0;
+	m_numDroppedBytes.store(0, std::memory_order_relaxed);
+	m_pendingText.clear();
+	m_pendingText.reserve(maxPendingBytes);
+
+	m_isRunning = true;
+	m_writerThread = std::thread(&LogFileWriter::ThreadMain, this);
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void LogFileWriter::Shutdown()
+{
+	{
+		std::scoped_lock<std::mutex> lock(m_writerMutex);
+
+		if(!m_isRunning)
+		{
+			return;
+		}
+
+		m_isRunning = false;
+	}
+
+	m_workAvailableCV.notify_all();
+
+	if(m_writerThread.joinable())
+	{
+		m_writerThread.join();
+	}
+
+	if(m_file)
+	{
+		fclose(m_file);
+		m_file = nullptr;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool LogFileWriter::IsRunning() const
+{
+	return m_isRunning;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void LogFileWriter::Enqueue(LogEntry const& entry)
+{
+	char header[64];
+	int headerLength = snprintf(header, sizeof(header), "[%10.4f][%6d][%s] ", entry.m_timestamp, entry.m_frameNumber, GetLogSeverityName(entry.m_severity));
+
+	size_t lineLength = static_cast<size_t>(headerLength) + entry.m_textLength + 1;
+
+	std::scoped_lock<std::mutex> lock(m_writerMutex);
+
+	if(m_pendingText.size() + lineLength > m_maxPendingBytes)
+	{
+		m_numUnreportedDroppedBytes += lineLength;
+		m_numDroppedBytes.fetch_add(lineLength, std::memory_order_relaxed);
+		return;
+	}
+
+	m_pendingText.append(header, static_cast<size_t>(headerLength));
+	m_pendingText.append(entry.m_text, entry.m_textLength);
+	m_pendingText.push_back('\n');
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void LogFileWriter::Flush()
+{
+	m_workAvailableCV.notify_one();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+size_t LogFileWriter::GetNumDroppedBytes() const
+{
+	return m_numDroppedBytes.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// The two strings swap back and forth, so once both have grown to m_maxPendingBytes nothing here allocates again.
+void LogFileWriter::ThreadMain()
+{
+	std::string textToWrite;
+	textToWrite.reserve(m_maxPendingBytes);
+
+	for(;;)
+	{
+		bool isRunning = true;
+		size_t numDroppedBytes = 0;
+
+		{
+			std::unique_lock<std::mutex> lock(m_writerMutex);
+			m_workAvailableCV.wait(lock, [this] { return !m_pendingText.empty() || !m_isRunning; });
+
+			textToWrite.swap(m_pendingText);
+			numDroppedBytes = m_numUnreportedDroppedBytes;
+			m_numUnreportedDroppedBytes = 0;
+			isRunning = m_isRunning;
+		}
+
+		if(!textToWrite.empty())
+		{
+			fwrite(textToWrite.data(), 1, textToWrite.size(), m_file);
+			textToWrite.clear();
+		}
+
+		// everything dropped arrived after the text just written, while that text filled the staging buffer
+		if(numDroppedBytes > 0)
+		{
+			char note[96];
+			int noteLength = snprintf(note, sizeof(note), "[LogFileWriter] %zu bytes of log dropped while the disk was busy\n", numDroppedBytes);
+			fwrite(note, 1, static_cast<size_t>(noteLength), m_file);
+		}
+
+		fflush(m_file);
+
+		if(!isRunning)
+		{
+			break;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+char const* GetLogSeverityName(LogSeverity severity)
+{
+	switch(severity)
+	{
+		case LogSeverity::VERBOSE:	return "VERBOSE";
+		case LogSeverity::INFO:		return "INFO";
+		case LogSeverity::WARNING:	return "WARNING";
+		case LogSeverity::CRITICAL:	return "CRITICAL";
+		default:					return "UNKNOWN";
+	}
+}
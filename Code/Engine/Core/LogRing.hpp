@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Engine/Core/Rgba8.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------
+constexpr int LOG_ENTRY_MAX_TEXT_LENGTH = 512;
+constexpr size_t LOG_FILE_DEFAULT_MAX_PENDING_BYTES = 256 * 1024;
+
+//------------------------------------------------------------------------------------------------------------------
+enum class LogSeverity : unsigned char
+{
+	VERBOSE,
+	INFO,
+	WARNING,
+	CRITICAL,
+	NUM_LOG_SEVERITIES
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Fixed size so the ring never allocates after construction. Text longer than LOG_ENTRY_MAX_TEXT_LENGTH - 1 is truncated.
+struct LogEntry
+{
+	double			m_timestamp = 0.0;
+	int				m_frameNumber = 0;
+	Rgba8			m_color = Rgba8::WHITE;
+	LogSeverity		m_severity = LogSeverity::INFO;
+	unsigned short	m_textLength = 0;
+	char			m_text[LOG_ENTRY_MAX_TEXT_LENGTH] = {};
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Bounded multi-producer ring buffer (per-slot sequence numbers, no locks).
+// Any thread may push; the owner drains it, normally once per frame. When the ring is full new entries are dropped
+// and counted rather than blocking the producer.
+class LogRing
+{
+public:
+	explicit LogRing(unsigned int capacity = 1024);
+	~LogRing();
+
+	LogRing(LogRing const& copy) = delete;
+	LogRing& operator=(LogRing const& copy) = delete;
+
+	bool			TryPush(LogSeverity severity, Rgba8 const& color, char const* text, size_t textLength, double timestamp, int frameNumber);
+	bool			TryPop(LogEntry& out_entry);
+
+	unsigned int	GetCapacity() const;
+	unsigned int	GetNumDroppedEntries() const;
+	unsigned int	ResetNumDroppedEntries();
+
+private:
+	struct Slot
+	{
+		std::atomic<unsigned int>	m_sequence = 0;
+		LogEntry					m_entry;
+	};
+
+	Slot*						m_slots = nullptr;
+	unsigned int				m_capacityMask = 0;
+
+	alignas(64) std::atomic<unsigned int>	m_enqueuePosition = 0;
+	alignas(64) std::atomic<unsigned int>	m_dequeuePosition = 0;
+	alignas(64) std::atomic<unsigned int>	m_numDroppedEntries = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Appends drained log lines to a file from a background thread so disk I/O never stalls the frame.
+// Lines wait in a staging buffer of at most maxPendingBytes while the thread is busy writing. If the disk falls that
+// far behind, further lines are dropped and their bytes counted; the file gets a note saying how much went missing.
+class LogFileWriter
+{
+public:
+	LogFileWriter();
+	~LogFileWriter();
+
+	bool	Startup(std::string const& filePath, size_t maxPendingBytes = LOG_FILE_DEFAULT_MAX_PENDING_BYTES);
+	void	Shutdown();
+	bool	IsRunning() const;
+
+	void	Enqueue(LogEntry const& entry);
+	void	Flush();
+
+	size_t	GetNumDroppedBytes() const;		// since Startup
+
+private:
+	void	ThreadMain();
+
+private:
+	FILE*						m_file = nullptr;
+	std::thread					m_writerThread;
+	std::mutex					m_writerMutex;
+	std::condition_variable		m_workAvailableCV;
+	std::string					m_pendingText;
+	size_t						m_maxPendingBytes = LOG_FILE_DEFAULT_MAX_PENDING_BYTES;
+	size_t						m_numUnreportedDroppedBytes = 0;
+	std::atomic<size_t>			m_numDroppedBytes = 0;
+	bool						m_isRunning = false;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+char const* GetLogSeverityName(LogSeverity severity);
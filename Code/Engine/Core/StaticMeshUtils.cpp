@@ -9,6 +9,9 @@
 #include "Engine/Math/Vec3.hpp"
 #include "Engine/Math/IntVec3.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/BVH3.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/ConvexHull3.hpp"
 
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Renderer/DX12Renderer.hpp"
@@ -380,3 +383,53 @@ void AddVertsForOBJMesh(std::string const& meshData, std::vector<Vertex_PCUTBN>&
 
 	CalculateTangentSpaceBasisVectors(verts, indexes, computeTangents, computeNormals);
 }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Raycasts against the mesh should go through this instead of looping over m_indexes.
+void BuildMeshBVHForStaticMesh(StaticMesh const& mesh, MeshBVH3& out_meshBVH, JobSystem* jobSystem)
+{
+	std::vector<Vec3> positions;
+	positions.reserve(mesh.m_pcutbnVerts.size());
+	for(int vertIndex = 0; vertIndex < static_cast<int>(mesh.m_pcutbnVerts.size()); ++vertIndex)
+	{
+		positions.push_back(mesh.m_pcutbnVerts[vertIndex].m_position);
+	}
+
+	out_meshBVH.Build(positions, mesh.m_indexes, jobSystem);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Bounds of the mesh in its own space, for culling. Transform them with the instance to get world bounds.
+AABB3 GetLocalBoundsForStaticMesh(StaticMesh const& mesh)
+{
+	if(mesh.m_pcutbnVerts.empty())
+	{
+		return AABB3();
+	}
+
+	Vec3 mins = mesh.m_pcutbnVerts[0].m_position;
+	Vec3 maxs = mins;
+	for(int vertIndex = 1; vertIndex < static_cast<int>(mesh.m_pcutbnVerts.size()); ++vertIndex)
+	{
+		Vec3 const& position = mesh.m_pcutbnVerts[vertIndex].m_position;
+		mins = Vec3(GetMin(mins.x, position.x), GetMin(mins.y, position.y), GetMin(mins.z, position.z));
+		maxs = Vec3(GetMax(maxs.x, position.x), GetMax(maxs.y, position.y), GetMax(maxs.z, position.z));
+	}
+
+	return AABB3(mins, maxs);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Cheap collision proxy for the mesh in its own space, enclosing every vertex. Meant for cook time; flat meshes that do
+// not span a volume return false.
+bool BuildConvexHullForStaticMesh(StaticMesh const& mesh, ConvexHull3& out_hull, int maxVertexes, float faceMergeDegrees)
+{
+	std::vector<Vec3> positions;
+	positions.reserve(mesh.m_pcutbnVerts.size());
+	for(int vertIndex = 0; vertIndex < static_cast<int>(mesh.m_pcutbnVerts.size()); ++vertIndex)
+	{
+		positions.push_back(mesh.m_pcutbnVerts[vertIndex].m_position);
+	}
+
+	return BuildConvexHull3FromPoints(positions, out_hull, maxVertexes, faceMergeDegrees);
+}
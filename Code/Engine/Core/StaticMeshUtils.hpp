@@ -7,10 +7,17 @@ struct Vertex_PCUTBN;
 class StaticMesh;
 class Renderer;
 class DX12Renderer;
+class MeshBVH3;
+struct AABB3;
+struct ConvexHull3;
+class JobSystem;
 
 void AddVertsForOBJMesh(std::string const& meshData, std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes);
 bool LoadStaticMeshFileFromXML(std::string const& meshFilePath);
 void CalculateTangentSpaceBasisVectors(std::vector<Vertex_PCUTBN>& vertexes, std::vector<unsigned int>& indexes, bool computeTangents, bool computeNormals);
+void BuildMeshBVHForStaticMesh(StaticMesh const& mesh, MeshBVH3& out_meshBVH, JobSystem* jobSystem = nullptr);
+AABB3 GetLocalBoundsForStaticMesh(StaticMesh const& mesh);
+bool BuildConvexHullForStaticMesh(StaticMesh const& mesh, ConvexHull3& out_hull, int maxVertexes = 32, float faceMergeDegrees = 3.f);
 
 #if defined (USING_DX12)
 void LoadGLTFTextures(tinygltf::Material const& material, StaticMesh* mesh, tinygltf::Model& model, DX12Renderer* renderer, std::string const& texturePath);
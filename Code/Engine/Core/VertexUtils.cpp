@@ -16,6 +16,10 @@
 #include "Engine/Math/Mat44.hpp"
 #include "Engine/Math/Triangle2.hpp"
 #include "Engine/Core/DebugRender.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/BatchTransformUtils.hpp"
+#include "Engine/JobSystem/JobSystem.hpp"
+#include "Engine/JobSystem/Job.hpp"
 #include <cstdint>
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void TransformVertexArrayXY3D(int numVerts, Vertex_PCU* verts, float uniformScaleXY, float rotationDegreesAboutZ, Vec2 const& translationXY)
@@ -44,41 +48,189 @@ void TransformVertexArrayXY3D(std::vector<Vertex_PCU>& verts, float uniformScale
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void TransformVertexArray3D(std::vector<Vertex_PCU>& verts, Mat44 const& transform, float scale)
+// Vertices are gathered into SoA blocks small enough to stay in L1, transformed by the batch kernels, then scattered back.
+constexpr int VERTEX_TRANSFORM_BLOCK_SIZE = 256;
+constexpr int MIN_VERTS_PER_TRANSFORM_JOB = 32768;
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static void TransformVertexRange(BatchTransform3D const& transform, int numVerts, Vertex_PCU* verts, bool transformTBN)
 {
-	for(int vertex = 0; vertex < static_cast<int>(verts.size()); ++vertex)
+	UNUSED(transformTBN);
+
+	float xs[VERTEX_TRANSFORM_BLOCK_SIZE];
+	float ys[VERTEX_TRANSFORM_BLOCK_SIZE];
+	float zs[VERTEX_TRANSFORM_BLOCK_SIZE];
+
+	for(int blockStart = 0; blockStart < numVerts; blockStart += VERTEX_TRANSFORM_BLOCK_SIZE)
 	{
-		Vec3& position = verts[vertex].m_position;
+		int blockSize = GetMin(VERTEX_TRANSFORM_BLOCK_SIZE, numVerts - blockStart);
+		Vertex_PCU* blockVerts = verts + blockStart;
 
-		position *= scale;
+		for(int index = 0; index < blockSize; ++index)
+		{
+			xs[index] = blockVerts[index].m_position.x;
+			ys[index] = blockVerts[index].m_position.y;
+			zs[index] = blockVerts[index].m_position.z;
+		}
 
-		position = transform.TransformPosition3D(position);
+		TransformPositionsSoA(transform, blockSize, xs, ys, zs);
+
+		for(int index = 0; index < blockSize; ++index)
+		{
+			blockVerts[index].m_position = Vec3(xs[index], ys[index], zs[index]);
+		}
 	}
 }
+
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void TransformVertexArray3D(std::vector<Vertex_PCUTBN>& verts, Mat44 const& transform, float scale, bool transformTBN)
+static void TransformVertexRange(BatchTransform3D const& transform, int numVerts, Vertex_PCUTBN* verts, bool transformTBN)
 {
-	for(int vertex = 0; vertex < static_cast<int>(verts.size()); ++vertex)
+	bool needsTBN = transformTBN && !transform.m_isTranslationOnly;
+
+	float xs[VERTEX_TRANSFORM_BLOCK_SIZE];
+	float ys[VERTEX_TRANSFORM_BLOCK_SIZE];
+	float zs[VERTEX_TRANSFORM_BLOCK_SIZE];
+
+	for(int blockStart = 0; blockStart < numVerts; blockStart += VERTEX_TRANSFORM_BLOCK_SIZE)
 	{
-		Vec3& position = verts[vertex].m_position;
+		int blockSize = GetMin(VERTEX_TRANSFORM_BLOCK_SIZE, numVerts - blockStart);
+		Vertex_PCUTBN* blockVerts = verts + blockStart;
 
-		position *= scale;
+		for(int index = 0; index < blockSize; ++index)
+		{
+			xs[index] = blockVerts[index].m_position.x;
+			ys[index] = blockVerts[index].m_position.y;
+			zs[index] = blockVerts[index].m_position.z;
+		}
+		TransformPositionsSoA(transform, blockSize, xs, ys, zs);
+		for(int index = 0; index < blockSize; ++index)
+		{
+			blockVerts[index].m_position = Vec3(xs[index], ys[index], zs[index]);
+		}
 
-		position = transform.TransformPosition3D(position);
+		if(!needsTBN)
+		{
+			continue;
+		}
 
-		if(transformTBN)
+		for(int index = 0; index < blockSize; ++index)
+		{
+			xs[index] = blockVerts[index].m_tangent.x;
+			ys[index] = blockVerts[index].m_tangent.y;
+			zs[index] = blockVerts[index].m_tangent.z;
+		}
+		TransformTangentsSoA(transform, blockSize, xs, ys, zs);
+		for(int index = 0; index < blockSize; ++index)
 		{
-			Vec3& tangent = verts[vertex].m_tangent;
-			Vec3& bitangent = verts[vertex].m_bitangent;
-			Vec3& normal = verts[vertex].m_normal;
+			blockVerts[index].m_tangent = Vec3(xs[index], ys[index], zs[index]);
+		}
 
-			tangent = transform.TransformPosition3D(tangent);
-			bitangent = transform.TransformPosition3D(bitangent);
-			normal = transform.TransformPosition3D(normal);
+		for(int index = 0; index < blockSize; ++index)
+		{
+			xs[index] = blockVerts[index].m_bitangent.x;
+			ys[index] = blockVerts[index].m_bitangent.y;
+			zs[index] = blockVerts[index].m_bitangent.z;
+		}
+		TransformTangentsSoA(transform, blockSize, xs, ys, zs);
+		for(int index = 0; index < blockSize; ++index)
+		{
+			blockVerts[index].m_bitangent = Vec3(xs[index], ys[index], zs[index]);
+		}
+
+		for(int index = 0; index < blockSize; ++index)
+		{
+			xs[index] = blockVerts[index].m_normal.x;
+			ys[index] = blockVerts[index].m_normal.y;
+			zs[index] = blockVerts[index].m_normal.z;
+		}
+		TransformNormalsSoA(transform, blockSize, xs, ys, zs);
+		for(int index = 0; index < blockSize; ++index)
+		{
+			blockVerts[index].m_normal = Vec3(xs[index], ys[index], zs[index]);
 		}
 	}
 }
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+template<typename VertexType>
+class VertexTransformJob : public Job
+{
+public:
+	virtual void Execute() override
+	{
+		TransformVertexRange(*m_transform, m_numVerts, m_verts, m_transformTBN);
+	}
+
+public:
+	BatchTransform3D const*	m_transform = nullptr;
+	VertexType*				m_verts = nullptr;
+	int						m_numVerts = 0;
+	bool					m_transformTBN = false;
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+template<typename VertexType>
+static void DispatchVertexTransform(BatchTransform3D const& transform, int numVerts, VertexType* verts, bool transformTBN, JobSystem* jobSystem)
+{
+	std::vector<int> chunkStarts;
+	SplitIntoJobRanges(0, numVerts, MIN_VERTS_PER_TRANSFORM_JOB, jobSystem, chunkStarts);
+
+	int numChunks = static_cast<int>(chunkStarts.size()) - 1;
+	if(numChunks == 1)
+	{
+		TransformVertexRange(transform, numVerts, verts, transformTBN);
+		return;
+	}
+
+	std::vector<VertexTransformJob<VertexType>> jobs(numChunks);
+	for(int chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex)
+	{
+		VertexTransformJob<VertexType>& job = jobs[chunkIndex];
+		job.m_transform = &transform;
+		job.m_verts = verts + chunkStarts[chunkIndex];
+		job.m_numVerts = chunkStarts[chunkIndex + 1] - chunkStarts[chunkIndex];
+		job.m_transformTBN = transformTBN;
+	}
+
+	jobSystem->ExecuteJobsAndWait(jobs);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void TransformVertexArray3D(std::vector<Vertex_PCU>& verts, Mat44 const& transform, float scale, JobSystem* jobSystem)
+{
+	TransformVertexArray3D(static_cast<int>(verts.size()), verts.data(), transform, scale, jobSystem);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void TransformVertexArray3D(std::vector<Vertex_PCUTBN>& verts, Mat44 const& transform, float scale, bool transformTBN, JobSystem* jobSystem)
+{
+	TransformVertexArray3D(static_cast<int>(verts.size()), verts.data(), transform, scale, transformTBN, jobSystem);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void TransformVertexArray3D(int numVerts, Vertex_PCU* verts, Mat44 const& transform, float scale, JobSystem* jobSystem)
+{
+	if(numVerts <= 0)
+	{
+		return;
+	}
+
+	BatchTransform3D batchTransform = BatchTransform3D::MakeFromMat44(transform, scale);
+	DispatchVertexTransform(batchTransform, numVerts, verts, false, jobSystem);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void TransformVertexArray3D(int numVerts, Vertex_PCUTBN* verts, Mat44 const& transform, float scale, bool transformTBN, JobSystem* jobSystem)
+{
+	if(numVerts <= 0)
+	{
+		return;
+	}
+
+	BatchTransform3D batchTransform = BatchTransform3D::MakeFromMat44(transform, scale);
+	DispatchVertexTransform(batchTransform, numVerts, verts, transformTBN, jobSystem);
+}
+
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void TransformVertexArray3DForPartialVector(std::vector<Vertex_PCU>& verts, Mat44 const& transform, int startPos, int endPos)
 {
@@ -1277,13 +1429,20 @@ void AddVertsForZCylinder3D(std::vector<Vertex_PCU>& verts, Cylinder3D const& cy
 		int topRightPointIndex = (sliceIndex + 1) % numSlices;
 		int topLeftPointIndex = sliceIndex;
 
+		float currentSine;
+		float currentCosine;
+		float nextSine;
+		float nextCosine;
+		SinCosDegrees(currentYawAngle, currentSine, currentCosine);
+		SinCosDegrees(currentYawAngle + angleChangePerSlice, nextSine, nextCosine);
+
 		Vec2 currentFaceUVs;
-		currentFaceUVs.x = (UVs.m_maxs.x - UVs.m_mins.x) * (0.5f * CosDegrees(currentYawAngle) + 0.5f);
-		currentFaceUVs.y = (UVs.m_maxs.y - UVs.m_mins.y) * (0.5f * SinDegrees(currentYawAngle) + 0.5f);
+		currentFaceUVs.x = (UVs.m_maxs.x - UVs.m_mins.x) * (0.5f * currentCosine + 0.5f);
+		currentFaceUVs.y = (UVs.m_maxs.y - UVs.m_mins.y) * (0.5f * currentSine + 0.5f);
 
 		Vec2 nextFaceUVs;
-		nextFaceUVs.x = (UVs.m_maxs.x - UVs.m_mins.x) * (0.5f * CosDegrees(currentYawAngle + angleChangePerSlice) + 0.5f);
-		nextFaceUVs.y = (UVs.m_maxs.y - UVs.m_mins.y) * (0.5f * SinDegrees(currentYawAngle + angleChangePerSlice) + 0.5f);
+		nextFaceUVs.x = (UVs.m_maxs.x - UVs.m_mins.x) * (0.5f * nextCosine + 0.5f);
+		nextFaceUVs.y = (UVs.m_maxs.y - UVs.m_mins.y) * (0.5f * nextSine + 0.5f);
 
 	
 		// bottom face
@@ -1350,13 +1509,20 @@ void AddVertsForIndexedZCylinder3D(std::vector<Vertex_PCUTBN>& verts, std::vecto
 		int topRightPointIndex		= (sliceIndex + 1) % numSlices;
 		int topLeftPointIndex		= sliceIndex;
 
+		float currentSine;
+		float currentCosine;
+		float nextSine;
+		float nextCosine;
+		SinCosDegrees(currentYawAngle, currentSine, currentCosine);
+		SinCosDegrees(currentYawAngle + angleChangePerSlice, nextSine, nextCosine);
+
 		Vec2 currentFaceUVs;
-		currentFaceUVs.x = (UVs.m_maxs.x - UVs.m_mins.x) * (0.5f * CosDegrees(currentYawAngle) + 0.5f);
-		currentFaceUVs.y = (UVs.m_maxs.y - UVs.m_mins.y) * (0.5f * SinDegrees(currentYawAngle) + 0.5f);
+		currentFaceUVs.x = (UVs.m_maxs.x - UVs.m_mins.x) * (0.5f * currentCosine + 0.5f);
+		currentFaceUVs.y = (UVs.m_maxs.y - UVs.m_mins.y) * (0.5f * currentSine + 0.5f);
 
 		Vec2 nextFaceUVs;
-		nextFaceUVs.x = (UVs.m_maxs.x - UVs.m_mins.x) * (0.5f * CosDegrees(currentYawAngle + angleChangePerSlice) + 0.5f);
-		nextFaceUVs.y = (UVs.m_maxs.y - UVs.m_mins.y) * (0.5f * SinDegrees(currentYawAngle + angleChangePerSlice) + 0.5f);
+		nextFaceUVs.x = (UVs.m_maxs.x - UVs.m_mins.x) * (0.5f * nextCosine + 0.5f);
+		nextFaceUVs.y = (UVs.m_maxs.y - UVs.m_mins.y) * (0.5f * nextSine + 0.5f);
 
 		// bottom face
 		int bottomFaceIndex = static_cast<unsigned int>(verts.size());
@@ -1548,13 +1714,20 @@ void AddVertsForIndexedCone3D(std::vector<Vertex_PCUTBN>& verts, std::vector<uns
 		int bottomLeftPointIndex	= sliceIndex;
 		int bottomRightPointIndex	= (sliceIndex + 1) % numSlices;
 
+		float currentSine;
+		float currentCosine;
+		float nextSine;
+		float nextCosine;
+		SinCosDegrees(currentPitchAngle, currentSine, currentCosine);
+		SinCosDegrees(currentPitchAngle + angleChangePerSlice, nextSine, nextCosine);
+
 		Vec2 currentFaceUVs;
-		currentFaceUVs.x = (UVs.m_maxs.x - UVs.m_mins.x) * (0.5f * CosDegrees(currentPitchAngle) + 0.5f);
-		currentFaceUVs.y = (UVs.m_maxs.y - UVs.m_mins.y) * (0.5f * SinDegrees(currentPitchAngle) + 0.5f);
+		currentFaceUVs.x = (UVs.m_maxs.x - UVs.m_mins.x) * (0.5f * currentCosine + 0.5f);
+		currentFaceUVs.y = (UVs.m_maxs.y - UVs.m_mins.y) * (0.5f * currentSine + 0.5f);
 
 		Vec2 nextFaceUVs;
-		nextFaceUVs.x = (UVs.m_maxs.x - UVs.m_mins.x) * (0.5f * CosDegrees(currentPitchAngle + angleChangePerSlice) + 0.5f);
-		nextFaceUVs.y = (UVs.m_maxs.y - UVs.m_mins.y) * (0.5f * SinDegrees(currentPitchAngle + angleChangePerSlice) + 0.5f);
+		nextFaceUVs.x = (UVs.m_maxs.x - UVs.m_mins.x) * (0.5f * nextCosine + 0.5f);
+		nextFaceUVs.y = (UVs.m_maxs.y - UVs.m_mins.y) * (0.5f * nextSine + 0.5f);
 
 		Vec3 posA = startPosition;
 		Vec3 posB = bottomLeftPoints[bottomRightPointIndex];
@@ -21,13 +21,19 @@ struct Cylinder3D;
 struct Ray3;
 struct Triangle2;
 struct Mat44;
+class JobSystem;
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void TransformVertexArrayXY3D(int numVerts, Vertex_PCU* verts, float uniformScaleXY, float rotationDegreesAboutZ, Vec2 const& translationXY);
 void TransformVertexArrayXY3D(std::vector<Vertex_PCU>& verts, float uniformScaleXY, float rotationDegreesAboutZ, Vec2 const& translationXY);
 
-void TransformVertexArray3D(std::vector<Vertex_PCU>& verts, Mat44 const& transform, float scale = 1.f);
-void TransformVertexArray3D(std::vector<Vertex_PCUTBN>& verts, Mat44 const& transform, float scale = 1.f, bool transformTBN = false);
+
+// Batched SoA transforms. Tangents and normals go through a precomputed normal matrix and are skipped for pure translations.
+// Passing a JobSystem splits large arrays across its workers; the call still returns only once every vertex is done.
+void TransformVertexArray3D(std::vector<Vertex_PCU>& verts, Mat44 const& transform, float scale = 1.f, JobSystem* jobSystem = nullptr);
+void TransformVertexArray3D(std::vector<Vertex_PCUTBN>& verts, Mat44 const& transform, float scale = 1.f, bool transformTBN = false, JobSystem* jobSystem = nullptr);
+void TransformVertexArray3D(int numVerts, Vertex_PCU* verts, Mat44 const& transform, float scale = 1.f, JobSystem* jobSystem = nullptr);
+void TransformVertexArray3D(int numVerts, Vertex_PCUTBN* verts, Mat44 const& transform, float scale = 1.f, bool transformTBN = false, JobSystem* jobSystem = nullptr);
 void TransformVertexArray3DForPartialVector(std::vector<Vertex_PCU>& verts, Mat44 const& transform, int startPos, int endPos);
 
 AABB2 GetVertexBounds(std::vector<Vertex_PCU>& verts);
@@ -93,6 +93,12 @@ unsigned int JobSystem::GetActiveThreads()
 	return count;
 }
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int JobSystem::GetNumWorkerThreads() const
+{
+	return static_cast<int>(m_workerThreads.size());
+}
+
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
 unsigned int JobSystem::GetNumPendingJobs()
 {
@@ -212,6 +218,21 @@ std::vector<Job*> JobSystem::RetrieveCompletedJobs()
 	return completedJobs;
 }
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void JobSystem::ExecuteOrWaitForJob(Job* job)
+{
+	if(CancelPendingJob(job))
+	{
+		job->Execute();
+		return;
+	}
+
+	while(!CheckAndRetrieveCompletedJob(job))
+	{
+		std::this_thread::yield();
+	}
+}
+
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
 Job* JobSystem::GetJobToExecute()
 {
@@ -241,3 +262,33 @@ void JobSystem::MoveJobToCompletedPile(Job* jobToMove)
 	}
 
 }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void SplitIntoJobRanges(int first, int end, int minPerRange, JobSystem const* jobSystem, std::vector<int>& out_rangeStarts, int granularity)
+{
+	int count = GetMax(end - first, 0);
+	int numRanges = 1;
+
+	if(jobSystem != nullptr)
+	{
+		int maxRanges = jobSystem->GetNumWorkerThreads() + 1;
+		numRanges = GetClamped(count / GetMax(minPerRange, 1), 1, maxRanges);
+	}
+
+	out_rangeStarts.clear();
+	out_rangeStarts.push_back(first);
+
+	for(int rangeIndex = 1; rangeIndex < numRanges; ++rangeIndex)
+	{
+		int offset = static_cast<int>((static_cast<int64_t>(count) * rangeIndex) / numRanges);
+		offset = (offset + granularity - 1) / granularity * granularity;
+
+		// rounding can swallow a whole range when the ranges are barely longer than granularity
+		if(offset > out_rangeStarts.back() - first && offset < count)
+		{
+			out_rangeStarts.push_back(first + offset);
+		}
+	}
+
+	out_rangeStarts.push_back(first + count);
+}
@@ -30,6 +30,7 @@ public:
 	void							EndFrame();
 
 	unsigned int					GetActiveThreads();
+	int								GetNumWorkerThreads() const;
 
 	unsigned int					GetNumPendingJobs();
 	unsigned int					GetNumExecutingJobs();
@@ -44,8 +45,16 @@ public:
 	Job*							RetrieveLastCompletedJob();
 	Job*							RetrieveEarliestCompletedJob();
 	std::vector<Job*>				RetrieveCompletedJobs();
+
+	// Fork/join over a caller-owned batch: queues jobs[1..], executes jobs[0] on the calling thread, then executes
+	// any job no worker has started yet instead of waiting for one. Returns once every job has run, so the batch
+	// never stalls on a JobSystem whose workers are busy elsewhere, and never leaves jobs in the completed pile.
+	template<typename JobType>
+	void							ExecuteJobsAndWait(std::vector<JobType>& jobs);
 	
 private:
+	void							ExecuteOrWaitForJob(Job* job);
+
 
 	// Called only by Worker Threads. Removes the oldest job in the job queue and adds it to the executing queue. Returns the same.
 	Job*							GetJobToExecute();
@@ -63,3 +72,32 @@ private:
 	std::mutex						m_jobMutex;
 	bool							m_isRunning = true;
 };
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Splits [first, end) into at most one range per thread that can run it (the JobSystem's workers plus the calling thread),
+// each at least minPerRange long, and writes the range starts followed by end. Range boundaries land on multiples of
+// granularity past first, so no two ranges share a SIMD group. A null jobSystem, or one without workers, gives one range.
+void SplitIntoJobRanges(int first, int end, int minPerRange, JobSystem const* jobSystem, std::vector<int>& out_rangeStarts, int granularity = 1);
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+template<typename JobType>
+void JobSystem::ExecuteJobsAndWait(std::vector<JobType>& jobs)
+{
+	if(jobs.empty())
+	{
+		return;
+	}
+
+	for(size_t jobIndex = 1; jobIndex < jobs.size(); ++jobIndex)
+	{
+		AddJob(&jobs[jobIndex]);
+	}
+
+	jobs[0].Execute();
+
+	// workers pull from the front of the queue, so reclaim from the back
+	for(size_t jobIndex = jobs.size() - 1; jobIndex > 0; --jobIndex)
+	{
+		ExecuteOrWaitForJob(&jobs[jobIndex]);
+	}
+}
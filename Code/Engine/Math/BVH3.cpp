@@ -0,0 +1,658 @@
+#include "Engine/Math/BVH3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/OBB3.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/JobSystem/Job.hpp"
+#include "Engine/JobSystem/JobSystem.hpp"
+
+#include <math.h>
+#include <float.h>
+#include <algorithm>
+
+//------------------------------------------------------------------------------------------------------------------
+constexpr int MAX_BVH_BUILD_DEPTH = BVH3::MAX_TRAVERSAL_DEPTH - 2;
+constexpr int MIN_PRIMS_PER_BVH_BUILD_JOB = 16384;
+constexpr float MIN_CENTROID_EXTENT = 1e-12f;
+
+//------------------------------------------------------------------------------------------------------------------
+// Build-time bounds kept as plain floats; AABB3 leaves its corners uninitialized and has no grow operation.
+//------------------------------------------------------------------------------------------------------------------
+struct BVHBuildBounds
+{
+	float m_mins[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+	float m_maxs[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+	void Grow(float const* mins, float const* maxs)
+	{
+		for(int axis = 0; axis < 3; ++axis)
+		{
+			m_mins[axis] = m_mins[axis] < mins[axis] ? m_mins[axis] : mins[axis];
+			m_maxs[axis] = m_maxs[axis] > maxs[axis] ? m_maxs[axis] : maxs[axis];
+		}
+	}
+
+	void Grow(BVHBuildBounds const& bounds)	{ Grow(bounds.m_mins, bounds.m_maxs); }
+
+	// half the surface area, which is all SAH needs
+	float GetHalfArea() const
+	{
+		float dx = m_maxs[0] - m_mins[0];
+		float dy = m_maxs[1] - m_mins[1];
+		float dz = m_maxs[2] - m_mins[2];
+		return dx < 0.f ? 0.f : dx * dy + dy * dz + dz * dx;
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct BVHBuildInput
+{
+	std::vector<BVHBuildBounds>	m_primBounds;
+	std::vector<Vec3>			m_centroids;
+	int*						m_primIndexes = nullptr;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// A subtree handed off to a job. Its root is written into m_nodeIndex of the main node array once the job finishes.
+struct BVHSubtreeTask
+{
+	int						m_nodeIndex = 0;
+	int						m_first = 0;
+	int						m_count = 0;
+	int						m_depth = 0;
+	std::vector<BVHNode3>	m_nodes;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+static float GetAxis(Vec3 const& vec, int axis)
+{
+	return axis == 0 ? vec.x : (axis == 1 ? vec.y : vec.z);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// A split plane between SAH bins. Partitioning recomputes the bin exactly as binning did, so the primitives that end up
+// on each side are the ones the cost was computed for.
+struct BVHSplit
+{
+	int		m_axis = 0;
+	int		m_lastLeftBin = 0;
+	float	m_axisMin = 0.f;
+	float	m_binScale = 0.f;
+
+	int GetBin(Vec3 const& centroid) const
+	{
+		return GetMin(static_cast<int>((GetAxis(centroid, m_axis) - m_axisMin) * m_binScale), BVH3::NUM_SAH_BINS - 1);
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct IsPrimLeftOfSplit
+{
+	std::vector<Vec3> const*	m_centroids;
+	BVHSplit					m_split;
+
+	bool operator()(int primIndex) const { return m_split.GetBin((*m_centroids)[primIndex]) <= m_split.m_lastLeftBin; }
+};
+
+//------------------------------------------------------------------------------------------------------------------
+static void SetNodeBounds(BVHNode3& node, BVHBuildBounds const& bounds)
+{
+	for(int axis = 0; axis < 3; ++axis)
+	{
+		node.m_mins[axis] = bounds.m_mins[axis];
+		node.m_maxs[axis] = bounds.m_maxs[axis];
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Finds the cheapest binned SAH split over all three axes. Returns false if the centroids cannot be separated.
+static bool FindBestSplit(BVHBuildInput const& input, int first, int count, BVHBuildBounds const& centroidBounds, BVHSplit& out_split)
+{
+	float bestCost = FLT_MAX;
+
+	for(int axis = 0; axis < 3; ++axis)
+	{
+		float axisMin = centroidBounds.m_mins[axis];
+		float extent = centroidBounds.m_maxs[axis] - axisMin;
+		if(extent <= MIN_CENTROID_EXTENT)
+		{
+			continue;
+		}
+
+		BVHSplit split;
+		split.m_axis = axis;
+		split.m_axisMin = axisMin;
+		split.m_binScale = static_cast<float>(BVH3::NUM_SAH_BINS) / extent;
+
+		BVHBuildBounds binBounds[BVH3::NUM_SAH_BINS];
+		int binCounts[BVH3::NUM_SAH_BINS] = {};
+
+		for(int slot = first; slot < first + count; ++slot)
+		{
+			int primIndex = input.m_primIndexes[slot];
+			int bin = split.GetBin(input.m_centroids[primIndex]);
+			binBounds[bin].Grow(input.m_primBounds[primIndex]);
+			++binCounts[bin];
+		}
+
+		// sweep from the right to get the cost of everything past each split plane, then from the left to finish it
+		float rightCosts[BVH3::NUM_SAH_BINS];
+		BVHBuildBounds rightBounds;
+		int rightCount = 0;
+		for(int bin = BVH3::NUM_SAH_BINS - 1; bin > 0; --bin)
+		{
+			rightBounds.Grow(binBounds[bin]);
+			rightCount += binCounts[bin];
+			rightCosts[bin] = static_cast<float>(rightCount) * rightBounds.GetHalfArea();
+		}
+
+		BVHBuildBounds leftBounds;
+		int leftCount = 0;
+		for(int bin = 0; bin < BVH3::NUM_SAH_BINS - 1; ++bin)
+		{
+			leftBounds.Grow(binBounds[bin]);
+			leftCount += binCounts[bin];
+			if(leftCount == 0 || leftCount == count)
+			{
+				continue;
+			}
+
+			float cost = static_cast<float>(leftCount) * leftBounds.GetHalfArea() + rightCosts[bin + 1];
+			if(cost < bestCost)
+			{
+				bestCost = cost;
+				out_split = split;
+				out_split.m_lastLeftBin = bin;
+			}
+		}
+	}
+
+	return bestCost < FLT_MAX;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Builds the subtree rooted at nodes[nodeIndex]. With out_tasks set, ranges of at most taskThreshold primitives are
+// left as placeholders for jobs instead of being built here.
+static void BuildBVHNode(BVHBuildInput& input, std::vector<BVHNode3>& nodes, int nodeIndex, int first, int count, int depth,
+						 int taskThreshold, std::vector<BVHSubtreeTask>* out_tasks)
+{
+	BVHBuildBounds bounds;
+	BVHBuildBounds centroidBounds;
+	for(int slot = first; slot < first + count; ++slot)
+	{
+		int primIndex = input.m_primIndexes[slot];
+		Vec3 const& centroid = input.m_centroids[primIndex];
+		float centroidArray[3] = { centroid.x, centroid.y, centroid.z };
+
+		bounds.Grow(input.m_primBounds[primIndex]);
+		centroidBounds.Grow(centroidArray, centroidArray);
+	}
+
+	SetNodeBounds(nodes[nodeIndex], bounds);
+	nodes[nodeIndex].m_leftOrFirst = first;
+	nodes[nodeIndex].m_count = count;
+
+	if(count <= BVH3::MAX_LEAF_PRIMS || depth >= MAX_BVH_BUILD_DEPTH)
+	{
+		return;
+	}
+
+	if(out_tasks != nullptr && count <= taskThreshold)
+	{
+		BVHSubtreeTask task;
+		task.m_nodeIndex = nodeIndex;
+		task.m_first = first;
+		task.m_count = count;
+		task.m_depth = depth;
+		out_tasks->push_back(task);
+		return;
+	}
+
+	int* primBegin = input.m_primIndexes + first;
+	int* primEnd = primBegin + count;
+
+	// if all centroids coincide no plane separates them, and any split is as good as another
+	int* primMid = primBegin + count / 2;
+	BVHSplit split;
+	if(FindBestSplit(input, first, count, centroidBounds, split))
+	{
+		primMid = std::partition(primBegin, primEnd, IsPrimLeftOfSplit{ &input.m_centroids, split });
+	}
+
+	int leftCount = static_cast<int>(primMid - primBegin);
+	int leftIndex = static_cast<int>(nodes.size());
+	nodes.resize(nodes.size() + 2);
+	nodes[nodeIndex].m_leftOrFirst = leftIndex;
+	nodes[nodeIndex].m_count = 0;
+
+	BuildBVHNode(input, nodes, leftIndex, first, leftCount, depth + 1, taskThreshold, out_tasks);
+	BuildBVHNode(input, nodes, leftIndex + 1, first + leftCount, count - leftCount, depth + 1, taskThreshold, out_tasks);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static void BuildBVHSubtree(BVHBuildInput& input, BVHSubtreeTask& task)
+{
+	task.m_nodes.resize(1);
+	BuildBVHNode(input, task.m_nodes, 0, task.m_first, task.m_count, task.m_depth, 0, nullptr);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+class BVHSubtreeJob : public Job
+{
+public:
+	virtual void Execute() override
+	{
+		BuildBVHSubtree(*m_input, *m_task);
+	}
+
+public:
+	BVHBuildInput*		m_input = nullptr;
+	BVHSubtreeTask*		m_task = nullptr;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// One job per subtree; the calling thread builds the first and takes back anything still queued.
+static void BuildBVHSubtrees(BVHBuildInput& input, std::vector<BVHSubtreeTask>& tasks, JobSystem* jobSystem)
+{
+	std::vector<BVHSubtreeJob> jobs(tasks.size());
+	for(int taskIndex = 0; taskIndex < static_cast<int>(tasks.size()); ++taskIndex)
+	{
+		jobs[taskIndex].m_input = &input;
+		jobs[taskIndex].m_task = &tasks[taskIndex];
+	}
+
+	jobSystem->ExecuteJobsAndWait(jobs);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Appends a finished subtree and patches its root into the placeholder. Local node i > 0 lands at base + i - 1, which
+// keeps sibling pairs adjacent and every child after its parent (Refit relies on that order).
+static void StitchBVHSubtree(std::vector<BVHNode3>& nodes, BVHSubtreeTask const& task)
+{
+	int base = static_cast<int>(nodes.size());
+	int numLocalNodes = static_cast<int>(task.m_nodes.size());
+
+	for(int localIndex = 0; localIndex < numLocalNodes; ++localIndex)
+	{
+		BVHNode3 node = task.m_nodes[localIndex];
+		if(!node.IsLeaf())
+		{
+			node.m_leftOrFirst = base + node.m_leftOrFirst - 1;
+		}
+
+		if(localIndex == 0)
+		{
+			nodes[task.m_nodeIndex] = node;
+		}
+		else
+		{
+			nodes.push_back(node);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void BVH3::Build(std::vector<AABB3> const& primBounds, JobSystem* jobSystem)
+{
+	Clear();
+
+	int numPrims = static_cast<int>(primBounds.size());
+	if(numPrims == 0)
+	{
+		return;
+	}
+
+	BVHBuildInput input;
+	input.m_primBounds.resize(numPrims);
+	input.m_centroids.resize(numPrims);
+	m_primIndexes.resize(numPrims);
+	input.m_primIndexes = m_primIndexes.data();
+
+	for(int primIndex = 0; primIndex < numPrims; ++primIndex)
+	{
+		AABB3 const& box = primBounds[primIndex];
+		BVHBuildBounds& bounds = input.m_primBounds[primIndex];
+		bounds.m_mins[0] = box.m_mins.x;	bounds.m_mins[1] = box.m_mins.y;	bounds.m_mins[2] = box.m_mins.z;
+		bounds.m_maxs[0] = box.m_maxs.x;	bounds.m_maxs[1] = box.m_maxs.y;	bounds.m_maxs[2] = box.m_maxs.z;
+
+		input.m_centroids[primIndex] = (box.m_mins + box.m_maxs) * 0.5f;
+		m_primIndexes[primIndex] = primIndex;
+	}
+
+	// a binary tree with leaves of one to MAX_LEAF_PRIMS primitives never needs more than 2n - 1 nodes
+	m_nodes.reserve(2 * numPrims - 1);
+	m_nodes.resize(1);
+
+	int numThreads = jobSystem != nullptr ? jobSystem->GetNumWorkerThreads() + 1 : 1;
+	if(numThreads <= 1 || numPrims < 2 * MIN_PRIMS_PER_BVH_BUILD_JOB)
+	{
+		BuildBVHNode(input, m_nodes, 0, 0, numPrims, 0, 0, nullptr);
+		return;
+	}
+
+	// a few subtrees per thread so an unlucky split doesn't leave one worker with most of the mesh
+	int taskThreshold = GetMax(numPrims / (numThreads * 4), MIN_PRIMS_PER_BVH_BUILD_JOB);
+	std::vector<BVHSubtreeTask> tasks;
+	BuildBVHNode(input, m_nodes, 0, 0, numPrims, 0, taskThreshold, &tasks);
+
+	BuildBVHSubtrees(input, tasks, jobSystem);
+	for(int taskIndex = 0; taskIndex < static_cast<int>(tasks.size()); ++taskIndex)
+	{
+		StitchBVHSubtree(m_nodes, tasks[taskIndex]);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void BVH3::Refit(std::vector<AABB3> const& primBounds)
+{
+	GUARANTEE_OR_DIE(static_cast<int>(primBounds.size()) == GetNumPrims(), "BVH3::Refit needs the same primitives the tree was built from");
+
+	// children always come after their parent, so one reverse pass sees both children before the parent
+	for(int nodeIndex = static_cast<int>(m_nodes.size()) - 1; nodeIndex >= 0; --nodeIndex)
+	{
+		BVHNode3& node = m_nodes[nodeIndex];
+		BVHBuildBounds bounds;
+
+		if(node.IsLeaf())
+		{
+			for(int slot = node.m_leftOrFirst; slot < node.m_leftOrFirst + node.m_count; ++slot)
+			{
+				AABB3 const& box = primBounds[m_primIndexes[slot]];
+				float mins[3] = { box.m_mins.x, box.m_mins.y, box.m_mins.z };
+				float maxs[3] = { box.m_maxs.x, box.m_maxs.y, box.m_maxs.z };
+				bounds.Grow(mins, maxs);
+			}
+		}
+		else
+		{
+			BVHNode3 const& left = m_nodes[node.m_leftOrFirst];
+			BVHNode3 const& right = m_nodes[node.m_leftOrFirst + 1];
+			bounds.Grow(left.m_mins, left.m_maxs);
+			bounds.Grow(right.m_mins, right.m_maxs);
+		}
+
+		SetNodeBounds(node, bounds);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void BVH3::Clear()
+{
+	m_nodes.clear();
+	m_primIndexes.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+AABB3 BVH3::GetBounds() const
+{
+	if(m_nodes.empty())
+	{
+		return AABB3(0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+	}
+
+	BVHNode3 const& root = m_nodes[0];
+	return AABB3(root.m_mins[0], root.m_mins[1], root.m_mins[2], root.m_maxs[0], root.m_maxs[1], root.m_maxs[2]);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void BVH3::QueryOverlaps(AABB3 const& box, std::vector<int>& out_primIndexes) const
+{
+	struct AcceptAll
+	{
+		bool operator()(int) const { return true; }
+	};
+
+	QueryOverlaps(box, AcceptAll(), out_primIndexes);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+BVH3::RayTraversal BVH3::MakeRayTraversal(Vec3 const& startPos, Vec3 const& fwdNormal)
+{
+	RayTraversal ray;
+	ray.m_startPos = startPos;
+	ray.m_invFwd = Vec3(1.f / fwdNormal.x, 1.f / fwdNormal.y, 1.f / fwdNormal.z);
+	return ray;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Slab test. fminf/fmaxf drop the NaN that 0 * inf produces when the ray runs exactly along a slab plane.
+bool BVH3::IsRayHittingNode(RayTraversal const& ray, BVHNode3 const& node, float maxDist, float& out_entryDist)
+{
+	float tx0 = (node.m_mins[0] - ray.m_startPos.x) * ray.m_invFwd.x;
+	float tx1 = (node.m_maxs[0] - ray.m_startPos.x) * ray.m_invFwd.x;
+	float ty0 = (node.m_mins[1] - ray.m_startPos.y) * ray.m_invFwd.y;
+	float ty1 = (node.m_maxs[1] - ray.m_startPos.y) * ray.m_invFwd.y;
+	float tz0 = (node.m_mins[2] - ray.m_startPos.z) * ray.m_invFwd.z;
+	float tz1 = (node.m_maxs[2] - ray.m_startPos.z) * ray.m_invFwd.z;
+
+	float entry = fmaxf(fmaxf(fminf(tx0, tx1), fminf(ty0, ty1)), fmaxf(fminf(tz0, tz1), 0.f));
+	float exit = fminf(fminf(fmaxf(tx0, tx1), fmaxf(ty0, ty1)), fminf(fmaxf(tz0, tz1), maxDist));
+
+	out_entryDist = entry;
+	return entry <= exit;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool BVH3::IsNodeOverlapping(BVHNode3 const& node, AABB3 const& box)
+{
+	return node.m_mins[0] <= box.m_maxs.x && node.m_maxs[0] >= box.m_mins.x &&
+		   node.m_mins[1] <= box.m_maxs.y && node.m_maxs[1] >= box.m_mins.y &&
+		   node.m_mins[2] <= box.m_maxs.z && node.m_maxs[2] >= box.m_mins.z;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+struct MeshBVH3::TriangleRaycast
+{
+	MeshBVH3 const*	m_mesh;
+	Vec3			m_startPos;
+	Vec3			m_fwdNormal;
+
+	RaycastResult3D operator()(int triangleIndex, float maxDist) const
+	{
+		float impactDistance = 0.f;
+		if(!m_mesh->RaycastTriangle(m_startPos, m_fwdNormal, maxDist, triangleIndex, impactDistance))
+		{
+			return RaycastResult3D(false, m_startPos, m_fwdNormal, maxDist);
+		}
+
+		// report the face normal on the side the ray came from
+		Triangle const& triangle = m_mesh->m_triangles[triangleIndex];
+		Vec3 normal = CrossProduct3D(triangle.m_edge1, triangle.m_edge2).GetNormalized();
+		if(DotProduct3D(normal, m_fwdNormal) > 0.f)
+		{
+			normal = -normal;
+		}
+
+		return RaycastResult3D(true, impactDistance, m_startPos + m_fwdNormal * impactDistance, normal, m_startPos, m_fwdNormal, maxDist);
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct MeshBVH3::TriangleHit
+{
+	MeshBVH3 const*	m_mesh;
+	Vec3			m_startPos;
+	Vec3			m_fwdNormal;
+	float			m_maxDist;
+
+	bool operator()(int triangleIndex) const
+	{
+		float impactDistance = 0.f;
+		return m_mesh->RaycastTriangle(m_startPos, m_fwdNormal, m_maxDist, triangleIndex, impactDistance);
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct MeshBVH3::TriangleBoundsOverlap
+{
+	MeshBVH3 const*	m_mesh;
+	AABB3 const*	m_box;
+
+	bool operator()(int triangleIndex) const
+	{
+		Triangle const& triangle = m_mesh->m_triangles[triangleIndex];
+		Vec3 pos1 = triangle.m_pos0 + triangle.m_edge1;
+		Vec3 pos2 = triangle.m_pos0 + triangle.m_edge2;
+
+		return GetMin(triangle.m_pos0.x, GetMin(pos1.x, pos2.x)) <= m_box->m_maxs.x && GetMax(triangle.m_pos0.x, GetMax(pos1.x, pos2.x)) >= m_box->m_mins.x &&
+			   GetMin(triangle.m_pos0.y, GetMin(pos1.y, pos2.y)) <= m_box->m_maxs.y && GetMax(triangle.m_pos0.y, GetMax(pos1.y, pos2.y)) >= m_box->m_mins.y &&
+			   GetMin(triangle.m_pos0.z, GetMin(pos1.z, pos2.z)) <= m_box->m_maxs.z && GetMax(triangle.m_pos0.z, GetMax(pos1.z, pos2.z)) >= m_box->m_mins.z;
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------
+void MeshBVH3::Build(std::vector<Vec3> const& positions, std::vector<unsigned int> const& indexes, JobSystem* jobSystem)
+{
+	std::vector<AABB3> bounds;
+	SetTriangles(positions, indexes, bounds);
+	m_bvh.Build(bounds, jobSystem);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void MeshBVH3::Refit(std::vector<Vec3> const& positions, std::vector<unsigned int> const& indexes)
+{
+	std::vector<AABB3> bounds;
+	SetTriangles(positions, indexes, bounds);
+	m_bvh.Refit(bounds);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+RaycastResult3D MeshBVH3::RaycastClosest(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, int* out_triangleIndex) const
+{
+	TriangleRaycast raycastTriangle = { this, startPos, fwdNormal };
+	return m_bvh.RaycastClosest(startPos, fwdNormal, maxDist, raycastTriangle, out_triangleIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool MeshBVH3::RaycastAny(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist) const
+{
+	TriangleHit isTriangleHit = { this, startPos, fwdNormal, maxDist };
+	return m_bvh.RaycastAny(startPos, fwdNormal, maxDist, isTriangleHit);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void MeshBVH3::QueryOverlaps(AABB3 const& box, std::vector<int>& out_triangleIndexes) const
+{
+	TriangleBoundsOverlap isTriangleOverlapping = { this, &box };
+	m_bvh.QueryOverlaps(box, isTriangleOverlapping, out_triangleIndexes);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void MeshBVH3::SetTriangles(std::vector<Vec3> const& positions, std::vector<unsigned int> const& indexes, std::vector<AABB3>& out_bounds)
+{
+	int numTriangles = static_cast<int>(indexes.size()) / 3;
+	m_triangles.resize(numTriangles);
+	out_bounds.resize(numTriangles);
+
+	for(int triangleIndex = 0; triangleIndex < numTriangles; ++triangleIndex)
+	{
+		Vec3 const& pos0 = positions[indexes[triangleIndex * 3]];
+		Vec3 const& pos1 = positions[indexes[triangleIndex * 3 + 1]];
+		Vec3 const& pos2 = positions[indexes[triangleIndex * 3 + 2]];
+
+		Triangle& triangle = m_triangles[triangleIndex];
+		triangle.m_pos0 = pos0;
+		triangle.m_edge1 = pos1 - pos0;
+		triangle.m_edge2 = pos2 - pos0;
+
+		AABB3& bounds = out_bounds[triangleIndex];
+		bounds.m_mins = Vec3(GetMin(pos0.x, GetMin(pos1.x, pos2.x)), GetMin(pos0.y, GetMin(pos1.y, pos2.y)), GetMin(pos0.z, GetMin(pos1.z, pos2.z)));
+		bounds.m_maxs = Vec3(GetMax(pos0.x, GetMax(pos1.x, pos2.x)), GetMax(pos0.y, GetMax(pos1.y, pos2.y)), GetMax(pos0.z, GetMax(pos1.z, pos2.z)));
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Moller-Trumbore, two-sided. Rays parallel to the triangle plane miss.
+bool MeshBVH3::RaycastTriangle(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, int triangleIndex, float& out_impactDistance) const
+{
+	constexpr float PARALLEL_EPSILON = 1e-12f;
+
+	Triangle const& triangle = m_triangles[triangleIndex];
+	Vec3 fwdCrossEdge2 = CrossProduct3D(fwdNormal, triangle.m_edge2);
+	float determinant = DotProduct3D(triangle.m_edge1, fwdCrossEdge2);
+	if(fabsf(determinant) < PARALLEL_EPSILON)
+	{
+		return false;
+	}
+
+	float invDeterminant = 1.f / determinant;
+	Vec3 pos0ToStart = startPos - triangle.m_pos0;
+	float u = DotProduct3D(pos0ToStart, fwdCrossEdge2) * invDeterminant;
+	if(u < 0.f || u > 1.f)
+	{
+		return false;
+	}
+
+	Vec3 startCrossEdge1 = CrossProduct3D(pos0ToStart, triangle.m_edge1);
+	float v = DotProduct3D(fwdNormal, startCrossEdge1) * invDeterminant;
+	if(v < 0.f || u + v > 1.f)
+	{
+		return false;
+	}
+
+	float impactDistance = DotProduct3D(triangle.m_edge2, startCrossEdge1) * invDeterminant;
+	if(impactDistance < 0.f || impactDistance > maxDist)
+	{
+		return false;
+	}
+
+	out_impactDistance = impactDistance;
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void GetBoundsForAABB3s(std::vector<AABB3> const& boxes, std::vector<AABB3>& out_bounds)
+{
+	out_bounds = boxes;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void GetBoundsForOBB3s(std::vector<OBB3> const& obbs, std::vector<AABB3>& out_bounds)
+{
+	out_bounds.clear();
+	out_bounds.reserve(obbs.size());
+
+	for(int obbIndex = 0; obbIndex < static_cast<int>(obbs.size()); ++obbIndex)
+	{
+		out_bounds.push_back(GetBoundsForOBB3(obbs[obbIndex]));
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+struct AABB3SetRaycast
+{
+	std::vector<AABB3> const*	m_boxes;
+	Vec3						m_startPos;
+	Vec3						m_fwdNormal;
+
+	RaycastResult3D operator()(int boxIndex, float maxDist) const
+	{
+		return RaycastVsAABB3D(m_startPos, m_fwdNormal, maxDist, (*m_boxes)[boxIndex]);
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct OBB3SetRaycast
+{
+	std::vector<OBB3> const*	m_obbs;
+	Vec3						m_startPos;
+	Vec3						m_fwdNormal;
+
+	RaycastResult3D operator()(int obbIndex, float maxDist) const
+	{
+		return RaycastVsOBB3D(m_startPos, m_fwdNormal, maxDist, (*m_obbs)[obbIndex]);
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------
+RaycastResult3D RaycastVsAABB3Ds(BVH3 const& bvh, std::vector<AABB3> const& boxes, Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, int* out_boxIndex)
+{
+	AABB3SetRaycast raycastBox = { &boxes, startPos, fwdNormal };
+	return bvh.RaycastClosest(startPos, fwdNormal, maxDist, raycastBox, out_boxIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+RaycastResult3D RaycastVsOBB3Ds(BVH3 const& bvh, std::vector<OBB3> const& obbs, Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, int* out_obbIndex)
+{
+	OBB3SetRaycast raycastOBB = { &obbs, startPos, fwdNormal };
+	return bvh.RaycastClosest(startPos, fwdNormal, maxDist, raycastOBB, out_obbIndex);
+}
@@ -0,0 +1,293 @@
+#pragma once
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------
+class JobSystem;
+struct OBB3;
+
+//------------------------------------------------------------------------------------------------------------------
+// One BVH node in 32 bytes. Inner nodes store the index of their left child (the right child always follows it);
+// leaves store the first slot of their primitive range. m_count is 0 for inner nodes.
+//------------------------------------------------------------------------------------------------------------------
+struct BVHNode3
+{
+	float	m_mins[3];
+	int		m_leftOrFirst;
+	float	m_maxs[3];
+	int		m_count;
+
+	bool	IsLeaf() const	{ return m_count > 0; }
+};
+static_assert(sizeof(BVHNode3) == 32, "BVHNode3 must stay 32 bytes");
+
+//------------------------------------------------------------------------------------------------------------------
+// Bounding volume hierarchy over any set of primitives that can be bounded by an AABB3. The tree only knows primitive
+// indices and bounds; the query templates call back into the owner for the exact primitive test, so the same tree
+// serves triangle meshes, AABB3/OBB3 sets and game objects.
+//
+// Build bins primitive centroids along all three axes and splits where the surface area heuristic is cheapest. With a
+// JobSystem the top of the tree is split on the calling thread and the subtrees below it are built as jobs.
+//
+// Refit keeps the topology and only recomputes bounds. That is the cheap path for primitives that move a little each
+// frame; rebuild once they have moved far enough that query times degrade.
+//------------------------------------------------------------------------------------------------------------------
+class BVH3
+{
+public:
+	BVH3() = default;
+	~BVH3() = default;
+
+	void	Build(std::vector<AABB3> const& primBounds, JobSystem* jobSystem = nullptr);
+	void	Refit(std::vector<AABB3> const& primBounds);
+	void	Clear();
+
+	bool	IsEmpty() const					{ return m_nodes.empty(); }
+	int		GetNumNodes() const				{ return static_cast<int>(m_nodes.size()); }
+	int		GetNumPrims() const				{ return static_cast<int>(m_primIndexes.size()); }
+	AABB3	GetBounds() const;
+
+	// raycastPrim(primIndex, maxDist) returns a RaycastResult3D for the ray against that primitive. The ray is shortened
+	// to each closer hit, so later primitives are only tested against what is left of it.
+	template<typename PrimRaycastFunc>
+	RaycastResult3D RaycastClosest(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, PrimRaycastFunc const& raycastPrim, int* out_primIndex = nullptr) const;
+
+	// isPrimHit(primIndex) returns true if the ray hits that primitive; traversal stops at the first one.
+	template<typename PrimHitFunc>
+	bool RaycastAny(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, PrimHitFunc const& isPrimHit) const;
+
+	// Appends every primitive in a leaf that overlaps the box. That is a superset of the primitives that actually
+	// overlap; pass isPrimOverlapping(primIndex) to filter them with the owner's own test.
+	void QueryOverlaps(AABB3 const& box, std::vector<int>& out_primIndexes) const;
+	template<typename PrimOverlapFunc>
+	void QueryOverlaps(AABB3 const& box, PrimOverlapFunc const& isPrimOverlapping, std::vector<int>& out_primIndexes) const;
+
+public:
+	static constexpr int MAX_LEAF_PRIMS = 4;
+	static constexpr int NUM_SAH_BINS = 16;
+	static constexpr int MAX_TRAVERSAL_DEPTH = 64;
+
+private:
+	struct RayTraversal
+	{
+		Vec3	m_startPos;
+		Vec3	m_invFwd;
+	};
+
+	static RayTraversal	MakeRayTraversal(Vec3 const& startPos, Vec3 const& fwdNormal);
+	static bool			IsRayHittingNode(RayTraversal const& ray, BVHNode3 const& node, float maxDist, float& out_entryDist);
+	static bool			IsNodeOverlapping(BVHNode3 const& node, AABB3 const& box);
+
+private:
+	std::vector<BVHNode3>	m_nodes;
+	std::vector<int>		m_primIndexes;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Triangle mesh wrapper. Positions are copied in as precomputed edges, so the source vertex buffer can be freed or
+// changed; call Refit after deforming the mesh in place.
+//------------------------------------------------------------------------------------------------------------------
+class MeshBVH3
+{
+public:
+	void	Build(std::vector<Vec3> const& positions, std::vector<unsigned int> const& indexes, JobSystem* jobSystem = nullptr);
+	void	Refit(std::vector<Vec3> const& positions, std::vector<unsigned int> const& indexes);
+
+	RaycastResult3D	RaycastClosest(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, int* out_triangleIndex = nullptr) const;
+	bool			RaycastAny(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist) const;
+	void			QueryOverlaps(AABB3 const& box, std::vector<int>& out_triangleIndexes) const;		// triangles whose bounds overlap the box
+
+	BVH3 const&		GetBVH() const					{ return m_bvh; }
+	int				GetNumTriangles() const			{ return static_cast<int>(m_triangles.size()); }
+
+private:
+	struct Triangle
+	{
+		Vec3	m_pos0;
+		Vec3	m_edge1;
+		Vec3	m_edge2;
+	};
+
+	struct TriangleRaycast;
+	struct TriangleHit;
+	struct TriangleBoundsOverlap;
+
+	void	SetTriangles(std::vector<Vec3> const& positions, std::vector<unsigned int> const& indexes, std::vector<AABB3>& out_bounds);
+	bool	RaycastTriangle(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, int triangleIndex, float& out_impactDistance) const;
+
+private:
+	BVH3					m_bvh;
+	std::vector<Triangle>	m_triangles;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Shape sets. The BVH must have been built from the matching bounds (GetBoundsForAABB3s / GetBoundsForOBB3s).
+void			GetBoundsForAABB3s(std::vector<AABB3> const& boxes, std::vector<AABB3>& out_bounds);
+void			GetBoundsForOBB3s(std::vector<OBB3> const& obbs, std::vector<AABB3>& out_bounds);
+RaycastResult3D	RaycastVsAABB3Ds(BVH3 const& bvh, std::vector<AABB3> const& boxes, Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, int* out_boxIndex = nullptr);
+RaycastResult3D	RaycastVsOBB3Ds(BVH3 const& bvh, std::vector<OBB3> const& obbs, Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, int* out_obbIndex = nullptr);
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename PrimRaycastFunc>
+RaycastResult3D BVH3::RaycastClosest(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, PrimRaycastFunc const& raycastPrim, int* out_primIndex) const
+{
+	RaycastResult3D closest(false, startPos, fwdNormal, maxDist);
+	int closestPrim = -1;
+	float closestDist = maxDist;
+
+	RayTraversal ray = MakeRayTraversal(startPos, fwdNormal);
+	float entryDist = 0.f;
+
+	if(m_nodes.empty() || !IsRayHittingNode(ray, m_nodes[0], closestDist, entryDist))
+	{
+		if(out_primIndex != nullptr)
+		{
+			*out_primIndex = -1;
+		}
+		return closest;
+	}
+
+	int nodeStack[MAX_TRAVERSAL_DEPTH];
+	float entryStack[MAX_TRAVERSAL_DEPTH];
+	int stackSize = 0;
+	nodeStack[stackSize] = 0;
+	entryStack[stackSize++] = entryDist;
+
+	while(stackSize > 0)
+	{
+		--stackSize;
+		if(entryStack[stackSize] > closestDist)
+		{
+			continue;
+		}
+
+		BVHNode3 const& node = m_nodes[nodeStack[stackSize]];
+		if(node.IsLeaf())
+		{
+			for(int slot = node.m_leftOrFirst; slot < node.m_leftOrFirst + node.m_count; ++slot)
+			{
+				int primIndex = m_primIndexes[slot];
+				RaycastResult3D result = raycastPrim(primIndex, closestDist);
+				if(result.m_didImpact && result.m_impactDistance <= closestDist)
+				{
+					closest = result;
+					closestDist = result.m_impactDistance;
+					closestPrim = primIndex;
+				}
+			}
+			continue;
+		}
+
+		// push the far child first so the near one is popped next
+		int leftIndex = node.m_leftOrFirst;
+		float leftEntry = 0.f;
+		float rightEntry = 0.f;
+		bool isLeftHit = IsRayHittingNode(ray, m_nodes[leftIndex], closestDist, leftEntry);
+		bool isRightHit = IsRayHittingNode(ray, m_nodes[leftIndex + 1], closestDist, rightEntry);
+
+		if(isLeftHit && isRightHit)
+		{
+			bool isLeftNear = leftEntry <= rightEntry;
+			nodeStack[stackSize] = isLeftNear ? leftIndex + 1 : leftIndex;
+			entryStack[stackSize++] = isLeftNear ? rightEntry : leftEntry;
+			nodeStack[stackSize] = isLeftNear ? leftIndex : leftIndex + 1;
+			entryStack[stackSize++] = isLeftNear ? leftEntry : rightEntry;
+		}
+		else if(isLeftHit || isRightHit)
+		{
+			nodeStack[stackSize] = isLeftHit ? leftIndex : leftIndex + 1;
+			entryStack[stackSize++] = isLeftHit ? leftEntry : rightEntry;
+		}
+	}
+
+	closest.m_rayMaxLength = maxDist;
+	if(out_primIndex != nullptr)
+	{
+		*out_primIndex = closestPrim;
+	}
+	return closest;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename PrimHitFunc>
+bool BVH3::RaycastAny(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, PrimHitFunc const& isPrimHit) const
+{
+	if(m_nodes.empty())
+	{
+		return false;
+	}
+
+	RayTraversal ray = MakeRayTraversal(startPos, fwdNormal);
+	int nodeStack[MAX_TRAVERSAL_DEPTH];
+	int stackSize = 0;
+	nodeStack[stackSize++] = 0;
+
+	while(stackSize > 0)
+	{
+		BVHNode3 const& node = m_nodes[nodeStack[--stackSize]];
+		float entryDist = 0.f;
+		if(!IsRayHittingNode(ray, node, maxDist, entryDist))
+		{
+			continue;
+		}
+
+		if(!node.IsLeaf())
+		{
+			nodeStack[stackSize++] = node.m_leftOrFirst + 1;
+			nodeStack[stackSize++] = node.m_leftOrFirst;
+			continue;
+		}
+
+		for(int slot = node.m_leftOrFirst; slot < node.m_leftOrFirst + node.m_count; ++slot)
+		{
+			if(isPrimHit(m_primIndexes[slot]))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename PrimOverlapFunc>
+void BVH3::QueryOverlaps(AABB3 const& box, PrimOverlapFunc const& isPrimOverlapping, std::vector<int>& out_primIndexes) const
+{
+	if(m_nodes.empty())
+	{
+		return;
+	}
+
+	int nodeStack[MAX_TRAVERSAL_DEPTH];
+	int stackSize = 0;
+	nodeStack[stackSize++] = 0;
+
+	while(stackSize > 0)
+	{
+		BVHNode3 const& node = m_nodes[nodeStack[--stackSize]];
+		if(!IsNodeOverlapping(node, box))
+		{
+			continue;
+		}
+
+		if(!node.IsLeaf())
+		{
+			nodeStack[stackSize++] = node.m_leftOrFirst + 1;
+			nodeStack[stackSize++] = node.m_leftOrFirst;
+			continue;
+		}
+
+		for(int slot = node.m_leftOrFirst; slot < node.m_leftOrFirst + node.m_count; ++slot)
+		{
+			int primIndex = m_primIndexes[slot];
+			if(isPrimOverlapping(primIndex))
+			{
+				out_primIndexes.push_back(primIndex);
+			}
+		}
+	}
+}
@@ -0,0 +1,206 @@
+#include "Engine/Math/BakedCurve1D.hpp"
+#include "Engine/Math/CurveUtils.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <algorithm>
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+struct KeyframeTimeLess
+{
+	bool operator()(LinearCurve1D const& a, LinearCurve1D const& b) const
+	{
+		return a.m_start < b.m_start;
+	}
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+BakedCurve1D::BakedCurve1D(LinearCurve1D const& curve)
+{
+	AddSegment(0.f, 1.f, curve.m_start, curve.m_end);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// PieceWiseCurves holds one of two forms, and the bake follows whichever is filled in:
+//	m_subCurves		Each LinearCurve1D runs from its start time to the next one's (the last to 1) and may jump between them.
+//	m_subCurvesList	Keyframes, with m_start as the time and m_end as the value, joined by straight lines.
+// Unlike PieceWiseCurves::Evaluate, times before the first key give the first value rather than 0.
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+BakedCurve1D::BakedCurve1D(PieceWiseCurves const& curves)
+{
+	if(!curves.m_subCurves.empty())
+	{
+		for(auto iter = curves.m_subCurves.begin(); iter != curves.m_subCurves.end(); ++iter)
+		{
+			float startTime = iter->first;
+			if(startTime >= 1.f)
+			{
+				break;
+			}
+
+			auto nextIter = iter;
+			++nextIter;
+			float endTime = (nextIter == curves.m_subCurves.end()) ? 1.f : GetMin(nextIter->first, 1.f);
+
+			AddSegment(startTime, endTime, iter->second.m_start, iter->second.m_end);
+		}
+	}
+	else if(!curves.m_subCurvesList.empty())
+	{
+		std::vector<LinearCurve1D> keyframes = curves.m_subCurvesList;
+		std::stable_sort(keyframes.begin(), keyframes.end(), KeyframeTimeLess());
+
+		if(keyframes.size() == 1)
+		{
+			AddSegment(keyframes[0].m_start, keyframes[0].m_start, keyframes[0].m_end, keyframes[0].m_end);
+		}
+
+		for(int index = 0; index < static_cast<int>(keyframes.size()) - 1; ++index)
+		{
+			AddSegment(keyframes[index].m_start, keyframes[index + 1].m_start, keyframes[index].m_end, keyframes[index + 1].m_end);
+		}
+	}
+
+	if(m_keyTimes.empty())
+	{
+		AddSegment(0.f, 1.f, 0.f, 0.f);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+BakedCurve1D::BakedCurve1D(EasingFunction easingFunction, int numSamples)
+{
+	GUARANTEE_OR_DIE(numSamples >= 2, "BakedCurve1D needs at least two samples");
+
+	m_keyValues.resize(numSamples);
+	for(int sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex)
+	{
+		m_keyValues[sampleIndex] = easingFunction(static_cast<float>(sampleIndex) / static_cast<float>(numSamples - 1));
+	}
+
+	m_startTime = 0.f;
+	m_endTime = 1.f;
+	m_startValue = m_keyValues.front();
+	m_endValue = m_keyValues.back();
+	m_samplesPerTime = static_cast<float>(numSamples - 1);
+	m_isUniform = true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void BakedCurve1D::AddSegment(float startTime, float endTime, float startValue, float endValue)
+{
+	float duration = endTime - startTime;
+
+	if(m_keyTimes.empty())
+	{
+		m_startTime = startTime;
+		m_startValue = startValue;
+	}
+
+	m_keyTimes.push_back(startTime);
+	m_keyValues.push_back(startValue);
+	m_keySlopes.push_back(duration > 0.f ? (endValue - startValue) / duration : 0.f);
+
+	m_endTime = GetMax(endTime, startTime);
+	m_endValue = endValue;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void BakedCurve1D::ResampleUniform(int numSamples)
+{
+	GUARANTEE_OR_DIE(numSamples >= 2, "BakedCurve1D needs at least two samples");
+
+	float duration = m_endTime - m_startTime;
+	std::vector<float> samples(numSamples);
+
+	for(int sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex)
+	{
+		float t = m_startTime + duration * static_cast<float>(sampleIndex) / static_cast<float>(numSamples - 1);
+		samples[sampleIndex] = Evaluate(t);
+	}
+	samples.back() = m_endValue;
+
+	m_keyValues.swap(samples);
+	m_keyTimes.clear();
+	m_keySlopes.clear();
+	m_samplesPerTime = (duration > 0.f) ? static_cast<float>(numSamples - 1) / duration : 0.f;
+	m_isUniform = true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+float BakedCurve1D::Evaluate(float t) const
+{
+	if(m_isUniform)
+	{
+		return EvaluateUniform(t);
+	}
+	return EvaluateKeyed(t);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void BakedCurve1D::EvaluateBatch(int count, float const* ts, float* out_values) const
+{
+	if(m_isUniform)
+	{
+		for(int index = 0; index < count; ++index)
+		{
+			out_values[index] = EvaluateUniform(ts[index]);
+		}
+	}
+	else
+	{
+		for(int index = 0; index < count; ++index)
+		{
+			out_values[index] = EvaluateKeyed(ts[index]);
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+float BakedCurve1D::EvaluateKeyed(float t) const
+{
+	float clampedT = (t < m_startTime) ? m_startTime : t;
+	clampedT = (clampedT > m_endTime) ? m_endTime : clampedT;
+
+	// Last key at or before t. The loop count only depends on the number of keys and the compare becomes a
+	// conditional move, so there is no branch to mispredict however the ts are ordered
+	float const* keyTimes = m_keyTimes.data();
+	int keyIndex = 0;
+	int numLeft = static_cast<int>(m_keyTimes.size());
+
+	while(numLeft > 1)
+	{
+		int half = numLeft / 2;
+		keyIndex = (keyTimes[keyIndex + half] <= clampedT) ? keyIndex + half : keyIndex;
+		numLeft -= half;
+	}
+
+	float value = m_keyValues[keyIndex] + m_keySlopes[keyIndex] * (clampedT - keyTimes[keyIndex]);
+	return (t >= m_endTime) ? m_endValue : value;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+float BakedCurve1D::EvaluateUniform(float t) const
+{
+	int lastInterval = static_cast<int>(m_keyValues.size()) - 2;
+
+	float sampleCoord = (t - m_startTime) * m_samplesPerTime;
+	sampleCoord = (sampleCoord > 0.f) ? sampleCoord : 0.f;
+	sampleCoord = (sampleCoord < static_cast<float>(lastInterval + 1)) ? sampleCoord : static_cast<float>(lastInterval + 1);
+
+	int sampleIndex = static_cast<int>(sampleCoord);
+	sampleIndex = (sampleIndex < lastInterval) ? sampleIndex : lastInterval;
+
+	float fraction = sampleCoord - static_cast<float>(sampleIndex);
+	float startValue = m_keyValues[sampleIndex];
+	return startValue + fraction * (m_keyValues[sampleIndex + 1] - startValue);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void EvaluateBakedCurves(int count, std::vector<BakedCurve1D> const& curves, int const* curveIndexes, float const* ts, float* out_values)
+{
+	for(int index = 0; index < count; ++index)
+	{
+		out_values[index] = curves[curveIndexes[index]].Evaluate(ts[index]);
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+class LinearCurve1D;
+class PieceWiseCurves;
+
+typedef float (*EasingFunction)(float time);
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Flat, read-only copy of a 1D curve for code that evaluates the same curves every frame (animation tracks, easing
+// per entity). Baking copies the curve into plain arrays once; Evaluate is const, not virtual and does no allocation.
+//
+// Two layouts, picked by what was baked:
+//	keyed	 Segment start times with each segment's start value and slope, found by a branchless binary search.
+//			 Exact for piecewise-linear input, including jumps between segments. Used for LinearCurve1D and PieceWiseCurves.
+//	uniform	 Values at evenly spaced times, found with one multiply and interpolated linearly. Used for easing functions,
+//			 or after ResampleUniform when a keyed curve has enough keys that the search shows up in a profile.
+// Before the start time and after the end time both layouts hold the first and last value.
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+class BakedCurve1D
+{
+public:
+	BakedCurve1D() = default;
+	explicit BakedCurve1D(LinearCurve1D const& curve);
+	explicit BakedCurve1D(PieceWiseCurves const& curves);
+	explicit BakedCurve1D(EasingFunction easingFunction, int numSamples = 256);
+
+	void	ResampleUniform(int numSamples);
+
+	float	Evaluate(float t) const;
+	void	EvaluateBatch(int count, float const* ts, float* out_values) const;
+
+	bool	IsUniform() const			{ return m_isUniform; }
+	int		GetNumKeys() const			{ return static_cast<int>(m_keyValues.size()); }
+	float	GetStartTime() const		{ return m_startTime; }
+	float	GetEndTime() const			{ return m_endTime; }
+
+private:
+	void	AddSegment(float startTime, float endTime, float startValue, float endValue);
+	float	EvaluateKeyed(float t) const;
+	float	EvaluateUniform(float t) const;
+
+private:
+	std::vector<float>	m_keyTimes;					// keyed: segment start times, ascending
+	std::vector<float>	m_keyValues;				// keyed: value at each segment start; uniform: the samples
+	std::vector<float>	m_keySlopes;				// keyed: value change per unit of time within each segment
+	float				m_startTime = 0.f;
+	float				m_endTime = 1.f;
+	float				m_startValue = 0.f;
+	float				m_endValue = 0.f;
+	float				m_samplesPerTime = 0.f;		// uniform: samples per unit of time
+	bool				m_isUniform = false;
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// One value per entry: out_values[i] = curves[curveIndexes[i]].Evaluate(ts[i]). For a set of entities that each play
+// one of a shared list of tracks.
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void EvaluateBakedCurves(int count, std::vector<BakedCurve1D> const& curves, int const* curveIndexes, float const* ts, float* out_values);
@@ -0,0 +1,469 @@
+#include "Engine/Math/BatchNoise.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/NoiseLanes.hpp"
+#include "Engine/Math/SIMDUtils.hpp"
+#include "Engine/JobSystem/JobSystem.hpp"
+#include "Engine/JobSystem/Job.hpp"
+#include "ThirdParty/Noise/SmoothNoise.hpp"
+
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------
+// Each sample hashes 4 or 8 lattice corners per octave, so noise pays for a worker with far fewer samples than culling.
+constexpr int MIN_SAMPLES_PER_NOISE_JOB = 4096;
+constexpr float OCTAVE_OFFSET = 0.636764989593174f;		// the same translation SmoothNoise adds to each octave
+
+typedef NoiseLaneOps::FloatOps NoiseFloatOps;
+typedef NoiseLaneOps::Type NoiseUInts;
+typedef NoiseFloatOps::Type NoiseFloats;
+
+//------------------------------------------------------------------------------------------------------------------
+struct FractalNoiseSettings
+{
+	float			m_scale = 1.f;
+	unsigned int	m_numOctaves = 1;
+	float			m_octavePersistence = 0.5f;
+	float			m_octaveScale = 2.f;
+	bool			m_renormalize = true;
+	unsigned int	m_seed = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// The kernels below follow SmoothNoise's scalar code operation for operation, with separate multiplies and adds where
+// it has them, so each lane rounds exactly as the scalar version does.
+//------------------------------------------------------------------------------------------------------------------
+static NoiseFloats SmoothStep3Lanes(NoiseFloats t)
+{
+	NoiseFloats threeTT = NoiseFloatOps::Mul(NoiseFloatOps::Mul(NoiseFloatOps::Splat(3.f), t), t);
+	NoiseFloats twoTTT = NoiseFloatOps::Mul(NoiseFloatOps::Mul(NoiseFloatOps::Mul(NoiseFloatOps::Splat(2.f), t), t), t);
+	return NoiseFloatOps::Sub(threeTT, twoTTT);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static NoiseFloats BlendLanes(NoiseFloats weightHigh, NoiseFloats valueHigh, NoiseFloats weightLow, NoiseFloats valueLow)
+{
+	return NoiseFloatOps::Add(NoiseFloatOps::Mul(weightHigh, valueHigh), NoiseFloatOps::Mul(weightLow, valueLow));
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static NoiseFloats RenormalizeNoiseLanes(NoiseFloats totalNoise, float totalAmplitude)
+{
+	NoiseFloats half = NoiseFloatOps::Splat(0.5f);
+	totalNoise = NoiseFloatOps::Div(totalNoise, NoiseFloatOps::Splat(totalAmplitude));
+	totalNoise = NoiseFloatOps::Add(NoiseFloatOps::Mul(totalNoise, half), half);
+	totalNoise = SmoothStep3Lanes(totalNoise);
+	return NoiseFloatOps::Sub(NoiseFloatOps::Mul(totalNoise, NoiseFloatOps::Splat(2.f)), NoiseFloatOps::Splat(1.f));
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static NoiseFloats Compute2dFractalNoiseLanes(NoiseFloats posX, NoiseFloats posY, FractalNoiseSettings const& settings)
+{
+	NoiseFloats one = NoiseFloatOps::Splat(1.f);
+	NoiseFloats half = NoiseFloatOps::Splat(0.5f);
+	NoiseFloats two = NoiseFloatOps::Splat(2.f);
+	NoiseFloats octaveScale = NoiseFloatOps::Splat(settings.m_octaveScale);
+	NoiseFloats octaveOffset = NoiseFloatOps::Splat(OCTAVE_OFFSET);
+	NoiseUInts indexStep = NoiseLaneOps::Splat(1);
+
+	NoiseFloats totalNoise = NoiseFloatOps::Zero();
+	float totalAmplitude = 0.f;
+	float currentAmplitude = 1.f;
+	unsigned int seed = settings.m_seed;
+	NoiseFloats invScale = NoiseFloatOps::Splat(1.f / settings.m_scale);
+	NoiseFloats currentX = NoiseFloatOps::Mul(posX, invScale);
+	NoiseFloats currentY = NoiseFloatOps::Mul(posY, invScale);
+
+	for(unsigned int octaveNum = 0; octaveNum < settings.m_numOctaves; ++octaveNum)
+	{
+		NoiseFloats cellMinX = NoiseFloatOps::Floor(currentX);
+		NoiseFloats cellMinY = NoiseFloatOps::Floor(currentY);
+		NoiseUInts indexWestX = NoiseLaneOps::FromFloatTruncated(cellMinX);
+		NoiseUInts indexSouthY = NoiseLaneOps::FromFloatTruncated(cellMinY);
+		NoiseUInts indexEastX = NoiseLaneOps::Add(indexWestX, indexStep);
+		NoiseUInts indexNorthY = NoiseLaneOps::Add(indexSouthY, indexStep);
+		NoiseFloats valueSouthWest = Get2dNoiseZeroToOneLanes<NoiseLaneOps>(indexWestX, indexSouthY, seed);
+		NoiseFloats valueSouthEast = Get2dNoiseZeroToOneLanes<NoiseLaneOps>(indexEastX, indexSouthY, seed);
+		NoiseFloats valueNorthWest = Get2dNoiseZeroToOneLanes<NoiseLaneOps>(indexWestX, indexNorthY, seed);
+		NoiseFloats valueNorthEast = Get2dNoiseZeroToOneLanes<NoiseLaneOps>(indexEastX, indexNorthY, seed);
+
+		NoiseFloats weightEast = SmoothStep3Lanes(NoiseFloatOps::Sub(currentX, cellMinX));
+		NoiseFloats weightNorth = SmoothStep3Lanes(NoiseFloatOps::Sub(currentY, cellMinY));
+		NoiseFloats weightWest = NoiseFloatOps::Sub(one, weightEast);
+		NoiseFloats weightSouth = NoiseFloatOps::Sub(one, weightNorth);
+
+		NoiseFloats blendSouth = BlendLanes(weightEast, valueSouthEast, weightWest, valueSouthWest);
+		NoiseFloats blendNorth = BlendLanes(weightEast, valueNorthEast, weightWest, valueNorthWest);
+		NoiseFloats blendTotal = BlendLanes(weightSouth, blendSouth, weightNorth, blendNorth);
+		NoiseFloats noiseThisOctave = NoiseFloatOps::Mul(two, NoiseFloatOps::Sub(blendTotal, half));
+
+		totalNoise = NoiseFloatOps::Add(totalNoise, NoiseFloatOps::Mul(noiseThisOctave, NoiseFloatOps::Splat(currentAmplitude)));
+		totalAmplitude += currentAmplitude;
+		currentAmplitude *= settings.m_octavePersistence;
+		currentX = NoiseFloatOps::Add(NoiseFloatOps::Mul(currentX, octaveScale), octaveOffset);
+		currentY = NoiseFloatOps::Add(NoiseFloatOps::Mul(currentY, octaveScale), octaveOffset);
+		++seed;
+	}
+
+	if(settings.m_renormalize && totalAmplitude > 0.f)
+	{
+		totalNoise = RenormalizeNoiseLanes(totalNoise, totalAmplitude);
+	}
+
+	return totalNoise;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static NoiseFloats Compute3dFractalNoiseLanes(NoiseFloats posX, NoiseFloats posY, NoiseFloats posZ, FractalNoiseSettings const& settings)
+{
+	NoiseFloats one = NoiseFloatOps::Splat(1.f);
+	NoiseFloats half = NoiseFloatOps::Splat(0.5f);
+	NoiseFloats two = NoiseFloatOps::Splat(2.f);
+	NoiseFloats octaveScale = NoiseFloatOps::Splat(settings.m_octaveScale);
+	NoiseFloats octaveOffset = NoiseFloatOps::Splat(OCTAVE_OFFSET);
+	NoiseUInts indexStep = NoiseLaneOps::Splat(1);
+
+	NoiseFloats totalNoise = NoiseFloatOps::Zero();
+	float totalAmplitude = 0.f;
+	float currentAmplitude = 1.f;
+	unsigned int seed = settings.m_seed;
+	NoiseFloats invScale = NoiseFloatOps::Splat(1.f / settings.m_scale);
+	NoiseFloats currentX = NoiseFloatOps::Mul(posX, invScale);
+	NoiseFloats currentY = NoiseFloatOps::Mul(posY, invScale);
+	NoiseFloats currentZ = NoiseFloatOps::Mul(posZ, invScale);
+
+	for(unsigned int octaveNum = 0; octaveNum < settings.m_numOctaves; ++octaveNum)
+	{
+		NoiseFloats cellMinX = NoiseFloatOps::Floor(currentX);
+		NoiseFloats cellMinY = NoiseFloatOps::Floor(currentY);
+		NoiseFloats cellMinZ = NoiseFloatOps::Floor(currentZ);
+		NoiseUInts indexWestX = NoiseLaneOps::FromFloatTruncated(cellMinX);
+		NoiseUInts indexSouthY = NoiseLaneOps::FromFloatTruncated(cellMinY);
+		NoiseUInts indexBelowZ = NoiseLaneOps::FromFloatTruncated(cellMinZ);
+		NoiseUInts indexEastX = NoiseLaneOps::Add(indexWestX, indexStep);
+		NoiseUInts indexNorthY = NoiseLaneOps::Add(indexSouthY, indexStep);
+		NoiseUInts indexAboveZ = NoiseLaneOps::Add(indexBelowZ, indexStep);
+
+		NoiseFloats aboveSouthWest = Get3dNoiseZeroToOneLanes<NoiseLaneOps>(indexWestX, indexSouthY, indexAboveZ, seed);
+		NoiseFloats aboveSouthEast = Get3dNoiseZeroToOneLanes<NoiseLaneOps>(indexEastX, indexSouthY, indexAboveZ, seed);
+		NoiseFloats aboveNorthWest = Get3dNoiseZeroToOneLanes<NoiseLaneOps>(indexWestX, indexNorthY, indexAboveZ, seed);
+		NoiseFloats aboveNorthEast = Get3dNoiseZeroToOneLanes<NoiseLaneOps>(indexEastX, indexNorthY, indexAboveZ, seed);
+		NoiseFloats belowSouthWest = Get3dNoiseZeroToOneLanes<NoiseLaneOps>(indexWestX, indexSouthY, indexBelowZ, seed);
+		NoiseFloats belowSouthEast = Get3dNoiseZeroToOneLanes<NoiseLaneOps>(indexEastX, indexSouthY, indexBelowZ, seed);
+		NoiseFloats belowNorthWest = Get3dNoiseZeroToOneLanes<NoiseLaneOps>(indexWestX, indexNorthY, indexBelowZ, seed);
+		NoiseFloats belowNorthEast = Get3dNoiseZeroToOneLanes<NoiseLaneOps>(indexEastX, indexNorthY, indexBelowZ, seed);
+
+		NoiseFloats weightEast = SmoothStep3Lanes(NoiseFloatOps::Sub(currentX, cellMinX));
+		NoiseFloats weightNorth = SmoothStep3Lanes(NoiseFloatOps::Sub(currentY, cellMinY));
+		NoiseFloats weightAbove = SmoothStep3Lanes(NoiseFloatOps::Sub(currentZ, cellMinZ));
+		NoiseFloats weightWest = NoiseFloatOps::Sub(one, weightEast);
+		NoiseFloats weightSouth = NoiseFloatOps::Sub(one, weightNorth);
+		NoiseFloats weightBelow = NoiseFloatOps::Sub(one, weightAbove);
+
+		NoiseFloats blendBelowSouth = BlendLanes(weightEast, belowSouthEast, weightWest, belowSouthWest);
+		NoiseFloats blendBelowNorth = BlendLanes(weightEast, belowNorthEast, weightWest, belowNorthWest);
+		NoiseFloats blendAboveSouth = BlendLanes(weightEast, aboveSouthEast, weightWest, aboveSouthWest);
+		NoiseFloats blendAboveNorth = BlendLanes(weightEast, aboveNorthEast, weightWest, aboveNorthWest);
+		NoiseFloats blendBelow = BlendLanes(weightSouth, blendBelowSouth, weightNorth, blendBelowNorth);
+		NoiseFloats blendAbove = BlendLanes(weightSouth, blendAboveSouth, weightNorth, blendAboveNorth);
+		NoiseFloats blendTotal = BlendLanes(weightBelow, blendBelow, weightAbove, blendAbove);
+		NoiseFloats noiseThisOctave = NoiseFloatOps::Mul(two, NoiseFloatOps::Sub(blendTotal, half));
+
+		totalNoise = NoiseFloatOps::Add(totalNoise, NoiseFloatOps::Mul(noiseThisOctave, NoiseFloatOps::Splat(currentAmplitude)));
+		totalAmplitude += currentAmplitude;
+		currentAmplitude *= settings.m_octavePersistence;
+		currentX = NoiseFloatOps::Add(NoiseFloatOps::Mul(currentX, octaveScale), octaveOffset);
+		currentY = NoiseFloatOps::Add(NoiseFloatOps::Mul(currentY, octaveScale), octaveOffset);
+		currentZ = NoiseFloatOps::Add(NoiseFloatOps::Mul(currentZ, octaveScale), octaveOffset);
+		++seed;
+	}
+
+	if(settings.m_renormalize && totalAmplitude > 0.f)
+	{
+		totalNoise = RenormalizeNoiseLanes(totalNoise, totalAmplitude);
+	}
+
+	return totalNoise;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Leftover samples at the end of a range or row go through SmoothNoise itself.
+//------------------------------------------------------------------------------------------------------------------
+static float ComputeScalar2dFractalNoise(float posX, float posY, FractalNoiseSettings const& settings)
+{
+	return Compute2dFractalNoise(posX, posY, settings.m_scale, settings.m_numOctaves, settings.m_octavePersistence, settings.m_octaveScale, settings.m_renormalize, settings.m_seed);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static float ComputeScalar3dFractalNoise(float posX, float posY, float posZ, FractalNoiseSettings const& settings)
+{
+	return Compute3dFractalNoise(posX, posY, posZ, settings.m_scale, settings.m_numOctaves, settings.m_octavePersistence, settings.m_octaveScale, settings.m_renormalize, settings.m_seed);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Work for the dispatcher: Fill(start, end) computes items [start, end), where an item is one sample of the
+// arbitrary-position versions or one row of a grid. Ranges of single samples start on lane-group boundaries.
+//------------------------------------------------------------------------------------------------------------------
+struct FractalNoise2dPositions
+{
+	static constexpr int ITEM_GRANULARITY = NoiseLaneOps::WIDTH;
+
+	float const*			m_posXs = nullptr;
+	float const*			m_posYs = nullptr;
+	float*					m_noise = nullptr;
+	FractalNoiseSettings	m_settings;
+
+	void Fill(int start, int end) const
+	{
+		int index = start;
+		for(; index + NoiseLaneOps::WIDTH <= end; index += NoiseLaneOps::WIDTH)
+		{
+			NoiseFloats posX = NoiseFloatOps::Load(m_posXs + index);
+			NoiseFloats posY = NoiseFloatOps::Load(m_posYs + index);
+			NoiseFloatOps::Store(m_noise + index, Compute2dFractalNoiseLanes(posX, posY, m_settings));
+		}
+
+		for(; index < end; ++index)
+		{
+			m_noise[index] = ComputeScalar2dFractalNoise(m_posXs[index], m_posYs[index], m_settings);
+		}
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct FractalNoise3dPositions
+{
+	static constexpr int ITEM_GRANULARITY = NoiseLaneOps::WIDTH;
+
+	float const*			m_posXs = nullptr;
+	float const*			m_posYs = nullptr;
+	float const*			m_posZs = nullptr;
+	float*					m_noise = nullptr;
+	FractalNoiseSettings	m_settings;
+
+	void Fill(int start, int end) const
+	{
+		int index = start;
+		for(; index + NoiseLaneOps::WIDTH <= end; index += NoiseLaneOps::WIDTH)
+		{
+			NoiseFloats posX = NoiseFloatOps::Load(m_posXs + index);
+			NoiseFloats posY = NoiseFloatOps::Load(m_posYs + index);
+			NoiseFloats posZ = NoiseFloatOps::Load(m_posZs + index);
+			NoiseFloatOps::Store(m_noise + index, Compute3dFractalNoiseLanes(posX, posY, posZ, m_settings));
+		}
+
+		for(; index < end; ++index)
+		{
+			m_noise[index] = ComputeScalar3dFractalNoise(m_posXs[index], m_posYs[index], m_posZs[index], m_settings);
+		}
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Fills one grid row at a fixed y (and z); x positions are origin.x + (float) x * spacing.x in every lane.
+//------------------------------------------------------------------------------------------------------------------
+static void Fill2dFractalNoiseRow(int width, float originX, float spacingX, NoiseFloats posY, float scalarPosY, float* out_noise, FractalNoiseSettings const& settings)
+{
+	NoiseFloats laneOrigin = NoiseFloatOps::Splat(originX);
+	NoiseFloats laneSpacing = NoiseFloatOps::Splat(spacingX);
+	NoiseUInts xIndexes = NoiseLaneOps::Sequence(0);
+	NoiseUInts xIndexStep = NoiseLaneOps::Splat(NoiseLaneOps::WIDTH);
+
+	int x = 0;
+	for(; x + NoiseLaneOps::WIDTH <= width; x += NoiseLaneOps::WIDTH)
+	{
+		NoiseFloats posX = NoiseFloatOps::Add(laneOrigin, NoiseFloatOps::Mul(NoiseLaneOps::ToFloat(xIndexes), laneSpacing));
+		NoiseFloatOps::Store(out_noise + x, Compute2dFractalNoiseLanes(posX, posY, settings));
+		xIndexes = NoiseLaneOps::Add(xIndexes, xIndexStep);
+	}
+
+	for(; x < width; ++x)
+	{
+		out_noise[x] = ComputeScalar2dFractalNoise(originX + static_cast<float>(x) * spacingX, scalarPosY, settings);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static void Fill3dFractalNoiseRow(int width, float originX, float spacingX, NoiseFloats posY, NoiseFloats posZ, float scalarPosY, float scalarPosZ, float* out_noise, FractalNoiseSettings const& settings)
+{
+	NoiseFloats laneOrigin = NoiseFloatOps::Splat(originX);
+	NoiseFloats laneSpacing = NoiseFloatOps::Splat(spacingX);
+	NoiseUInts xIndexes = NoiseLaneOps::Sequence(0);
+	NoiseUInts xIndexStep = NoiseLaneOps::Splat(NoiseLaneOps::WIDTH);
+
+	int x = 0;
+	for(; x + NoiseLaneOps::WIDTH <= width; x += NoiseLaneOps::WIDTH)
+	{
+		NoiseFloats posX = NoiseFloatOps::Add(laneOrigin, NoiseFloatOps::Mul(NoiseLaneOps::ToFloat(xIndexes), laneSpacing));
+		NoiseFloatOps::Store(out_noise + x, Compute3dFractalNoiseLanes(posX, posY, posZ, settings));
+		xIndexes = NoiseLaneOps::Add(xIndexes, xIndexStep);
+	}
+
+	for(; x < width; ++x)
+	{
+		out_noise[x] = ComputeScalar3dFractalNoise(originX + static_cast<float>(x) * spacingX, scalarPosY, scalarPosZ, settings);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+struct FractalNoise2dRows
+{
+	static constexpr int ITEM_GRANULARITY = 1;
+
+	IntVec2					m_dims;
+	Vec2					m_origin;
+	Vec2					m_spacing;
+	float*					m_noise = nullptr;
+	FractalNoiseSettings	m_settings;
+
+	void Fill(int firstRow, int endRow) const
+	{
+		for(int y = firstRow; y < endRow; ++y)
+		{
+			float posY = m_origin.y + static_cast<float>(y) * m_spacing.y;
+			float* rowNoise = m_noise + y * m_dims.x;
+			Fill2dFractalNoiseRow(m_dims.x, m_origin.x, m_spacing.x, NoiseFloatOps::Splat(posY), posY, rowNoise, m_settings);
+		}
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct FractalNoise3dRows
+{
+	static constexpr int ITEM_GRANULARITY = 1;
+
+	IntVec3					m_dims;
+	Vec3					m_origin;
+	Vec3					m_spacing;
+	float*					m_noise = nullptr;
+	FractalNoiseSettings	m_settings;
+
+	void Fill(int firstRow, int endRow) const
+	{
+		for(int rowIndex = firstRow; rowIndex < endRow; ++rowIndex)
+		{
+			int y = rowIndex % m_dims.y;
+			int z = rowIndex / m_dims.y;
+			float posY = m_origin.y + static_cast<float>(y) * m_spacing.y;
+			float posZ = m_origin.z + static_cast<float>(z) * m_spacing.z;
+			float* rowNoise = m_noise + rowIndex * m_dims.x;
+			Fill3dFractalNoiseRow(m_dims.x, m_origin.x, m_spacing.x, NoiseFloatOps::Splat(posY), NoiseFloatOps::Splat(posZ), posY, posZ, rowNoise, m_settings);
+		}
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename Work>
+class FractalNoiseJob : public Job
+{
+public:
+	virtual void Execute() override
+	{
+		m_work->Fill(m_start, m_end);
+	}
+
+public:
+	Work const*		m_work = nullptr;
+	int				m_start = 0;
+	int				m_end = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Splits the items into one range per JobSystem thread (workers plus the caller) at most, never fewer than
+// MIN_SAMPLES_PER_NOISE_JOB samples each. Ranges write disjoint parts of the output, so the result does not depend on
+// which thread filled what.
+template<typename Work>
+static void DispatchFractalNoise(Work const& work, int numItems, int samplesPerItem, JobSystem* jobSystem)
+{
+	if(numItems <= 0 || samplesPerItem <= 0)
+	{
+		return;
+	}
+
+	// ranges start on an item-group boundary so no two ranges share a SIMD group
+	std::vector<int> rangeStarts;
+	int minItemsPerRange = GetMax(MIN_SAMPLES_PER_NOISE_JOB / samplesPerItem, 1);
+	SplitIntoJobRanges(0, numItems, minItemsPerRange, jobSystem, rangeStarts, Work::ITEM_GRANULARITY);
+
+	int numRanges = static_cast<int>(rangeStarts.size()) - 1;
+	if(numRanges == 1)
+	{
+		work.Fill(0, numItems);
+		return;
+	}
+
+	std::vector<FractalNoiseJob<Work>> jobs(numRanges);
+	for(int rangeIndex = 0; rangeIndex < numRanges; ++rangeIndex)
+	{
+		FractalNoiseJob<Work>& job = jobs[rangeIndex];
+		job.m_work = &work;
+		job.m_start = rangeStarts[rangeIndex];
+		job.m_end = rangeStarts[rangeIndex + 1];
+	}
+
+	jobSystem->ExecuteJobsAndWait(jobs);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static FractalNoiseSettings MakeFractalNoiseSettings(float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed)
+{
+	FractalNoiseSettings settings;
+	settings.m_scale = scale;
+	settings.m_numOctaves = numOctaves;
+	settings.m_octavePersistence = octavePersistence;
+	settings.m_octaveScale = octaveScale;
+	settings.m_renormalize = renormalize;
+	settings.m_seed = seed;
+	return settings;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void Compute2dFractalNoiseBatch(int count, float const* posXs, float const* posYs, float* out_noise, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed, JobSystem* jobSystem)
+{
+	FractalNoise2dPositions work;
+	work.m_posXs = posXs;
+	work.m_posYs = posYs;
+	work.m_noise = out_noise;
+	work.m_settings = MakeFractalNoiseSettings(scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+	DispatchFractalNoise(work, count, 1, jobSystem);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void Compute3dFractalNoiseBatch(int count, float const* posXs, float const* posYs, float const* posZs, float* out_noise, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed, JobSystem* jobSystem)
+{
+	FractalNoise3dPositions work;
+	work.m_posXs = posXs;
+	work.m_posYs = posYs;
+	work.m_posZs = posZs;
+	work.m_noise = out_noise;
+	work.m_settings = MakeFractalNoiseSettings(scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+	DispatchFractalNoise(work, count, 1, jobSystem);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void Compute2dFractalNoiseGrid(IntVec2 const& dims, Vec2 const& origin, Vec2 const& spacing, float* out_noise, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed, JobSystem* jobSystem)
+{
+	FractalNoise2dRows work;
+	work.m_dims = dims;
+	work.m_origin = origin;
+	work.m_spacing = spacing;
+	work.m_noise = out_noise;
+	work.m_settings = MakeFractalNoiseSettings(scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+	DispatchFractalNoise(work, dims.y, dims.x, jobSystem);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void Compute3dFractalNoiseGrid(IntVec3 const& dims, Vec3 const& origin, Vec3 const& spacing, float* out_noise, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed, JobSystem* jobSystem)
+{
+	if(dims.y <= 0 || dims.z <= 0)
+	{
+		return;
+	}
+
+	FractalNoise3dRows work;
+	work.m_dims = dims;
+	work.m_origin = origin;
+	work.m_spacing = spacing;
+	work.m_noise = out_noise;
+	work.m_settings = MakeFractalNoiseSettings(scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+	DispatchFractalNoise(work, dims.y * dims.z, dims.x, jobSystem);
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/IntVec3.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+//------------------------------------------------------------------------------------------------------------------
+class JobSystem;
+
+//------------------------------------------------------------------------------------------------------------------
+// Batch versions of Compute2dFractalNoise and Compute3dFractalNoise (ThirdParty/Noise/SmoothNoise) for filling
+// heightmaps, density fields and other grids of samples. The settings mean the same as in the scalar functions, and
+// every output is bit-for-bit what the scalar function returns for that position, so batch and one-off lookups of
+// the same field always agree.
+//
+// Samples run 8 lanes wide on AVX2 builds (4 otherwise), hashing all the lattice corners of an octave in SIMD. With a
+// JobSystem, big batches are split into ranges (rows, for the grids) that workers fill while the calling thread fills
+// the first one.
+//
+// The grids sample origin + index * spacing per axis and write x fastest: out_noise[(z * dims.y + y) * dims.x + x].
+// The arbitrary-position versions take the coordinates as separate arrays.
+//
+// Exact agreement assumes the scalar build does not contract its multiplies and adds into fused multiply-adds;
+// MSVC's default /fp:precise doesn't, GCC and Clang with FMA enabled need -ffp-contract=off.
+//------------------------------------------------------------------------------------------------------------------
+void Compute2dFractalNoiseBatch(int count, float const* posXs, float const* posYs, float* out_noise, float scale = 1.f, unsigned int numOctaves = 1, float octavePersistence = 0.5f, float octaveScale = 2.f, bool renormalize = true, unsigned int seed = 0, JobSystem* jobSystem = nullptr);
+void Compute3dFractalNoiseBatch(int count, float const* posXs, float const* posYs, float const* posZs, float* out_noise, float scale = 1.f, unsigned int numOctaves = 1, float octavePersistence = 0.5f, float octaveScale = 2.f, bool renormalize = true, unsigned int seed = 0, JobSystem* jobSystem = nullptr);
+
+void Compute2dFractalNoiseGrid(IntVec2 const& dims, Vec2 const& origin, Vec2 const& spacing, float* out_noise, float scale = 1.f, unsigned int numOctaves = 1, float octavePersistence = 0.5f, float octaveScale = 2.f, bool renormalize = true, unsigned int seed = 0, JobSystem* jobSystem = nullptr);
+void Compute3dFractalNoiseGrid(IntVec3 const& dims, Vec3 const& origin, Vec3 const& spacing, float* out_noise, float scale = 1.f, unsigned int numOctaves = 1, float octavePersistence = 0.5f, float octaveScale = 2.f, bool renormalize = true, unsigned int seed = 0, JobSystem* jobSystem = nullptr);
@@ -0,0 +1,157 @@
+#include "Engine/Math/BatchTransformUtils.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/SIMDUtils.hpp"
+
+#include <math.h>
+
+//------------------------------------------------------------------------------------------------------------------
+constexpr float BATCH_TRANSFORM_EPSILON = 1e-5f;
+constexpr float MIN_RENORMALIZE_LENGTH = 1e-20f;
+
+//------------------------------------------------------------------------------------------------------------------
+static void SetMatrix3(float* out_matrix, Vec3 const& iBasis, Vec3 const& jBasis, Vec3 const& kBasis)
+{
+	out_matrix[0] = iBasis.x;	out_matrix[1] = iBasis.y;	out_matrix[2] = iBasis.z;
+	out_matrix[3] = jBasis.x;	out_matrix[4] = jBasis.y;	out_matrix[5] = jBasis.z;
+	out_matrix[6] = kBasis.x;	out_matrix[7] = kBasis.y;	out_matrix[8] = kBasis.z;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+BatchTransform3D BatchTransform3D::MakeFromMat44(Mat44 const& transform, float uniformPreScale)
+{
+	BatchTransform3D batchTransform;
+
+	Vec3 iBasis = transform.GetIBasis3D();
+	Vec3 jBasis = transform.GetJBasis3D();
+	Vec3 kBasis = transform.GetKBasis3D();
+	Vec3 translation = transform.GetTranslation3D();
+
+	SetMatrix3(batchTransform.m_linear, iBasis * uniformPreScale, jBasis * uniformPreScale, kBasis * uniformPreScale);
+	batchTransform.m_translation[0] = translation.x;
+	batchTransform.m_translation[1] = translation.y;
+	batchTransform.m_translation[2] = translation.z;
+
+	// exact, since even a tiny rotation turns normals and any tolerance here would leave them stale
+	batchTransform.m_isTranslationOnly = iBasis == Vec3(1.f, 0.f, 0.f) && jBasis == Vec3(0.f, 1.f, 0.f) && kBasis == Vec3(0.f, 0.f, 1.f);
+
+	// the pre-scale is uniform, so it never changes tangent or normal directions
+	float iLength = iBasis.GetLength();
+	float jLength = jBasis.GetLength();
+	float kLength = kBasis.GetLength();
+	float maxLength = GetMax(iLength, GetMax(jLength, kLength));
+	float lengthTolerance = BATCH_TRANSFORM_EPSILON * maxLength;
+	float dotTolerance = BATCH_TRANSFORM_EPSILON * maxLength * maxLength;
+
+	batchTransform.m_isSimilarity = maxLength > 0.f &&
+									fabsf(iLength - jLength) < lengthTolerance && fabsf(iLength - kLength) < lengthTolerance &&
+									fabsf(DotProduct3D(iBasis, jBasis)) < dotTolerance &&
+									fabsf(DotProduct3D(iBasis, kBasis)) < dotTolerance &&
+									fabsf(DotProduct3D(jBasis, kBasis)) < dotTolerance;
+
+	if(batchTransform.m_isSimilarity)
+	{
+		float invScale = 1.f / iLength;
+		SetMatrix3(batchTransform.m_tangentMatrix, iBasis * invScale, jBasis * invScale, kBasis * invScale);
+		SetMatrix3(batchTransform.m_normalMatrix, iBasis * invScale, jBasis * invScale, kBasis * invScale);
+	}
+	else
+	{
+		// the cofactor matrix is the inverse transpose up to a scale factor, which renormalization removes anyway
+		SetMatrix3(batchTransform.m_tangentMatrix, iBasis, jBasis, kBasis);
+		SetMatrix3(batchTransform.m_normalMatrix, CrossProduct3D(jBasis, kBasis), CrossProduct3D(kBasis, iBasis), CrossProduct3D(iBasis, jBasis));
+	}
+
+	return batchTransform;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Transforms lanes [startIndex, count) in steps of Ops::WIDTH and returns the first index it did not reach.
+template<typename Ops>
+static int TransformSoA(float const* matrix, float const* translation, bool renormalize, int startIndex, int count, float* xs, float* ys, float* zs)
+{
+	typedef typename Ops::Type Lane;
+
+	Lane ix = Ops::Splat(matrix[0]);	Lane iy = Ops::Splat(matrix[1]);	Lane iz = Ops::Splat(matrix[2]);
+	Lane jx = Ops::Splat(matrix[3]);	Lane jy = Ops::Splat(matrix[4]);	Lane jz = Ops::Splat(matrix[5]);
+	Lane kx = Ops::Splat(matrix[6]);	Lane ky = Ops::Splat(matrix[7]);	Lane kz = Ops::Splat(matrix[8]);
+
+	Lane tx = Ops::Splat(translation ? translation[0] : 0.f);
+	Lane ty = Ops::Splat(translation ? translation[1] : 0.f);
+	Lane tz = Ops::Splat(translation ? translation[2] : 0.f);
+
+	Lane one = Ops::Splat(1.f);
+	Lane minLength = Ops::Splat(MIN_RENORMALIZE_LENGTH);
+
+	int index = startIndex;
+	for(; index + Ops::WIDTH <= count; index += Ops::WIDTH)
+	{
+		Lane x = Ops::Load(&xs[index]);
+		Lane y = Ops::Load(&ys[index]);
+		Lane z = Ops::Load(&zs[index]);
+
+		Lane outX = Ops::MulAdd(ix, x, Ops::MulAdd(jx, y, Ops::MulAdd(kx, z, tx)));
+		Lane outY = Ops::MulAdd(iy, x, Ops::MulAdd(jy, y, Ops::MulAdd(ky, z, ty)));
+		Lane outZ = Ops::MulAdd(iz, x, Ops::MulAdd(jz, y, Ops::MulAdd(kz, z, tz)));
+
+		if(renormalize)
+		{
+			// zero-length inputs stay zero instead of turning into NaNs
+			Lane lengthSquared = Ops::MulAdd(outX, outX, Ops::MulAdd(outY, outY, Ops::Mul(outZ, outZ)));
+			Lane invLength = Ops::Div(one, Ops::Max(Ops::Sqrt(lengthSquared), minLength));
+			outX = Ops::Mul(outX, invLength);
+			outY = Ops::Mul(outY, invLength);
+			outZ = Ops::Mul(outZ, invLength);
+		}
+
+		Ops::Store(&xs[index], outX);
+		Ops::Store(&ys[index], outY);
+		Ops::Store(&zs[index], outZ);
+	}
+
+	return index;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static void TransformSoA(float const* matrix, float const* translation, bool renormalize, int count, float* xs, float* ys, float* zs)
+{
+	int index = 0;
+
+#if defined(ENGINE_SIMD_AVX2)
+	index = TransformSoA<Float8Ops>(matrix, translation, renormalize, index, count, xs, ys, zs);
+#endif
+#if defined(ENGINE_SIMD_FLOAT4)
+	index = TransformSoA<Float4Ops>(matrix, translation, renormalize, index, count, xs, ys, zs);
+#endif
+
+	TransformSoA<Float1Ops>(matrix, translation, renormalize, index, count, xs, ys, zs);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TransformPositionsSoA(BatchTransform3D const& transform, int count, float* xs, float* ys, float* zs)
+{
+	TransformSoA(transform.m_linear, transform.m_translation, false, count, xs, ys, zs);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TransformTangentsSoA(BatchTransform3D const& transform, int count, float* xs, float* ys, float* zs)
+{
+	if(transform.m_isTranslationOnly)
+	{
+		return;
+	}
+
+	TransformSoA(transform.m_tangentMatrix, nullptr, !transform.m_isSimilarity, count, xs, ys, zs);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TransformNormalsSoA(BatchTransform3D const& transform, int count, float* xs, float* ys, float* zs)
+{
+	if(transform.m_isTranslationOnly)
+	{
+		return;
+	}
+
+	TransformSoA(transform.m_normalMatrix, nullptr, !transform.m_isSimilarity, count, xs, ys, zs);
+}
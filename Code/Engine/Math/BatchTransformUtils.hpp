@@ -0,0 +1,30 @@
+#pragma once
+
+//------------------------------------------------------------------------------------------------------------------
+struct Mat44;
+
+//------------------------------------------------------------------------------------------------------------------
+// Everything a batch transform needs, worked out once per call instead of once per vertex.
+// Matrices are 3x3 column-major (I, J, K). For similarity transforms (rotation plus uniform scale) tangents and normals
+// go through the pure rotation and keep their length; any other transform uses the linear part for tangents and the
+// inverse transpose for normals, then renormalizes.
+//------------------------------------------------------------------------------------------------------------------
+struct BatchTransform3D
+{
+public:
+	static BatchTransform3D	MakeFromMat44(Mat44 const& transform, float uniformPreScale = 1.f);
+
+public:
+	float	m_linear[9] = { 1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f };
+	float	m_translation[3] = { 0.f, 0.f, 0.f };
+	float	m_tangentMatrix[9] = { 1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f };
+	float	m_normalMatrix[9] = { 1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f };
+	bool	m_isTranslationOnly = true;		// tangents and normals can be left untouched
+	bool	m_isSimilarity = true;			// no renormalization needed
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// SoA kernels. 8 lanes per iteration on AVX2 builds, 4 on SSE/NEON, scalar for the remainder.
+void TransformPositionsSoA(BatchTransform3D const& transform, int count, float* xs, float* ys, float* zs);
+void TransformTangentsSoA(BatchTransform3D const& transform, int count, float* xs, float* ys, float* zs);
+void TransformNormalsSoA(BatchTransform3D const& transform, int count, float* xs, float* ys, float* zs);
@@ -0,0 +1,248 @@
+#include "Engine/Math/ContactManifold2D.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/OBB2.hpp"
+
+#include <float.h>
+#include <math.h>
+
+//------------------------------------------------------------------------------------------------------------------
+// A box prefers its own face as the reference unless the other box's face separates them by clearly more, so the
+// choice does not flicker between frames when the two are nearly equal.
+constexpr float REFERENCE_FACE_TOLERANCE = 0.0005f;
+
+//------------------------------------------------------------------------------------------------------------------
+// Corners counter-clockwise from the local (-x, -y) corner; edge k runs from corner k to corner k + 1.
+struct BoxPolygon2D
+{
+	Vec2	m_corners[4];
+	Vec2	m_edgeNormals[4];
+};
+
+//------------------------------------------------------------------------------------------------------------------
+static BoxPolygon2D MakeBoxPolygon2D(OBB2 const& box)
+{
+	Vec2 iBasis = box.m_iBasisNormal;
+	Vec2 jBasis = iBasis.GetRotated90Degrees();
+	Vec2 iExtent = iBasis * box.m_halfDimension.x;
+	Vec2 jExtent = jBasis * box.m_halfDimension.y;
+
+	BoxPolygon2D polygon;
+	polygon.m_corners[0] = box.m_center - iExtent - jExtent;
+	polygon.m_corners[1] = box.m_center + iExtent - jExtent;
+	polygon.m_corners[2] = box.m_center + iExtent + jExtent;
+	polygon.m_corners[3] = box.m_center - iExtent + jExtent;
+	polygon.m_edgeNormals[0] = -jBasis;
+	polygon.m_edgeNormals[1] = iBasis;
+	polygon.m_edgeNormals[2] = jBasis;
+	polygon.m_edgeNormals[3] = -iBasis;
+	return polygon;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// The edge of polygonA whose outward normal separates the two the most (or overlaps them the least).
+static float FindMaxSeparation(BoxPolygon2D const& polygonA, BoxPolygon2D const& polygonB, int& out_edgeIndex)
+{
+	float maxSeparation = -FLT_MAX;
+	out_edgeIndex = 0;
+
+	for(int edgeIndex = 0; edgeIndex < 4; ++edgeIndex)
+	{
+		Vec2 const& normal = polygonA.m_edgeNormals[edgeIndex];
+		float edgeSeparation = FLT_MAX;
+		for(int cornerIndex = 0; cornerIndex < 4; ++cornerIndex)
+		{
+			edgeSeparation = GetMin(edgeSeparation, DotProduct2D(normal, polygonB.m_corners[cornerIndex] - polygonA.m_corners[edgeIndex]));
+		}
+
+		if(edgeSeparation > maxSeparation)
+		{
+			maxSeparation = edgeSeparation;
+			out_edgeIndex = edgeIndex;
+		}
+	}
+
+	return maxSeparation;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Cuts the segment back to the side of the line dot(normal, p) = offset it is mostly on, keeping the ends in order so
+// each end stays the same contact point from one step to the next. Returns false when the whole segment is in front.
+static bool ClipSegmentToLine(Vec2& inout_start, Vec2& inout_end, Vec2 const& normal, float offset)
+{
+	float startDistance = DotProduct2D(normal, inout_start) - offset;
+	float endDistance = DotProduct2D(normal, inout_end) - offset;
+	if(startDistance > 0.f && endDistance > 0.f)
+	{
+		return false;
+	}
+
+	if(startDistance > 0.f || endDistance > 0.f)
+	{
+		Vec2 crossing = inout_start + ((inout_end - inout_start) * (startDistance / (startDistance - endDistance)));
+		if(startDistance > 0.f)
+		{
+			inout_start = crossing;
+		}
+		else
+		{
+			inout_end = crossing;
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool GetDiscVsDiscManifold2D(Vec2 const& centerA, float radiusA, Vec2 const& centerB, float radiusB, ContactManifold2D& out_manifold, float speculativeDistance)
+{
+	out_manifold.m_numPoints = 0;
+
+	Vec2 displacement = centerB - centerA;
+	float distance = displacement.GetLength();
+	float separation = distance - radiusA - radiusB;
+	if(separation > speculativeDistance)
+	{
+		return false;
+	}
+
+	out_manifold.m_normal = (distance > 0.f) ? displacement / distance : Vec2(1.f, 0.f);
+	out_manifold.m_points[0].m_position = centerA + (out_manifold.m_normal * (radiusA + (0.5f * separation)));
+	out_manifold.m_points[0].m_separation = separation;
+	out_manifold.m_points[0].m_featureKey = 0;
+	out_manifold.m_numPoints = 1;
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool GetDiscVsOBB2Manifold2D(Vec2 const& discCenter, float discRadius, OBB2 const& box, ContactManifold2D& out_manifold, float speculativeDistance)
+{
+	out_manifold.m_numPoints = 0;
+
+	Vec2 iBasis = box.m_iBasisNormal;
+	Vec2 jBasis = iBasis.GetRotated90Degrees();
+	Vec2 localCenter = box.GetLocalPosForWorldPos(discCenter);
+	Vec2 halfDimensions = box.m_halfDimension;
+
+	Vec2 localSurfacePoint(GetClamped(localCenter.x, -halfDimensions.x, halfDimensions.x), GetClamped(localCenter.y, -halfDimensions.y, halfDimensions.y));
+	Vec2 localNormal;
+	float separation;
+
+	if(localSurfacePoint != localCenter)
+	{
+		Vec2 surfaceToCenter = localCenter - localSurfacePoint;
+		float distance = surfaceToCenter.GetLength();
+		separation = distance - discRadius;
+		localNormal = surfaceToCenter / distance;
+	}
+	else
+	{
+		// the center is inside the box, so the disc leaves through the nearest face
+		float xDepth = halfDimensions.x - fabsf(localCenter.x);
+		float yDepth = halfDimensions.y - fabsf(localCenter.y);
+		if(xDepth < yDepth)
+		{
+			localNormal = Vec2(localCenter.x < 0.f ? -1.f : 1.f, 0.f);
+			localSurfacePoint.x = localNormal.x * halfDimensions.x;
+			separation = -xDepth - discRadius;
+		}
+		else
+		{
+			localNormal = Vec2(0.f, localCenter.y < 0.f ? -1.f : 1.f);
+			localSurfacePoint.y = localNormal.y * halfDimensions.y;
+			separation = -yDepth - discRadius;
+		}
+	}
+
+	if(separation > speculativeDistance)
+	{
+		return false;
+	}
+
+	// the local normal points from the box out toward the disc; the manifold's goes from the disc to the box
+	Vec2 boxToDisc = (iBasis * localNormal.x) + (jBasis * localNormal.y);
+	Vec2 boxSurfacePoint = box.GetWorldPosForLocalPos(localSurfacePoint);
+	Vec2 discSurfacePoint = discCenter - (boxToDisc * discRadius);
+
+	out_manifold.m_normal = -boxToDisc;
+	out_manifold.m_points[0].m_position = (boxSurfacePoint + discSurfacePoint) * 0.5f;
+	out_manifold.m_points[0].m_separation = separation;
+	out_manifold.m_points[0].m_featureKey = 0;
+	out_manifold.m_numPoints = 1;
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool GetOBB2VsOBB2Manifold2D(OBB2 const& boxA, OBB2 const& boxB, ContactManifold2D& out_manifold, float speculativeDistance)
+{
+	out_manifold.m_numPoints = 0;
+
+	BoxPolygon2D polygonA = MakeBoxPolygon2D(boxA);
+	BoxPolygon2D polygonB = MakeBoxPolygon2D(boxB);
+
+	int edgeA;
+	float separationA = FindMaxSeparation(polygonA, polygonB, edgeA);
+	if(separationA > speculativeDistance)
+	{
+		return false;
+	}
+
+	int edgeB;
+	float separationB = FindMaxSeparation(polygonB, polygonA, edgeB);
+	if(separationB > speculativeDistance)
+	{
+		return false;
+	}
+
+	bool isReferenceB = separationB > separationA + REFERENCE_FACE_TOLERANCE;
+	BoxPolygon2D const& reference = isReferenceB ? polygonB : polygonA;
+	BoxPolygon2D const& incident = isReferenceB ? polygonA : polygonB;
+	int referenceEdge = isReferenceB ? edgeB : edgeA;
+	Vec2 referenceNormal = reference.m_edgeNormals[referenceEdge];
+
+	// the incident edge is the one facing most directly against the reference face
+	int incidentEdge = 0;
+	float minDot = FLT_MAX;
+	for(int edgeIndex = 0; edgeIndex < 4; ++edgeIndex)
+	{
+		float normalDot = DotProduct2D(referenceNormal, incident.m_edgeNormals[edgeIndex]);
+		if(normalDot < minDot)
+		{
+			minDot = normalDot;
+			incidentEdge = edgeIndex;
+		}
+	}
+
+	Vec2 incidentPoints[2] = { incident.m_corners[incidentEdge], incident.m_corners[(incidentEdge + 1) % 4] };
+
+	// clip to the two side planes through the ends of the reference face
+	Vec2 referenceStart = reference.m_corners[referenceEdge];
+	Vec2 referenceEnd = reference.m_corners[(referenceEdge + 1) % 4];
+	Vec2 tangent = (referenceEnd - referenceStart).GetNormalized();
+	if(!ClipSegmentToLine(incidentPoints[0], incidentPoints[1], -tangent, -DotProduct2D(tangent, referenceStart)))
+	{
+		return false;
+	}
+	if(!ClipSegmentToLine(incidentPoints[0], incidentPoints[1], tangent, DotProduct2D(tangent, referenceEnd)))
+	{
+		return false;
+	}
+
+	// keyed by the faces and the end of the incident edge, not by whether that end was clipped, which can flicker
+	// when equal boxes sit flush on each other
+	out_manifold.m_normal = isReferenceB ? -referenceNormal : referenceNormal;
+	for(int pointIndex = 0; pointIndex < 2; ++pointIndex)
+	{
+		float separation = DotProduct2D(referenceNormal, incidentPoints[pointIndex] - referenceStart);
+		if(separation > speculativeDistance)
+		{
+			continue;
+		}
+
+		ContactPoint2D& point = out_manifold.m_points[out_manifold.m_numPoints++];
+		point.m_position = incidentPoints[pointIndex] - (referenceNormal * (0.5f * separation));
+		point.m_separation = separation;
+		point.m_featureKey = ((isReferenceB ? 1 : 0) << 8) | (referenceEdge << 4) | (incidentEdge << 1) | pointIndex;
+	}
+
+	return out_manifold.m_numPoints > 0;
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "Engine/Math/Vec2.hpp"
+
+//------------------------------------------------------------------------------------------------------------------
+struct OBB2;
+
+//------------------------------------------------------------------------------------------------------------------
+struct ContactPoint2D
+{
+	Vec2	m_position;					// midway between the two surfaces
+	float	m_separation = 0.f;			// negative when the shapes overlap
+	int		m_featureKey = 0;			// which edges and corners made this point; stays the same while the contact lasts
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct ContactManifold2D
+{
+	Vec2			m_normal;			// from shape A toward shape B
+	ContactPoint2D	m_points[2];
+	int				m_numPoints = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Contact manifolds for a physics solver: the normal and up to two points where shapes A and B touch or overlap.
+// Shapes closer than speculativeDistance count as touching with a positive separation, so a solver can stop them
+// meeting during the next step instead of resolving the overlap afterwards. Each returns false, leaving the manifold
+// empty, when the shapes are farther apart than that.
+//
+// Box vs box clips the incident edge of one box against the reference face of the other, so resting boxes get two
+// points. Feature keys let the solver carry impulses from one step to the next for the same point.
+//------------------------------------------------------------------------------------------------------------------
+bool GetDiscVsDiscManifold2D(Vec2 const& centerA, float radiusA, Vec2 const& centerB, float radiusB, ContactManifold2D& out_manifold, float speculativeDistance = 0.f);
+bool GetDiscVsOBB2Manifold2D(Vec2 const& discCenter, float discRadius, OBB2 const& box, ContactManifold2D& out_manifold, float speculativeDistance = 0.f);
+bool GetOBB2VsOBB2Manifold2D(OBB2 const& boxA, OBB2 const& boxB, ContactManifold2D& out_manifold, float speculativeDistance = 0.f);
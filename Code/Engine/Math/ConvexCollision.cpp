@@ -0,0 +1,1090 @@
+#include "Engine/Math/ConvexCollision.hpp"
+#include "Engine/Math/ConvexHull2.hpp"
+#include "Engine/Math/ConvexPoly2.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <float.h>
+#include <math.h>
+#include <utility>
+
+//------------------------------------------------------------------------------------------------------------------
+constexpr int GJK_MAX_ITERATIONS = 64;
+constexpr float GJK_RELATIVE_TOLERANCE = 1e-5f;				// of the squared distance, for the convergence test
+constexpr float GJK_TOUCHING_RELATIVE_DISTANCE_SQUARED = 1e-10f;	// the origin is on the simplex, to float precision
+constexpr int EPA_MAX_ITERATIONS = 128;
+constexpr float EPA_RELATIVE_TOLERANCE = 1e-4f;
+constexpr float DEGENERATE_EPSILON = 1e-12f;
+
+//------------------------------------------------------------------------------------------------------------------
+// Support mappings
+//------------------------------------------------------------------------------------------------------------------
+Vec3 SphereSupport::GetSupportPoint(Vec3 const& direction) const
+{
+	float length = direction.GetLength();
+	if(length <= 0.f)
+	{
+		return m_sphere.m_center + Vec3(m_sphere.m_radius, 0.f, 0.f);
+	}
+
+	return m_sphere.m_center + direction * (m_sphere.m_radius / length);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+Vec3 AABB3Support::GetSupportPoint(Vec3 const& direction) const
+{
+	return Vec3(direction.x >= 0.f ? m_box.m_maxs.x : m_box.m_mins.x,
+				direction.y >= 0.f ? m_box.m_maxs.y : m_box.m_mins.y,
+				direction.z >= 0.f ? m_box.m_maxs.z : m_box.m_mins.z);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+Vec3 AABB3Support::GetCenter() const
+{
+	return m_box.GetCenter();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+Vec3 OBB3Support::GetSupportPoint(Vec3 const& direction) const
+{
+	float iExtent = DotProduct3D(direction, m_box.m_iBasis) >= 0.f ? m_box.m_halfDimensions.x : -m_box.m_halfDimensions.x;
+	float jExtent = DotProduct3D(direction, m_box.m_jBasis) >= 0.f ? m_box.m_halfDimensions.y : -m_box.m_halfDimensions.y;
+	float kExtent = DotProduct3D(direction, m_box.m_kBasis) >= 0.f ? m_box.m_halfDimensions.z : -m_box.m_halfDimensions.z;
+	return m_box.m_center + (m_box.m_iBasis * iExtent) + (m_box.m_jBasis * jExtent) + (m_box.m_kBasis * kExtent);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+Vec3 Cylinder3DSupport::GetSupportPoint(Vec3 const& direction) const
+{
+	Vec3 support = m_cylinder.m_startPosition;
+	if(direction.z > 0.f)
+	{
+		support.z += m_cylinder.m_height;
+	}
+
+	float lengthXY = direction.GetLengthXY();
+	if(lengthXY > 0.f)
+	{
+		float scale = m_cylinder.m_radius / lengthXY;
+		support.x += direction.x * scale;
+		support.y += direction.y * scale;
+	}
+
+	return support;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+Vec3 Cylinder3DSupport::GetCenter() const
+{
+	return m_cylinder.GetCenter();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+ConvexPoly2Support::ConvexPoly2Support(ConvexPoly2 const& poly)
+{
+	poly.GetVertexPositions(m_vertexPositions);
+	ComputeCenter();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+ConvexPoly2Support::ConvexPoly2Support(std::vector<Vec2> const& vertexPositions)
+	: m_vertexPositions(vertexPositions)
+{
+	ComputeCenter();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+Vec2 ConvexPoly2Support::GetSupportPoint(Vec2 const& direction) const
+{
+	int bestIndex = 0;
+	float bestDot = -FLT_MAX;
+	for(int vertIndex = 0; vertIndex < static_cast<int>(m_vertexPositions.size()); ++vertIndex)
+	{
+		float dot = DotProduct2D(m_vertexPositions[vertIndex], direction);
+		if(dot > bestDot)
+		{
+			bestDot = dot;
+			bestIndex = vertIndex;
+		}
+	}
+
+	return m_vertexPositions[bestIndex];
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void ConvexPoly2Support::ComputeCenter()
+{
+	GUARANTEE_OR_DIE(!m_vertexPositions.empty(), "ConvexPoly2Support needs at least one vertex");
+
+	m_center = Vec2();
+	for(Vec2 const& position : m_vertexPositions)
+	{
+		m_center += position;
+	}
+	m_center /= static_cast<float>(m_vertexPositions.size());
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Every corner is where two planes meet and lies behind all the others. Hulls are a handful of planes and this runs
+// once per adapter, so trying every pair is fine.
+//------------------------------------------------------------------------------------------------------------------
+ConvexHull2Support::ConvexHull2Support(ConvexHull2 const& hull)
+{
+	constexpr float INSIDE_TOLERANCE = 1e-4f;
+	std::vector<Plane2> const& planes = hull.m_planes;
+	int numPlanes = static_cast<int>(planes.size());
+
+	for(int planeIndexA = 0; planeIndexA < numPlanes; ++planeIndexA)
+	{
+		for(int planeIndexB = planeIndexA + 1; planeIndexB < numPlanes; ++planeIndexB)
+		{
+			Plane2 const& planeA = planes[planeIndexA];
+			Plane2 const& planeB = planes[planeIndexB];
+			float determinant = CrossProduct2D(planeA.m_normal, planeB.m_normal);
+			if(fabsf(determinant) <= 1e-6f)
+			{
+				continue;
+			}
+
+			Vec2 corner;
+			corner.x = (planeA.m_distanceFromOrigin * planeB.m_normal.y - planeB.m_distanceFromOrigin * planeA.m_normal.y) / determinant;
+			corner.y = (planeB.m_distanceFromOrigin * planeA.m_normal.x - planeA.m_distanceFromOrigin * planeB.m_normal.x) / determinant;
+
+			bool isBehindAllPlanes = true;
+			for(Plane2 const& plane : planes)
+			{
+				if(DotProduct2D(corner, plane.m_normal) - plane.m_distanceFromOrigin > INSIDE_TOLERANCE)
+				{
+					isBehindAllPlanes = false;
+					break;
+				}
+			}
+
+			if(isBehindAllPlanes)
+			{
+				m_vertexPositions.push_back(corner);
+			}
+		}
+	}
+
+	GUARANTEE_OR_DIE(m_vertexPositions.size() >= 3, "ConvexHull2Support needs a closed, bounded hull");
+	ComputeCenter();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Simplexes. Each vertex is a point of the Minkowski difference A - B with the support points and the direction that
+// made it; weights are the barycentric coordinates of the simplex's closest point to the origin.
+//------------------------------------------------------------------------------------------------------------------
+static float DotProduct(Vec2 const& a, Vec2 const& b)		{ return DotProduct2D(a, b); }
+static float DotProduct(Vec3 const& a, Vec3 const& b)		{ return DotProduct3D(a, b); }
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename VecType>
+struct SimplexVertex
+{
+	VecType	m_point;
+	VecType	m_pointOnA;
+	VecType	m_pointOnB;
+	VecType	m_direction;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename VecType, int MAX_VERTICES>
+struct Simplex
+{
+	SimplexVertex<VecType>	m_vertices[MAX_VERTICES];
+	float					m_weights[MAX_VERTICES];
+	int						m_numVertices = 0;
+
+	VecType GetPoint() const
+	{
+		VecType point = m_vertices[0].m_point * m_weights[0];
+		for(int vertIndex = 1; vertIndex < m_numVertices; ++vertIndex)
+		{
+			point += m_vertices[vertIndex].m_point * m_weights[vertIndex];
+		}
+		return point;
+	}
+
+	void GetWitnessPoints(VecType& out_pointOnA, VecType& out_pointOnB) const
+	{
+		out_pointOnA = m_vertices[0].m_pointOnA * m_weights[0];
+		out_pointOnB = m_vertices[0].m_pointOnB * m_weights[0];
+		for(int vertIndex = 1; vertIndex < m_numVertices; ++vertIndex)
+		{
+			out_pointOnA += m_vertices[vertIndex].m_pointOnA * m_weights[vertIndex];
+			out_pointOnB += m_vertices[vertIndex].m_pointOnB * m_weights[vertIndex];
+		}
+	}
+
+	float GetMaxVertexLengthSquared() const
+	{
+		float maxLengthSquared = 0.f;
+		for(int vertIndex = 0; vertIndex < m_numVertices; ++vertIndex)
+		{
+			float lengthSquared = DotProduct(m_vertices[vertIndex].m_point, m_vertices[vertIndex].m_point);
+			maxLengthSquared = lengthSquared > maxLengthSquared ? lengthSquared : maxLengthSquared;
+		}
+		return maxLengthSquared;
+	}
+
+	bool Contains(VecType const& point) const
+	{
+		for(int vertIndex = 0; vertIndex < m_numVertices; ++vertIndex)
+		{
+			if(m_vertices[vertIndex].m_point == point)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+typedef Simplex<Vec3, 4> Simplex3D;
+typedef Simplex<Vec2, 3> Simplex2D;
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename VecType, typename SupportType>
+static SimplexVertex<VecType> GetMinkowskiSupport(SupportType const& shapeA, SupportType const& shapeB, VecType const& direction)
+{
+	SimplexVertex<VecType> vertex;
+	vertex.m_direction = direction;
+	vertex.m_pointOnA = shapeA.GetSupportPoint(direction);
+	vertex.m_pointOnB = shapeB.GetSupportPoint(-direction);
+	vertex.m_point = vertex.m_pointOnA - vertex.m_pointOnB;
+	return vertex;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Keeps the listed vertices, in that order, with their weights
+template<typename SimplexType>
+static void KeepSimplexVertices(SimplexType& simplex, int numKept, int const* keptIndexes, float const* keptWeights)
+{
+	SimplexType reduced;
+	reduced.m_numVertices = numKept;
+	for(int keptIndex = 0; keptIndex < numKept; ++keptIndex)
+	{
+		reduced.m_vertices[keptIndex] = simplex.m_vertices[keptIndexes[keptIndex]];
+		reduced.m_weights[keptIndex] = keptWeights[keptIndex];
+	}
+	simplex = reduced;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Closest point of segment (a, b) to the origin, as weights; returns how many vertices it needs
+template<typename VecType>
+static int SolveSegment(VecType const& a, VecType const& b, int* out_indexes, float* out_weights, int indexA, int indexB)
+{
+	VecType ab = b - a;
+	float abLengthSquared = DotProduct(ab, ab);
+	float t = abLengthSquared > DEGENERATE_EPSILON ? -DotProduct(a, ab) / abLengthSquared : 0.f;
+	if(t <= 0.f)
+	{
+		out_indexes[0] = indexA;
+		out_weights[0] = 1.f;
+		return 1;
+	}
+	if(t >= 1.f)
+	{
+		out_indexes[0] = indexB;
+		out_weights[0] = 1.f;
+		return 1;
+	}
+
+	out_indexes[0] = indexA;
+	out_indexes[1] = indexB;
+	out_weights[0] = 1.f - t;
+	out_weights[1] = t;
+	return 2;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Closest point of triangle (a, b, c) to the origin by Voronoi regions (Ericson, Real-Time Collision Detection 5.1.5).
+// Works the same in 2D, where the face region means the origin is inside.
+template<typename VecType>
+static int SolveTriangle(VecType const& a, VecType const& b, VecType const& c, int* out_indexes, float* out_weights, int indexA, int indexB, int indexC)
+{
+	VecType ab = b - a;
+	VecType ac = c - a;
+
+	float d1 = -DotProduct(ab, a);
+	float d2 = -DotProduct(ac, a);
+	if(d1 <= 0.f && d2 <= 0.f)
+	{
+		out_indexes[0] = indexA;
+		out_weights[0] = 1.f;
+		return 1;
+	}
+
+	float d3 = -DotProduct(ab, b);
+	float d4 = -DotProduct(ac, b);
+	if(d3 >= 0.f && d4 <= d3)
+	{
+		out_indexes[0] = indexB;
+		out_weights[0] = 1.f;
+		return 1;
+	}
+
+	float vc = d1 * d4 - d3 * d2;
+	if(vc <= 0.f && d1 >= 0.f && d3 <= 0.f)
+	{
+		return SolveSegment(a, b, out_indexes, out_weights, indexA, indexB);
+	}
+
+	float d5 = -DotProduct(ab, c);
+	float d6 = -DotProduct(ac, c);
+	if(d6 >= 0.f && d5 <= d6)
+	{
+		out_indexes[0] = indexC;
+		out_weights[0] = 1.f;
+		return 1;
+	}
+
+	float vb = d5 * d2 - d1 * d6;
+	if(vb <= 0.f && d2 >= 0.f && d6 <= 0.f)
+	{
+		return SolveSegment(a, c, out_indexes, out_weights, indexA, indexC);
+	}
+
+	float va = d3 * d6 - d5 * d4;
+	if(va <= 0.f && (d4 - d3) >= 0.f && (d5 - d6) >= 0.f)
+	{
+		return SolveSegment(b, c, out_indexes, out_weights, indexB, indexC);
+	}
+
+	float sum = va + vb + vc;
+	if(sum <= DEGENERATE_EPSILON)
+	{
+		// collinear; the nearest of the edges will do
+		int bestCount = 0;
+		float bestDistanceSquared = FLT_MAX;
+		VecType const* corners[3] = { &a, &b, &c };
+		int cornerIndexes[3] = { indexA, indexB, indexC };
+		for(int edgeIndex = 0; edgeIndex < 3; ++edgeIndex)
+		{
+			int edgeIndexes[2];
+			float edgeWeights[2];
+			int nextIndex = (edgeIndex + 1) % 3;
+			int count = SolveSegment(*corners[edgeIndex], *corners[nextIndex], edgeIndexes, edgeWeights, cornerIndexes[edgeIndex], cornerIndexes[nextIndex]);
+			VecType point = (count == 1) ? (edgeIndexes[0] == cornerIndexes[edgeIndex] ? *corners[edgeIndex] : *corners[nextIndex])
+										 : (*corners[edgeIndex] * edgeWeights[0]) + (*corners[nextIndex] * edgeWeights[1]);
+			float distanceSquared = DotProduct(point, point);
+			if(distanceSquared < bestDistanceSquared)
+			{
+				bestDistanceSquared = distanceSquared;
+				bestCount = count;
+				for(int kept = 0; kept < count; ++kept)
+				{
+					out_indexes[kept] = edgeIndexes[kept];
+					out_weights[kept] = edgeWeights[kept];
+				}
+			}
+		}
+		return bestCount;
+	}
+
+	float v = vb / sum;
+	float w = vc / sum;
+	out_indexes[0] = indexA;
+	out_indexes[1] = indexB;
+	out_indexes[2] = indexC;
+	out_weights[0] = 1.f - v - w;
+	out_weights[1] = v;
+	out_weights[2] = w;
+	return 3;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Whether the origin is on the other side of face (a, b, c) from d; flat tetrahedra test every face
+static bool IsOriginOutsideFace(Vec3 const& a, Vec3 const& b, Vec3 const& c, Vec3 const& d)
+{
+	Vec3 normal = CrossProduct3D(b - a, c - a);
+	float signOrigin = -DotProduct3D(a, normal);
+	float signD = DotProduct3D(d - a, normal);
+	if(signD * signD <= DEGENERATE_EPSILON * DotProduct3D(normal, normal))
+	{
+		return true;
+	}
+	return signOrigin * signD < 0.f;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Reduces the simplex to the smallest part holding its closest point to the origin and returns that point. A full
+// simplex (a triangle in 2D, a tetrahedron in 3D) is only kept when it holds the origin.
+//------------------------------------------------------------------------------------------------------------------
+static Vec2 ReduceSimplex(Simplex2D& simplex)
+{
+	int keptIndexes[3] = { 0, 0, 0 };
+	float keptWeights[3] = { 1.f, 0.f, 0.f };
+	int numKept = 1;
+	SimplexVertex<Vec2> const* vertices = simplex.m_vertices;
+
+	if(simplex.m_numVertices == 2)
+	{
+		numKept = SolveSegment(vertices[0].m_point, vertices[1].m_point, keptIndexes, keptWeights, 0, 1);
+	}
+	else if(simplex.m_numVertices == 3)
+	{
+		numKept = SolveTriangle(vertices[0].m_point, vertices[1].m_point, vertices[2].m_point, keptIndexes, keptWeights, 0, 1, 2);
+	}
+
+	KeepSimplexVertices(simplex, numKept, keptIndexes, keptWeights);
+	return simplex.GetPoint();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static Vec3 ReduceSimplex(Simplex3D& simplex)
+{
+	int keptIndexes[4] = { 0, 0, 0, 0 };
+	float keptWeights[4] = { 1.f, 0.f, 0.f, 0.f };
+	int numKept = 1;
+	SimplexVertex<Vec3> const* vertices = simplex.m_vertices;
+
+	if(simplex.m_numVertices == 2)
+	{
+		numKept = SolveSegment(vertices[0].m_point, vertices[1].m_point, keptIndexes, keptWeights, 0, 1);
+	}
+	else if(simplex.m_numVertices == 3)
+	{
+		numKept = SolveTriangle(vertices[0].m_point, vertices[1].m_point, vertices[2].m_point, keptIndexes, keptWeights, 0, 1, 2);
+	}
+	else if(simplex.m_numVertices == 4)
+	{
+		// the nearest of the faces the origin is outside of; inside all four means the origin is in the tetrahedron
+		static int const FACES[4][4] = { { 0, 1, 2, 3 }, { 0, 2, 3, 1 }, { 0, 3, 1, 2 }, { 1, 3, 2, 0 } };
+		float bestDistanceSquared = FLT_MAX;
+		bool isOutsideAnyFace = false;
+		for(int faceIndex = 0; faceIndex < 4; ++faceIndex)
+		{
+			int const* face = FACES[faceIndex];
+			Vec3 const& a = vertices[face[0]].m_point;
+			Vec3 const& b = vertices[face[1]].m_point;
+			Vec3 const& c = vertices[face[2]].m_point;
+			if(!IsOriginOutsideFace(a, b, c, vertices[face[3]].m_point))
+			{
+				continue;
+			}
+
+			isOutsideAnyFace = true;
+			int faceKeptIndexes[3];
+			float faceKeptWeights[3];
+			int faceNumKept = SolveTriangle(a, b, c, faceKeptIndexes, faceKeptWeights, face[0], face[1], face[2]);
+			Vec3 point;
+			for(int kept = 0; kept < faceNumKept; ++kept)
+			{
+				point += vertices[faceKeptIndexes[kept]].m_point * faceKeptWeights[kept];
+			}
+
+			float distanceSquared = point.GetLengthSquared();
+			if(distanceSquared < bestDistanceSquared)
+			{
+				bestDistanceSquared = distanceSquared;
+				numKept = faceNumKept;
+				for(int kept = 0; kept < faceNumKept; ++kept)
+				{
+					keptIndexes[kept] = faceKeptIndexes[kept];
+					keptWeights[kept] = faceKeptWeights[kept];
+				}
+			}
+		}
+
+		if(!isOutsideAnyFace)
+		{
+			simplex.m_weights[0] = simplex.m_weights[1] = simplex.m_weights[2] = simplex.m_weights[3] = 0.25f;
+			return Vec3();
+		}
+	}
+
+	KeepSimplexVertices(simplex, numKept, keptIndexes, keptWeights);
+	return simplex.GetPoint();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// The direction to search in next, as long as the closest point. Near the origin the closest point is mostly rounding
+// in its direction, so a 2D segment or 3D triangle uses its own normal instead, which does not depend on the origin.
+//------------------------------------------------------------------------------------------------------------------
+static Vec2 GetSearchDirection(Simplex2D const& simplex, Vec2 const& closestPoint)
+{
+	if(simplex.m_numVertices == 2)
+	{
+		Vec2 const& a = simplex.m_vertices[0].m_point;
+		Vec2 normal = (simplex.m_vertices[1].m_point - a).GetRotated90Degrees();
+		float normalLength = normal.GetLength();
+		if(normalLength > DEGENERATE_EPSILON)
+		{
+			float towardOrigin = DotProduct2D(normal, a) > 0.f ? -1.f : 1.f;
+			return normal * (towardOrigin * closestPoint.GetLength() / normalLength);
+		}
+	}
+	return -closestPoint;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static Vec3 GetSearchDirection(Simplex3D const& simplex, Vec3 const& closestPoint)
+{
+	if(simplex.m_numVertices == 3)
+	{
+		Vec3 const& a = simplex.m_vertices[0].m_point;
+		Vec3 normal = CrossProduct3D(simplex.m_vertices[1].m_point - a, simplex.m_vertices[2].m_point - a);
+		float normalLength = normal.GetLength();
+		if(normalLength > DEGENERATE_EPSILON)
+		{
+			float towardOrigin = DotProduct3D(normal, a) > 0.f ? -1.f : 1.f;
+			return normal * (towardOrigin * closestPoint.GetLength() / normalLength);
+		}
+	}
+	return -closestPoint;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// GJK
+//------------------------------------------------------------------------------------------------------------------
+enum class GJKOutcome
+{
+	SEPARATED,			// stopped at a separating direction before converging; only when asked to
+	CONVERGED,			// the simplex's closest point is the closest point of A - B to the origin
+	OVERLAPPING,
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Runs GJK from the cached directions if there are any, else from the direction between the shapes' centers. With
+// stopAtSeparation it returns as soon as some direction proves the shapes apart. Leaves the final simplex in
+// out_simplex and its closest point in out_closestPoint, and refills the cache from the final simplex.
+//------------------------------------------------------------------------------------------------------------------
+template<typename VecType, typename SupportType, typename SimplexType, typename CacheType>
+static GJKOutcome RunGJK(SupportType const& shapeA, SupportType const& shapeB, CacheType* inout_cache, bool stopAtSeparation, SimplexType& out_simplex, VecType& out_closestPoint, int& out_numIterations)
+{
+	constexpr int MAX_VERTICES = static_cast<int>(sizeof(out_simplex.m_weights) / sizeof(float));
+
+	out_simplex.m_numVertices = 0;
+	if(inout_cache != nullptr)
+	{
+		for(int directionIndex = 0; directionIndex < inout_cache->m_numDirections; ++directionIndex)
+		{
+			SimplexVertex<VecType> vertex = GetMinkowskiSupport(shapeA, shapeB, inout_cache->m_directions[directionIndex]);
+			if(!out_simplex.Contains(vertex.m_point))
+			{
+				out_simplex.m_vertices[out_simplex.m_numVertices++] = vertex;
+			}
+		}
+	}
+
+	if(out_simplex.m_numVertices == 0)
+	{
+		VecType direction = shapeB.GetCenter() - shapeA.GetCenter();
+		if(DotProduct(direction, direction) <= DEGENERATE_EPSILON)
+		{
+			direction = VecType();
+			direction.x = 1.f;
+		}
+		out_simplex.m_vertices[out_simplex.m_numVertices++] = GetMinkowskiSupport(shapeA, shapeB, direction);
+	}
+
+	VecType closestPoint = ReduceSimplex(out_simplex);
+	GJKOutcome outcome = GJKOutcome::CONVERGED;
+	bool isSeparationProven = false;
+	out_numIterations = 0;
+
+	while(true)
+	{
+		float distanceSquared = DotProduct(closestPoint, closestPoint);
+		float touchingDistanceSquared = GJK_TOUCHING_RELATIVE_DISTANCE_SQUARED * out_simplex.GetMaxVertexLengthSquared();
+		if(out_simplex.m_numVertices == MAX_VERTICES || distanceSquared <= touchingDistanceSquared)
+		{
+			outcome = GJKOutcome::OVERLAPPING;
+			break;
+		}
+
+		if(out_numIterations == GJK_MAX_ITERATIONS)
+		{
+			break;
+		}
+		++out_numIterations;
+
+		// every point of A - B is at least this far against the search direction, so a positive value proves a gap
+		VecType searchDirection = GetSearchDirection(out_simplex, closestPoint);
+		SimplexVertex<VecType> vertex = GetMinkowskiSupport(shapeA, shapeB, searchDirection);
+		float progress = -DotProduct(searchDirection, vertex.m_point);
+		if(progress > 0.f)
+		{
+			if(stopAtSeparation)
+			{
+				outcome = GJKOutcome::SEPARATED;
+				break;
+			}
+			isSeparationProven = true;
+		}
+
+		if(distanceSquared - progress <= GJK_RELATIVE_TOLERANCE * distanceSquared || out_simplex.Contains(vertex.m_point))
+		{
+			break;
+		}
+
+		SimplexType previousSimplex = out_simplex;
+		out_simplex.m_vertices[out_simplex.m_numVertices++] = vertex;
+		VecType nextClosestPoint = ReduceSimplex(out_simplex);
+		bool holdsOrigin = out_simplex.m_numVertices == MAX_VERTICES;
+		if(holdsOrigin ? isSeparationProven : DotProduct(nextClosestPoint, nextClosestPoint) >= distanceSquared)
+		{
+			// rounding: a nearly flat simplex taken to hold the origin after a gap was proven, or no longer getting closer
+			out_simplex = previousSimplex;
+			break;
+		}
+		closestPoint = nextClosestPoint;
+	}
+
+	if(inout_cache != nullptr)
+	{
+		inout_cache->m_numDirections = out_simplex.m_numVertices;
+		for(int vertIndex = 0; vertIndex < out_simplex.m_numVertices; ++vertIndex)
+		{
+			inout_cache->m_directions[vertIndex] = out_simplex.m_vertices[vertIndex].m_direction;
+		}
+	}
+
+	out_closestPoint = closestPoint;
+	return outcome;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// EPA, 3D. Grows the GJK simplex into a polytope inside A - B around the origin, always pushing out the face nearest
+// the origin, until that face is on the boundary; its distance is the penetration depth.
+//------------------------------------------------------------------------------------------------------------------
+struct PolytopeFace3D
+{
+	int		m_vertexIndexes[3];
+	Vec3	m_normal;
+	float	m_distance = 0.f;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+static bool AddPolytopeFace(std::vector<SimplexVertex<Vec3>> const& vertices, int indexA, int indexB, int indexC, Vec3 const& interiorPoint, std::vector<PolytopeFace3D>& inout_faces)
+{
+	Vec3 const& a = vertices[indexA].m_point;
+	Vec3 normal = CrossProduct3D(vertices[indexB].m_point - a, vertices[indexC].m_point - a);
+	float normalLength = normal.GetLength();
+	if(normalLength <= DEGENERATE_EPSILON)
+	{
+		return false;
+	}
+
+	normal /= normalLength;
+	PolytopeFace3D face;
+	face.m_vertexIndexes[0] = indexA;
+	face.m_vertexIndexes[1] = indexB;
+	face.m_vertexIndexes[2] = indexC;
+	if(DotProduct3D(normal, a - interiorPoint) < 0.f)
+	{
+		// wind every face outward, so neighbors list their shared edge in opposite orders
+		normal = -normal;
+		face.m_vertexIndexes[1] = indexC;
+		face.m_vertexIndexes[2] = indexB;
+	}
+
+	face.m_normal = normal;
+	face.m_distance = DotProduct3D(normal, a);
+	inout_faces.push_back(face);
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static int GetNearestPolytopeFaceIndex(std::vector<PolytopeFace3D> const& faces)
+{
+	int nearestFaceIndex = 0;
+	for(int faceIndex = 1; faceIndex < static_cast<int>(faces.size()); ++faceIndex)
+	{
+		if(faces[faceIndex].m_distance < faces[nearestFaceIndex].m_distance)
+		{
+			nearestFaceIndex = faceIndex;
+		}
+	}
+	return nearestFaceIndex;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// GJK can finish on fewer than four points when the shapes only just touch; add support points in new directions
+// until the simplex has volume. Fails only when A - B is flat.
+//------------------------------------------------------------------------------------------------------------------
+static bool MakeSimplexTetrahedron(ConvexSupport3D const& shapeA, ConvexSupport3D const& shapeB, std::vector<SimplexVertex<Vec3>>& inout_vertices)
+{
+	constexpr float SPREAD_EPSILON = 1e-6f;
+	static Vec3 const AXES[6] = { Vec3(1.f, 0.f, 0.f), Vec3(-1.f, 0.f, 0.f), Vec3(0.f, 1.f, 0.f), Vec3(0.f, -1.f, 0.f), Vec3(0.f, 0.f, 1.f), Vec3(0.f, 0.f, -1.f) };
+
+	if(inout_vertices.empty())
+	{
+		inout_vertices.push_back(GetMinkowskiSupport(shapeA, shapeB, AXES[0]));
+	}
+
+	if(inout_vertices.size() == 1)
+	{
+		for(int axisIndex = 0; axisIndex < 6 && inout_vertices.size() == 1; ++axisIndex)
+		{
+			SimplexVertex<Vec3> vertex = GetMinkowskiSupport(shapeA, shapeB, AXES[axisIndex]);
+			if(GetVectorDistanceSquared3D(vertex.m_point, inout_vertices[0].m_point) > SPREAD_EPSILON)
+			{
+				inout_vertices.push_back(vertex);
+			}
+		}
+	}
+
+	if(inout_vertices.size() == 2)
+	{
+		Vec3 lineDirection = (inout_vertices[1].m_point - inout_vertices[0].m_point).GetNormalized();
+		Vec3 leastAlignedAxis = fabsf(lineDirection.x) < fabsf(lineDirection.y) ? (fabsf(lineDirection.x) < fabsf(lineDirection.z) ? AXES[0] : AXES[4]) : (fabsf(lineDirection.y) < fabsf(lineDirection.z) ? AXES[2] : AXES[4]);
+		Vec3 sideA = CrossProduct3D(lineDirection, leastAlignedAxis).GetNormalized();
+		Vec3 sideB = CrossProduct3D(lineDirection, sideA);
+		Vec3 const sideDirections[4] = { sideA, sideB, -sideA, -sideB };
+		for(int sideIndex = 0; sideIndex < 4 && inout_vertices.size() == 2; ++sideIndex)
+		{
+			SimplexVertex<Vec3> vertex = GetMinkowskiSupport(shapeA, shapeB, sideDirections[sideIndex]);
+			Vec3 offCenter = CrossProduct3D(vertex.m_point - inout_vertices[0].m_point, lineDirection);
+			if(offCenter.GetLengthSquared() > SPREAD_EPSILON)
+			{
+				inout_vertices.push_back(vertex);
+			}
+		}
+	}
+
+	if(inout_vertices.size() == 3)
+	{
+		Vec3 normal = CrossProduct3D(inout_vertices[1].m_point - inout_vertices[0].m_point, inout_vertices[2].m_point - inout_vertices[0].m_point).GetNormalized();
+		for(int sideIndex = 0; sideIndex < 2 && inout_vertices.size() == 3; ++sideIndex)
+		{
+			Vec3 direction = sideIndex == 0 ? normal : -normal;
+			SimplexVertex<Vec3> vertex = GetMinkowskiSupport(shapeA, shapeB, direction);
+			float height = DotProduct3D(vertex.m_point - inout_vertices[0].m_point, normal);
+			if(height * height > SPREAD_EPSILON)
+			{
+				inout_vertices.push_back(vertex);
+			}
+		}
+	}
+
+	return inout_vertices.size() == 4;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static bool RunEPA3D(ConvexSupport3D const& shapeA, ConvexSupport3D const& shapeB, Simplex3D const& simplex, ConvexPenetration3D& out_penetration)
+{
+	std::vector<SimplexVertex<Vec3>> vertices(simplex.m_vertices, simplex.m_vertices + simplex.m_numVertices);
+	if(!MakeSimplexTetrahedron(shapeA, shapeB, vertices))
+	{
+		return false;
+	}
+
+	Vec3 interiorPoint = (vertices[0].m_point + vertices[1].m_point + vertices[2].m_point + vertices[3].m_point) * 0.25f;
+	std::vector<PolytopeFace3D> faces;
+	AddPolytopeFace(vertices, 0, 1, 2, interiorPoint, faces);
+	AddPolytopeFace(vertices, 0, 3, 1, interiorPoint, faces);
+	AddPolytopeFace(vertices, 0, 2, 3, interiorPoint, faces);
+	AddPolytopeFace(vertices, 1, 3, 2, interiorPoint, faces);
+
+	std::vector<int> horizonEdges;
+	for(int iteration = 0; iteration < EPA_MAX_ITERATIONS && !faces.empty(); ++iteration)
+	{
+		PolytopeFace3D const& nearestFace = faces[GetNearestPolytopeFaceIndex(faces)];
+		SimplexVertex<Vec3> vertex = GetMinkowskiSupport(shapeA, shapeB, nearestFace.m_normal);
+		float supportDistance = DotProduct3D(vertex.m_point, nearestFace.m_normal);
+		if(supportDistance - nearestFace.m_distance <= EPA_RELATIVE_TOLERANCE * GetMax(supportDistance, 1e-3f))
+		{
+			break;
+		}
+
+		// remove every face the new point can see; their edges that only one of them had are the horizon
+		horizonEdges.clear();
+		for(int faceIndex = static_cast<int>(faces.size()) - 1; faceIndex >= 0; --faceIndex)
+		{
+			PolytopeFace3D const& face = faces[faceIndex];
+			if(DotProduct3D(face.m_normal, vertex.m_point - vertices[face.m_vertexIndexes[0]].m_point) <= 0.f)
+			{
+				continue;
+			}
+
+			for(int edgeIndex = 0; edgeIndex < 3; ++edgeIndex)
+			{
+				int edgeStart = face.m_vertexIndexes[edgeIndex];
+				int edgeEnd = face.m_vertexIndexes[(edgeIndex + 1) % 3];
+				bool isShared = false;
+				for(int horizonIndex = 0; horizonIndex < static_cast<int>(horizonEdges.size()); horizonIndex += 2)
+				{
+					if(horizonEdges[horizonIndex] == edgeEnd && horizonEdges[horizonIndex + 1] == edgeStart)
+					{
+						horizonEdges.erase(horizonEdges.begin() + horizonIndex, horizonEdges.begin() + horizonIndex + 2);
+						isShared = true;
+						break;
+					}
+				}
+
+				if(!isShared)
+				{
+					horizonEdges.push_back(edgeStart);
+					horizonEdges.push_back(edgeEnd);
+				}
+			}
+
+			faces[faceIndex] = faces.back();
+			faces.pop_back();
+		}
+
+		int newVertexIndex = static_cast<int>(vertices.size());
+		vertices.push_back(vertex);
+		for(int horizonIndex = 0; horizonIndex < static_cast<int>(horizonEdges.size()); horizonIndex += 2)
+		{
+			AddPolytopeFace(vertices, horizonEdges[horizonIndex], horizonEdges[horizonIndex + 1], newVertexIndex, interiorPoint, faces);
+		}
+	}
+
+	if(faces.empty())
+	{
+		return false;
+	}
+
+	// where the origin projects onto the nearest face, mapped back onto each shape. The barycentric coordinates are
+	// left unclamped: on curved shapes rounding can leave the projection just outside the face, and the contact points
+	// should still differ by exactly normal * depth.
+	PolytopeFace3D const& face = faces[GetNearestPolytopeFaceIndex(faces)];
+	SimplexVertex<Vec3> const& a = vertices[face.m_vertexIndexes[0]];
+	SimplexVertex<Vec3> const& b = vertices[face.m_vertexIndexes[1]];
+	SimplexVertex<Vec3> const& c = vertices[face.m_vertexIndexes[2]];
+	Vec3 projectedOrigin = face.m_normal * face.m_distance;
+	Vec3 ab = b.m_point - a.m_point;
+	Vec3 ac = c.m_point - a.m_point;
+	Vec3 ap = projectedOrigin - a.m_point;
+	float abab = DotProduct3D(ab, ab);
+	float abac = DotProduct3D(ab, ac);
+	float acac = DotProduct3D(ac, ac);
+	float denominator = abab * acac - abac * abac;
+	float weightB = 0.f;
+	float weightC = 0.f;
+	if(denominator > DEGENERATE_EPSILON)
+	{
+		float abap = DotProduct3D(ab, ap);
+		float acap = DotProduct3D(ac, ap);
+		weightB = (acac * abap - abac * acap) / denominator;
+		weightC = (abab * acap - abac * abap) / denominator;
+	}
+	float weightA = 1.f - weightB - weightC;
+
+	out_penetration.m_areOverlapping = true;
+	out_penetration.m_depth = GetMax(face.m_distance, 0.f);
+	out_penetration.m_normal = face.m_normal;
+	out_penetration.m_contactPointOnA = (a.m_pointOnA * weightA) + (b.m_pointOnA * weightB) + (c.m_pointOnA * weightC);
+	out_penetration.m_contactPointOnB = (a.m_pointOnB * weightA) + (b.m_pointOnB * weightB) + (c.m_pointOnB * weightC);
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// EPA, 2D. The polytope is a counterclockwise polygon, and a new point always goes between the ends of the edge
+// that found it.
+//------------------------------------------------------------------------------------------------------------------
+static int GetNearestPolygonEdge(std::vector<SimplexVertex<Vec2>> const& polygon, Vec2& out_normal, float& out_distance)
+{
+	int nearestEdgeIndex = 0;
+	out_distance = FLT_MAX;
+	int numVertices = static_cast<int>(polygon.size());
+	for(int edgeIndex = 0; edgeIndex < numVertices; ++edgeIndex)
+	{
+		Vec2 const& start = polygon[edgeIndex].m_point;
+		Vec2 const& end = polygon[(edgeIndex + 1) % numVertices].m_point;
+		Vec2 edge = end - start;
+		float edgeLength = edge.GetLength();
+		if(edgeLength <= DEGENERATE_EPSILON)
+		{
+			continue;
+		}
+
+		Vec2 normal = edge.GetRotatedMinus90Degrees() / edgeLength;
+		float distance = DotProduct2D(normal, start);
+		if(distance < out_distance)
+		{
+			out_distance = distance;
+			out_normal = normal;
+			nearestEdgeIndex = edgeIndex;
+		}
+	}
+	return nearestEdgeIndex;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static bool RunEPA2D(ConvexSupport2D const& shapeA, ConvexSupport2D const& shapeB, Simplex2D const& simplex, ConvexPenetration2D& out_penetration)
+{
+	constexpr float SPREAD_EPSILON = 1e-6f;
+	std::vector<SimplexVertex<Vec2>> polygon(simplex.m_vertices, simplex.m_vertices + simplex.m_numVertices);
+
+	if(polygon.empty())
+	{
+		polygon.push_back(GetMinkowskiSupport(shapeA, shapeB, Vec2(1.f, 0.f)));
+	}
+
+	if(polygon.size() == 1)
+	{
+		Vec2 const directions[4] = { Vec2(1.f, 0.f), Vec2(-1.f, 0.f), Vec2(0.f, 1.f), Vec2(0.f, -1.f) };
+		for(int directionIndex = 0; directionIndex < 4 && polygon.size() == 1; ++directionIndex)
+		{
+			SimplexVertex<Vec2> vertex = GetMinkowskiSupport(shapeA, shapeB, directions[directionIndex]);
+			if(GetVectorDistanceSquared2D(vertex.m_point, polygon[0].m_point) > SPREAD_EPSILON)
+			{
+				polygon.push_back(vertex);
+			}
+		}
+	}
+
+	if(polygon.size() == 2)
+	{
+		Vec2 side = (polygon[1].m_point - polygon[0].m_point).GetNormalized().GetRotated90Degrees();
+		for(int sideIndex = 0; sideIndex < 2 && polygon.size() == 2; ++sideIndex)
+		{
+			SimplexVertex<Vec2> vertex = GetMinkowskiSupport(shapeA, shapeB, sideIndex == 0 ? side : -side);
+			float height = DotProduct2D(vertex.m_point - polygon[0].m_point, side);
+			if(height * height > SPREAD_EPSILON)
+			{
+				polygon.push_back(vertex);
+			}
+		}
+	}
+
+	if(polygon.size() != 3)
+	{
+		return false;
+	}
+
+	if(CrossProduct2D(polygon[1].m_point - polygon[0].m_point, polygon[2].m_point - polygon[0].m_point) < 0.f)
+	{
+		std::swap(polygon[1], polygon[2]);
+	}
+
+	Vec2 nearestNormal;
+	float nearestDistance = 0.f;
+	int nearestEdgeIndex = GetNearestPolygonEdge(polygon, nearestNormal, nearestDistance);
+	for(int iteration = 0; iteration < EPA_MAX_ITERATIONS; ++iteration)
+	{
+		SimplexVertex<Vec2> vertex = GetMinkowskiSupport(shapeA, shapeB, nearestNormal);
+		float supportDistance = DotProduct2D(vertex.m_point, nearestNormal);
+		if(supportDistance - nearestDistance <= EPA_RELATIVE_TOLERANCE * GetMax(supportDistance, 1e-3f))
+		{
+			break;
+		}
+
+		polygon.insert(polygon.begin() + nearestEdgeIndex + 1, vertex);
+		nearestEdgeIndex = GetNearestPolygonEdge(polygon, nearestNormal, nearestDistance);
+	}
+
+	SimplexVertex<Vec2> const& start = polygon[nearestEdgeIndex];
+	SimplexVertex<Vec2> const& end = polygon[(nearestEdgeIndex + 1) % static_cast<int>(polygon.size())];
+	int keptIndexes[2];
+	float keptWeights[2];
+	int numKept = SolveSegment(start.m_point, end.m_point, keptIndexes, keptWeights, 0, 1);
+	SimplexVertex<Vec2> const* ends[2] = { &start, &end };
+
+	out_penetration.m_areOverlapping = true;
+	out_penetration.m_depth = GetMax(nearestDistance, 0.f);
+	out_penetration.m_normal = nearestNormal;
+	out_penetration.m_contactPointOnA = Vec2();
+	out_penetration.m_contactPointOnB = Vec2();
+	for(int kept = 0; kept < numKept; ++kept)
+	{
+		out_penetration.m_contactPointOnA += ends[keptIndexes[kept]]->m_pointOnA * keptWeights[kept];
+		out_penetration.m_contactPointOnB += ends[keptIndexes[kept]]->m_pointOnB * keptWeights[kept];
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Queries
+//------------------------------------------------------------------------------------------------------------------
+bool DoConvexShapesOverlap3D(ConvexSupport3D const& shapeA, ConvexSupport3D const& shapeB, ConvexSimplexCache3D* inout_cache)
+{
+	Simplex3D simplex;
+	Vec3 closestPoint;
+	int numIterations = 0;
+	return RunGJK(shapeA, shapeB, inout_cache, true, simplex, closestPoint, numIterations) == GJKOutcome::OVERLAPPING;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+ConvexDistance3D GetConvexShapesDistance3D(ConvexSupport3D const& shapeA, ConvexSupport3D const& shapeB, ConvexSimplexCache3D* inout_cache)
+{
+	ConvexDistance3D result;
+	Simplex3D simplex;
+	Vec3 closestPoint;
+	GJKOutcome outcome = RunGJK(shapeA, shapeB, inout_cache, false, simplex, closestPoint, result.m_numIterations);
+	if(outcome == GJKOutcome::OVERLAPPING)
+	{
+		result.m_areOverlapping = true;
+		return result;
+	}
+
+	result.m_distance = closestPoint.GetLength();
+	simplex.GetWitnessPoints(result.m_nearestPointOnA, result.m_nearestPointOnB);
+	return result;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+ConvexPenetration3D GetConvexShapesPenetration3D(ConvexSupport3D const& shapeA, ConvexSupport3D const& shapeB, ConvexSimplexCache3D* inout_cache)
+{
+	ConvexPenetration3D result;
+	Simplex3D simplex;
+	Vec3 closestPoint;
+	int numIterations = 0;
+	if(RunGJK(shapeA, shapeB, inout_cache, true, simplex, closestPoint, numIterations) != GJKOutcome::OVERLAPPING)
+	{
+		return result;
+	}
+
+	if(!RunEPA3D(shapeA, shapeB, simplex, result))
+	{
+		// A - B has no volume, so the shapes only touch
+		result.m_areOverlapping = true;
+		result.m_normal = Vec3(0.f, 0.f, 1.f);
+		simplex.GetWitnessPoints(result.m_contactPointOnA, result.m_contactPointOnB);
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool DoConvexShapesOverlap2D(ConvexSupport2D const& shapeA, ConvexSupport2D const& shapeB, ConvexSimplexCache2D* inout_cache)
+{
+	Simplex2D simplex;
+	Vec2 closestPoint;
+	int numIterations = 0;
+	return RunGJK(shapeA, shapeB, inout_cache, true, simplex, closestPoint, numIterations) == GJKOutcome::OVERLAPPING;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+ConvexDistance2D GetConvexShapesDistance2D(ConvexSupport2D const& shapeA, ConvexSupport2D const& shapeB, ConvexSimplexCache2D* inout_cache)
+{
+	ConvexDistance2D result;
+	Simplex2D simplex;
+	Vec2 closestPoint;
+	GJKOutcome outcome = RunGJK(shapeA, shapeB, inout_cache, false, simplex, closestPoint, result.m_numIterations);
+	if(outcome == GJKOutcome::OVERLAPPING)
+	{
+		result.m_areOverlapping = true;
+		return result;
+	}
+
+	result.m_distance = closestPoint.GetLength();
+	simplex.GetWitnessPoints(result.m_nearestPointOnA, result.m_nearestPointOnB);
+	return result;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+ConvexPenetration2D GetConvexShapesPenetration2D(ConvexSupport2D const& shapeA, ConvexSupport2D const& shapeB, ConvexSimplexCache2D* inout_cache)
+{
+	ConvexPenetration2D result;
+	Simplex2D simplex;
+	Vec2 closestPoint;
+	int numIterations = 0;
+	if(RunGJK(shapeA, shapeB, inout_cache, true, simplex, closestPoint, numIterations) != GJKOutcome::OVERLAPPING)
+	{
+		return result;
+	}
+
+	if(!RunEPA2D(shapeA, shapeB, simplex, result))
+	{
+		result.m_areOverlapping = true;
+		result.m_normal = Vec2(0.f, 1.f);
+		simplex.GetWitnessPoints(result.m_contactPointOnA, result.m_contactPointOnB);
+	}
+	return result;
+}
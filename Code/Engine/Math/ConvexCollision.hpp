@@ -0,0 +1,197 @@
+#pragma once
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Cylinder3D.hpp"
+#include "Engine/Math/OBB3.hpp"
+#include "Engine/Math/Sphere.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------
+struct ConvexPoly2;
+struct ConvexHull2;
+
+//------------------------------------------------------------------------------------------------------------------
+// General convex narrowphase: GJK for overlap and distance, EPA on top of it for penetration depth. Both only ever ask
+// a shape for its support point, the point farthest along a direction, so any pair of shapes below can be tested
+// against each other, and new shapes only need an adapter.
+//
+// Adapters copy what they need from the shape, so build them once per shape per frame and reuse them for every pair
+// the shape is in. GetCenter can be any point inside the shape; it only picks the first search direction.
+//------------------------------------------------------------------------------------------------------------------
+class ConvexSupport3D
+{
+public:
+	virtual ~ConvexSupport3D() = default;
+
+	// direction need not be normalized and may be zero
+	virtual Vec3	GetSupportPoint(Vec3 const& direction) const = 0;
+	virtual Vec3	GetCenter() const = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+class SphereSupport : public ConvexSupport3D
+{
+public:
+	explicit SphereSupport(Sphere const& sphere)				: m_sphere(sphere) {}
+
+	virtual Vec3	GetSupportPoint(Vec3 const& direction) const override;
+	virtual Vec3	GetCenter() const override					{ return m_sphere.m_center; }
+
+public:
+	Sphere	m_sphere;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+class AABB3Support : public ConvexSupport3D
+{
+public:
+	explicit AABB3Support(AABB3 const& box)						: m_box(box) {}
+
+	virtual Vec3	GetSupportPoint(Vec3 const& direction) const override;
+	virtual Vec3	GetCenter() const override;
+
+public:
+	AABB3	m_box;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+class OBB3Support : public ConvexSupport3D
+{
+public:
+	explicit OBB3Support(OBB3 const& box)						: m_box(box) {}
+
+	virtual Vec3	GetSupportPoint(Vec3 const& direction) const override;
+	virtual Vec3	GetCenter() const override					{ return m_box.m_center; }
+
+public:
+	OBB3	m_box;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Cylinder3D stands upright along z from m_startPosition
+class Cylinder3DSupport : public ConvexSupport3D
+{
+public:
+	explicit Cylinder3DSupport(Cylinder3D const& cylinder)		: m_cylinder(cylinder) {}
+
+	virtual Vec3	GetSupportPoint(Vec3 const& direction) const override;
+	virtual Vec3	GetCenter() const override;
+
+public:
+	Cylinder3D	m_cylinder;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+class ConvexSupport2D
+{
+public:
+	virtual ~ConvexSupport2D() = default;
+
+	virtual Vec2	GetSupportPoint(Vec2 const& direction) const = 0;
+	virtual Vec2	GetCenter() const = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Any set of points works; the support mapping is of their convex hull. A single point makes a point query.
+class ConvexPoly2Support : public ConvexSupport2D
+{
+public:
+	explicit ConvexPoly2Support(ConvexPoly2 const& poly);
+	explicit ConvexPoly2Support(std::vector<Vec2> const& vertexPositions);
+
+	virtual Vec2	GetSupportPoint(Vec2 const& direction) const override;
+	virtual Vec2	GetCenter() const override					{ return m_center; }
+
+protected:
+	ConvexPoly2Support() = default;
+	void			ComputeCenter();
+
+public:
+	std::vector<Vec2>	m_vertexPositions;
+	Vec2				m_center;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Finds the hull's corners once, from where its planes meet; the hull must be bounded.
+class ConvexHull2Support : public ConvexPoly2Support
+{
+public:
+	explicit ConvexHull2Support(ConvexHull2 const& hull);
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Warm start for a pair queried again and again, such as a contact pair from frame to frame: the search directions
+// that found the last simplex. Queries rebuild the simplex from them at the shapes' current poses, so while the pair
+// moves a little they usually finish in an iteration or two. Keep one per pair; a default-constructed cache is empty.
+//------------------------------------------------------------------------------------------------------------------
+struct ConvexSimplexCache3D
+{
+	Vec3	m_directions[4];
+	int		m_numDirections = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct ConvexSimplexCache2D
+{
+	Vec2	m_directions[3];
+	int		m_numDirections = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct ConvexDistance3D
+{
+	bool	m_areOverlapping = false;
+	float	m_distance = 0.f;				// 0 when overlapping
+	Vec3	m_nearestPointOnA;				// the nearest points are only set when the shapes are apart
+	Vec3	m_nearestPointOnB;
+	int		m_numIterations = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct ConvexDistance2D
+{
+	bool	m_areOverlapping = false;
+	float	m_distance = 0.f;
+	Vec2	m_nearestPointOnA;
+	Vec2	m_nearestPointOnB;
+	int		m_numIterations = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Moving B by m_normal * m_depth (or A by the opposite) leaves the shapes just touching. The contact points are the
+// deepest points of each shape inside the other; m_contactPointOnA - m_contactPointOnB = m_normal * m_depth.
+//------------------------------------------------------------------------------------------------------------------
+struct ConvexPenetration3D
+{
+	bool	m_areOverlapping = false;
+	float	m_depth = 0.f;
+	Vec3	m_normal;						// unit length, from A toward B
+	Vec3	m_contactPointOnA;
+	Vec3	m_contactPointOnB;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct ConvexPenetration2D
+{
+	bool	m_areOverlapping = false;
+	float	m_depth = 0.f;
+	Vec2	m_normal;
+	Vec2	m_contactPointOnA;
+	Vec2	m_contactPointOnB;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// The overlap tests stop at the first separating direction they find, so they are much cheaper than asking for the
+// distance. Touching counts as overlapping. Distances and depths come out to about 1e-4 of the shapes' size; curved
+// shapes are approached one support point at a time, and deep overlaps of them, such as two spheres on nearly the same
+// center, can stop short of that.
+//------------------------------------------------------------------------------------------------------------------
+bool				DoConvexShapesOverlap3D(ConvexSupport3D const& shapeA, ConvexSupport3D const& shapeB, ConvexSimplexCache3D* inout_cache = nullptr);
+ConvexDistance3D	GetConvexShapesDistance3D(ConvexSupport3D const& shapeA, ConvexSupport3D const& shapeB, ConvexSimplexCache3D* inout_cache = nullptr);
+ConvexPenetration3D	GetConvexShapesPenetration3D(ConvexSupport3D const& shapeA, ConvexSupport3D const& shapeB, ConvexSimplexCache3D* inout_cache = nullptr);
+
+bool				DoConvexShapesOverlap2D(ConvexSupport2D const& shapeA, ConvexSupport2D const& shapeB, ConvexSimplexCache2D* inout_cache = nullptr);
+ConvexDistance2D	GetConvexShapesDistance2D(ConvexSupport2D const& shapeA, ConvexSupport2D const& shapeB, ConvexSimplexCache2D* inout_cache = nullptr);
+ConvexPenetration2D	GetConvexShapesPenetration2D(ConvexSupport2D const& shapeA, ConvexSupport2D const& shapeB, ConvexSimplexCache2D* inout_cache = nullptr);
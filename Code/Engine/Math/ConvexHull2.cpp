@@ -29,6 +29,21 @@ ConvexHull2::ConvexHull2(ConvexPoly2 const& convexPoly)
 	}
 }
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ConvexHull2 ConvexHull2::MakeFromPointCloud(std::vector<Vec2> const& points)
+{
+	ConvexPoly2 poly = ConvexPoly2::MakeFromPointCloud(points);
+
+	std::vector<Vec2> positions;
+	poly.GetVertexPositions(positions);
+	if(positions.size() < 3)
+	{
+		return ConvexHull2();
+	}
+
+	return ConvexHull2(poly);
+}
+
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void ConvexHull2::OffsetPlanes(float distanceOffset)
 {
@@ -18,6 +18,9 @@ public:
 	
 	~ConvexHull2() = default;
 
+	// Needs at least three points not all on one line; returns an empty hull otherwise.
+	static ConvexHull2 MakeFromPointCloud(std::vector<Vec2> const& points);
+
 	void OffsetPlanes(float distanceOffset);
 
 };
\ No newline at end of file
@@ -0,0 +1,614 @@
+#include "Engine/Math/ConvexHull3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include <float.h>
+#include <math.h>
+#include <queue>
+
+//------------------------------------------------------------------------------------------------------------------
+// Triangle of the hull under construction, wound counter-clockwise seen from outside. Edge k runs from vertex k to
+// vertex k + 1, and m_neighbors[k] is the face on the other side of it.
+struct QuickhullFace3
+{
+	int					m_vertexes[3] = { -1, -1, -1 };
+	int					m_neighbors[3] = { -1, -1, -1 };
+	Vec3				m_normal;
+	float				m_offset = 0.f;
+	std::vector<int>	m_outsidePoints;
+	int					m_farthestPoint = -1;
+	float				m_farthestDistance = 0.f;
+	int					m_visitStamp = 0;
+	bool				m_isDeleted = false;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct QuickhullHorizonEdge3
+{
+	int m_start = -1;
+	int m_end = -1;
+	int m_outerFace = -1;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// A face's farthest outside point as it was when queued; stale once the face is deleted or has a new farthest point.
+struct QuickhullEyeCandidate3
+{
+	float	m_distance = 0.f;
+	int		m_face = -1;
+	int		m_point = -1;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct QuickhullEyeCandidateLess
+{
+	bool operator()(QuickhullEyeCandidate3 const& candidateA, QuickhullEyeCandidate3 const& candidateB) const
+	{
+		return candidateA.m_distance < candidateB.m_distance;
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------
+class QuickhullBuilder3
+{
+public:
+	QuickhullBuilder3(std::vector<Vec3> const& points);
+
+	bool	Build(int maxVertexes);
+	void	GetPlanes(float faceMergeDegrees, std::vector<Plane3>& out_planes);
+	void	GetHullVertexes(std::vector<Vec3>& out_vertexes);
+
+private:
+	bool	BuildInitialTetrahedron();
+	int		AddFace(int vertexA, int vertexB, int vertexC);
+	void	AssignOutsidePoint(int pointIndex, int const* candidateFaces, int numCandidateFaces);
+	void	QueueEyeCandidate(int faceIndex);
+	int		PopFaceWithFarthestPoint();
+	bool	AddPoint(int eyeFaceIndex);
+	void	LinkFaces(int faceIndex, int edgeIndex, int otherFaceIndex);
+	float	GetDistance(QuickhullFace3 const& face, int pointIndex) const;
+
+private:
+	std::vector<Vec3> const&			m_points;
+	float								m_tolerance = 0.f;
+	std::vector<QuickhullFace3>			m_faces;
+	int									m_numLiveFaces = 0;
+	std::priority_queue<QuickhullEyeCandidate3, std::vector<QuickhullEyeCandidate3>, QuickhullEyeCandidateLess> m_eyeCandidates;
+	std::vector<int>					m_newFaces;
+	std::vector<int>					m_visibleFaces;
+	std::vector<int>					m_faceStack;
+	std::vector<QuickhullHorizonEdge3>	m_horizon;
+	std::vector<int>					m_orphanedPoints;
+	std::vector<int>					m_newFaceByStart;		// point index -> new face whose horizon edge starts there
+	std::vector<int>					m_pointStamps;
+	int									m_currentStamp = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+ConvexHull3::ConvexHull3(std::vector<Plane3> const& planes)
+	: m_planes(planes)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void ConvexHull3::OffsetPlanes(float distanceOffset)
+{
+	for(Plane3& plane : m_planes)
+	{
+		plane.m_distanceFromOrigin += distanceOffset;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool BuildConvexHull3FromPoints(std::vector<Vec3> const& points, ConvexHull3& out_hull, int maxVertexes, float faceMergeDegrees, std::vector<Vec3>* out_hullVertexes)
+{
+	out_hull.m_planes.clear();
+	if(out_hullVertexes != nullptr)
+	{
+		out_hullVertexes->clear();
+	}
+
+	QuickhullBuilder3 builder(points);
+	if(!builder.Build(GetMax(maxVertexes, 4)))
+	{
+		return false;
+	}
+
+	builder.GetPlanes(faceMergeDegrees, out_hull.m_planes);
+	if(out_hullVertexes != nullptr)
+	{
+		builder.GetHullVertexes(*out_hullVertexes);
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Points closer to a face than the tolerance count as on it. Scaling it by the size of the coordinates keeps round-off
+// in the plane tests from making a face see a point that is really on it, which would fold the hull over itself.
+QuickhullBuilder3::QuickhullBuilder3(std::vector<Vec3> const& points)
+	: m_points(points)
+{
+	Vec3 maxAbs;
+	for(Vec3 const& point : m_points)
+	{
+		maxAbs = Vec3(GetMax(maxAbs.x, fabsf(point.x)), GetMax(maxAbs.y, fabsf(point.y)), GetMax(maxAbs.z, fabsf(point.z)));
+	}
+	m_tolerance = 3.f * FLT_EPSILON * (maxAbs.x + maxAbs.y + maxAbs.z);
+
+	m_newFaceByStart.assign(m_points.size(), -1);
+	m_pointStamps.assign(m_points.size(), 0);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool QuickhullBuilder3::Build(int maxVertexes)
+{
+	if(m_points.size() < 4 || !BuildInitialTetrahedron())
+	{
+		return false;
+	}
+
+	// a closed hull of triangles has two faces for every vertex beyond the first two (Euler's formula)
+	while((m_numLiveFaces / 2) + 2 < maxVertexes)
+	{
+		int eyeFaceIndex = PopFaceWithFarthestPoint();
+		if(eyeFaceIndex < 0)
+		{
+			break;
+		}
+
+		AddPoint(eyeFaceIndex);
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Starts from the two extreme points farthest apart, the point farthest from the line through them, and the point
+// farthest from the plane through all three, so the first hull already covers most of the cloud.
+bool QuickhullBuilder3::BuildInitialTetrahedron()
+{
+	int numPoints = static_cast<int>(m_points.size());
+
+	int extremes[6] = { 0, 0, 0, 0, 0, 0 };
+	for(int pointIndex = 1; pointIndex < numPoints; ++pointIndex)
+	{
+		Vec3 const& point = m_points[pointIndex];
+		if(point.x < m_points[extremes[0]].x) { extremes[0] = pointIndex; }
+		if(point.x > m_points[extremes[1]].x) { extremes[1] = pointIndex; }
+		if(point.y < m_points[extremes[2]].y) { extremes[2] = pointIndex; }
+		if(point.y > m_points[extremes[3]].y) { extremes[3] = pointIndex; }
+		if(point.z < m_points[extremes[4]].z) { extremes[4] = pointIndex; }
+		if(point.z > m_points[extremes[5]].z) { extremes[5] = pointIndex; }
+	}
+
+	int vertex0 = extremes[0];
+	int vertex1 = extremes[1];
+	float maxDistanceSquared = -1.f;
+	for(int axis = 0; axis < 3; ++axis)
+	{
+		float distanceSquared = GetVectorDistanceSquared3D(m_points[extremes[2 * axis]], m_points[extremes[2 * axis + 1]]);
+		if(distanceSquared > maxDistanceSquared)
+		{
+			maxDistanceSquared = distanceSquared;
+			vertex0 = extremes[2 * axis];
+			vertex1 = extremes[2 * axis + 1];
+		}
+	}
+	if(maxDistanceSquared <= m_tolerance * m_tolerance)
+	{
+		return false;
+	}
+
+	Vec3 lineDirection = (m_points[vertex1] - m_points[vertex0]).GetNormalized();
+	int vertex2 = -1;
+	float maxLineDistance = m_tolerance;
+	for(int pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+	{
+		float lineDistance = CrossProduct3D(m_points[pointIndex] - m_points[vertex0], lineDirection).GetLength();
+		if(lineDistance > maxLineDistance)
+		{
+			maxLineDistance = lineDistance;
+			vertex2 = pointIndex;
+		}
+	}
+	if(vertex2 < 0)
+	{
+		return false;
+	}
+
+	Vec3 baseNormal = CrossProduct3D(m_points[vertex1] - m_points[vertex0], m_points[vertex2] - m_points[vertex0]).GetNormalized();
+	int vertex3 = -1;
+	float maxPlaneDistance = m_tolerance;
+	for(int pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+	{
+		float planeDistance = fabsf(DotProduct3D(m_points[pointIndex] - m_points[vertex0], baseNormal));
+		if(planeDistance > maxPlaneDistance)
+		{
+			maxPlaneDistance = planeDistance;
+			vertex3 = pointIndex;
+		}
+	}
+	if(vertex3 < 0)
+	{
+		return false;
+	}
+
+	// wind the base away from the apex, then the three sides follow from it
+	if(DotProduct3D(m_points[vertex3] - m_points[vertex0], baseNormal) > 0.f)
+	{
+		int swapVertex = vertex1;
+		vertex1 = vertex2;
+		vertex2 = swapVertex;
+	}
+
+	int faces[4];
+	faces[0] = AddFace(vertex0, vertex1, vertex2);
+	faces[1] = AddFace(vertex1, vertex0, vertex3);
+	faces[2] = AddFace(vertex2, vertex1, vertex3);
+	faces[3] = AddFace(vertex0, vertex2, vertex3);
+
+	LinkFaces(faces[0], 0, faces[1]);
+	LinkFaces(faces[0], 1, faces[2]);
+	LinkFaces(faces[0], 2, faces[3]);
+	LinkFaces(faces[1], 1, faces[3]);
+	LinkFaces(faces[2], 1, faces[1]);
+	LinkFaces(faces[3], 1, faces[2]);
+
+	for(int pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+	{
+		if(pointIndex != vertex0 && pointIndex != vertex1 && pointIndex != vertex2 && pointIndex != vertex3)
+		{
+			AssignOutsidePoint(pointIndex, faces, 4);
+		}
+	}
+
+	for(int faceIndex : faces)
+	{
+		QueueEyeCandidate(faceIndex);
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int QuickhullBuilder3::AddFace(int vertexA, int vertexB, int vertexC)
+{
+	QuickhullFace3 face;
+	face.m_vertexes[0] = vertexA;
+	face.m_vertexes[1] = vertexB;
+	face.m_vertexes[2] = vertexC;
+
+	Vec3 const& pointA = m_points[vertexA];
+	face.m_normal = CrossProduct3D(m_points[vertexB] - pointA, m_points[vertexC] - pointA).GetNormalized();
+	face.m_offset = DotProduct3D(face.m_normal, pointA);
+
+	m_faces.push_back(face);
+	++m_numLiveFaces;
+	return static_cast<int>(m_faces.size()) - 1;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Sets both sides of an edge; edgeIndex is the edge of faceIndex, and the other face has the same edge reversed.
+void QuickhullBuilder3::LinkFaces(int faceIndex, int edgeIndex, int otherFaceIndex)
+{
+	QuickhullFace3& face = m_faces[faceIndex];
+	QuickhullFace3& otherFace = m_faces[otherFaceIndex];
+	int edgeStart = face.m_vertexes[edgeIndex];
+
+	face.m_neighbors[edgeIndex] = otherFaceIndex;
+	for(int otherEdgeIndex = 0; otherEdgeIndex < 3; ++otherEdgeIndex)
+	{
+		if(otherFace.m_vertexes[(otherEdgeIndex + 1) % 3] == edgeStart)
+		{
+			otherFace.m_neighbors[otherEdgeIndex] = faceIndex;
+			return;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+float QuickhullBuilder3::GetDistance(QuickhullFace3 const& face, int pointIndex) const
+{
+	return DotProduct3D(face.m_normal, m_points[pointIndex]) - face.m_offset;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// A point only needs to be outside one face to keep the hull growing toward it; points outside none of the candidates
+// are inside the hull and are dropped for good.
+void QuickhullBuilder3::AssignOutsidePoint(int pointIndex, int const* candidateFaces, int numCandidateFaces)
+{
+	for(int candidateIndex = 0; candidateIndex < numCandidateFaces; ++candidateIndex)
+	{
+		QuickhullFace3& face = m_faces[candidateFaces[candidateIndex]];
+		float distance = GetDistance(face, pointIndex);
+		if(distance > m_tolerance)
+		{
+			face.m_outsidePoints.push_back(pointIndex);
+			if(distance > face.m_farthestDistance)
+			{
+				face.m_farthestDistance = distance;
+				face.m_farthestPoint = pointIndex;
+			}
+			return;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void QuickhullBuilder3::QueueEyeCandidate(int faceIndex)
+{
+	QuickhullFace3 const& face = m_faces[faceIndex];
+	if(face.m_farthestPoint >= 0)
+	{
+		QuickhullEyeCandidate3 candidate;
+		candidate.m_distance = face.m_farthestDistance;
+		candidate.m_face = faceIndex;
+		candidate.m_point = face.m_farthestPoint;
+		m_eyeCandidates.push(candidate);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Always the farthest point of all, not just of the next face, so a vertex limit keeps the corners that matter most.
+int QuickhullBuilder3::PopFaceWithFarthestPoint()
+{
+	while(!m_eyeCandidates.empty())
+	{
+		QuickhullEyeCandidate3 candidate = m_eyeCandidates.top();
+		m_eyeCandidates.pop();
+
+		QuickhullFace3 const& face = m_faces[candidate.m_face];
+		if(!face.m_isDeleted && face.m_farthestPoint == candidate.m_point)
+		{
+			return candidate.m_face;
+		}
+	}
+	return -1;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Removes every face the eye point can see and fans new faces from the eye to the horizon, the loop of edges between
+// seen and unseen faces. Returns false if round-off left the horizon not a simple loop; the eye point is then dropped
+// and the hull is left as it was.
+bool QuickhullBuilder3::AddPoint(int eyeFaceIndex)
+{
+	int eyePoint = m_faces[eyeFaceIndex].m_farthestPoint;
+	++m_currentStamp;
+
+	m_visibleFaces.clear();
+	m_horizon.clear();
+	m_faceStack.clear();
+	m_faceStack.push_back(eyeFaceIndex);
+	m_faces[eyeFaceIndex].m_visitStamp = m_currentStamp;
+
+	while(!m_faceStack.empty())
+	{
+		int faceIndex = m_faceStack.back();
+		m_faceStack.pop_back();
+		m_visibleFaces.push_back(faceIndex);
+
+		for(int edgeIndex = 0; edgeIndex < 3; ++edgeIndex)
+		{
+			int neighborIndex = m_faces[faceIndex].m_neighbors[edgeIndex];
+			QuickhullFace3& neighbor = m_faces[neighborIndex];
+			if(neighbor.m_visitStamp == m_currentStamp)
+			{
+				continue;
+			}
+
+			if(GetDistance(neighbor, eyePoint) > m_tolerance)
+			{
+				neighbor.m_visitStamp = m_currentStamp;
+				m_faceStack.push_back(neighborIndex);
+			}
+			else
+			{
+				QuickhullHorizonEdge3 edge;
+				edge.m_start = m_faces[faceIndex].m_vertexes[edgeIndex];
+				edge.m_end = m_faces[faceIndex].m_vertexes[(edgeIndex + 1) % 3];
+				edge.m_outerFace = neighborIndex;
+				m_horizon.push_back(edge);
+			}
+		}
+	}
+
+	// each horizon vertex must start exactly one edge and end exactly one
+	bool isHorizonLoop = true;
+	int startStamp = ++m_currentStamp;
+	for(QuickhullHorizonEdge3 const& edge : m_horizon)
+	{
+		isHorizonLoop = isHorizonLoop && m_pointStamps[edge.m_start] != startStamp;
+		m_pointStamps[edge.m_start] = startStamp;
+	}
+	int endStamp = ++m_currentStamp;
+	for(QuickhullHorizonEdge3 const& edge : m_horizon)
+	{
+		isHorizonLoop = isHorizonLoop && m_pointStamps[edge.m_end] == startStamp;
+		m_pointStamps[edge.m_end] = endStamp;
+	}
+
+	if(!isHorizonLoop)
+	{
+		QuickhullFace3& eyeFace = m_faces[eyeFaceIndex];
+		for(int& pointIndex : eyeFace.m_outsidePoints)
+		{
+			if(pointIndex == eyePoint)
+			{
+				pointIndex = eyeFace.m_outsidePoints.back();
+				eyeFace.m_outsidePoints.pop_back();
+				break;
+			}
+		}
+		eyeFace.m_farthestPoint = -1;
+		eyeFace.m_farthestDistance = 0.f;
+		for(int pointIndex : eyeFace.m_outsidePoints)
+		{
+			float distance = GetDistance(eyeFace, pointIndex);
+			if(distance > eyeFace.m_farthestDistance)
+			{
+				eyeFace.m_farthestDistance = distance;
+				eyeFace.m_farthestPoint = pointIndex;
+			}
+		}
+		QueueEyeCandidate(eyeFaceIndex);
+		return false;
+	}
+
+	m_orphanedPoints.clear();
+	for(int faceIndex : m_visibleFaces)
+	{
+		QuickhullFace3& face = m_faces[faceIndex];
+		face.m_isDeleted = true;
+		--m_numLiveFaces;
+		for(int pointIndex : face.m_outsidePoints)
+		{
+			if(pointIndex != eyePoint)
+			{
+				m_orphanedPoints.push_back(pointIndex);
+			}
+		}
+		face.m_outsidePoints.clear();
+		face.m_outsidePoints.shrink_to_fit();
+	}
+
+	m_newFaces.clear();
+	for(QuickhullHorizonEdge3 const& edge : m_horizon)
+	{
+		int newFaceIndex = AddFace(edge.m_start, edge.m_end, eyePoint);
+		LinkFaces(newFaceIndex, 0, edge.m_outerFace);
+		m_newFaceByStart[edge.m_start] = newFaceIndex;
+		m_newFaces.push_back(newFaceIndex);
+	}
+
+	// edge 1 of each new face (end -> eye) backs onto edge 2 of the new face that starts where this one ends
+	for(int newFaceIndex : m_newFaces)
+	{
+		LinkFaces(newFaceIndex, 1, m_newFaceByStart[m_faces[newFaceIndex].m_vertexes[1]]);
+	}
+	for(QuickhullHorizonEdge3 const& edge : m_horizon)
+	{
+		m_newFaceByStart[edge.m_start] = -1;
+	}
+
+	for(int pointIndex : m_orphanedPoints)
+	{
+		AssignOutsidePoint(pointIndex, m_newFaces.data(), static_cast<int>(m_newFaces.size()));
+	}
+	for(int newFaceIndex : m_newFaces)
+	{
+		QueueEyeCandidate(newFaceIndex);
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void QuickhullBuilder3::GetHullVertexes(std::vector<Vec3>& out_vertexes)
+{
+	++m_currentStamp;
+	for(QuickhullFace3 const& face : m_faces)
+	{
+		if(face.m_isDeleted)
+		{
+			continue;
+		}
+
+		for(int vertexIndex : face.m_vertexes)
+		{
+			if(m_pointStamps[vertexIndex] != m_currentStamp)
+			{
+				m_pointStamps[vertexIndex] = m_currentStamp;
+				out_vertexes.push_back(m_points[vertexIndex]);
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Grows each group of faces out from a seed face across edges while the normals stay within the merge angle of the
+// seed's, so a gently curved surface cannot drift into one plane. A group's plane takes the area-weighted normal of its
+// triangles and is then pushed out to the farthest hull vertex or leftover outside point along it. The triangle hull
+// is convex and holds every point that was dropped, so that is enough to enclose the whole cloud.
+void QuickhullBuilder3::GetPlanes(float faceMergeDegrees, std::vector<Plane3>& out_planes)
+{
+	float minMergeDot = CosDegrees(GetClamped(faceMergeDegrees, 0.f, 90.f));
+
+	// vertex graph of the triangle hull, for walking to the farthest vertex along each plane normal
+	std::vector<int> leftoverPoints;
+	std::vector<std::vector<int>> vertexNeighbors(m_points.size());
+	for(QuickhullFace3 const& face : m_faces)
+	{
+		if(face.m_isDeleted)
+		{
+			continue;
+		}
+
+		for(int edgeIndex = 0; edgeIndex < 3; ++edgeIndex)
+		{
+			vertexNeighbors[face.m_vertexes[edgeIndex]].push_back(face.m_vertexes[(edgeIndex + 1) % 3]);
+		}
+		leftoverPoints.insert(leftoverPoints.end(), face.m_outsidePoints.begin(), face.m_outsidePoints.end());
+	}
+
+	++m_currentStamp;
+	int groupedStamp = m_currentStamp;
+	for(int seedIndex = 0; seedIndex < static_cast<int>(m_faces.size()); ++seedIndex)
+	{
+		QuickhullFace3& seed = m_faces[seedIndex];
+		if(seed.m_isDeleted || seed.m_visitStamp == groupedStamp)
+		{
+			continue;
+		}
+
+		Vec3 weightedNormal;
+		seed.m_visitStamp = groupedStamp;
+		m_faceStack.clear();
+		m_faceStack.push_back(seedIndex);
+		while(!m_faceStack.empty())
+		{
+			QuickhullFace3 const& face = m_faces[m_faceStack.back()];
+			m_faceStack.pop_back();
+
+			Vec3 const& pointA = m_points[face.m_vertexes[0]];
+			weightedNormal += CrossProduct3D(m_points[face.m_vertexes[1]] - pointA, m_points[face.m_vertexes[2]] - pointA);
+
+			for(int neighborIndex : face.m_neighbors)
+			{
+				QuickhullFace3& neighbor = m_faces[neighborIndex];
+				if(neighbor.m_visitStamp != groupedStamp && DotProduct3D(neighbor.m_normal, seed.m_normal) >= minMergeDot)
+				{
+					neighbor.m_visitStamp = groupedStamp;
+					m_faceStack.push_back(neighborIndex);
+				}
+			}
+		}
+
+		Plane3 plane;
+		plane.m_normal = weightedNormal.GetNormalized();
+
+		// on a convex hull the first vertex with no farther neighbour is the farthest of all; the tolerance covers
+		// the slight dents round-off can leave
+		int farthestVertex = seed.m_vertexes[0];
+		float farthestDistance = DotProduct3D(plane.m_normal, m_points[farthestVertex]);
+		bool isClimbing = true;
+		while(isClimbing)
+		{
+			isClimbing = false;
+			for(int neighborVertex : vertexNeighbors[farthestVertex])
+			{
+				float distance = DotProduct3D(plane.m_normal, m_points[neighborVertex]);
+				if(distance > farthestDistance)
+				{
+					farthestDistance = distance;
+					farthestVertex = neighborVertex;
+					isClimbing = true;
+				}
+			}
+		}
+
+		plane.m_distanceFromOrigin = farthestDistance + m_tolerance;
+		for(int pointIndex : leftoverPoints)
+		{
+			plane.m_distanceFromOrigin = GetMax(plane.m_distanceFromOrigin, DotProduct3D(plane.m_normal, m_points[pointIndex]));
+		}
+		out_planes.push_back(plane);
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "Engine/Math/Plane3.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------
+// Convex volume bounded by outward-facing planes; a point is inside when it is behind all of them.
+//------------------------------------------------------------------------------------------------------------------
+struct ConvexHull3
+{
+public:
+	std::vector<Plane3> m_planes;
+
+public:
+	ConvexHull3() = default;
+	explicit ConvexHull3(std::vector<Plane3> const& planes);
+	~ConvexHull3() = default;
+
+	void OffsetPlanes(float distanceOffset);
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Builds the convex hull of a point cloud with quickhull, for generating collision proxies from mesh data.
+//
+// Quickhull starts from a tetrahedron of extreme points and repeatedly adds the point farthest outside the current
+// hull, so the most significant corners come first. It stops after maxVertexes corners, then merges neighbouring
+// triangles whose normals are within faceMergeDegrees of each other into one plane. Finally every plane is pushed out
+// to the farthest input point along its normal, so the hull always encloses all the points even when the vertex limit
+// or merging cut corners off; it is only ever slightly larger than the exact hull, never smaller. out_hullVertexes, if
+// given, receives the corners quickhull kept, for drawing the hull or feeding a support-point adapter.
+//
+// Returns false, leaving out_hull empty, when the points do not span a volume (fewer than four, or all on one plane).
+// Expected O(n log n) for n points.
+//------------------------------------------------------------------------------------------------------------------
+bool BuildConvexHull3FromPoints(std::vector<Vec3> const& points, ConvexHull3& out_hull, int maxVertexes = 64, float faceMergeDegrees = 3.f, std::vector<Vec3>* out_hullVertexes = nullptr);
@@ -1,4 +1,7 @@
 #include "Engine/Math/ConvexPoly2.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include <algorithm>
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
 ConvexPoly2::ConvexPoly2(std::vector<Vec2> const& vertexPositions)
@@ -22,3 +25,53 @@ void ConvexPoly2::OffsetVertexPositions(Vec2 const& offset)
 		pos += offset;
 	}
 }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+struct PointLexicographicLess
+{
+	bool operator()(Vec2 const& pointA, Vec2 const& pointB) const
+	{
+		return (pointA.x < pointB.x) || (pointA.x == pointB.x && pointA.y < pointB.y);
+	}
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Andrew's monotone chain: sort the points by x, then sweep once left to right for the lower chain and once right to
+// left for the upper one, popping every point that does not make a strict left turn.
+ConvexPoly2 ConvexPoly2::MakeFromPointCloud(std::vector<Vec2> const& points)
+{
+	std::vector<Vec2> sortedPoints(points);
+	std::sort(sortedPoints.begin(), sortedPoints.end(), PointLexicographicLess());
+	sortedPoints.erase(std::unique(sortedPoints.begin(), sortedPoints.end()), sortedPoints.end());
+
+	int numPoints = static_cast<int>(sortedPoints.size());
+	if(numPoints < 3)
+	{
+		return ConvexPoly2(sortedPoints);
+	}
+
+	std::vector<Vec2> hull(2 * numPoints);
+	int hullSize = 0;
+	for(int pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+	{
+		while(hullSize >= 2 && CrossProduct2D(hull[hullSize - 1] - hull[hullSize - 2], sortedPoints[pointIndex] - hull[hullSize - 2]) <= 0.f)
+		{
+			--hullSize;
+		}
+		hull[hullSize++] = sortedPoints[pointIndex];
+	}
+
+	int lowerSize = hullSize + 1;
+	for(int pointIndex = numPoints - 2; pointIndex >= 0; --pointIndex)
+	{
+		while(hullSize >= lowerSize && CrossProduct2D(hull[hullSize - 1] - hull[hullSize - 2], sortedPoints[pointIndex] - hull[hullSize - 2]) <= 0.f)
+		{
+			--hullSize;
+		}
+		hull[hullSize++] = sortedPoints[pointIndex];
+	}
+
+	// the upper chain ends back on the first point
+	hull.resize(hullSize - 1);
+	return ConvexPoly2(hull);
+}
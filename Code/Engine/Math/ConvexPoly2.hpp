@@ -8,6 +8,9 @@ struct ConvexPoly2
 	explicit ConvexPoly2(std::vector<Vec2> const& vertexPositions);
 	~ConvexPoly2() = default;
 
+	// Convex hull of any set of points, counter-clockwise, without duplicate or collinear vertexes. O(n log n).
+	static ConvexPoly2 MakeFromPointCloud(std::vector<Vec2> const& points);
+
 	void GetVertexPositions(std::vector<Vec2>& out_positions) const;
 	void OffsetVertexPositions(Vec2 const& offset);
 
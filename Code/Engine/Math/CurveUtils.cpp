@@ -1,6 +1,9 @@
 #include "Engine/Math/CurveUtils.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/LineSegment2.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <math.h>
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
 float ComputeCubicBezier1D(float a, float b, float c, float d, float t)
@@ -87,22 +90,34 @@ Vec2 CubicBezierCurve2D::EvaluateAtParametric(float parametricZeroToOne) const
 	return Vec2(pX, pY);
 }
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+Vec2 CubicBezierCurve2D::EvaluateTangentAtParametric(float parametricZeroToOne) const
+{
+	float t = parametricZeroToOne;
+	float oneMinusT = 1.f - t;
+
+	float startWeight = 3.f * oneMinusT * oneMinusT;
+	float middleWeight = 6.f * oneMinusT * t;
+	float endWeight = 3.f * t * t;
+
+	return startWeight * (m_guidePos1 - m_startPos) + middleWeight * (m_guidePos2 - m_guidePos1) + endWeight * (m_endPos - m_guidePos2);
+}
+
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
 float CubicBezierCurve2D::GetApproximateLength(int subdivisions) const
 {
 	float length = 0.f;
+	Vec2 start = m_startPos;
 
 	for(int segment = 0; segment < subdivisions; ++segment)
 	{
-		float currentSegmentStartTime = static_cast<float>(segment) / subdivisions;
 		float currentSegmentEndTime = static_cast<float>(segment + 1) / subdivisions;
 
-		Vec2 start = EvaluateAtParametric(currentSegmentStartTime);
 		Vec2 end = EvaluateAtParametric(currentSegmentEndTime);
 
-		LineSegment2 lineSegment = LineSegment2(start, end);
-		
-		length += lineSegment.GetLength();
+		length += (end - start).GetLength();
+
+		start = end;
 	}
 	return length;
 }
@@ -111,14 +126,13 @@ float CubicBezierCurve2D::GetApproximateLength(int subdivisions) const
 Vec2 CubicBezierCurve2D::EvaluateAtApproximateDistance(float distanceAlongCurve, int numSubdivisions)
 {
 	Vec2 point;
+	Vec2 start = m_startPos;
 
 	for(int segment = 0; segment < numSubdivisions; ++segment)
 	{
-		float currentSegmentStartTime = static_cast<float>(segment) / numSubdivisions;
 		float currentSegmentEndTime = static_cast<float>(segment + 1) / numSubdivisions;
 
-		Vec2 start = EvaluateAtParametric(currentSegmentStartTime);
-		Vec2 end =	 EvaluateAtParametric(currentSegmentEndTime);
+		Vec2 end = EvaluateAtParametric(currentSegmentEndTime);
 
 		float length = (end - start).GetLength();
 
@@ -134,6 +148,7 @@ Vec2 CubicBezierCurve2D::EvaluateAtApproximateDistance(float distanceAlongCurve,
 		}
 
 		distanceAlongCurve -= length;
+		start = end;
 	}
 	return point;
 }
@@ -247,25 +262,306 @@ float Spline::GetApproximateLength(int subdivisions) const
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
 Vec2 Spline::EvaluateAtApproximateDistance(float distanceAlongCurve, int numSubdivisions)
 {
-	Vec2 point;
-	float distanceLeft = distanceAlongCurve;
+	return GetArcLengthTable(numSubdivisions).EvaluateAtDistance(distanceAlongCurve);
+}
 
-	for(int index = 0; index < static_cast<int>(m_hermiteCurves.size()); ++index)
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Spline::RebuildArcLengthTable(int numSubdivisionsPerCurve)
+{
+	m_arcLengthTable = CurveArcLengthTable2D(*this, numSubdivisionsPerCurve);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+CurveArcLengthTable2D const& Spline::GetArcLengthTable(int numSubdivisionsPerCurve)
+{
+	if(m_arcLengthTable.GetNumSubdivisionsPerCurve() != numSubdivisionsPerCurve || m_arcLengthTable.GetNumCurves() != static_cast<int>(m_hermiteCurves.size()))
+	{
+		RebuildArcLengthTable(numSubdivisionsPerCurve);
+	}
+	return m_arcLengthTable;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// 5-point Gauss-Legendre on [-1, 1]; exact for polynomials up to degree 9, and the speed of a cubic is smooth enough
+// between table entries that this is far below float precision for any sane subdivision count.
+static constexpr int   NUM_ARC_LENGTH_QUADRATURE_POINTS = 5;
+static constexpr float ARC_LENGTH_QUADRATURE_NODES[NUM_ARC_LENGTH_QUADRATURE_POINTS] = { -0.906179845938664f, -0.538469310105683f, 0.f, 0.538469310105683f, 0.906179845938664f };
+static constexpr float ARC_LENGTH_QUADRATURE_WEIGHTS[NUM_ARC_LENGTH_QUADRATURE_POINTS] = { 0.236926885056189f, 0.478628670499366f, 0.568888888888889f, 0.478628670499366f, 0.236926885056189f };
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+CurveArcLengthTable2D::CurveArcLengthTable2D(CubicBezierCurve2D const& curve, int numSubdivisions)
+{
+	m_curves.push_back(curve);
+	BuildFromCurves(numSubdivisions);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+CurveArcLengthTable2D::CurveArcLengthTable2D(CubicHermiteCurve2D const& curve, int numSubdivisions)
+{
+	m_curves.push_back(CubicBezierCurve2D(curve));
+	BuildFromCurves(numSubdivisions);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+CurveArcLengthTable2D::CurveArcLengthTable2D(Spline const& spline, int numSubdivisionsPerCurve)
+{
+	m_curves.reserve(spline.m_hermiteCurves.size());
+
+	for(int index = 0; index < static_cast<int>(spline.m_hermiteCurves.size()); ++index)
+	{
+		m_curves.push_back(CubicBezierCurve2D(spline.m_hermiteCurves[index]));
+	}
+	BuildFromCurves(numSubdivisionsPerCurve);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void CurveArcLengthTable2D::BuildFromCurves(int numSubdivisionsPerCurve)
+{
+	GUARANTEE_OR_DIE(numSubdivisionsPerCurve > 0, "CurveArcLengthTable2D needs at least one subdivision per curve");
+
+	m_numSubdivisionsPerCurve = numSubdivisionsPerCurve;
+
+	int numCurves = static_cast<int>(m_curves.size());
+	m_cumulativeLengths.clear();
+	m_cumulativeLengths.reserve(numCurves * numSubdivisionsPerCurve + 1);
+	m_cumulativeLengths.push_back(0.f);
+
+	// Accumulate in double so a long spline's last entries are not off by the rounding of every interval before them
+	double totalLength = 0.0;
+	float  subdivisionWidth = 1.f / static_cast<float>(numSubdivisionsPerCurve);
+
+	for(int curveIndex = 0; curveIndex < numCurves; ++curveIndex)
 	{
-		float length = m_hermiteCurves[index].GetApproximateLength(numSubdivisions);
+		for(int subdivision = 0; subdivision < numSubdivisionsPerCurve; ++subdivision)
+		{
+			float startLocalT = static_cast<float>(subdivision) * subdivisionWidth;
+			float endLocalT = (subdivision == numSubdivisionsPerCurve - 1) ? 1.f : static_cast<float>(subdivision + 1) * subdivisionWidth;
 
-		if(distanceLeft > length)
+			totalLength += GetLengthWithinCurve(curveIndex, startLocalT, endLocalT);
+			m_cumulativeLengths.push_back(static_cast<float>(totalLength));
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+float CurveArcLengthTable2D::GetLengthWithinCurve(int curveIndex, float startLocalT, float endLocalT) const
+{
+	CubicBezierCurve2D const& curve = m_curves[curveIndex];
+
+	float halfWidth = 0.5f * (endLocalT - startLocalT);
+	float middle = 0.5f * (startLocalT + endLocalT);
+	float length = 0.f;
+
+	for(int point = 0; point < NUM_ARC_LENGTH_QUADRATURE_POINTS; ++point)
+	{
+		float t = middle + halfWidth * ARC_LENGTH_QUADRATURE_NODES[point];
+		length += ARC_LENGTH_QUADRATURE_WEIGHTS[point] * curve.EvaluateTangentAtParametric(t).GetLength();
+	}
+	return length * halfWidth;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+float CurveArcLengthTable2D::GetLength() const
+{
+	if(m_cumulativeLengths.empty())
+	{
+		return 0.f;
+	}
+	return m_cumulativeLengths.back();
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int CurveArcLengthTable2D::FindIntervalAtDistance(float distanceAlongCurve) const
+{
+	// Last entry at or before the distance; ties go to the later interval so zero-length intervals are skipped
+	int numIntervals = static_cast<int>(m_cumulativeLengths.size()) - 1;
+	int low = 0;
+	int high = numIntervals;
+
+	while(high - low > 1)
+	{
+		int middle = (low + high) / 2;
+
+		if(m_cumulativeLengths[middle] <= distanceAlongCurve)
 		{
-			distanceLeft -=length;
+			low = middle;
 		}
 		else
 		{
-			point = m_hermiteCurves[index].EvaluateAtApproximateDistance(distanceLeft, numSubdivisions);
+			high = middle;
+		}
+	}
+	return low;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+float CurveArcLengthTable2D::GetLocalParametricInInterval(int intervalIndex, float distanceAlongCurve) const
+{
+	float intervalStart = m_cumulativeLengths[intervalIndex];
+	float intervalLength = m_cumulativeLengths[intervalIndex + 1] - intervalStart;
+
+	float fraction = 0.f;
+	if(intervalLength > 0.f)
+	{
+		fraction = GetClampedZeroToOne((distanceAlongCurve - intervalStart) / intervalLength);
+	}
+
+	int subdivision = intervalIndex % m_numSubdivisionsPerCurve;
+	return (static_cast<float>(subdivision) + fraction) / static_cast<float>(m_numSubdivisionsPerCurve);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+float CurveArcLengthTable2D::RefineLocalParametricInInterval(int intervalIndex, float distanceAlongCurve, int maxNewtonSteps) const
+{
+	int   curveIndex = intervalIndex / m_numSubdivisionsPerCurve;
+	int   subdivision = intervalIndex % m_numSubdivisionsPerCurve;
+	float startLocalT = static_cast<float>(subdivision) / static_cast<float>(m_numSubdivisionsPerCurve);
+	float endLocalT = static_cast<float>(subdivision + 1) / static_cast<float>(m_numSubdivisionsPerCurve);
+	float distanceIntoInterval = distanceAlongCurve - m_cumulativeLengths[intervalIndex];
+
+	float localT = GetLocalParametricInInterval(intervalIndex, distanceAlongCurve);
+
+	// Newton on f(t) = length(start, t) - distance, where f'(t) is the speed; the linear guess is already close, so
+	// this converges in one or two steps and the clamp only matters on degenerate (stationary) stretches
+	for(int step = 0; step < maxNewtonSteps; ++step)
+	{
+		float error = GetLengthWithinCurve(curveIndex, startLocalT, localT) - distanceIntoInterval;
+		float speed = m_curves[curveIndex].EvaluateTangentAtParametric(localT).GetLength();
+
+		if(speed <= 0.f)
+		{
+			break;
+		}
+
+		float nextLocalT = GetClamped(localT - error / speed, startLocalT, endLocalT);
+		if(nextLocalT == localT)
+		{
 			break;
 		}
+		localT = nextLocalT;
 	}
+	return localT;
+}
 
-	return point;
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+float CurveArcLengthTable2D::GetParametricAtDistance(float distanceAlongCurve) const
+{
+	if(m_curves.empty())
+	{
+		return 0.f;
+	}
+
+	int intervalIndex = FindIntervalAtDistance(distanceAlongCurve);
+	int curveIndex = intervalIndex / m_numSubdivisionsPerCurve;
+	return static_cast<float>(curveIndex) + GetLocalParametricInInterval(intervalIndex, distanceAlongCurve);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+float CurveArcLengthTable2D::GetParametricAtDistanceRefined(float distanceAlongCurve, int maxNewtonSteps) const
+{
+	if(m_curves.empty())
+	{
+		return 0.f;
+	}
+
+	int intervalIndex = FindIntervalAtDistance(distanceAlongCurve);
+	int curveIndex = intervalIndex / m_numSubdivisionsPerCurve;
+	return static_cast<float>(curveIndex) + RefineLocalParametricInInterval(intervalIndex, distanceAlongCurve, maxNewtonSteps);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+float CurveArcLengthTable2D::GetDistanceAtParametric(float parametric) const
+{
+	if(m_curves.empty())
+	{
+		return 0.f;
+	}
+
+	int numCurves = static_cast<int>(m_curves.size());
+	int curveIndex = GetClamped(static_cast<int>(floorf(parametric)), 0, numCurves - 1);
+	float localT = GetClampedZeroToOne(parametric - static_cast<float>(curveIndex));
+
+	int subdivision = static_cast<int>(localT * static_cast<float>(m_numSubdivisionsPerCurve));
+	subdivision = GetClamped(subdivision, 0, m_numSubdivisionsPerCurve - 1);
+
+	float startLocalT = static_cast<float>(subdivision) / static_cast<float>(m_numSubdivisionsPerCurve);
+	int intervalIndex = curveIndex * m_numSubdivisionsPerCurve + subdivision;
+	return m_cumulativeLengths[intervalIndex] + GetLengthWithinCurve(curveIndex, startLocalT, localT);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+Vec2 CurveArcLengthTable2D::EvaluateAtParametric(float parametric) const
+{
+	if(m_curves.empty())
+	{
+		return Vec2();
+	}
+
+	int numCurves = static_cast<int>(m_curves.size());
+	int curveIndex = GetClamped(static_cast<int>(floorf(parametric)), 0, numCurves - 1);
+	return m_curves[curveIndex].EvaluateAtParametric(GetClampedZeroToOne(parametric - static_cast<float>(curveIndex)));
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+Vec2 CurveArcLengthTable2D::EvaluateAtDistance(float distanceAlongCurve) const
+{
+	if(m_curves.empty())
+	{
+		return Vec2();
+	}
+
+	int intervalIndex = FindIntervalAtDistance(distanceAlongCurve);
+	int curveIndex = intervalIndex / m_numSubdivisionsPerCurve;
+	return m_curves[curveIndex].EvaluateAtParametric(GetLocalParametricInInterval(intervalIndex, distanceAlongCurve));
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+Vec2 CurveArcLengthTable2D::EvaluateAtDistanceRefined(float distanceAlongCurve, int maxNewtonSteps) const
+{
+	if(m_curves.empty())
+	{
+		return Vec2();
+	}
+
+	int intervalIndex = FindIntervalAtDistance(distanceAlongCurve);
+	int curveIndex = intervalIndex / m_numSubdivisionsPerCurve;
+	return m_curves[curveIndex].EvaluateAtParametric(RefineLocalParametricInInterval(intervalIndex, distanceAlongCurve, maxNewtonSteps));
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void CurveArcLengthTable2D::SampleEvenlySpaced(int numPoints, std::vector<Vec2>& out_points) const
+{
+	if(numPoints <= 0 || m_curves.empty())
+	{
+		return;
+	}
+
+	out_points.reserve(out_points.size() + numPoints);
+
+	if(numPoints == 1)
+	{
+		out_points.push_back(m_curves[0].m_startPos);
+		return;
+	}
+
+	// Distances only increase, so walk the table forward once instead of searching it for every point
+	float totalLength = GetLength();
+	float spacing = totalLength / static_cast<float>(numPoints - 1);
+	int   lastIntervalIndex = static_cast<int>(m_cumulativeLengths.size()) - 2;
+	int   intervalIndex = 0;
+
+	for(int pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+	{
+		float distance = (pointIndex == numPoints - 1) ? totalLength : static_cast<float>(pointIndex) * spacing;
+
+		while(intervalIndex < lastIntervalIndex && m_cumulativeLengths[intervalIndex + 1] <= distance)
+		{
+			++intervalIndex;
+		}
+
+		int curveIndex = intervalIndex / m_numSubdivisionsPerCurve;
+		out_points.push_back(m_curves[curveIndex].EvaluateAtParametric(GetLocalParametricInInterval(intervalIndex, distance)));
+	}
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -344,28 +640,23 @@ float PieceWiseCurves::Evaluate(float t)
 		return iter->second.m_end;
 	}
 
-	for(auto iter = m_subCurves.begin(); iter != m_subCurves.end(); )
+	// The curve that starts at or before t is the one before the first curve starting after it
+	auto nextIter = m_subCurves.upper_bound(t);
+	if(nextIter == m_subCurves.begin())
 	{
-		float curveStartTime	= iter->first;
-		LinearCurve1D curve		= iter->second;
+		return 0.f;
+	}
 
-		auto	nextIter = ++iter;
-		float	nextCurveStartTime = 0.f;
+	auto iter = nextIter;
+	--iter;
 
-		if(nextIter == m_subCurves.end())
-		{
-			nextCurveStartTime = 1.f;
-		}
-		else
-		{
-			nextCurveStartTime = nextIter->first;
-		}
+	float curveStartTime		= iter->first;
+	float nextCurveStartTime	= (nextIter == m_subCurves.end()) ? 1.f : nextIter->first;
 
-		if(curveStartTime <= t && t < nextCurveStartTime)
-		{
-			float tFractionBetweenStartTimes = GetFractionWithinRange(t, curveStartTime, nextCurveStartTime);
-			return curve.Evaluate(tFractionBetweenStartTimes);
-		}
+	if(t < nextCurveStartTime)
+	{
+		float tFractionBetweenStartTimes = GetFractionWithinRange(t, curveStartTime, nextCurveStartTime);
+		return iter->second.Evaluate(tFractionBetweenStartTimes);
 	}
 
 	return 0.f;
@@ -4,6 +4,7 @@
 #include <map>
 
 class CubicHermiteCurve2D;
+class Spline;
 struct Hash2D;
 
 class CubicBezierCurve2D
@@ -14,6 +15,7 @@ public:
 	explicit CubicBezierCurve2D(Vec2 startPos, Vec2 guidePos1, Vec2 guidePos2, Vec2 endPos);
 	explicit CubicBezierCurve2D(CubicHermiteCurve2D hermite);
 	Vec2  EvaluateAtParametric(float parametricZeroToOne) const;
+	Vec2  EvaluateTangentAtParametric(float parametricZeroToOne) const;
 	float GetApproximateLength(int subdivisions = 64) const;
 	Vec2  EvaluateAtApproximateDistance(float distanceAlongCurve, int numSubdivisions = 64);
 
@@ -48,6 +50,60 @@ public:
 
 };
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Cumulative arc length sampled at evenly spaced parameters along one curve or a chain of them, so distance queries
+// cost a binary search instead of re-walking the curve. Build it once per curve (or after editing a spline) and keep it.
+//
+// Parameters follow Spline::EvaluateAtParametric: curve i covers [i, i + 1]. A single curve is [0, 1].
+// Each table interval is integrated with 5-point Gauss-Legendre rather than measured as a chord, so GetLength is
+// accurate to around 1e-6 relative at the default 64 subdivisions even on tight bends.
+//
+//	GetParametricAtDistance			binary search, then linear within the interval; good to a fraction of the
+//									interval's parametric width
+//	GetParametricAtDistanceRefined	the same, then Newton steps on the true arc length; for when a path follower
+//									must not drift from the distance it thinks it has travelled
+//	SampleEvenlySpaced				N points a fixed distance apart in one forward pass over the table
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+class CurveArcLengthTable2D
+{
+public:
+
+	CurveArcLengthTable2D() = default;
+	explicit CurveArcLengthTable2D(CubicBezierCurve2D const& curve, int numSubdivisions = 64);
+	explicit CurveArcLengthTable2D(CubicHermiteCurve2D const& curve, int numSubdivisions = 64);
+	explicit CurveArcLengthTable2D(Spline const& spline, int numSubdivisionsPerCurve = 64);
+
+	int   GetNumCurves() const						{ return static_cast<int>(m_curves.size()); }
+	int   GetNumSubdivisionsPerCurve() const		{ return m_numSubdivisionsPerCurve; }
+	float GetLength() const;
+
+	float GetParametricAtDistance(float distanceAlongCurve) const;
+	float GetParametricAtDistanceRefined(float distanceAlongCurve, int maxNewtonSteps = 3) const;
+	float GetDistanceAtParametric(float parametric) const;
+
+	Vec2  EvaluateAtParametric(float parametric) const;
+	Vec2  EvaluateAtDistance(float distanceAlongCurve) const;
+	Vec2  EvaluateAtDistanceRefined(float distanceAlongCurve, int maxNewtonSteps = 3) const;
+
+	// Appends numPoints points from the start to the end of the curve, evenly spaced by arc length
+	void  SampleEvenlySpaced(int numPoints, std::vector<Vec2>& out_points) const;
+
+private:
+
+	void  BuildFromCurves(int numSubdivisionsPerCurve);
+	int   FindIntervalAtDistance(float distanceAlongCurve) const;
+	float GetLocalParametricInInterval(int intervalIndex, float distanceAlongCurve) const;
+	float RefineLocalParametricInInterval(int intervalIndex, float distanceAlongCurve, int maxNewtonSteps) const;
+	float GetLengthWithinCurve(int curveIndex, float startLocalT, float endLocalT) const;
+
+private:
+
+	std::vector<CubicBezierCurve2D> m_curves;
+	std::vector<float>				m_cumulativeLengths;			// numCurves * subdivisions + 1; entry k is the length up to parameter k / subdivisions
+	int								m_numSubdivisionsPerCurve = 0;
+
+};
+
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
 class Spline
 {
@@ -62,11 +118,17 @@ public:
 	float GetApproximateLength(int subdivisions = 64) const;
 	Vec2  EvaluateAtApproximateDistance(float distanceAlongCurve, int numSubdivisions = 64);
 
+	// Distance queries go through this table. It is built on first use and rebuilt when numSubdivisions changes;
+	// call RebuildArcLengthTable after editing m_hermiteCurves directly.
+	void						 RebuildArcLengthTable(int numSubdivisionsPerCurve = 64);
+	CurveArcLengthTable2D const& GetArcLengthTable(int numSubdivisionsPerCurve = 64);
+
 public:
 	
 	std::vector<Vec2> m_positions;
 	std::vector<Vec2> m_velocities;
 	std::vector<CubicHermiteCurve2D> m_hermiteCurves;
+	CurveArcLengthTable2D m_arcLengthTable;
 
 };
 
@@ -0,0 +1,551 @@
+#include "Engine/Math/DynamicAABBTree3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Sphere.hpp"
+#include "Engine/Math/OBB3.hpp"
+#include "Engine/Math/Cylinder3D.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <math.h>
+
+//------------------------------------------------------------------------------------------------------------------
+// How far ahead of a moving proxy its fat bounds reach, in frames of its current displacement.
+constexpr float DISPLACEMENT_MULTIPLIER = 2.f;
+
+//------------------------------------------------------------------------------------------------------------------
+// Spelled out rather than built on GetMin/GetMax: insertion calls this several times per tree level.
+static void SetUnion(AABB3& out_bounds, AABB3 const& boundsA, AABB3 const& boundsB)
+{
+	out_bounds.m_mins.x = boundsA.m_mins.x < boundsB.m_mins.x ? boundsA.m_mins.x : boundsB.m_mins.x;
+	out_bounds.m_mins.y = boundsA.m_mins.y < boundsB.m_mins.y ? boundsA.m_mins.y : boundsB.m_mins.y;
+	out_bounds.m_mins.z = boundsA.m_mins.z < boundsB.m_mins.z ? boundsA.m_mins.z : boundsB.m_mins.z;
+	out_bounds.m_maxs.x = boundsA.m_maxs.x > boundsB.m_maxs.x ? boundsA.m_maxs.x : boundsB.m_maxs.x;
+	out_bounds.m_maxs.y = boundsA.m_maxs.y > boundsB.m_maxs.y ? boundsA.m_maxs.y : boundsB.m_maxs.y;
+	out_bounds.m_maxs.z = boundsA.m_maxs.z > boundsB.m_maxs.z ? boundsA.m_maxs.z : boundsB.m_maxs.z;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static float GetUnionHalfArea(AABB3 const& boundsA, AABB3 const& boundsB)
+{
+	float sizeX = (boundsA.m_maxs.x > boundsB.m_maxs.x ? boundsA.m_maxs.x : boundsB.m_maxs.x) - (boundsA.m_mins.x < boundsB.m_mins.x ? boundsA.m_mins.x : boundsB.m_mins.x);
+	float sizeY = (boundsA.m_maxs.y > boundsB.m_maxs.y ? boundsA.m_maxs.y : boundsB.m_maxs.y) - (boundsA.m_mins.y < boundsB.m_mins.y ? boundsA.m_mins.y : boundsB.m_mins.y);
+	float sizeZ = (boundsA.m_maxs.z > boundsB.m_maxs.z ? boundsA.m_maxs.z : boundsB.m_maxs.z) - (boundsA.m_mins.z < boundsB.m_mins.z ? boundsA.m_mins.z : boundsB.m_mins.z);
+	return sizeX * sizeY + sizeY * sizeZ + sizeZ * sizeX;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Half the surface area; the insertion cost only compares areas, so the factor of two never matters.
+static float GetHalfArea(AABB3 const& bounds)
+{
+	float sizeX = bounds.m_maxs.x - bounds.m_mins.x;
+	float sizeY = bounds.m_maxs.y - bounds.m_mins.y;
+	float sizeZ = bounds.m_maxs.z - bounds.m_mins.z;
+	return sizeX * sizeY + sizeY * sizeZ + sizeZ * sizeX;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static bool IsContaining(AABB3 const& outer, AABB3 const& inner)
+{
+	return outer.m_mins.x <= inner.m_mins.x && outer.m_mins.y <= inner.m_mins.y && outer.m_mins.z <= inner.m_mins.z &&
+		   outer.m_maxs.x >= inner.m_maxs.x && outer.m_maxs.y >= inner.m_maxs.y && outer.m_maxs.z >= inner.m_maxs.z;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+DynamicAABBTree3::DynamicAABBTree3(float fatMargin)
+	: m_fatMargin(fatMargin)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int DynamicAABBTree3::CreateProxy(AABB3 const& bounds, void* userData)
+{
+	int proxyId = AllocateNode();
+	Node& node = m_nodes[proxyId];
+	node.m_fatBounds = MakeFatBounds(bounds, Vec3());
+	node.m_userData = userData;
+	node.m_height = 0;
+	node.m_isMoved = true;
+
+	InsertLeaf(proxyId);
+	m_movedProxies.push_back(proxyId);
+	++m_numProxies;
+
+	return proxyId;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int DynamicAABBTree3::CreateProxy(Sphere const& sphere, void* userData)
+{
+	return CreateProxy(GetBoundsForSphere(sphere), userData);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int DynamicAABBTree3::CreateProxy(OBB3 const& obb, void* userData)
+{
+	return CreateProxy(GetBoundsForOBB3(obb), userData);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int DynamicAABBTree3::CreateProxy(Cylinder3D const& cylinder, void* userData)
+{
+	return CreateProxy(GetBoundsForCylinder3D(cylinder), userData);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void DynamicAABBTree3::DestroyProxy(int proxyId)
+{
+	GUARANTEE_OR_DIE(proxyId >= 0 && proxyId < static_cast<int>(m_nodes.size()) && m_nodes[proxyId].IsLeaf() && m_nodes[proxyId].m_height == 0,
+					 "DynamicAABBTree3::DestroyProxy called with an invalid proxy id");
+
+	if(m_nodes[proxyId].m_isMoved)
+	{
+		for(int movedIndex = 0; movedIndex < static_cast<int>(m_movedProxies.size()); ++movedIndex)
+		{
+			if(m_movedProxies[movedIndex] == proxyId)
+			{
+				m_movedProxies[movedIndex] = NULL_NODE;
+			}
+		}
+	}
+
+	RemoveLeaf(proxyId);
+	FreeNode(proxyId);
+	--m_numProxies;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool DynamicAABBTree3::MoveProxy(int proxyId, AABB3 const& bounds, Vec3 const& displacement)
+{
+	Node& node = m_nodes[proxyId];
+	if(IsContaining(node.m_fatBounds, bounds))
+	{
+		return false;
+	}
+
+	RemoveLeaf(proxyId);
+	m_nodes[proxyId].m_fatBounds = MakeFatBounds(bounds, displacement);
+	InsertLeaf(proxyId);
+
+	if(!m_nodes[proxyId].m_isMoved)
+	{
+		m_nodes[proxyId].m_isMoved = true;
+		m_movedProxies.push_back(proxyId);
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool DynamicAABBTree3::MoveProxy(int proxyId, Sphere const& sphere, Vec3 const& displacement)
+{
+	return MoveProxy(proxyId, GetBoundsForSphere(sphere), displacement);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool DynamicAABBTree3::MoveProxy(int proxyId, OBB3 const& obb, Vec3 const& displacement)
+{
+	return MoveProxy(proxyId, GetBoundsForOBB3(obb), displacement);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool DynamicAABBTree3::MoveProxy(int proxyId, Cylinder3D const& cylinder, Vec3 const& displacement)
+{
+	return MoveProxy(proxyId, GetBoundsForCylinder3D(cylinder), displacement);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int DynamicAABBTree3::GetHeight() const
+{
+	return m_rootIndex == NULL_NODE ? 0 : m_nodes[m_rootIndex].m_height;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// When both proxies of a pair moved, only the lower id reports it, so nothing comes out twice.
+void DynamicAABBTree3::FindNewPairs(std::vector<BroadphasePair3>& out_pairs)
+{
+	std::vector<int> candidates;
+
+	for(int movedIndex = 0; movedIndex < static_cast<int>(m_movedProxies.size()); ++movedIndex)
+	{
+		int proxyId = m_movedProxies[movedIndex];
+		if(proxyId == NULL_NODE)
+		{
+			continue;
+		}
+
+		candidates.clear();
+		QueryOverlaps(m_nodes[proxyId].m_fatBounds, candidates);
+
+		for(int candidateIndex = 0; candidateIndex < static_cast<int>(candidates.size()); ++candidateIndex)
+		{
+			int otherId = candidates[candidateIndex];
+			if(otherId == proxyId || (m_nodes[otherId].m_isMoved && otherId < proxyId))
+			{
+				continue;
+			}
+
+			BroadphasePair3 pair;
+			pair.m_proxyA = GetMin(proxyId, otherId);
+			pair.m_proxyB = GetMax(proxyId, otherId);
+			out_pairs.push_back(pair);
+		}
+	}
+
+	for(int movedIndex = 0; movedIndex < static_cast<int>(m_movedProxies.size()); ++movedIndex)
+	{
+		if(m_movedProxies[movedIndex] != NULL_NODE)
+		{
+			m_nodes[m_movedProxies[movedIndex]].m_isMoved = false;
+		}
+	}
+	m_movedProxies.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Walks the tree against itself: every inner node checks its two subtrees against each other, then each subtree
+// against itself. Each overlapping leaf pair is reached exactly once, without a per-leaf query.
+void DynamicAABBTree3::FindAllPairs(std::vector<BroadphasePair3>& out_pairs) const
+{
+	if(m_rootIndex == NULL_NODE)
+	{
+		return;
+	}
+
+	std::vector<int> selfStack;
+	std::vector<int> pairStack;
+	selfStack.push_back(m_rootIndex);
+
+	while(!selfStack.empty())
+	{
+		int nodeIndex = selfStack.back();
+		selfStack.pop_back();
+
+		Node const& node = m_nodes[nodeIndex];
+		if(node.IsLeaf())
+		{
+			continue;
+		}
+
+		selfStack.push_back(node.m_child1);
+		selfStack.push_back(node.m_child2);
+		pairStack.push_back(node.m_child1);
+		pairStack.push_back(node.m_child2);
+
+		while(!pairStack.empty())
+		{
+			int indexB = pairStack.back();
+			pairStack.pop_back();
+			int indexA = pairStack.back();
+			pairStack.pop_back();
+
+			Node const& nodeA = m_nodes[indexA];
+			Node const& nodeB = m_nodes[indexB];
+			if(!DoBoundsOverlap(nodeA.m_fatBounds, nodeB.m_fatBounds))
+			{
+				continue;
+			}
+
+			if(nodeA.IsLeaf() && nodeB.IsLeaf())
+			{
+				BroadphasePair3 pair;
+				pair.m_proxyA = GetMin(indexA, indexB);
+				pair.m_proxyB = GetMax(indexA, indexB);
+				out_pairs.push_back(pair);
+			}
+			else if(nodeB.IsLeaf() || (!nodeA.IsLeaf() && nodeA.m_height >= nodeB.m_height))
+			{
+				// descend into the taller side
+				pairStack.push_back(nodeA.m_child1);
+				pairStack.push_back(indexB);
+				pairStack.push_back(nodeA.m_child2);
+				pairStack.push_back(indexB);
+			}
+			else
+			{
+				pairStack.push_back(indexA);
+				pairStack.push_back(nodeB.m_child1);
+				pairStack.push_back(indexA);
+				pairStack.push_back(nodeB.m_child2);
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void DynamicAABBTree3::QueryOverlaps(AABB3 const& box, std::vector<int>& out_proxyIds) const
+{
+	struct AcceptAll
+	{
+		bool operator()(int) const { return true; }
+	};
+
+	QueryOverlaps(box, AcceptAll(), out_proxyIds);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int DynamicAABBTree3::AllocateNode()
+{
+	if(m_freeList == NULL_NODE)
+	{
+		m_nodes.push_back(Node());
+		return static_cast<int>(m_nodes.size()) - 1;
+	}
+
+	int nodeIndex = m_freeList;
+	m_freeList = m_nodes[nodeIndex].m_parentOrNext;
+	m_nodes[nodeIndex] = Node();
+	return nodeIndex;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void DynamicAABBTree3::FreeNode(int nodeIndex)
+{
+	Node& node = m_nodes[nodeIndex];
+	node.m_parentOrNext = m_freeList;
+	node.m_child1 = NULL_NODE;
+	node.m_child2 = NULL_NODE;
+	node.m_height = -1;
+	node.m_userData = nullptr;
+	node.m_isMoved = false;
+	m_freeList = nodeIndex;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Walks down to the sibling whose enlargement costs least (surface area heuristic), then pairs the leaf with it
+// under a new parent and rebalances on the way back up.
+void DynamicAABBTree3::InsertLeaf(int leafIndex)
+{
+	if(m_rootIndex == NULL_NODE)
+	{
+		m_rootIndex = leafIndex;
+		m_nodes[leafIndex].m_parentOrNext = NULL_NODE;
+		return;
+	}
+
+	AABB3 const leafBounds = m_nodes[leafIndex].m_fatBounds;
+	int siblingIndex = m_rootIndex;
+
+	while(!m_nodes[siblingIndex].IsLeaf())
+	{
+		Node const& node = m_nodes[siblingIndex];
+		float area = GetHalfArea(node.m_fatBounds);
+		float combinedArea = GetUnionHalfArea(node.m_fatBounds, leafBounds);
+
+		// cost of making a new parent here, and the extra area every level below would inherit
+		float cost = 2.f * combinedArea;
+		float inheritanceCost = 2.f * (combinedArea - area);
+
+		float childCosts[2];
+		int children[2] = { node.m_child1, node.m_child2 };
+		for(int childSlot = 0; childSlot < 2; ++childSlot)
+		{
+			Node const& child = m_nodes[children[childSlot]];
+			float enlargedArea = GetUnionHalfArea(child.m_fatBounds, leafBounds);
+			childCosts[childSlot] = (child.IsLeaf() ? enlargedArea : enlargedArea - GetHalfArea(child.m_fatBounds)) + inheritanceCost;
+		}
+
+		if(cost < childCosts[0] && cost < childCosts[1])
+		{
+			break;
+		}
+
+		siblingIndex = childCosts[0] < childCosts[1] ? children[0] : children[1];
+	}
+
+	int oldParentIndex = m_nodes[siblingIndex].m_parentOrNext;
+	int newParentIndex = AllocateNode();
+
+	Node& newParent = m_nodes[newParentIndex];
+	newParent.m_parentOrNext = oldParentIndex;
+	SetUnion(newParent.m_fatBounds, leafBounds, m_nodes[siblingIndex].m_fatBounds);
+	newParent.m_height = m_nodes[siblingIndex].m_height + 1;
+	newParent.m_child1 = siblingIndex;
+	newParent.m_child2 = leafIndex;
+
+	if(oldParentIndex == NULL_NODE)
+	{
+		m_rootIndex = newParentIndex;
+	}
+	else if(m_nodes[oldParentIndex].m_child1 == siblingIndex)
+	{
+		m_nodes[oldParentIndex].m_child1 = newParentIndex;
+	}
+	else
+	{
+		m_nodes[oldParentIndex].m_child2 = newParentIndex;
+	}
+
+	m_nodes[siblingIndex].m_parentOrNext = newParentIndex;
+	m_nodes[leafIndex].m_parentOrNext = newParentIndex;
+
+	FixUpwards(m_nodes[leafIndex].m_parentOrNext);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void DynamicAABBTree3::RemoveLeaf(int leafIndex)
+{
+	if(leafIndex == m_rootIndex)
+	{
+		m_rootIndex = NULL_NODE;
+		return;
+	}
+
+	int parentIndex = m_nodes[leafIndex].m_parentOrNext;
+	int grandParentIndex = m_nodes[parentIndex].m_parentOrNext;
+	int siblingIndex = m_nodes[parentIndex].m_child1 == leafIndex ? m_nodes[parentIndex].m_child2 : m_nodes[parentIndex].m_child1;
+
+	if(grandParentIndex == NULL_NODE)
+	{
+		m_rootIndex = siblingIndex;
+		m_nodes[siblingIndex].m_parentOrNext = NULL_NODE;
+		FreeNode(parentIndex);
+		return;
+	}
+
+	// the sibling takes the parent's place
+	if(m_nodes[grandParentIndex].m_child1 == parentIndex)
+	{
+		m_nodes[grandParentIndex].m_child1 = siblingIndex;
+	}
+	else
+	{
+		m_nodes[grandParentIndex].m_child2 = siblingIndex;
+	}
+	m_nodes[siblingIndex].m_parentOrNext = grandParentIndex;
+	FreeNode(parentIndex);
+
+	FixUpwards(grandParentIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Rebalances, then refreshes height and bounds from nodeIndex up to the root.
+void DynamicAABBTree3::FixUpwards(int nodeIndex)
+{
+	while(nodeIndex != NULL_NODE)
+	{
+		nodeIndex = Balance(nodeIndex);
+
+		Node& node = m_nodes[nodeIndex];
+		Node const& child1 = m_nodes[node.m_child1];
+		Node const& child2 = m_nodes[node.m_child2];
+		node.m_height = 1 + GetMax(child1.m_height, child2.m_height);
+		SetUnion(node.m_fatBounds, child1.m_fatBounds, child2.m_fatBounds);
+
+		nodeIndex = node.m_parentOrNext;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// If one child of A is two or more levels taller than the other, rotates that child up into A's place. Returns the
+// index of the node now at A's position.
+int DynamicAABBTree3::Balance(int indexA)
+{
+	Node& nodeA = m_nodes[indexA];
+	if(nodeA.IsLeaf() || nodeA.m_height < 2)
+	{
+		return indexA;
+	}
+
+	int indexB = nodeA.m_child1;
+	int indexC = nodeA.m_child2;
+	Node& nodeB = m_nodes[indexB];
+	Node& nodeC = m_nodes[indexC];
+	int balance = nodeC.m_height - nodeB.m_height;
+
+	if(balance > 1 || balance < -1)
+	{
+		// rise is the taller child, stay the shorter one
+		bool isRaisingC = balance > 1;
+		int indexRise = isRaisingC ? indexC : indexB;
+		int indexStay = isRaisingC ? indexB : indexC;
+		Node& rise = m_nodes[indexRise];
+		Node& stay = m_nodes[indexStay];
+
+		int indexF = rise.m_child1;
+		int indexG = rise.m_child2;
+		Node& nodeF = m_nodes[indexF];
+		Node& nodeG = m_nodes[indexG];
+
+		// rise replaces A under A's parent, and A becomes rise's first child
+		rise.m_child1 = indexA;
+		rise.m_parentOrNext = nodeA.m_parentOrNext;
+		nodeA.m_parentOrNext = indexRise;
+
+		if(rise.m_parentOrNext == NULL_NODE)
+		{
+			m_rootIndex = indexRise;
+		}
+		else if(m_nodes[rise.m_parentOrNext].m_child1 == indexA)
+		{
+			m_nodes[rise.m_parentOrNext].m_child1 = indexRise;
+		}
+		else
+		{
+			m_nodes[rise.m_parentOrNext].m_child2 = indexRise;
+		}
+
+		// the taller grandchild stays with rise, the shorter one moves down into A in rise's old slot
+		int indexKeep = nodeF.m_height > nodeG.m_height ? indexF : indexG;
+		int indexMove = nodeF.m_height > nodeG.m_height ? indexG : indexF;
+		Node& keep = m_nodes[indexKeep];
+		Node& move = m_nodes[indexMove];
+
+		rise.m_child2 = indexKeep;
+		if(isRaisingC)
+		{
+			nodeA.m_child2 = indexMove;
+		}
+		else
+		{
+			nodeA.m_child1 = indexMove;
+		}
+		move.m_parentOrNext = indexA;
+
+		SetUnion(nodeA.m_fatBounds, stay.m_fatBounds, move.m_fatBounds);
+		nodeA.m_height = 1 + GetMax(stay.m_height, move.m_height);
+		SetUnion(rise.m_fatBounds, nodeA.m_fatBounds, keep.m_fatBounds);
+		rise.m_height = 1 + GetMax(nodeA.m_height, keep.m_height);
+
+		return indexRise;
+	}
+
+	return indexA;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+AABB3 DynamicAABBTree3::MakeFatBounds(AABB3 const& bounds, Vec3 const& displacement) const
+{
+	Vec3 margin(m_fatMargin, m_fatMargin, m_fatMargin);
+	AABB3 fatBounds(bounds.m_mins - margin, bounds.m_maxs + margin);
+
+	// stretch toward where the proxy is heading, so steady movement doesn't reinsert every frame
+	Vec3 stretch = displacement * DISPLACEMENT_MULTIPLIER;
+	fatBounds.m_mins += Vec3(GetMin(stretch.x, 0.f), GetMin(stretch.y, 0.f), GetMin(stretch.z, 0.f));
+	fatBounds.m_maxs += Vec3(GetMax(stretch.x, 0.f), GetMax(stretch.y, 0.f), GetMax(stretch.z, 0.f));
+
+	return fatBounds;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool DynamicAABBTree3::DoBoundsOverlap(AABB3 const& boundsA, AABB3 const& boundsB)
+{
+	return boundsA.m_mins.x <= boundsB.m_maxs.x && boundsA.m_maxs.x >= boundsB.m_mins.x &&
+		   boundsA.m_mins.y <= boundsB.m_maxs.y && boundsA.m_maxs.y >= boundsB.m_mins.y &&
+		   boundsA.m_mins.z <= boundsB.m_maxs.z && boundsA.m_maxs.z >= boundsB.m_mins.z;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool DynamicAABBTree3::IsRayHittingBounds(Vec3 const& startPos, Vec3 const& invFwd, AABB3 const& bounds, float maxDist, float& out_entryDist)
+{
+	float tx0 = (bounds.m_mins.x - startPos.x) * invFwd.x;
+	float tx1 = (bounds.m_maxs.x - startPos.x) * invFwd.x;
+	float ty0 = (bounds.m_mins.y - startPos.y) * invFwd.y;
+	float ty1 = (bounds.m_maxs.y - startPos.y) * invFwd.y;
+	float tz0 = (bounds.m_mins.z - startPos.z) * invFwd.z;
+	float tz1 = (bounds.m_maxs.z - startPos.z) * invFwd.z;
+
+	float entry = fmaxf(fmaxf(fminf(tx0, tx1), fminf(ty0, ty1)), fmaxf(fminf(tz0, tz1), 0.f));
+	float exit = fminf(fminf(fmaxf(tx0, tx1), fmaxf(ty0, ty1)), fminf(fmaxf(tz0, tz1), maxDist));
+
+	out_entryDist = entry;
+	return entry <= exit;
+}
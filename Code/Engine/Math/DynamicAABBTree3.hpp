@@ -0,0 +1,191 @@
+#pragma once
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------
+struct Sphere;
+struct OBB3;
+struct Cylinder3D;
+
+//------------------------------------------------------------------------------------------------------------------
+struct BroadphasePair3
+{
+	int m_proxyA = -1;			// always the lower id
+	int m_proxyB = -1;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Incremental broadphase for moving 3D shapes. Each proxy is a leaf holding a fattened AABB3 and a caller pointer;
+// inner nodes are kept height-balanced with tree rotations, so create, move and destroy are O(log n).
+//
+// A proxy's fat bounds are its tight bounds grown by the margin, plus a stretch along its last displacement. MoveProxy
+// only touches the tree when the new tight bounds leave the fat ones, so slow-moving actors cost nothing most frames.
+// Pair and volume queries work on fat bounds and return candidates; run the exact Do*Overlap test on what comes back.
+//
+// Two ways to get pairs:
+//	FindNewPairs	pairs involving proxies reinserted since the last call (keep your own contact list, drop a pair
+//					once its fat bounds stop overlapping). This is the cheap per-frame path.
+//	FindAllPairs	every overlapping pair, for callers that want the full set each frame.
+//------------------------------------------------------------------------------------------------------------------
+class DynamicAABBTree3
+{
+public:
+	explicit DynamicAABBTree3(float fatMargin = 0.1f);
+	~DynamicAABBTree3() = default;
+
+	int		CreateProxy(AABB3 const& bounds, void* userData);
+	int		CreateProxy(Sphere const& sphere, void* userData);
+	int		CreateProxy(OBB3 const& obb, void* userData);
+	int		CreateProxy(Cylinder3D const& cylinder, void* userData);
+	void	DestroyProxy(int proxyId);
+
+	// Returns true if the proxy had to be reinserted. displacement is how far it moved this frame, if known.
+	bool	MoveProxy(int proxyId, AABB3 const& bounds, Vec3 const& displacement = Vec3());
+	bool	MoveProxy(int proxyId, Sphere const& sphere, Vec3 const& displacement = Vec3());
+	bool	MoveProxy(int proxyId, OBB3 const& obb, Vec3 const& displacement = Vec3());
+	bool	MoveProxy(int proxyId, Cylinder3D const& cylinder, Vec3 const& displacement = Vec3());
+
+	void*			GetUserData(int proxyId) const		{ return m_nodes[proxyId].m_userData; }
+	AABB3 const&	GetFatBounds(int proxyId) const		{ return m_nodes[proxyId].m_fatBounds; }
+	int				GetNumProxies() const				{ return m_numProxies; }
+	int				GetHeight() const;
+
+	void	FindNewPairs(std::vector<BroadphasePair3>& out_pairs);
+	void	FindAllPairs(std::vector<BroadphasePair3>& out_pairs) const;
+
+	// Appends every proxy whose fat bounds overlap the box; isProxyOverlapping(proxyId) filters them further.
+	void	QueryOverlaps(AABB3 const& box, std::vector<int>& out_proxyIds) const;
+	template<typename ProxyOverlapFunc>
+	void	QueryOverlaps(AABB3 const& box, ProxyOverlapFunc const& isProxyOverlapping, std::vector<int>& out_proxyIds) const;
+
+	// raycastProxy(proxyId, maxDist) returns a RaycastResult3D against that proxy's shape; the ray is shortened to each
+	// closer hit. Same contract as BVH3::RaycastClosest.
+	template<typename ProxyRaycastFunc>
+	RaycastResult3D	RaycastClosest(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, ProxyRaycastFunc const& raycastProxy, int* out_proxyId = nullptr) const;
+
+public:
+	static constexpr int NULL_NODE = -1;
+	static constexpr int MAX_QUERY_DEPTH = 64;			// an AVL-balanced tree stays under 46 levels for any int count
+
+private:
+	struct Node
+	{
+		AABB3	m_fatBounds;
+		void*	m_userData = nullptr;
+		int		m_parentOrNext = NULL_NODE;		// next free node while on the free list
+		int		m_child1 = NULL_NODE;
+		int		m_child2 = NULL_NODE;
+		int		m_height = -1;					// 0 for leaves, -1 while free
+		bool	m_isMoved = false;
+
+		bool	IsLeaf() const		{ return m_child1 == NULL_NODE; }
+	};
+
+	int		AllocateNode();
+	void	FreeNode(int nodeIndex);
+	void	InsertLeaf(int leafIndex);
+	void	RemoveLeaf(int leafIndex);
+	int		Balance(int nodeIndex);
+	void	FixUpwards(int nodeIndex);
+	AABB3	MakeFatBounds(AABB3 const& bounds, Vec3 const& displacement) const;
+
+	static bool	DoBoundsOverlap(AABB3 const& boundsA, AABB3 const& boundsB);
+	static bool	IsRayHittingBounds(Vec3 const& startPos, Vec3 const& invFwd, AABB3 const& bounds, float maxDist, float& out_entryDist);
+
+private:
+	std::vector<Node>	m_nodes;
+	std::vector<int>	m_movedProxies;
+	int					m_rootIndex = NULL_NODE;
+	int					m_freeList = NULL_NODE;
+	int					m_numProxies = 0;
+	float				m_fatMargin = 0.1f;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename ProxyOverlapFunc>
+void DynamicAABBTree3::QueryOverlaps(AABB3 const& box, ProxyOverlapFunc const& isProxyOverlapping, std::vector<int>& out_proxyIds) const
+{
+	if(m_rootIndex == NULL_NODE)
+	{
+		return;
+	}
+
+	int nodeStack[MAX_QUERY_DEPTH];
+	int stackSize = 0;
+	nodeStack[stackSize++] = m_rootIndex;
+
+	while(stackSize > 0)
+	{
+		int nodeIndex = nodeStack[--stackSize];
+		Node const& node = m_nodes[nodeIndex];
+		if(!DoBoundsOverlap(node.m_fatBounds, box))
+		{
+			continue;
+		}
+
+		if(!node.IsLeaf())
+		{
+			nodeStack[stackSize++] = node.m_child2;
+			nodeStack[stackSize++] = node.m_child1;
+			continue;
+		}
+
+		if(isProxyOverlapping(nodeIndex))
+		{
+			out_proxyIds.push_back(nodeIndex);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename ProxyRaycastFunc>
+RaycastResult3D DynamicAABBTree3::RaycastClosest(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, ProxyRaycastFunc const& raycastProxy, int* out_proxyId) const
+{
+	RaycastResult3D closest(false, startPos, fwdNormal, maxDist);
+	int closestProxy = -1;
+	float closestDist = maxDist;
+	Vec3 invFwd(1.f / fwdNormal.x, 1.f / fwdNormal.y, 1.f / fwdNormal.z);
+
+	int nodeStack[MAX_QUERY_DEPTH];
+	int stackSize = 0;
+	if(m_rootIndex != NULL_NODE)
+	{
+		nodeStack[stackSize++] = m_rootIndex;
+	}
+
+	while(stackSize > 0)
+	{
+		int nodeIndex = nodeStack[--stackSize];
+		Node const& node = m_nodes[nodeIndex];
+		float entryDist = 0.f;
+		if(!IsRayHittingBounds(startPos, invFwd, node.m_fatBounds, closestDist, entryDist))
+		{
+			continue;
+		}
+
+		if(!node.IsLeaf())
+		{
+			nodeStack[stackSize++] = node.m_child2;
+			nodeStack[stackSize++] = node.m_child1;
+			continue;
+		}
+
+		RaycastResult3D result = raycastProxy(nodeIndex, closestDist);
+		if(result.m_didImpact && result.m_impactDistance <= closestDist)
+		{
+			closest = result;
+			closestDist = result.m_impactDistance;
+			closestProxy = nodeIndex;
+		}
+	}
+
+	closest.m_rayMaxLength = maxDist;
+	if(out_proxyId != nullptr)
+	{
+		*out_proxyId = closestProxy;
+	}
+	return closest;
+}
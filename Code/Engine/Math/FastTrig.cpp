@@ -0,0 +1,243 @@
+#include "Engine/Math/FastTrig.hpp"
+#include "Engine/Math/SIMDUtils.hpp"
+
+#include <float.h>
+#include <math.h>
+
+//------------------------------------------------------------------------------------------------------------------
+constexpr float DEGREES_TO_RADIANS = 3.14159265358979f / 180.f;
+constexpr float RADIANS_TO_DEGREES = 180.f / 3.14159265358979f;
+
+// minimax coefficients for sin(x) / x and cos(x) on [-pi/4, pi/4] (Cephes sinf / cosf)
+constexpr float SIN_COEFFICIENT_3 = -1.6666654611e-1f;
+constexpr float SIN_COEFFICIENT_5 = 8.3321608736e-3f;
+constexpr float SIN_COEFFICIENT_7 = -1.9515295891e-4f;
+constexpr float COS_COEFFICIENT_4 = 4.166664568298827e-2f;
+constexpr float COS_COEFFICIENT_6 = -1.388731625493765e-3f;
+constexpr float COS_COEFFICIENT_8 = 2.443315711809948e-5f;
+
+// minimax coefficients for atan(x) on [-tan(pi/8), tan(pi/8)] (Cephes atanf)
+constexpr float ATAN_COEFFICIENT_3 = -3.33329491539e-1f;
+constexpr float ATAN_COEFFICIENT_5 = 1.99777106478e-1f;
+constexpr float ATAN_COEFFICIENT_7 = -1.38776856032e-1f;
+constexpr float ATAN_COEFFICIENT_9 = 8.05374449538e-2f;
+constexpr float TAN_PI_OVER_8 = 0.414213562373095f;
+
+//------------------------------------------------------------------------------------------------------------------
+// Scalar versions. The batch kernels below evaluate the same expressions in the same order.
+//------------------------------------------------------------------------------------------------------------------
+static void EvaluateSinCosPolynomials(float reducedDegrees, float& out_sine, float& out_cosine)
+{
+	float x = reducedDegrees * DEGREES_TO_RADIANS;
+	float x2 = x * x;
+	out_sine = x * x2 * (x2 * (x2 * SIN_COEFFICIENT_7 + SIN_COEFFICIENT_5) + SIN_COEFFICIENT_3) + x;
+	out_cosine = x2 * x2 * (x2 * (x2 * COS_COEFFICIENT_8 + COS_COEFFICIENT_6) + COS_COEFFICIENT_4) + (1.f - 0.5f * x2);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Goes through the Float4 round so the scalar and batch versions agree on ties; nearbyintf is a library call on
+// SSE2-only builds and costs more than the polynomials.
+static float RoundToNearest(float value)
+{
+	return Float4GetLane<0>(Float4Round(Float4Splat(value)));
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void FastSinCosDegrees(float degrees, float& out_sine, float& out_cosine)
+{
+	float quadrant = RoundToNearest(degrees * (1.f / 90.f));
+	float sine;
+	float cosine;
+	EvaluateSinCosPolynomials(degrees - quadrant * 90.f, sine, cosine);
+
+	switch(static_cast<int>(quadrant) & 3)
+	{
+		case 0:		out_sine = sine;		out_cosine = cosine;	break;
+		case 1:		out_sine = cosine;		out_cosine = -sine;		break;
+		case 2:		out_sine = -sine;		out_cosine = -cosine;	break;
+		default:	out_sine = -cosine;		out_cosine = sine;		break;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+float FastSinDegrees(float degrees)
+{
+	float sine;
+	float cosine;
+	FastSinCosDegrees(degrees, sine, cosine);
+	return sine;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+float FastCosDegrees(float degrees)
+{
+	float sine;
+	float cosine;
+	FastSinCosDegrees(degrees, sine, cosine);
+	return cosine;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Works on the ratio of the smaller to the larger of |x| and |y|, which is in [0, 1]. Above tan(22.5) the identity
+// atan(r) = 45 + atan((r - 1) / (r + 1)) brings it back into the polynomial's range, and with r = min / max that
+// second ratio is (min - max) / (min + max), so there is still only one divide. The octant is restored afterwards.
+float FastATan2Degrees(float y, float x)
+{
+	float absY = fabsf(y);
+	float absX = fabsf(x);
+	bool isSteep = absY > absX;
+	float smaller = isSteep ? absX : absY;
+	float larger = isSteep ? absY : absX;
+	bool isPastEighth = smaller > TAN_PI_OVER_8 * larger;
+
+	float numerator = isPastEighth ? smaller - larger : smaller;
+	float denominator = isPastEighth ? smaller + larger : larger;
+	float ratio = numerator / (denominator > FLT_MIN ? denominator : FLT_MIN);
+	float ratio2 = ratio * ratio;
+	float degrees = (ratio * ratio2 * (ratio2 * (ratio2 * (ratio2 * ATAN_COEFFICIENT_9 + ATAN_COEFFICIENT_7) + ATAN_COEFFICIENT_5) + ATAN_COEFFICIENT_3) + ratio) * RADIANS_TO_DEGREES;
+
+	degrees = isPastEighth ? degrees + 45.f : degrees;
+	degrees = isSteep ? 90.f - degrees : degrees;
+	degrees = x < 0.f ? 180.f - degrees : degrees;
+	return y < 0.f ? -degrees : degrees;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Batch versions
+//------------------------------------------------------------------------------------------------------------------
+#if defined(ENGINE_SIMD_AVX2)
+typedef Float8Ops TrigOps;
+#else
+typedef Float4Ops TrigOps;
+#endif
+
+typedef TrigOps::Type	TrigLane;
+
+constexpr int TRIG_LANES = TrigOps::WIDTH;
+
+//------------------------------------------------------------------------------------------------------------------
+// Multiplying by -1 rather than subtracting from zero flips the sign of zeros too, the same as unary minus.
+static TrigLane NegateIf(TrigLane mask, TrigLane value)
+{
+	return TrigOps::Select(mask, TrigOps::Mul(value, TrigOps::Splat(-1.f)), value);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// The quadrant comes back as a float; quadrant - 4 * round(quadrant / 4) puts it in [-2, 2], where -1 is the same
+// quadrant as 3 and -2 the same as 2.
+static void SinCosDegreesLanes(TrigLane degrees, TrigLane& out_sines, TrigLane& out_cosines)
+{
+	TrigLane quadrant = TrigOps::Round(TrigOps::Mul(degrees, TrigOps::Splat(1.f / 90.f)));
+	TrigLane reduced = TrigOps::Sub(degrees, TrigOps::Mul(quadrant, TrigOps::Splat(90.f)));
+
+	TrigLane x = TrigOps::Mul(reduced, TrigOps::Splat(DEGREES_TO_RADIANS));
+	TrigLane x2 = TrigOps::Mul(x, x);
+	TrigLane sinePolynomial = TrigOps::MulAdd(x2, TrigOps::Splat(SIN_COEFFICIENT_7), TrigOps::Splat(SIN_COEFFICIENT_5));
+	sinePolynomial = TrigOps::MulAdd(x2, sinePolynomial, TrigOps::Splat(SIN_COEFFICIENT_3));
+	TrigLane sine = TrigOps::MulAdd(TrigOps::Mul(x, x2), sinePolynomial, x);
+	TrigLane cosinePolynomial = TrigOps::MulAdd(x2, TrigOps::Splat(COS_COEFFICIENT_8), TrigOps::Splat(COS_COEFFICIENT_6));
+	cosinePolynomial = TrigOps::MulAdd(x2, cosinePolynomial, TrigOps::Splat(COS_COEFFICIENT_4));
+	TrigLane cosine = TrigOps::MulAdd(TrigOps::Mul(x2, x2), cosinePolynomial, TrigOps::Sub(TrigOps::Splat(1.f), TrigOps::Mul(TrigOps::Splat(0.5f), x2)));
+
+	TrigLane wrapped = TrigOps::Sub(quadrant, TrigOps::Mul(TrigOps::Splat(4.f), TrigOps::Round(TrigOps::Mul(quadrant, TrigOps::Splat(0.25f)))));
+	TrigLane isOdd = TrigOps::Or(TrigOps::CmpEq(wrapped, TrigOps::Splat(1.f)), TrigOps::CmpEq(wrapped, TrigOps::Splat(-1.f)));
+	TrigLane isSineNegative = TrigOps::Or(TrigOps::CmpLt(wrapped, TrigOps::Splat(-0.5f)), TrigOps::CmpGt(wrapped, TrigOps::Splat(1.5f)));
+	TrigLane isCosineNegative = TrigOps::Or(TrigOps::CmpGt(wrapped, TrigOps::Splat(0.5f)), TrigOps::CmpLt(wrapped, TrigOps::Splat(-1.5f)));
+
+	out_sines = NegateIf(isSineNegative, TrigOps::Select(isOdd, cosine, sine));
+	out_cosines = NegateIf(isCosineNegative, TrigOps::Select(isOdd, sine, cosine));
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static TrigLane ATan2DegreesLanes(TrigLane ys, TrigLane xs)
+{
+	TrigLane zero = TrigOps::Zero();
+	TrigLane absY = TrigOps::Max(ys, TrigOps::Sub(zero, ys));
+	TrigLane absX = TrigOps::Max(xs, TrigOps::Sub(zero, xs));
+	TrigLane isSteep = TrigOps::CmpGt(absY, absX);
+	TrigLane smaller = TrigOps::Select(isSteep, absX, absY);
+	TrigLane larger = TrigOps::Select(isSteep, absY, absX);
+	TrigLane isPastEighth = TrigOps::CmpGt(smaller, TrigOps::Mul(TrigOps::Splat(TAN_PI_OVER_8), larger));
+
+	TrigLane numerator = TrigOps::Select(isPastEighth, TrigOps::Sub(smaller, larger), smaller);
+	TrigLane denominator = TrigOps::Select(isPastEighth, TrigOps::Add(smaller, larger), larger);
+	TrigLane ratio = TrigOps::Div(numerator, TrigOps::Max(denominator, TrigOps::Splat(FLT_MIN)));
+	TrigLane ratio2 = TrigOps::Mul(ratio, ratio);
+	TrigLane polynomial = TrigOps::MulAdd(ratio2, TrigOps::Splat(ATAN_COEFFICIENT_9), TrigOps::Splat(ATAN_COEFFICIENT_7));
+	polynomial = TrigOps::MulAdd(ratio2, polynomial, TrigOps::Splat(ATAN_COEFFICIENT_5));
+	polynomial = TrigOps::MulAdd(ratio2, polynomial, TrigOps::Splat(ATAN_COEFFICIENT_3));
+	TrigLane degrees = TrigOps::Mul(TrigOps::MulAdd(TrigOps::Mul(ratio, ratio2), polynomial, ratio), TrigOps::Splat(RADIANS_TO_DEGREES));
+
+	degrees = TrigOps::Select(isPastEighth, TrigOps::Add(degrees, TrigOps::Splat(45.f)), degrees);
+	degrees = TrigOps::Select(isSteep, TrigOps::Sub(TrigOps::Splat(90.f), degrees), degrees);
+	degrees = TrigOps::Select(TrigOps::CmpLt(xs, zero), TrigOps::Sub(TrigOps::Splat(180.f), degrees), degrees);
+	return NegateIf(TrigOps::CmpLt(ys, zero), degrees);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void SinCosDegreesBatch(int count, float const* degrees, float* out_sines, float* out_cosines)
+{
+	int index = 0;
+	for(; index + TRIG_LANES <= count; index += TRIG_LANES)
+	{
+		TrigLane sines;
+		TrigLane cosines;
+		SinCosDegreesLanes(TrigOps::Load(degrees + index), sines, cosines);
+		TrigOps::Store(out_sines + index, sines);
+		TrigOps::Store(out_cosines + index, cosines);
+	}
+
+	if(index == count)
+	{
+		return;
+	}
+
+	float padded[TRIG_LANES] = {};
+	float paddedSines[TRIG_LANES];
+	float paddedCosines[TRIG_LANES];
+	for(int lane = 0; index + lane < count; ++lane)
+	{
+		padded[lane] = degrees[index + lane];
+	}
+
+	TrigLane sines;
+	TrigLane cosines;
+	SinCosDegreesLanes(TrigOps::Load(padded), sines, cosines);
+	TrigOps::Store(paddedSines, sines);
+	TrigOps::Store(paddedCosines, cosines);
+	for(int lane = 0; index + lane < count; ++lane)
+	{
+		out_sines[index + lane] = paddedSines[lane];
+		out_cosines[index + lane] = paddedCosines[lane];
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void ATan2DegreesBatch(int count, float const* ys, float const* xs, float* out_degrees)
+{
+	int index = 0;
+	for(; index + TRIG_LANES <= count; index += TRIG_LANES)
+	{
+		TrigOps::Store(out_degrees + index, ATan2DegreesLanes(TrigOps::Load(ys + index), TrigOps::Load(xs + index)));
+	}
+
+	if(index == count)
+	{
+		return;
+	}
+
+	float paddedYs[TRIG_LANES] = {};
+	float paddedXs[TRIG_LANES] = {};
+	float paddedDegrees[TRIG_LANES];
+	for(int lane = 0; index + lane < count; ++lane)
+	{
+		paddedYs[lane] = ys[index + lane];
+		paddedXs[lane] = xs[index + lane];
+	}
+
+	TrigOps::Store(paddedDegrees, ATan2DegreesLanes(TrigOps::Load(paddedYs), TrigOps::Load(paddedXs)));
+	for(int lane = 0; index + lane < count; ++lane)
+	{
+		out_degrees[index + lane] = paddedDegrees[lane];
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+//------------------------------------------------------------------------------------------------------------------
+// Polynomial sine, cosine and arctangent in degrees, for loops that build geometry or rotations from many angles.
+//
+// Sine and cosine reduce the angle by the nearest multiple of 90 degrees, which is exact in floats, then evaluate
+// minimax polynomials on [-45, 45]. Arctangent folds the ratio into [-tan(22.5), tan(22.5)] and does the same.
+// Measured maximum errors against double-precision libm:
+//	FastSinDegrees / FastCosDegrees		9.5e-8 absolute, at any angle up to a few million degrees
+//	FastATan2Degrees					1.3e-5 degrees, about one float ulp of 180
+// Near zero that is a little looser than libm; past a turn or two it is tighter than the precise versions, which
+// round pi to 3.1415926f before converting.
+// Define ENGINE_FAST_TRIG in EngineBuildPreferences.hpp to make those MathUtils functions use these.
+//
+// The batch versions run the same polynomials 8 lanes wide on AVX2 builds (4 otherwise) and handle the remainder as a
+// zero-padded group, so every element of a batch is computed the same way. They match the scalar functions exactly
+// except on FMA builds, where the fused multiply-adds can differ in the last bit.
+//------------------------------------------------------------------------------------------------------------------
+float	FastSinDegrees(float degrees);
+float	FastCosDegrees(float degrees);
+void	FastSinCosDegrees(float degrees, float& out_sine, float& out_cosine);
+float	FastATan2Degrees(float y, float x);
+
+void	SinCosDegreesBatch(int count, float const* degrees, float* out_sines, float* out_cosines);
+void	ATan2DegreesBatch(int count, float const* ys, float const* xs, float* out_degrees);
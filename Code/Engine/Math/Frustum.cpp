@@ -0,0 +1,477 @@
+#include "Engine/Math/Frustum.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/Vec4.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/OBB3.hpp"
+#include "Engine/Math/Sphere.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/SIMDUtils.hpp"
+#include "Engine/Math/Vec3xN.hpp"
+#include "Engine/JobSystem/JobSystem.hpp"
+#include "Engine/JobSystem/Job.hpp"
+
+#include <math.h>
+
+//------------------------------------------------------------------------------------------------------------------
+// Below this many shapes per range, handing ranges to workers costs more than it saves.
+constexpr int MIN_SHAPES_PER_CULL_JOB = 16384;
+
+//------------------------------------------------------------------------------------------------------------------
+// Row r of the clip transform dotted with (x, y, z, 1) is clip component r. A clip-space bound like x >= -w becomes
+// (rowW + rowX) . p >= 0, which is a plane with normal (a, b, c) at distance -d once normalized.
+static Plane3 MakeFrustumPlane(Vec4 const& coefficients)
+{
+	Vec3 normal(coefficients.x, coefficients.y, coefficients.z);
+	float invLength = 1.f / normal.GetLength();
+
+	Plane3 plane;
+	plane.m_normal = normal * invLength;
+	plane.m_distanceFromOrigin = -coefficients.w * invLength;
+	return plane;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// D3D clip space: -w <= x <= w, -w <= y <= w, 0 <= z <= w.
+Frustum Frustum::MakeFromWorldToClip(Mat44 const& worldToClip)
+{
+	float const* values = worldToClip.GetAsFloatArray();
+	Vec4 rowX(values[Mat44::Ix], values[Mat44::Jx], values[Mat44::Kx], values[Mat44::Tx]);
+	Vec4 rowY(values[Mat44::Iy], values[Mat44::Jy], values[Mat44::Ky], values[Mat44::Ty]);
+	Vec4 rowZ(values[Mat44::Iz], values[Mat44::Jz], values[Mat44::Kz], values[Mat44::Tz]);
+	Vec4 rowW(values[Mat44::Iw], values[Mat44::Jw], values[Mat44::Kw], values[Mat44::Tw]);
+
+	Frustum frustum;
+	frustum.m_planes[FRUSTUM_PLANE_LEFT] = MakeFrustumPlane(rowW + rowX);
+	frustum.m_planes[FRUSTUM_PLANE_RIGHT] = MakeFrustumPlane(rowW - rowX);
+	frustum.m_planes[FRUSTUM_PLANE_BOTTOM] = MakeFrustumPlane(rowW + rowY);
+	frustum.m_planes[FRUSTUM_PLANE_TOP] = MakeFrustumPlane(rowW - rowY);
+	frustum.m_planes[FRUSTUM_PLANE_NEAR] = MakeFrustumPlane(rowZ);
+	frustum.m_planes[FRUSTUM_PLANE_FAR] = MakeFrustumPlane(rowW - rowZ);
+
+	for(int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES; ++planeIndex)
+	{
+		Vec3 const& normal = frustum.m_planes[planeIndex].m_normal;
+		frustum.m_planeOctants[planeIndex] = static_cast<unsigned char>((normal.x >= 0.f ? 1 : 0) | (normal.y >= 0.f ? 2 : 0) | (normal.z >= 0.f ? 4 : 0));
+	}
+
+	return frustum;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Per-shape plane tests. Each returns true if the shape lies entirely on the outside of the plane.
+//------------------------------------------------------------------------------------------------------------------
+static bool IsSphereOutsidePlane(Frustum const& frustum, int planeIndex, Sphere const& sphere)
+{
+	return frustum.m_planes[planeIndex].GetAltitudeFromPoint(sphere.m_center) < -sphere.m_radius;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static bool IsAABB3OutsidePlane(Frustum const& frustum, int planeIndex, AABB3 const& box)
+{
+	unsigned char octant = frustum.m_planeOctants[planeIndex];
+	Vec3 furthestCorner((octant & 1) ? box.m_maxs.x : box.m_mins.x, (octant & 2) ? box.m_maxs.y : box.m_mins.y, (octant & 4) ? box.m_maxs.z : box.m_mins.z);
+	return frustum.m_planes[planeIndex].GetAltitudeFromPoint(furthestCorner) < 0.f;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static bool IsOBB3OutsidePlane(Frustum const& frustum, int planeIndex, OBB3 const& obb)
+{
+	Plane3 const& plane = frustum.m_planes[planeIndex];
+	Vec3 kBasis = CrossProduct3D(obb.m_iBasis, obb.m_jBasis);
+	float projectedRadius = obb.m_halfDimensions.x * fabsf(DotProduct3D(plane.m_normal, obb.m_iBasis)) +
+							obb.m_halfDimensions.y * fabsf(DotProduct3D(plane.m_normal, obb.m_jBasis)) +
+							obb.m_halfDimensions.z * fabsf(DotProduct3D(plane.m_normal, kBasis));
+	return plane.GetAltitudeFromPoint(obb.m_center) < -projectedRadius;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool Frustum::IsPointInside(Vec3 const& point) const
+{
+	for(int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES; ++planeIndex)
+	{
+		if(m_planes[planeIndex].GetAltitudeFromPoint(point) < 0.f)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool Frustum::IsSphereVisible(Sphere const& sphere) const
+{
+	for(int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES; ++planeIndex)
+	{
+		if(IsSphereOutsidePlane(*this, planeIndex, sphere))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool Frustum::IsAABB3Visible(AABB3 const& box) const
+{
+	for(int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES; ++planeIndex)
+	{
+		if(IsAABB3OutsidePlane(*this, planeIndex, box))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool Frustum::IsOBB3Visible(OBB3 const& obb) const
+{
+	for(int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES; ++planeIndex)
+	{
+		if(IsOBB3OutsidePlane(*this, planeIndex, obb))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool Frustum::IsSphereVisible(Sphere const& sphere, unsigned char& inout_lastFailedPlane) const
+{
+	if(IsSphereOutsidePlane(*this, inout_lastFailedPlane, sphere))
+	{
+		return false;
+	}
+
+	for(int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES; ++planeIndex)
+	{
+		if(planeIndex != inout_lastFailedPlane && IsSphereOutsidePlane(*this, planeIndex, sphere))
+		{
+			inout_lastFailedPlane = static_cast<unsigned char>(planeIndex);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool Frustum::IsAABB3Visible(AABB3 const& box, unsigned char& inout_lastFailedPlane) const
+{
+	if(IsAABB3OutsidePlane(*this, inout_lastFailedPlane, box))
+	{
+		return false;
+	}
+
+	for(int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES; ++planeIndex)
+	{
+		if(planeIndex != inout_lastFailedPlane && IsAABB3OutsidePlane(*this, planeIndex, box))
+		{
+			inout_lastFailedPlane = static_cast<unsigned char>(planeIndex);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool Frustum::IsOBB3Visible(OBB3 const& obb, unsigned char& inout_lastFailedPlane) const
+{
+	if(IsOBB3OutsidePlane(*this, inout_lastFailedPlane, obb))
+	{
+		return false;
+	}
+
+	for(int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES; ++planeIndex)
+	{
+		if(planeIndex != inout_lastFailedPlane && IsOBB3OutsidePlane(*this, planeIndex, obb))
+		{
+			inout_lastFailedPlane = static_cast<unsigned char>(planeIndex);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Batch culling
+//------------------------------------------------------------------------------------------------------------------
+#if defined(ENGINE_SIMD_AVX2)
+typedef Float8Ops CullOps;
+#else
+typedef Float4Ops CullOps;
+#endif
+
+typedef CullOps::Type			CullLane;
+typedef Vec3xN<CullOps>			CullVec3Lanes;
+
+constexpr int CULL_LANES = CullOps::WIDTH;
+
+//------------------------------------------------------------------------------------------------------------------
+// One frustum plane splatted across the lanes.
+struct CullPlaneLanes
+{
+	CullVec3Lanes	m_normal;
+	CullVec3Lanes	m_absNormal;
+	CullLane		m_distance;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+static CullPlaneLanes SplatCullPlane(Plane3 const& plane)
+{
+	CullPlaneLanes lanes;
+	lanes.m_normal = CullVec3Lanes(plane.m_normal);
+	lanes.m_absNormal = CullVec3Lanes(Vec3(fabsf(plane.m_normal.x), fabsf(plane.m_normal.y), fabsf(plane.m_normal.z)));
+	lanes.m_distance = CullOps::Splat(plane.m_distanceFromOrigin);
+	return lanes;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Loads lanes [first, first + numLanes) of parallel arrays, zero-padding a partial group.
+static void LoadCullLanes(int first, int numLanes, int numArrays, float const* const* arrays, CullLane* out_lanes)
+{
+	for(int arrayIndex = 0; arrayIndex < numArrays; ++arrayIndex)
+	{
+		if(numLanes == CULL_LANES)
+		{
+			out_lanes[arrayIndex] = CullOps::Load(arrays[arrayIndex] + first);
+			continue;
+		}
+
+		float padded[CULL_LANES] = {};
+		for(int lane = 0; lane < numLanes; ++lane)
+		{
+			padded[lane] = arrays[arrayIndex][first + lane];
+		}
+		out_lanes[arrayIndex] = CullOps::Load(padded);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Shape groups. GetMaxAltitude is the altitude of the point of each shape furthest along the plane normal; the shape
+// is outside the plane when that is negative.
+//------------------------------------------------------------------------------------------------------------------
+struct SphereCullLanes
+{
+	typedef SphereSoA Source;
+
+	CullVec3Lanes	m_center;
+	CullLane		m_radius;
+
+	SphereCullLanes(SphereSoA const& spheres, int first, int numLanes)
+	{
+		float const* arrays[4] = { spheres.m_centerX, spheres.m_centerY, spheres.m_centerZ, spheres.m_radius };
+		CullLane lanes[4];
+		LoadCullLanes(first, numLanes, 4, arrays, lanes);
+
+		m_center = CullVec3Lanes(lanes[0], lanes[1], lanes[2]);
+		m_radius = lanes[3];
+	}
+
+	CullLane GetMaxAltitude(CullPlaneLanes const& plane) const
+	{
+		return CullOps::Add(CullOps::Sub(DotProduct3D(plane.m_normal, m_center), plane.m_distance), m_radius);
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct AABB3CullLanes
+{
+	typedef AABB3SoA Source;
+
+	CullVec3Lanes	m_center;
+	CullVec3Lanes	m_halfExtents;
+
+	AABB3CullLanes(AABB3SoA const& boxes, int first, int numLanes)
+	{
+		float const* arrays[6] = { boxes.m_minX, boxes.m_minY, boxes.m_minZ, boxes.m_maxX, boxes.m_maxY, boxes.m_maxZ };
+		CullLane lanes[6];
+		LoadCullLanes(first, numLanes, 6, arrays, lanes);
+
+		CullVec3Lanes mins(lanes[0], lanes[1], lanes[2]);
+		CullVec3Lanes maxs(lanes[3], lanes[4], lanes[5]);
+		m_center = (mins + maxs) * 0.5f;
+		m_halfExtents = (maxs - mins) * 0.5f;
+	}
+
+	// center/extent form of picking the corner by normal octant: the extents weighted by |n| reach that corner
+	CullLane GetMaxAltitude(CullPlaneLanes const& plane) const
+	{
+		return CullOps::Add(CullOps::Sub(DotProduct3D(plane.m_normal, m_center), plane.m_distance), DotProduct3D(plane.m_absNormal, m_halfExtents));
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct OBB3CullLanes
+{
+	typedef OBB3SoA Source;
+
+	CullVec3Lanes	m_center;
+	CullVec3Lanes	m_iBasis;
+	CullVec3Lanes	m_jBasis;
+	CullVec3Lanes	m_kBasis;
+	CullVec3Lanes	m_halfDimensions;
+
+	OBB3CullLanes(OBB3SoA const& obbs, int first, int numLanes)
+	{
+		float const* arrays[12] = { obbs.m_centerX, obbs.m_centerY, obbs.m_centerZ, obbs.m_iBasisX, obbs.m_iBasisY, obbs.m_iBasisZ,
+									obbs.m_jBasisX, obbs.m_jBasisY, obbs.m_jBasisZ, obbs.m_halfDimX, obbs.m_halfDimY, obbs.m_halfDimZ };
+		CullLane lanes[12];
+		LoadCullLanes(first, numLanes, 12, arrays, lanes);
+
+		m_center = CullVec3Lanes(lanes[0], lanes[1], lanes[2]);
+		m_iBasis = CullVec3Lanes(lanes[3], lanes[4], lanes[5]);
+		m_jBasis = CullVec3Lanes(lanes[6], lanes[7], lanes[8]);
+		m_kBasis = CrossProduct3D(m_iBasis, m_jBasis);
+		m_halfDimensions = CullVec3Lanes(lanes[9], lanes[10], lanes[11]);
+	}
+
+	CullLane GetMaxAltitude(CullPlaneLanes const& plane) const
+	{
+		CullLane zero = CullOps::Zero();
+		CullLane alongI = DotProduct3D(plane.m_normal, m_iBasis);
+		CullLane alongJ = DotProduct3D(plane.m_normal, m_jBasis);
+		CullLane alongK = DotProduct3D(plane.m_normal, m_kBasis);
+		CullVec3Lanes absAlong(CullOps::Max(alongI, CullOps::Sub(zero, alongI)), CullOps::Max(alongJ, CullOps::Sub(zero, alongJ)), CullOps::Max(alongK, CullOps::Sub(zero, alongK)));
+
+		return CullOps::Add(CullOps::Sub(DotProduct3D(plane.m_normal, m_center), plane.m_distance), DotProduct3D(absAlong, m_halfDimensions));
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Culls shapes [start, end) and writes the survivors' indexes to out_visibleIndexes. Returns how many it wrote.
+template<typename ShapeLanes>
+static int CullShapeRange(CullPlaneLanes const* planes, typename ShapeLanes::Source const& shapes, int start, int end,
+						  int* out_visibleIndexes)
+{
+	CullLane zero = CullOps::Zero();
+	int numVisible = 0;
+
+	for(int first = start; first < end; first += CULL_LANES)
+	{
+		int numLanes = end - first < CULL_LANES ? end - first : CULL_LANES;
+		int validBits = (1 << numLanes) - 1;
+		ShapeLanes shapeLanes(shapes, first, numLanes);
+
+		int outsideBits = 0;
+		for(int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES && outsideBits != validBits; ++planeIndex)
+		{
+			outsideBits |= CullOps::GetMaskBits(CullOps::CmpLt(shapeLanes.GetMaxAltitude(planes[planeIndex]), zero)) & validBits;
+		}
+
+		int visibleBits = validBits & ~outsideBits;
+		for(int lane = 0; lane < numLanes; ++lane)
+		{
+			if(visibleBits & (1 << lane))
+			{
+				out_visibleIndexes[numVisible++] = first + lane;
+			}
+		}
+	}
+
+	return numVisible;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename ShapeLanes>
+class FrustumCullJob : public Job
+{
+public:
+	virtual void Execute() override
+	{
+		m_numVisible = CullShapeRange<ShapeLanes>(m_planes, *m_shapes, m_start, m_end, m_visibleIndexes);
+	}
+
+public:
+	CullPlaneLanes const*					m_planes = nullptr;
+	typename ShapeLanes::Source const*		m_shapes = nullptr;
+	int										m_start = 0;
+	int										m_end = 0;
+	int*									m_visibleIndexes = nullptr;
+	int										m_numVisible = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Each range writes its survivors at its own start offset in out_visibleIndexes, then the ranges are slid down in
+// order, so the result stays sorted without a merge. The calling thread culls the first range itself and takes back
+// any range no worker has picked up yet, the same as the batch vertex transforms.
+template<typename ShapeLanes>
+static int DispatchFrustumCull(Frustum const& frustum, typename ShapeLanes::Source const& shapes, std::vector<int>& out_visibleIndexes, JobSystem* jobSystem)
+{
+	int numShapes = shapes.m_count;
+	out_visibleIndexes.resize(numShapes);
+	if(numShapes == 0)
+	{
+		return 0;
+	}
+
+	CullPlaneLanes planes[NUM_FRUSTUM_PLANES];
+	for(int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES; ++planeIndex)
+	{
+		planes[planeIndex] = SplatCullPlane(frustum.m_planes[planeIndex]);
+	}
+
+	// ranges start on a lane-group boundary so no two ranges share a group
+	std::vector<int> rangeStarts;
+	SplitIntoJobRanges(0, numShapes, MIN_SHAPES_PER_CULL_JOB, jobSystem, rangeStarts, CULL_LANES);
+
+	int numRanges = static_cast<int>(rangeStarts.size()) - 1;
+	if(numRanges == 1)
+	{
+		int numVisible = CullShapeRange<ShapeLanes>(planes, shapes, 0, numShapes, out_visibleIndexes.data());
+		out_visibleIndexes.resize(numVisible);
+		return numVisible;
+	}
+
+	std::vector<FrustumCullJob<ShapeLanes>> jobs(numRanges);
+	for(int rangeIndex = 0; rangeIndex < numRanges; ++rangeIndex)
+	{
+		FrustumCullJob<ShapeLanes>& job = jobs[rangeIndex];
+		job.m_planes = planes;
+		job.m_shapes = &shapes;
+		job.m_start = rangeStarts[rangeIndex];
+		job.m_end = rangeStarts[rangeIndex + 1];
+		job.m_visibleIndexes = out_visibleIndexes.data() + job.m_start;
+	}
+
+	jobSystem->ExecuteJobsAndWait(jobs);
+
+	// the first range is already in place
+	int numVisible = jobs[0].m_numVisible;
+	for(int jobIndex = 1; jobIndex < static_cast<int>(jobs.size()); ++jobIndex)
+	{
+		FrustumCullJob<ShapeLanes> const& job = jobs[jobIndex];
+		for(int visibleIndex = 0; visibleIndex < job.m_numVisible; ++visibleIndex)
+		{
+			out_visibleIndexes[numVisible++] = job.m_visibleIndexes[visibleIndex];
+		}
+	}
+
+	out_visibleIndexes.resize(numVisible);
+	return numVisible;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int CullSpheresToFrustum(Frustum const& frustum, SphereSoA const& spheres, std::vector<int>& out_visibleIndexes, JobSystem* jobSystem)
+{
+	return DispatchFrustumCull<SphereCullLanes>(frustum, spheres, out_visibleIndexes, jobSystem);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int CullAABB3sToFrustum(Frustum const& frustum, AABB3SoA const& boxes, std::vector<int>& out_visibleIndexes, JobSystem* jobSystem)
+{
+	return DispatchFrustumCull<AABB3CullLanes>(frustum, boxes, out_visibleIndexes, jobSystem);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int CullOBB3sToFrustum(Frustum const& frustum, OBB3SoA const& obbs, std::vector<int>& out_visibleIndexes, JobSystem* jobSystem)
+{
+	return DispatchFrustumCull<OBB3CullLanes>(frustum, obbs, out_visibleIndexes, jobSystem);
+}
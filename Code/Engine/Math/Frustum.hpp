@@ -0,0 +1,86 @@
+#pragma once
+#include "Engine/Math/Plane3.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
+
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------
+struct Mat44;
+struct AABB3;
+struct OBB3;
+struct Sphere;
+class JobSystem;
+
+//------------------------------------------------------------------------------------------------------------------
+enum FrustumPlane
+{
+	FRUSTUM_PLANE_LEFT,
+	FRUSTUM_PLANE_RIGHT,
+	FRUSTUM_PLANE_BOTTOM,
+	FRUSTUM_PLANE_TOP,
+	FRUSTUM_PLANE_NEAR,
+	FRUSTUM_PLANE_FAR,
+
+	NUM_FRUSTUM_PLANES
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Six world-space planes with unit normals pointing into the view volume, so a point is inside when its altitude
+// above every plane is zero or more. Works for perspective and orthographic cameras alike.
+//
+// The shape tests are conservative: anything reported invisible is certainly off screen, but a shape just outside a
+// frustum corner can still pass. That is the usual trade for six dot products per shape.
+//
+// The lastFailedPlane overloads start with the plane that rejected the shape last frame. Most culled objects are still
+// behind the same plane a frame later, so they cost one plane test instead of up to six. Start the values at 0.
+//------------------------------------------------------------------------------------------------------------------
+struct Frustum
+{
+public:
+	static Frustum	MakeFromWorldToClip(Mat44 const& worldToClip);
+
+	bool	IsPointInside(Vec3 const& point) const;
+	bool	IsSphereVisible(Sphere const& sphere) const;
+	bool	IsAABB3Visible(AABB3 const& box) const;
+	bool	IsOBB3Visible(OBB3 const& obb) const;
+
+	bool	IsSphereVisible(Sphere const& sphere, unsigned char& inout_lastFailedPlane) const;
+	bool	IsAABB3Visible(AABB3 const& box, unsigned char& inout_lastFailedPlane) const;
+	bool	IsOBB3Visible(OBB3 const& obb, unsigned char& inout_lastFailedPlane) const;
+
+public:
+	Plane3			m_planes[NUM_FRUSTUM_PLANES];
+	unsigned char	m_planeOctants[NUM_FRUSTUM_PLANES] = {};	// bit 0/1/2 set where the normal's x/y/z is not negative;
+																// picks the box corner furthest along the normal
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct OBB3SoA
+{
+	int				m_count = 0;
+	float const*	m_centerX = nullptr;
+	float const*	m_centerY = nullptr;
+	float const*	m_centerZ = nullptr;
+	float const*	m_iBasisX = nullptr;
+	float const*	m_iBasisY = nullptr;
+	float const*	m_iBasisZ = nullptr;
+	float const*	m_jBasisX = nullptr;
+	float const*	m_jBasisY = nullptr;
+	float const*	m_jBasisZ = nullptr;
+	float const*	m_halfDimX = nullptr;
+	float const*	m_halfDimY = nullptr;
+	float const*	m_halfDimZ = nullptr;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Batch culling over caller-owned SoA bounds, 8 shapes per iteration on AVX2 builds (4 otherwise). out_visibleIndexes
+// is overwritten with the indexes of the shapes that pass, in ascending order; the return value is their count.
+//
+// A group stops testing planes as soon as all of its shapes are culled. There is no per-shape remembered plane here:
+// reading and writing it per lane cost more than the plane tests it skipped.
+//
+// With a JobSystem, sets above a few tens of thousands of shapes are split into ranges culled on the workers.
+//------------------------------------------------------------------------------------------------------------------
+int CullSpheresToFrustum(Frustum const& frustum, SphereSoA const& spheres, std::vector<int>& out_visibleIndexes, JobSystem* jobSystem = nullptr);
+int CullAABB3sToFrustum(Frustum const& frustum, AABB3SoA const& boxes, std::vector<int>& out_visibleIndexes, JobSystem* jobSystem = nullptr);
+int CullOBB3sToFrustum(Frustum const& frustum, OBB3SoA const& obbs, std::vector<int>& out_visibleIndexes, JobSystem* jobSystem = nullptr);
@@ -4,6 +4,9 @@
 #include "Engine/Math/Vec4.hpp"
 #include "Engine/Math/EulerAngles.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/SIMDUtils.hpp"
+
+#include <math.h>
 
 //------------------------------------------------------------------------------------------------------------------
 Mat44::Mat44()
@@ -478,7 +481,7 @@ void const Mat44::GetIJKT3D(Vec3& iBasis3D, Vec3& jBasis3D, Vec3& kBasis3D, Vec3
 }
 
 //------------------------------------------------------------------------------------------------------------------
-Mat44 const Mat44::GetOrthonormalInverse() const
+Mat44 const Mat44::GetOrthonormalInverse_Scalar() const
 {
 
 	Vec3 iBasis = Vec3(m_values[Ix], m_values[Jx], m_values[Kx]);
@@ -496,7 +499,7 @@ Mat44 const Mat44::GetOrthonormalInverse() const
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
-Mat44 const Mat44::GetInverse() const
+Mat44 const Mat44::GetInverse_Scalar() const
 {
 	float detIJy = m_values[Jy] * ((m_values[Kz] * m_values[Tw]) - (m_values[Tz] * m_values[Kw]));
 	float detIKy = m_values[Ky] * ((m_values[Jz] * m_values[Tw]) - (m_values[Tz] * m_values[Jw]));
@@ -521,7 +524,7 @@ Mat44 const Mat44::GetInverse() const
 	float detTKy = m_values[Ky] * ((m_values[Iz] * m_values[Jw]) - (m_values[Jz] * m_values[Iw]));
 	float detTx = detTIy - detTJy + detTKy;
 
-	float det4x4 = detIx - detJx + detKx - detTx;
+	float det4x4 = m_values[Ix] * detIx - m_values[Jx] * detJx + m_values[Kx] * detKx - m_values[Tx] * detTx;
 
 	if(fabs(det4x4) < 1e-8f)
 	{
@@ -573,6 +576,39 @@ Mat44 const Mat44::GetInverse() const
 }
 
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+Mat44 const Mat44::GetAffineInverse_Scalar() const
+{
+	Vec3 iBasis = GetIBasis3D();
+	Vec3 jBasis = GetJBasis3D();
+	Vec3 kBasis = GetKBasis3D();
+
+	// rows of the inverse 3x3 are the cross products of the basis pairs over the determinant
+	Vec3 row0 = CrossProduct3D(jBasis, kBasis);
+	Vec3 row1 = CrossProduct3D(kBasis, iBasis);
+	Vec3 row2 = CrossProduct3D(iBasis, jBasis);
+
+	float det = DotProduct3D(iBasis, row0);
+
+	if(fabsf(det) < 1e-8f)
+	{
+		return Mat44();
+	}
+
+	float invDet = 1.f / det;
+	row0 *= invDet;
+	row1 *= invDet;
+	row2 *= invDet;
+
+	Vec3 translation = GetTranslation3D();
+
+	Mat44 inverseMat;
+	inverseMat.SetIJKT3D(Vec3(row0.x, row1.x, row2.x), Vec3(row0.y, row1.y, row2.y), Vec3(row0.z, row1.z, row2.z),
+						 -Vec3(DotProduct3D(row0, translation), DotProduct3D(row1, translation), DotProduct3D(row2, translation)));
+
+	return inverseMat;
+}
+
 //------------------------------------------------------------------------------------------------------------------
 void Mat44::SetTranslation2D(Vec2 const& translation2D)
 {
@@ -715,7 +751,19 @@ void Mat44::SetIJKT4D(Vec4 const& iBasis4D, Vec4 const& jBasis4D, Vec4 const& kB
 //------------------------------------------------------------------------------------------------------------------
 void Mat44::Transpose()
 {
-
+#if defined(ENGINE_SIMD_FLOAT4)
+	Float4 iBasis = Float4LoadUnaligned(&m_values[Ix]);
+	Float4 jBasis = Float4LoadUnaligned(&m_values[Jx]);
+	Float4 kBasis = Float4LoadUnaligned(&m_values[Kx]);
+	Float4 translation = Float4LoadUnaligned(&m_values[Tx]);
+
+	Float4Transpose(iBasis, jBasis, kBasis, translation);
+
+	Float4StoreUnaligned(&m_values[Ix], iBasis);
+	Float4StoreUnaligned(&m_values[Jx], jBasis);
+	Float4StoreUnaligned(&m_values[Kx], kBasis);
+	Float4StoreUnaligned(&m_values[Tx], translation);
+#else
 	float tempArray[NUM_INDEXES];
 
 	for(int index = 0; index < NUM_INDEXES; ++index)
@@ -742,11 +790,11 @@ void Mat44::Transpose()
 	m_values[Ty] = tempArray[Jw];
 	m_values[Tz] = tempArray[Kw];
 	m_values[Tw] = tempArray[Tw];
-
+#endif
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
-Mat44 Mat44::GetTranspose() const
+Mat44 Mat44::GetTranspose_Scalar() const
 {
 	float transpose[NUM_INDEXES];
 
@@ -821,7 +869,7 @@ Vec2 const Mat44::TransformVectorQuantity2D(Vec2 const& vectorQuantityXY) const
 
 
 //------------------------------------------------------------------------------------------------------------------
-Vec3 const Mat44::TransformVectorQuantity3D(Vec3 const& vectorQuantityXYZ) const
+Vec3 const Mat44::TransformVectorQuantity3D_Scalar(Vec3 const& vectorQuantityXYZ) const
 {
 	float x = (m_values[Ix] * vectorQuantityXYZ.x) + (m_values[Jx] * vectorQuantityXYZ.y) + (m_values[Kx] * vectorQuantityXYZ.z);
 	float y = (m_values[Iy] * vectorQuantityXYZ.x) + (m_values[Jy] * vectorQuantityXYZ.y) + (m_values[Ky] * vectorQuantityXYZ.z);
@@ -843,7 +891,7 @@ Vec2 const Mat44::TransformPosition2D(Vec2 const& positionXY) const
 
 
 //------------------------------------------------------------------------------------------------------------------
-Vec3 const Mat44::TransformPosition3D(Vec3 const positionXYZ) const
+Vec3 const Mat44::TransformPosition3D_Scalar(Vec3 const positionXYZ) const
 {
 	float x = (m_values[Ix] * positionXYZ.x) + (m_values[Jx] * positionXYZ.y) + (m_values[Kx] * positionXYZ.z) + m_values[Tx];
 	float y = (m_values[Iy] * positionXYZ.x) + (m_values[Jy] * positionXYZ.y) + (m_values[Ky] * positionXYZ.z) + m_values[Ty];
@@ -854,7 +902,7 @@ Vec3 const Mat44::TransformPosition3D(Vec3 const positionXYZ) const
 
 
 //------------------------------------------------------------------------------------------------------------------
-Vec4 const Mat44::TransformHomogeneous3D(Vec4 const& homogenousPoint3D) const
+Vec4 const Mat44::TransformHomogeneous3D_Scalar(Vec4 const& homogenousPoint3D) const
 {
 	float x = (m_values[Ix] * homogenousPoint3D.x) + (m_values[Jx] * homogenousPoint3D.y) + (m_values[Kx] * homogenousPoint3D.z) + (m_values[Tx] * homogenousPoint3D.w);
 	float y = (m_values[Iy] * homogenousPoint3D.x) + (m_values[Jy] * homogenousPoint3D.y) + (m_values[Ky] * homogenousPoint3D.z) + (m_values[Ty] * homogenousPoint3D.w);
@@ -866,8 +914,14 @@ Vec4 const Mat44::TransformHomogeneous3D(Vec4 const& homogenousPoint3D) const
 
 
 //------------------------------------------------------------------------------------------------------------------
-void Mat44::Append(Mat44 const& appendThis)
+void Mat44::Append_Scalar(Mat44 const& appendThis)
 {
+	if(&appendThis == this)
+	{
+		Mat44 const appendCopy = appendThis;
+		Append_Scalar(appendCopy);
+		return;
+	}
 
 
 	Mat44 copyMatrix = Mat44(m_values);
@@ -1047,3 +1101,263 @@ bool Mat44::operator!=(Mat44 const& compare) const
 
 
 
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// SIMD kernels. Each column (I, J, K, T) is one Float4; without SIMD every call falls back to its _Scalar twin.
+// Mat44 has no alignment requirement, so it packs into Camera and other structs without padding, and columns load unaligned.
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+#if defined(ENGINE_SIMD_FLOAT4)
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static inline Float4 TransformFloat4(Float4 iBasis, Float4 jBasis, Float4 kBasis, Float4 translation, Float4 v)
+{
+	Float4 result = Float4Mul(iBasis, Float4SplatLane<0>(v));
+	result = Float4MulAdd(jBasis, Float4SplatLane<1>(v), result);
+	result = Float4MulAdd(kBasis, Float4SplatLane<2>(v), result);
+	result = Float4MulAdd(translation, Float4SplatLane<3>(v), result);
+
+	return result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// 2x2 blocks packed as (m00, m01, m10, m11)
+static inline Float4 Mat2Mul(Float4 a, Float4 b)
+{
+	return Float4Add(Float4Mul(a, Float4Swizzle<0, 3, 0, 3>(b)), Float4Mul(Float4Swizzle<1, 0, 3, 2>(a), Float4Swizzle<2, 1, 2, 1>(b)));
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// adjugate(a) * b
+static inline Float4 Mat2AdjMul(Float4 a, Float4 b)
+{
+	return Float4Sub(Float4Mul(Float4Swizzle<3, 3, 0, 0>(a), b), Float4Mul(Float4Swizzle<1, 1, 2, 2>(a), Float4Swizzle<2, 3, 0, 1>(b)));
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// a * adjugate(b)
+static inline Float4 Mat2MulAdj(Float4 a, Float4 b)
+{
+	return Float4Sub(Float4Mul(a, Float4Swizzle<3, 0, 3, 0>(b)), Float4Mul(Float4Swizzle<1, 0, 3, 2>(a), Float4Swizzle<2, 1, 2, 1>(b)));
+}
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Mat44::Append(Mat44 const& appendThis)
+{
+#if defined(ENGINE_SIMD_FLOAT4)
+	Float4 iBasis = Float4LoadUnaligned(&m_values[Ix]);
+	Float4 jBasis = Float4LoadUnaligned(&m_values[Jx]);
+	Float4 kBasis = Float4LoadUnaligned(&m_values[Kx]);
+	Float4 translation = Float4LoadUnaligned(&m_values[Tx]);
+
+	Float4 appendI = Float4LoadUnaligned(&appendThis.m_values[Ix]);
+	Float4 appendJ = Float4LoadUnaligned(&appendThis.m_values[Jx]);
+	Float4 appendK = Float4LoadUnaligned(&appendThis.m_values[Kx]);
+	Float4 appendT = Float4LoadUnaligned(&appendThis.m_values[Tx]);
+
+	// appendThis may alias this, so every column is loaded before any store
+	Float4StoreUnaligned(&m_values[Ix], TransformFloat4(iBasis, jBasis, kBasis, translation, appendI));
+	Float4StoreUnaligned(&m_values[Jx], TransformFloat4(iBasis, jBasis, kBasis, translation, appendJ));
+	Float4StoreUnaligned(&m_values[Kx], TransformFloat4(iBasis, jBasis, kBasis, translation, appendK));
+	Float4StoreUnaligned(&m_values[Tx], TransformFloat4(iBasis, jBasis, kBasis, translation, appendT));
+#else
+	Append_Scalar(appendThis);
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+Vec3 const Mat44::TransformVectorQuantity3D(Vec3 const& vectorQuantityXYZ) const
+{
+#if defined(ENGINE_SIMD_FLOAT4)
+	Float4 result = Float4Mul(Float4LoadUnaligned(&m_values[Ix]), Float4Splat(vectorQuantityXYZ.x));
+	result = Float4MulAdd(Float4LoadUnaligned(&m_values[Jx]), Float4Splat(vectorQuantityXYZ.y), result);
+	result = Float4MulAdd(Float4LoadUnaligned(&m_values[Kx]), Float4Splat(vectorQuantityXYZ.z), result);
+
+	return Vec3(Float4GetLane<0>(result), Float4GetLane<1>(result), Float4GetLane<2>(result));
+#else
+	return TransformVectorQuantity3D_Scalar(vectorQuantityXYZ);
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+Vec3 const Mat44::TransformPosition3D(Vec3 const positionXYZ) const
+{
+#if defined(ENGINE_SIMD_FLOAT4)
+	Float4 result = Float4MulAdd(Float4LoadUnaligned(&m_values[Ix]), Float4Splat(positionXYZ.x), Float4LoadUnaligned(&m_values[Tx]));
+	result = Float4MulAdd(Float4LoadUnaligned(&m_values[Jx]), Float4Splat(positionXYZ.y), result);
+	result = Float4MulAdd(Float4LoadUnaligned(&m_values[Kx]), Float4Splat(positionXYZ.z), result);
+
+	return Vec3(Float4GetLane<0>(result), Float4GetLane<1>(result), Float4GetLane<2>(result));
+#else
+	return TransformPosition3D_Scalar(positionXYZ);
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+Vec4 const Mat44::TransformHomogeneous3D(Vec4 const& homogenousPoint3D) const
+{
+#if defined(ENGINE_SIMD_FLOAT4)
+	Float4 point = Float4Set(homogenousPoint3D.x, homogenousPoint3D.y, homogenousPoint3D.z, homogenousPoint3D.w);
+	Float4 result = TransformFloat4(Float4LoadUnaligned(&m_values[Ix]), Float4LoadUnaligned(&m_values[Jx]), Float4LoadUnaligned(&m_values[Kx]), Float4LoadUnaligned(&m_values[Tx]), point);
+
+	alignas(16) float resultValues[4];
+	Float4Store(resultValues, result);
+
+	return Vec4(resultValues[0], resultValues[1], resultValues[2], resultValues[3]);
+#else
+	return TransformHomogeneous3D_Scalar(homogenousPoint3D);
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+Mat44 Mat44::GetTranspose() const
+{
+#if defined(ENGINE_SIMD_FLOAT4)
+	Mat44 transpose = *this;
+	transpose.Transpose();
+
+	return transpose;
+#else
+	return GetTranspose_Scalar();
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+Mat44 const Mat44::GetOrthonormalInverse() const
+{
+#if defined(ENGINE_SIMD_FLOAT4)
+	Float4 iBasis = Float4LoadUnaligned(&m_values[Ix]);
+	Float4 jBasis = Float4LoadUnaligned(&m_values[Jx]);
+	Float4 kBasis = Float4LoadUnaligned(&m_values[Kx]);
+	Float4 translation = Float4LoadUnaligned(&m_values[Tx]);
+	Float4 zero = Float4Zero();
+
+	// transposing with a zero fourth column leaves the w lanes of the rotation at zero
+	Float4Transpose(iBasis, jBasis, kBasis, zero);
+
+	Float4 inverseTranslation = Float4Mul(iBasis, Float4SplatLane<0>(translation));
+	inverseTranslation = Float4MulAdd(jBasis, Float4SplatLane<1>(translation), inverseTranslation);
+	inverseTranslation = Float4MulAdd(kBasis, Float4SplatLane<2>(translation), inverseTranslation);
+	inverseTranslation = Float4Sub(Float4Set(0.f, 0.f, 0.f, 1.f), inverseTranslation);
+
+	Mat44 inverseMat;
+	Float4StoreUnaligned(&inverseMat.m_values[Ix], iBasis);
+	Float4StoreUnaligned(&inverseMat.m_values[Jx], jBasis);
+	Float4StoreUnaligned(&inverseMat.m_values[Kx], kBasis);
+	Float4StoreUnaligned(&inverseMat.m_values[Tx], inverseTranslation);
+
+	return inverseMat;
+#else
+	return GetOrthonormalInverse_Scalar();
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+Mat44 const Mat44::GetAffineInverse() const
+{
+#if defined(ENGINE_SIMD_FLOAT4)
+	Float4 wMask = Float4Set(1.f, 1.f, 1.f, 0.f);
+	Float4 iBasis = Float4Mul(Float4LoadUnaligned(&m_values[Ix]), wMask);
+	Float4 jBasis = Float4Mul(Float4LoadUnaligned(&m_values[Jx]), wMask);
+	Float4 kBasis = Float4Mul(Float4LoadUnaligned(&m_values[Kx]), wMask);
+	Float4 translation = Float4LoadUnaligned(&m_values[Tx]);
+
+	// cross(a, b) = a.yzx * b.zxy - a.zxy * b.yzx
+	Float4 row0 = Float4Sub(Float4Mul(Float4Swizzle<1, 2, 0, 3>(jBasis), Float4Swizzle<2, 0, 1, 3>(kBasis)), Float4Mul(Float4Swizzle<2, 0, 1, 3>(jBasis), Float4Swizzle<1, 2, 0, 3>(kBasis)));
+	Float4 row1 = Float4Sub(Float4Mul(Float4Swizzle<1, 2, 0, 3>(kBasis), Float4Swizzle<2, 0, 1, 3>(iBasis)), Float4Mul(Float4Swizzle<2, 0, 1, 3>(kBasis), Float4Swizzle<1, 2, 0, 3>(iBasis)));
+	Float4 row2 = Float4Sub(Float4Mul(Float4Swizzle<1, 2, 0, 3>(iBasis), Float4Swizzle<2, 0, 1, 3>(jBasis)), Float4Mul(Float4Swizzle<2, 0, 1, 3>(iBasis), Float4Swizzle<1, 2, 0, 3>(jBasis)));
+
+	Float4 detProducts = Float4Mul(iBasis, row0);
+	float det = Float4GetLane<0>(detProducts) + Float4GetLane<1>(detProducts) + Float4GetLane<2>(detProducts);
+
+	if(fabsf(det) < 1e-8f)
+	{
+		return Mat44();
+	}
+
+	Float4 invDet = Float4Splat(1.f / det);
+	row0 = Float4Mul(row0, invDet);
+	row1 = Float4Mul(row1, invDet);
+	row2 = Float4Mul(row2, invDet);
+
+	Float4 zero = Float4Zero();
+	Float4Transpose(row0, row1, row2, zero);
+
+	Float4 inverseTranslation = Float4Mul(row0, Float4SplatLane<0>(translation));
+	inverseTranslation = Float4MulAdd(row1, Float4SplatLane<1>(translation), inverseTranslation);
+	inverseTranslation = Float4MulAdd(row2, Float4SplatLane<2>(translation), inverseTranslation);
+	inverseTranslation = Float4Sub(Float4Set(0.f, 0.f, 0.f, 1.f), inverseTranslation);
+
+	Mat44 inverseMat;
+	Float4StoreUnaligned(&inverseMat.m_values[Ix], row0);
+	Float4StoreUnaligned(&inverseMat.m_values[Jx], row1);
+	Float4StoreUnaligned(&inverseMat.m_values[Kx], row2);
+	Float4StoreUnaligned(&inverseMat.m_values[Tx], inverseTranslation);
+
+	return inverseMat;
+#else
+	return GetAffineInverse_Scalar();
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Block inverse: split into 2x2 blocks A B / C D and build the inverse from their adjugates and determinants.
+// Inverting the transpose gives the transposed inverse, so the columns can be fed in as rows without any shuffling.
+Mat44 const Mat44::GetInverse() const
+{
+#if defined(ENGINE_SIMD_FLOAT4)
+	Float4 row0 = Float4LoadUnaligned(&m_values[Ix]);
+	Float4 row1 = Float4LoadUnaligned(&m_values[Jx]);
+	Float4 row2 = Float4LoadUnaligned(&m_values[Kx]);
+	Float4 row3 = Float4LoadUnaligned(&m_values[Tx]);
+
+	Float4 blockA = Float4Shuffle<0, 1, 0, 1>(row0, row1);
+	Float4 blockB = Float4Shuffle<2, 3, 2, 3>(row0, row1);
+	Float4 blockC = Float4Shuffle<0, 1, 0, 1>(row2, row3);
+	Float4 blockD = Float4Shuffle<2, 3, 2, 3>(row2, row3);
+
+	// (|A|, |B|, |C|, |D|)
+	Float4 blockDets = Float4Sub(Float4Mul(Float4Shuffle<0, 2, 0, 2>(row0, row2), Float4Shuffle<1, 3, 1, 3>(row1, row3)),
+								 Float4Mul(Float4Shuffle<1, 3, 1, 3>(row0, row2), Float4Shuffle<0, 2, 0, 2>(row1, row3)));
+
+	Float4 detA = Float4SplatLane<0>(blockDets);
+	Float4 detB = Float4SplatLane<1>(blockDets);
+	Float4 detC = Float4SplatLane<2>(blockDets);
+	Float4 detD = Float4SplatLane<3>(blockDets);
+
+	Float4 adjDTimesC = Mat2AdjMul(blockD, blockC);
+	Float4 adjATimesB = Mat2AdjMul(blockA, blockB);
+
+	Float4 adjX = Float4Sub(Float4Mul(detD, blockA), Mat2Mul(blockB, adjDTimesC));
+	Float4 adjW = Float4Sub(Float4Mul(detA, blockD), Mat2Mul(blockC, adjATimesB));
+	Float4 adjY = Float4Sub(Float4Mul(detB, blockC), Mat2MulAdj(blockD, adjATimesB));
+	Float4 adjZ = Float4Sub(Float4Mul(detC, blockB), Mat2MulAdj(blockA, adjDTimesC));
+
+	// |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+	Float4 traceProducts = Float4Mul(adjATimesB, Float4Swizzle<0, 2, 1, 3>(adjDTimesC));
+	float trace = Float4GetLane<0>(traceProducts) + Float4GetLane<1>(traceProducts) + Float4GetLane<2>(traceProducts) + Float4GetLane<3>(traceProducts);
+	float det4x4 = Float4GetLane<0>(detA) * Float4GetLane<0>(detD) + Float4GetLane<0>(detB) * Float4GetLane<0>(detC) - trace;
+
+	if(fabsf(det4x4) < 1e-8f)
+	{
+		return Mat44();
+	}
+
+	Float4 invDetSigned = Float4Div(Float4Set(1.f, -1.f, -1.f, 1.f), Float4Splat(det4x4));
+
+	adjX = Float4Mul(adjX, invDetSigned);
+	adjY = Float4Mul(adjY, invDetSigned);
+	adjZ = Float4Mul(adjZ, invDetSigned);
+	adjW = Float4Mul(adjW, invDetSigned);
+
+	Mat44 inverseMat;
+	Float4StoreUnaligned(&inverseMat.m_values[Ix], Float4Shuffle<3, 1, 3, 1>(adjX, adjY));
+	Float4StoreUnaligned(&inverseMat.m_values[Jx], Float4Shuffle<2, 0, 2, 0>(adjX, adjY));
+	Float4StoreUnaligned(&inverseMat.m_values[Kx], Float4Shuffle<3, 1, 3, 1>(adjZ, adjW));
+	Float4StoreUnaligned(&inverseMat.m_values[Tx], Float4Shuffle<2, 0, 2, 0>(adjZ, adjW));
+
+	return inverseMat;
+#else
+	return GetInverse_Scalar();
+#endif
+}
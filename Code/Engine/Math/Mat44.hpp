@@ -53,6 +53,7 @@ struct Mat44
 	void const GetIJKT3D(Vec3& iBasis3D, Vec3& jBasis3D, Vec3& kBasis3D, Vec3& translation3D) const;
 
 	Mat44 const GetOrthonormalInverse() const;
+	Mat44 const GetAffineInverse() const;	// any invertible 3x3 plus translation, bottom row assumed (0, 0, 0, 1)
 	Mat44 const GetInverse() const;
 
 	// mutators
@@ -89,6 +90,16 @@ struct Mat44
 
 	void GetAsMat34(float out_Mat[3][4]);
 
+	// scalar reference paths; the methods above use SIMD unless ENGINE_FORCE_SCALAR_MATH is defined
+	Mat44 const GetOrthonormalInverse_Scalar() const;
+	Mat44 const GetAffineInverse_Scalar() const;
+	Mat44 const GetInverse_Scalar() const;
+	Mat44		GetTranspose_Scalar() const;
+	Vec3 const	TransformVectorQuantity3D_Scalar(Vec3 const& vectorQuantityXYZ) const;
+	Vec3 const	TransformPosition3D_Scalar(Vec3 const positionXYZ) const;
+	Vec4 const	TransformHomogeneous3D_Scalar(Vec4 const& homogenousPoint3D) const;
+	void		Append_Scalar(Mat44 const& appendThis);
+
 	bool		operator==(Mat44 const& compare) const;
 	bool		operator!=(Mat44 const& compare) const;
 
@@ -0,0 +1,3703 @@
+#include "Engine/Math/MathBenchmarks.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/Vec4.hpp"
+#include "Engine/Math/BVH3.hpp"
+#include "Engine/Math/CurveUtils.hpp"
+#include "Engine/Math/Frustum.hpp"
+#include "Engine/Math/FastTrig.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/BakedCurve1D.hpp"
+#include "Engine/Math/BatchNoise.hpp"
+#include "Engine/Math/ConvexCollision.hpp"
+#include "Engine/Math/ConvexHull2.hpp"
+#include "Engine/Math/ConvexHull3.hpp"
+#include "Engine/Math/ConvexPoly2.hpp"
+#include "Engine/Math/Cylinder3D.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/DynamicAABBTree3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/OBB3.hpp"
+#include "Engine/Math/PackedConvexHulls2.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
+#include "Engine/Math/Sphere.hpp"
+#include "Engine/Math/SoftwareOcclusionBuffer.hpp"
+#include "Engine/Math/SpatialHashGrid2D.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Physics/PhysicsWorld2D.hpp"
+#include "Engine/Scene/TransformHierarchy.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "ThirdParty/Noise/SmoothNoise.hpp"
+
+#include <algorithm>
+#include <float.h>
+#include <math.h>
+#include <memory>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------
+// Every benchmark folds its results into this so the optimizer cannot throw the work away.
+static volatile float s_benchmarkSink = 0.f;
+
+//------------------------------------------------------------------------------------------------------------------
+// A failed check is fatal when the suites are run from code. From the MathBenchmarks command it is printed to the
+// console instead, and the checking function returns false so that its suite stops there.
+static DevConsole* s_benchmarkFailureConsole = nullptr;
+static int s_numBenchmarkFailures = 0;
+
+//------------------------------------------------------------------------------------------------------------------
+static void ReportBenchmarkFailure(char const* filePath, char const* functionName, int lineNum, std::string const& errorMessage)
+{
+	++s_numBenchmarkFailures;
+	if(s_benchmarkFailureConsole == nullptr)
+	{
+		FatalError(filePath, functionName, lineNum, errorMessage);
+	}
+
+	s_benchmarkFailureConsole->AddLine(DevConsole::ERROR, errorMessage);
+}
+
+#define GUARANTEE_OR_RETURN( condition, errorMessageText )											\
+{																									\
+	if( !(condition) )																				\
+	{																								\
+		ReportBenchmarkFailure( __FILE__, __FUNCTION__, __LINE__, errorMessageText );				\
+		return;																						\
+	}																								\
+}
+
+#define GUARANTEE_OR_RETURN_FALSE( condition, errorMessageText )									\
+{																									\
+	if( !(condition) )																				\
+	{																								\
+		ReportBenchmarkFailure( __FILE__, __FUNCTION__, __LINE__, errorMessageText );				\
+		return false;																				\
+	}																								\
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Per-iteration times of a baseline and the version it is compared against, each under a short label saying what it
+// runs ("scalar", "gjk", "wrap"...), and how many times faster the second one is.
+static void PrintBenchmarkResult(char const* name, int numIterations, char const* baselineLabel, double baselineSeconds, char const* label, double seconds)
+{
+	double baselineNs = baselineSeconds * 1e9 / static_cast<double>(numIterations);
+	double ns = seconds * 1e9 / static_cast<double>(numIterations);
+	double speedup = seconds > 0.0 ? baselineSeconds / seconds : 0.0;
+
+	DebuggerPrintf("  %-28s %-8s %8.2f ns   %-8s %8.2f ns   x%.2f\n", name, baselineLabel, baselineNs, label, ns, speedup);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static Mat44 MakeBenchmarkMatrix()
+{
+	Mat44 matrix = Mat44::MakeZRotationDegrees(30.f);
+	matrix.AppendYRotation(20.f);
+	matrix.AppendTranslation3D(Vec3(1.f, 2.f, 3.f));
+	matrix.AppendScaleNonUniform3D(Vec3(1.5f, 0.75f, 2.f));
+
+	return matrix;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Largest difference between two results relative to the expected value, so translations of hundreds and projection
+// terms near zero are held to the same number of significant bits.
+static float GetRelativeDifference(float const* expected, float const* actual, int numValues)
+{
+	float maxDifference = 0.f;
+	for(int index = 0; index < numValues; ++index)
+	{
+		float difference = fabsf(actual[index] - expected[index]) / (1.f + fabsf(expected[index]));
+		maxDifference = difference > maxDifference ? difference : maxDifference;
+	}
+
+	return maxDifference;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static bool CheckMat44Result(char const* kernelName, int matrixIndex, float const* scalarValues, float const* simdValues, int numValues)
+{
+	float const maxDifference = 1e-5f;
+	float difference = GetRelativeDifference(scalarValues, simdValues, numValues);
+	GUARANTEE_OR_RETURN_FALSE(difference <= maxDifference, Stringf("Mat44 %s: SIMD result differs from the scalar kernel by %g on test matrix %d", kernelName, difference, matrixIndex));
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Every SIMD kernel against its _Scalar twin on a skewed affine, a pure rotation, a rigid transform and a perspective
+// projection, so a timing is never printed for a kernel that gives the wrong answer.
+static bool CheckMat44Kernels()
+{
+	Mat44 rigid = Mat44::MakeZRotationDegrees(-75.f);
+	rigid.AppendXRotation(40.f);
+	rigid.SetTranslation3D(Vec3(-120.f, 35.f, 7.5f));
+
+	Mat44 const matrices[] = { MakeBenchmarkMatrix(), Mat44::MakeXRotationDegrees(10.f), rigid, Mat44::MakePerspectiveProjection(60.f, 1.75f, 0.1f, 100.f) };
+	bool const isAffine[] = { true, true, true, false };
+	bool const isOrthonormal[] = { false, true, true, false };
+	int const numMatrices = static_cast<int>(sizeof(matrices) / sizeof(matrices[0]));
+	Vec3 const positions[] = { Vec3(0.f, 0.f, 0.f), Vec3(1.f, -2.f, 3.f), Vec3(-250.f, 80.f, 0.5f) };
+
+	for(int matrixIndex = 0; matrixIndex < numMatrices; ++matrixIndex)
+	{
+		Mat44 const& matrix = matrices[matrixIndex];
+		for(int otherIndex = 0; otherIndex < numMatrices; ++otherIndex)
+		{
+			Mat44 scalarProduct = matrix;
+			scalarProduct.Append_Scalar(matrices[otherIndex]);
+			Mat44 simdProduct = matrix;
+			simdProduct.Append(matrices[otherIndex]);
+			if(!CheckMat44Result("Append", matrixIndex, scalarProduct.m_values, simdProduct.m_values, 16))
+			{
+				return false;
+			}
+		}
+
+		if(!CheckMat44Result("GetInverse", matrixIndex, matrix.GetInverse_Scalar().m_values, matrix.GetInverse().m_values, 16))
+		{
+			return false;
+		}
+		if(isAffine[matrixIndex])
+		{
+			if(!CheckMat44Result("GetAffineInverse", matrixIndex, matrix.GetAffineInverse_Scalar().m_values, matrix.GetAffineInverse().m_values, 16))
+			{
+				return false;
+			}
+		}
+		if(isOrthonormal[matrixIndex])
+		{
+			if(!CheckMat44Result("GetOrthonormalInverse", matrixIndex, matrix.GetOrthonormalInverse_Scalar().m_values, matrix.GetOrthonormalInverse().m_values, 16))
+			{
+				return false;
+			}
+		}
+
+		for(Vec3 const& position : positions)
+		{
+			Vec3 scalarPosition = matrix.TransformPosition3D_Scalar(position);
+			Vec3 simdPosition = matrix.TransformPosition3D(position);
+			if(!CheckMat44Result("TransformPosition3D", matrixIndex, &scalarPosition.x, &simdPosition.x, 3))
+			{
+				return false;
+			}
+
+			Vec4 point(position.x, position.y, position.z, 1.f);
+			Vec4 scalarPoint = matrix.TransformHomogeneous3D_Scalar(point);
+			Vec4 simdPoint = matrix.TransformHomogeneous3D(point);
+			if(!CheckMat44Result("TransformHomogeneous3D", matrixIndex, &scalarPoint.x, &simdPoint.x, 4))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void RunMat44Benchmarks(int numIterations)
+{
+	if(numIterations <= 0)
+	{
+		return;
+	}
+
+	if(!CheckMat44Kernels())
+	{
+		return;
+	}
+
+	Mat44 const source = MakeBenchmarkMatrix();
+	Mat44 const other = Mat44::MakeXRotationDegrees(10.f);
+	float sink = 0.f;
+
+	DebuggerPrintf("Mat44 benchmarks (%d iterations)\n", numIterations);
+
+	// Append
+	{
+		Mat44 scalarMatrix = source;
+		double start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numIterations; ++index)
+		{
+			scalarMatrix.Append_Scalar(other);
+		}
+		double scalarSeconds = GetCurrentTimeSeconds() - start;
+
+		Mat44 simdMatrix = source;
+		start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numIterations; ++index)
+		{
+			simdMatrix.Append(other);
+		}
+		double simdSeconds = GetCurrentTimeSeconds() - start;
+
+		sink += scalarMatrix.m_values[Mat44::Tx] + simdMatrix.m_values[Mat44::Tx];
+		PrintBenchmarkResult("Append", numIterations, "scalar", scalarSeconds, "simd", simdSeconds);
+	}
+
+	// GetInverse
+	{
+		Mat44 matrix = source;
+		double start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numIterations; ++index)
+		{
+			matrix.m_values[Mat44::Tx] = static_cast<float>(index & 7);
+			sink += matrix.GetInverse_Scalar().m_values[Mat44::Tx];
+		}
+		double scalarSeconds = GetCurrentTimeSeconds() - start;
+
+		start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numIterations; ++index)
+		{
+			matrix.m_values[Mat44::Tx] = static_cast<float>(index & 7);
+			sink += matrix.GetInverse().m_values[Mat44::Tx];
+		}
+		double simdSeconds = GetCurrentTimeSeconds() - start;
+
+		PrintBenchmarkResult("GetInverse", numIterations, "scalar", scalarSeconds, "simd", simdSeconds);
+	}
+
+	// GetAffineInverse
+	{
+		Mat44 matrix = source;
+		double start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numIterations; ++index)
+		{
+			matrix.m_values[Mat44::Tx] = static_cast<float>(index & 7);
+			sink += matrix.GetAffineInverse_Scalar().m_values[Mat44::Tx];
+		}
+		double scalarSeconds = GetCurrentTimeSeconds() - start;
+
+		start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numIterations; ++index)
+		{
+			matrix.m_values[Mat44::Tx] = static_cast<float>(index & 7);
+			sink += matrix.GetAffineInverse().m_values[Mat44::Tx];
+		}
+		double simdSeconds = GetCurrentTimeSeconds() - start;
+
+		PrintBenchmarkResult("GetAffineInverse", numIterations, "scalar", scalarSeconds, "simd", simdSeconds);
+	}
+
+	// GetOrthonormalInverse
+	{
+		Mat44 matrix = Mat44::MakeZRotationDegrees(30.f);
+		double start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numIterations; ++index)
+		{
+			matrix.m_values[Mat44::Tx] = static_cast<float>(index & 7);
+			sink += matrix.GetOrthonormalInverse_Scalar().m_values[Mat44::Tx];
+		}
+		double scalarSeconds = GetCurrentTimeSeconds() - start;
+
+		start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numIterations; ++index)
+		{
+			matrix.m_values[Mat44::Tx] = static_cast<float>(index & 7);
+			sink += matrix.GetOrthonormalInverse().m_values[Mat44::Tx];
+		}
+		double simdSeconds = GetCurrentTimeSeconds() - start;
+
+		PrintBenchmarkResult("GetOrthonormalInverse", numIterations, "scalar", scalarSeconds, "simd", simdSeconds);
+	}
+
+	// TransformPosition3D
+	{
+		Vec3 scalarPosition(0.f, 0.f, 0.f);
+		double start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numIterations; ++index)
+		{
+			scalarPosition += source.TransformPosition3D_Scalar(Vec3(static_cast<float>(index & 7), 2.f, 3.f));
+		}
+		double scalarSeconds = GetCurrentTimeSeconds() - start;
+
+		Vec3 simdPosition(0.f, 0.f, 0.f);
+		start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numIterations; ++index)
+		{
+			simdPosition += source.TransformPosition3D(Vec3(static_cast<float>(index & 7), 2.f, 3.f));
+		}
+		double simdSeconds = GetCurrentTimeSeconds() - start;
+
+		sink += scalarPosition.x + simdPosition.x;
+		PrintBenchmarkResult("TransformPosition3D", numIterations, "scalar", scalarSeconds, "simd", simdSeconds);
+	}
+
+	// TransformHomogeneous3D
+	{
+		Vec4 scalarPoint(0.f, 0.f, 0.f, 0.f);
+		double start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numIterations; ++index)
+		{
+			scalarPoint += source.TransformHomogeneous3D_Scalar(Vec4(static_cast<float>(index & 7), 2.f, 3.f, 1.f));
+		}
+		double scalarSeconds = GetCurrentTimeSeconds() - start;
+
+		Vec4 simdPoint(0.f, 0.f, 0.f, 0.f);
+		start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numIterations; ++index)
+		{
+			simdPoint += source.TransformHomogeneous3D(Vec4(static_cast<float>(index & 7), 2.f, 3.f, 1.f));
+		}
+		double simdSeconds = GetCurrentTimeSeconds() - start;
+
+		sink += scalarPoint.x + simdPoint.x;
+		PrintBenchmarkResult("TransformHomogeneous3D", numIterations, "scalar", scalarSeconds, "simd", simdSeconds);
+	}
+
+	s_benchmarkSink = s_benchmarkSink + sink;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// The documented FastTrig.hpp error bounds, measured against double precision: every quarter degree out to 720 degrees,
+// a coarse sweep out to four million degrees, and atan2 around circles from tiny to huge radii plus the benchmark's
+// integer grid. The batch functions must then agree with the scalar ones on the same inputs.
+static bool CheckTrigErrors(std::vector<float> const& ys, std::vector<float> const& xs)
+{
+	double const maxSinCosError = 9.5e-8;
+	double const maxATan2ErrorDegrees = 1.3e-5;
+	double const degreesToRadians = 3.14159265358979323846 / 180.0;
+
+	std::vector<float> angles;
+	for(int step = -720 * 64; step <= 720 * 64; ++step)
+	{
+		angles.push_back(static_cast<float>(step) / 64.f);
+	}
+	int const numCoarseSteps = 1 << 20;
+	for(int step = 0; step <= numCoarseSteps; ++step)
+	{
+		angles.push_back(-4.0e6f + 8.0e6f * static_cast<float>(step) / static_cast<float>(numCoarseSteps));
+	}
+
+	int const numAngles = static_cast<int>(angles.size());
+	std::vector<float> sines(numAngles);
+	std::vector<float> cosines(numAngles);
+	for(int index = 0; index < numAngles; ++index)
+	{
+		// fmod is exact, so the reference only rounds once the angle is small
+		double radians = fmod(static_cast<double>(angles[index]), 360.0) * degreesToRadians;
+		float sine = 0.f;
+		float cosine = 0.f;
+		FastSinCosDegrees(angles[index], sine, cosine);
+		sines[index] = sine;
+		cosines[index] = cosine;
+
+		double sineError = fabs(sine - sin(radians));
+		double cosineError = fabs(cosine - cos(radians));
+		double error = sineError > cosineError ? sineError : cosineError;
+		GUARANTEE_OR_RETURN_FALSE(error <= maxSinCosError, Stringf("FastSinCosDegrees(%.9g) is off by %g, above the documented %g", angles[index], error, maxSinCosError));
+		GUARANTEE_OR_RETURN_FALSE(FastSinDegrees(angles[index]) == sine && FastCosDegrees(angles[index]) == cosine, Stringf("FastSinDegrees / FastCosDegrees(%.9g) differ from FastSinCosDegrees", angles[index]));
+	}
+
+	std::vector<float> batchSines(numAngles);
+	std::vector<float> batchCosines(numAngles);
+	SinCosDegreesBatch(numAngles, angles.data(), batchSines.data(), batchCosines.data());
+	for(int index = 0; index < numAngles; ++index)
+	{
+		// exact without FMA; allow the last bit where fused multiply-adds round differently
+		float difference = GetMax(fabsf(batchSines[index] - sines[index]), fabsf(batchCosines[index] - cosines[index]));
+		GUARANTEE_OR_RETURN_FALSE(difference <= FLT_EPSILON, Stringf("SinCosDegreesBatch(%.9g) differs from FastSinCosDegrees by %g", angles[index], difference));
+	}
+
+	std::vector<float> pointYs(ys);
+	std::vector<float> pointXs(xs);
+	float const radii[] = { 1e-6f, 1.f, 1234.5f, 1e7f };
+	for(float radius : radii)
+	{
+		for(int step = 0; step < 360 * 16; ++step)
+		{
+			double radians = static_cast<double>(step) / 16.0 * degreesToRadians;
+			pointYs.push_back(radius * static_cast<float>(sin(radians)));
+			pointXs.push_back(radius * static_cast<float>(cos(radians)));
+		}
+	}
+
+	int const numPoints = static_cast<int>(pointYs.size());
+	std::vector<float> atans(numPoints);
+	for(int index = 0; index < numPoints; ++index)
+	{
+		atans[index] = FastATan2Degrees(pointYs[index], pointXs[index]);
+		if(pointYs[index] == 0.f && pointXs[index] == 0.f)
+		{
+			continue;
+		}
+
+		// +180 and -180 are the same direction
+		double error = fabs(atans[index] - atan2(static_cast<double>(pointYs[index]), static_cast<double>(pointXs[index])) / degreesToRadians);
+		error = error > 180.0 ? 360.0 - error : error;
+		GUARANTEE_OR_RETURN_FALSE(error <= maxATan2ErrorDegrees, Stringf("FastATan2Degrees(%.9g, %.9g) is off by %g degrees, above the documented %g", pointYs[index], pointXs[index], error, maxATan2ErrorDegrees));
+	}
+
+	std::vector<float> batchAtans(numPoints);
+	ATan2DegreesBatch(numPoints, pointYs.data(), pointXs.data(), batchAtans.data());
+	for(int index = 0; index < numPoints; ++index)
+	{
+		float difference = fabsf(batchAtans[index] - atans[index]);
+		GUARANTEE_OR_RETURN_FALSE(difference <= 180.f * FLT_EPSILON, Stringf("ATan2DegreesBatch(%.9g, %.9g) differs from FastATan2Degrees by %g", pointYs[index], pointXs[index], difference));
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Precise libm trig against the polynomial versions, one call per angle and then as a batch. The "scalar" column is
+// always the precise MathUtils path with ENGINE_FAST_TRIG off.
+void RunTrigBenchmarks(int numAngles)
+{
+	if(numAngles <= 0)
+	{
+		return;
+	}
+
+	std::vector<float> angles(numAngles);
+	std::vector<float> ys(numAngles);
+	std::vector<float> xs(numAngles);
+	for(int index = 0; index < numAngles; ++index)
+	{
+		angles[index] = static_cast<float>(index) * 0.37f - 7200.f;
+		ys[index] = static_cast<float>((index * 7919) % 2001 - 1000);
+		xs[index] = static_cast<float>((index * 104729) % 2001 - 1000);
+	}
+
+	if(!CheckTrigErrors(ys, xs))
+	{
+		return;
+	}
+
+	std::vector<float> sines(numAngles);
+	std::vector<float> cosines(numAngles);
+	float sink = 0.f;
+
+	DebuggerPrintf("Trig benchmarks (%d angles)\n", numAngles);
+
+	// sine and cosine of the same angle, as the polar and rotation helpers use them
+	{
+		double start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numAngles; ++index)
+		{
+			float radians = angles[index] * (3.1415926f / 180.f);
+			sines[index] = sinf(radians);
+			cosines[index] = cosf(radians);
+		}
+		double scalarSeconds = GetCurrentTimeSeconds() - start;
+		sink += sines[numAngles / 2] + cosines[numAngles / 3];
+
+		start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numAngles; ++index)
+		{
+			FastSinCosDegrees(angles[index], sines[index], cosines[index]);
+		}
+		double fastSeconds = GetCurrentTimeSeconds() - start;
+		sink += sines[numAngles / 2] + cosines[numAngles / 3];
+		PrintBenchmarkResult("FastSinCosDegrees", numAngles, "libm", scalarSeconds, "fast", fastSeconds);
+
+		start = GetCurrentTimeSeconds();
+		SinCosDegreesBatch(numAngles, angles.data(), sines.data(), cosines.data());
+		double batchSeconds = GetCurrentTimeSeconds() - start;
+		sink += sines[numAngles / 2] + cosines[numAngles / 3];
+		PrintBenchmarkResult("SinCosDegreesBatch", numAngles, "libm", scalarSeconds, "batch", batchSeconds);
+	}
+
+	// atan2
+	{
+		double start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numAngles; ++index)
+		{
+			sines[index] = atan2f(ys[index], xs[index]) * (180.f / 3.1415926f);
+		}
+		double scalarSeconds = GetCurrentTimeSeconds() - start;
+		sink += sines[numAngles / 2];
+
+		start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numAngles; ++index)
+		{
+			sines[index] = FastATan2Degrees(ys[index], xs[index]);
+		}
+		double fastSeconds = GetCurrentTimeSeconds() - start;
+		sink += sines[numAngles / 2];
+		PrintBenchmarkResult("FastATan2Degrees", numAngles, "libm", scalarSeconds, "fast", fastSeconds);
+
+		start = GetCurrentTimeSeconds();
+		ATan2DegreesBatch(numAngles, ys.data(), xs.data(), sines.data());
+		double batchSeconds = GetCurrentTimeSeconds() - start;
+		sink += sines[numAngles / 2];
+		PrintBenchmarkResult("ATan2DegreesBatch", numAngles, "libm", scalarSeconds, "batch", batchSeconds);
+	}
+
+	s_benchmarkSink = s_benchmarkSink + sink;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static void FillBenchmarkVerts(std::vector<Vertex_PCUTBN>& verts, int numVerts)
+{
+	verts.resize(numVerts);
+	for(int index = 0; index < numVerts; ++index)
+	{
+		float value = static_cast<float>(index % 1024) * 0.01f;
+		verts[index].m_position = Vec3(value, 1.f - value, 0.5f * value);
+		verts[index].m_tangent = Vec3(1.f, 0.f, 0.f);
+		verts[index].m_bitangent = Vec3(0.f, 1.f, 0.f);
+		verts[index].m_normal = Vec3(0.f, 0.f, 1.f);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// The per-vertex loop TransformVertexArray3D used to run, kept here as the baseline.
+static void TransformVertsPerVertex(std::vector<Vertex_PCUTBN>& verts, Mat44 const& transform, Mat44 const& normalTransform)
+{
+	for(int index = 0; index < static_cast<int>(verts.size()); ++index)
+	{
+		Vertex_PCUTBN& vert = verts[index];
+		vert.m_position = transform.TransformPosition3D_Scalar(vert.m_position);
+		vert.m_tangent = transform.TransformVectorQuantity3D_Scalar(vert.m_tangent).GetNormalized();
+		vert.m_bitangent = transform.TransformVectorQuantity3D_Scalar(vert.m_bitangent).GetNormalized();
+		vert.m_normal = normalTransform.TransformVectorQuantity3D_Scalar(vert.m_normal).GetNormalized();
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Unlike the benchmark verts, every vertex gets its own position and tangent frame, so a lane that picks up the wrong
+// vertex or basis shows up.
+static void FillCheckVerts(std::vector<Vertex_PCUTBN>& verts, int numVerts)
+{
+	verts.resize(numVerts);
+	for(int index = 0; index < numVerts; ++index)
+	{
+		float angle = 0.37f * static_cast<float>(index);
+		Vec3 tangent = Vec3(cosf(angle), sinf(angle), 0.3f).GetNormalized();
+		Vec3 normal = CrossProduct3D(tangent, Vec3(0.f, 0.f, 1.f)).GetNormalized();
+
+		verts[index].m_position = Vec3(static_cast<float>(index % 97) * 1.3f - 60.f, static_cast<float>(index % 89) * -0.7f, static_cast<float>(index % 31) * 2.1f);
+		verts[index].m_tangent = tangent;
+		verts[index].m_bitangent = CrossProduct3D(normal, tangent);
+		verts[index].m_normal = normal;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// The batched path against the per-vertex loop for one transform, over enough verts to split into several jobs and
+// leave a partial SIMD group at the end.
+static bool CheckVertexTransform(char const* transformName, Mat44 const& transform, JobSystem* jobSystem)
+{
+	int const numVerts = 70001;
+	float const maxDifference = 1e-5f;
+
+	std::vector<Vertex_PCUTBN> expectedVerts;
+	FillCheckVerts(expectedVerts, numVerts);
+	std::vector<Vertex_PCUTBN> verts = expectedVerts;
+
+	TransformVertsPerVertex(expectedVerts, transform, transform.GetAffineInverse().GetTranspose());
+	TransformVertexArray3D(verts, transform, 1.f, true, jobSystem);
+
+	for(int index = 0; index < numVerts; ++index)
+	{
+		Vertex_PCUTBN const& expected = expectedVerts[index];
+		Vertex_PCUTBN const& vert = verts[index];
+		float difference = GetRelativeDifference(&expected.m_position.x, &vert.m_position.x, 3);
+		difference = GetMax(difference, (vert.m_tangent - expected.m_tangent).GetLength());
+		difference = GetMax(difference, (vert.m_bitangent - expected.m_bitangent).GetLength());
+		difference = GetMax(difference, (vert.m_normal - expected.m_normal).GetLength());
+
+		GUARANTEE_OR_RETURN_FALSE(difference <= maxDifference, Stringf("TransformVertexArray3D (%s%s): vertex %d differs from the per-vertex loop by %g", transformName, jobSystem != nullptr ? ", jobs" : "", index, difference));
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void RunVertexTransformBenchmarks(int numVerts, JobSystem* jobSystem)
+{
+	if(numVerts <= 0)
+	{
+		return;
+	}
+
+	Mat44 rigidTransform = MakeBenchmarkMatrix();
+	rigidTransform.Orthonormalize_XFwd_YLeft_ZUp();
+	Mat44 const skewedTransform = MakeBenchmarkMatrix();
+	Mat44 const skewedNormalTransform = skewedTransform.GetAffineInverse().GetTranspose();
+	Mat44 const translationTransform = Mat44::MakeTranslation3D(Vec3(1.f, 2.f, 3.f));
+	Mat44 smallRotationTransform = Mat44::MakeZRotationDegrees(0.15f);
+	smallRotationTransform.SetTranslation3D(Vec3(1.f, 2.f, 3.f));
+
+	if(!CheckVertexTransform("skewed", skewedTransform, nullptr))
+	{
+		return;
+	}
+	if(!CheckVertexTransform("rigid", rigidTransform, nullptr))
+	{
+		return;
+	}
+	if(!CheckVertexTransform("translation only", translationTransform, nullptr))
+	{
+		return;
+	}
+	if(!CheckVertexTransform("small rotation", smallRotationTransform, nullptr))
+	{
+		return;
+	}
+	if(jobSystem != nullptr)
+	{
+		if(!CheckVertexTransform("skewed", skewedTransform, jobSystem))
+		{
+			return;
+		}
+	}
+
+	std::vector<Vertex_PCUTBN> verts;
+	float sink = 0.f;
+
+	DebuggerPrintf("Vertex transform benchmarks (%d Vertex_PCUTBN)\n", numVerts);
+
+	FillBenchmarkVerts(verts, numVerts);
+	double start = GetCurrentTimeSeconds();
+	TransformVertsPerVertex(verts, skewedTransform, skewedNormalTransform);
+	double perVertexSeconds = GetCurrentTimeSeconds() - start;
+	sink += verts[numVerts - 1].m_normal.x;
+
+	FillBenchmarkVerts(verts, numVerts);
+	start = GetCurrentTimeSeconds();
+	TransformVertexArray3D(verts, skewedTransform, 1.f, true);
+	double batchedSeconds = GetCurrentTimeSeconds() - start;
+	sink += verts[numVerts - 1].m_normal.x;
+
+	FillBenchmarkVerts(verts, numVerts);
+	start = GetCurrentTimeSeconds();
+	TransformVertexArray3D(verts, rigidTransform, 1.f, true);
+	double rigidSeconds = GetCurrentTimeSeconds() - start;
+	sink += verts[numVerts - 1].m_normal.x;
+
+	FillBenchmarkVerts(verts, numVerts);
+	start = GetCurrentTimeSeconds();
+	TransformVertexArray3D(verts, translationTransform, 1.f, true);
+	double translationSeconds = GetCurrentTimeSeconds() - start;
+	sink += verts[numVerts - 1].m_position.x;
+
+	DebuggerPrintf("  %-28s %8.2f ms\n", "per-vertex (skewed)", perVertexSeconds * 1000.0);
+	DebuggerPrintf("  %-28s %8.2f ms   x%.2f\n", "batched (skewed)", batchedSeconds * 1000.0, perVertexSeconds / (batchedSeconds > 0.0 ? batchedSeconds : 1e-9));
+	DebuggerPrintf("  %-28s %8.2f ms\n", "batched (rigid)", rigidSeconds * 1000.0);
+	DebuggerPrintf("  %-28s %8.2f ms\n", "batched (translation only)", translationSeconds * 1000.0);
+
+	if(jobSystem != nullptr)
+	{
+		FillBenchmarkVerts(verts, numVerts);
+		start = GetCurrentTimeSeconds();
+		TransformVertexArray3D(verts, skewedTransform, 1.f, true, jobSystem);
+		double jobsSeconds = GetCurrentTimeSeconds() - start;
+		sink += verts[numVerts - 1].m_normal.x;
+
+		DebuggerPrintf("  %-28s %8.2f ms   x%.2f\n", "batched + jobs (skewed)", jobsSeconds * 1000.0, perVertexSeconds / (jobsSeconds > 0.0 ? jobsSeconds : 1e-9));
+	}
+
+	s_benchmarkSink = s_benchmarkSink + sink;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// A rolling heightfield, so rays hit at varied depths and the tree is not just a flat grid.
+static void MakeBenchmarkTerrain(int numTriangles, std::vector<Vec3>& out_positions, std::vector<unsigned int>& out_indexes)
+{
+	int gridSize = static_cast<int>(sqrtf(static_cast<float>(numTriangles / 2)));
+	gridSize = gridSize < 1 ? 1 : gridSize;
+	int numVertsPerSide = gridSize + 1;
+
+	out_positions.resize(numVertsPerSide * numVertsPerSide);
+	for(int y = 0; y < numVertsPerSide; ++y)
+	{
+		for(int x = 0; x < numVertsPerSide; ++x)
+		{
+			float height = 3.f * sinf(static_cast<float>(x) * 0.37f) * cosf(static_cast<float>(y) * 0.23f);
+			out_positions[y * numVertsPerSide + x] = Vec3(static_cast<float>(x), static_cast<float>(y), height);
+		}
+	}
+
+	out_indexes.clear();
+	out_indexes.reserve(gridSize * gridSize * 6);
+	for(int y = 0; y < gridSize; ++y)
+	{
+		for(int x = 0; x < gridSize; ++x)
+		{
+			unsigned int bottomLeft = static_cast<unsigned int>(y * numVertsPerSide + x);
+			unsigned int topLeft = bottomLeft + static_cast<unsigned int>(numVertsPerSide);
+			out_indexes.push_back(bottomLeft);		out_indexes.push_back(bottomLeft + 1);	out_indexes.push_back(topLeft + 1);
+			out_indexes.push_back(bottomLeft);		out_indexes.push_back(topLeft + 1);		out_indexes.push_back(topLeft);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Rays from above the terrain, tilted up to 45 degrees, so most of them hit but from many directions.
+static void MakeBenchmarkRay(int rayIndex, float terrainSize, Vec3& out_startPos, Vec3& out_fwdNormal)
+{
+	unsigned int hash = static_cast<unsigned int>(rayIndex) * 2654435761u;
+	float u = static_cast<float>(hash & 0xFFFF) / 65535.f;
+	float v = static_cast<float>((hash >> 16) & 0xFFFF) / 65535.f;
+	float tiltX = static_cast<float>((hash >> 3) & 0xFF) / 255.f - 0.5f;
+	float tiltY = static_cast<float>((hash >> 11) & 0xFF) / 255.f - 0.5f;
+
+	out_startPos = Vec3(u * terrainSize, v * terrainSize, 20.f);
+	out_fwdNormal = Vec3(tiltX, tiltY, -1.f).GetNormalized();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Closest hit over every triangle with no tree at all; the same two-sided Moller-Trumbore test MeshBVH3 runs per leaf.
+static float GetBruteForceRaycastDistance(std::vector<Vec3> const& positions, std::vector<unsigned int> const& indexes, Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist)
+{
+	float closestDist = FLT_MAX;
+	for(int index = 0; index + 2 < static_cast<int>(indexes.size()); index += 3)
+	{
+		Vec3 const& pos0 = positions[indexes[index]];
+		Vec3 edge1 = positions[indexes[index + 1]] - pos0;
+		Vec3 edge2 = positions[indexes[index + 2]] - pos0;
+
+		Vec3 fwdCrossEdge2 = CrossProduct3D(fwdNormal, edge2);
+		float determinant = DotProduct3D(edge1, fwdCrossEdge2);
+		if(fabsf(determinant) < 1e-12f)
+		{
+			continue;
+		}
+
+		float invDeterminant = 1.f / determinant;
+		Vec3 pos0ToStart = startPos - pos0;
+		float u = DotProduct3D(pos0ToStart, fwdCrossEdge2) * invDeterminant;
+		Vec3 startCrossEdge1 = CrossProduct3D(pos0ToStart, edge1);
+		float v = DotProduct3D(fwdNormal, startCrossEdge1) * invDeterminant;
+		float impactDistance = DotProduct3D(edge2, startCrossEdge1) * invDeterminant;
+		if(u >= 0.f && v >= 0.f && u + v <= 1.f && impactDistance >= 0.f && impactDistance <= maxDist && impactDistance < closestDist)
+		{
+			closestDist = impactDistance;
+		}
+	}
+
+	return closestDist;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// A handful of the benchmark rays against the brute-force closest hit; RaycastAny must agree with whether anything was
+// hit. The brute force is O(rays * triangles), hence only a few rays.
+static bool CheckMeshBVHRaycasts(char const* stage, MeshBVH3 const& meshBVH, std::vector<Vec3> const& positions, std::vector<unsigned int> const& indexes, float terrainSize, int numRays)
+{
+	int const numCheckRays = GetMin(numRays, 64);
+	for(int rayIndex = 0; rayIndex < numCheckRays; ++rayIndex)
+	{
+		Vec3 rayStart;
+		Vec3 rayFwd;
+		MakeBenchmarkRay(rayIndex, terrainSize, rayStart, rayFwd);
+
+		float expectedDist = GetBruteForceRaycastDistance(positions, indexes, rayStart, rayFwd, 100.f);
+		bool isExpectedHit = expectedDist != FLT_MAX;
+		RaycastResult3D result = meshBVH.RaycastClosest(rayStart, rayFwd, 100.f);
+		bool isAnyHit = meshBVH.RaycastAny(rayStart, rayFwd, 100.f);
+
+		GUARANTEE_OR_RETURN_FALSE(result.m_didImpact == isExpectedHit && isAnyHit == isExpectedHit, Stringf("MeshBVH3 (%s): ray %d closest hit %d, any hit %d, brute force hit %d", stage, rayIndex, result.m_didImpact ? 1 : 0, isAnyHit ? 1 : 0, isExpectedHit ? 1 : 0));
+		GUARANTEE_OR_RETURN_FALSE(!isExpectedHit || fabsf(result.m_impactDistance - expectedDist) <= 1e-4f * (1.f + expectedDist), Stringf("MeshBVH3 (%s): ray %d hits at %g, brute force at %g", stage, rayIndex, result.m_impactDistance, expectedDist));
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void RunBVHBenchmarks(int numTriangles, int numRays, JobSystem* jobSystem)
+{
+	if(numTriangles <= 0 || numRays <= 0)
+	{
+		return;
+	}
+
+	std::vector<Vec3> positions;
+	std::vector<unsigned int> indexes;
+	MakeBenchmarkTerrain(numTriangles, positions, indexes);
+	float terrainSize = positions.back().x;
+	float sink = 0.f;
+
+	MeshBVH3 meshBVH;
+	double start = GetCurrentTimeSeconds();
+	meshBVH.Build(positions, indexes);
+	double buildSeconds = GetCurrentTimeSeconds() - start;
+
+	DebuggerPrintf("BVH benchmarks (%d triangles, %d nodes, %d rays)\n", meshBVH.GetNumTriangles(), meshBVH.GetBVH().GetNumNodes(), numRays);
+	DebuggerPrintf("  %-28s %8.2f ms\n", "build", buildSeconds * 1000.0);
+	if(!CheckMeshBVHRaycasts("build", meshBVH, positions, indexes, terrainSize, numRays))
+	{
+		return;
+	}
+
+	if(jobSystem != nullptr)
+	{
+		MeshBVH3 jobsMeshBVH;
+		start = GetCurrentTimeSeconds();
+		jobsMeshBVH.Build(positions, indexes, jobSystem);
+		double jobsBuildSeconds = GetCurrentTimeSeconds() - start;
+		if(!CheckMeshBVHRaycasts("build + jobs", jobsMeshBVH, positions, indexes, terrainSize, numRays))
+		{
+			return;
+		}
+
+		DebuggerPrintf("  %-28s %8.2f ms   x%.2f\n", "build + jobs", jobsBuildSeconds * 1000.0, buildSeconds / (jobsBuildSeconds > 0.0 ? jobsBuildSeconds : 1e-9));
+	}
+
+	for(int vertIndex = 0; vertIndex < static_cast<int>(positions.size()); ++vertIndex)
+	{
+		positions[vertIndex].z += 0.25f * sinf(static_cast<float>(vertIndex) * 0.01f);
+	}
+	start = GetCurrentTimeSeconds();
+	meshBVH.Refit(positions, indexes);
+	double refitSeconds = GetCurrentTimeSeconds() - start;
+	DebuggerPrintf("  %-28s %8.2f ms\n", "refit", refitSeconds * 1000.0);
+	if(!CheckMeshBVHRaycasts("refit", meshBVH, positions, indexes, terrainSize, numRays))
+	{
+		return;
+	}
+
+	int numHits = 0;
+	start = GetCurrentTimeSeconds();
+	for(int rayIndex = 0; rayIndex < numRays; ++rayIndex)
+	{
+		Vec3 rayStart;
+		Vec3 rayFwd;
+		MakeBenchmarkRay(rayIndex, terrainSize, rayStart, rayFwd);
+
+		RaycastResult3D result = meshBVH.RaycastClosest(rayStart, rayFwd, 100.f);
+		numHits += result.m_didImpact ? 1 : 0;
+		sink += result.m_impactDistance;
+	}
+	double closestSeconds = GetCurrentTimeSeconds() - start;
+
+	int numAnyHits = 0;
+	start = GetCurrentTimeSeconds();
+	for(int rayIndex = 0; rayIndex < numRays; ++rayIndex)
+	{
+		Vec3 rayStart;
+		Vec3 rayFwd;
+		MakeBenchmarkRay(rayIndex, terrainSize, rayStart, rayFwd);
+
+		numAnyHits += meshBVH.RaycastAny(rayStart, rayFwd, 100.f) ? 1 : 0;
+	}
+	double anySeconds = GetCurrentTimeSeconds() - start;
+	GUARANTEE_OR_RETURN(numAnyHits == numHits, Stringf("MeshBVH3: RaycastAny hit %d rays but RaycastClosest hit %d", numAnyHits, numHits));
+
+	double closestRate = closestSeconds > 0.0 ? static_cast<double>(numRays) / closestSeconds : 0.0;
+	double anyRate = anySeconds > 0.0 ? static_cast<double>(numRays) / anySeconds : 0.0;
+	DebuggerPrintf("  %-28s %8.2f Mrays/s   (%d hits)\n", "closest hit", closestRate * 1e-6, numHits);
+	DebuggerPrintf("  %-28s %8.2f Mrays/s   (%d hits)\n", "any hit", anyRate * 1e-6, numAnyHits);
+
+	s_benchmarkSink = s_benchmarkSink + sink;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Full avalanche integer hash; a plain multiplicative hash leaves its low bits on a lattice, which clusters 3D points.
+static unsigned int GetBenchmarkHash(unsigned int value)
+{
+	value ^= value >> 16;
+	value *= 0x7FEB352Du;
+	value ^= value >> 15;
+	value *= 0x846CA68Bu;
+	value ^= value >> 16;
+	return value;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Spheres drifting around a box sized for a handful of neighbours each, the usual crowd of actors.
+void RunBroadphaseBenchmarks(int numProxies, int numFrames)
+{
+	if(numProxies <= 0 || numFrames <= 0)
+	{
+		return;
+	}
+
+	float const worldSize = 4.f * cbrtf(static_cast<float>(numProxies));
+	float const frameSeconds = 1.f / 60.f;
+
+	std::vector<Sphere> spheres(numProxies);
+	std::vector<Vec3> velocities(numProxies);
+	for(int index = 0; index < numProxies; ++index)
+	{
+		unsigned int hash = GetBenchmarkHash(static_cast<unsigned int>(index));
+		float u = static_cast<float>(hash & 0x3FF) / 1023.f;
+		float v = static_cast<float>((hash >> 10) & 0x3FF) / 1023.f;
+		float w = static_cast<float>((hash >> 20) & 0x3FF) / 1023.f;
+
+		spheres[index] = Sphere(Vec3(u, v, w) * worldSize, 1.f);
+		velocities[index] = Vec3(v - 0.5f, w - 0.5f, u - 0.5f) * 6.f;
+	}
+
+	DynamicAABBTree3 tree(0.5f);
+	std::vector<int> proxyIds(numProxies);
+	std::vector<BroadphasePair3> pairs;
+
+	double start = GetCurrentTimeSeconds();
+	for(int index = 0; index < numProxies; ++index)
+	{
+		proxyIds[index] = tree.CreateProxy(spheres[index], &spheres[index]);
+	}
+	tree.FindNewPairs(pairs);
+	double createSeconds = GetCurrentTimeSeconds() - start;
+
+	DebuggerPrintf("Broadphase benchmarks (%d spheres, %d frames, tree height %d)\n", numProxies, numFrames, tree.GetHeight());
+	DebuggerPrintf("  %-28s %8.2f ms   (%d pairs)\n", "create + first pairs", createSeconds * 1000.0, static_cast<int>(pairs.size()));
+
+	double updateSeconds = 0.0;
+	double allPairsSeconds = 0.0;
+	int numReinserted = 0;
+	int numNewPairs = 0;
+	int numOverlaps = 0;
+
+	for(int frame = 0; frame < numFrames; ++frame)
+	{
+		for(int index = 0; index < numProxies; ++index)
+		{
+			Vec3 displacement = velocities[index] * frameSeconds;
+			Vec3 center = spheres[index].m_center + displacement;
+			if(center.x < 0.f || center.x > worldSize || center.y < 0.f || center.y > worldSize || center.z < 0.f || center.z > worldSize)
+			{
+				velocities[index] = -velocities[index];
+				displacement = -displacement;
+				center = spheres[index].m_center + displacement;
+			}
+			spheres[index].m_center = center;
+		}
+
+		pairs.clear();
+		start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numProxies; ++index)
+		{
+			numReinserted += tree.MoveProxy(proxyIds[index], spheres[index], velocities[index] * frameSeconds) ? 1 : 0;
+		}
+		tree.FindNewPairs(pairs);
+		updateSeconds += GetCurrentTimeSeconds() - start;
+		numNewPairs += static_cast<int>(pairs.size());
+
+		pairs.clear();
+		start = GetCurrentTimeSeconds();
+		tree.FindAllPairs(pairs);
+		for(int pairIndex = 0; pairIndex < static_cast<int>(pairs.size()); ++pairIndex)
+		{
+			Sphere const* sphereA = static_cast<Sphere const*>(tree.GetUserData(pairs[pairIndex].m_proxyA));
+			Sphere const* sphereB = static_cast<Sphere const*>(tree.GetUserData(pairs[pairIndex].m_proxyB));
+			numOverlaps += DoSpheresOverlap(*sphereA, *sphereB) ? 1 : 0;
+		}
+		allPairsSeconds += GetCurrentTimeSeconds() - start;
+	}
+
+	// the narrow phase on the final frame's tree pairs, to hold against the nested loop below
+	std::vector<unsigned long long> overlappingPairKeys;
+	for(int pairIndex = 0; pairIndex < static_cast<int>(pairs.size()); ++pairIndex)
+	{
+		Sphere const* sphereA = static_cast<Sphere const*>(tree.GetUserData(pairs[pairIndex].m_proxyA));
+		Sphere const* sphereB = static_cast<Sphere const*>(tree.GetUserData(pairs[pairIndex].m_proxyB));
+		if(DoSpheresOverlap(*sphereA, *sphereB))
+		{
+			unsigned long long indexA = static_cast<unsigned long long>(sphereA - spheres.data());
+			unsigned long long indexB = static_cast<unsigned long long>(sphereB - spheres.data());
+			overlappingPairKeys.push_back(indexA < indexB ? (indexA << 32) | indexB : (indexB << 32) | indexA);
+		}
+	}
+	std::sort(overlappingPairKeys.begin(), overlappingPairKeys.end());
+	GUARANTEE_OR_RETURN(std::adjacent_find(overlappingPairKeys.begin(), overlappingPairKeys.end()) == overlappingPairKeys.end(), "DynamicAABBTree3: FindAllPairs reported the same pair twice");
+
+	// one frame of the nested loop the tree replaces
+	int numBruteForceOverlaps = 0;
+	start = GetCurrentTimeSeconds();
+	for(int indexA = 0; indexA < numProxies; ++indexA)
+	{
+		for(int indexB = indexA + 1; indexB < numProxies; ++indexB)
+		{
+			numBruteForceOverlaps += DoSpheresOverlap(spheres[indexA], spheres[indexB]) ? 1 : 0;
+		}
+	}
+	double bruteForceSeconds = GetCurrentTimeSeconds() - start;
+
+	// every tree pair really overlaps and none repeats, so equal counts mean the tree missed no overlapping pair
+	GUARANTEE_OR_RETURN(static_cast<int>(overlappingPairKeys.size()) == numBruteForceOverlaps, Stringf("DynamicAABBTree3: FindAllPairs found %d overlapping pairs, brute force %d", static_cast<int>(overlappingPairKeys.size()), numBruteForceOverlaps));
+
+	DebuggerPrintf("  %-28s %8.3f ms   (%.0f reinserts, %.0f new pairs per frame)\n", "move + new pairs / frame", updateSeconds * 1000.0 / numFrames,
+				   static_cast<double>(numReinserted) / numFrames, static_cast<double>(numNewPairs) / numFrames);
+	DebuggerPrintf("  %-28s %8.3f ms   (%.0f overlaps per frame)\n", "all pairs + narrow / frame", allPairsSeconds * 1000.0 / numFrames, static_cast<double>(numOverlaps) / numFrames);
+	DebuggerPrintf("  %-28s %8.3f ms   (%d overlaps)\n", "brute force / frame", bruteForceSeconds * 1000.0, numBruteForceOverlaps);
+
+	s_benchmarkSink = s_benchmarkSink + static_cast<float>(numOverlaps + numBruteForceOverlaps);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Disc and sector queries from a few discs against a loop over every disc, compared as sorted index lists so the
+// bucket order the grid returns them in does not matter.
+static bool CheckSpatialHashQueries(SpatialHashGrid2D const& grid, std::vector<Vec2> const& centers, std::vector<float> const& radii, std::vector<Vec2> const& velocities)
+{
+	int const numDiscs = static_cast<int>(centers.size());
+	int const numCheckQueries = 64;
+	std::vector<int> gridResults;
+	std::vector<int> bruteForceResults;
+
+	for(int queryIndex = 0; queryIndex < numCheckQueries; ++queryIndex)
+	{
+		int viewerIndex = static_cast<int>(GetBenchmarkHash(static_cast<unsigned int>(queryIndex) + 0x5EED0000u) % static_cast<unsigned int>(numDiscs));
+		Vec2 const& viewerPos = centers[viewerIndex];
+		Vec2 viewerFwd = velocities[viewerIndex].GetNormalized();
+
+		gridResults.clear();
+		grid.QueryDisc(viewerPos, 3.f, gridResults);
+		bruteForceResults.clear();
+		for(int index = 0; index < numDiscs; ++index)
+		{
+			if(DoDiscsOverlap(viewerPos, 3.f, centers[index], radii[index]))
+			{
+				bruteForceResults.push_back(index);
+			}
+		}
+		std::sort(gridResults.begin(), gridResults.end());
+		GUARANTEE_OR_RETURN_FALSE(gridResults == bruteForceResults, Stringf("SpatialHashGrid2D: QueryDisc from disc %d found %d discs, brute force %d", viewerIndex, static_cast<int>(gridResults.size()), static_cast<int>(bruteForceResults.size())));
+
+		gridResults.clear();
+		grid.QueryDirectedSector(viewerPos, viewerFwd, 90.f, 8.f, gridResults);
+		bruteForceResults.clear();
+		for(int index = 0; index < numDiscs; ++index)
+		{
+			if(IsPointInsideDirectedSector2D(centers[index], viewerPos, viewerFwd, 90.f, 8.f))
+			{
+				bruteForceResults.push_back(index);
+			}
+		}
+		std::sort(gridResults.begin(), gridResults.end());
+		GUARANTEE_OR_RETURN_FALSE(gridResults == bruteForceResults, Stringf("SpatialHashGrid2D: QueryDirectedSector from disc %d found %d discs, brute force %d", viewerIndex, static_cast<int>(gridResults.size()), static_cast<int>(bruteForceResults.size())));
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// A crowd of discs bouncing around a walled arena, resolved with BounceDiscOutOfDisc the way 2D gameplay code does it,
+// plus the vision-cone and splash queries an AI pass would make each frame.
+void RunSpatialHashBenchmarks(int numDiscs, int numFrames)
+{
+	if(numDiscs <= 0 || numFrames <= 0)
+	{
+		return;
+	}
+
+	float const arenaSize = 2.f * sqrtf(static_cast<float>(numDiscs));
+	float const frameSeconds = 1.f / 60.f;
+	int const numQueriesPerFrame = 1000;
+
+	std::vector<Vec2> centers(numDiscs);
+	std::vector<Vec2> velocities(numDiscs);
+	std::vector<float> radii(numDiscs);
+	for(int index = 0; index < numDiscs; ++index)
+	{
+		unsigned int hash = GetBenchmarkHash(static_cast<unsigned int>(index));
+		float u = static_cast<float>(hash & 0x3FF) / 1023.f;
+		float v = static_cast<float>((hash >> 10) & 0x3FF) / 1023.f;
+		float w = static_cast<float>((hash >> 20) & 0x3FF) / 1023.f;
+
+		centers[index] = Vec2(u, v) * arenaSize;
+		velocities[index] = Vec2(v - 0.5f, w - 0.5f) * 8.f;
+		radii[index] = 0.3f + 0.4f * w;
+	}
+
+	SpatialHashGrid2D grid(1.4f);
+	std::vector<SpatialHashPair2D> pairs;
+	std::vector<int> queryResults;
+
+	double rebuildSeconds = 0.0;
+	double pairsSeconds = 0.0;
+	double resolveSeconds = 0.0;
+	double querySeconds = 0.0;
+	int numPairs = 0;
+	int numBounces = 0;
+	int numQueryHits = 0;
+
+	for(int frame = 0; frame < numFrames; ++frame)
+	{
+		for(int index = 0; index < numDiscs; ++index)
+		{
+			centers[index] += velocities[index] * frameSeconds;
+			if(centers[index].x < 0.f || centers[index].x > arenaSize)
+			{
+				velocities[index].x = -velocities[index].x;
+			}
+			if(centers[index].y < 0.f || centers[index].y > arenaSize)
+			{
+				velocities[index].y = -velocities[index].y;
+			}
+		}
+
+		double start = GetCurrentTimeSeconds();
+		grid.Rebuild(centers, radii);
+		rebuildSeconds += GetCurrentTimeSeconds() - start;
+
+		pairs.clear();
+		start = GetCurrentTimeSeconds();
+		grid.FindOverlappingPairs(pairs);
+		pairsSeconds += GetCurrentTimeSeconds() - start;
+		numPairs += static_cast<int>(pairs.size());
+
+		start = GetCurrentTimeSeconds();
+		for(int pairIndex = 0; pairIndex < static_cast<int>(pairs.size()); ++pairIndex)
+		{
+			int indexA = pairs[pairIndex].m_discA;
+			int indexB = pairs[pairIndex].m_discB;
+			numBounces += BounceDiscOutOfDisc(centers[indexA], radii[indexA], velocities[indexA], 0.9f, centers[indexB], radii[indexB], velocities[indexB], 0.9f) ? 1 : 0;
+		}
+		resolveSeconds += GetCurrentTimeSeconds() - start;
+
+		start = GetCurrentTimeSeconds();
+		for(int queryIndex = 0; queryIndex < numQueriesPerFrame; ++queryIndex)
+		{
+			int viewerIndex = static_cast<int>(GetBenchmarkHash(static_cast<unsigned int>(frame * numQueriesPerFrame + queryIndex)) % static_cast<unsigned int>(numDiscs));
+			Vec2 const& viewerPos = centers[viewerIndex];
+
+			queryResults.clear();
+			grid.QueryDirectedSector(viewerPos, velocities[viewerIndex].GetNormalized(), 90.f, 8.f, queryResults);
+			grid.QueryDisc(viewerPos, 3.f, queryResults);
+			numQueryHits += static_cast<int>(queryResults.size());
+		}
+		querySeconds += GetCurrentTimeSeconds() - start;
+	}
+
+	// one frame of the nested loop the grid replaces
+	int numBruteForcePairs = 0;
+	double start = GetCurrentTimeSeconds();
+	for(int indexA = 0; indexA < numDiscs; ++indexA)
+	{
+		for(int indexB = indexA + 1; indexB < numDiscs; ++indexB)
+		{
+			numBruteForcePairs += DoDiscsOverlap(centers[indexA], radii[indexA], centers[indexB], radii[indexB]) ? 1 : 0;
+		}
+	}
+	double bruteForceSeconds = GetCurrentTimeSeconds() - start;
+
+	pairs.clear();
+	grid.Rebuild(centers, radii);
+	grid.FindOverlappingPairs(pairs);
+
+	// every grid pair must overlap and appear once, so matching the nested loop's count means none were missed
+	std::vector<unsigned long long> pairKeys;
+	for(int pairIndex = 0; pairIndex < static_cast<int>(pairs.size()); ++pairIndex)
+	{
+		int indexA = pairs[pairIndex].m_discA;
+		int indexB = pairs[pairIndex].m_discB;
+		GUARANTEE_OR_RETURN(DoDiscsOverlap(centers[indexA], radii[indexA], centers[indexB], radii[indexB]), Stringf("SpatialHashGrid2D: discs %d and %d paired but not overlapping", indexA, indexB));
+		pairKeys.push_back((static_cast<unsigned long long>(indexA) << 32) | static_cast<unsigned long long>(indexB));
+	}
+	std::sort(pairKeys.begin(), pairKeys.end());
+	GUARANTEE_OR_RETURN(std::adjacent_find(pairKeys.begin(), pairKeys.end()) == pairKeys.end(), "SpatialHashGrid2D: FindOverlappingPairs reported the same pair twice");
+	GUARANTEE_OR_RETURN(static_cast<int>(pairs.size()) == numBruteForcePairs, Stringf("SpatialHashGrid2D: FindOverlappingPairs found %d pairs, brute force %d", static_cast<int>(pairs.size()), numBruteForcePairs));
+	if(!CheckSpatialHashQueries(grid, centers, radii, velocities))
+	{
+		return;
+	}
+
+	DebuggerPrintf("Spatial hash benchmarks (%d discs, %d frames, %d buckets)\n", numDiscs, numFrames, grid.GetNumBuckets());
+	DebuggerPrintf("  %-28s %8.3f ms\n", "rebuild / frame", rebuildSeconds * 1000.0 / numFrames);
+	DebuggerPrintf("  %-28s %8.3f ms   (%.0f pairs per frame)\n", "overlapping pairs / frame", pairsSeconds * 1000.0 / numFrames, static_cast<double>(numPairs) / numFrames);
+	DebuggerPrintf("  %-28s %8.3f ms   (%.0f bounces per frame)\n", "bounce pairs / frame", resolveSeconds * 1000.0 / numFrames, static_cast<double>(numBounces) / numFrames);
+	DebuggerPrintf("  %-28s %8.3f ms   (%d sector + disc queries, %.0f hits per frame)\n", "queries / frame", querySeconds * 1000.0 / numFrames, numQueriesPerFrame,
+				   static_cast<double>(numQueryHits) / numFrames);
+	DebuggerPrintf("  %-28s %8.3f ms   (%d pairs, grid found %d)\n", "brute force / frame", bruteForceSeconds * 1000.0, numBruteForcePairs, static_cast<int>(pairs.size()));
+
+	s_benchmarkSink = s_benchmarkSink + static_cast<float>(numBounces + numQueryHits + numBruteForcePairs);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// One frame of every culling path against IsAABB3Visible box by box. The batch paths write indexes in ascending order, so
+// the lists must match exactly; inout_lastFailedPlanes carries the coherent path's per-box state from frame to frame.
+static bool CheckFrustumCulling(int frame, Frustum const& frustum, std::vector<AABB3> const& boxes, AABB3SoA const& boxesSoA, std::vector<unsigned char>& inout_lastFailedPlanes, JobSystem* jobSystem)
+{
+	std::vector<int> scalarIndexes;
+	for(int index = 0; index < static_cast<int>(boxes.size()); ++index)
+	{
+		bool isVisible = frustum.IsAABB3Visible(boxes[index]);
+		bool isCoherentVisible = frustum.IsAABB3Visible(boxes[index], inout_lastFailedPlanes[index]);
+		GUARANTEE_OR_RETURN_FALSE(isCoherentVisible == isVisible, Stringf("Frustum: frame %d box %d is %s with the last failed plane, %s without", frame, index, isCoherentVisible ? "visible" : "culled", isVisible ? "visible" : "culled"));
+		if(isVisible)
+		{
+			scalarIndexes.push_back(index);
+		}
+	}
+
+	std::vector<int> batchIndexes;
+	int numBatchVisible = CullAABB3sToFrustum(frustum, boxesSoA, batchIndexes);
+	GUARANTEE_OR_RETURN_FALSE(numBatchVisible == static_cast<int>(batchIndexes.size()) && batchIndexes == scalarIndexes, Stringf("Frustum: frame %d batch cull kept %d boxes, IsAABB3Visible %d, or kept different ones", frame, numBatchVisible, static_cast<int>(scalarIndexes.size())));
+
+	if(jobSystem != nullptr)
+	{
+		int numJobVisible = CullAABB3sToFrustum(frustum, boxesSoA, batchIndexes, jobSystem);
+		GUARANTEE_OR_RETURN_FALSE(numJobVisible == static_cast<int>(batchIndexes.size()) && batchIndexes == scalarIndexes, Stringf("Frustum: frame %d batch cull with jobs kept %d boxes, IsAABB3Visible %d, or kept different ones", frame, numJobVisible, static_cast<int>(scalarIndexes.size())));
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// A camera turning slowly in the middle of a field of boxes, so about a tenth of them are on screen and most culled
+// boxes fail the same plane as the frame before.
+void RunFrustumCullingBenchmarks(int numObjects, int numFrames, JobSystem* jobSystem)
+{
+	if(numObjects <= 0 || numFrames <= 0)
+	{
+		return;
+	}
+
+	float const worldSize = 1000.f;
+	std::vector<AABB3> boxes(numObjects);
+	std::vector<float> minXs(numObjects);
+	std::vector<float> minYs(numObjects);
+	std::vector<float> minZs(numObjects);
+	std::vector<float> maxXs(numObjects);
+	std::vector<float> maxYs(numObjects);
+	std::vector<float> maxZs(numObjects);
+	for(int index = 0; index < numObjects; ++index)
+	{
+		unsigned int hash = GetBenchmarkHash(static_cast<unsigned int>(index));
+		float u = static_cast<float>(hash & 0x3FF) / 1023.f - 0.5f;
+		float v = static_cast<float>((hash >> 10) & 0x3FF) / 1023.f - 0.5f;
+		float w = static_cast<float>((hash >> 20) & 0x3FF) / 1023.f - 0.5f;
+		Vec3 center(u * worldSize, v * worldSize, w * 0.1f * worldSize);
+		Vec3 halfSize(2.f + 3.f * (u + 0.5f), 2.f + 3.f * (v + 0.5f), 2.f + 3.f * (w + 0.5f));
+
+		boxes[index] = AABB3(center - halfSize, center + halfSize);
+		minXs[index] = boxes[index].m_mins.x;
+		minYs[index] = boxes[index].m_mins.y;
+		minZs[index] = boxes[index].m_mins.z;
+		maxXs[index] = boxes[index].m_maxs.x;
+		maxYs[index] = boxes[index].m_maxs.y;
+		maxZs[index] = boxes[index].m_maxs.z;
+	}
+
+	AABB3SoA boxesSoA;
+	boxesSoA.m_count = numObjects;
+	boxesSoA.m_minX = minXs.data();
+	boxesSoA.m_minY = minYs.data();
+	boxesSoA.m_minZ = minZs.data();
+	boxesSoA.m_maxX = maxXs.data();
+	boxesSoA.m_maxY = maxYs.data();
+	boxesSoA.m_maxZ = maxZs.data();
+
+	// camera looks down +x in world space, render space is x right, y up, z forward
+	Mat44 cameraToRender(Vec3(0.f, 0.f, 1.f), Vec3(-1.f, 0.f, 0.f), Vec3(0.f, 1.f, 0.f), Vec3(0.f, 0.f, 0.f));
+	std::vector<Frustum> frustums(numFrames);
+	for(int frame = 0; frame < numFrames; ++frame)
+	{
+		Mat44 worldToClip = Mat44::MakePerspectiveProjection(60.f, 16.f / 9.f, 0.1f, 400.f);
+		worldToClip.Append(cameraToRender);
+		worldToClip.Append(Mat44::MakeZRotationDegrees(static_cast<float>(frame) * -0.5f));
+		frustums[frame] = Frustum::MakeFromWorldToClip(worldToClip);
+	}
+
+	std::vector<unsigned char> lastFailedPlanes(numObjects, 0);
+	for(int frame = 0; frame < numFrames; ++frame)
+	{
+		if(!CheckFrustumCulling(frame, frustums[frame], boxes, boxesSoA, lastFailedPlanes, jobSystem))
+		{
+			return;
+		}
+	}
+	lastFailedPlanes.assign(numObjects, 0);
+
+	std::vector<int> visibleIndexes;
+	int numScalarVisible = 0;
+	int numCoherentVisible = 0;
+	int numBatchVisible = 0;
+	int numJobVisible = 0;
+
+	double start = GetCurrentTimeSeconds();
+	for(int frame = 0; frame < numFrames; ++frame)
+	{
+		for(int index = 0; index < numObjects; ++index)
+		{
+			numScalarVisible += frustums[frame].IsAABB3Visible(boxes[index]) ? 1 : 0;
+		}
+	}
+	double scalarSeconds = GetCurrentTimeSeconds() - start;
+
+	start = GetCurrentTimeSeconds();
+	for(int frame = 0; frame < numFrames; ++frame)
+	{
+		for(int index = 0; index < numObjects; ++index)
+		{
+			numCoherentVisible += frustums[frame].IsAABB3Visible(boxes[index], lastFailedPlanes[index]) ? 1 : 0;
+		}
+	}
+	double coherentSeconds = GetCurrentTimeSeconds() - start;
+
+	start = GetCurrentTimeSeconds();
+	for(int frame = 0; frame < numFrames; ++frame)
+	{
+		numBatchVisible += CullAABB3sToFrustum(frustums[frame], boxesSoA, visibleIndexes);
+	}
+	double batchSeconds = GetCurrentTimeSeconds() - start;
+
+	double jobSeconds = 0.0;
+	if(jobSystem != nullptr)
+	{
+		start = GetCurrentTimeSeconds();
+		for(int frame = 0; frame < numFrames; ++frame)
+		{
+			numJobVisible += CullAABB3sToFrustum(frustums[frame], boxesSoA, visibleIndexes, jobSystem);
+		}
+		jobSeconds = GetCurrentTimeSeconds() - start;
+	}
+
+	double frames = static_cast<double>(numFrames);
+	DebuggerPrintf("Frustum culling benchmarks (%d boxes, %d frames, %.0f visible per frame)\n", numObjects, numFrames, numScalarVisible / frames);
+	DebuggerPrintf("  %-28s %8.3f ms / frame\n", "scalar", scalarSeconds * 1000.0 / frames);
+	DebuggerPrintf("  %-28s %8.3f ms / frame   (%.0f visible)\n", "scalar, last failed plane", coherentSeconds * 1000.0 / frames, numCoherentVisible / frames);
+	DebuggerPrintf("  %-28s %8.3f ms / frame   (%.0f visible)\n", "batch", batchSeconds * 1000.0 / frames, numBatchVisible / frames);
+	if(jobSystem != nullptr)
+	{
+		DebuggerPrintf("  %-28s %8.3f ms / frame   (%.0f visible)\n", "batch + jobs", jobSeconds * 1000.0 / frames, numJobVisible / frames);
+	}
+
+	s_benchmarkSink = s_benchmarkSink + static_cast<float>(numScalarVisible + numCoherentVisible + numBatchVisible + numJobVisible);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Rasterizes one frame's buildings serially (and on the JobSystem, which must give the same depths and survivors), then
+// ray casts from the camera to the corners and center of every box the buffer culled. A sample point on screen that no
+// building blocks means the buffer hid something the camera can see.
+static bool CheckOcclusionCulling(int frame, Mat44 const& worldToClip, Vec3 const& cameraPosition, std::vector<AABB3> const& buildings, AABB3SoA const& boxesSoA, JobSystem* jobSystem)
+{
+	std::vector<int> frustumIndexes;
+	CullAABB3sToFrustum(Frustum::MakeFromWorldToClip(worldToClip), boxesSoA, frustumIndexes);
+
+	SoftwareOcclusionBuffer occlusionBuffer;
+	occlusionBuffer.BeginFrame(worldToClip);
+	for(int buildingIndex = 0; buildingIndex < static_cast<int>(buildings.size()); ++buildingIndex)
+	{
+		occlusionBuffer.AddOccluder(buildings[buildingIndex]);
+	}
+	occlusionBuffer.RasterizeOccluders();
+
+	std::vector<int> visibleIndexes = frustumIndexes;
+	occlusionBuffer.CullOccludedAABB3s(boxesSoA, visibleIndexes);
+
+	if(jobSystem != nullptr)
+	{
+		SoftwareOcclusionBuffer jobsOcclusionBuffer;
+		jobsOcclusionBuffer.BeginFrame(worldToClip);
+		for(int buildingIndex = 0; buildingIndex < static_cast<int>(buildings.size()); ++buildingIndex)
+		{
+			jobsOcclusionBuffer.AddOccluder(buildings[buildingIndex]);
+		}
+		jobsOcclusionBuffer.RasterizeOccluders(jobSystem);
+
+		for(int pixelY = 0; pixelY < occlusionBuffer.GetHeight(); ++pixelY)
+		{
+			for(int pixelX = 0; pixelX < occlusionBuffer.GetWidth(); ++pixelX)
+			{
+				GUARANTEE_OR_RETURN_FALSE(jobsOcclusionBuffer.GetDepth(pixelX, pixelY) == occlusionBuffer.GetDepth(pixelX, pixelY), Stringf("SoftwareOcclusionBuffer: frame %d pixel (%d, %d) has depth %g rasterized on jobs, %g serially",
+								 frame, pixelX, pixelY, jobsOcclusionBuffer.GetDepth(pixelX, pixelY), occlusionBuffer.GetDepth(pixelX, pixelY)));
+			}
+		}
+
+		std::vector<int> jobsVisibleIndexes = frustumIndexes;
+		jobsOcclusionBuffer.CullOccludedAABB3s(boxesSoA, jobsVisibleIndexes);
+		GUARANTEE_OR_RETURN_FALSE(jobsVisibleIndexes == visibleIndexes, Stringf("SoftwareOcclusionBuffer: frame %d kept %d boxes rasterized on jobs, %d serially", frame, static_cast<int>(jobsVisibleIndexes.size()), static_cast<int>(visibleIndexes.size())));
+	}
+
+	// the survivors keep their order, so the culled boxes are the frustum indexes the walk skips
+	int numVisible = static_cast<int>(visibleIndexes.size());
+	int visibleSlot = 0;
+	for(int frustumSlot = 0; frustumSlot < static_cast<int>(frustumIndexes.size()); ++frustumSlot)
+	{
+		int boxIndex = frustumIndexes[frustumSlot];
+		if(visibleSlot < numVisible && visibleIndexes[visibleSlot] == boxIndex)
+		{
+			++visibleSlot;
+			continue;
+		}
+
+		Vec3 mins(boxesSoA.m_minX[boxIndex], boxesSoA.m_minY[boxIndex], boxesSoA.m_minZ[boxIndex]);
+		Vec3 maxs(boxesSoA.m_maxX[boxIndex], boxesSoA.m_maxY[boxIndex], boxesSoA.m_maxZ[boxIndex]);
+		Vec3 samplePoints[9] = { (mins + maxs) * 0.5f };
+		for(int cornerIndex = 0; cornerIndex < 8; ++cornerIndex)
+		{
+			samplePoints[cornerIndex + 1] = Vec3((cornerIndex & 1) ? maxs.x : mins.x, (cornerIndex & 2) ? maxs.y : mins.y, (cornerIndex & 4) ? maxs.z : mins.z);
+		}
+
+		for(Vec3 const& samplePoint : samplePoints)
+		{
+			Vec4 clip = worldToClip.TransformHomogeneous3D(Vec4(samplePoint.x, samplePoint.y, samplePoint.z, 1.f));
+			if(clip.w <= 0.f || fabsf(clip.x) > clip.w || fabsf(clip.y) > clip.w || clip.z < 0.f || clip.z > clip.w)
+			{
+				continue;
+			}
+
+			Vec3 toSample = samplePoint - cameraPosition;
+			float sampleDist = toSample.GetLength();
+			Vec3 sampleFwd = toSample / sampleDist;
+			bool isBlocked = false;
+			for(int buildingIndex = 0; buildingIndex < static_cast<int>(buildings.size()) && !isBlocked; ++buildingIndex)
+			{
+				RaycastResult3D result = RaycastVsAABB3D(cameraPosition, sampleFwd, sampleDist, buildings[buildingIndex]);
+				isBlocked = result.m_didImpact && result.m_impactDistance < sampleDist - 1e-3f;
+			}
+
+			GUARANTEE_OR_RETURN_FALSE(isBlocked, Stringf("SoftwareOcclusionBuffer: frame %d culled box %d, but the camera can see (%g, %g, %g)", frame, boxIndex, samplePoint.x, samplePoint.y, samplePoint.z));
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// A city block: a grid of tall buildings as occluders with small props scattered between and behind them. The camera
+// stands at street level and turns slowly, so most of the frustum survivors are behind some building.
+void RunOcclusionCullingBenchmarks(int numObjects, int numOccluders, int numFrames, JobSystem* jobSystem)
+{
+	if(numObjects <= 0 || numFrames <= 0)
+	{
+		return;
+	}
+
+	float const worldSize = 400.f;
+	int buildingsPerSide = GetMax(static_cast<int>(sqrtf(static_cast<float>(numOccluders))), 1);
+	float spacing = worldSize / static_cast<float>(buildingsPerSide);
+	std::vector<AABB3> buildings;
+	for(int buildingY = 0; buildingY < buildingsPerSide; ++buildingY)
+	{
+		for(int buildingX = 0; buildingX < buildingsPerSide; ++buildingX)
+		{
+			unsigned int hash = GetBenchmarkHash(static_cast<unsigned int>(buildingY * buildingsPerSide + buildingX));
+			Vec3 center((static_cast<float>(buildingX) + 0.5f) * spacing - 0.5f * worldSize, (static_cast<float>(buildingY) + 0.5f) * spacing - 0.5f * worldSize, 0.f);
+			float height = 20.f + static_cast<float>(hash & 0xFF) * 0.25f;
+			Vec3 halfSize(spacing * 0.35f, spacing * 0.35f, height * 0.5f);
+			center.z = halfSize.z;
+			buildings.push_back(AABB3(center - halfSize, center + halfSize));
+		}
+	}
+
+	std::vector<float> minXs(numObjects);
+	std::vector<float> minYs(numObjects);
+	std::vector<float> minZs(numObjects);
+	std::vector<float> maxXs(numObjects);
+	std::vector<float> maxYs(numObjects);
+	std::vector<float> maxZs(numObjects);
+	for(int index = 0; index < numObjects; ++index)
+	{
+		unsigned int hash = GetBenchmarkHash(static_cast<unsigned int>(index) + 0x10000000u);
+		float u = static_cast<float>(hash & 0x3FF) / 1023.f - 0.5f;
+		float v = static_cast<float>((hash >> 10) & 0x3FF) / 1023.f - 0.5f;
+		float w = static_cast<float>((hash >> 20) & 0x3FF) / 1023.f;
+		Vec3 halfSize(0.5f + w, 0.5f + w, 0.5f + w);
+		Vec3 center(u * worldSize, v * worldSize, halfSize.z);
+		minXs[index] = center.x - halfSize.x;
+		minYs[index] = center.y - halfSize.y;
+		minZs[index] = center.z - halfSize.z;
+		maxXs[index] = center.x + halfSize.x;
+		maxYs[index] = center.y + halfSize.y;
+		maxZs[index] = center.z + halfSize.z;
+	}
+
+	AABB3SoA boxesSoA;
+	boxesSoA.m_count = numObjects;
+	boxesSoA.m_minX = minXs.data();
+	boxesSoA.m_minY = minYs.data();
+	boxesSoA.m_minZ = minZs.data();
+	boxesSoA.m_maxX = maxXs.data();
+	boxesSoA.m_maxY = maxYs.data();
+	boxesSoA.m_maxZ = maxZs.data();
+
+	// camera in the street between the first two rows of buildings, 2 units up, looking along +x
+	Mat44 cameraToRender(Vec3(0.f, 0.f, 1.f), Vec3(-1.f, 0.f, 0.f), Vec3(0.f, 1.f, 0.f), Vec3(0.f, 0.f, 0.f));
+	Vec3 cameraPosition(0.f, spacing - 0.5f * worldSize, 2.f);
+	std::vector<Mat44> worldToClips(numFrames);
+	for(int frame = 0; frame < numFrames; ++frame)
+	{
+		Mat44 worldToClip = Mat44::MakePerspectiveProjection(60.f, 2.f, 0.1f, 400.f);
+		worldToClip.Append(cameraToRender);
+		worldToClip.Append(Mat44::MakeZRotationDegrees(static_cast<float>(frame) * -0.5f));
+		worldToClip.AppendTranslation3D(-cameraPosition);
+		worldToClips[frame] = worldToClip;
+	}
+
+	if(!CheckOcclusionCulling(0, worldToClips[0], cameraPosition, buildings, boxesSoA, jobSystem))
+	{
+		return;
+	}
+	if(!CheckOcclusionCulling(numFrames - 1, worldToClips[numFrames - 1], cameraPosition, buildings, boxesSoA, jobSystem))
+	{
+		return;
+	}
+
+	SoftwareOcclusionBuffer occlusionBuffer;
+	std::vector<int> visibleIndexes;
+	int numFrustumVisible = 0;
+	int numOcclusionVisible = 0;
+	double frustumSeconds = 0.0;
+	double rasterizeSeconds = 0.0;
+	double testSeconds = 0.0;
+
+	for(int frame = 0; frame < numFrames; ++frame)
+	{
+		double start = GetCurrentTimeSeconds();
+		numFrustumVisible += CullAABB3sToFrustum(Frustum::MakeFromWorldToClip(worldToClips[frame]), boxesSoA, visibleIndexes, jobSystem);
+		double frustumEnd = GetCurrentTimeSeconds();
+
+		occlusionBuffer.BeginFrame(worldToClips[frame]);
+		for(int buildingIndex = 0; buildingIndex < static_cast<int>(buildings.size()); ++buildingIndex)
+		{
+			occlusionBuffer.AddOccluder(buildings[buildingIndex]);
+		}
+		occlusionBuffer.RasterizeOccluders(jobSystem);
+		double rasterizeEnd = GetCurrentTimeSeconds();
+
+		numOcclusionVisible += occlusionBuffer.CullOccludedAABB3s(boxesSoA, visibleIndexes);
+		double testEnd = GetCurrentTimeSeconds();
+
+		frustumSeconds += frustumEnd - start;
+		rasterizeSeconds += rasterizeEnd - frustumEnd;
+		testSeconds += testEnd - rasterizeEnd;
+	}
+
+	double frames = static_cast<double>(numFrames);
+	DebuggerPrintf("Occlusion culling benchmarks (%d boxes, %d occluders, %dx%d buffer, %d frames)\n", numObjects, static_cast<int>(buildings.size()),
+				   occlusionBuffer.GetWidth(), occlusionBuffer.GetHeight(), numFrames);
+	DebuggerPrintf("  %-28s %8.3f ms / frame   (%.0f visible)\n", "frustum cull", frustumSeconds * 1000.0 / frames, numFrustumVisible / frames);
+	DebuggerPrintf("  %-28s %8.3f ms / frame\n", "rasterize occluders", rasterizeSeconds * 1000.0 / frames);
+	DebuggerPrintf("  %-28s %8.3f ms / frame   (%.0f visible)\n", "occlusion test", testSeconds * 1000.0 / frames, numOcclusionVisible / frames);
+
+	s_benchmarkSink = s_benchmarkSink + static_cast<float>(numFrustumVisible + numOcclusionVisible);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// The table's length and distance lookups against a polyline fine enough to stand in for the true arc length, and
+// SampleEvenlySpaced against one EvaluateAtDistance per point. Tolerances are fractions of one table interval's length.
+static bool CheckArcLengthTable(Spline const& spline, CurveArcLengthTable2D const& table, int numSubdivisionsPerCurve)
+{
+	int const numPolylineSegmentsPerCurve = 2048;
+	int const numCheckQueries = 257;
+	int const numCurves = static_cast<int>(spline.m_hermiteCurves.size());
+
+	std::vector<Vec2> polyline;
+	std::vector<double> polylineDistances;
+	polyline.push_back(spline.m_hermiteCurves[0].EvaluateAtParametric(0.f));
+	polylineDistances.push_back(0.0);
+	for(int curveIndex = 0; curveIndex < numCurves; ++curveIndex)
+	{
+		for(int segment = 1; segment <= numPolylineSegmentsPerCurve; ++segment)
+		{
+			Vec2 point = spline.m_hermiteCurves[curveIndex].EvaluateAtParametric(static_cast<float>(segment) / static_cast<float>(numPolylineSegmentsPerCurve));
+			polylineDistances.push_back(polylineDistances.back() + static_cast<double>((point - polyline.back()).GetLength()));
+			polyline.push_back(point);
+		}
+	}
+
+	float tableLength = table.GetLength();
+	float polylineLength = static_cast<float>(polylineDistances.back());
+	float intervalLength = tableLength / static_cast<float>(table.GetNumCurves() * numSubdivisionsPerCurve);
+	GUARANTEE_OR_RETURN_FALSE(fabsf(tableLength - polylineLength) <= 1e-5f * polylineLength, Stringf("CurveArcLengthTable2D: length %g, fine polyline %g", tableLength, polylineLength));
+
+	float maxLinearError = 0.f;
+	float maxRefinedError = 0.f;
+	for(int query = 0; query < numCheckQueries; ++query)
+	{
+		float distance = tableLength * static_cast<float>(query) / static_cast<float>(numCheckQueries - 1);
+		int segmentEnd = static_cast<int>(std::upper_bound(polylineDistances.begin(), polylineDistances.end(), static_cast<double>(distance)) - polylineDistances.begin());
+		segmentEnd = GetMin(GetMax(segmentEnd, 1), static_cast<int>(polyline.size()) - 1);
+		double segmentLength = polylineDistances[segmentEnd] - polylineDistances[segmentEnd - 1];
+		float fraction = segmentLength > 0.0 ? static_cast<float>((static_cast<double>(distance) - polylineDistances[segmentEnd - 1]) / segmentLength) : 0.f;
+		Vec2 expected = polyline[segmentEnd - 1] + (polyline[segmentEnd] - polyline[segmentEnd - 1]) * GetClampedZeroToOne(fraction);
+
+		maxLinearError = GetMax(maxLinearError, (table.EvaluateAtDistance(distance) - expected).GetLength());
+		maxRefinedError = GetMax(maxRefinedError, (table.EvaluateAtDistanceRefined(distance) - expected).GetLength());
+	}
+	GUARANTEE_OR_RETURN_FALSE(maxLinearError <= 0.1f * intervalLength, Stringf("CurveArcLengthTable2D: EvaluateAtDistance is %g from the fine polyline, table intervals are %g long", maxLinearError, intervalLength));
+	GUARANTEE_OR_RETURN_FALSE(maxRefinedError <= 0.01f * intervalLength, Stringf("CurveArcLengthTable2D: EvaluateAtDistanceRefined is %g from the fine polyline, table intervals are %g long", maxRefinedError, intervalLength));
+
+	std::vector<Vec2> points;
+	table.SampleEvenlySpaced(numCheckQueries, points);
+	float spacing = tableLength / static_cast<float>(numCheckQueries - 1);
+	for(int pointIndex = 0; pointIndex < numCheckQueries; ++pointIndex)
+	{
+		float distance = (pointIndex == numCheckQueries - 1) ? tableLength : static_cast<float>(pointIndex) * spacing;
+		float error = (points[pointIndex] - table.EvaluateAtDistance(distance)).GetLength();
+		GUARANTEE_OR_RETURN_FALSE(error <= 1e-4f * intervalLength, Stringf("CurveArcLengthTable2D: SampleEvenlySpaced point %d is %g from EvaluateAtDistance(%g)", pointIndex, error, distance));
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Distance queries along a spline: the old per-query walk that re-measures every curve against the cached arc-length
+// table, then N evenly spaced points from one table walk against N separate table lookups.
+void RunCurveBenchmarks(int numSplinePoints, int numQueries)
+{
+	if(numSplinePoints < 2 || numQueries <= 0)
+	{
+		return;
+	}
+
+	std::vector<Vec2> positions(numSplinePoints);
+	for(int index = 0; index < numSplinePoints; ++index)
+	{
+		float x = static_cast<float>(index) * 10.f;
+		float y = static_cast<float>(static_cast<int>(GetBenchmarkHash(index) % 21) - 10);
+		positions[index] = Vec2(x, y);
+	}
+
+	Spline spline(positions);
+	CurveArcLengthTable2D const& table = spline.GetArcLengthTable(64);
+	if(!CheckArcLengthTable(spline, table, 64))
+	{
+		return;
+	}
+	float totalLength = table.GetLength();
+	float spacing = totalLength / static_cast<float>(numQueries);
+	float sink = 0.f;
+
+	DebuggerPrintf("Curve benchmarks (%d curves, %d queries)\n", table.GetNumCurves(), numQueries);
+
+	// one point per query at increasing distances, as a path follower would ask
+	double scalarSeconds = 0.0;
+	{
+		double start = GetCurrentTimeSeconds();
+		for(int query = 0; query < numQueries; ++query)
+		{
+			float distanceLeft = static_cast<float>(query) * spacing;
+			for(int curveIndex = 0; curveIndex < static_cast<int>(spline.m_hermiteCurves.size()); ++curveIndex)
+			{
+				float length = spline.m_hermiteCurves[curveIndex].GetApproximateLength(64);
+				if(distanceLeft <= length)
+				{
+					sink += spline.m_hermiteCurves[curveIndex].EvaluateAtApproximateDistance(distanceLeft, 64).x;
+					break;
+				}
+				distanceLeft -= length;
+			}
+		}
+		scalarSeconds = GetCurrentTimeSeconds() - start;
+
+		start = GetCurrentTimeSeconds();
+		for(int query = 0; query < numQueries; ++query)
+		{
+			sink += table.EvaluateAtDistance(static_cast<float>(query) * spacing).x;
+		}
+		double tableSeconds = GetCurrentTimeSeconds() - start;
+		PrintBenchmarkResult("Table distance, linear", numQueries, "walk", scalarSeconds, "table", tableSeconds);
+
+		start = GetCurrentTimeSeconds();
+		for(int query = 0; query < numQueries; ++query)
+		{
+			sink += table.EvaluateAtDistanceRefined(static_cast<float>(query) * spacing).x;
+		}
+		double refinedSeconds = GetCurrentTimeSeconds() - start;
+		PrintBenchmarkResult("Table distance, refined", numQueries, "walk", scalarSeconds, "refined", refinedSeconds);
+	}
+
+	// the same distances as one bulk sample
+	{
+		std::vector<Vec2> points;
+		points.reserve(numQueries);
+
+		double start = GetCurrentTimeSeconds();
+		for(int query = 0; query < numQueries; ++query)
+		{
+			points.push_back(table.EvaluateAtDistance(static_cast<float>(query) * spacing));
+		}
+		double lookupSeconds = GetCurrentTimeSeconds() - start;
+		sink += points[numQueries / 2].y;
+		points.clear();
+
+		start = GetCurrentTimeSeconds();
+		table.SampleEvenlySpaced(numQueries, points);
+		double walkSeconds = GetCurrentTimeSeconds() - start;
+		sink += points[numQueries / 2].y;
+		PrintBenchmarkResult("SampleEvenlySpaced", numQueries, "lookups", lookupSeconds, "walk", walkSeconds);
+	}
+
+	s_benchmarkSink = s_benchmarkSink + sink;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// The keyed bake must reproduce the PieceWiseCurves map at the benchmark times, at every key and halfway between keys.
+// Uniform resampling blurs the jumps between segments, so it is only held to the map halfway between keys, where both
+// neighbouring samples lie on the same segment. EvaluateBatch must give exactly what Evaluate gives.
+static bool CheckBakedCurves(PieceWiseCurves& curves, BakedCurve1D const& baked, BakedCurve1D const& resampled, int numKeys, std::vector<float> const& ts)
+{
+	// PieceWiseCurves pads each segment's duration by 1e-5 when it takes the fraction, which moves its values (all in
+	// [0, 1] here) by up to 1e-5 divided by the segment duration; twice that leaves room for rounding
+	float const maxDifference = 2e-5f * static_cast<float>(numKeys + 1);
+
+	std::vector<float> checkTs = ts;
+	for(int keyIndex = 0; keyIndex < numKeys; ++keyIndex)
+	{
+		checkTs.push_back(static_cast<float>(keyIndex) / static_cast<float>(numKeys));
+		checkTs.push_back((static_cast<float>(keyIndex) + 0.5f) / static_cast<float>(numKeys));
+	}
+
+	int const numChecks = static_cast<int>(checkTs.size());
+	std::vector<float> bakedValues(numChecks);
+	std::vector<float> resampledValues(numChecks);
+	baked.EvaluateBatch(numChecks, checkTs.data(), bakedValues.data());
+	resampled.EvaluateBatch(numChecks, checkTs.data(), resampledValues.data());
+
+	for(int index = 0; index < numChecks; ++index)
+	{
+		float t = checkTs[index];
+		float expected = curves.Evaluate(t);
+		float bakedValue = baked.Evaluate(t);
+		GUARANTEE_OR_RETURN_FALSE(fabsf(bakedValue - expected) <= maxDifference, Stringf("BakedCurve1D: keyed Evaluate(%g) = %g, PieceWiseCurves %g", t, bakedValue, expected));
+		GUARANTEE_OR_RETURN_FALSE(bakedValues[index] == bakedValue, Stringf("BakedCurve1D: keyed EvaluateBatch at %g gave %g, Evaluate %g", t, bakedValues[index], bakedValue));
+		GUARANTEE_OR_RETURN_FALSE(resampledValues[index] == resampled.Evaluate(t), Stringf("BakedCurve1D: uniform EvaluateBatch at %g gave %g, Evaluate %g", t, resampledValues[index], resampled.Evaluate(t)));
+	}
+
+	for(int keyIndex = 0; keyIndex < numKeys; ++keyIndex)
+	{
+		float t = (static_cast<float>(keyIndex) + 0.5f) / static_cast<float>(numKeys);
+		float expected = curves.Evaluate(t);
+		GUARANTEE_OR_RETURN_FALSE(fabsf(resampled.Evaluate(t) - expected) <= maxDifference, Stringf("BakedCurve1D: uniform Evaluate(%g) = %g, PieceWiseCurves %g", t, resampled.Evaluate(t), expected));
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// PieceWiseCurves::Evaluate (a std::map lookup and a virtual call) against the baked copy, keyed and resampled, one
+// call per value and as a batch. The ts are scrambled so the keyed search cannot ride the branch predictor.
+void RunPieceWiseCurveBenchmarks(int numKeys, int numEvaluations)
+{
+	if(numKeys <= 0 || numEvaluations <= 0)
+	{
+		return;
+	}
+
+	PieceWiseCurves curves;
+	for(int keyIndex = 0; keyIndex < numKeys; ++keyIndex)
+	{
+		float startValue = static_cast<float>(GetBenchmarkHash(keyIndex) % 100) * 0.01f;
+		float endValue = static_cast<float>(GetBenchmarkHash(keyIndex + numKeys) % 100) * 0.01f;
+		curves.AddCurve(LinearCurve1D(startValue, endValue), static_cast<float>(keyIndex) / static_cast<float>(numKeys));
+	}
+
+	std::vector<float> ts(numEvaluations);
+	for(int index = 0; index < numEvaluations; ++index)
+	{
+		ts[index] = static_cast<float>(GetBenchmarkHash(index) % 65536) / 65536.f;
+	}
+
+	std::vector<float> values(numEvaluations);
+	BakedCurve1D baked(curves);
+	BakedCurve1D resampled(curves);
+	resampled.ResampleUniform(numKeys * 32 + 1);
+	if(!CheckBakedCurves(curves, baked, resampled, numKeys, ts))
+	{
+		return;
+	}
+	float sink = 0.f;
+
+	DebuggerPrintf("Piecewise curve benchmarks (%d keys, %d evaluations)\n", numKeys, numEvaluations);
+
+	double start = GetCurrentTimeSeconds();
+	for(int index = 0; index < numEvaluations; ++index)
+	{
+		values[index] = curves.Evaluate(ts[index]);
+	}
+	double scalarSeconds = GetCurrentTimeSeconds() - start;
+	sink += values[numEvaluations / 2];
+
+	start = GetCurrentTimeSeconds();
+	for(int index = 0; index < numEvaluations; ++index)
+	{
+		values[index] = baked.Evaluate(ts[index]);
+	}
+	double keyedSeconds = GetCurrentTimeSeconds() - start;
+	sink += values[numEvaluations / 2];
+	PrintBenchmarkResult("BakedCurve1D keyed", numEvaluations, "map", scalarSeconds, "baked", keyedSeconds);
+
+	start = GetCurrentTimeSeconds();
+	baked.EvaluateBatch(numEvaluations, ts.data(), values.data());
+	double keyedBatchSeconds = GetCurrentTimeSeconds() - start;
+	sink += values[numEvaluations / 2];
+	PrintBenchmarkResult("BakedCurve1D keyed batch", numEvaluations, "map", scalarSeconds, "batch", keyedBatchSeconds);
+
+	start = GetCurrentTimeSeconds();
+	resampled.EvaluateBatch(numEvaluations, ts.data(), values.data());
+	double uniformBatchSeconds = GetCurrentTimeSeconds() - start;
+	sink += values[numEvaluations / 2];
+	PrintBenchmarkResult("BakedCurve1D uniform batch", numEvaluations, "map", scalarSeconds, "uniform", uniformBatchSeconds);
+
+	s_benchmarkSink = s_benchmarkSink + sink;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Ten-bucket histogram of values already scaled to [0, 10); every bucket must hold its share to within 5%, which is
+// several standard deviations at the sizes used here.
+static bool CheckRandomHistogram(char const* functionName, std::vector<int> const& buckets)
+{
+	int const numBuckets = static_cast<int>(buckets.size());
+	int total = 0;
+	for(int bucket = 0; bucket < numBuckets; ++bucket)
+	{
+		total += buckets[bucket];
+	}
+
+	float expected = static_cast<float>(total) / static_cast<float>(numBuckets);
+	for(int bucket = 0; bucket < numBuckets; ++bucket)
+	{
+		GUARANTEE_OR_RETURN_FALSE(fabsf(static_cast<float>(buckets[bucket]) - expected) <= 0.05f * expected, Stringf("%s: bucket %d of %d holds %d values, expected about %.0f", functionName, bucket, numBuckets, buckets[bucket], expected));
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Seeding must be reproducible, stream indexes must give different sequences, every result must land in its range and
+// spread evenly over it, and the Fill functions must give exactly what their documentation promises: one roll as the
+// key, then NoiseRandomNumberGenerator positions 0, 1, 2... from it.
+static bool CheckRandomNumberGenerators()
+{
+	int const numChecks = 100000;
+
+	RandomNumberGenerator rngA(777, 3);
+	RandomNumberGenerator rngB(777, 3);
+	RandomNumberGenerator otherStream(777, 4);
+	int numStreamMatches = 0;
+	for(int index = 0; index < 1000; ++index)
+	{
+		unsigned int value = rngA.RollUInt();
+		GUARANTEE_OR_RETURN_FALSE(rngB.RollUInt() == value, Stringf("RandomNumberGenerator: two generators seeded alike differ at roll %d", index));
+		numStreamMatches += otherStream.RollUInt() == value ? 1 : 0;
+	}
+	GUARANTEE_OR_RETURN_FALSE(numStreamMatches < 10, Stringf("RandomNumberGenerator: stream indexes 3 and 4 agree on %d of 1000 rolls", numStreamMatches));
+
+	std::vector<int> floatBuckets(10, 0);
+	std::vector<int> intBuckets(10, 0);
+	for(int index = 0; index < numChecks; ++index)
+	{
+		float value = rngA.RollFloatZeroToOne();
+		GUARANTEE_OR_RETURN_FALSE(value >= 0.f && value < 1.f, Stringf("RandomNumberGenerator: RollFloatZeroToOne gave %.9g", value));
+		++floatBuckets[static_cast<int>(value * 10.f)];
+
+		int intValue = rngA.RollIntLessThan(10);
+		GUARANTEE_OR_RETURN_FALSE(intValue >= 0 && intValue < 10, Stringf("RandomNumberGenerator: RollIntLessThan(10) gave %d", intValue));
+		++intBuckets[intValue];
+
+		intValue = rngA.RollIntInRangeOf(-3, 3);
+		GUARANTEE_OR_RETURN_FALSE(intValue >= -3 && intValue <= 3, Stringf("RandomNumberGenerator: RollIntInRangeOf(-3, 3) gave %d", intValue));
+	}
+	if(!CheckRandomHistogram("RollFloatZeroToOne", floatBuckets))
+	{
+		return false;
+	}
+	if(!CheckRandomHistogram("RollIntLessThan", intBuckets))
+	{
+		return false;
+	}
+
+	// rngB mirrors rngA's fills one roll at a time
+	rngB = rngA;
+	std::vector<float> floats(numChecks);
+	std::vector<int> ints(numChecks);
+	rngA.FillFloatsZeroToOne(numChecks, floats.data());
+	NoiseRandomNumberGenerator floatKey(rngB.RollUInt());
+	rngA.FillIntsLessThan(numChecks, 10, ints.data());
+	NoiseRandomNumberGenerator intKey(rngB.RollUInt());
+	GUARANTEE_OR_RETURN_FALSE(rngA.RollUInt() == rngB.RollUInt(), "RandomNumberGenerator: a Fill advanced the generator by more than one roll");
+
+	floatBuckets.assign(10, 0);
+	intBuckets.assign(10, 0);
+	for(int index = 0; index < numChecks; ++index)
+	{
+		GUARANTEE_OR_RETURN_FALSE(floats[index] == floatKey.GetFloatZeroToOneAtPosition(index), Stringf("RandomNumberGenerator: FillFloatsZeroToOne value %d is %.9g, its key's position gives %.9g", index, floats[index], floatKey.GetFloatZeroToOneAtPosition(index)));
+		GUARANTEE_OR_RETURN_FALSE(floats[index] >= 0.f && floats[index] < 1.f, Stringf("RandomNumberGenerator: FillFloatsZeroToOne gave %.9g", floats[index]));
+		++floatBuckets[static_cast<int>(floats[index] * 10.f)];
+
+		GUARANTEE_OR_RETURN_FALSE(ints[index] == intKey.GetIntLessThanAtPosition(index, 10), Stringf("RandomNumberGenerator: FillIntsLessThan value %d is %d, its key's position gives %d", index, ints[index], intKey.GetIntLessThanAtPosition(index, 10)));
+		GUARANTEE_OR_RETURN_FALSE(ints[index] >= 0 && ints[index] < 10, Stringf("RandomNumberGenerator: FillIntsLessThan(10) gave %d", ints[index]));
+		++intBuckets[ints[index]];
+	}
+	if(!CheckRandomHistogram("FillFloatsZeroToOne", floatBuckets))
+	{
+		return false;
+	}
+	if(!CheckRandomHistogram("FillIntsLessThan", intBuckets))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// The old rand()-based rolls against the per-instance generator, one call per value and as a bulk fill
+void RunRandomBenchmarks(int numValues)
+{
+	if(numValues <= 0)
+	{
+		return;
+	}
+
+	if(!CheckRandomNumberGenerators())
+	{
+		return;
+	}
+
+	std::vector<float> floats(numValues);
+	std::vector<int> ints(numValues);
+	RandomNumberGenerator rng(12345);
+	float sink = 0.f;
+
+	DebuggerPrintf("Random number benchmarks (%d values)\n", numValues);
+
+	{
+		double start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numValues; ++index)
+		{
+			floats[index] = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+		}
+		double scalarSeconds = GetCurrentTimeSeconds() - start;
+		sink += floats[numValues / 2];
+
+		start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numValues; ++index)
+		{
+			floats[index] = rng.RollFloatZeroToOne();
+		}
+		double rollSeconds = GetCurrentTimeSeconds() - start;
+		sink += floats[numValues / 2];
+		PrintBenchmarkResult("RollFloatZeroToOne", numValues, "rand()", scalarSeconds, "roll", rollSeconds);
+
+		start = GetCurrentTimeSeconds();
+		rng.FillFloatsZeroToOne(numValues, floats.data());
+		double fillSeconds = GetCurrentTimeSeconds() - start;
+		sink += floats[numValues / 2];
+		PrintBenchmarkResult("FillFloatsZeroToOne", numValues, "rand()", scalarSeconds, "fill", fillSeconds);
+	}
+
+	{
+		double start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numValues; ++index)
+		{
+			ints[index] = rand() % 1000;
+		}
+		double scalarSeconds = GetCurrentTimeSeconds() - start;
+		sink += static_cast<float>(ints[numValues / 2]);
+
+		start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numValues; ++index)
+		{
+			ints[index] = rng.RollIntLessThan(1000);
+		}
+		double rollSeconds = GetCurrentTimeSeconds() - start;
+		sink += static_cast<float>(ints[numValues / 2]);
+		PrintBenchmarkResult("RollIntLessThan", numValues, "rand()", scalarSeconds, "roll", rollSeconds);
+
+		start = GetCurrentTimeSeconds();
+		rng.FillIntsLessThan(numValues, 1000, ints.data());
+		double fillSeconds = GetCurrentTimeSeconds() - start;
+		sink += static_cast<float>(ints[numValues / 2]);
+		PrintBenchmarkResult("FillIntsLessThan", numValues, "rand()", scalarSeconds, "fill", fillSeconds);
+	}
+
+	s_benchmarkSink = s_benchmarkSink + sink;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// BatchNoise.hpp promises every batch sample is bit-for-bit the scalar function's, so any difference at all is fatal.
+static bool CheckNoiseMatchesScalar(char const* gridName, std::vector<float> const& scalarNoise, std::vector<float> const& noise, int numSamples)
+{
+	for(int index = 0; index < numSamples; ++index)
+	{
+		GUARANTEE_OR_RETURN_FALSE(noise[index] == scalarNoise[index], Stringf("%s: sample %d is %.9g, the scalar function gives %.9g", gridName, index, noise[index], scalarNoise[index]));
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// A heightmap's worth of 2D noise and a chunk's worth of 3D noise, one scalar call per sample against the batch grids.
+// Every batch and job sample is checked against the scalar call for the same position.
+void RunFractalNoiseBenchmarks(int gridSize, int numOctaves, JobSystem* jobSystem)
+{
+	unsigned int octaves = static_cast<unsigned int>(numOctaves);
+	IntVec2 dims2d(gridSize, gridSize);
+	IntVec3 dims3d(gridSize / 8, gridSize / 8, gridSize / 8);
+	int numSamples2d = dims2d.x * dims2d.y;
+	int numSamples3d = dims3d.x * dims3d.y * dims3d.z;
+	Vec2 origin2d(-317.5f, 1024.25f);
+	Vec3 origin3d(-40.f, 12.5f, -7.75f);
+	std::vector<float> scalarNoise(GetMax(numSamples2d, numSamples3d));
+	std::vector<float> batchNoise(scalarNoise.size());
+	std::vector<float> jobNoise(scalarNoise.size());
+	float sink = 0.f;
+
+	DebuggerPrintf("Fractal noise benchmarks (%d octaves)\n", numOctaves);
+
+	{
+		double start = GetCurrentTimeSeconds();
+		for(int y = 0; y < dims2d.y; ++y)
+		{
+			for(int x = 0; x < dims2d.x; ++x)
+			{
+				float posX = origin2d.x + static_cast<float>(x);
+				float posY = origin2d.y + static_cast<float>(y);
+				scalarNoise[y * dims2d.x + x] = Compute2dFractalNoise(posX, posY, 200.f, octaves);
+			}
+		}
+		double scalarSeconds = GetCurrentTimeSeconds() - start;
+
+		start = GetCurrentTimeSeconds();
+		Compute2dFractalNoiseGrid(dims2d, origin2d, Vec2(1.f, 1.f), batchNoise.data(), 200.f, octaves);
+		double batchSeconds = GetCurrentTimeSeconds() - start;
+		if(!CheckNoiseMatchesScalar("Compute2dFractalNoiseGrid", scalarNoise, batchNoise, numSamples2d))
+		{
+			return;
+		}
+		PrintBenchmarkResult("2D noise grid", numSamples2d, "scalar", scalarSeconds, "batch", batchSeconds);
+		sink += batchNoise[numSamples2d / 2];
+
+		if(jobSystem != nullptr)
+		{
+			start = GetCurrentTimeSeconds();
+			Compute2dFractalNoiseGrid(dims2d, origin2d, Vec2(1.f, 1.f), jobNoise.data(), 200.f, octaves, 0.5f, 2.f, true, 0, jobSystem);
+			double jobSeconds = GetCurrentTimeSeconds() - start;
+			if(!CheckNoiseMatchesScalar("Compute2dFractalNoiseGrid with jobs", scalarNoise, jobNoise, numSamples2d))
+			{
+				return;
+			}
+			PrintBenchmarkResult("2D noise grid + jobs", numSamples2d, "scalar", scalarSeconds, "jobs", jobSeconds);
+			sink += jobNoise[numSamples2d / 2];
+		}
+	}
+
+	{
+		double start = GetCurrentTimeSeconds();
+		for(int z = 0; z < dims3d.z; ++z)
+		{
+			for(int y = 0; y < dims3d.y; ++y)
+			{
+				for(int x = 0; x < dims3d.x; ++x)
+				{
+					float posX = origin3d.x + static_cast<float>(x);
+					float posY = origin3d.y + static_cast<float>(y);
+					float posZ = origin3d.z + static_cast<float>(z);
+					scalarNoise[(z * dims3d.y + y) * dims3d.x + x] = Compute3dFractalNoise(posX, posY, posZ, 20.f, octaves);
+				}
+			}
+		}
+		double scalarSeconds = GetCurrentTimeSeconds() - start;
+
+		start = GetCurrentTimeSeconds();
+		Compute3dFractalNoiseGrid(dims3d, origin3d, Vec3(1.f, 1.f, 1.f), batchNoise.data(), 20.f, octaves);
+		double batchSeconds = GetCurrentTimeSeconds() - start;
+		if(!CheckNoiseMatchesScalar("Compute3dFractalNoiseGrid", scalarNoise, batchNoise, numSamples3d))
+		{
+			return;
+		}
+		PrintBenchmarkResult("3D noise grid", numSamples3d, "scalar", scalarSeconds, "batch", batchSeconds);
+		sink += batchNoise[numSamples3d / 2];
+
+		if(jobSystem != nullptr)
+		{
+			start = GetCurrentTimeSeconds();
+			Compute3dFractalNoiseGrid(dims3d, origin3d, Vec3(1.f, 1.f, 1.f), jobNoise.data(), 20.f, octaves, 0.5f, 2.f, true, 0, jobSystem);
+			double jobSeconds = GetCurrentTimeSeconds() - start;
+			if(!CheckNoiseMatchesScalar("Compute3dFractalNoiseGrid with jobs", scalarNoise, jobNoise, numSamples3d))
+			{
+				return;
+			}
+			PrintBenchmarkResult("3D noise grid + jobs", numSamples3d, "scalar", scalarSeconds, "jobs", jobSeconds);
+			sink += jobNoise[numSamples3d / 2];
+		}
+	}
+
+	s_benchmarkSink = s_benchmarkSink + sink;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static float GetBenchmarkFraction(int index, unsigned int channel)
+{
+	return static_cast<float>(GetBenchmarkHash(static_cast<unsigned int>(index) * 16u + channel) & 0xFFFF) / 65535.f;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static OBB3 MakeBenchmarkOBB3(int index, Vec3 const& center)
+{
+	Vec3 iBasis = Vec3::MakeFromPolarDegrees(120.f * GetBenchmarkFraction(index, 10) - 60.f, 360.f * GetBenchmarkFraction(index, 11));
+	Vec3 jBasis = CrossProduct3D(Vec3(0.f, 0.f, 1.f), iBasis).GetNormalized();
+	Vec3 halfDimensions(0.3f + GetBenchmarkFraction(index, 12), 0.3f + GetBenchmarkFraction(index, 13), 0.3f + GetBenchmarkFraction(index, 14));
+	return OBB3(center, iBasis, jBasis, halfDimensions);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Distance between the shapes, or minus the penetration depth when they overlap.
+static float GetSignedSeparation3D(ConvexSupport3D const& shapeA, ConvexSupport3D const& shapeB)
+{
+	ConvexDistance3D distance = GetConvexShapesDistance3D(shapeA, shapeB);
+	return distance.m_areOverlapping ? -GetConvexShapesPenetration3D(shapeA, shapeB).m_depth : distance.m_distance;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static float GetSignedSeparation2D(ConvexSupport2D const& shapeA, ConvexSupport2D const& shapeB)
+{
+	ConvexDistance2D distance = GetConvexShapesDistance2D(shapeA, shapeB);
+	return distance.m_areOverlapping ? -GetConvexShapesPenetration2D(shapeA, shapeB).m_depth : distance.m_distance;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// A special-case test and GJK may only disagree about a pair that is touching to within GJK's accuracy, about 1e-4 of
+// the shapes' size; these shapes are around a unit across.
+static bool CheckOverlapDisagreement(char const* pairName, int index, bool isSpecialOverlap, float signedSeparation)
+{
+	float const maxTouchingSeparation = 1e-3f;
+	GUARANTEE_OR_RETURN_FALSE(fabsf(signedSeparation) <= maxTouchingSeparation, Stringf("%s: the special case says pair %d %s and GJK disagrees, but the shapes are %g apart (negative is penetration)",
+					 pairName, index, isSpecialOverlap ? "overlaps" : "is apart", signedSeparation));
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Shape pairs scattered so that roughly half of them overlap. Each special-case test runs against GJK on the same
+// pairs; OBB3 pairs have no special case, so those compare GJK with and without a simplex cache while every pair
+// drifts a little each frame, and time EPA on the ones that overlap.
+void RunConvexCollisionBenchmarks(int numPairs)
+{
+	if(numPairs <= 0)
+	{
+		return;
+	}
+
+	std::vector<Sphere> spheres(numPairs);
+	std::vector<OBB3> obbs(numPairs);
+	std::vector<OBB3> otherObbs(numPairs);
+	std::vector<Cylinder3D> cylinders(numPairs);
+	std::vector<AABB3> boxes(numPairs);
+	std::vector<ConvexHull2> hulls(numPairs);
+	std::vector<Vec2> points(numPairs);
+	for(int index = 0; index < numPairs; ++index)
+	{
+		Vec3 offset(4.f * GetBenchmarkFraction(index, 0) - 2.f, 4.f * GetBenchmarkFraction(index, 1) - 2.f, 4.f * GetBenchmarkFraction(index, 2) - 2.f);
+		spheres[index] = Sphere(offset, 0.2f + GetBenchmarkFraction(index, 3));
+		obbs[index] = MakeBenchmarkOBB3(index, Vec3());
+		otherObbs[index] = MakeBenchmarkOBB3(index + numPairs, offset * 0.75f);
+		cylinders[index] = Cylinder3D(offset - Vec3(0.f, 0.f, 1.f), 0.5f + 2.f * GetBenchmarkFraction(index, 4), 0.2f + GetBenchmarkFraction(index, 5));
+		boxes[index] = AABB3(Vec3(-1.f, -0.5f, -0.75f), Vec3(0.5f, 1.f, 0.75f));
+
+		int numSides = 3 + static_cast<int>(GetBenchmarkHash(static_cast<unsigned int>(index)) % 6);
+		std::vector<Vec2> polyPositions(numSides);
+		for(int sideIndex = 0; sideIndex < numSides; ++sideIndex)
+		{
+			polyPositions[sideIndex] = Vec2::MakeFromPolarDegrees(360.f * static_cast<float>(sideIndex) / static_cast<float>(numSides), 1.f);
+		}
+		hulls[index] = ConvexHull2(ConvexPoly2(polyPositions));
+		points[index] = Vec2(offset.x * 0.75f, offset.y * 0.75f);
+	}
+
+	DebuggerPrintf("Convex collision benchmarks (%d pairs; special case vs GJK)\n", numPairs);
+
+	{
+		int numSpecialOverlaps = 0;
+		int numGJKOverlaps = 0;
+		double start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numPairs; ++index)
+		{
+			numSpecialOverlaps += DoesSphereAndOBB3Overlap(spheres[index], obbs[index]) ? 1 : 0;
+		}
+		double specialSeconds = GetCurrentTimeSeconds() - start;
+
+		start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numPairs; ++index)
+		{
+			numGJKOverlaps += DoConvexShapesOverlap3D(SphereSupport(spheres[index]), OBB3Support(obbs[index])) ? 1 : 0;
+		}
+		double gjkSeconds = GetCurrentTimeSeconds() - start;
+		PrintBenchmarkResult("Sphere vs OBB3", numPairs, "special", specialSeconds, "gjk", gjkSeconds);
+
+		for(int index = 0; index < numPairs; ++index)
+		{
+			SphereSupport sphereSupport(spheres[index]);
+			OBB3Support obbSupport(obbs[index]);
+			bool isSpecialOverlap = DoesSphereAndOBB3Overlap(spheres[index], obbs[index]);
+			bool isGJKOverlap = DoConvexShapesOverlap3D(sphereSupport, obbSupport);
+			if(isSpecialOverlap != isGJKOverlap)
+			{
+				if(!CheckOverlapDisagreement("Sphere vs OBB3", index, isSpecialOverlap, GetSignedSeparation3D(sphereSupport, obbSupport)))
+				{
+					return;
+				}
+			}
+		}
+		DebuggerPrintf("  %-28s %d / %d\n", "  overlapping", numSpecialOverlaps, numGJKOverlaps);
+	}
+
+	{
+		int numSpecialOverlaps = 0;
+		int numGJKOverlaps = 0;
+		double start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numPairs; ++index)
+		{
+			numSpecialOverlaps += DoesCylinderAndBoxOverlap(cylinders[index], boxes[index]) ? 1 : 0;
+		}
+		double specialSeconds = GetCurrentTimeSeconds() - start;
+
+		start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numPairs; ++index)
+		{
+			numGJKOverlaps += DoConvexShapesOverlap3D(Cylinder3DSupport(cylinders[index]), AABB3Support(boxes[index])) ? 1 : 0;
+		}
+		double gjkSeconds = GetCurrentTimeSeconds() - start;
+		PrintBenchmarkResult("Cylinder3D vs AABB3", numPairs, "special", specialSeconds, "gjk", gjkSeconds);
+
+		for(int index = 0; index < numPairs; ++index)
+		{
+			Cylinder3DSupport cylinderSupport(cylinders[index]);
+			AABB3Support boxSupport(boxes[index]);
+			bool isSpecialOverlap = DoesCylinderAndBoxOverlap(cylinders[index], boxes[index]);
+			bool isGJKOverlap = DoConvexShapesOverlap3D(cylinderSupport, boxSupport);
+			if(isSpecialOverlap != isGJKOverlap)
+			{
+				if(!CheckOverlapDisagreement("Cylinder3D vs AABB3", index, isSpecialOverlap, GetSignedSeparation3D(cylinderSupport, boxSupport)))
+				{
+					return;
+				}
+			}
+		}
+		DebuggerPrintf("  %-28s %d / %d\n", "  overlapping", numSpecialOverlaps, numGJKOverlaps);
+	}
+
+	{
+		std::vector<ConvexHull2Support> hullSupports;
+		hullSupports.reserve(numPairs);
+		for(int index = 0; index < numPairs; ++index)
+		{
+			hullSupports.emplace_back(hulls[index]);
+		}
+
+		int numSpecialInside = 0;
+		int numGJKInside = 0;
+		double start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numPairs; ++index)
+		{
+			numSpecialInside += IsPointInsideConvexHull2(points[index], hulls[index]) ? 1 : 0;
+		}
+		double specialSeconds = GetCurrentTimeSeconds() - start;
+
+		std::vector<Vec2> pointPosition(1);
+		start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numPairs; ++index)
+		{
+			pointPosition[0] = points[index];
+			numGJKInside += DoConvexShapesOverlap2D(hullSupports[index], ConvexPoly2Support(pointPosition)) ? 1 : 0;
+		}
+		double gjkSeconds = GetCurrentTimeSeconds() - start;
+		PrintBenchmarkResult("Point vs ConvexHull2", numPairs, "special", specialSeconds, "gjk", gjkSeconds);
+
+		for(int index = 0; index < numPairs; ++index)
+		{
+			pointPosition[0] = points[index];
+			ConvexPoly2Support pointSupport(pointPosition);
+			bool isSpecialInside = IsPointInsideConvexHull2(points[index], hulls[index]);
+			bool isGJKInside = DoConvexShapesOverlap2D(hullSupports[index], pointSupport);
+			if(isSpecialInside != isGJKInside)
+			{
+				if(!CheckOverlapDisagreement("Point vs ConvexHull2", index, isSpecialInside, GetSignedSeparation2D(hullSupports[index], pointSupport)))
+				{
+					return;
+				}
+			}
+		}
+		DebuggerPrintf("  %-28s %d / %d\n", "  inside", numSpecialInside, numGJKInside);
+	}
+
+	{
+		constexpr int NUM_FRAMES = 8;
+		std::vector<ConvexSimplexCache3D> caches(numPairs);
+		std::vector<ConvexDistance3D> coldDistances(numPairs);
+		std::vector<ConvexDistance3D> warmDistances(numPairs);
+		int numColdOverlaps = 0;
+		int numWarmOverlaps = 0;
+		int numColdIterations = 0;
+		int numWarmIterations = 0;
+		double coldSeconds = 0.0;
+		double warmSeconds = 0.0;
+		for(int frame = 0; frame < NUM_FRAMES; ++frame)
+		{
+			Vec3 drift(0.01f * static_cast<float>(frame), -0.005f * static_cast<float>(frame), 0.f);
+			std::vector<OBB3Support> supportsA;
+			std::vector<OBB3Support> supportsB;
+			supportsA.reserve(numPairs);
+			supportsB.reserve(numPairs);
+			for(int index = 0; index < numPairs; ++index)
+			{
+				OBB3 movedBox = otherObbs[index];
+				movedBox.m_center += drift;
+				supportsA.emplace_back(obbs[index]);
+				supportsB.emplace_back(movedBox);
+			}
+
+			double start = GetCurrentTimeSeconds();
+			for(int index = 0; index < numPairs; ++index)
+			{
+				coldDistances[index] = GetConvexShapesDistance3D(supportsA[index], supportsB[index]);
+				numColdOverlaps += coldDistances[index].m_areOverlapping ? 1 : 0;
+				numColdIterations += coldDistances[index].m_numIterations;
+			}
+			coldSeconds += GetCurrentTimeSeconds() - start;
+
+			start = GetCurrentTimeSeconds();
+			for(int index = 0; index < numPairs; ++index)
+			{
+				warmDistances[index] = GetConvexShapesDistance3D(supportsA[index], supportsB[index], &caches[index]);
+				numWarmOverlaps += warmDistances[index].m_areOverlapping ? 1 : 0;
+				numWarmIterations += warmDistances[index].m_numIterations;
+			}
+			warmSeconds += GetCurrentTimeSeconds() - start;
+
+			// a warm start may only change how fast the answer is found, not the answer
+			for(int index = 0; index < numPairs; ++index)
+			{
+				ConvexDistance3D const& cold = coldDistances[index];
+				ConvexDistance3D const& warm = warmDistances[index];
+				GUARANTEE_OR_RETURN(fabsf(warm.m_distance - cold.m_distance) <= 1e-3f && (warm.m_areOverlapping == cold.m_areOverlapping || cold.m_distance <= 1e-3f),
+								 Stringf("OBB3 distance: frame %d pair %d is %g apart (overlapping %d) with the cache, %g (overlapping %d) without", frame, index, warm.m_distance, warm.m_areOverlapping ? 1 : 0, cold.m_distance, cold.m_areOverlapping ? 1 : 0));
+			}
+		}
+
+		int numQueries = numPairs * NUM_FRAMES;
+		PrintBenchmarkResult("OBB3 distance, cached", numQueries, "cold", coldSeconds, "cached", warmSeconds);
+		DebuggerPrintf("  %-28s %.2f / %.2f iterations, %d / %d overlapping\n", "", static_cast<double>(numColdIterations) / numQueries, static_cast<double>(numWarmIterations) / numQueries, numColdOverlaps, numWarmOverlaps);
+
+		int numPenetrating = 0;
+		float totalDepth = 0.f;
+		double start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numPairs; ++index)
+		{
+			ConvexPenetration3D penetration = GetConvexShapesPenetration3D(OBB3Support(obbs[index]), OBB3Support(otherObbs[index]));
+			numPenetrating += penetration.m_areOverlapping ? 1 : 0;
+			totalDepth += penetration.m_depth;
+		}
+		double penetrationSeconds = GetCurrentTimeSeconds() - start;
+		DebuggerPrintf("  %-28s %8.2f ns per pair, %d penetrating\n", "OBB3 penetration (EPA)", penetrationSeconds * 1e9 / numPairs, numPenetrating);
+
+		// pushing B out along the normal by the depth must leave the boxes just touching
+		for(int index = 0; index < numPairs; ++index)
+		{
+			OBB3Support supportA(obbs[index]);
+			ConvexPenetration3D penetration = GetConvexShapesPenetration3D(supportA, OBB3Support(otherObbs[index]));
+			if(!penetration.m_areOverlapping)
+			{
+				continue;
+			}
+
+			OBB3 pushedBox = otherObbs[index];
+			pushedBox.m_center += penetration.m_normal * (penetration.m_depth + 1e-3f);
+			GUARANTEE_OR_RETURN(!DoConvexShapesOverlap3D(supportA, OBB3Support(pushedBox)), Stringf("OBB3 penetration: pair %d still overlaps after being pushed %g along the normal", index, penetration.m_depth + 1e-3f));
+
+			pushedBox = otherObbs[index];
+			pushedBox.m_center += penetration.m_normal * (penetration.m_depth - 1e-3f);
+			GUARANTEE_OR_RETURN(penetration.m_depth <= 1e-3f || DoConvexShapesOverlap3D(supportA, OBB3Support(pushedBox)), Stringf("OBB3 penetration: pair %d is %g deep, but already apart when pushed %g", index, penetration.m_depth, penetration.m_depth - 1e-3f));
+		}
+		s_benchmarkSink = s_benchmarkSink + totalDepth;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Fast projectiles against a thin wall in one frame: discrete overlap tests at fixed substeps (which let most of them
+// tunnel through) vs a single sweep each. Then one sphere swept against a field of boxes, one box at a time vs the
+// batched closest-hit query.
+void RunSweptCollisionBenchmarks(int numProjectiles, int numBoxes)
+{
+	if(numProjectiles <= 0 || numBoxes <= 0)
+	{
+		return;
+	}
+
+	constexpr int NUM_SUBSTEPS = 8;
+	constexpr float PROJECTILE_RADIUS = 0.1f;
+	constexpr float FRAME_DISTANCE = 12.f;
+	AABB3 wall(Vec3(0.f, -5.f, -5.f), Vec3(0.2f, 5.f, 5.f));
+
+	std::vector<Vec3> starts(numProjectiles);
+	std::vector<Vec3> directions(numProjectiles);
+	for(int index = 0; index < numProjectiles; ++index)
+	{
+		starts[index] = Vec3(-10.f + 4.f * GetBenchmarkFraction(index, 0), 8.f * GetBenchmarkFraction(index, 1) - 4.f, 8.f * GetBenchmarkFraction(index, 2) - 4.f);
+		directions[index] = Vec3(1.f, 0.2f * GetBenchmarkFraction(index, 3) - 0.1f, 0.2f * GetBenchmarkFraction(index, 4) - 0.1f).GetNormalized();
+	}
+
+	DebuggerPrintf("Swept collision benchmarks (%d projectiles, %d boxes)\n", numProjectiles, numBoxes);
+
+	int numSubstepHits = 0;
+	double start = GetCurrentTimeSeconds();
+	for(int index = 0; index < numProjectiles; ++index)
+	{
+		for(int substep = 1; substep <= NUM_SUBSTEPS; ++substep)
+		{
+			Vec3 center = starts[index] + directions[index] * (FRAME_DISTANCE * static_cast<float>(substep) / static_cast<float>(NUM_SUBSTEPS));
+			if(DoesSphereAndAABB3Overlap(Sphere(center, PROJECTILE_RADIUS), wall))
+			{
+				++numSubstepHits;
+				break;
+			}
+		}
+	}
+	double substepSeconds = GetCurrentTimeSeconds() - start;
+
+	int numSweptHits = 0;
+	start = GetCurrentTimeSeconds();
+	for(int index = 0; index < numProjectiles; ++index)
+	{
+		numSweptHits += SweepSphereVsAABB3D(starts[index], directions[index], FRAME_DISTANCE, PROJECTILE_RADIUS, wall).m_didImpact ? 1 : 0;
+	}
+	double sweptSeconds = GetCurrentTimeSeconds() - start;
+	PrintBenchmarkResult("Projectiles vs wall", numProjectiles, "substeps", substepSeconds, "sweep", sweptSeconds);
+	DebuggerPrintf("  %-28s %d / %d\n", "  hits", numSubstepHits, numSweptHits);
+
+	// the sweep covers every substep position, so it must hit wherever a substep did, and no later than that substep
+	for(int index = 0; index < numProjectiles; ++index)
+	{
+		RaycastResult3D sweep = SweepSphereVsAABB3D(starts[index], directions[index], FRAME_DISTANCE, PROJECTILE_RADIUS, wall);
+		for(int substep = 1; substep <= NUM_SUBSTEPS; ++substep)
+		{
+			float substepDistance = FRAME_DISTANCE * static_cast<float>(substep) / static_cast<float>(NUM_SUBSTEPS);
+			if(DoesSphereAndAABB3Overlap(Sphere(starts[index] + directions[index] * substepDistance, PROJECTILE_RADIUS), wall))
+			{
+				GUARANTEE_OR_RETURN(sweep.m_didImpact && sweep.m_impactDistance <= substepDistance + 1e-4f, Stringf("Projectiles vs wall: projectile %d overlaps the wall at substep %d (%g along), but the sweep %s",
+								 index, substep, substepDistance, sweep.m_didImpact ? Stringf("hits later, at %g", sweep.m_impactDistance).c_str() : "misses"));
+				break;
+			}
+		}
+	}
+
+	std::vector<float> boxCoords[6];
+	for(int coord = 0; coord < 6; ++coord)
+	{
+		boxCoords[coord].resize(numBoxes);
+	}
+	for(int index = 0; index < numBoxes; ++index)
+	{
+		Vec3 mins(100.f * GetBenchmarkFraction(index, 5) - 50.f, 100.f * GetBenchmarkFraction(index, 6) - 50.f, 100.f * GetBenchmarkFraction(index, 7) - 50.f);
+		Vec3 size(0.5f + 2.f * GetBenchmarkFraction(index, 8), 0.5f + 2.f * GetBenchmarkFraction(index, 9), 0.5f + 2.f * GetBenchmarkFraction(index, 10));
+		boxCoords[0][index] = mins.x;
+		boxCoords[1][index] = mins.y;
+		boxCoords[2][index] = mins.z;
+		boxCoords[3][index] = mins.x + size.x;
+		boxCoords[4][index] = mins.y + size.y;
+		boxCoords[5][index] = mins.z + size.z;
+	}
+
+	AABB3SoA boxes;
+	boxes.m_count = numBoxes;
+	boxes.m_minX = boxCoords[0].data();
+	boxes.m_minY = boxCoords[1].data();
+	boxes.m_minZ = boxCoords[2].data();
+	boxes.m_maxX = boxCoords[3].data();
+	boxes.m_maxY = boxCoords[4].data();
+	boxes.m_maxZ = boxCoords[5].data();
+
+	int numQueries = GetMax(numProjectiles / 100, 1);
+	int scalarIndexSum = 0;
+	std::vector<int> scalarClosestIndexes(numQueries);
+	std::vector<float> scalarClosestDistances(numQueries);
+	start = GetCurrentTimeSeconds();
+	for(int query = 0; query < numQueries; ++query)
+	{
+		Vec3 queryStart = starts[query] * 5.f;
+		float closestDistance = FLT_MAX;
+		int closestIndex = -1;
+		for(int boxIndex = 0; boxIndex < numBoxes; ++boxIndex)
+		{
+			AABB3 box(boxCoords[0][boxIndex], boxCoords[1][boxIndex], boxCoords[2][boxIndex], boxCoords[3][boxIndex], boxCoords[4][boxIndex], boxCoords[5][boxIndex]);
+			RaycastResult3D result = SweepSphereVsAABB3D(queryStart, directions[query], 100.f, 0.5f, box);
+			if(result.m_didImpact && result.m_impactDistance < closestDistance)
+			{
+				closestDistance = result.m_impactDistance;
+				closestIndex = boxIndex;
+			}
+		}
+		scalarIndexSum += closestIndex;
+		scalarClosestIndexes[query] = closestIndex;
+		scalarClosestDistances[query] = closestDistance;
+	}
+	double scalarSeconds = GetCurrentTimeSeconds() - start;
+
+	int batchIndexSum = 0;
+	std::vector<int> batchClosestIndexes(numQueries);
+	std::vector<RaycastResult3D> batchResults(numQueries);
+	start = GetCurrentTimeSeconds();
+	for(int query = 0; query < numQueries; ++query)
+	{
+		batchClosestIndexes[query] = SweepSphereVsAABB3DsClosest(starts[query] * 5.f, directions[query], 100.f, 0.5f, boxes, batchResults[query]);
+		batchIndexSum += batchClosestIndexes[query];
+	}
+	double batchSeconds = GetCurrentTimeSeconds() - start;
+	PrintBenchmarkResult("Sweep vs boxes, closest", numQueries, "per box", scalarSeconds, "batch", batchSeconds);
+	DebuggerPrintf("  %-28s %d / %d\n", "  index checksum", scalarIndexSum, batchIndexSum);
+
+	for(int query = 0; query < numQueries; ++query)
+	{
+		int batchIndex = batchClosestIndexes[query];
+		int scalarIndex = scalarClosestIndexes[query];
+		GUARANTEE_OR_RETURN(batchIndex == scalarIndex, Stringf("Sweep vs boxes: query %d hits box %d first in the batch (%g along), box %d one box at a time (%g along)",
+						 query, batchIndex, batchIndex >= 0 ? batchResults[query].m_impactDistance : -1.f, scalarIndex, scalarIndex >= 0 ? scalarClosestDistances[query] : -1.f));
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Points a RaycastPacketResults3D at caller-owned arrays, one entry per ray or shape.
+static RaycastPacketResults3D MakeBenchmarkPacketResults(bool* didImpact, std::vector<float>* impactValues)
+{
+	RaycastPacketResults3D results;
+	results.m_didImpact = didImpact;
+	results.m_impactDistance = impactValues[0].data();
+	results.m_impactPosX = impactValues[1].data();
+	results.m_impactPosY = impactValues[2].data();
+	results.m_impactPosZ = impactValues[3].data();
+	results.m_impactNormalX = impactValues[4].data();
+	results.m_impactNormalY = impactValues[5].data();
+	results.m_impactNormalZ = impactValues[6].data();
+	return results;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// A ray that only grazes a shape, or ends right at it, can land either way in different arithmetic. It is borderline
+// when growing and shrinking the shape by a hair changes the scalar answer.
+constexpr float RAYCAST_CHECK_MARGIN = 1e-4f;
+
+static bool IsRaycastVsAABB3DBorderline(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, AABB3 const& box)
+{
+	Vec3 margin(RAYCAST_CHECK_MARGIN, RAYCAST_CHECK_MARGIN, RAYCAST_CHECK_MARGIN);
+	return RaycastVsAABB3D(startPos, fwdNormal, maxDist, AABB3(box.m_mins - margin, box.m_maxs + margin)).m_didImpact !=
+		   RaycastVsAABB3D(startPos, fwdNormal, maxDist, AABB3(box.m_mins + margin, box.m_maxs - margin)).m_didImpact;
+}
+
+static bool IsRaycastVsSphere3DBorderline(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, Sphere const& sphere)
+{
+	return RaycastVsSphere3D(startPos, fwdNormal, maxDist, Sphere(sphere.m_center, sphere.m_radius + RAYCAST_CHECK_MARGIN)).m_didImpact !=
+		   RaycastVsSphere3D(startPos, fwdNormal, maxDist, Sphere(sphere.m_center, sphere.m_radius - RAYCAST_CHECK_MARGIN)).m_didImpact;
+}
+
+static bool IsRaycastVsOBB3DBorderline(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, OBB3 const& obb)
+{
+	Vec3 margin(RAYCAST_CHECK_MARGIN, RAYCAST_CHECK_MARGIN, RAYCAST_CHECK_MARGIN);
+	OBB3 grownBox = obb;
+	grownBox.m_halfDimensions += margin;
+	OBB3 shrunkBox = obb;
+	shrunkBox.m_halfDimensions -= margin;
+	return RaycastVsOBB3D(startPos, fwdNormal, maxDist, grownBox).m_didImpact != RaycastVsOBB3D(startPos, fwdNormal, maxDist, shrunkBox).m_didImpact;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// One entry of a batched query against the scalar raycast for the same ray and shape. Hits must agree unless the ray is
+// borderline, and a hit must have the same distance, position and normal.
+static bool CheckBatchRaycastResult(char const* queryName, int rayIndex, int shapeIndex, RaycastResult3D const& expected, bool isBorderline, RaycastPacketResults3D const& results, int index)
+{
+	float const maxDifference = 1e-3f;
+	bool didImpact = results.m_didImpact[index];
+	if(didImpact != expected.m_didImpact)
+	{
+		GUARANTEE_OR_RETURN_FALSE(isBorderline, Stringf("%s: ray %d vs shape %d %s in the batch, but %s in the scalar raycast", queryName, rayIndex, shapeIndex, didImpact ? "hits" : "misses", expected.m_didImpact ? "hits" : "misses"));
+		return true;
+	}
+	if(!didImpact)
+	{
+		return true;
+	}
+
+	Vec3 impactPos(results.m_impactPosX[index], results.m_impactPosY[index], results.m_impactPosZ[index]);
+	Vec3 impactNormal(results.m_impactNormalX[index], results.m_impactNormalY[index], results.m_impactNormalZ[index]);
+	float difference = fabsf(results.m_impactDistance[index] - expected.m_impactDistance) / (1.f + expected.m_impactDistance);
+	difference = GetMax(difference, (impactPos - expected.m_impactPos).GetLength() / (1.f + expected.m_impactPos.GetLength()));
+	difference = GetMax(difference, (impactNormal - expected.m_impactNormal).GetLength());
+	GUARANTEE_OR_RETURN_FALSE(difference <= maxDifference, Stringf("%s: ray %d vs shape %d hits %g along in the batch, %g along in the scalar raycast (differs by %g)",
+							  queryName, rayIndex, shapeIndex, results.m_impactDistance[index], expected.m_impactDistance, difference));
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// The any-hit and closest-hit answers for one ray against what the scalar raycasts found. The closest shape may differ
+// only on a tie, or when one of the two shapes is borderline; isShapeBorderline is only called on a mismatch.
+template<typename IsShapeBorderline>
+static bool CheckAnyAndClosestHit(char const* queryName, int rayIndex, std::vector<RaycastResult3D> const& expected, bool isAnyHit, int closestIndex, IsShapeBorderline isShapeBorderline)
+{
+	int numShapes = static_cast<int>(expected.size());
+	int expectedClosestIndex = -1;
+	for(int shapeIndex = 0; shapeIndex < numShapes; ++shapeIndex)
+	{
+		if(expected[shapeIndex].m_didImpact && (expectedClosestIndex < 0 || expected[shapeIndex].m_impactDistance < expected[expectedClosestIndex].m_impactDistance))
+		{
+			expectedClosestIndex = shapeIndex;
+		}
+	}
+
+	bool isExpectedAnyHit = expectedClosestIndex >= 0;
+	if(isAnyHit != isExpectedAnyHit)
+	{
+		bool isBorderline = false;
+		for(int shapeIndex = 0; shapeIndex < numShapes && !isBorderline; ++shapeIndex)
+		{
+			isBorderline = isShapeBorderline(shapeIndex);
+		}
+		GUARANTEE_OR_RETURN_FALSE(isBorderline, Stringf("%s, any: ray %d %s in the batch, but %s in the scalar raycasts", queryName, rayIndex, isAnyHit ? "hits" : "misses", isExpectedAnyHit ? "hits" : "misses"));
+	}
+
+	if(closestIndex != expectedClosestIndex)
+	{
+		bool isTie = closestIndex >= 0 && expectedClosestIndex >= 0 && expected[closestIndex].m_didImpact &&
+					 fabsf(expected[closestIndex].m_impactDistance - expected[expectedClosestIndex].m_impactDistance) <= 1e-3f;
+		bool isBorderline = (closestIndex >= 0 && isShapeBorderline(closestIndex)) || (expectedClosestIndex >= 0 && isShapeBorderline(expectedClosestIndex));
+		GUARANTEE_OR_RETURN_FALSE(isTie || isBorderline, Stringf("%s, closest: ray %d hits shape %d first in the batch, shape %d in the scalar raycasts", queryName, rayIndex, closestIndex, expectedClosestIndex));
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Rays fired at one box, sphere and OBB3 from all around it (every 16th from inside), one scalar raycast per ray vs the
+// packet query. Then single rays through a field of boxes and of spheres, one scalar raycast per shape vs the batched
+// per-shape, any-hit and closest-hit queries. Every batched answer is checked against the scalar raycasts.
+void RunRayPacketBenchmarks(int numRays, int numShapes)
+{
+	if(numRays <= 0 || numShapes <= 0)
+	{
+		return;
+	}
+
+	std::vector<float> rayValues[7];
+	for(int value = 0; value < 7; ++value)
+	{
+		rayValues[value].resize(numRays);
+	}
+	for(int index = 0; index < numRays; ++index)
+	{
+		Vec3 start = Vec3::MakeFromPolarDegrees(180.f * GetBenchmarkFraction(index, 0) - 90.f, 360.f * GetBenchmarkFraction(index, 1), 3.f + 3.f * GetBenchmarkFraction(index, 2));
+		if(index % 16 == 0)
+		{
+			start *= 0.05f;
+		}
+		Vec3 target(3.f * GetBenchmarkFraction(index, 3) - 1.5f, 3.f * GetBenchmarkFraction(index, 4) - 1.5f, 3.f * GetBenchmarkFraction(index, 5) - 1.5f);
+		Vec3 fwd = (target - start).GetNormalized();
+		rayValues[0][index] = start.x;
+		rayValues[1][index] = start.y;
+		rayValues[2][index] = start.z;
+		rayValues[3][index] = fwd.x;
+		rayValues[4][index] = fwd.y;
+		rayValues[5][index] = fwd.z;
+		rayValues[6][index] = 2.f + 8.f * GetBenchmarkFraction(index, 6);
+	}
+
+	RayPacket3D rays;
+	rays.m_numRays = numRays;
+	rays.m_startX = rayValues[0].data();
+	rays.m_startY = rayValues[1].data();
+	rays.m_startZ = rayValues[2].data();
+	rays.m_fwdX = rayValues[3].data();
+	rays.m_fwdY = rayValues[4].data();
+	rays.m_fwdZ = rayValues[5].data();
+	rays.m_maxLength = rayValues[6].data();
+
+	int numResults = GetMax(numRays, numShapes);
+	std::unique_ptr<bool[]> didImpact(new bool[numResults]);
+	std::vector<float> impactValues[7];
+	for(int value = 0; value < 7; ++value)
+	{
+		impactValues[value].resize(numResults);
+	}
+	RaycastPacketResults3D results = MakeBenchmarkPacketResults(didImpact.get(), impactValues);
+
+	AABB3 box(Vec3(-1.f, -0.75f, -0.5f), Vec3(1.25f, 0.5f, 1.f));
+	Sphere sphere(Vec3(0.1f, -0.2f, 0.15f), 1.2f);
+	OBB3 obb = MakeBenchmarkOBB3(0, Vec3(0.1f, 0.f, -0.1f));
+	obb.m_halfDimensions *= 1.5f;
+
+	DebuggerPrintf("Ray packet benchmarks (%d rays, %d shapes)\n", numRays, numShapes);
+
+	{
+		int numScalarHits = 0;
+		double start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numRays; ++index)
+		{
+			Vec3 rayStart(rays.m_startX[index], rays.m_startY[index], rays.m_startZ[index]);
+			Vec3 rayFwd(rays.m_fwdX[index], rays.m_fwdY[index], rays.m_fwdZ[index]);
+			numScalarHits += RaycastVsAABB3D(rayStart, rayFwd, rays.m_maxLength[index], box).m_didImpact ? 1 : 0;
+		}
+		double scalarSeconds = GetCurrentTimeSeconds() - start;
+
+		start = GetCurrentTimeSeconds();
+		int numPacketHits = RaycastPacketVsAABB3D(rays, box, results);
+		double packetSeconds = GetCurrentTimeSeconds() - start;
+		PrintBenchmarkResult("Packet vs AABB3", numRays, "scalar", scalarSeconds, "packet", packetSeconds);
+		DebuggerPrintf("  %-28s %d / %d\n", "  hits", numScalarHits, numPacketHits);
+
+		for(int index = 0; index < numRays; ++index)
+		{
+			Vec3 rayStart(rays.m_startX[index], rays.m_startY[index], rays.m_startZ[index]);
+			Vec3 rayFwd(rays.m_fwdX[index], rays.m_fwdY[index], rays.m_fwdZ[index]);
+			RaycastResult3D expected = RaycastVsAABB3D(rayStart, rayFwd, rays.m_maxLength[index], box);
+			bool isBorderline = results.m_didImpact[index] != expected.m_didImpact && IsRaycastVsAABB3DBorderline(rayStart, rayFwd, rays.m_maxLength[index], box);
+			if(!CheckBatchRaycastResult("Packet vs AABB3", index, 0, expected, isBorderline, results, index))
+			{
+				return;
+			}
+		}
+	}
+
+	{
+		int numScalarHits = 0;
+		double start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numRays; ++index)
+		{
+			Vec3 rayStart(rays.m_startX[index], rays.m_startY[index], rays.m_startZ[index]);
+			Vec3 rayFwd(rays.m_fwdX[index], rays.m_fwdY[index], rays.m_fwdZ[index]);
+			numScalarHits += RaycastVsSphere3D(rayStart, rayFwd, rays.m_maxLength[index], sphere).m_didImpact ? 1 : 0;
+		}
+		double scalarSeconds = GetCurrentTimeSeconds() - start;
+
+		start = GetCurrentTimeSeconds();
+		int numPacketHits = RaycastPacketVsSphere3D(rays, sphere, results);
+		double packetSeconds = GetCurrentTimeSeconds() - start;
+		PrintBenchmarkResult("Packet vs Sphere", numRays, "scalar", scalarSeconds, "packet", packetSeconds);
+		DebuggerPrintf("  %-28s %d / %d\n", "  hits", numScalarHits, numPacketHits);
+
+		for(int index = 0; index < numRays; ++index)
+		{
+			Vec3 rayStart(rays.m_startX[index], rays.m_startY[index], rays.m_startZ[index]);
+			Vec3 rayFwd(rays.m_fwdX[index], rays.m_fwdY[index], rays.m_fwdZ[index]);
+			RaycastResult3D expected = RaycastVsSphere3D(rayStart, rayFwd, rays.m_maxLength[index], sphere);
+			bool isBorderline = results.m_didImpact[index] != expected.m_didImpact && IsRaycastVsSphere3DBorderline(rayStart, rayFwd, rays.m_maxLength[index], sphere);
+			if(!CheckBatchRaycastResult("Packet vs Sphere", index, 0, expected, isBorderline, results, index))
+			{
+				return;
+			}
+		}
+	}
+
+	{
+		int numScalarHits = 0;
+		double start = GetCurrentTimeSeconds();
+		for(int index = 0; index < numRays; ++index)
+		{
+			Vec3 rayStart(rays.m_startX[index], rays.m_startY[index], rays.m_startZ[index]);
+			Vec3 rayFwd(rays.m_fwdX[index], rays.m_fwdY[index], rays.m_fwdZ[index]);
+			numScalarHits += RaycastVsOBB3D(rayStart, rayFwd, rays.m_maxLength[index], obb).m_didImpact ? 1 : 0;
+		}
+		double scalarSeconds = GetCurrentTimeSeconds() - start;
+
+		start = GetCurrentTimeSeconds();
+		int numPacketHits = RaycastPacketVsOBB3D(rays, obb, results);
+		double packetSeconds = GetCurrentTimeSeconds() - start;
+		PrintBenchmarkResult("Packet vs OBB3", numRays, "scalar", scalarSeconds, "packet", packetSeconds);
+		DebuggerPrintf("  %-28s %d / %d\n", "  hits", numScalarHits, numPacketHits);
+
+		for(int index = 0; index < numRays; ++index)
+		{
+			Vec3 rayStart(rays.m_startX[index], rays.m_startY[index], rays.m_startZ[index]);
+			Vec3 rayFwd(rays.m_fwdX[index], rays.m_fwdY[index], rays.m_fwdZ[index]);
+			RaycastResult3D expected = RaycastVsOBB3D(rayStart, rayFwd, rays.m_maxLength[index], obb);
+			bool isBorderline = results.m_didImpact[index] != expected.m_didImpact && IsRaycastVsOBB3DBorderline(rayStart, rayFwd, rays.m_maxLength[index], obb);
+			if(!CheckBatchRaycastResult("Packet vs OBB3", index, 0, expected, isBorderline, results, index))
+			{
+				return;
+			}
+		}
+	}
+
+	std::vector<AABB3> boxes(numShapes);
+	std::vector<Sphere> spheres(numShapes);
+	std::vector<float> shapeValues[10];
+	for(int value = 0; value < 10; ++value)
+	{
+		shapeValues[value].resize(numShapes);
+	}
+	for(int index = 0; index < numShapes; ++index)
+	{
+		Vec3 mins(60.f * GetBenchmarkFraction(index, 7) - 30.f, 60.f * GetBenchmarkFraction(index, 8) - 30.f, 60.f * GetBenchmarkFraction(index, 9) - 30.f);
+		Vec3 size(0.5f + 2.f * GetBenchmarkFraction(index, 10), 0.5f + 2.f * GetBenchmarkFraction(index, 11), 0.5f + 2.f * GetBenchmarkFraction(index, 12));
+		boxes[index] = AABB3(mins, mins + size);
+		spheres[index] = Sphere(mins + size * 0.5f, 0.25f + GetBenchmarkFraction(index, 13));
+
+		shapeValues[0][index] = boxes[index].m_mins.x;
+		shapeValues[1][index] = boxes[index].m_mins.y;
+		shapeValues[2][index] = boxes[index].m_mins.z;
+		shapeValues[3][index] = boxes[index].m_maxs.x;
+		shapeValues[4][index] = boxes[index].m_maxs.y;
+		shapeValues[5][index] = boxes[index].m_maxs.z;
+		shapeValues[6][index] = spheres[index].m_center.x;
+		shapeValues[7][index] = spheres[index].m_center.y;
+		shapeValues[8][index] = spheres[index].m_center.z;
+		shapeValues[9][index] = spheres[index].m_radius;
+	}
+
+	AABB3SoA boxesSoA;
+	boxesSoA.m_count = numShapes;
+	boxesSoA.m_minX = shapeValues[0].data();
+	boxesSoA.m_minY = shapeValues[1].data();
+	boxesSoA.m_minZ = shapeValues[2].data();
+	boxesSoA.m_maxX = shapeValues[3].data();
+	boxesSoA.m_maxY = shapeValues[4].data();
+	boxesSoA.m_maxZ = shapeValues[5].data();
+
+	SphereSoA spheresSoA;
+	spheresSoA.m_count = numShapes;
+	spheresSoA.m_centerX = shapeValues[6].data();
+	spheresSoA.m_centerY = shapeValues[7].data();
+	spheresSoA.m_centerZ = shapeValues[8].data();
+	spheresSoA.m_radius = shapeValues[9].data();
+
+	// the packet rays scaled up to cross the field, each as long as the field is wide
+	int numQueries = GetMax(numRays / 100, 1);
+	float const queryLength = 60.f;
+	std::vector<Vec3> queryStarts(numQueries);
+	std::vector<Vec3> queryFwds(numQueries);
+	for(int query = 0; query < numQueries; ++query)
+	{
+		queryStarts[query] = Vec3(rays.m_startX[query], rays.m_startY[query], rays.m_startZ[query]) * 5.f;
+		queryFwds[query] = Vec3(rays.m_fwdX[query], rays.m_fwdY[query], rays.m_fwdZ[query]);
+	}
+
+	std::vector<RaycastResult3D> expected(numShapes);
+
+	{
+		int numScalarHits = 0;
+		int scalarClosestSum = 0;
+		double start = GetCurrentTimeSeconds();
+		for(int query = 0; query < numQueries; ++query)
+		{
+			float closestDistance = FLT_MAX;
+			int closestIndex = -1;
+			for(int boxIndex = 0; boxIndex < numShapes; ++boxIndex)
+			{
+				RaycastResult3D result = RaycastVsAABB3D(queryStarts[query], queryFwds[query], queryLength, boxes[boxIndex]);
+				if(result.m_didImpact)
+				{
+					++numScalarHits;
+					if(result.m_impactDistance < closestDistance)
+					{
+						closestDistance = result.m_impactDistance;
+						closestIndex = boxIndex;
+					}
+				}
+			}
+			scalarClosestSum += closestIndex;
+		}
+		double scalarSeconds = GetCurrentTimeSeconds() - start;
+
+		int numBatchHits = 0;
+		start = GetCurrentTimeSeconds();
+		for(int query = 0; query < numQueries; ++query)
+		{
+			numBatchHits += RaycastVsAABB3Ds(queryStarts[query], queryFwds[query], queryLength, boxesSoA, results);
+		}
+		double batchSeconds = GetCurrentTimeSeconds() - start;
+		PrintBenchmarkResult("Ray vs boxes", numQueries, "scalar", scalarSeconds, "batch", batchSeconds);
+
+		int numAnyHits = 0;
+		start = GetCurrentTimeSeconds();
+		for(int query = 0; query < numQueries; ++query)
+		{
+			numAnyHits += RaycastVsAABB3DsAny(queryStarts[query], queryFwds[query], queryLength, boxesSoA) ? 1 : 0;
+		}
+		double anySeconds = GetCurrentTimeSeconds() - start;
+		PrintBenchmarkResult("Ray vs boxes, any", numQueries, "scalar", scalarSeconds, "any", anySeconds);
+
+		int batchClosestSum = 0;
+		RaycastResult3D closestResult;
+		start = GetCurrentTimeSeconds();
+		for(int query = 0; query < numQueries; ++query)
+		{
+			batchClosestSum += RaycastVsAABB3DsClosest(queryStarts[query], queryFwds[query], queryLength, boxesSoA, closestResult);
+		}
+		double closestSeconds = GetCurrentTimeSeconds() - start;
+		PrintBenchmarkResult("Ray vs boxes, closest", numQueries, "scalar", scalarSeconds, "closest", closestSeconds);
+		DebuggerPrintf("  %-28s %d / %d hits, %d rays hit something, index checksum %d / %d\n", "", numScalarHits, numBatchHits, numAnyHits, scalarClosestSum, batchClosestSum);
+
+		for(int query = 0; query < numQueries; ++query)
+		{
+			Vec3 const& rayStart = queryStarts[query];
+			Vec3 const& rayFwd = queryFwds[query];
+			RaycastVsAABB3Ds(rayStart, rayFwd, queryLength, boxesSoA, results);
+			for(int boxIndex = 0; boxIndex < numShapes; ++boxIndex)
+			{
+				expected[boxIndex] = RaycastVsAABB3D(rayStart, rayFwd, queryLength, boxes[boxIndex]);
+				bool isBorderline = results.m_didImpact[boxIndex] != expected[boxIndex].m_didImpact && IsRaycastVsAABB3DBorderline(rayStart, rayFwd, queryLength, boxes[boxIndex]);
+				if(!CheckBatchRaycastResult("Ray vs boxes", query, boxIndex, expected[boxIndex], isBorderline, results, boxIndex))
+				{
+					return;
+				}
+			}
+
+			bool isAnyHit = RaycastVsAABB3DsAny(rayStart, rayFwd, queryLength, boxesSoA);
+			int closestIndex = RaycastVsAABB3DsClosest(rayStart, rayFwd, queryLength, boxesSoA, closestResult);
+			auto isBoxBorderline = [&](int boxIndex) { return IsRaycastVsAABB3DBorderline(rayStart, rayFwd, queryLength, boxes[boxIndex]); };
+			if(!CheckAnyAndClosestHit("Ray vs boxes", query, expected, isAnyHit, closestIndex, isBoxBorderline))
+			{
+				return;
+			}
+		}
+	}
+
+	{
+		int numScalarHits = 0;
+		int scalarClosestSum = 0;
+		double start = GetCurrentTimeSeconds();
+		for(int query = 0; query < numQueries; ++query)
+		{
+			float closestDistance = FLT_MAX;
+			int closestIndex = -1;
+			for(int sphereIndex = 0; sphereIndex < numShapes; ++sphereIndex)
+			{
+				RaycastResult3D result = RaycastVsSphere3D(queryStarts[query], queryFwds[query], queryLength, spheres[sphereIndex]);
+				if(result.m_didImpact)
+				{
+					++numScalarHits;
+					if(result.m_impactDistance < closestDistance)
+					{
+						closestDistance = result.m_impactDistance;
+						closestIndex = sphereIndex;
+					}
+				}
+			}
+			scalarClosestSum += closestIndex;
+		}
+		double scalarSeconds = GetCurrentTimeSeconds() - start;
+
+		int numBatchHits = 0;
+		start = GetCurrentTimeSeconds();
+		for(int query = 0; query < numQueries; ++query)
+		{
+			numBatchHits += RaycastVsSphere3Ds(queryStarts[query], queryFwds[query], queryLength, spheresSoA, results);
+		}
+		double batchSeconds = GetCurrentTimeSeconds() - start;
+		PrintBenchmarkResult("Ray vs spheres", numQueries, "scalar", scalarSeconds, "batch", batchSeconds);
+
+		int numAnyHits = 0;
+		start = GetCurrentTimeSeconds();
+		for(int query = 0; query < numQueries; ++query)
+		{
+			numAnyHits += RaycastVsSphere3DsAny(queryStarts[query], queryFwds[query], queryLength, spheresSoA) ? 1 : 0;
+		}
+		double anySeconds = GetCurrentTimeSeconds() - start;
+		PrintBenchmarkResult("Ray vs spheres, any", numQueries, "scalar", scalarSeconds, "any", anySeconds);
+
+		int batchClosestSum = 0;
+		RaycastResult3D closestResult;
+		start = GetCurrentTimeSeconds();
+		for(int query = 0; query < numQueries; ++query)
+		{
+			batchClosestSum += RaycastVsSphere3DsClosest(queryStarts[query], queryFwds[query], queryLength, spheresSoA, closestResult);
+		}
+		double closestSeconds = GetCurrentTimeSeconds() - start;
+		PrintBenchmarkResult("Ray vs spheres, closest", numQueries, "scalar", scalarSeconds, "closest", closestSeconds);
+		DebuggerPrintf("  %-28s %d / %d hits, %d rays hit something, index checksum %d / %d\n", "", numScalarHits, numBatchHits, numAnyHits, scalarClosestSum, batchClosestSum);
+
+		for(int query = 0; query < numQueries; ++query)
+		{
+			Vec3 const& rayStart = queryStarts[query];
+			Vec3 const& rayFwd = queryFwds[query];
+			RaycastVsSphere3Ds(rayStart, rayFwd, queryLength, spheresSoA, results);
+			for(int sphereIndex = 0; sphereIndex < numShapes; ++sphereIndex)
+			{
+				expected[sphereIndex] = RaycastVsSphere3D(rayStart, rayFwd, queryLength, spheres[sphereIndex]);
+				bool isBorderline = results.m_didImpact[sphereIndex] != expected[sphereIndex].m_didImpact && IsRaycastVsSphere3DBorderline(rayStart, rayFwd, queryLength, spheres[sphereIndex]);
+				if(!CheckBatchRaycastResult("Ray vs spheres", query, sphereIndex, expected[sphereIndex], isBorderline, results, sphereIndex))
+				{
+					return;
+				}
+			}
+
+			bool isAnyHit = RaycastVsSphere3DsAny(rayStart, rayFwd, queryLength, spheresSoA);
+			int closestIndex = RaycastVsSphere3DsClosest(rayStart, rayFwd, queryLength, spheresSoA, closestResult);
+			auto isSphereBorderline = [&](int sphereIndex) { return IsRaycastVsSphere3DBorderline(rayStart, rayFwd, queryLength, spheres[sphereIndex]); };
+			if(!CheckAnyAndClosestHit("Ray vs spheres", query, expected, isAnyHit, closestIndex, isSphereBorderline))
+			{
+				return;
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// A row of walled bins, each with 40 boxes and discs dropped into it, so every bin settles into its own island.
+static void AddPhysicsBenchmarkBodies(PhysicsWorld2D& world, int numBodies)
+{
+	constexpr int BODIES_PER_BIN = 40;
+	constexpr float BIN_WIDTH = 6.f;
+	int numBins = GetMax((numBodies + BODIES_PER_BIN - 1) / BODIES_PER_BIN, 1);
+
+	PhysicsBodyDefinition2D wall;
+	wall.m_shapeType = PhysicsShapeType2D::BOX;
+	wall.m_density = 0.f;
+	wall.m_halfDimensions = Vec2(0.25f, 5.f);
+	for(int binIndex = 0; binIndex <= numBins; ++binIndex)
+	{
+		wall.m_position = Vec2(BIN_WIDTH * static_cast<float>(binIndex) - 0.25f, 5.f);
+		world.AddBody(wall);
+	}
+
+	PhysicsBodyDefinition2D floor;
+	floor.m_shapeType = PhysicsShapeType2D::BOX;
+	floor.m_density = 0.f;
+	floor.m_halfDimensions = Vec2(0.5f * BIN_WIDTH * static_cast<float>(numBins), 0.5f);
+	floor.m_position = Vec2(floor.m_halfDimensions.x, -0.5f);
+	world.AddBody(floor);
+
+	for(int bodyIndex = 0; bodyIndex < numBodies; ++bodyIndex)
+	{
+		int binIndex = bodyIndex / BODIES_PER_BIN;
+		int slot = bodyIndex % BODIES_PER_BIN;
+
+		PhysicsBodyDefinition2D body;
+		body.m_shapeType = (slot % 3 == 0) ? PhysicsShapeType2D::DISC : PhysicsShapeType2D::BOX;
+		body.m_position = Vec2(BIN_WIDTH * static_cast<float>(binIndex) + 1.f + 1.2f * static_cast<float>(slot % 4), 1.f + 1.2f * static_cast<float>(slot / 4));
+		body.m_orientationDegrees = 360.f * GetBenchmarkFraction(bodyIndex, 11);
+		body.m_radius = 0.4f;
+		body.m_halfDimensions = Vec2(0.4f, 0.35f);
+		world.AddBody(body);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Bit-for-bit, so that a solver split differently across threads shows up even when it only moves the last bit.
+static bool CheckPhysicsWorldsMatch(PhysicsWorld2D const& serialWorld, PhysicsWorld2D const& jobWorld)
+{
+	std::vector<Vec2> const& serialPositions = serialWorld.GetPositionArray();
+	std::vector<Vec2> const& jobPositions = jobWorld.GetPositionArray();
+	GUARANTEE_OR_RETURN_FALSE(serialPositions.size() == jobPositions.size(), Stringf("PhysicsWorld2D: %d bodies with jobs, %d serial", static_cast<int>(jobPositions.size()), static_cast<int>(serialPositions.size())));
+	for(int bodyIndex = 0; bodyIndex < static_cast<int>(serialPositions.size()); ++bodyIndex)
+	{
+		Vec2 const& serialPosition = serialPositions[bodyIndex];
+		Vec2 const& jobPosition = jobPositions[bodyIndex];
+		GUARANTEE_OR_RETURN_FALSE(memcmp(&serialPosition, &jobPosition, sizeof(Vec2)) == 0, Stringf("PhysicsWorld2D: body %d ends at (%.9g, %.9g) with jobs, (%.9g, %.9g) serial",
+						 bodyIndex, jobPosition.x, jobPosition.y, serialPosition.x, serialPosition.y));
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Steps the same settling scene on the calling thread alone and with the JobSystem. The two must end bit-identical,
+// since islands are formed and solved in body order however the work is split.
+void RunPhysicsWorld2DBenchmarks(int numBodies, int numFrames, JobSystem* jobSystem)
+{
+	constexpr float FRAME_SECONDS = 1.f / 60.f;
+	DebuggerPrintf("PhysicsWorld2D benchmarks (%d bodies, %d frames)\n", numBodies, numFrames);
+
+	PhysicsWorld2DConfig config;
+	PhysicsWorld2D serialWorld(config);
+	serialWorld.Startup();
+	AddPhysicsBenchmarkBodies(serialWorld, numBodies);
+
+	double start = GetCurrentTimeSeconds();
+	for(int frame = 0; frame < numFrames; ++frame)
+	{
+		serialWorld.Step(FRAME_SECONDS);
+	}
+	double serialSeconds = GetCurrentTimeSeconds() - start;
+	DebuggerPrintf("  %-28s %d / %d\n", "  contacts / islands", serialWorld.GetNumContacts(), serialWorld.GetNumIslands());
+	DebuggerPrintf("  %-28s %.3f ms\n", "  serial step", 1000.0 * serialSeconds / static_cast<double>(numFrames));
+
+	if(jobSystem != nullptr)
+	{
+		config.m_jobSystem = jobSystem;
+		PhysicsWorld2D jobWorld(config);
+		jobWorld.Startup();
+		AddPhysicsBenchmarkBodies(jobWorld, numBodies);
+
+		start = GetCurrentTimeSeconds();
+		for(int frame = 0; frame < numFrames; ++frame)
+		{
+			jobWorld.Step(FRAME_SECONDS);
+		}
+		double jobSeconds = GetCurrentTimeSeconds() - start;
+		PrintBenchmarkResult("Physics step + jobs", numFrames, "serial", serialSeconds, "jobs", jobSeconds);
+		CheckPhysicsWorldsMatch(serialWorld, jobWorld);
+		jobWorld.Shutdown();
+	}
+
+	s_benchmarkSink = s_benchmarkSink + serialWorld.GetPositionArray()[serialWorld.GetNumBodies() - 1].y;
+	serialWorld.Shutdown();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// The hand-rolled way of hulling a point set: start at the lowest point and keep wrapping to the point every other
+// point is left of. O(n h) for h hull vertexes.
+static void GetGiftWrappedHull2D(std::vector<Vec2> const& points, std::vector<Vec2>& out_hull)
+{
+	int numPoints = static_cast<int>(points.size());
+	int startIndex = 0;
+	for(int pointIndex = 1; pointIndex < numPoints; ++pointIndex)
+	{
+		if(points[pointIndex].y < points[startIndex].y || (points[pointIndex].y == points[startIndex].y && points[pointIndex].x < points[startIndex].x))
+		{
+			startIndex = pointIndex;
+		}
+	}
+
+	int currentIndex = startIndex;
+	do
+	{
+		out_hull.push_back(points[currentIndex]);
+		int nextIndex = (currentIndex + 1) % numPoints;
+		for(int pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+		{
+			float turn = CrossProduct2D(points[nextIndex] - points[currentIndex], points[pointIndex] - points[currentIndex]);
+			bool isFarther = GetVectorDistanceSquared2D(points[pointIndex], points[currentIndex]) > GetVectorDistanceSquared2D(points[nextIndex], points[currentIndex]);
+			if(turn < 0.f || (turn == 0.f && isFarther))
+			{
+				nextIndex = pointIndex;
+			}
+		}
+		currentIndex = nextIndex;
+	}
+	while(currentIndex != startIndex && out_hull.size() <= points.size());
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Both walk the hull counterclockwise, but from different first vertexes.
+static bool CheckHullsMatch2D(std::vector<Vec2> const& wrappedHull, std::vector<Vec2> const& chainHull)
+{
+	int numVertexes = static_cast<int>(wrappedHull.size());
+	GUARANTEE_OR_RETURN_FALSE(numVertexes == static_cast<int>(chainHull.size()), Stringf("2D hull: %d vertexes by gift wrapping, %d by the monotone chain", numVertexes, static_cast<int>(chainHull.size())));
+
+	int chainOffset = static_cast<int>(std::find(chainHull.begin(), chainHull.end(), wrappedHull[0]) - chainHull.begin());
+	GUARANTEE_OR_RETURN_FALSE(chainOffset < numVertexes, Stringf("2D hull: the monotone chain is missing the lowest vertex (%g, %g)", wrappedHull[0].x, wrappedHull[0].y));
+	for(int vertIndex = 0; vertIndex < numVertexes; ++vertIndex)
+	{
+		Vec2 const& wrappedVertex = wrappedHull[vertIndex];
+		Vec2 const& chainVertex = chainHull[(chainOffset + vertIndex) % numVertexes];
+		GUARANTEE_OR_RETURN_FALSE(wrappedVertex == chainVertex, Stringf("2D hull: vertex %d is (%g, %g) by gift wrapping, (%g, %g) by the monotone chain",
+						 vertIndex, wrappedVertex.x, wrappedVertex.y, chainVertex.x, chainVertex.y));
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// The planes are pushed out to the farthest point, so no point may be more than rounding outside any of them.
+static bool CheckHullEnclosesPoints3D(char const* hullName, ConvexHull3 const& hull, std::vector<Vec3> const& points)
+{
+	constexpr float MAX_ALTITUDE = 1e-5f;
+	for(int pointIndex = 0; pointIndex < static_cast<int>(points.size()); ++pointIndex)
+	{
+		for(int planeIndex = 0; planeIndex < static_cast<int>(hull.m_planes.size()); ++planeIndex)
+		{
+			float altitude = hull.m_planes[planeIndex].GetAltitudeFromPoint(points[pointIndex]);
+			GUARANTEE_OR_RETURN_FALSE(altitude <= MAX_ALTITUDE, Stringf("%s: point %d is %g outside plane %d", hullName, pointIndex, altitude, planeIndex));
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// 2D: gift wrapping vs the monotone chain in ConvexPoly2, on a disc of points (where hulls have many vertexes). 3D: a
+// noisy ellipsoid, the shape of a typical scanned or sculpted mesh, hulled exactly and with a collision-proxy limit.
+void RunConvexHullBenchmarks(int numPoints)
+{
+	DebuggerPrintf("Convex hull benchmarks (%d points)\n", numPoints);
+
+	std::vector<Vec2> points2D(numPoints);
+	for(int index = 0; index < numPoints; ++index)
+	{
+		float radius = 10.f * sqrtf(GetBenchmarkFraction(index, 0));
+		points2D[index] = Vec2::MakeFromPolarDegrees(360.f * GetBenchmarkFraction(index, 1), radius);
+	}
+
+	std::vector<Vec2> wrappedHull;
+	double start = GetCurrentTimeSeconds();
+	GetGiftWrappedHull2D(points2D, wrappedHull);
+	double wrapSeconds = GetCurrentTimeSeconds() - start;
+
+	start = GetCurrentTimeSeconds();
+	ConvexPoly2 poly = ConvexPoly2::MakeFromPointCloud(points2D);
+	double chainSeconds = GetCurrentTimeSeconds() - start;
+	PrintBenchmarkResult("2D hull", numPoints, "wrap", wrapSeconds, "chain", chainSeconds);
+
+	std::vector<Vec2> chainHull;
+	poly.GetVertexPositions(chainHull);
+	DebuggerPrintf("  %-28s %d / %d\n", "  hull vertexes", static_cast<int>(wrappedHull.size()), static_cast<int>(chainHull.size()));
+	if(!CheckHullsMatch2D(wrappedHull, chainHull))
+	{
+		return;
+	}
+
+	std::vector<Vec3> points3D(numPoints);
+	for(int index = 0; index < numPoints; ++index)
+	{
+		Vec3 direction = Vec3::MakeFromPolarDegrees(180.f * GetBenchmarkFraction(index, 2) - 90.f, 360.f * GetBenchmarkFraction(index, 3));
+		float radius = 1.f - 0.05f * GetBenchmarkFraction(index, 4);
+		points3D[index] = Vec3(3.f * direction.x, 2.f * direction.y, direction.z) * radius;
+	}
+
+	int const maxVertexCounts[2] = { numPoints, 32 };
+	for(int maxVertexes : maxVertexCounts)
+	{
+		ConvexHull3 hull;
+		std::vector<Vec3> hullVertexes;
+		start = GetCurrentTimeSeconds();
+		BuildConvexHull3FromPoints(points3D, hull, maxVertexes, 3.f, &hullVertexes);
+		double hullSeconds = GetCurrentTimeSeconds() - start;
+
+		char const* hullName = (maxVertexes == 32) ? "3D hull, 32 vertexes" : "3D hull, exact";
+		DebuggerPrintf("  %-28s %.2f ms, %d vertexes, %d planes\n", hullName, 1000.0 * hullSeconds, static_cast<int>(hullVertexes.size()), static_cast<int>(hull.m_planes.size()));
+		if(!CheckHullEnclosesPoints3D(hullName, hull, points3D))
+		{
+			return;
+		}
+		s_benchmarkSink = s_benchmarkSink + static_cast<float>(hull.m_planes.size());
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// The batch queries list their hits in ascending index order, the same as a loop over IsPointInsideConvexHull2.
+static bool CheckHullQueryIndexes(char const* queryName, int queryIndex, std::vector<int> const& scalarIndexes, std::vector<int> const& batchIndexes)
+{
+	int numEntries = GetMax(static_cast<int>(scalarIndexes.size()), static_cast<int>(batchIndexes.size()));
+	for(int entryIndex = 0; entryIndex < numEntries; ++entryIndex)
+	{
+		int scalarIndex = (entryIndex < static_cast<int>(scalarIndexes.size())) ? scalarIndexes[entryIndex] : -1;
+		int batchIndex = (entryIndex < static_cast<int>(batchIndexes.size())) ? batchIndexes[entryIndex] : -1;
+		GUARANTEE_OR_RETURN_FALSE(scalarIndex == batchIndex, Stringf("%s %d: hit %d is %d in the batch, %d by the scalar loop (-1 is no hit; %d vs %d hits)",
+						 queryName, queryIndex, entryIndex, batchIndex, scalarIndex, static_cast<int>(batchIndexes.size()), static_cast<int>(scalarIndexes.size())));
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// A 2D arena with a crowd of actors and a scatter of convex zones (from a dozen points each), each actor asking which
+// zones it is in. The loops over IsPointInsideConvexHull2 are the baseline, and every batch answer must match them.
+void RunConvexHullQueryBenchmarks(int numPoints, int numHulls)
+{
+	if(numPoints <= 0 || numHulls <= 0)
+	{
+		return;
+	}
+
+	DebuggerPrintf("Convex hull query benchmarks (%d points, %d hulls)\n", numPoints, numHulls);
+
+	float const arenaSize = 200.f;
+	std::vector<ConvexHull2> hulls(numHulls);
+	PackedConvexHulls2 packedHulls;
+	for(int hullIndex = 0; hullIndex < numHulls; ++hullIndex)
+	{
+		Vec2 center(arenaSize * GetBenchmarkFraction(hullIndex, 0), arenaSize * GetBenchmarkFraction(hullIndex, 1));
+		float size = 5.f + 20.f * GetBenchmarkFraction(hullIndex, 2);
+
+		std::vector<Vec2> cloud(12);
+		for(int cloudIndex = 0; cloudIndex < 12; ++cloudIndex)
+		{
+			int seed = hullIndex * 12 + cloudIndex;
+			cloud[cloudIndex] = center + Vec2::MakeFromPolarDegrees(360.f * GetBenchmarkFraction(seed, 3), size * GetBenchmarkFraction(seed, 4));
+		}
+
+		hulls[hullIndex] = ConvexHull2::MakeFromPointCloud(cloud);
+		packedHulls.AddHull(hulls[hullIndex]);
+	}
+
+	std::vector<float> pointXs(numPoints);
+	std::vector<float> pointYs(numPoints);
+	for(int pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+	{
+		pointXs[pointIndex] = arenaSize * GetBenchmarkFraction(pointIndex, 5);
+		pointYs[pointIndex] = arenaSize * GetBenchmarkFraction(pointIndex, 6);
+	}
+
+	Vec2SoA points;
+	points.m_count = numPoints;
+	points.m_x = pointXs.data();
+	points.m_y = pointYs.data();
+
+	float sink = 0.f;
+
+	// many points vs one hull
+	int scalarCount = 0;
+	double start = GetCurrentTimeSeconds();
+	for(ConvexHull2 const& hull : hulls)
+	{
+		for(int pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+		{
+			scalarCount += IsPointInsideConvexHull2(Vec2(pointXs[pointIndex], pointYs[pointIndex]), hull) ? 1 : 0;
+		}
+	}
+	double scalarSeconds = GetCurrentTimeSeconds() - start;
+
+	std::vector<int> insideIndexes;
+	int batchCount = 0;
+	start = GetCurrentTimeSeconds();
+	for(int hullIndex = 0; hullIndex < numHulls; ++hullIndex)
+	{
+		batchCount += GetPointsInsideConvexHull2(packedHulls, hullIndex, points, insideIndexes);
+	}
+	double batchSeconds = GetCurrentTimeSeconds() - start;
+	PrintBenchmarkResult("points vs hull", numPoints * numHulls, "scalar", scalarSeconds, "batch", batchSeconds);
+	sink += static_cast<float>(batchCount + scalarCount);
+
+	std::vector<int> scalarIndexes;
+	for(int hullIndex = 0; hullIndex < numHulls; ++hullIndex)
+	{
+		scalarIndexes.clear();
+		for(int pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+		{
+			if(IsPointInsideConvexHull2(Vec2(pointXs[pointIndex], pointYs[pointIndex]), hulls[hullIndex]))
+			{
+				scalarIndexes.push_back(pointIndex);
+			}
+		}
+		GetPointsInsideConvexHull2(packedHulls, hullIndex, points, insideIndexes);
+		if(!CheckHullQueryIndexes("points vs hull, hull", hullIndex, scalarIndexes, insideIndexes))
+		{
+			return;
+		}
+	}
+
+	// one point vs many hulls
+	std::vector<int> scalarHullIndexes;
+	scalarCount = 0;
+	start = GetCurrentTimeSeconds();
+	for(int pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+	{
+		scalarHullIndexes.clear();
+		Vec2 point(pointXs[pointIndex], pointYs[pointIndex]);
+		for(int hullIndex = 0; hullIndex < numHulls; ++hullIndex)
+		{
+			if(IsPointInsideConvexHull2(point, hulls[hullIndex]))
+			{
+				scalarHullIndexes.push_back(hullIndex);
+			}
+		}
+		scalarCount += static_cast<int>(scalarHullIndexes.size());
+	}
+	scalarSeconds = GetCurrentTimeSeconds() - start;
+
+	std::vector<int> batchHullIndexes;
+	batchCount = 0;
+	start = GetCurrentTimeSeconds();
+	for(int pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+	{
+		batchCount += GetConvexHulls2ContainingPoint(packedHulls, Vec2(pointXs[pointIndex], pointYs[pointIndex]), batchHullIndexes);
+	}
+	batchSeconds = GetCurrentTimeSeconds() - start;
+	PrintBenchmarkResult("point vs hulls", numPoints, "scalar", scalarSeconds, "batch", batchSeconds);
+	sink += static_cast<float>(batchCount + scalarCount);
+
+	for(int pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+	{
+		Vec2 point(pointXs[pointIndex], pointYs[pointIndex]);
+		scalarIndexes.clear();
+		for(int hullIndex = 0; hullIndex < numHulls; ++hullIndex)
+		{
+			if(IsPointInsideConvexHull2(point, hulls[hullIndex]))
+			{
+				scalarIndexes.push_back(hullIndex);
+			}
+		}
+		GetConvexHulls2ContainingPoint(packedHulls, point, batchHullIndexes);
+		if(!CheckHullQueryIndexes("point vs hulls, point", pointIndex, scalarIndexes, batchHullIndexes))
+		{
+			return;
+		}
+	}
+
+	// first containing hull for every point
+	std::vector<int> scalarFirstHulls(numPoints, -1);
+	start = GetCurrentTimeSeconds();
+	for(int pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+	{
+		Vec2 point(pointXs[pointIndex], pointYs[pointIndex]);
+		for(int hullIndex = 0; hullIndex < numHulls; ++hullIndex)
+		{
+			if(IsPointInsideConvexHull2(point, hulls[hullIndex]))
+			{
+				scalarFirstHulls[pointIndex] = hullIndex;
+				break;
+			}
+		}
+	}
+	scalarSeconds = GetCurrentTimeSeconds() - start;
+
+	std::vector<int> batchFirstHulls;
+	start = GetCurrentTimeSeconds();
+	GetFirstConvexHull2ContainingPoints(packedHulls, points, batchFirstHulls);
+	batchSeconds = GetCurrentTimeSeconds() - start;
+	PrintBenchmarkResult("first hull per point", numPoints, "scalar", scalarSeconds, "batch", batchSeconds);
+
+	GUARANTEE_OR_RETURN(static_cast<int>(batchFirstHulls.size()) == numPoints, Stringf("first hull per point: %d answers for %d points", static_cast<int>(batchFirstHulls.size()), numPoints));
+	int numInAnyHull = 0;
+	for(int pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+	{
+		GUARANTEE_OR_RETURN(scalarFirstHulls[pointIndex] == batchFirstHulls[pointIndex], Stringf("first hull per point: point %d is first in hull %d in the batch, %d by the scalar loop (-1 is none)",
+						 pointIndex, batchFirstHulls[pointIndex], scalarFirstHulls[pointIndex]));
+		numInAnyHull += (batchFirstHulls[pointIndex] >= 0) ? 1 : 0;
+	}
+
+	DebuggerPrintf("  %-28s %d of %d\n", "points in some hull", numInAnyHull, numPoints);
+	s_benchmarkSink = s_benchmarkSink + sink + static_cast<float>(numInAnyHull);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Groups of ten transforms, a root with three children and six grandchildren, the shape of a simple rigged prop.
+static int GetBenchmarkTransformParent(int transformIndex)
+{
+	int groupFirst = transformIndex - (transformIndex % 10);
+	int groupOffset = transformIndex % 10;
+	return (groupOffset == 0) ? -1 : groupFirst + (groupOffset - 1) / 3;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static Vec3 GetBenchmarkRootPosition(int transformIndex, int frame)
+{
+	return Vec3(100.f * GetBenchmarkFraction(transformIndex, 0) + 0.01f * static_cast<float>(frame), 100.f * GetBenchmarkFraction(transformIndex, 1), 0.f);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// The way games build these today: every frame, every transform, a chain of Mat44 appends onto its parent's matrix.
+static void ComputeHandRolledWorldMatrices(std::vector<Vec3> const& positions, std::vector<EulerAngles> const& orientations, std::vector<Vec3> const& scales, std::vector<Mat44>& out_worldMatrices)
+{
+	for(int transformIndex = 0; transformIndex < static_cast<int>(positions.size()); ++transformIndex)
+	{
+		int parentIndex = GetBenchmarkTransformParent(transformIndex);
+		Mat44 worldMatrix = (parentIndex < 0) ? Mat44() : out_worldMatrices[parentIndex];
+		worldMatrix.Append(Mat44::MakeTranslation3D(positions[transformIndex]));
+		worldMatrix.Append(orientations[transformIndex].GetAsMatrix_IFwd_JLeft_KUp());
+		worldMatrix.AppendScaleNonUniform3D(scales[transformIndex]);
+		out_worldMatrices[transformIndex] = worldMatrix;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// The batch uses the polynomial sine and cosine, so it only matches the hand-rolled matrices to around 1e-6; it dies
+// beyond 1e-4, relative to each value or to one for values near zero.
+static bool CheckWorldMatricesNearHandRolled(TransformHierarchy const& hierarchy, std::vector<TransformID> const& transformIDs, std::vector<Mat44> const& handRolledMatrices, float& out_maxError)
+{
+	constexpr float MAX_RELATIVE_ERROR = 1e-4f;
+	out_maxError = 0.f;
+	for(int transformIndex = 0; transformIndex < static_cast<int>(transformIDs.size()); ++transformIndex)
+	{
+		Mat44 const& worldMatrix = hierarchy.GetWorldMatrix(transformIDs[transformIndex]);
+		for(int valueIndex = 0; valueIndex < Mat44::NUM_INDEXES; ++valueIndex)
+		{
+			float expected = handRolledMatrices[transformIndex].m_values[valueIndex];
+			float error = fabsf(worldMatrix.m_values[valueIndex] - expected);
+			GUARANTEE_OR_RETURN_FALSE(error <= MAX_RELATIVE_ERROR * GetMax(fabsf(expected), 1.f), Stringf("Transform hierarchy: transform %d value %d is %.9g, hand-rolled %.9g",
+							 transformIndex, valueIndex, worldMatrix.m_values[valueIndex], expected));
+			out_maxError = GetMax(out_maxError, error);
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Jobs only split the levels into ranges, so the matrices must come out bit-identical to the calling thread's.
+static bool CheckWorldMatricesMatchSerial(char const* stage, TransformHierarchy const& hierarchy, std::vector<TransformID> const& transformIDs, std::vector<Mat44>& inout_serialMatrices, bool isJobRun)
+{
+	if(!isJobRun)
+	{
+		inout_serialMatrices.resize(transformIDs.size());
+		for(int transformIndex = 0; transformIndex < static_cast<int>(transformIDs.size()); ++transformIndex)
+		{
+			inout_serialMatrices[transformIndex] = hierarchy.GetWorldMatrix(transformIDs[transformIndex]);
+		}
+		return true;
+	}
+
+	for(int transformIndex = 0; transformIndex < static_cast<int>(transformIDs.size()); ++transformIndex)
+	{
+		Mat44 const& worldMatrix = hierarchy.GetWorldMatrix(transformIDs[transformIndex]);
+		GUARANTEE_OR_RETURN_FALSE(memcmp(worldMatrix.m_values, inout_serialMatrices[transformIndex].m_values, sizeof(worldMatrix.m_values)) == 0,
+						 Stringf("Transform hierarchy, %s: transform %d has a different world matrix with jobs", stage, transformIndex));
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Props moving around a level. With every root moving, the hierarchy does the same work as the hand-rolled loop, just
+// batched; with one in twenty moving, it only touches those props. Both runs are checked against the hand-rolled
+// matrices, and the run with jobs against the one without.
+void RunTransformHierarchyBenchmarks(int numTransforms, int numFrames, JobSystem* jobSystem)
+{
+	if(numTransforms <= 0 || numFrames <= 0)
+	{
+		return;
+	}
+
+	DebuggerPrintf("Transform hierarchy benchmarks (%d transforms, %d frames)\n", numTransforms, numFrames);
+
+	std::vector<Vec3> positions(numTransforms);
+	std::vector<EulerAngles> orientations(numTransforms);
+	std::vector<Vec3> scales(numTransforms);
+	for(int transformIndex = 0; transformIndex < numTransforms; ++transformIndex)
+	{
+		bool isRoot = GetBenchmarkTransformParent(transformIndex) < 0;
+		positions[transformIndex] = isRoot ? GetBenchmarkRootPosition(transformIndex, 0) : Vec3(GetBenchmarkFraction(transformIndex, 2), GetBenchmarkFraction(transformIndex, 3), 1.f);
+		orientations[transformIndex] = EulerAngles(360.f * GetBenchmarkFraction(transformIndex, 4), 60.f * GetBenchmarkFraction(transformIndex, 5) - 30.f, 20.f * GetBenchmarkFraction(transformIndex, 6));
+		scales[transformIndex] = Vec3(1.f, 1.f, 1.f) * (0.5f + GetBenchmarkFraction(transformIndex, 7));
+	}
+
+	std::vector<Mat44> handRolledMatrices(numTransforms);
+	double start = GetCurrentTimeSeconds();
+	for(int frame = 0; frame < numFrames; ++frame)
+	{
+		for(int transformIndex = 0; transformIndex < numTransforms; transformIndex += 10)
+		{
+			positions[transformIndex] = GetBenchmarkRootPosition(transformIndex, frame);
+		}
+		ComputeHandRolledWorldMatrices(positions, orientations, scales, handRolledMatrices);
+	}
+	double handRolledSeconds = GetCurrentTimeSeconds() - start;
+
+	std::vector<Mat44> serialMatrices[2];
+	int numRuns = (jobSystem != nullptr) ? 2 : 1;
+	for(int runIndex = 0; runIndex < numRuns; ++runIndex)
+	{
+		JobSystem* hierarchyJobSystem = (runIndex == 0) ? nullptr : jobSystem;
+
+		TransformHierarchyConfig config;
+		config.m_jobSystem = hierarchyJobSystem;
+		TransformHierarchy hierarchy(config);
+		hierarchy.Startup();
+
+		std::vector<TransformID> transformIDs(numTransforms);
+		for(int transformIndex = 0; transformIndex < numTransforms; ++transformIndex)
+		{
+			int parentIndex = GetBenchmarkTransformParent(transformIndex);
+			TransformID parentID = (parentIndex < 0) ? INVALID_TRANSFORM_ID : transformIDs[parentIndex];
+			transformIDs[transformIndex] = hierarchy.CreateTransform(parentID, positions[transformIndex], orientations[transformIndex], scales[transformIndex]);
+		}
+		hierarchy.UpdateWorldMatrices();
+
+		start = GetCurrentTimeSeconds();
+		for(int frame = 0; frame < numFrames; ++frame)
+		{
+			for(int transformIndex = 0; transformIndex < numTransforms; transformIndex += 10)
+			{
+				hierarchy.SetLocalPosition(transformIDs[transformIndex], GetBenchmarkRootPosition(transformIndex, frame));
+			}
+			hierarchy.UpdateWorldMatrices();
+		}
+		double allMovingSeconds = GetCurrentTimeSeconds() - start;
+		PrintBenchmarkResult(hierarchyJobSystem != nullptr ? "all moving, jobs" : "all moving", numTransforms * numFrames, "appends", handRolledSeconds, hierarchyJobSystem != nullptr ? "jobs" : "batched", allMovingSeconds);
+
+		float maxError = 0.f;
+		if(!CheckWorldMatricesNearHandRolled(hierarchy, transformIDs, handRolledMatrices, maxError) ||
+		   !CheckWorldMatricesMatchSerial("all moving", hierarchy, transformIDs, serialMatrices[0], hierarchyJobSystem != nullptr))
+		{
+			hierarchy.Shutdown();
+			return;
+		}
+
+		int numUpdated = 0;
+		start = GetCurrentTimeSeconds();
+		for(int frame = 0; frame < numFrames; ++frame)
+		{
+			for(int transformIndex = 10 * (frame % 20); transformIndex < numTransforms; transformIndex += 200)
+			{
+				hierarchy.SetLocalPosition(transformIDs[transformIndex], GetBenchmarkRootPosition(transformIndex, frame));
+			}
+			hierarchy.UpdateWorldMatrices();
+			numUpdated += hierarchy.GetNumWorldMatricesUpdated();
+		}
+		double fewMovingSeconds = GetCurrentTimeSeconds() - start;
+		PrintBenchmarkResult(hierarchyJobSystem != nullptr ? "5% moving, jobs" : "5% moving", numTransforms * numFrames, "appends", handRolledSeconds, hierarchyJobSystem != nullptr ? "jobs" : "batched", fewMovingSeconds);
+		DebuggerPrintf("  %-28s %d per frame\n", "  world matrices updated", numUpdated / numFrames);
+		DebuggerPrintf("  %-28s %g\n", "  max difference", maxError);
+		bool isMatch = CheckWorldMatricesMatchSerial("5% moving", hierarchy, transformIDs, serialMatrices[1], hierarchyJobSystem != nullptr);
+
+		s_benchmarkSink = s_benchmarkSink + hierarchy.GetWorldMatrix(transformIDs[numTransforms - 1]).m_values[Mat44::Tx];
+		hierarchy.Shutdown();
+		if(!isMatch)
+		{
+			return;
+		}
+	}
+
+	s_benchmarkSink = s_benchmarkSink + handRolledMatrices[numTransforms - 1].m_values[Mat44::Tx];
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static bool IsBenchmarkSuiteSelected(std::string const& suiteName, char const* name)
+{
+	return suiteName == "all" || suiteName == name;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool RunMathBenchmarks(std::string const& suiteName, JobSystem* jobSystem)
+{
+	bool const isKnownSuite = suiteName == "all" || suiteName == "mat44" || suiteName == "vertex" || suiteName == "trig" || suiteName == "bvh" ||
+							  suiteName == "broadphase" || suiteName == "spatialhash" || suiteName == "frustum" || suiteName == "occlusion" ||
+							  suiteName == "curve" || suiteName == "piecewise" || suiteName == "random" || suiteName == "noise" || suiteName == "convex" ||
+							  suiteName == "swept" || suiteName == "raypacket" || suiteName == "physics" || suiteName == "hull" || suiteName == "hullquery" ||
+							  suiteName == "hierarchy";
+	if(!isKnownSuite)
+	{
+		return false;
+	}
+
+	if(IsBenchmarkSuiteSelected(suiteName, "mat44"))			RunMat44Benchmarks();
+	if(IsBenchmarkSuiteSelected(suiteName, "vertex"))			RunVertexTransformBenchmarks(1000000, jobSystem);
+	if(IsBenchmarkSuiteSelected(suiteName, "trig"))				RunTrigBenchmarks();
+	if(IsBenchmarkSuiteSelected(suiteName, "bvh"))				RunBVHBenchmarks(1000000, 1000000, jobSystem);
+	if(IsBenchmarkSuiteSelected(suiteName, "broadphase"))		RunBroadphaseBenchmarks();
+	if(IsBenchmarkSuiteSelected(suiteName, "spatialhash"))		RunSpatialHashBenchmarks();
+	if(IsBenchmarkSuiteSelected(suiteName, "frustum"))			RunFrustumCullingBenchmarks(100000, 60, jobSystem);
+	if(IsBenchmarkSuiteSelected(suiteName, "occlusion"))		RunOcclusionCullingBenchmarks(100000, 64, 60, jobSystem);
+	if(IsBenchmarkSuiteSelected(suiteName, "curve"))			RunCurveBenchmarks();
+	if(IsBenchmarkSuiteSelected(suiteName, "piecewise"))		RunPieceWiseCurveBenchmarks();
+	if(IsBenchmarkSuiteSelected(suiteName, "random"))			RunRandomBenchmarks();
+	if(IsBenchmarkSuiteSelected(suiteName, "noise"))			RunFractalNoiseBenchmarks(512, 6, jobSystem);
+	if(IsBenchmarkSuiteSelected(suiteName, "convex"))			RunConvexCollisionBenchmarks();
+	if(IsBenchmarkSuiteSelected(suiteName, "swept"))			RunSweptCollisionBenchmarks();
+	if(IsBenchmarkSuiteSelected(suiteName, "raypacket"))		RunRayPacketBenchmarks();
+	if(IsBenchmarkSuiteSelected(suiteName, "physics"))			RunPhysicsWorld2DBenchmarks(20000, 60, jobSystem);
+	if(IsBenchmarkSuiteSelected(suiteName, "hull"))				RunConvexHullBenchmarks();
+	if(IsBenchmarkSuiteSelected(suiteName, "hullquery"))		RunConvexHullQueryBenchmarks();
+	if(IsBenchmarkSuiteSelected(suiteName, "hierarchy"))		RunTransformHierarchyBenchmarks(100000, 60, jobSystem);
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Console commands are plain function pointers, so the JobSystem given at registration waits here.
+static JobSystem* s_benchmarkCommandJobSystem = nullptr;
+
+//------------------------------------------------------------------------------------------------------------------
+static bool OnMathBenchmarksCommand(ConsoleCommandArgs const& args)
+{
+	std::string const& suiteName = args.IsSet(0) ? args.GetString(0) : std::string("all");
+	s_benchmarkFailureConsole = g_devConsole;
+	s_numBenchmarkFailures = 0;
+	bool isKnownSuite = RunMathBenchmarks(suiteName, s_benchmarkCommandJobSystem);
+	s_benchmarkFailureConsole = nullptr;
+	if(!isKnownSuite)
+	{
+		g_devConsole->AddLine(DevConsole::ERROR, Stringf("Unknown benchmark suite '%s'", suiteName.c_str()));
+		return false;
+	}
+
+	if(s_numBenchmarkFailures > 0)
+	{
+		g_devConsole->AddLine(DevConsole::ERROR, Stringf("Math benchmarks '%s': %d checks failed, each stopping its suite", suiteName.c_str(), s_numBenchmarkFailures));
+		return false;
+	}
+
+	g_devConsole->AddLine(DevConsole::SUCCESS, Stringf("Math benchmarks '%s' done; timings are in the debugger output", suiteName.c_str()));
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void RegisterMathBenchmarksCommand(DevConsole& devConsole, JobSystem* jobSystem)
+{
+	s_benchmarkCommandJobSystem = jobSystem;
+
+	ConsoleArgDefinition suiteArg;
+	suiteArg.m_name = "suite";
+	suiteArg.m_type = ConsoleArgType::STRING;
+	devConsole.RegisterCommand("MathBenchmarks", OnMathBenchmarksCommand, { suiteArg }, "Times and checks the math kernels (suite=all, mat44, trig, bvh, ...); the game stalls until it finishes");
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void UnregisterMathBenchmarksCommand(DevConsole& devConsole)
+{
+	devConsole.UnregisterCommand("MathBenchmarks");
+	s_benchmarkCommandJobSystem = nullptr;
+}
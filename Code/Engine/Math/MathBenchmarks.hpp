@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+
+//------------------------------------------------------------------------------------------------------------------
+// Timings of the hot math kernels against the code they replace, printed to the debugger output. Run them from the
+// "MathBenchmarks suite=<name>" console command in a Release build; the numbers in Debug are meaningless. Each suite
+// first checks the fast path against its scalar or brute-force reference. A mismatch is fatal when the suites are run
+// from code; from the console command it is printed as an error and stops that suite.
+//------------------------------------------------------------------------------------------------------------------
+class DevConsole;
+class JobSystem;
+
+//------------------------------------------------------------------------------------------------------------------
+void RunMat44Benchmarks(int numIterations = 1000000);
+void RunVertexTransformBenchmarks(int numVerts = 1000000, JobSystem* jobSystem = nullptr);
+void RunTrigBenchmarks(int numAngles = 1000000);
+void RunBVHBenchmarks(int numTriangles = 1000000, int numRays = 1000000, JobSystem* jobSystem = nullptr);
+void RunBroadphaseBenchmarks(int numProxies = 10000, int numFrames = 60);
+void RunSpatialHashBenchmarks(int numDiscs = 50000, int numFrames = 60);
+void RunFrustumCullingBenchmarks(int numObjects = 100000, int numFrames = 60, JobSystem* jobSystem = nullptr);
+void RunOcclusionCullingBenchmarks(int numObjects = 100000, int numOccluders = 64, int numFrames = 60, JobSystem* jobSystem = nullptr);
+void RunCurveBenchmarks(int numSplinePoints = 64, int numQueries = 10000);
+void RunPieceWiseCurveBenchmarks(int numKeys = 32, int numEvaluations = 1000000);
+void RunRandomBenchmarks(int numValues = 1000000);
+void RunFractalNoiseBenchmarks(int gridSize = 512, int numOctaves = 6, JobSystem* jobSystem = nullptr);
+void RunConvexCollisionBenchmarks(int numPairs = 100000);
+void RunSweptCollisionBenchmarks(int numProjectiles = 100000, int numBoxes = 4096);
+void RunRayPacketBenchmarks(int numRays = 100000, int numShapes = 4096);
+void RunPhysicsWorld2DBenchmarks(int numBodies = 20000, int numFrames = 60, JobSystem* jobSystem = nullptr);
+void RunConvexHullBenchmarks(int numPoints = 100000);
+void RunConvexHullQueryBenchmarks(int numPoints = 10000, int numHulls = 48);
+void RunTransformHierarchyBenchmarks(int numTransforms = 100000, int numFrames = 60, JobSystem* jobSystem = nullptr);
+
+// One suite by name (mat44, vertex, trig, bvh, broadphase, spatialhash, frustum, occlusion, curve, piecewise, random,
+// noise, convex, swept, raypacket, physics, hull, hullquery, hierarchy), or every suite for "all", at the default sizes.
+// Returns false for an unknown name.
+bool RunMathBenchmarks(std::string const& suiteName = "all", JobSystem* jobSystem = nullptr);
+
+// The engine does not register the command. A game that wants it, usually only in its development builds, registers it
+// after DevConsole::Startup with the JobSystem for the job variants (or nullptr), and unregisters it before shutdown.
+// Every suite runs on the calling thread, so the game stalls until the command finishes; "all" takes minutes.
+void RegisterMathBenchmarksCommand(DevConsole& devConsole, JobSystem* jobSystem);
+void UnregisterMathBenchmarksCommand(DevConsole& devConsole);
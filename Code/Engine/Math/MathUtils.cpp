@@ -11,12 +11,15 @@
 #include "Engine/Math/Cylinder3D.hpp"
 #include "Engine/Math/Sphere.hpp"
 #include "Engine/Math/ConvexHull2.hpp"
+#include "Engine/Math/ConvexHull3.hpp"
 #include "Engine/Math/LineSegment2.hpp"
 #include "Engine/Math/Capsule2.hpp"
 #include "Engine/Math/Triangle2.hpp"
 #include "Engine/Math/IntVec2.hpp"
 #include "Engine/Math/FloatRange.hpp"
+#include "Engine/Math/FastTrig.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Game/EngineBuildPreferences.hpp"
 
 #include <math.h>
 
@@ -38,9 +41,14 @@ float ConvertRadiansToDegrees(float rad)
 
 
 
+// ENGINE_FAST_TRIG swaps these for the polynomial versions in FastTrig.hpp
 float CosDegrees(float deg)
 {
+#if defined(ENGINE_FAST_TRIG)
+    return FastCosDegrees(deg);
+#else
     return cosf(deg * (3.1415926f / 180.f));
+#endif
 }
 
 
@@ -48,7 +56,26 @@ float CosDegrees(float deg)
 float SinDegrees(float deg)
 {
 
+#if defined(ENGINE_FAST_TRIG)
+    return FastSinDegrees(deg);
+#else
     return sinf(deg * (3.1415926f / 180.f));
+#endif
+
+}
+
+
+
+void SinCosDegrees(float deg, float& out_sine, float& out_cosine)
+{
+
+#if defined(ENGINE_FAST_TRIG)
+    FastSinCosDegrees(deg, out_sine, out_cosine);
+#else
+    float rad = deg * (3.1415926f / 180.f);
+    out_sine = sinf(rad);
+    out_cosine = cosf(rad);
+#endif
 
 }
 
@@ -57,7 +84,11 @@ float SinDegrees(float deg)
 float ATan2Degrees(float y, float x)
 {
 
+#if defined(ENGINE_FAST_TRIG)
+    return FastATan2Degrees(y, x);
+#else
     return atan2f(y, x) * (180.f / 3.1415926f);
+#endif
 
 }
 
@@ -579,6 +610,34 @@ bool DoesCylinderAndSphereOverlap(Cylinder3D const& cylinder, Sphere const& sphe
 
 }
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+AABB3 GetBoundsForSphere(Sphere const& sphere)
+{
+	Vec3 extents(sphere.m_radius, sphere.m_radius, sphere.m_radius);
+	return AABB3(sphere.m_center - extents, sphere.m_center + extents);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+AABB3 GetBoundsForOBB3(OBB3 const& obb)
+{
+	Vec3 i = obb.m_iBasis * obb.m_halfDimensions.x;
+	Vec3 j = obb.m_jBasis * obb.m_halfDimensions.y;
+	Vec3 k = obb.m_kBasis * obb.m_halfDimensions.z;
+	Vec3 extents(fabsf(i.x) + fabsf(j.x) + fabsf(k.x), fabsf(i.y) + fabsf(j.y) + fabsf(k.y), fabsf(i.z) + fabsf(j.z) + fabsf(k.z));
+
+	return AABB3(obb.m_center - extents, obb.m_center + extents);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+AABB3 GetBoundsForCylinder3D(Cylinder3D const& cylinder)
+{
+	float bottomZ = GetMin(cylinder.m_startPosition.z, cylinder.m_startPosition.z + cylinder.m_height);
+	float topZ = GetMax(cylinder.m_startPosition.z, cylinder.m_startPosition.z + cylinder.m_height);
+
+	return AABB3(cylinder.m_startPosition.x - cylinder.m_radius, cylinder.m_startPosition.y - cylinder.m_radius, bottomZ,
+				 cylinder.m_startPosition.x + cylinder.m_radius, cylinder.m_startPosition.y + cylinder.m_radius, topZ);
+}
+
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
 bool IsPointInsideDisc2D(Vec2 const& point, Vec2 const& discCenter, float discRadius)
@@ -832,6 +891,20 @@ bool IsPointInFrontOfPlane(Vec3 const& referencePoint, Plane3 const& plane)
     return plane.GetAltitudeFromPoint(referencePoint) > 0.f;
 }
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool IsPointInsideConvexHull3(Vec3 const& refPoint, ConvexHull3 const& hull)
+{
+	for(Plane3 const& plane : hull.m_planes)
+	{
+		if(plane.GetAltitudeFromPoint(refPoint) >= 0.f)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
 Vec2 const GetNearestPointOnDisc2D(Vec2 const& referencePosition, Vec2 const& discCenter, float discRadius)
 {
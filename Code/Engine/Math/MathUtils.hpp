@@ -31,12 +31,14 @@ struct Triangle2;
 struct Plane3;
 struct Plane2;
 struct ConvexHull2;
+struct ConvexHull3;
 
 // Degrees and radians
 float ConvertDegreesToRadians(float deg);
 float ConvertRadiansToDegrees(float rad);
 float CosDegrees(float deg);
 float SinDegrees(float deg);
+void  SinCosDegrees(float deg, float& out_sine, float& out_cosine);
 float ATan2Degrees(float y, float x);
 float GetShortestAngularDispDegrees(float startDegrees, float endDegrees);
 float GetTurnedTowardDegrees(float currentDegrees, float goalDegrees, float maxDeltaDegrees);
@@ -88,6 +90,10 @@ bool DoesSphereAndOBB3Overlap(Sphere const& sphere, OBB3 const& box);
 bool DoesCylinderAndBoxOverlap(Cylinder3D const& cylinder, AABB3 const& box);
 bool DoesCylinderAndSphereOverlap(Cylinder3D const& cylinder, Sphere const& sphere);
 
+AABB3 GetBoundsForSphere(Sphere const& sphere);
+AABB3 GetBoundsForOBB3(OBB3 const& obb);
+AABB3 GetBoundsForCylinder3D(Cylinder3D const& cylinder);
+
 bool IsPointInsideDisc2D(Vec2 const& point, Vec2 const& discCenter, float discRadius);
 bool IsPointInsideOrientedSector2D(Vec2 const& point, Vec2 const& sectorTip, float sectorForwardDegrees, float sectorApertureDegree, float sectorRadius); 
 bool IsPointInsideDirectedSector2D(Vec2 const& point, Vec2 const& sectorTip, Vec2 const& sectorForwardNormal, float sectorApertureDegree, float sectorRadius);
@@ -107,6 +113,7 @@ bool IsPointInsideCylinder3D(Vec3 const& point, Cylinder3D const& cylinder);
 bool IsPointInsideOBB3D(Vec3 const& point, OBB3 const& obb);
 
 bool IsPointInFrontOfPlane(Vec3 const& referencePoint, Plane3 const& plane);
+bool IsPointInsideConvexHull3(Vec3 const& refPoint, ConvexHull3 const& hull);
 
 Vec2 const GetNearestPointOnDisc2D(Vec2 const& referencePosition, Vec2 const& discCenter, float discRadius);
 Vec2 const GetNearestPointOnAABB2D(Vec2 const& referencePosition, AABB2 const& box);
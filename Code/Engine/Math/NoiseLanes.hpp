@@ -0,0 +1,70 @@
+#pragma once
+#include "Engine/Math/SIMDUtils.hpp"
+
+//------------------------------------------------------------------------------------------------------------------
+// Lane versions of the ThirdParty/Noise/RawNoise.hpp hashes for batch kernels, written against the UInt*Ops
+// adapters so one template serves 8, 4 and 1 lanes; NoiseLaneOps is the widest adapter this build has. Every lane
+// gives exactly the bits its scalar counterpart returns for the same inputs; keep them in step with RawNoise.
+//------------------------------------------------------------------------------------------------------------------
+#if defined(ENGINE_SIMD_AVX2)
+typedef UInt8Ops NoiseLaneOps;
+#elif defined(ENGINE_SIMD_FLOAT4)
+typedef UInt4Ops NoiseLaneOps;
+#else
+typedef UInt1Ops NoiseLaneOps;
+#endif
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename Ops>
+inline typename Ops::Type SquirrelNoise5Lanes(typename Ops::Type positions, unsigned int seed)
+{
+	typedef typename Ops::Type Lane;
+
+	Lane mangledBits = Ops::Mul(positions, Ops::Splat(0xd2a80a3f));
+	mangledBits = Ops::Add(mangledBits, Ops::Splat(seed));
+	mangledBits = Ops::Xor(mangledBits, Ops::template ShiftRight<9>(mangledBits));
+	mangledBits = Ops::Add(mangledBits, Ops::Splat(0xa884f197));
+	mangledBits = Ops::Xor(mangledBits, Ops::template ShiftRight<11>(mangledBits));
+	mangledBits = Ops::Mul(mangledBits, Ops::Splat(0x6C736F4B));
+	mangledBits = Ops::Xor(mangledBits, Ops::template ShiftRight<13>(mangledBits));
+	mangledBits = Ops::Add(mangledBits, Ops::Splat(0xB79F3ABB));
+	mangledBits = Ops::Xor(mangledBits, Ops::template ShiftRight<15>(mangledBits));
+	mangledBits = Ops::Mul(mangledBits, Ops::Splat(0x1b56c4f5));
+	mangledBits = Ops::Xor(mangledBits, Ops::template ShiftRight<17>(mangledBits));
+	return mangledBits;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename Ops>
+inline typename Ops::Type Get2dNoiseUintLanes(typename Ops::Type indexX, typename Ops::Type indexY, unsigned int seed)
+{
+	constexpr unsigned int PRIME_NUMBER = 198491317;
+	return SquirrelNoise5Lanes<Ops>(Ops::Add(indexX, Ops::Mul(Ops::Splat(PRIME_NUMBER), indexY)), seed);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename Ops>
+inline typename Ops::Type Get3dNoiseUintLanes(typename Ops::Type indexX, typename Ops::Type indexY, typename Ops::Type indexZ, unsigned int seed)
+{
+	constexpr unsigned int PRIME1 = 198491317;
+	constexpr unsigned int PRIME2 = 6542989;
+	typename Ops::Type position = Ops::Add(Ops::Add(indexX, Ops::Mul(Ops::Splat(PRIME1), indexY)), Ops::Mul(Ops::Splat(PRIME2), indexZ));
+	return SquirrelNoise5Lanes<Ops>(position, seed);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// RawNoise maps hashes onto [0, 1] in double precision, so these do too
+template<typename Ops>
+inline typename Ops::FloatOps::Type Get2dNoiseZeroToOneLanes(typename Ops::Type indexX, typename Ops::Type indexY, unsigned int seed)
+{
+	constexpr double ONE_OVER_MAX_UINT = (1.0 / (double) 0xFFFFFFFF);
+	return Ops::ToFloatViaDouble(Get2dNoiseUintLanes<Ops>(indexX, indexY, seed), ONE_OVER_MAX_UINT);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename Ops>
+inline typename Ops::FloatOps::Type Get3dNoiseZeroToOneLanes(typename Ops::Type indexX, typename Ops::Type indexY, typename Ops::Type indexZ, unsigned int seed)
+{
+	constexpr double ONE_OVER_MAX_UINT = (1.0 / (double) 0xFFFFFFFF);
+	return Ops::ToFloatViaDouble(Get3dNoiseUintLanes<Ops>(indexX, indexY, indexZ, seed), ONE_OVER_MAX_UINT);
+}
@@ -0,0 +1,317 @@
+#include "Engine/Math/PackedConvexHulls2.hpp"
+#include "Engine/Math/ConvexHull2.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/SIMDUtils.hpp"
+
+#include <algorithm>
+#include <float.h>
+#include <math.h>
+
+//------------------------------------------------------------------------------------------------------------------
+#if defined(ENGINE_SIMD_AVX2)
+typedef Float8Ops HullOps;
+#else
+typedef Float4Ops HullOps;
+#endif
+
+typedef HullOps::Type			HullLane;
+
+constexpr int HULL_LANES = HullOps::WIDTH;
+
+//------------------------------------------------------------------------------------------------------------------
+// Padding planes: a zero normal at distance 1 puts every point at altitude -1, behind the plane.
+constexpr float PADDING_PLANE_DISTANCE = 1.f;
+
+//------------------------------------------------------------------------------------------------------------------
+// A hull is closed when its normals leave no gap of half a turn or more; otherwise it runs off to infinity between
+// the two normals either side of the gap.
+static bool IsPlaneSetClosed2(std::vector<Plane2> const& planes)
+{
+	if(planes.size() < 3)
+	{
+		return false;
+	}
+
+	std::vector<float> normalRadians;
+	normalRadians.reserve(planes.size());
+	for(Plane2 const& plane : planes)
+	{
+		normalRadians.push_back(atan2f(plane.m_normal.y, plane.m_normal.x));
+	}
+	std::sort(normalRadians.begin(), normalRadians.end());
+
+	float const pi = 3.14159265f;
+	float maxGap = normalRadians.front() + 2.f * pi - normalRadians.back();
+	for(size_t index = 1; index < normalRadians.size(); ++index)
+	{
+		maxGap = GetMax(maxGap, normalRadians[index] - normalRadians[index - 1]);
+	}
+
+	return maxGap < pi - 0.0001f;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// The disc around the corners where pairs of planes meet on the hull. An open hull gets an infinite disc and an empty
+// one (planes with no common interior) a negative radius, so the disc test rejects every point.
+static void GetBoundingDiscOfPlaneSet2(std::vector<Plane2> const& planes, Vec2& out_center, float& out_radiusSquared)
+{
+	out_center = Vec2();
+	if(!IsPlaneSetClosed2(planes))
+	{
+		out_radiusSquared = FLT_MAX;
+		return;
+	}
+
+	float maxAbsDistance = 0.f;
+	for(Plane2 const& plane : planes)
+	{
+		maxAbsDistance = GetMax(maxAbsDistance, fabsf(plane.m_distanceFromOrigin));
+	}
+	float tolerance = 0.0001f * (1.f + maxAbsDistance);
+
+	std::vector<Vec2> corners;
+	for(size_t indexA = 0; indexA < planes.size(); ++indexA)
+	{
+		for(size_t indexB = indexA + 1; indexB < planes.size(); ++indexB)
+		{
+			Vec2 const& normalA = planes[indexA].m_normal;
+			Vec2 const& normalB = planes[indexB].m_normal;
+			float determinant = CrossProduct2D(normalA, normalB);
+			if(fabsf(determinant) < 0.00001f)
+			{
+				continue;
+			}
+
+			float distanceA = planes[indexA].m_distanceFromOrigin;
+			float distanceB = planes[indexB].m_distanceFromOrigin;
+			Vec2 corner((distanceA * normalB.y - distanceB * normalA.y) / determinant, (normalA.x * distanceB - normalB.x * distanceA) / determinant);
+
+			bool isOnHull = true;
+			for(size_t planeIndex = 0; planeIndex < planes.size() && isOnHull; ++planeIndex)
+			{
+				isOnHull = planes[planeIndex].GetAltitudeFromPoint(corner) <= tolerance;
+			}
+			if(isOnHull)
+			{
+				corners.push_back(corner);
+			}
+		}
+	}
+
+	if(corners.empty())
+	{
+		out_radiusSquared = -1.f;
+		return;
+	}
+
+	Vec2 mins = corners.front();
+	Vec2 maxs = corners.front();
+	for(Vec2 const& corner : corners)
+	{
+		mins = Vec2(GetMin(mins.x, corner.x), GetMin(mins.y, corner.y));
+		maxs = Vec2(GetMax(maxs.x, corner.x), GetMax(maxs.y, corner.y));
+	}
+	out_center = (mins + maxs) * 0.5f;
+
+	float radiusSquared = 0.f;
+	for(Vec2 const& corner : corners)
+	{
+		radiusSquared = GetMax(radiusSquared, GetVectorDistanceSquared2D(corner, out_center));
+	}
+
+	// a little slack so rounding in the corners can never reject a point the planes would accept
+	float radius = sqrtf(radiusSquared) + tolerance;
+	out_radiusSquared = radius * radius;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int PackedConvexHulls2::AddHull(ConvexHull2 const& hull)
+{
+	for(Plane2 const& plane : hull.m_planes)
+	{
+		m_normalX.push_back(plane.m_normal.x);
+		m_normalY.push_back(plane.m_normal.y);
+		m_distance.push_back(plane.m_distanceFromOrigin);
+	}
+
+	while(m_normalX.size() % HULL_LANES != 0)
+	{
+		m_normalX.push_back(0.f);
+		m_normalY.push_back(0.f);
+		m_distance.push_back(PADDING_PLANE_DISTANCE);
+	}
+	m_planeStarts.push_back(static_cast<int>(m_normalX.size()));
+
+	Vec2 boundCenter;
+	float boundRadiusSquared;
+	GetBoundingDiscOfPlaneSet2(hull.m_planes, boundCenter, boundRadiusSquared);
+	m_boundCenterX.push_back(boundCenter.x);
+	m_boundCenterY.push_back(boundCenter.y);
+	m_boundRadiusSquared.push_back(boundRadiusSquared);
+
+	return GetNumHulls() - 1;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void PackedConvexHulls2::Clear()
+{
+	m_normalX.clear();
+	m_normalY.clear();
+	m_distance.clear();
+	m_planeStarts.assign(1, 0);
+	m_boundCenterX.clear();
+	m_boundCenterY.clear();
+	m_boundRadiusSquared.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Loads lanes [first, first + numLanes) of an array, zero-padding a partial group.
+static HullLane LoadHullLanes(float const* values, int first, int numLanes)
+{
+	if(numLanes == HULL_LANES)
+	{
+		return HullOps::Load(values + first);
+	}
+
+	float padded[HULL_LANES] = {};
+	for(int lane = 0; lane < numLanes; ++lane)
+	{
+		padded[lane] = values[first + lane];
+	}
+	return HullOps::Load(padded);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Altitude of points above planes, lane by lane, in the same order of operations as Plane2::GetAltitudeFromPoint.
+static HullLane GetHullAltitudes(HullLane pointX, HullLane pointY, HullLane normalX, HullLane normalY, HullLane distance)
+{
+	return HullOps::Sub(HullOps::Add(HullOps::Mul(pointX, normalX), HullOps::Mul(pointY, normalY)), distance);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// A group of points (one per lane) against one hull; returns the bits of the lanes in testBits that are inside.
+static int GetPointLanesInsideHull(PackedConvexHulls2 const& hulls, int hullIndex, HullLane pointX, HullLane pointY, int testBits)
+{
+	HullLane toCenterX = HullOps::Sub(pointX, HullOps::Splat(hulls.m_boundCenterX[hullIndex]));
+	HullLane toCenterY = HullOps::Sub(pointY, HullOps::Splat(hulls.m_boundCenterY[hullIndex]));
+	HullLane distanceSquared = HullOps::Add(HullOps::Mul(toCenterX, toCenterX), HullOps::Mul(toCenterY, toCenterY));
+	int candidateBits = HullOps::GetMaskBits(HullOps::CmpLe(distanceSquared, HullOps::Splat(hulls.m_boundRadiusSquared[hullIndex]))) & testBits;
+
+	HullLane zero = HullOps::Zero();
+	int outsideBits = 0;
+	int planeEnd = hulls.m_planeStarts[hullIndex + 1];
+	for(int planeIndex = hulls.m_planeStarts[hullIndex]; planeIndex < planeEnd && outsideBits != candidateBits; ++planeIndex)
+	{
+		HullLane altitude = GetHullAltitudes(pointX, pointY, HullOps::Splat(hulls.m_normalX[planeIndex]), HullOps::Splat(hulls.m_normalY[planeIndex]), HullOps::Splat(hulls.m_distance[planeIndex]));
+		outsideBits |= HullOps::GetMaskBits(HullOps::CmpGe(altitude, zero)) & candidateBits;
+	}
+
+	return candidateBits & ~outsideBits;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// One point against one hull, with the lanes running over the hull's planes; the padding makes every group full.
+static bool IsPointInsidePackedHull(PackedConvexHulls2 const& hulls, int hullIndex, HullLane pointX, HullLane pointY)
+{
+	HullLane zero = HullOps::Zero();
+	int planeEnd = hulls.m_planeStarts[hullIndex + 1];
+	for(int firstPlane = hulls.m_planeStarts[hullIndex]; firstPlane < planeEnd; firstPlane += HULL_LANES)
+	{
+		HullLane altitude = GetHullAltitudes(pointX, pointY, HullOps::Load(&hulls.m_normalX[firstPlane]), HullOps::Load(&hulls.m_normalY[firstPlane]), HullOps::Load(&hulls.m_distance[firstPlane]));
+		if(HullOps::GetMaskBits(HullOps::CmpGe(altitude, zero)) != 0)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int GetPointsInsideConvexHull2(PackedConvexHulls2 const& hulls, int hullIndex, Vec2SoA const& points, std::vector<int>& out_insideIndexes)
+{
+	out_insideIndexes.resize(points.m_count);
+	int numInside = 0;
+
+	for(int first = 0; first < points.m_count; first += HULL_LANES)
+	{
+		int numLanes = GetMin(points.m_count - first, HULL_LANES);
+		int validBits = (1 << numLanes) - 1;
+		HullLane pointX = LoadHullLanes(points.m_x, first, numLanes);
+		HullLane pointY = LoadHullLanes(points.m_y, first, numLanes);
+
+		int insideBits = GetPointLanesInsideHull(hulls, hullIndex, pointX, pointY, validBits);
+		for(int lane = 0; insideBits != 0; ++lane, insideBits >>= 1)
+		{
+			if(insideBits & 1)
+			{
+				out_insideIndexes[numInside++] = first + lane;
+			}
+		}
+	}
+
+	out_insideIndexes.resize(numInside);
+	return numInside;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int GetConvexHulls2ContainingPoint(PackedConvexHulls2 const& hulls, Vec2 const& point, std::vector<int>& out_hullIndexes)
+{
+	out_hullIndexes.clear();
+
+	int numHulls = hulls.GetNumHulls();
+	HullLane pointX = HullOps::Splat(point.x);
+	HullLane pointY = HullOps::Splat(point.y);
+
+	for(int first = 0; first < numHulls; first += HULL_LANES)
+	{
+		int numLanes = GetMin(numHulls - first, HULL_LANES);
+		int validBits = (1 << numLanes) - 1;
+
+		HullLane toCenterX = HullOps::Sub(pointX, LoadHullLanes(hulls.m_boundCenterX.data(), first, numLanes));
+		HullLane toCenterY = HullOps::Sub(pointY, LoadHullLanes(hulls.m_boundCenterY.data(), first, numLanes));
+		HullLane distanceSquared = HullOps::Add(HullOps::Mul(toCenterX, toCenterX), HullOps::Mul(toCenterY, toCenterY));
+		HullLane radiusSquared = LoadHullLanes(hulls.m_boundRadiusSquared.data(), first, numLanes);
+		int candidateBits = HullOps::GetMaskBits(HullOps::CmpLe(distanceSquared, radiusSquared)) & validBits;
+
+		for(int lane = 0; candidateBits != 0; ++lane, candidateBits >>= 1)
+		{
+			if((candidateBits & 1) && IsPointInsidePackedHull(hulls, first + lane, pointX, pointY))
+			{
+				out_hullIndexes.push_back(first + lane);
+			}
+		}
+	}
+
+	return static_cast<int>(out_hullIndexes.size());
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int GetFirstConvexHull2ContainingPoints(PackedConvexHulls2 const& hulls, Vec2SoA const& points, std::vector<int>& out_hullIndexes)
+{
+	out_hullIndexes.assign(points.m_count, -1);
+
+	int numHulls = hulls.GetNumHulls();
+	for(int first = 0; first < points.m_count; first += HULL_LANES)
+	{
+		int numLanes = GetMin(points.m_count - first, HULL_LANES);
+		int unresolvedBits = (1 << numLanes) - 1;
+		HullLane pointX = LoadHullLanes(points.m_x, first, numLanes);
+		HullLane pointY = LoadHullLanes(points.m_y, first, numLanes);
+
+		for(int hullIndex = 0; hullIndex < numHulls && unresolvedBits != 0; ++hullIndex)
+		{
+			int insideBits = GetPointLanesInsideHull(hulls, hullIndex, pointX, pointY, unresolvedBits);
+			unresolvedBits &= ~insideBits;
+			for(int lane = 0; insideBits != 0; ++lane, insideBits >>= 1)
+			{
+				if(insideBits & 1)
+				{
+					out_hullIndexes[first + lane] = hullIndex;
+				}
+			}
+		}
+	}
+
+	return points.m_count;
+}
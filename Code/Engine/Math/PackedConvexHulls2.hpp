@@ -0,0 +1,57 @@
+#pragma once
+#include "Engine/Math/Vec2.hpp"
+
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------
+struct ConvexHull2;
+
+//------------------------------------------------------------------------------------------------------------------
+struct Vec2SoA
+{
+	int				m_count = 0;
+	float const*	m_x = nullptr;
+	float const*	m_y = nullptr;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Many ConvexHull2s packed into parallel plane arrays for the batch point tests below.
+//
+// Hull i owns planes [m_planeStarts[i], m_planeStarts[i + 1]). Each hull's run is padded up to the SIMD width with
+// planes that every point is behind, so a group of planes can be loaded and tested without a remainder loop. Each hull
+// also keeps a bounding disc around its corners; points outside it skip the plane tests entirely. A hull that is open
+// on some side (fewer than three planes, or normals that do not surround the origin) gets an infinite disc.
+//
+// Inside means strictly behind every plane, the same as IsPointInsideConvexHull2, so the results match it exactly.
+//------------------------------------------------------------------------------------------------------------------
+struct PackedConvexHulls2
+{
+public:
+	int		AddHull(ConvexHull2 const& hull);		// returns the new hull's index
+	void	Clear();
+	int		GetNumHulls() const							{ return static_cast<int>(m_boundCenterX.size()); }
+
+public:
+	std::vector<float>	m_normalX;
+	std::vector<float>	m_normalY;
+	std::vector<float>	m_distance;
+	std::vector<int>	m_planeStarts = { 0 };
+
+	std::vector<float>	m_boundCenterX;
+	std::vector<float>	m_boundCenterY;
+	std::vector<float>	m_boundRadiusSquared;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Batch point-in-hull tests, 8 lanes at a time on AVX2 builds (4 otherwise). Each overwrites its output vector and
+// returns the number of entries written.
+//
+// Many points vs one hull: the lanes are points and the hull's planes are splatted one at a time; a group stops as
+// soon as every point in it is outside some plane.
+// One point vs many hulls: the lanes are first the hulls' bounding discs, then each surviving hull's planes.
+// Per point, first hull: out_hullIndexes gets one entry per point, the lowest hull index containing it or -1, which is
+// the usual "which zone is this actor in" query for a whole crowd at once.
+//------------------------------------------------------------------------------------------------------------------
+int GetPointsInsideConvexHull2(PackedConvexHulls2 const& hulls, int hullIndex, Vec2SoA const& points, std::vector<int>& out_insideIndexes);
+int GetConvexHulls2ContainingPoint(PackedConvexHulls2 const& hulls, Vec2 const& point, std::vector<int>& out_hullIndexes);
+int GetFirstConvexHull2ContainingPoints(PackedConvexHulls2 const& hulls, Vec2SoA const& points, std::vector<int>& out_hullIndexes);
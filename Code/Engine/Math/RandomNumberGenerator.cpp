@@ -1,69 +1,402 @@
-#include "RandomNumberGenerator.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Math/FloatRange.hpp"
+#include "Engine/Math/NoiseLanes.hpp"
+#include "Engine/Math/SIMDUtils.hpp"
+#include "ThirdParty/Noise/RawNoise.hpp"
 
-#include <stdlib.h>
+#include <atomic>
+#include <random>
 
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static std::atomic<unsigned int> s_defaultSequenceSeed(0);
+static std::atomic<unsigned int> s_defaultSequencePosition(0);
+static std::atomic<bool> s_isDefaultSequenceSeeded(false);
 
+constexpr float ONE_OVER_2_TO_THE_24 = 1.f / 16777216.f;
+constexpr unsigned int NOISE_RETRY_SEED_STEP = 0x9e3779b9;		// seed offset for each redraw in an integer rejection
 
-int RandomNumberGenerator::RollIntLessThan(int maxIntNotInclusive) const
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// PCG-XSH-RR: advance the 64-bit LCG and output a xorshifted, randomly rotated 32 bits of the old state
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static unsigned int AdvancePCG32(uint64_t& inout_state, uint64_t increment)
 {
+	uint64_t oldState = inout_state;
+	inout_state = oldState * 6364136223846793005ull + increment;
 
-    int randInt = rand() % maxIntNotInclusive;
+	unsigned int xorShifted = static_cast<unsigned int>(((oldState >> 18u) ^ oldState) >> 27u);
+	unsigned int rotation = static_cast<unsigned int>(oldState >> 59u);
 
-    return randInt;
+	return (xorShifted >> rotation) | (xorShifted << ((0u - rotation) & 31u));
+}
 
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Maps 32 random bits onto [0, maxNotInclusive) by taking the high half of bits * maxNotInclusive. The lowest
+// 2^32 % maxNotInclusive products would make some results one draw more likely than others, so those draws are
+// rejected; that happens with probability below maxNotInclusive / 2^32, so nearly every call takes the fast path.
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static bool IsUIntLessThanAccepted(unsigned int bits, unsigned int maxNotInclusive, unsigned int& out_value)
+{
+	uint64_t product = static_cast<uint64_t>(bits) * maxNotInclusive;
+	unsigned int lowBits = static_cast<unsigned int>(product);
+
+	out_value = static_cast<unsigned int>(product >> 32);
+
+	if(lowBits >= maxNotInclusive)
+	{
+		return true;
+	}
+
+	unsigned int threshold = (0u - maxNotInclusive) % maxNotInclusive;
+	return lowBits >= threshold;
 }
 
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static unsigned int GetNoiseUIntLessThan(int position, unsigned int seed, unsigned int maxNotInclusive)
+{
+	unsigned int value = 0;
+	unsigned int bits = Get1dNoiseUint(position, seed);
 
-int RandomNumberGenerator::RollIntInRangeOf(int minIntInclusive, int maxIntInclusive) const
+	while(!IsUIntLessThanAccepted(bits, maxNotInclusive, value))
+	{
+		seed += NOISE_RETRY_SEED_STEP;
+		bits = Get1dNoiseUint(position, seed);
+	}
+
+	return value;
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+struct NoiseUIntWriter
 {
+	unsigned int* m_values;
+
+	template<typename Ops>
+	void Write(int index, typename Ops::Type bits) const
+	{
+		Ops::Store(m_values + index, bits);
+	}
+};
 
-    int randInt = minIntInclusive + (rand() % ((maxIntInclusive - minIntInclusive) + 1));
 
-    return randInt;
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// min + (24 random bits / 2^24) * (max - min); the same operations in the same order as GetFloatInRangeAtPosition
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+struct NoiseFloatWriter
+{
+	float*	m_values;
+	float	m_min;
+	float	m_range;
+
+	template<typename Ops>
+	void Write(int index, typename Ops::Type bits) const
+	{
+		typedef typename Ops::FloatOps FloatOps;
 
+		typename FloatOps::Type zeroToOne = FloatOps::Mul(Ops::ToFloat(Ops::template ShiftRight<8>(bits)), FloatOps::Splat(ONE_OVER_2_TO_THE_24));
+		FloatOps::Store(m_values + index, FloatOps::Add(FloatOps::Splat(m_min), FloatOps::Mul(zeroToOne, FloatOps::Splat(m_range))));
+	}
+};
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+template<typename Writer>
+static void FillNoiseLanes(unsigned int seed, int firstPosition, int count, Writer const& writer)
+{
+	int index = 0;
+	NoiseLaneOps::Type positions = NoiseLaneOps::Sequence(static_cast<unsigned int>(firstPosition));
+	NoiseLaneOps::Type positionStep = NoiseLaneOps::Splat(NoiseLaneOps::WIDTH);
+
+	for(; index + NoiseLaneOps::WIDTH <= count; index += NoiseLaneOps::WIDTH)
+	{
+		writer.template Write<NoiseLaneOps>(index, SquirrelNoise5Lanes<NoiseLaneOps>(positions, seed));
+		positions = NoiseLaneOps::Add(positions, positionStep);
+	}
+
+	for(; index < count; ++index)
+	{
+		writer.template Write<UInt1Ops>(index, Get1dNoiseUint(firstPosition + index, seed));
+	}
 }
 
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Drawn once, the first time a default-constructed generator needs it, so unseeded runs differ from launch to launch
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static unsigned int GetLaunchSeed()
+{
+	static unsigned int const s_launchSeed = std::random_device()();
+	return s_launchSeed;
+}
 
-float RandomNumberGenerator::RollFloatZeroToOne() const
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+RandomNumberGenerator::RandomNumberGenerator()
 {
-    float randFloat = float(rand()) / float(RAND_MAX);
+	unsigned int position = s_defaultSequencePosition.fetch_add(1, std::memory_order_relaxed);
+	unsigned int sequenceSeed = s_isDefaultSequenceSeeded.load(std::memory_order_acquire) ? s_defaultSequenceSeed.load(std::memory_order_relaxed) : GetLaunchSeed();
+	SetSeed(Get1dNoiseUint(static_cast<int>(position), sequenceSeed));
+}
 
-    return randFloat;
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+RandomNumberGenerator::RandomNumberGenerator(unsigned int seed, unsigned int streamIndex)
+{
+	SetSeed(seed, streamIndex);
 }
 
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void RandomNumberGenerator::SeedDefaultSequence(unsigned int seed)
+{
+	s_defaultSequenceSeed.store(seed, std::memory_order_relaxed);
+	s_defaultSequencePosition.store(0, std::memory_order_relaxed);
+	s_isDefaultSequenceSeeded.store(true, std::memory_order_release);
+}
 
-float RandomNumberGenerator::RollFloatInRangeOf(float minFloatInclusive, float maxFloatInclusive) const
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Generators with the same seed but different streams produce unrelated sequences
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void RandomNumberGenerator::SetSeed(unsigned int seed, unsigned int streamIndex)
 {
+	m_seed = seed;
+	m_state = 0;
+	m_increment = (static_cast<uint64_t>(streamIndex) << 1u) | 1u;
 
-    float randFloat = minFloatInclusive + ((float(rand()) / float(RAND_MAX)) * (maxFloatInclusive - minFloatInclusive));
+	AdvancePCG32(m_state, m_increment);
+	m_state += seed;
+	AdvancePCG32(m_state, m_increment);
+}
 
-    return randFloat;
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+unsigned int RandomNumberGenerator::RollUInt() const
+{
+	return AdvancePCG32(m_state, m_increment);
 }
 
-float RandomNumberGenerator::RollFloatInRangeOf(FloatRange range) const
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+unsigned int RandomNumberGenerator::RollUIntLessThan(unsigned int maxNotInclusive) const
+{
+	unsigned int value = 0;
+	bool isAccepted = false;
+
+	while(!isAccepted)
+	{
+		isAccepted = IsUIntLessThanAccepted(RollUInt(), maxNotInclusive, value);
+	}
+
+	return value;
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int RandomNumberGenerator::RollIntLessThan(int maxIntNotInclusive) const
+{
+	if(maxIntNotInclusive <= 1)
+	{
+		return 0;
+	}
+
+	return static_cast<int>(RollUIntLessThan(static_cast<unsigned int>(maxIntNotInclusive)));
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int RandomNumberGenerator::RollIntInRangeOf(int minIntInclusive, int maxIntInclusive) const
+{
+	if(maxIntInclusive <= minIntInclusive)
+	{
+		return minIntInclusive;
+	}
+
+	// Unsigned so ranges wider than INT_MAX still work; a range of every int wraps to 0
+	unsigned int numValues = static_cast<unsigned int>(maxIntInclusive) - static_cast<unsigned int>(minIntInclusive) + 1u;
+	unsigned int offset = (numValues == 0) ? RollUInt() : RollUIntLessThan(numValues);
+
+	return static_cast<int>(static_cast<unsigned int>(minIntInclusive) + offset);
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+float RandomNumberGenerator::RollFloatZeroToOne() const
 {
+	return static_cast<float>(RollUInt() >> 8) * ONE_OVER_2_TO_THE_24;
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+float RandomNumberGenerator::RollFloatInRangeOf(float minFloatInclusive, float maxFloatInclusive) const
+{
+	return minFloatInclusive + RollFloatZeroToOne() * (maxFloatInclusive - minFloatInclusive);
+}
 
-    return RollFloatInRangeOf(range.m_min, range.m_max);
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+float RandomNumberGenerator::RollFloatInRangeOf(FloatRange range) const
+{
+	return RollFloatInRangeOf(range.m_min, range.m_max);
 }
 
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
 float RandomNumberGenerator::RollRandomAngle() const
 {
-    return RollFloatInRangeOf(0.f, 360.f);
+	return RollFloatInRangeOf(0.f, 360.f);
 }
 
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
 float RandomNumberGenerator::RollNewAngleInRange(float minAngle, float maxAngle) const
 {
-    return RollFloatInRangeOf(minAngle, maxAngle);
+	return RollFloatInRangeOf(minAngle, maxAngle);
 }
 
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
 float RandomNumberGenerator::RollNewAngleInRange(FloatRange range) const
 {
-    return RollFloatInRangeOf(range.m_min, range.m_max);
+	return RollFloatInRangeOf(range.m_min, range.m_max);
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void RandomNumberGenerator::FillUInts(int count, unsigned int* out_values) const
+{
+	NoiseRandomNumberGenerator(RollUInt()).FillUInts(0, count, out_values);
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void RandomNumberGenerator::FillIntsLessThan(int count, int maxIntNotInclusive, int* out_values) const
+{
+	NoiseRandomNumberGenerator(RollUInt()).FillIntsLessThan(0, count, maxIntNotInclusive, out_values);
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void RandomNumberGenerator::FillFloatsZeroToOne(int count, float* out_values) const
+{
+	NoiseRandomNumberGenerator(RollUInt()).FillFloatsZeroToOne(0, count, out_values);
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void RandomNumberGenerator::FillFloatsInRange(int count, float minFloatInclusive, float maxFloatInclusive, float* out_values) const
+{
+	NoiseRandomNumberGenerator(RollUInt()).FillFloatsInRange(0, count, minFloatInclusive, maxFloatInclusive, out_values);
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+NoiseRandomNumberGenerator::NoiseRandomNumberGenerator(unsigned int seed)
+	: m_seed(seed)
+{
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+unsigned int NoiseRandomNumberGenerator::GetUIntAtPosition(int position) const
+{
+	return Get1dNoiseUint(position, m_seed);
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int NoiseRandomNumberGenerator::GetIntLessThanAtPosition(int position, int maxIntNotInclusive) const
+{
+	if(maxIntNotInclusive <= 1)
+	{
+		return 0;
+	}
+
+	return static_cast<int>(GetNoiseUIntLessThan(position, m_seed, static_cast<unsigned int>(maxIntNotInclusive)));
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int NoiseRandomNumberGenerator::GetIntInRangeAtPosition(int position, int minIntInclusive, int maxIntInclusive) const
+{
+	if(maxIntInclusive <= minIntInclusive)
+	{
+		return minIntInclusive;
+	}
+
+	unsigned int numValues = static_cast<unsigned int>(maxIntInclusive) - static_cast<unsigned int>(minIntInclusive) + 1u;
+	unsigned int offset = (numValues == 0) ? Get1dNoiseUint(position, m_seed) : GetNoiseUIntLessThan(position, m_seed, numValues);
+
+	return static_cast<int>(static_cast<unsigned int>(minIntInclusive) + offset);
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+float NoiseRandomNumberGenerator::GetFloatZeroToOneAtPosition(int position) const
+{
+	return static_cast<float>(Get1dNoiseUint(position, m_seed) >> 8) * ONE_OVER_2_TO_THE_24;
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+float NoiseRandomNumberGenerator::GetFloatInRangeAtPosition(int position, float minFloatInclusive, float maxFloatInclusive) const
+{
+	return minFloatInclusive + GetFloatZeroToOneAtPosition(position) * (maxFloatInclusive - minFloatInclusive);
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void NoiseRandomNumberGenerator::FillUInts(int firstPosition, int count, unsigned int* out_values) const
+{
+	FillNoiseLanes(m_seed, firstPosition, count, NoiseUIntWriter{ out_values });
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Hashes a whole batch of raw bits with the SIMD kernel, then maps each onto the range; the rare rejected draw is
+// redrawn exactly as GetIntLessThanAtPosition would
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void NoiseRandomNumberGenerator::FillIntsLessThan(int firstPosition, int count, int maxIntNotInclusive, int* out_values) const
+{
+	if(maxIntNotInclusive <= 1)
+	{
+		for(int index = 0; index < count; ++index)
+		{
+			out_values[index] = 0;
+		}
+		return;
+	}
+
+	unsigned int* bits = reinterpret_cast<unsigned int*>(out_values);
+	unsigned int maxNotInclusive = static_cast<unsigned int>(maxIntNotInclusive);
+
+	FillNoiseLanes(m_seed, firstPosition, count, NoiseUIntWriter{ bits });
+
+	for(int index = 0; index < count; ++index)
+	{
+		unsigned int value = 0;
+		if(!IsUIntLessThanAccepted(bits[index], maxNotInclusive, value))
+		{
+			value = GetNoiseUIntLessThan(firstPosition + index, m_seed, maxNotInclusive);
+		}
+		out_values[index] = static_cast<int>(value);
+	}
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void NoiseRandomNumberGenerator::FillFloatsZeroToOne(int firstPosition, int count, float* out_values) const
+{
+	FillNoiseLanes(m_seed, firstPosition, count, NoiseFloatWriter{ out_values, 0.f, 1.f });
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void NoiseRandomNumberGenerator::FillFloatsInRange(int firstPosition, int count, float minFloatInclusive, float maxFloatInclusive, float* out_values) const
+{
+	FillNoiseLanes(m_seed, firstPosition, count, NoiseFloatWriter{ out_values, minFloatInclusive, maxFloatInclusive - minFloatInclusive });
 }
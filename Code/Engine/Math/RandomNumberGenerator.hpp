@@ -1,13 +1,43 @@
 #pragma once
+#include <stdint.h>
 
 struct FloatRange;
 
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Seedable random numbers without the C runtime's hidden global state. Each instance runs its own PCG32 generator
+// (64-bit state, 32-bit output), so systems and jobs that each own one get reproducible sequences and never contend
+// with each other. One instance must not be rolled from two threads at once; give every job its own.
+//
+// The Roll functions stay const so existing callers keep compiling; the generator state is mutable.
+// Integer rolls are unbiased: RollIntLessThan rejects the few values that a plain modulo would fold onto small
+// results. RollFloatZeroToOne returns 24 random bits scaled into [0, 1), so it never returns exactly 1. That makes
+// RollFloatInRangeOf, the angle rolls and the float Fill functions [min, max) as well, despite the "Inclusive" in their
+// parameter names; they used to be [min, max]. Only float rounding in min + roll * (max - min) can still give max.
+//
+// A default-constructed generator takes the next seed from a process-wide sequence, so temporaries such as the one
+// in FloatRange::GetRandomFloat still differ from call to call. The sequence is seeded from std::random_device the
+// first time it is used, so it differs on every launch. SeedDefaultSequence replaces the old srand(): call it at
+// startup with a fixed seed to replay the same default sequence, or with time() as before.
+//
+// The Fill functions roll one value as a key and fill the array from NoiseRandomNumberGenerator with it, 8 or 4
+// values at a time. The results are the same on every instruction set, and a fill advances the generator by one roll.
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
 class RandomNumberGenerator
 {
 
 public:
 
+	RandomNumberGenerator();
+	explicit RandomNumberGenerator(unsigned int seed, unsigned int streamIndex = 0);
+
+	static void SeedDefaultSequence(unsigned int seed);
+
+	void			SetSeed(unsigned int seed, unsigned int streamIndex = 0);
+	unsigned int	GetSeed() const { return m_seed; }
+
+	unsigned int	RollUInt() const;
+
 	int RollIntLessThan(int maxIntNotInclusive) const;
 	int RollIntInRangeOf(int minIntInclusive, int maxIntInclusive) const;
 
@@ -19,4 +49,51 @@ public:
 	float RollNewAngleInRange(float minAngle, float maxAngle) const;
 	float RollNewAngleInRange(FloatRange range) const;
 
-};
\ No newline at end of file
+	void FillUInts(int count, unsigned int* out_values) const;
+	void FillIntsLessThan(int count, int maxIntNotInclusive, int* out_values) const;
+	void FillFloatsZeroToOne(int count, float* out_values) const;
+	void FillFloatsInRange(int count, float minFloatInclusive, float maxFloatInclusive, float* out_values) const;
+
+private:
+
+	unsigned int	RollUIntLessThan(unsigned int maxNotInclusive) const;
+
+private:
+
+	mutable uint64_t	m_state = 0;
+	uint64_t			m_increment = 1;
+	unsigned int		m_seed = 0;
+
+};
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Stateless random numbers: every value is a hash (SquirrelNoise5) of the seed and a position, like a lookup into an
+// endless table of pre-rolled numbers. Jobs can generate any slice of a sequence in any order on any thread and get
+// exactly the values a single loop would, which makes this the one to use for procedural generation.
+//
+// A position gives the same value from the Get and Fill functions of the same kind, on every instruction set.
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+class NoiseRandomNumberGenerator
+{
+
+public:
+
+	explicit NoiseRandomNumberGenerator(unsigned int seed = 0);
+
+	unsigned int	GetUIntAtPosition(int position) const;
+	int				GetIntLessThanAtPosition(int position, int maxIntNotInclusive) const;
+	int				GetIntInRangeAtPosition(int position, int minIntInclusive, int maxIntInclusive) const;
+	float			GetFloatZeroToOneAtPosition(int position) const;
+	float			GetFloatInRangeAtPosition(int position, float minFloatInclusive, float maxFloatInclusive) const;
+
+	void FillUInts(int firstPosition, int count, unsigned int* out_values) const;
+	void FillIntsLessThan(int firstPosition, int count, int maxIntNotInclusive, int* out_values) const;
+	void FillFloatsZeroToOne(int firstPosition, int count, float* out_values) const;
+	void FillFloatsInRange(int firstPosition, int count, float minFloatInclusive, float maxFloatInclusive, float* out_values) const;
+
+public:
+
+	unsigned int m_seed = 0;
+
+};
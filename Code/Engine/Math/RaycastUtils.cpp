@@ -3,6 +3,8 @@
 #include "Engine/Math/FloatRange.hpp"
 #include "Engine/Math/LineSegment2.hpp"
 #include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/OBB2.hpp"
+#include "Engine/Math/Capsule2.hpp"
 #include "Engine/Math/Plane2.hpp"
 #include "Engine/Math/ConvexHull2.hpp"
 #include "Engine/Math/AABB3.hpp"
@@ -11,8 +13,12 @@
 #include "Engine/Math/Sphere.hpp"
 #include "Engine/Math/Cylinder3D.hpp"
 #include "Engine/Math/Plane3.hpp"
+#include "Engine/Math/SIMDUtils.hpp"
+#include "Engine/Math/Vec3xN.hpp"
 
 #include <math.h>
+#include <float.h>
+#include <utility>
 #include <vector>
 
 
@@ -775,3 +781,1280 @@ RaycastResult3D::RaycastResult3D(bool impactResult, float impactDistance, Vec3 c
 	, m_rayMaxLength(rayLength)
 	, m_impactPos(impactPos)
 {}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Batched raycasts
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+#if defined(ENGINE_SIMD_AVX2)
+typedef Float8Ops RaycastOps;
+#else
+typedef Float4Ops RaycastOps;
+#endif
+
+typedef RaycastOps::Type			RaycastLane;
+typedef Vec3xN<RaycastOps>			RaycastVec3Lanes;
+
+constexpr int RAYCAST_LANES = RaycastOps::WIDTH;
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Loads lanes [first, first + numLanes) of up to seven parallel arrays, zero-padding a partial group.
+static void LoadRaycastLanes(int first, int numLanes, int numArrays, float const* const* arrays, RaycastLane* out_lanes)
+{
+	for(int arrayIndex = 0; arrayIndex < numArrays; ++arrayIndex)
+	{
+		if(numLanes == RAYCAST_LANES)
+		{
+			out_lanes[arrayIndex] = RaycastOps::Load(arrays[arrayIndex] + first);
+			continue;
+		}
+
+		float padded[RAYCAST_LANES] = {};
+		for(int lane = 0; lane < numLanes; ++lane)
+		{
+			padded[lane] = arrays[arrayIndex][first + lane];
+		}
+		out_lanes[arrayIndex] = RaycastOps::Load(padded);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static void StoreRaycastLanes(float* out_values, int first, int numLanes, RaycastLane values)
+{
+	if(out_values == nullptr)
+	{
+		return;
+	}
+
+	if(numLanes == RAYCAST_LANES)
+	{
+		RaycastOps::Store(out_values + first, values);
+		return;
+	}
+
+	float lanes[RAYCAST_LANES];
+	RaycastOps::Store(lanes, values);
+	for(int lane = 0; lane < numLanes; ++lane)
+	{
+		out_values[first + lane] = lanes[lane];
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static void LoadRayLanes(RayPacket3D const& rays, int first, int numLanes, RaycastVec3Lanes& out_start, RaycastVec3Lanes& out_fwd, RaycastLane& out_maxDist)
+{
+	float const* arrays[7] = { rays.m_startX, rays.m_startY, rays.m_startZ, rays.m_fwdX, rays.m_fwdY, rays.m_fwdZ, rays.m_maxLength };
+	RaycastLane lanes[7];
+	LoadRaycastLanes(first, numLanes, 7, arrays, lanes);
+
+	out_start = RaycastVec3Lanes(lanes[0], lanes[1], lanes[2]);
+	out_fwd = RaycastVec3Lanes(lanes[3], lanes[4], lanes[5]);
+	out_maxDist = lanes[6];
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Writes one group of results, substituting the documented miss values. Returns the number of hits in the group.
+static int StoreRaycastResults(RaycastPacketResults3D const& out_results, int first, int numLanes, RaycastLane hitMask, RaycastLane impactDistance,
+							   RaycastVec3Lanes const& impactPos, RaycastVec3Lanes const& impactNormal, RaycastVec3Lanes const& start, RaycastVec3Lanes const& fwd)
+{
+	int hitBits = RaycastOps::GetMaskBits(hitMask) & ((1 << numLanes) - 1);
+
+	for(int lane = 0; lane < numLanes; ++lane)
+	{
+		out_results.m_didImpact[first + lane] = (hitBits & (1 << lane)) != 0;
+	}
+
+	StoreRaycastLanes(out_results.m_impactDistance, first, numLanes, RaycastOps::Select(hitMask, impactDistance, RaycastOps::Splat(FLT_MAX)));
+
+	RaycastVec3Lanes pos = RaycastVec3Lanes::Select(hitMask, impactPos, start);
+	StoreRaycastLanes(out_results.m_impactPosX, first, numLanes, pos.m_x);
+	StoreRaycastLanes(out_results.m_impactPosY, first, numLanes, pos.m_y);
+	StoreRaycastLanes(out_results.m_impactPosZ, first, numLanes, pos.m_z);
+
+	RaycastVec3Lanes normal = RaycastVec3Lanes::Select(hitMask, impactNormal, fwd);
+	StoreRaycastLanes(out_results.m_impactNormalX, first, numLanes, normal.m_x);
+	StoreRaycastLanes(out_results.m_impactNormalY, first, numLanes, normal.m_y);
+	StoreRaycastLanes(out_results.m_impactNormalZ, first, numLanes, normal.m_z);
+
+	int numHits = 0;
+	for(; hitBits != 0; hitBits &= hitBits - 1)
+	{
+		++numHits;
+	}
+	return numHits;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Same rules as RaycastVsAABB3D: a start inside the box hits at distance 0 with the ray direction as normal, otherwise
+// the normal faces back along the axis whose slab was entered last.
+static RaycastLane RaycastLanesVsAABB3D(RaycastVec3Lanes const& start, RaycastVec3Lanes const& fwd, RaycastLane maxDist, RaycastVec3Lanes const& mins,
+										RaycastVec3Lanes const& maxs, RaycastLane& out_impactDistance, RaycastLane& out_isInside)
+{
+	RaycastLane zero = RaycastOps::Zero();
+	RaycastLane one = RaycastOps::Splat(1.f);
+
+	RaycastLane isInside = RaycastOps::And(RaycastOps::And(RaycastOps::CmpGt(start.m_x, mins.m_x), RaycastOps::CmpGt(start.m_y, mins.m_y)), RaycastOps::CmpGt(start.m_z, mins.m_z));
+	isInside = RaycastOps::And(isInside, RaycastOps::And(RaycastOps::And(RaycastOps::CmpLt(start.m_x, maxs.m_x), RaycastOps::CmpLt(start.m_y, maxs.m_y)), RaycastOps::CmpLt(start.m_z, maxs.m_z)));
+
+	RaycastVec3Lanes invFwd(RaycastOps::Div(one, fwd.m_x), RaycastOps::Div(one, fwd.m_y), RaycastOps::Div(one, fwd.m_z));
+	RaycastVec3Lanes toMins = (mins - start) * invFwd;
+	RaycastVec3Lanes toMaxs = (maxs - start) * invFwd;
+	RaycastVec3Lanes entries = RaycastVec3Lanes::Min(toMins, toMaxs);
+	RaycastVec3Lanes exits = RaycastVec3Lanes::Max(toMins, toMaxs);
+
+	RaycastLane entry = RaycastOps::Max(entries.m_x, RaycastOps::Max(entries.m_y, entries.m_z));
+	RaycastLane exit = RaycastOps::Min(exits.m_x, RaycastOps::Min(exits.m_y, exits.m_z));
+
+	RaycastLane didHit = RaycastOps::And(RaycastOps::CmpLe(entry, exit), RaycastOps::And(RaycastOps::CmpLe(entry, maxDist), RaycastOps::CmpGe(exit, zero)));
+
+	out_impactDistance = RaycastOps::Select(isInside, zero, entry);
+	out_isInside = isInside;
+	return RaycastOps::Or(isInside, didHit);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static RaycastVec3Lanes GetAABB3DImpactNormalLanes(RaycastVec3Lanes const& start, RaycastVec3Lanes const& fwd, RaycastVec3Lanes const& mins, RaycastVec3Lanes const& maxs,
+													 RaycastLane isInside)
+{
+	RaycastLane zero = RaycastOps::Zero();
+	RaycastLane one = RaycastOps::Splat(1.f);
+	RaycastLane minusOne = RaycastOps::Splat(-1.f);
+
+	RaycastVec3Lanes invFwd(RaycastOps::Div(one, fwd.m_x), RaycastOps::Div(one, fwd.m_y), RaycastOps::Div(one, fwd.m_z));
+	RaycastVec3Lanes entries = RaycastVec3Lanes::Min((mins - start) * invFwd, (maxs - start) * invFwd);
+
+	RaycastLane isXFace = RaycastOps::And(RaycastOps::CmpGt(entries.m_x, entries.m_y), RaycastOps::CmpGt(entries.m_x, entries.m_z));
+	RaycastLane isYFace = RaycastOps::AndNot(RaycastOps::CmpGt(entries.m_y, entries.m_z), isXFace);
+	RaycastLane isZFace = RaycastOps::AndNot(RaycastOps::AndNot(RaycastOps::CmpEq(zero, zero), isXFace), isYFace);
+
+	RaycastVec3Lanes normal(RaycastOps::And(isXFace, RaycastOps::Select(RaycastOps::CmpLt(fwd.m_x, zero), one, minusOne)),
+							RaycastOps::And(isYFace, RaycastOps::Select(RaycastOps::CmpLt(fwd.m_y, zero), one, minusOne)),
+							RaycastOps::And(isZFace, RaycastOps::Select(RaycastOps::CmpLt(fwd.m_z, zero), one, minusOne)));
+
+	// lanes that started inside report the ray direction
+	return RaycastVec3Lanes::Select(isInside, fwd, normal);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Same rules as RaycastVsSphere3D.
+static RaycastLane RaycastLanesVsSphere3D(RaycastVec3Lanes const& start, RaycastVec3Lanes const& fwd, RaycastLane maxDist, RaycastVec3Lanes const& center,
+										  RaycastLane radius, RaycastLane& out_impactDistance, RaycastLane& out_isInside)
+{
+	RaycastLane zero = RaycastOps::Zero();
+
+	RaycastVec3Lanes startToCenter = center - start;
+	RaycastLane distanceSquared = startToCenter.GetLengthSquared();
+	RaycastLane radiusSquared = RaycastOps::Mul(radius, radius);
+	RaycastLane isInside = RaycastOps::CmpLe(distanceSquared, radiusSquared);
+
+	RaycastLane alongRay = DotProduct3D(startToCenter, fwd);
+	RaycastLane altitudeSquared = RaycastOps::Sub(distanceSquared, RaycastOps::Mul(alongRay, alongRay));
+	RaycastLane adjust = RaycastOps::Sqrt(RaycastOps::Max(RaycastOps::Sub(radiusSquared, altitudeSquared), zero));
+	RaycastLane impactDistance = RaycastOps::Sub(alongRay, adjust);
+
+	RaycastLane didHit = RaycastOps::And(RaycastOps::CmpLt(altitudeSquared, radiusSquared), RaycastOps::And(RaycastOps::CmpGe(impactDistance, zero), RaycastOps::CmpLe(impactDistance, maxDist)));
+
+	out_impactDistance = RaycastOps::Select(isInside, zero, impactDistance);
+	out_isInside = isInside;
+	return RaycastOps::Or(isInside, didHit);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static RaycastVec3Lanes GetSphere3DImpactNormalLanes(RaycastVec3Lanes const& start, RaycastVec3Lanes const& fwd, RaycastVec3Lanes const& center, RaycastLane impactDistance,
+													   RaycastLane isInside)
+{
+	RaycastVec3Lanes impactPos = RaycastVec3Lanes::MulAdd(fwd, impactDistance, start);
+	RaycastVec3Lanes normal = (impactPos - center).GetNormalized();
+
+	return RaycastVec3Lanes::Select(isInside, fwd, normal);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int RaycastPacketVsAABB3D(RayPacket3D const& rays, AABB3 const& box, RaycastPacketResults3D const& out_results)
+{
+	RaycastVec3Lanes mins(box.m_mins);
+	RaycastVec3Lanes maxs(box.m_maxs);
+	int numHits = 0;
+
+	for(int first = 0; first < rays.m_numRays; first += RAYCAST_LANES)
+	{
+		int numLanes = GetMin(RAYCAST_LANES, rays.m_numRays - first);
+
+		RaycastVec3Lanes start;
+		RaycastVec3Lanes fwd;
+		RaycastLane maxDist;
+		LoadRayLanes(rays, first, numLanes, start, fwd, maxDist);
+
+		RaycastLane impactDistance;
+		RaycastLane isInside;
+		RaycastLane hitMask = RaycastLanesVsAABB3D(start, fwd, maxDist, mins, maxs, impactDistance, isInside);
+
+		if(!RaycastVec3Lanes::IsAnyLaneSet(hitMask))
+		{
+			StoreRaycastResults(out_results, first, numLanes, hitMask, impactDistance, start, fwd, start, fwd);
+			continue;
+		}
+
+		RaycastVec3Lanes impactPos = RaycastVec3Lanes::MulAdd(fwd, impactDistance, start);
+		RaycastVec3Lanes impactNormal = GetAABB3DImpactNormalLanes(start, fwd, mins, maxs, isInside);
+		numHits += StoreRaycastResults(out_results, first, numLanes, hitMask, impactDistance, impactPos, impactNormal, start, fwd);
+	}
+
+	return numHits;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int RaycastPacketVsSphere3D(RayPacket3D const& rays, Sphere const& sphere, RaycastPacketResults3D const& out_results)
+{
+	RaycastVec3Lanes center(sphere.m_center);
+	RaycastLane radius = RaycastOps::Splat(sphere.m_radius);
+	int numHits = 0;
+
+	for(int first = 0; first < rays.m_numRays; first += RAYCAST_LANES)
+	{
+		int numLanes = GetMin(RAYCAST_LANES, rays.m_numRays - first);
+
+		RaycastVec3Lanes start;
+		RaycastVec3Lanes fwd;
+		RaycastLane maxDist;
+		LoadRayLanes(rays, first, numLanes, start, fwd, maxDist);
+
+		RaycastLane impactDistance;
+		RaycastLane isInside;
+		RaycastLane hitMask = RaycastLanesVsSphere3D(start, fwd, maxDist, center, radius, impactDistance, isInside);
+
+		if(!RaycastVec3Lanes::IsAnyLaneSet(hitMask))
+		{
+			StoreRaycastResults(out_results, first, numLanes, hitMask, impactDistance, start, fwd, start, fwd);
+			continue;
+		}
+
+		RaycastVec3Lanes impactPos = RaycastVec3Lanes::MulAdd(fwd, impactDistance, start);
+		RaycastVec3Lanes impactNormal = GetSphere3DImpactNormalLanes(start, fwd, center, impactDistance, isInside);
+		numHits += StoreRaycastResults(out_results, first, numLanes, hitMask, impactDistance, impactPos, impactNormal, start, fwd);
+	}
+
+	return numHits;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Rays are moved into the box's local frame, slab-tested against its half extents, and only the normal is rotated back;
+// the impact position is rebuilt from the world-space ray.
+int RaycastPacketVsOBB3D(RayPacket3D const& rays, OBB3 const& obb, RaycastPacketResults3D const& out_results)
+{
+	RaycastVec3Lanes center(obb.m_center);
+	RaycastVec3Lanes iBasis(obb.m_iBasis);
+	RaycastVec3Lanes jBasis(obb.m_jBasis);
+	RaycastVec3Lanes kBasis(obb.m_kBasis);
+	RaycastVec3Lanes maxs(obb.m_halfDimensions);
+	RaycastVec3Lanes mins(-obb.m_halfDimensions);
+	int numHits = 0;
+
+	for(int first = 0; first < rays.m_numRays; first += RAYCAST_LANES)
+	{
+		int numLanes = GetMin(RAYCAST_LANES, rays.m_numRays - first);
+
+		RaycastVec3Lanes start;
+		RaycastVec3Lanes fwd;
+		RaycastLane maxDist;
+		LoadRayLanes(rays, first, numLanes, start, fwd, maxDist);
+
+		RaycastVec3Lanes centerToStart = start - center;
+		RaycastVec3Lanes localStart(DotProduct3D(centerToStart, iBasis), DotProduct3D(centerToStart, jBasis), DotProduct3D(centerToStart, kBasis));
+		RaycastVec3Lanes localFwd(DotProduct3D(fwd, iBasis), DotProduct3D(fwd, jBasis), DotProduct3D(fwd, kBasis));
+
+		RaycastLane impactDistance;
+		RaycastLane isInside;
+		RaycastLane hitMask = RaycastLanesVsAABB3D(localStart, localFwd, maxDist, mins, maxs, impactDistance, isInside);
+
+		if(!RaycastVec3Lanes::IsAnyLaneSet(hitMask))
+		{
+			StoreRaycastResults(out_results, first, numLanes, hitMask, impactDistance, start, fwd, start, fwd);
+			continue;
+		}
+
+		RaycastVec3Lanes localNormal = GetAABB3DImpactNormalLanes(localStart, localFwd, mins, maxs, isInside);
+		RaycastVec3Lanes impactNormal = RaycastVec3Lanes::MulAdd(iBasis, localNormal.m_x, RaycastVec3Lanes::MulAdd(jBasis, localNormal.m_y, kBasis * localNormal.m_z));
+		RaycastVec3Lanes impactPos = RaycastVec3Lanes::MulAdd(fwd, impactDistance, start);
+		numHits += StoreRaycastResults(out_results, first, numLanes, hitMask, impactDistance, impactPos, impactNormal, start, fwd);
+	}
+
+	return numHits;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static void LoadAABB3Lanes(AABB3SoA const& boxes, int first, int numLanes, RaycastVec3Lanes& out_mins, RaycastVec3Lanes& out_maxs)
+{
+	float const* arrays[6] = { boxes.m_minX, boxes.m_minY, boxes.m_minZ, boxes.m_maxX, boxes.m_maxY, boxes.m_maxZ };
+	RaycastLane lanes[6];
+	LoadRaycastLanes(first, numLanes, 6, arrays, lanes);
+
+	out_mins = RaycastVec3Lanes(lanes[0], lanes[1], lanes[2]);
+	out_maxs = RaycastVec3Lanes(lanes[3], lanes[4], lanes[5]);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static void LoadSphereLanes(SphereSoA const& spheres, int first, int numLanes, RaycastVec3Lanes& out_center, RaycastLane& out_radius)
+{
+	float const* arrays[4] = { spheres.m_centerX, spheres.m_centerY, spheres.m_centerZ, spheres.m_radius };
+	RaycastLane lanes[4];
+	LoadRaycastLanes(first, numLanes, 4, arrays, lanes);
+
+	out_center = RaycastVec3Lanes(lanes[0], lanes[1], lanes[2]);
+	out_radius = lanes[3];
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Padding lanes in a partial group never count as hits.
+static RaycastLane GetValidLanesMask(int numLanes)
+{
+	float laneIndexes[RAYCAST_LANES];
+	for(int lane = 0; lane < RAYCAST_LANES; ++lane)
+	{
+		laneIndexes[lane] = static_cast<float>(lane);
+	}
+
+	return RaycastOps::CmpLt(RaycastOps::Load(laneIndexes), RaycastOps::Splat(static_cast<float>(numLanes)));
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int RaycastVsAABB3Ds(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, AABB3SoA const& boxes, RaycastPacketResults3D const& out_results)
+{
+	RaycastVec3Lanes start(startPos);
+	RaycastVec3Lanes fwd(fwdNormal);
+	RaycastLane maxDistLanes = RaycastOps::Splat(maxDist);
+	int numHits = 0;
+
+	for(int first = 0; first < boxes.m_count; first += RAYCAST_LANES)
+	{
+		int numLanes = GetMin(RAYCAST_LANES, boxes.m_count - first);
+
+		RaycastVec3Lanes mins;
+		RaycastVec3Lanes maxs;
+		LoadAABB3Lanes(boxes, first, numLanes, mins, maxs);
+
+		RaycastLane impactDistance;
+		RaycastLane isInside;
+		RaycastLane hitMask = RaycastLanesVsAABB3D(start, fwd, maxDistLanes, mins, maxs, impactDistance, isInside);
+
+		if(!RaycastVec3Lanes::IsAnyLaneSet(hitMask))
+		{
+			StoreRaycastResults(out_results, first, numLanes, hitMask, impactDistance, start, fwd, start, fwd);
+			continue;
+		}
+
+		RaycastVec3Lanes impactPos = RaycastVec3Lanes::MulAdd(fwd, impactDistance, start);
+		RaycastVec3Lanes impactNormal = GetAABB3DImpactNormalLanes(start, fwd, mins, maxs, isInside);
+		numHits += StoreRaycastResults(out_results, first, numLanes, hitMask, impactDistance, impactPos, impactNormal, start, fwd);
+	}
+
+	return numHits;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool RaycastVsAABB3DsAny(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, AABB3SoA const& boxes)
+{
+	RaycastVec3Lanes start(startPos);
+	RaycastVec3Lanes fwd(fwdNormal);
+	RaycastLane maxDistLanes = RaycastOps::Splat(maxDist);
+
+	for(int first = 0; first < boxes.m_count; first += RAYCAST_LANES)
+	{
+		int numLanes = GetMin(RAYCAST_LANES, boxes.m_count - first);
+
+		RaycastVec3Lanes mins;
+		RaycastVec3Lanes maxs;
+		LoadAABB3Lanes(boxes, first, numLanes, mins, maxs);
+
+		RaycastLane impactDistance;
+		RaycastLane isInside;
+		RaycastLane hitMask = RaycastLanesVsAABB3D(start, fwd, maxDistLanes, mins, maxs, impactDistance, isInside);
+
+		if(RaycastVec3Lanes::IsAnyLaneSet(RaycastOps::And(hitMask, GetValidLanesMask(numLanes))))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Returns the lane with the smallest distance among the set bits, ties going to the lower lane.
+static int GetClosestHitLane(int hitBits, RaycastLane impactDistance, float& out_distance)
+{
+	float distances[RAYCAST_LANES];
+	RaycastOps::Store(distances, impactDistance);
+
+	int closestLane = -1;
+	for(int lane = 0; lane < RAYCAST_LANES; ++lane)
+	{
+		if((hitBits & (1 << lane)) && (closestLane < 0 || distances[lane] < out_distance))
+		{
+			closestLane = lane;
+			out_distance = distances[lane];
+		}
+	}
+
+	return closestLane;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int RaycastVsAABB3DsClosest(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, AABB3SoA const& boxes, RaycastResult3D& out_result)
+{
+	RaycastVec3Lanes start(startPos);
+	RaycastVec3Lanes fwd(fwdNormal);
+	float closestDistance = maxDist;
+	int closestIndex = -1;
+
+	for(int first = 0; first < boxes.m_count; first += RAYCAST_LANES)
+	{
+		int numLanes = GetMin(RAYCAST_LANES, boxes.m_count - first);
+
+		RaycastVec3Lanes mins;
+		RaycastVec3Lanes maxs;
+		LoadAABB3Lanes(boxes, first, numLanes, mins, maxs);
+
+		// the ray shrinks to the closest hit so far, so anything farther drops out of the mask
+		RaycastLane impactDistance;
+		RaycastLane isInside;
+		RaycastLane hitMask = RaycastLanesVsAABB3D(start, fwd, RaycastOps::Splat(closestDistance), mins, maxs, impactDistance, isInside);
+		int hitBits = RaycastOps::GetMaskBits(RaycastOps::And(hitMask, GetValidLanesMask(numLanes)));
+
+		if(hitBits == 0)
+		{
+			continue;
+		}
+
+		float groupDistance = closestDistance;
+		int lane = GetClosestHitLane(hitBits, impactDistance, groupDistance);
+		if(closestIndex < 0 || groupDistance < closestDistance)
+		{
+			closestDistance = groupDistance;
+			closestIndex = first + lane;
+		}
+	}
+
+	if(closestIndex < 0)
+	{
+		out_result = RaycastResult3D(false, startPos, fwdNormal, maxDist);
+		return -1;
+	}
+
+	AABB3 closestBox(boxes.m_minX[closestIndex], boxes.m_minY[closestIndex], boxes.m_minZ[closestIndex], boxes.m_maxX[closestIndex], boxes.m_maxY[closestIndex], boxes.m_maxZ[closestIndex]);
+	out_result = RaycastVsAABB3D(startPos, fwdNormal, maxDist, closestBox);
+	return closestIndex;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int RaycastVsSphere3Ds(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, SphereSoA const& spheres, RaycastPacketResults3D const& out_results)
+{
+	RaycastVec3Lanes start(startPos);
+	RaycastVec3Lanes fwd(fwdNormal);
+	RaycastLane maxDistLanes = RaycastOps::Splat(maxDist);
+	int numHits = 0;
+
+	for(int first = 0; first < spheres.m_count; first += RAYCAST_LANES)
+	{
+		int numLanes = GetMin(RAYCAST_LANES, spheres.m_count - first);
+
+		RaycastVec3Lanes center;
+		RaycastLane radius;
+		LoadSphereLanes(spheres, first, numLanes, center, radius);
+
+		RaycastLane impactDistance;
+		RaycastLane isInside;
+		RaycastLane hitMask = RaycastLanesVsSphere3D(start, fwd, maxDistLanes, center, radius, impactDistance, isInside);
+
+		if(!RaycastVec3Lanes::IsAnyLaneSet(hitMask))
+		{
+			StoreRaycastResults(out_results, first, numLanes, hitMask, impactDistance, start, fwd, start, fwd);
+			continue;
+		}
+
+		RaycastVec3Lanes impactPos = RaycastVec3Lanes::MulAdd(fwd, impactDistance, start);
+		RaycastVec3Lanes impactNormal = GetSphere3DImpactNormalLanes(start, fwd, center, impactDistance, isInside);
+		numHits += StoreRaycastResults(out_results, first, numLanes, hitMask, impactDistance, impactPos, impactNormal, start, fwd);
+	}
+
+	return numHits;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool RaycastVsSphere3DsAny(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, SphereSoA const& spheres)
+{
+	RaycastVec3Lanes start(startPos);
+	RaycastVec3Lanes fwd(fwdNormal);
+	RaycastLane maxDistLanes = RaycastOps::Splat(maxDist);
+
+	for(int first = 0; first < spheres.m_count; first += RAYCAST_LANES)
+	{
+		int numLanes = GetMin(RAYCAST_LANES, spheres.m_count - first);
+
+		RaycastVec3Lanes center;
+		RaycastLane radius;
+		LoadSphereLanes(spheres, first, numLanes, center, radius);
+
+		RaycastLane impactDistance;
+		RaycastLane isInside;
+		RaycastLane hitMask = RaycastLanesVsSphere3D(start, fwd, maxDistLanes, center, radius, impactDistance, isInside);
+
+		if(RaycastVec3Lanes::IsAnyLaneSet(RaycastOps::And(hitMask, GetValidLanesMask(numLanes))))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int RaycastVsSphere3DsClosest(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, SphereSoA const& spheres, RaycastResult3D& out_result)
+{
+	RaycastVec3Lanes start(startPos);
+	RaycastVec3Lanes fwd(fwdNormal);
+	float closestDistance = maxDist;
+	int closestIndex = -1;
+
+	for(int first = 0; first < spheres.m_count; first += RAYCAST_LANES)
+	{
+		int numLanes = GetMin(RAYCAST_LANES, spheres.m_count - first);
+
+		RaycastVec3Lanes center;
+		RaycastLane radius;
+		LoadSphereLanes(spheres, first, numLanes, center, radius);
+
+		RaycastLane impactDistance;
+		RaycastLane isInside;
+		RaycastLane hitMask = RaycastLanesVsSphere3D(start, fwd, RaycastOps::Splat(closestDistance), center, radius, impactDistance, isInside);
+		int hitBits = RaycastOps::GetMaskBits(RaycastOps::And(hitMask, GetValidLanesMask(numLanes)));
+
+		if(hitBits == 0)
+		{
+			continue;
+		}
+
+		float groupDistance = closestDistance;
+		int lane = GetClosestHitLane(hitBits, impactDistance, groupDistance);
+		if(closestIndex < 0 || groupDistance < closestDistance)
+		{
+			closestDistance = groupDistance;
+			closestIndex = first + lane;
+		}
+	}
+
+	if(closestIndex < 0)
+	{
+		out_result = RaycastResult3D(false, startPos, fwdNormal, maxDist);
+		return -1;
+	}
+
+	Sphere closestSphere(Vec3(spheres.m_centerX[closestIndex], spheres.m_centerY[closestIndex], spheres.m_centerZ[closestIndex]), spheres.m_radius[closestIndex]);
+	out_result = RaycastVsSphere3D(startPos, fwdNormal, maxDist, closestSphere);
+	return closestIndex;
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Swept shape casts
+//
+// Each sweep is a ray from the moving shape's center against the fixed shape grown by the moving radius. Where that
+// grown shape has rounded parts (box corners and edges, triangle edges) the ray is tested against the discs, spheres or
+// capsules that make them up. Once the impact distance is known, the normal and touching point come from the nearest
+// point on the fixed shape's core (its center, bone, or the shape itself for boxes and triangles).
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+constexpr float SWEEP_DEGENERATE_EPSILON = 1e-12f;
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Narrows [inout_entry, inout_exit] to the distances along the ray where it is between slabMin and slabMax.
+static bool ClipRayToSlab(float start, float fwd, float slabMin, float slabMax, float& inout_entry, float& inout_exit)
+{
+	if(fwd == 0.f)
+	{
+		return start >= slabMin && start <= slabMax;
+	}
+
+	float stepForward = 1.f / fwd;
+	float entry = (slabMin - start) * stepForward;
+	float exit = (slabMax - start) * stepForward;
+	if(entry > exit)
+	{
+		std::swap(entry, exit);
+	}
+
+	inout_entry = GetMax(inout_entry, entry);
+	inout_exit = GetMin(inout_exit, exit);
+	return inout_entry <= inout_exit;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Distance along the ray to where it enters the disc, 0 if it starts inside.
+static bool GetRayEntryIntoDisc2D(Vec2 const& startPos, Vec2 const& fwdNormal, float maxDist, Vec2 const& center, float radius, float& out_distance)
+{
+	Vec2 centerToStart = startPos - center;
+	float alongRay = DotProduct2D(centerToStart, fwdNormal);
+	float startDistanceSquaredBeyondRadius = DotProduct2D(centerToStart, centerToStart) - (radius * radius);
+	if(startDistanceSquaredBeyondRadius > 0.f && alongRay > 0.f)
+	{
+		return false;
+	}
+
+	float discriminant = (alongRay * alongRay) - startDistanceSquaredBeyondRadius;
+	if(discriminant < 0.f)
+	{
+		return false;
+	}
+
+	out_distance = GetMax(-alongRay - sqrtf(discriminant), 0.f);
+	return out_distance <= maxDist;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static bool GetRayEntryIntoSphere3D(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, Vec3 const& center, float radius, float& out_distance)
+{
+	Vec3 centerToStart = startPos - center;
+	float alongRay = DotProduct3D(centerToStart, fwdNormal);
+	float startDistanceSquaredBeyondRadius = DotProduct3D(centerToStart, centerToStart) - (radius * radius);
+	if(startDistanceSquaredBeyondRadius > 0.f && alongRay > 0.f)
+	{
+		return false;
+	}
+
+	float discriminant = (alongRay * alongRay) - startDistanceSquaredBeyondRadius;
+	if(discriminant < 0.f)
+	{
+		return false;
+	}
+
+	out_distance = GetMax(-alongRay - sqrtf(discriminant), 0.f);
+	return out_distance <= maxDist;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Distance along the ray to where it enters the capsule; the ray must start outside it. The side is an infinite
+// cylinder clipped to the bone's length, the ends are spheres.
+static bool GetRayEntryIntoCapsule3D(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, Vec3 const& boneStart, Vec3 const& boneEnd, float radius, float& out_distance)
+{
+	float closestDistance = FLT_MAX;
+
+	Vec3 bone = boneEnd - boneStart;
+	Vec3 boneStartToStart = startPos - boneStart;
+	float boneLengthSquared = DotProduct3D(bone, bone);
+	float startAlongBone = DotProduct3D(boneStartToStart, bone);
+	float fwdAlongBone = DotProduct3D(fwdNormal, bone);
+
+	// quadratic in the distance along the ray, scaled by the squared bone length to avoid normalizing the bone
+	float a = boneLengthSquared - (fwdAlongBone * fwdAlongBone);
+	if(a > SWEEP_DEGENERATE_EPSILON * boneLengthSquared)
+	{
+		float b = (boneLengthSquared * DotProduct3D(boneStartToStart, fwdNormal)) - (fwdAlongBone * startAlongBone);
+		float c = (boneLengthSquared * (DotProduct3D(boneStartToStart, boneStartToStart) - (radius * radius))) - (startAlongBone * startAlongBone);
+		float discriminant = (b * b) - (a * c);
+		if(discriminant >= 0.f)
+		{
+			float sideDistance = (-b - sqrtf(discriminant)) / a;
+			float sideAlongBone = startAlongBone + (sideDistance * fwdAlongBone);
+			if(sideDistance >= 0.f && sideDistance <= maxDist && sideAlongBone >= 0.f && sideAlongBone <= boneLengthSquared)
+			{
+				closestDistance = sideDistance;
+			}
+		}
+	}
+
+	float endDistance;
+	if(GetRayEntryIntoSphere3D(startPos, fwdNormal, maxDist, boneStart, radius, endDistance))
+	{
+		closestDistance = GetMin(closestDistance, endDistance);
+	}
+	if(GetRayEntryIntoSphere3D(startPos, fwdNormal, maxDist, boneEnd, radius, endDistance))
+	{
+		closestDistance = GetMin(closestDistance, endDistance);
+	}
+
+	out_distance = closestDistance;
+	return closestDistance != FLT_MAX;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Builds a hit from the impact distance and the nearest point on the fixed shape's core at that moment.
+static RaycastResult2D MakeSweptDiscResult2D(Vec2 const& startCenter, Vec2 const& fwdNormal, float maxDist, float impactDistance, Vec2 const& nearestPointOnCore, float coreRadius)
+{
+	Vec2 impactCenter = startCenter + (fwdNormal * impactDistance);
+	Vec2 impactNormal = impactCenter - nearestPointOnCore;
+	float normalLength = impactNormal.GetLength();
+	impactNormal = (normalLength > 0.f) ? impactNormal / normalLength : -fwdNormal;
+
+	Vec2 impactPos = nearestPointOnCore + (impactNormal * coreRadius);
+	return RaycastResult2D(true, impactDistance, impactPos, impactNormal, startCenter, fwdNormal, maxDist);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static RaycastResult3D MakeSweptSphereResult3D(Vec3 const& startCenter, Vec3 const& fwdNormal, float maxDist, float impactDistance, Vec3 const& nearestPointOnCore, float coreRadius)
+{
+	Vec3 impactCenter = startCenter + (fwdNormal * impactDistance);
+	Vec3 impactNormal = impactCenter - nearestPointOnCore;
+	float normalLength = impactNormal.GetLength();
+	impactNormal = (normalLength > 0.f) ? impactNormal / normalLength : -fwdNormal;
+
+	Vec3 impactPos = nearestPointOnCore + (impactNormal * coreRadius);
+	return RaycastResult3D(true, impactDistance, impactPos, impactNormal, startCenter, fwdNormal, maxDist);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+RaycastResult2D SweepDiscVsDisc2D(Vec2 const& startCenter, Vec2 const& fwdNormal, float maxDist, float discRadius, Vec2 const& fixedDiscCenter, float fixedDiscRadius)
+{
+	float impactDistance;
+	if(!GetRayEntryIntoDisc2D(startCenter, fwdNormal, maxDist, fixedDiscCenter, discRadius + fixedDiscRadius, impactDistance))
+	{
+		return RaycastResult2D(false, startCenter, fwdNormal, maxDist);
+	}
+
+	return MakeSweptDiscResult2D(startCenter, fwdNormal, maxDist, impactDistance, fixedDiscCenter, fixedDiscRadius);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+RaycastResult2D SweepDiscVsCapsule2D(Vec2 const& startCenter, Vec2 const& fwdNormal, float maxDist, float discRadius, Capsule2 const& capsule)
+{
+	float combinedRadius = discRadius + capsule.m_radius;
+
+	Vec2 nearestPointOnBone = GetNearestPointOnLineSegment2D(startCenter, capsule.m_end, capsule.m_start);
+	if(GetVectorDistanceSquared2D(startCenter, nearestPointOnBone) < combinedRadius * combinedRadius)
+	{
+		return MakeSweptDiscResult2D(startCenter, fwdNormal, maxDist, 0.f, nearestPointOnBone, capsule.m_radius);
+	}
+
+	float closestDistance = FLT_MAX;
+
+	// the two straight sides, in a frame with x along the bone and y across it
+	Vec2 bone = capsule.m_end - capsule.m_start;
+	float boneLength = bone.GetLength();
+	if(boneLength > 0.f)
+	{
+		Vec2 iBasis = bone / boneLength;
+		Vec2 jBasis = iBasis.GetRotated90Degrees();
+		Vec2 boneStartToStart = startCenter - capsule.m_start;
+		float startX = DotProduct2D(boneStartToStart, iBasis);
+		float startY = DotProduct2D(boneStartToStart, jBasis);
+		float fwdX = DotProduct2D(fwdNormal, iBasis);
+		float fwdY = DotProduct2D(fwdNormal, jBasis);
+
+		for(float side = -1.f; side <= 1.f; side += 2.f)
+		{
+			float height = side * startY;
+			float approachSpeed = -side * fwdY;
+			if(height < combinedRadius || approachSpeed <= 0.f)
+			{
+				continue;
+			}
+
+			float sideDistance = (height - combinedRadius) / approachSpeed;
+			float sideX = startX + (fwdX * sideDistance);
+			if(sideDistance <= maxDist && sideX >= 0.f && sideX <= boneLength)
+			{
+				closestDistance = GetMin(closestDistance, sideDistance);
+			}
+		}
+	}
+
+	float endDistance;
+	if(GetRayEntryIntoDisc2D(startCenter, fwdNormal, maxDist, capsule.m_start, combinedRadius, endDistance))
+	{
+		closestDistance = GetMin(closestDistance, endDistance);
+	}
+	if(GetRayEntryIntoDisc2D(startCenter, fwdNormal, maxDist, capsule.m_end, combinedRadius, endDistance))
+	{
+		closestDistance = GetMin(closestDistance, endDistance);
+	}
+
+	if(closestDistance == FLT_MAX)
+	{
+		return RaycastResult2D(false, startCenter, fwdNormal, maxDist);
+	}
+
+	Vec2 impactCenter = startCenter + (fwdNormal * closestDistance);
+	nearestPointOnBone = GetNearestPointOnLineSegment2D(impactCenter, capsule.m_end, capsule.m_start);
+	return MakeSweptDiscResult2D(startCenter, fwdNormal, maxDist, closestDistance, nearestPointOnBone, capsule.m_radius);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+RaycastResult2D SweepDiscVsAABB2D(Vec2 const& startCenter, Vec2 const& fwdNormal, float maxDist, float discRadius, AABB2 const& box)
+{
+	Vec2 nearestPoint = GetNearestPointOnAABB2D(startCenter, box);
+	if(GetVectorDistanceSquared2D(startCenter, nearestPoint) < discRadius * discRadius)
+	{
+		return MakeSweptDiscResult2D(startCenter, fwdNormal, maxDist, 0.f, nearestPoint, 0.f);
+	}
+
+	// the box grown by the radius; an entry beside a corner has to be checked against that corner's disc instead
+	float entry = 0.f;
+	float exit = maxDist;
+	if(!ClipRayToSlab(startCenter.x, fwdNormal.x, box.m_mins.x - discRadius, box.m_maxs.x + discRadius, entry, exit) ||
+	   !ClipRayToSlab(startCenter.y, fwdNormal.y, box.m_mins.y - discRadius, box.m_maxs.y + discRadius, entry, exit))
+	{
+		return RaycastResult2D(false, startCenter, fwdNormal, maxDist);
+	}
+
+	Vec2 entryPos = startCenter + (fwdNormal * entry);
+	bool isBesideX = entryPos.x < box.m_mins.x || entryPos.x > box.m_maxs.x;
+	bool isBesideY = entryPos.y < box.m_mins.y || entryPos.y > box.m_maxs.y;
+	if(isBesideX && isBesideY)
+	{
+		Vec2 corner(entryPos.x < box.m_mins.x ? box.m_mins.x : box.m_maxs.x, entryPos.y < box.m_mins.y ? box.m_mins.y : box.m_maxs.y);
+		if(!GetRayEntryIntoDisc2D(startCenter, fwdNormal, maxDist, corner, discRadius, entry))
+		{
+			return RaycastResult2D(false, startCenter, fwdNormal, maxDist);
+		}
+	}
+
+	Vec2 impactCenter = startCenter + (fwdNormal * entry);
+	return MakeSweptDiscResult2D(startCenter, fwdNormal, maxDist, entry, GetNearestPointOnAABB2D(impactCenter, box), 0.f);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+RaycastResult2D SweepDiscVsOBB2D(Vec2 const& startCenter, Vec2 const& fwdNormal, float maxDist, float discRadius, OBB2 const& box)
+{
+	Vec2 iBasis = box.m_iBasisNormal;
+	Vec2 jBasis = iBasis.GetRotated90Degrees();
+
+	Vec2 localStart = box.GetLocalPosForWorldPos(startCenter);
+	Vec2 localFwd(DotProduct2D(fwdNormal, iBasis), DotProduct2D(fwdNormal, jBasis));
+	AABB2 localBox(-box.m_halfDimension, box.m_halfDimension);
+
+	RaycastResult2D result = SweepDiscVsAABB2D(localStart, localFwd, maxDist, discRadius, localBox);
+	result.m_rayStartPos = startCenter;
+	result.m_rayForwardNormal = fwdNormal;
+	if(result.m_didImpact)
+	{
+		result.m_impactPos = box.GetWorldPosForLocalPos(result.m_impactPos);
+		result.m_impactNormal = (iBasis * result.m_impactNormal.x) + (jBasis * result.m_impactNormal.y);
+	}
+
+	return result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+RaycastResult3D SweepSphereVsSphere3D(Vec3 const& startCenter, Vec3 const& fwdNormal, float maxDist, float sphereRadius, Sphere const& fixedSphere)
+{
+	float impactDistance;
+	if(!GetRayEntryIntoSphere3D(startCenter, fwdNormal, maxDist, fixedSphere.m_center, sphereRadius + fixedSphere.m_radius, impactDistance))
+	{
+		return RaycastResult3D(false, startCenter, fwdNormal, maxDist);
+	}
+
+	return MakeSweptSphereResult3D(startCenter, fwdNormal, maxDist, impactDistance, fixedSphere.m_center, fixedSphere.m_radius);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+RaycastResult3D SweepSphereVsAABB3D(Vec3 const& startCenter, Vec3 const& fwdNormal, float maxDist, float sphereRadius, AABB3 const& box)
+{
+	Vec3 nearestPoint = GetNearestPointOnAABB3D(startCenter, box);
+	if(GetVectorDistanceSquared3D(startCenter, nearestPoint) < sphereRadius * sphereRadius)
+	{
+		return MakeSweptSphereResult3D(startCenter, fwdNormal, maxDist, 0.f, nearestPoint, 0.f);
+	}
+
+	float entry = 0.f;
+	float exit = maxDist;
+	if(!ClipRayToSlab(startCenter.x, fwdNormal.x, box.m_mins.x - sphereRadius, box.m_maxs.x + sphereRadius, entry, exit) ||
+	   !ClipRayToSlab(startCenter.y, fwdNormal.y, box.m_mins.y - sphereRadius, box.m_maxs.y + sphereRadius, entry, exit) ||
+	   !ClipRayToSlab(startCenter.z, fwdNormal.z, box.m_mins.z - sphereRadius, box.m_maxs.z + sphereRadius, entry, exit))
+	{
+		return RaycastResult3D(false, startCenter, fwdNormal, maxDist);
+	}
+
+	// entering the grown box beside two faces means the rounded edge between them, beside three the rounded corner,
+	// which is covered by the three edges that meet there
+	Vec3 entryPos = startCenter + (fwdNormal * entry);
+	float const entryCoords[3] = { entryPos.x, entryPos.y, entryPos.z };
+	float const minCoords[3] = { box.m_mins.x, box.m_mins.y, box.m_mins.z };
+	float const maxCoords[3] = { box.m_maxs.x, box.m_maxs.y, box.m_maxs.z };
+	float cornerCoords[3];
+	float oppositeCoords[3];
+	bool isBeside[3];
+	int numBeside = 0;
+	for(int axis = 0; axis < 3; ++axis)
+	{
+		isBeside[axis] = entryCoords[axis] < minCoords[axis] || entryCoords[axis] > maxCoords[axis];
+		cornerCoords[axis] = (entryCoords[axis] < minCoords[axis]) ? minCoords[axis] : maxCoords[axis];
+		oppositeCoords[axis] = (entryCoords[axis] < minCoords[axis]) ? maxCoords[axis] : minCoords[axis];
+		numBeside += isBeside[axis] ? 1 : 0;
+	}
+
+	if(numBeside >= 2)
+	{
+		float closestDistance = FLT_MAX;
+		for(int edgeAxis = 0; edgeAxis < 3; ++edgeAxis)
+		{
+			if(numBeside == 2 && isBeside[edgeAxis])
+			{
+				continue;
+			}
+
+			float edgeStartCoords[3] = { cornerCoords[0], cornerCoords[1], cornerCoords[2] };
+			float edgeEndCoords[3] = { cornerCoords[0], cornerCoords[1], cornerCoords[2] };
+			if(numBeside == 2)
+			{
+				edgeStartCoords[edgeAxis] = minCoords[edgeAxis];
+				edgeEndCoords[edgeAxis] = maxCoords[edgeAxis];
+			}
+			else
+			{
+				edgeEndCoords[edgeAxis] = oppositeCoords[edgeAxis];
+			}
+
+			float edgeDistance;
+			Vec3 edgeStart(edgeStartCoords[0], edgeStartCoords[1], edgeStartCoords[2]);
+			Vec3 edgeEnd(edgeEndCoords[0], edgeEndCoords[1], edgeEndCoords[2]);
+			if(GetRayEntryIntoCapsule3D(startCenter, fwdNormal, maxDist, edgeStart, edgeEnd, sphereRadius, edgeDistance))
+			{
+				closestDistance = GetMin(closestDistance, edgeDistance);
+			}
+		}
+
+		if(closestDistance == FLT_MAX)
+		{
+			return RaycastResult3D(false, startCenter, fwdNormal, maxDist);
+		}
+		entry = closestDistance;
+	}
+
+	Vec3 impactCenter = startCenter + (fwdNormal * entry);
+	return MakeSweptSphereResult3D(startCenter, fwdNormal, maxDist, entry, GetNearestPointOnAABB3D(impactCenter, box), 0.f);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+RaycastResult3D SweepSphereVsOBB3D(Vec3 const& startCenter, Vec3 const& fwdNormal, float maxDist, float sphereRadius, OBB3 const& box)
+{
+	Vec3 localStart = box.GetLocalPositionForWorldPosition(startCenter);
+	Vec3 localFwd(DotProduct3D(fwdNormal, box.m_iBasis), DotProduct3D(fwdNormal, box.m_jBasis), DotProduct3D(fwdNormal, box.m_kBasis));
+	AABB3 localBox(-box.m_halfDimensions, box.m_halfDimensions);
+
+	RaycastResult3D result = SweepSphereVsAABB3D(localStart, localFwd, maxDist, sphereRadius, localBox);
+	result.m_rayStartPos = startCenter;
+	result.m_rayForwardNormal = fwdNormal;
+	if(result.m_didImpact)
+	{
+		result.m_impactPos = box.GetWorldPositionForLocalPosition(result.m_impactPos);
+		result.m_impactNormal = (box.m_iBasis * result.m_impactNormal.x) + (box.m_jBasis * result.m_impactNormal.y) + (box.m_kBasis * result.m_impactNormal.z);
+	}
+
+	return result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Nearest point on a solid triangle, by which vertex, edge or face region the point projects into.
+static Vec3 GetNearestPointOnTriangle3D(Vec3 const& referencePoint, Vec3 const& triPos0, Vec3 const& triPos1, Vec3 const& triPos2)
+{
+	Vec3 edge01 = triPos1 - triPos0;
+	Vec3 edge02 = triPos2 - triPos0;
+
+	Vec3 pos0ToPoint = referencePoint - triPos0;
+	float d1 = DotProduct3D(edge01, pos0ToPoint);
+	float d2 = DotProduct3D(edge02, pos0ToPoint);
+	if(d1 <= 0.f && d2 <= 0.f)
+	{
+		return triPos0;
+	}
+
+	Vec3 pos1ToPoint = referencePoint - triPos1;
+	float d3 = DotProduct3D(edge01, pos1ToPoint);
+	float d4 = DotProduct3D(edge02, pos1ToPoint);
+	if(d3 >= 0.f && d4 <= d3)
+	{
+		return triPos1;
+	}
+
+	float edge01Region = (d1 * d4) - (d3 * d2);
+	if(edge01Region <= 0.f && d1 >= 0.f && d3 <= 0.f)
+	{
+		return triPos0 + (edge01 * (d1 / (d1 - d3)));
+	}
+
+	Vec3 pos2ToPoint = referencePoint - triPos2;
+	float d5 = DotProduct3D(edge01, pos2ToPoint);
+	float d6 = DotProduct3D(edge02, pos2ToPoint);
+	if(d6 >= 0.f && d5 <= d6)
+	{
+		return triPos2;
+	}
+
+	float edge02Region = (d5 * d2) - (d1 * d6);
+	if(edge02Region <= 0.f && d2 >= 0.f && d6 <= 0.f)
+	{
+		return triPos0 + (edge02 * (d2 / (d2 - d6)));
+	}
+
+	float edge12Region = (d3 * d6) - (d5 * d4);
+	if(edge12Region <= 0.f && (d4 - d3) >= 0.f && (d5 - d6) >= 0.f)
+	{
+		return triPos1 + ((triPos2 - triPos1) * ((d4 - d3) / ((d4 - d3) + (d5 - d6))));
+	}
+
+	float faceScale = 1.f / (edge12Region + edge02Region + edge01Region);
+	return triPos0 + (edge01 * (edge02Region * faceScale)) + (edge02 * (edge01Region * faceScale));
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+RaycastResult3D SweepSphereVsTriangle3D(Vec3 const& startCenter, Vec3 const& fwdNormal, float maxDist, float sphereRadius, Vec3 const& triPos0, Vec3 const& triPos1, Vec3 const& triPos2)
+{
+	Vec3 nearestPoint = GetNearestPointOnTriangle3D(startCenter, triPos0, triPos1, triPos2);
+	if(GetVectorDistanceSquared3D(startCenter, nearestPoint) < sphereRadius * sphereRadius)
+	{
+		return MakeSweptSphereResult3D(startCenter, fwdNormal, maxDist, 0.f, nearestPoint, 0.f);
+	}
+
+	float closestDistance = FLT_MAX;
+
+	// the face, pushed out by the radius toward the side the sphere starts on; a sphere already closer to the plane than
+	// its radius can only reach the triangle over an edge
+	Vec3 faceNormal = CrossProduct3D(triPos1 - triPos0, triPos2 - triPos0);
+	float faceNormalLength = faceNormal.GetLength();
+	if(faceNormalLength > 0.f)
+	{
+		faceNormal /= faceNormalLength;
+		float height = DotProduct3D(startCenter - triPos0, faceNormal);
+		if(height < 0.f)
+		{
+			faceNormal = -faceNormal;
+			height = -height;
+		}
+
+		float approachSpeed = -DotProduct3D(fwdNormal, faceNormal);
+		if(height >= sphereRadius && approachSpeed > 0.f)
+		{
+			float faceDistance = (height - sphereRadius) / approachSpeed;
+			Vec3 pointOnPlane = startCenter + (fwdNormal * faceDistance) - (faceNormal * sphereRadius);
+			bool isInsideEdge01 = DotProduct3D(CrossProduct3D(triPos1 - triPos0, pointOnPlane - triPos0), faceNormal) >= 0.f;
+			bool isInsideEdge12 = DotProduct3D(CrossProduct3D(triPos2 - triPos1, pointOnPlane - triPos1), faceNormal) >= 0.f;
+			bool isInsideEdge20 = DotProduct3D(CrossProduct3D(triPos0 - triPos2, pointOnPlane - triPos2), faceNormal) >= 0.f;
+			bool isCounterClockwise = DotProduct3D(CrossProduct3D(triPos1 - triPos0, triPos2 - triPos0), faceNormal) > 0.f;
+			bool isInside = isCounterClockwise ? (isInsideEdge01 && isInsideEdge12 && isInsideEdge20) : (!isInsideEdge01 && !isInsideEdge12 && !isInsideEdge20);
+			if(faceDistance <= maxDist && isInside)
+			{
+				closestDistance = faceDistance;
+			}
+		}
+	}
+
+	Vec3 const corners[3] = { triPos0, triPos1, triPos2 };
+	for(int edgeIndex = 0; edgeIndex < 3; ++edgeIndex)
+	{
+		float edgeDistance;
+		if(GetRayEntryIntoCapsule3D(startCenter, fwdNormal, maxDist, corners[edgeIndex], corners[(edgeIndex + 1) % 3], sphereRadius, edgeDistance))
+		{
+			closestDistance = GetMin(closestDistance, edgeDistance);
+		}
+	}
+
+	if(closestDistance == FLT_MAX)
+	{
+		return RaycastResult3D(false, startCenter, fwdNormal, maxDist);
+	}
+
+	Vec3 impactCenter = startCenter + (fwdNormal * closestDistance);
+	return MakeSweptSphereResult3D(startCenter, fwdNormal, maxDist, closestDistance, GetNearestPointOnTriangle3D(impactCenter, triPos0, triPos1, triPos2), 0.f);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Batched sweeps. The lanes test the ray against each shape grown by the sphere radius plus a little slack, which can
+// only accept more than the exact sweep, never less; accepted shapes are then swept one at a time.
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static float GetSweepFilterRadius(float sphereRadius)
+{
+	return (sphereRadius * 1.0001f) + 1e-5f;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static void StoreRaycastResult(RaycastPacketResults3D const& out_results, int index, RaycastResult3D const& result)
+{
+	out_results.m_didImpact[index] = true;
+	float* const outputs[7] = { out_results.m_impactDistance, out_results.m_impactPosX, out_results.m_impactPosY, out_results.m_impactPosZ,
+								out_results.m_impactNormalX, out_results.m_impactNormalY, out_results.m_impactNormalZ };
+	float const values[7] = { result.m_impactDistance, result.m_impactPos.x, result.m_impactPos.y, result.m_impactPos.z,
+							  result.m_impactNormal.x, result.m_impactNormal.y, result.m_impactNormal.z };
+	for(int outputIndex = 0; outputIndex < 7; ++outputIndex)
+	{
+		if(outputs[outputIndex] != nullptr)
+		{
+			outputs[outputIndex][index] = values[outputIndex];
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static AABB3 GetAABB3FromSoA(AABB3SoA const& boxes, int index)
+{
+	return AABB3(boxes.m_minX[index], boxes.m_minY[index], boxes.m_minZ[index], boxes.m_maxX[index], boxes.m_maxY[index], boxes.m_maxZ[index]);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static Sphere GetSphereFromSoA(SphereSoA const& spheres, int index)
+{
+	return Sphere(Vec3(spheres.m_centerX[index], spheres.m_centerY[index], spheres.m_centerZ[index]), spheres.m_radius[index]);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Lanes of the group starting at first whose grown box the ray reaches within maxDist.
+static int GetSweepCandidateAABB3Lanes(RaycastVec3Lanes const& start, RaycastVec3Lanes const& fwd, float maxDist, float filterRadius, AABB3SoA const& boxes, int first, int numLanes)
+{
+	RaycastVec3Lanes mins;
+	RaycastVec3Lanes maxs;
+	LoadAABB3Lanes(boxes, first, numLanes, mins, maxs);
+
+	RaycastVec3Lanes grow(Vec3(filterRadius, filterRadius, filterRadius));
+	RaycastLane impactDistance;
+	RaycastLane isInside;
+	RaycastLane hitMask = RaycastLanesVsAABB3D(start, fwd, RaycastOps::Splat(maxDist), mins - grow, maxs + grow, impactDistance, isInside);
+	return RaycastOps::GetMaskBits(RaycastOps::And(hitMask, GetValidLanesMask(numLanes)));
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static int GetSweepCandidateSphereLanes(RaycastVec3Lanes const& start, RaycastVec3Lanes const& fwd, float maxDist, float filterRadius, SphereSoA const& spheres, int first, int numLanes)
+{
+	RaycastVec3Lanes center;
+	RaycastLane radius;
+	LoadSphereLanes(spheres, first, numLanes, center, radius);
+
+	RaycastLane impactDistance;
+	RaycastLane isInside;
+	RaycastLane hitMask = RaycastLanesVsSphere3D(start, fwd, RaycastOps::Splat(maxDist), center, RaycastOps::Add(radius, RaycastOps::Splat(filterRadius)), impactDistance, isInside);
+	return RaycastOps::GetMaskBits(RaycastOps::And(hitMask, GetValidLanesMask(numLanes)));
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int SweepSphereVsAABB3Ds(Vec3 const& startCenter, Vec3 const& fwdNormal, float maxDist, float sphereRadius, AABB3SoA const& boxes, RaycastPacketResults3D const& out_results)
+{
+	RaycastVec3Lanes start(startCenter);
+	RaycastVec3Lanes fwd(fwdNormal);
+	float filterRadius = GetSweepFilterRadius(sphereRadius);
+	int numHits = 0;
+
+	for(int first = 0; first < boxes.m_count; first += RAYCAST_LANES)
+	{
+		int numLanes = GetMin(RAYCAST_LANES, boxes.m_count - first);
+		StoreRaycastResults(out_results, first, numLanes, RaycastOps::Zero(), RaycastOps::Zero(), start, fwd, start, fwd);
+
+		int candidateBits = GetSweepCandidateAABB3Lanes(start, fwd, maxDist, filterRadius, boxes, first, numLanes);
+		for(int lane = 0; lane < numLanes; ++lane)
+		{
+			if((candidateBits & (1 << lane)) == 0)
+			{
+				continue;
+			}
+
+			int index = first + lane;
+			RaycastResult3D result = SweepSphereVsAABB3D(startCenter, fwdNormal, maxDist, sphereRadius, GetAABB3FromSoA(boxes, index));
+			if(result.m_didImpact)
+			{
+				StoreRaycastResult(out_results, index, result);
+				++numHits;
+			}
+		}
+	}
+
+	return numHits;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int SweepSphereVsAABB3DsClosest(Vec3 const& startCenter, Vec3 const& fwdNormal, float maxDist, float sphereRadius, AABB3SoA const& boxes, RaycastResult3D& out_result)
+{
+	RaycastVec3Lanes start(startCenter);
+	RaycastVec3Lanes fwd(fwdNormal);
+	float filterRadius = GetSweepFilterRadius(sphereRadius);
+	int closestIndex = -1;
+	out_result = RaycastResult3D(false, startCenter, fwdNormal, maxDist);
+
+	for(int first = 0; first < boxes.m_count; first += RAYCAST_LANES)
+	{
+		int numLanes = GetMin(RAYCAST_LANES, boxes.m_count - first);
+
+		// the sweep shrinks to the closest hit so far, so anything farther drops out of the candidates
+		float closestDistance = (closestIndex < 0) ? maxDist : out_result.m_impactDistance;
+		int candidateBits = GetSweepCandidateAABB3Lanes(start, fwd, closestDistance, filterRadius, boxes, first, numLanes);
+		for(int lane = 0; lane < numLanes; ++lane)
+		{
+			if((candidateBits & (1 << lane)) == 0)
+			{
+				continue;
+			}
+
+			int index = first + lane;
+			RaycastResult3D result = SweepSphereVsAABB3D(startCenter, fwdNormal, maxDist, sphereRadius, GetAABB3FromSoA(boxes, index));
+			if(result.m_didImpact && (closestIndex < 0 || result.m_impactDistance < out_result.m_impactDistance))
+			{
+				out_result = result;
+				closestIndex = index;
+			}
+		}
+	}
+
+	return closestIndex;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int SweepSphereVsSphere3Ds(Vec3 const& startCenter, Vec3 const& fwdNormal, float maxDist, float sphereRadius, SphereSoA const& spheres, RaycastPacketResults3D const& out_results)
+{
+	RaycastVec3Lanes start(startCenter);
+	RaycastVec3Lanes fwd(fwdNormal);
+	float filterRadius = GetSweepFilterRadius(sphereRadius);
+	int numHits = 0;
+
+	for(int first = 0; first < spheres.m_count; first += RAYCAST_LANES)
+	{
+		int numLanes = GetMin(RAYCAST_LANES, spheres.m_count - first);
+		StoreRaycastResults(out_results, first, numLanes, RaycastOps::Zero(), RaycastOps::Zero(), start, fwd, start, fwd);
+
+		int candidateBits = GetSweepCandidateSphereLanes(start, fwd, maxDist, filterRadius, spheres, first, numLanes);
+		for(int lane = 0; lane < numLanes; ++lane)
+		{
+			if((candidateBits & (1 << lane)) == 0)
+			{
+				continue;
+			}
+
+			int index = first + lane;
+			RaycastResult3D result = SweepSphereVsSphere3D(startCenter, fwdNormal, maxDist, sphereRadius, GetSphereFromSoA(spheres, index));
+			if(result.m_didImpact)
+			{
+				StoreRaycastResult(out_results, index, result);
+				++numHits;
+			}
+		}
+	}
+
+	return numHits;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int SweepSphereVsSphere3DsClosest(Vec3 const& startCenter, Vec3 const& fwdNormal, float maxDist, float sphereRadius, SphereSoA const& spheres, RaycastResult3D& out_result)
+{
+	RaycastVec3Lanes start(startCenter);
+	RaycastVec3Lanes fwd(fwdNormal);
+	float filterRadius = GetSweepFilterRadius(sphereRadius);
+	int closestIndex = -1;
+	out_result = RaycastResult3D(false, startCenter, fwdNormal, maxDist);
+
+	for(int first = 0; first < spheres.m_count; first += RAYCAST_LANES)
+	{
+		int numLanes = GetMin(RAYCAST_LANES, spheres.m_count - first);
+
+		float closestDistance = (closestIndex < 0) ? maxDist : out_result.m_impactDistance;
+		int candidateBits = GetSweepCandidateSphereLanes(start, fwd, closestDistance, filterRadius, spheres, first, numLanes);
+		for(int lane = 0; lane < numLanes; ++lane)
+		{
+			if((candidateBits & (1 << lane)) == 0)
+			{
+				continue;
+			}
+
+			int index = first + lane;
+			RaycastResult3D result = SweepSphereVsSphere3D(startCenter, fwdNormal, maxDist, sphereRadius, GetSphereFromSoA(spheres, index));
+			if(result.m_didImpact && (closestIndex < 0 || result.m_impactDistance < out_result.m_impactDistance))
+			{
+				out_result = result;
+				closestIndex = index;
+			}
+		}
+	}
+
+	return closestIndex;
+}
@@ -5,6 +5,8 @@
 
 struct LineSegment2;
 struct AABB2;
+struct OBB2;
+struct Capsule2;
 struct ConvexHull2;
 struct Plane2;
 
@@ -87,4 +89,103 @@ RaycastResult3D RaycastVsAABB3D(Vec3 const& startPos, Vec3 const& fwdNormal, flo
 RaycastResult3D RaycastVsSphere3D(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, Sphere const& sphere);
 RaycastResult3D RaycastVsCylinder3D(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, Cylinder3D const& cylinder);
 RaycastResult3D RaycastVsOBB3D(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, OBB3 const& obb);
-RaycastResult3D RaycastVsPlane3D(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, Plane3 const& plane);
\ No newline at end of file
+RaycastResult3D RaycastVsPlane3D(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, Plane3 const& plane);
+
+//------------------------------------------------------------------------------------------------------------------
+// Batched raycasts. Rays and shapes are passed as caller-owned SoA arrays and processed 8 lanes at a time on AVX2
+// builds (4 otherwise) with branch-free slab/sphere tests; groups where no lane hits skip the impact math entirely.
+// Results match the single-ray functions above. Misses write m_didImpact false, an impact distance of FLT_MAX, the ray
+// start as impact position and the ray direction as impact normal.
+//------------------------------------------------------------------------------------------------------------------
+struct RayPacket3D
+{
+	int				m_numRays = 0;
+	float const*	m_startX = nullptr;
+	float const*	m_startY = nullptr;
+	float const*	m_startZ = nullptr;
+	float const*	m_fwdX = nullptr;
+	float const*	m_fwdY = nullptr;
+	float const*	m_fwdZ = nullptr;
+	float const*	m_maxLength = nullptr;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// One entry per ray (packet queries) or per shape (one ray vs N shapes). Position and normal arrays may be left null.
+struct RaycastPacketResults3D
+{
+	bool*	m_didImpact = nullptr;
+	float*	m_impactDistance = nullptr;
+	float*	m_impactPosX = nullptr;
+	float*	m_impactPosY = nullptr;
+	float*	m_impactPosZ = nullptr;
+	float*	m_impactNormalX = nullptr;
+	float*	m_impactNormalY = nullptr;
+	float*	m_impactNormalZ = nullptr;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct AABB3SoA
+{
+	int				m_count = 0;
+	float const*	m_minX = nullptr;
+	float const*	m_minY = nullptr;
+	float const*	m_minZ = nullptr;
+	float const*	m_maxX = nullptr;
+	float const*	m_maxY = nullptr;
+	float const*	m_maxZ = nullptr;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct SphereSoA
+{
+	int				m_count = 0;
+	float const*	m_centerX = nullptr;
+	float const*	m_centerY = nullptr;
+	float const*	m_centerZ = nullptr;
+	float const*	m_radius = nullptr;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Many rays vs one shape. Return the number of rays that hit.
+int RaycastPacketVsAABB3D(RayPacket3D const& rays, AABB3 const& box, RaycastPacketResults3D const& out_results);
+int RaycastPacketVsSphere3D(RayPacket3D const& rays, Sphere const& sphere, RaycastPacketResults3D const& out_results);
+int RaycastPacketVsOBB3D(RayPacket3D const& rays, OBB3 const& obb, RaycastPacketResults3D const& out_results);
+
+// One ray vs many shapes. The plain versions fill one result per shape and return the hit count; Any stops at the first
+// hit (line of sight, occlusion); Closest shrinks the ray as it goes and returns the nearest shape index, or -1.
+int		RaycastVsAABB3Ds(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, AABB3SoA const& boxes, RaycastPacketResults3D const& out_results);
+bool	RaycastVsAABB3DsAny(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, AABB3SoA const& boxes);
+int		RaycastVsAABB3DsClosest(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, AABB3SoA const& boxes, RaycastResult3D& out_result);
+
+int		RaycastVsSphere3Ds(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, SphereSoA const& spheres, RaycastPacketResults3D const& out_results);
+bool	RaycastVsSphere3DsAny(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, SphereSoA const& spheres);
+int		RaycastVsSphere3DsClosest(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, SphereSoA const& spheres, RaycastResult3D& out_result);
+
+//------------------------------------------------------------------------------------------------------------------
+// Swept shape casts: a disc or sphere moving in a straight line against a fixed shape, so a single step per frame can
+// catch a fast mover that discrete overlap tests would let pass through. For two moving shapes, sweep one against the
+// other using the relative motion.
+//
+// The ray is the moving shape's center. m_impactDistance is how far the center travels before the shapes first touch,
+// m_impactPos is the touching point on the fixed shape and m_impactNormal is the fixed shape's surface normal there,
+// facing the moving shape. A moving shape that already overlaps at the start hits at distance 0 with the normal pushing
+// it out along the shortest way (back along the sweep if its center is on the fixed shape's core). Misses are reported
+// like raycast misses.
+//------------------------------------------------------------------------------------------------------------------
+RaycastResult2D SweepDiscVsDisc2D(Vec2 const& startCenter, Vec2 const& fwdNormal, float maxDist, float discRadius, Vec2 const& fixedDiscCenter, float fixedDiscRadius);
+RaycastResult2D SweepDiscVsCapsule2D(Vec2 const& startCenter, Vec2 const& fwdNormal, float maxDist, float discRadius, Capsule2 const& capsule);
+RaycastResult2D SweepDiscVsAABB2D(Vec2 const& startCenter, Vec2 const& fwdNormal, float maxDist, float discRadius, AABB2 const& box);
+RaycastResult2D SweepDiscVsOBB2D(Vec2 const& startCenter, Vec2 const& fwdNormal, float maxDist, float discRadius, OBB2 const& box);
+
+RaycastResult3D SweepSphereVsSphere3D(Vec3 const& startCenter, Vec3 const& fwdNormal, float maxDist, float sphereRadius, Sphere const& fixedSphere);
+RaycastResult3D SweepSphereVsAABB3D(Vec3 const& startCenter, Vec3 const& fwdNormal, float maxDist, float sphereRadius, AABB3 const& box);
+RaycastResult3D SweepSphereVsOBB3D(Vec3 const& startCenter, Vec3 const& fwdNormal, float maxDist, float sphereRadius, OBB3 const& box);
+RaycastResult3D SweepSphereVsTriangle3D(Vec3 const& startCenter, Vec3 const& fwdNormal, float maxDist, float sphereRadius, Vec3 const& triPos0, Vec3 const& triPos1, Vec3 const& triPos2);
+
+// One sphere swept against many shapes, with the same outputs as the batched raycasts. The lanes only reject shapes the
+// sweep cannot reach; the rest go through the single-shape sweeps above, so results are identical to calling them.
+int		SweepSphereVsAABB3Ds(Vec3 const& startCenter, Vec3 const& fwdNormal, float maxDist, float sphereRadius, AABB3SoA const& boxes, RaycastPacketResults3D const& out_results);
+int		SweepSphereVsAABB3DsClosest(Vec3 const& startCenter, Vec3 const& fwdNormal, float maxDist, float sphereRadius, AABB3SoA const& boxes, RaycastResult3D& out_result);
+
+int		SweepSphereVsSphere3Ds(Vec3 const& startCenter, Vec3 const& fwdNormal, float maxDist, float sphereRadius, SphereSoA const& spheres, RaycastPacketResults3D const& out_results);
+int		SweepSphereVsSphere3DsClosest(Vec3 const& startCenter, Vec3 const& fwdNormal, float maxDist, float sphereRadius, SphereSoA const& spheres, RaycastResult3D& out_result);
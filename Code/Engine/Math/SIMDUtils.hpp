@@ -0,0 +1,819 @@
+#pragma once
+
+#include "Game/EngineBuildPreferences.hpp"
+
+//------------------------------------------------------------------------------------------------------------------
+// Compile-time ISA selection. Define ENGINE_FORCE_SCALAR_MATH in EngineBuildPreferences.hpp to run every math kernel
+// through its scalar reference path (useful when validating the SIMD versions).
+//
+//	ENGINE_SIMD_SSE		x64 / SSE2 baseline, always available on the PC builds
+//	ENGINE_SIMD_SSE4	SSE4.1 blends and dot products (/arch:AVX or higher on MSVC)
+//	ENGINE_SIMD_AVX2	8-wide kernels and FMA (/arch:AVX2)
+//	ENGINE_SIMD_NEON	ARM64
+//------------------------------------------------------------------------------------------------------------------
+#if !defined(ENGINE_FORCE_SCALAR_MATH)
+	#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define ENGINE_SIMD_SSE
+		#if defined(__SSE4_1__) || defined(__AVX__)
+			#define ENGINE_SIMD_SSE4
+		#endif
+		#if defined(__AVX2__)
+			#define ENGINE_SIMD_AVX2
+		#endif
+	#elif defined(__ARM_NEON) || defined(_M_ARM64)
+		#define ENGINE_SIMD_NEON
+	#endif
+#endif
+
+#if defined(ENGINE_SIMD_SSE) || defined(ENGINE_SIMD_NEON)
+	#define ENGINE_SIMD_FLOAT4
+#endif
+
+#if defined(ENGINE_SIMD_AVX2)
+	#include <immintrin.h>
+#elif defined(ENGINE_SIMD_SSE4)
+	#include <smmintrin.h>
+#elif defined(ENGINE_SIMD_SSE)
+	#include <emmintrin.h>
+#elif defined(ENGINE_SIMD_NEON)
+	#include <arm_neon.h>
+#endif
+
+#include <math.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------------------------------------------
+// Float4: four packed floats. Maps to __m128 / float32x4_t, or to a plain aligned struct when no SIMD is available so
+// kernels written against it still compile and run everywhere.
+//------------------------------------------------------------------------------------------------------------------
+#if defined(ENGINE_SIMD_SSE)
+typedef __m128 Float4;
+#elif defined(ENGINE_SIMD_NEON)
+typedef float32x4_t Float4;
+#else
+struct alignas(16) Float4
+{
+	float m_lanes[4];
+};
+#endif
+
+//------------------------------------------------------------------------------------------------------------------
+inline Float4 Float4Load(float const* alignedValues)
+{
+#if defined(ENGINE_SIMD_SSE)
+	return _mm_load_ps(alignedValues);
+#elif defined(ENGINE_SIMD_NEON)
+	return vld1q_f32(alignedValues);
+#else
+	return Float4{ { alignedValues[0], alignedValues[1], alignedValues[2], alignedValues[3] } };
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------
+inline Float4 Float4LoadUnaligned(float const* values)
+{
+#if defined(ENGINE_SIMD_SSE)
+	return _mm_loadu_ps(values);
+#else
+	return Float4Load(values);
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------
+inline void Float4Store(float* out_alignedValues, Float4 v)
+{
+#if defined(ENGINE_SIMD_SSE)
+	_mm_store_ps(out_alignedValues, v);
+#elif defined(ENGINE_SIMD_NEON)
+	vst1q_f32(out_alignedValues, v);
+#else
+	out_alignedValues[0] = v.m_lanes[0];
+	out_alignedValues[1] = v.m_lanes[1];
+	out_alignedValues[2] = v.m_lanes[2];
+	out_alignedValues[3] = v.m_lanes[3];
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------
+inline void Float4StoreUnaligned(float* out_values, Float4 v)
+{
+#if defined(ENGINE_SIMD_SSE)
+	_mm_storeu_ps(out_values, v);
+#else
+	Float4Store(out_values, v);
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------
+inline Float4 Float4Set(float x, float y, float z, float w)
+{
+#if defined(ENGINE_SIMD_SSE)
+	return _mm_setr_ps(x, y, z, w);
+#else
+	alignas(16) float values[4] = { x, y, z, w };
+	return Float4Load(values);
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------
+inline Float4 Float4Splat(float value)
+{
+#if defined(ENGINE_SIMD_SSE)
+	return _mm_set1_ps(value);
+#elif defined(ENGINE_SIMD_NEON)
+	return vdupq_n_f32(value);
+#else
+	return Float4{ { value, value, value, value } };
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------
+inline Float4 Float4Zero()
+{
+#if defined(ENGINE_SIMD_SSE)
+	return _mm_setzero_ps();
+#else
+	return Float4Splat(0.f);
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------
+template<int lane>
+inline float Float4GetLane(Float4 v)
+{
+	static_assert(lane >= 0 && lane < 4, "Float4 lane out of range");
+
+#if defined(ENGINE_SIMD_SSE)
+	return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(lane, lane, lane, lane)));
+#elif defined(ENGINE_SIMD_NEON)
+	return vgetq_lane_f32(v, lane);
+#else
+	return v.m_lanes[lane];
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------
+#if defined(ENGINE_SIMD_SSE)
+	#define ENGINE_FLOAT4_BINARY_OP(name, sseOp, neonOp, scalarOp)		inline Float4 name(Float4 a, Float4 b) { return sseOp(a, b); }
+#elif defined(ENGINE_SIMD_NEON)
+	#define ENGINE_FLOAT4_BINARY_OP(name, sseOp, neonOp, scalarOp)		inline Float4 name(Float4 a, Float4 b) { return neonOp(a, b); }
+#else
+	#define ENGINE_FLOAT4_BINARY_OP(name, sseOp, neonOp, scalarOp)		inline Float4 name(Float4 a, Float4 b) { Float4 r; for(int i = 0; i < 4; ++i) { float x = a.m_lanes[i]; float y = b.m_lanes[i]; r.m_lanes[i] = (scalarOp); } return r; }
+#endif
+
+ENGINE_FLOAT4_BINARY_OP(Float4Add, _mm_add_ps, vaddq_f32, x + y)
+ENGINE_FLOAT4_BINARY_OP(Float4Sub, _mm_sub_ps, vsubq_f32, x - y)
+ENGINE_FLOAT4_BINARY_OP(Float4Mul, _mm_mul_ps, vmulq_f32, x * y)
+ENGINE_FLOAT4_BINARY_OP(Float4Div, _mm_div_ps, vdivq_f32, x / y)
+ENGINE_FLOAT4_BINARY_OP(Float4Min, _mm_min_ps, vminq_f32, x < y ? x : y)
+ENGINE_FLOAT4_BINARY_OP(Float4Max, _mm_max_ps, vmaxq_f32, x > y ? x : y)
+
+#undef ENGINE_FLOAT4_BINARY_OP
+
+//------------------------------------------------------------------------------------------------------------------
+inline Float4 Float4Sqrt(Float4 v)
+{
+#if defined(ENGINE_SIMD_SSE)
+	return _mm_sqrt_ps(v);
+#elif defined(ENGINE_SIMD_NEON)
+	return vsqrtq_f32(v);
+#else
+	return Float4{ { sqrtf(v.m_lanes[0]), sqrtf(v.m_lanes[1]), sqrtf(v.m_lanes[2]), sqrtf(v.m_lanes[3]) } };
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// a * b + c. Fused on AVX2/NEON, so results can differ from the scalar path in the last bit.
+inline Float4 Float4MulAdd(Float4 a, Float4 b, Float4 c)
+{
+#if defined(ENGINE_SIMD_AVX2)
+	return _mm_fmadd_ps(a, b, c);
+#elif defined(ENGINE_SIMD_NEON)
+	return vfmaq_f32(c, a, b);
+#else
+	return Float4Add(Float4Mul(a, b), c);
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Rounds to the nearest integer, ties to even, matching nearbyintf in the default rounding mode. The SSE2 path goes
+// through int32, so it only holds for |v| < 2^31.
+inline Float4 Float4Round(Float4 v)
+{
+#if defined(ENGINE_SIMD_SSE4)
+	return _mm_round_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+#elif defined(ENGINE_SIMD_SSE)
+	return _mm_cvtepi32_ps(_mm_cvtps_epi32(v));
+#elif defined(ENGINE_SIMD_NEON)
+	return vrndnq_f32(v);
+#else
+	return Float4{ { nearbyintf(v.m_lanes[0]), nearbyintf(v.m_lanes[1]), nearbyintf(v.m_lanes[2]), nearbyintf(v.m_lanes[3]) } };
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Rounds toward negative infinity, matching floorf. The SSE2 path goes through int32, so it only holds for |v| < 2^31.
+inline Float4 Float4Floor(Float4 v)
+{
+#if defined(ENGINE_SIMD_SSE4)
+	return _mm_floor_ps(v);
+#elif defined(ENGINE_SIMD_SSE)
+	__m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+	return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, v), _mm_set1_ps(1.f)));
+#elif defined(ENGINE_SIMD_NEON)
+	return vrndmq_f32(v);
+#else
+	return Float4{ { floorf(v.m_lanes[0]), floorf(v.m_lanes[1]), floorf(v.m_lanes[2]), floorf(v.m_lanes[3]) } };
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// r = { v1[a], v1[b], v2[c], v2[d] }
+template<int a, int b, int c, int d>
+inline Float4 Float4Shuffle(Float4 v1, Float4 v2)
+{
+	static_assert(a >= 0 && a < 4 && b >= 0 && b < 4 && c >= 0 && c < 4 && d >= 0 && d < 4, "Float4 lane out of range");
+
+#if defined(ENGINE_SIMD_SSE)
+	return _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(d, c, b, a));
+#elif defined(ENGINE_SIMD_NEON)
+	float32x4_t r = vdupq_n_f32(vgetq_lane_f32(v1, a));
+	r = vsetq_lane_f32(vgetq_lane_f32(v1, b), r, 1);
+	r = vsetq_lane_f32(vgetq_lane_f32(v2, c), r, 2);
+	r = vsetq_lane_f32(vgetq_lane_f32(v2, d), r, 3);
+	return r;
+#else
+	return Float4{ { v1.m_lanes[a], v1.m_lanes[b], v2.m_lanes[c], v2.m_lanes[d] } };
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// r = { v[a], v[b], v[c], v[d] }
+template<int a, int b, int c, int d>
+inline Float4 Float4Swizzle(Float4 v)
+{
+	return Float4Shuffle<a, b, c, d>(v, v);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+template<int lane>
+inline Float4 Float4SplatLane(Float4 v)
+{
+#if defined(ENGINE_SIMD_NEON)
+	return vdupq_laneq_f32(v, lane);
+#else
+	return Float4Shuffle<lane, lane, lane, lane>(v, v);
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Treats r0..r3 as the rows of a 4x4 matrix and transposes it in place.
+inline void Float4Transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3)
+{
+#if defined(ENGINE_SIMD_SSE)
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+#elif defined(ENGINE_SIMD_NEON)
+	float32x4x2_t t01 = vtrnq_f32(r0, r1);
+	float32x4x2_t t23 = vtrnq_f32(r2, r3);
+	r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+	r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+	r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+	r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+#else
+	Float4 t0 = r0;
+	Float4 t1 = r1;
+	Float4 t2 = r2;
+	Float4 t3 = r3;
+	r0 = Float4{ { t0.m_lanes[0], t1.m_lanes[0], t2.m_lanes[0], t3.m_lanes[0] } };
+	r1 = Float4{ { t0.m_lanes[1], t1.m_lanes[1], t2.m_lanes[1], t3.m_lanes[1] } };
+	r2 = Float4{ { t0.m_lanes[2], t1.m_lanes[2], t2.m_lanes[2], t3.m_lanes[2] } };
+	r3 = Float4{ { t0.m_lanes[3], t1.m_lanes[3], t2.m_lanes[3], t3.m_lanes[3] } };
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Masks. Comparisons return a Float4 whose lanes are all ones (true) or all zeros (false), ready for Float4Select and
+// the bitwise ops. Float4GetMaskBits packs lane i into bit i.
+//------------------------------------------------------------------------------------------------------------------
+#if !defined(ENGINE_SIMD_FLOAT4)
+inline float Float4MaskLane(bool isSet)
+{
+	unsigned int bits = isSet ? 0xFFFFFFFFu : 0u;
+	float lane;
+	memcpy(&lane, &bits, sizeof(lane));
+	return lane;
+}
+
+inline unsigned int Float4LaneBits(float lane)
+{
+	unsigned int bits;
+	memcpy(&bits, &lane, sizeof(bits));
+	return bits;
+}
+
+inline float Float4BitsLane(unsigned int bits)
+{
+	float lane;
+	memcpy(&lane, &bits, sizeof(lane));
+	return lane;
+}
+#endif
+
+#if defined(ENGINE_SIMD_SSE)
+	#define ENGINE_FLOAT4_COMPARE_OP(name, sseOp, neonOp, scalarOp)		inline Float4 name(Float4 a, Float4 b) { return sseOp(a, b); }
+	#define ENGINE_FLOAT4_BITWISE_OP(name, sseOp, neonOp, scalarOp)		inline Float4 name(Float4 a, Float4 b) { return sseOp(a, b); }
+#elif defined(ENGINE_SIMD_NEON)
+	#define ENGINE_FLOAT4_COMPARE_OP(name, sseOp, neonOp, scalarOp)		inline Float4 name(Float4 a, Float4 b) { return vreinterpretq_f32_u32(neonOp(a, b)); }
+	#define ENGINE_FLOAT4_BITWISE_OP(name, sseOp, neonOp, scalarOp)		inline Float4 name(Float4 a, Float4 b) { return vreinterpretq_f32_u32(neonOp(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+#else
+	#define ENGINE_FLOAT4_COMPARE_OP(name, sseOp, neonOp, scalarOp)		inline Float4 name(Float4 a, Float4 b) { Float4 r; for(int i = 0; i < 4; ++i) { float x = a.m_lanes[i]; float y = b.m_lanes[i]; r.m_lanes[i] = Float4MaskLane(scalarOp); } return r; }
+	#define ENGINE_FLOAT4_BITWISE_OP(name, sseOp, neonOp, scalarOp)		inline Float4 name(Float4 a, Float4 b) { Float4 r; for(int i = 0; i < 4; ++i) { unsigned int x = Float4LaneBits(a.m_lanes[i]); unsigned int y = Float4LaneBits(b.m_lanes[i]); r.m_lanes[i] = Float4BitsLane(scalarOp); } return r; }
+#endif
+
+ENGINE_FLOAT4_COMPARE_OP(Float4CmpLt, _mm_cmplt_ps, vcltq_f32, x < y)
+ENGINE_FLOAT4_COMPARE_OP(Float4CmpLe, _mm_cmple_ps, vcleq_f32, x <= y)
+ENGINE_FLOAT4_COMPARE_OP(Float4CmpGt, _mm_cmpgt_ps, vcgtq_f32, x > y)
+ENGINE_FLOAT4_COMPARE_OP(Float4CmpGe, _mm_cmpge_ps, vcgeq_f32, x >= y)
+ENGINE_FLOAT4_COMPARE_OP(Float4CmpEq, _mm_cmpeq_ps, vceqq_f32, x == y)
+
+ENGINE_FLOAT4_BITWISE_OP(Float4And, _mm_and_ps, vandq_u32, x & y)
+ENGINE_FLOAT4_BITWISE_OP(Float4Or, _mm_or_ps, vorrq_u32, x | y)
+ENGINE_FLOAT4_BITWISE_OP(Float4Xor, _mm_xor_ps, veorq_u32, x ^ y)
+
+#undef ENGINE_FLOAT4_COMPARE_OP
+#undef ENGINE_FLOAT4_BITWISE_OP
+
+//------------------------------------------------------------------------------------------------------------------
+// a & ~b
+inline Float4 Float4AndNot(Float4 a, Float4 b)
+{
+#if defined(ENGINE_SIMD_SSE)
+	return _mm_andnot_ps(b, a);
+#elif defined(ENGINE_SIMD_NEON)
+	return vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+#else
+	Float4 r;
+	for(int i = 0; i < 4; ++i)
+	{
+		r.m_lanes[i] = Float4BitsLane(Float4LaneBits(a.m_lanes[i]) & ~Float4LaneBits(b.m_lanes[i]));
+	}
+	return r;
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// mask ? ifTrue : ifFalse, per lane
+inline Float4 Float4Select(Float4 mask, Float4 ifTrue, Float4 ifFalse)
+{
+#if defined(ENGINE_SIMD_SSE4)
+	return _mm_blendv_ps(ifFalse, ifTrue, mask);
+#elif defined(ENGINE_SIMD_SSE)
+	return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+#elif defined(ENGINE_SIMD_NEON)
+	return vbslq_f32(vreinterpretq_u32_f32(mask), ifTrue, ifFalse);
+#else
+	return Float4Or(Float4And(mask, ifTrue), Float4AndNot(ifFalse, mask));
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------
+inline int Float4GetMaskBits(Float4 mask)
+{
+#if defined(ENGINE_SIMD_SSE)
+	return _mm_movemask_ps(mask);
+#elif defined(ENGINE_SIMD_NEON)
+	uint32x4_t bits = vshrq_n_u32(vreinterpretq_u32_f32(mask), 31);
+	return static_cast<int>(vgetq_lane_u32(bits, 0) | (vgetq_lane_u32(bits, 1) << 1) | (vgetq_lane_u32(bits, 2) << 2) | (vgetq_lane_u32(bits, 3) << 3));
+#else
+	int bits = 0;
+	for(int i = 0; i < 4; ++i)
+	{
+		bits |= (Float4LaneBits(mask.m_lanes[i]) >> 31) << i;
+	}
+	return bits;
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Float8: eight packed floats. A single __m256 on AVX2 builds, otherwise a pair of Float4 halves so code written
+// against it runs everywhere, just without the extra width.
+//------------------------------------------------------------------------------------------------------------------
+#if defined(ENGINE_SIMD_AVX2)
+typedef __m256 Float8;
+
+inline Float8 Float8LoadUnaligned(float const* values)					{ return _mm256_loadu_ps(values); }
+inline void Float8StoreUnaligned(float* out_values, Float8 v)			{ _mm256_storeu_ps(out_values, v); }
+inline Float8 Float8Splat(float value)									{ return _mm256_set1_ps(value); }
+inline Float8 Float8Zero()												{ return _mm256_setzero_ps(); }
+inline Float8 Float8Add(Float8 a, Float8 b)								{ return _mm256_add_ps(a, b); }
+inline Float8 Float8Sub(Float8 a, Float8 b)								{ return _mm256_sub_ps(a, b); }
+inline Float8 Float8Mul(Float8 a, Float8 b)								{ return _mm256_mul_ps(a, b); }
+inline Float8 Float8Div(Float8 a, Float8 b)								{ return _mm256_div_ps(a, b); }
+inline Float8 Float8Min(Float8 a, Float8 b)								{ return _mm256_min_ps(a, b); }
+inline Float8 Float8Max(Float8 a, Float8 b)								{ return _mm256_max_ps(a, b); }
+inline Float8 Float8MulAdd(Float8 a, Float8 b, Float8 c)				{ return _mm256_fmadd_ps(a, b, c); }
+inline Float8 Float8Sqrt(Float8 v)										{ return _mm256_sqrt_ps(v); }
+inline Float8 Float8Round(Float8 v)										{ return _mm256_round_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+inline Float8 Float8Floor(Float8 v)										{ return _mm256_floor_ps(v); }
+inline Float8 Float8CmpLt(Float8 a, Float8 b)							{ return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+inline Float8 Float8CmpLe(Float8 a, Float8 b)							{ return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+inline Float8 Float8CmpGt(Float8 a, Float8 b)							{ return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+inline Float8 Float8CmpGe(Float8 a, Float8 b)							{ return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+inline Float8 Float8CmpEq(Float8 a, Float8 b)							{ return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+inline Float8 Float8And(Float8 a, Float8 b)								{ return _mm256_and_ps(a, b); }
+inline Float8 Float8Or(Float8 a, Float8 b)								{ return _mm256_or_ps(a, b); }
+inline Float8 Float8Xor(Float8 a, Float8 b)								{ return _mm256_xor_ps(a, b); }
+inline Float8 Float8AndNot(Float8 a, Float8 b)							{ return _mm256_andnot_ps(b, a); }
+inline Float8 Float8Select(Float8 mask, Float8 ifTrue, Float8 ifFalse)	{ return _mm256_blendv_ps(ifFalse, ifTrue, mask); }
+inline int Float8GetMaskBits(Float8 mask)								{ return _mm256_movemask_ps(mask); }
+#else
+struct Float8
+{
+	Float4 m_low;
+	Float4 m_high;
+};
+
+inline Float8 Float8LoadUnaligned(float const* values)					{ return Float8{ Float4LoadUnaligned(values), Float4LoadUnaligned(values + 4) }; }
+inline void Float8StoreUnaligned(float* out_values, Float8 v)			{ Float4StoreUnaligned(out_values, v.m_low); Float4StoreUnaligned(out_values + 4, v.m_high); }
+inline Float8 Float8Splat(float value)									{ return Float8{ Float4Splat(value), Float4Splat(value) }; }
+inline Float8 Float8Zero()												{ return Float8{ Float4Zero(), Float4Zero() }; }
+inline Float8 Float8Sqrt(Float8 v)										{ return Float8{ Float4Sqrt(v.m_low), Float4Sqrt(v.m_high) }; }
+inline Float8 Float8Round(Float8 v)										{ return Float8{ Float4Round(v.m_low), Float4Round(v.m_high) }; }
+inline Float8 Float8Floor(Float8 v)										{ return Float8{ Float4Floor(v.m_low), Float4Floor(v.m_high) }; }
+inline Float8 Float8MulAdd(Float8 a, Float8 b, Float8 c)				{ return Float8{ Float4MulAdd(a.m_low, b.m_low, c.m_low), Float4MulAdd(a.m_high, b.m_high, c.m_high) }; }
+inline Float8 Float8Select(Float8 mask, Float8 ifTrue, Float8 ifFalse)	{ return Float8{ Float4Select(mask.m_low, ifTrue.m_low, ifFalse.m_low), Float4Select(mask.m_high, ifTrue.m_high, ifFalse.m_high) }; }
+inline int Float8GetMaskBits(Float8 mask)								{ return Float4GetMaskBits(mask.m_low) | (Float4GetMaskBits(mask.m_high) << 4); }
+
+#define ENGINE_FLOAT8_SPLIT_OP(name, float4Op)		inline Float8 name(Float8 a, Float8 b) { return Float8{ float4Op(a.m_low, b.m_low), float4Op(a.m_high, b.m_high) }; }
+
+ENGINE_FLOAT8_SPLIT_OP(Float8Add, Float4Add)
+ENGINE_FLOAT8_SPLIT_OP(Float8Sub, Float4Sub)
+ENGINE_FLOAT8_SPLIT_OP(Float8Mul, Float4Mul)
+ENGINE_FLOAT8_SPLIT_OP(Float8Div, Float4Div)
+ENGINE_FLOAT8_SPLIT_OP(Float8Min, Float4Min)
+ENGINE_FLOAT8_SPLIT_OP(Float8Max, Float4Max)
+ENGINE_FLOAT8_SPLIT_OP(Float8CmpLt, Float4CmpLt)
+ENGINE_FLOAT8_SPLIT_OP(Float8CmpLe, Float4CmpLe)
+ENGINE_FLOAT8_SPLIT_OP(Float8CmpGt, Float4CmpGt)
+ENGINE_FLOAT8_SPLIT_OP(Float8CmpGe, Float4CmpGe)
+ENGINE_FLOAT8_SPLIT_OP(Float8CmpEq, Float4CmpEq)
+ENGINE_FLOAT8_SPLIT_OP(Float8And, Float4And)
+ENGINE_FLOAT8_SPLIT_OP(Float8Or, Float4Or)
+ENGINE_FLOAT8_SPLIT_OP(Float8Xor, Float4Xor)
+ENGINE_FLOAT8_SPLIT_OP(Float8AndNot, Float4AndNot)
+
+#undef ENGINE_FLOAT8_SPLIT_OP
+#endif
+
+//------------------------------------------------------------------------------------------------------------------
+// UInt4 / UInt8: packed 32-bit unsigned integers for hashing (random numbers, noise lattices). Arithmetic wraps the
+// same way unsigned int does, so a kernel written against these gives the same bits as its scalar version.
+// UInt4Mul keeps the low 32 bits of each product; SSE2 builds without SSE4.1 emulate it with two 64-bit multiplies.
+// UInt4ToFloat4 converts as signed, so only pass values below 2^31.
+//------------------------------------------------------------------------------------------------------------------
+#if defined(ENGINE_SIMD_SSE)
+typedef __m128i UInt4;
+
+inline UInt4 UInt4LoadUnaligned(unsigned int const* values)				{ return _mm_loadu_si128(reinterpret_cast<__m128i const*>(values)); }
+inline void UInt4StoreUnaligned(unsigned int* out_values, UInt4 v)		{ _mm_storeu_si128(reinterpret_cast<__m128i*>(out_values), v); }
+inline UInt4 UInt4Splat(unsigned int value)								{ return _mm_set1_epi32(static_cast<int>(value)); }
+inline UInt4 UInt4Set(unsigned int x, unsigned int y, unsigned int z, unsigned int w)	{ return _mm_setr_epi32(static_cast<int>(x), static_cast<int>(y), static_cast<int>(z), static_cast<int>(w)); }
+inline UInt4 UInt4Add(UInt4 a, UInt4 b)									{ return _mm_add_epi32(a, b); }
+inline UInt4 UInt4Sub(UInt4 a, UInt4 b)									{ return _mm_sub_epi32(a, b); }
+inline UInt4 UInt4Xor(UInt4 a, UInt4 b)									{ return _mm_xor_si128(a, b); }
+inline UInt4 UInt4And(UInt4 a, UInt4 b)									{ return _mm_and_si128(a, b); }
+inline UInt4 UInt4Or(UInt4 a, UInt4 b)									{ return _mm_or_si128(a, b); }
+template<int BITS> inline UInt4 UInt4ShiftRight(UInt4 v)				{ return _mm_srli_epi32(v, BITS); }
+template<int BITS> inline UInt4 UInt4ShiftLeft(UInt4 v)					{ return _mm_slli_epi32(v, BITS); }
+inline Float4 UInt4ToFloat4(UInt4 v)									{ return _mm_cvtepi32_ps(v); }
+
+inline UInt4 UInt4Mul(UInt4 a, UInt4 b)
+{
+#if defined(ENGINE_SIMD_SSE4)
+	return _mm_mullo_epi32(a, b);
+#else
+	__m128i evenProducts = _mm_mul_epu32(a, b);
+	__m128i oddProducts = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(evenProducts, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(oddProducts, _MM_SHUFFLE(0, 0, 2, 0)));
+#endif
+}
+#elif defined(ENGINE_SIMD_NEON)
+typedef uint32x4_t UInt4;
+
+inline UInt4 UInt4LoadUnaligned(unsigned int const* values)				{ return vld1q_u32(values); }
+inline void UInt4StoreUnaligned(unsigned int* out_values, UInt4 v)		{ vst1q_u32(out_values, v); }
+inline UInt4 UInt4Splat(unsigned int value)								{ return vdupq_n_u32(value); }
+inline UInt4 UInt4Set(unsigned int x, unsigned int y, unsigned int z, unsigned int w)	{ unsigned int values[4] = { x, y, z, w }; return vld1q_u32(values); }
+inline UInt4 UInt4Add(UInt4 a, UInt4 b)									{ return vaddq_u32(a, b); }
+inline UInt4 UInt4Sub(UInt4 a, UInt4 b)									{ return vsubq_u32(a, b); }
+inline UInt4 UInt4Mul(UInt4 a, UInt4 b)									{ return vmulq_u32(a, b); }
+inline UInt4 UInt4Xor(UInt4 a, UInt4 b)									{ return veorq_u32(a, b); }
+inline UInt4 UInt4And(UInt4 a, UInt4 b)									{ return vandq_u32(a, b); }
+inline UInt4 UInt4Or(UInt4 a, UInt4 b)									{ return vorrq_u32(a, b); }
+template<int BITS> inline UInt4 UInt4ShiftRight(UInt4 v)				{ return vshrq_n_u32(v, BITS); }
+template<int BITS> inline UInt4 UInt4ShiftLeft(UInt4 v)					{ return vshlq_n_u32(v, BITS); }
+inline Float4 UInt4ToFloat4(UInt4 v)									{ return vcvtq_f32_s32(vreinterpretq_s32_u32(v)); }
+#else
+struct alignas(16) UInt4
+{
+	unsigned int m_lanes[4];
+};
+
+#define ENGINE_UINT4_LANE_OP(name, expression)		inline UInt4 name(UInt4 a, UInt4 b) { UInt4 r; for(int i = 0; i < 4; ++i) { unsigned int x = a.m_lanes[i]; unsigned int y = b.m_lanes[i]; r.m_lanes[i] = expression; } return r; }
+
+ENGINE_UINT4_LANE_OP(UInt4Add, x + y)
+ENGINE_UINT4_LANE_OP(UInt4Sub, x - y)
+ENGINE_UINT4_LANE_OP(UInt4Mul, x * y)
+ENGINE_UINT4_LANE_OP(UInt4Xor, x ^ y)
+ENGINE_UINT4_LANE_OP(UInt4And, x & y)
+ENGINE_UINT4_LANE_OP(UInt4Or, x | y)
+
+#undef ENGINE_UINT4_LANE_OP
+
+inline UInt4 UInt4LoadUnaligned(unsigned int const* values)				{ return UInt4{ { values[0], values[1], values[2], values[3] } }; }
+inline void UInt4StoreUnaligned(unsigned int* out_values, UInt4 v)		{ memcpy(out_values, v.m_lanes, sizeof(v.m_lanes)); }
+inline UInt4 UInt4Splat(unsigned int value)								{ return UInt4{ { value, value, value, value } }; }
+inline UInt4 UInt4Set(unsigned int x, unsigned int y, unsigned int z, unsigned int w)	{ return UInt4{ { x, y, z, w } }; }
+template<int BITS> inline UInt4 UInt4ShiftRight(UInt4 v)				{ return UInt4{ { v.m_lanes[0] >> BITS, v.m_lanes[1] >> BITS, v.m_lanes[2] >> BITS, v.m_lanes[3] >> BITS } }; }
+template<int BITS> inline UInt4 UInt4ShiftLeft(UInt4 v)					{ return UInt4{ { v.m_lanes[0] << BITS, v.m_lanes[1] << BITS, v.m_lanes[2] << BITS, v.m_lanes[3] << BITS } }; }
+inline Float4 UInt4ToFloat4(UInt4 v)									{ return Float4Set(static_cast<float>(static_cast<int>(v.m_lanes[0])), static_cast<float>(static_cast<int>(v.m_lanes[1])), static_cast<float>(static_cast<int>(v.m_lanes[2])), static_cast<float>(static_cast<int>(v.m_lanes[3]))); }
+#endif
+
+//------------------------------------------------------------------------------------------------------------------
+#if defined(ENGINE_SIMD_AVX2)
+typedef __m256i UInt8;
+
+inline UInt8 UInt8LoadUnaligned(unsigned int const* values)				{ return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(values)); }
+inline void UInt8StoreUnaligned(unsigned int* out_values, UInt8 v)		{ _mm256_storeu_si256(reinterpret_cast<__m256i*>(out_values), v); }
+inline UInt8 UInt8Splat(unsigned int value)								{ return _mm256_set1_epi32(static_cast<int>(value)); }
+inline UInt8 UInt8Add(UInt8 a, UInt8 b)									{ return _mm256_add_epi32(a, b); }
+inline UInt8 UInt8Sub(UInt8 a, UInt8 b)									{ return _mm256_sub_epi32(a, b); }
+inline UInt8 UInt8Mul(UInt8 a, UInt8 b)									{ return _mm256_mullo_epi32(a, b); }
+inline UInt8 UInt8Xor(UInt8 a, UInt8 b)									{ return _mm256_xor_si256(a, b); }
+inline UInt8 UInt8And(UInt8 a, UInt8 b)									{ return _mm256_and_si256(a, b); }
+inline UInt8 UInt8Or(UInt8 a, UInt8 b)									{ return _mm256_or_si256(a, b); }
+template<int BITS> inline UInt8 UInt8ShiftRight(UInt8 v)				{ return _mm256_srli_epi32(v, BITS); }
+template<int BITS> inline UInt8 UInt8ShiftLeft(UInt8 v)					{ return _mm256_slli_epi32(v, BITS); }
+inline Float8 UInt8ToFloat8(UInt8 v)									{ return _mm256_cvtepi32_ps(v); }
+#else
+struct UInt8
+{
+	UInt4 m_low;
+	UInt4 m_high;
+};
+
+#define ENGINE_UINT8_SPLIT_OP(name, uint4Op)		inline UInt8 name(UInt8 a, UInt8 b) { return UInt8{ uint4Op(a.m_low, b.m_low), uint4Op(a.m_high, b.m_high) }; }
+
+ENGINE_UINT8_SPLIT_OP(UInt8Add, UInt4Add)
+ENGINE_UINT8_SPLIT_OP(UInt8Sub, UInt4Sub)
+ENGINE_UINT8_SPLIT_OP(UInt8Mul, UInt4Mul)
+ENGINE_UINT8_SPLIT_OP(UInt8Xor, UInt4Xor)
+ENGINE_UINT8_SPLIT_OP(UInt8And, UInt4And)
+ENGINE_UINT8_SPLIT_OP(UInt8Or, UInt4Or)
+
+#undef ENGINE_UINT8_SPLIT_OP
+
+inline UInt8 UInt8LoadUnaligned(unsigned int const* values)				{ return UInt8{ UInt4LoadUnaligned(values), UInt4LoadUnaligned(values + 4) }; }
+inline void UInt8StoreUnaligned(unsigned int* out_values, UInt8 v)		{ UInt4StoreUnaligned(out_values, v.m_low); UInt4StoreUnaligned(out_values + 4, v.m_high); }
+inline UInt8 UInt8Splat(unsigned int value)								{ return UInt8{ UInt4Splat(value), UInt4Splat(value) }; }
+template<int BITS> inline UInt8 UInt8ShiftRight(UInt8 v)				{ return UInt8{ UInt4ShiftRight<BITS>(v.m_low), UInt4ShiftRight<BITS>(v.m_high) }; }
+template<int BITS> inline UInt8 UInt8ShiftLeft(UInt8 v)					{ return UInt8{ UInt4ShiftLeft<BITS>(v.m_low), UInt4ShiftLeft<BITS>(v.m_high) }; }
+inline Float8 UInt8ToFloat8(UInt8 v)									{ return Float8{ UInt4ToFloat4(v.m_low), UInt4ToFloat4(v.m_high) }; }
+#endif
+
+//------------------------------------------------------------------------------------------------------------------
+// Conversions for hashing lattice coordinates. TruncateToUInt converts toward zero as a signed int, the same bits as
+// (unsigned int)(int)x. ToFloatViaDouble gives exactly (float)(scale * (double)v) in each lane, which is how
+// RawNoise maps hashes onto [0, 1]; x86 has no unsigned conversion before AVX-512, so the top bit is flipped, the
+// lane converted as signed and 2^31 added back, all exact in double.
+//------------------------------------------------------------------------------------------------------------------
+inline UInt4 Float4TruncateToUInt4(Float4 v)
+{
+#if defined(ENGINE_SIMD_SSE)
+	return _mm_cvttps_epi32(v);
+#elif defined(ENGINE_SIMD_NEON)
+	return vreinterpretq_u32_s32(vcvtq_s32_f32(v));
+#else
+	UInt4 result;
+	for(int lane = 0; lane < 4; ++lane)
+	{
+		result.m_lanes[lane] = static_cast<unsigned int>(static_cast<int>(v.m_lanes[lane]));
+	}
+	return result;
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------
+inline Float4 UInt4ToFloat4ViaDouble(UInt4 v, double scale)
+{
+#if defined(ENGINE_SIMD_SSE)
+	__m128i biased = _mm_xor_si128(v, _mm_set1_epi32(static_cast<int>(0x80000000u)));
+	__m128d offset = _mm_set1_pd(2147483648.0);
+	__m128d scales = _mm_set1_pd(scale);
+	__m128d low = _mm_mul_pd(_mm_add_pd(_mm_cvtepi32_pd(biased), offset), scales);
+	__m128d high = _mm_mul_pd(_mm_add_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(biased, _MM_SHUFFLE(3, 2, 3, 2))), offset), scales);
+	return _mm_movelh_ps(_mm_cvtpd_ps(low), _mm_cvtpd_ps(high));
+#elif defined(ENGINE_SIMD_NEON)
+	float64x2_t scales = vdupq_n_f64(scale);
+	float64x2_t low = vmulq_f64(vcvtq_f64_u64(vmovl_u32(vget_low_u32(v))), scales);
+	float64x2_t high = vmulq_f64(vcvtq_f64_u64(vmovl_u32(vget_high_u32(v))), scales);
+	return vcombine_f32(vcvt_f32_f64(low), vcvt_f32_f64(high));
+#else
+	Float4 result;
+	for(int lane = 0; lane < 4; ++lane)
+	{
+		result.m_lanes[lane] = static_cast<float>(scale * static_cast<double>(v.m_lanes[lane]));
+	}
+	return result;
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------
+#if defined(ENGINE_SIMD_AVX2)
+inline UInt8 Float8TruncateToUInt8(Float8 v)
+{
+	return _mm256_cvttps_epi32(v);
+}
+
+inline Float8 UInt8ToFloat8ViaDouble(UInt8 v, double scale)
+{
+	__m256i biased = _mm256_xor_si256(v, _mm256_set1_epi32(static_cast<int>(0x80000000u)));
+	__m256d offset = _mm256_set1_pd(2147483648.0);
+	__m256d scales = _mm256_set1_pd(scale);
+	__m256d low = _mm256_mul_pd(_mm256_add_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(biased)), offset), scales);
+	__m256d high = _mm256_mul_pd(_mm256_add_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(biased, 1)), offset), scales);
+	return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(low)), _mm256_cvtpd_ps(high), 1);
+}
+#else
+inline UInt8 Float8TruncateToUInt8(Float8 v)							{ return UInt8{ Float4TruncateToUInt4(v.m_low), Float4TruncateToUInt4(v.m_high) }; }
+inline Float8 UInt8ToFloat8ViaDouble(UInt8 v, double scale)				{ return Float8{ UInt4ToFloat4ViaDouble(v.m_low, scale), UInt4ToFloat4ViaDouble(v.m_high, scale) }; }
+#endif
+
+//------------------------------------------------------------------------------------------------------------------
+// Lane-width adapters so a kernel can be written once as a template and instantiated 8, 4 or 1 lanes wide.
+// Float1Ops covers the arithmetic subset only and is meant for scalar remainder loops.
+//------------------------------------------------------------------------------------------------------------------
+struct Float4Ops
+{
+	typedef Float4 Type;
+	static constexpr int WIDTH = 4;
+
+	static Type Load(float const* values)							{ return Float4LoadUnaligned(values); }
+	static void Store(float* out_values, Type v)					{ Float4StoreUnaligned(out_values, v); }
+	static Type Splat(float value)									{ return Float4Splat(value); }
+	static Type Zero()												{ return Float4Zero(); }
+	static Type Add(Type a, Type b)									{ return Float4Add(a, b); }
+	static Type Sub(Type a, Type b)									{ return Float4Sub(a, b); }
+	static Type Mul(Type a, Type b)									{ return Float4Mul(a, b); }
+	static Type Div(Type a, Type b)									{ return Float4Div(a, b); }
+	static Type Min(Type a, Type b)									{ return Float4Min(a, b); }
+	static Type Max(Type a, Type b)									{ return Float4Max(a, b); }
+	static Type MulAdd(Type a, Type b, Type c)						{ return Float4MulAdd(a, b, c); }
+	static Type Sqrt(Type v)										{ return Float4Sqrt(v); }
+	static Type Round(Type v)										{ return Float4Round(v); }
+	static Type Floor(Type v)										{ return Float4Floor(v); }
+	static Type CmpLt(Type a, Type b)								{ return Float4CmpLt(a, b); }
+	static Type CmpLe(Type a, Type b)								{ return Float4CmpLe(a, b); }
+	static Type CmpGt(Type a, Type b)								{ return Float4CmpGt(a, b); }
+	static Type CmpGe(Type a, Type b)								{ return Float4CmpGe(a, b); }
+	static Type CmpEq(Type a, Type b)								{ return Float4CmpEq(a, b); }
+	static Type And(Type a, Type b)									{ return Float4And(a, b); }
+	static Type Or(Type a, Type b)									{ return Float4Or(a, b); }
+	static Type AndNot(Type a, Type b)								{ return Float4AndNot(a, b); }
+	static Type Select(Type mask, Type ifTrue, Type ifFalse)		{ return Float4Select(mask, ifTrue, ifFalse); }
+	static int	GetMaskBits(Type mask)								{ return Float4GetMaskBits(mask); }
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct Float8Ops
+{
+	typedef Float8 Type;
+	static constexpr int WIDTH = 8;
+
+	static Type Load(float const* values)							{ return Float8LoadUnaligned(values); }
+	static void Store(float* out_values, Type v)					{ Float8StoreUnaligned(out_values, v); }
+	static Type Splat(float value)									{ return Float8Splat(value); }
+	static Type Zero()												{ return Float8Zero(); }
+	static Type Add(Type a, Type b)									{ return Float8Add(a, b); }
+	static Type Sub(Type a, Type b)									{ return Float8Sub(a, b); }
+	static Type Mul(Type a, Type b)									{ return Float8Mul(a, b); }
+	static Type Div(Type a, Type b)									{ return Float8Div(a, b); }
+	static Type Min(Type a, Type b)									{ return Float8Min(a, b); }
+	static Type Max(Type a, Type b)									{ return Float8Max(a, b); }
+	static Type MulAdd(Type a, Type b, Type c)						{ return Float8MulAdd(a, b, c); }
+	static Type Sqrt(Type v)										{ return Float8Sqrt(v); }
+	static Type Round(Type v)										{ return Float8Round(v); }
+	static Type Floor(Type v)										{ return Float8Floor(v); }
+	static Type CmpLt(Type a, Type b)								{ return Float8CmpLt(a, b); }
+	static Type CmpLe(Type a, Type b)								{ return Float8CmpLe(a, b); }
+	static Type CmpGt(Type a, Type b)								{ return Float8CmpGt(a, b); }
+	static Type CmpGe(Type a, Type b)								{ return Float8CmpGe(a, b); }
+	static Type CmpEq(Type a, Type b)								{ return Float8CmpEq(a, b); }
+	static Type And(Type a, Type b)									{ return Float8And(a, b); }
+	static Type Or(Type a, Type b)									{ return Float8Or(a, b); }
+	static Type AndNot(Type a, Type b)								{ return Float8AndNot(a, b); }
+	static Type Select(Type mask, Type ifTrue, Type ifFalse)		{ return Float8Select(mask, ifTrue, ifFalse); }
+	static int	GetMaskBits(Type mask)								{ return Float8GetMaskBits(mask); }
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct Float1Ops
+{
+	typedef float Type;
+	static constexpr int WIDTH = 1;
+
+	static Type Load(float const* values)							{ return *values; }
+	static void Store(float* out_values, Type v)					{ *out_values = v; }
+	static Type Splat(float value)									{ return value; }
+	static Type Zero()												{ return 0.f; }
+	static Type Add(Type a, Type b)									{ return a + b; }
+	static Type Sub(Type a, Type b)									{ return a - b; }
+	static Type Mul(Type a, Type b)									{ return a * b; }
+	static Type Div(Type a, Type b)									{ return a / b; }
+	static Type Min(Type a, Type b)									{ return a < b ? a : b; }
+	static Type Max(Type a, Type b)									{ return a > b ? a : b; }
+	static Type MulAdd(Type a, Type b, Type c)						{ return a * b + c; }
+	static Type Sqrt(Type v)										{ return sqrtf(v); }
+	static Type Round(Type v)										{ return nearbyintf(v); }
+	static Type Floor(Type v)										{ return floorf(v); }
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Integer counterparts of the adapters above; FloatOps is the float adapter of the same width. Sequence(first) is
+// first, first + 1, ... across the lanes.
+// The shifts are templates, so kernels call them as Ops::template ShiftRight<9>(v).
+//------------------------------------------------------------------------------------------------------------------
+struct UInt4Ops
+{
+	typedef UInt4 Type;
+	typedef Float4Ops FloatOps;
+	static constexpr int WIDTH = 4;
+
+	static Type Load(unsigned int const* values)					{ return UInt4LoadUnaligned(values); }
+	static void Store(unsigned int* out_values, Type v)				{ UInt4StoreUnaligned(out_values, v); }
+	static Type Splat(unsigned int value)							{ return UInt4Splat(value); }
+	static Type Sequence(unsigned int first)						{ return UInt4Add(UInt4Splat(first), UInt4Set(0, 1, 2, 3)); }
+	static Type Add(Type a, Type b)									{ return UInt4Add(a, b); }
+	static Type Sub(Type a, Type b)									{ return UInt4Sub(a, b); }
+	static Type Mul(Type a, Type b)									{ return UInt4Mul(a, b); }
+	static Type Xor(Type a, Type b)									{ return UInt4Xor(a, b); }
+	static Type And(Type a, Type b)									{ return UInt4And(a, b); }
+	static Type Or(Type a, Type b)									{ return UInt4Or(a, b); }
+	template<int BITS> static Type ShiftRight(Type v)				{ return UInt4ShiftRight<BITS>(v); }
+	template<int BITS> static Type ShiftLeft(Type v)				{ return UInt4ShiftLeft<BITS>(v); }
+	static FloatOps::Type ToFloat(Type v)							{ return UInt4ToFloat4(v); }
+	static FloatOps::Type ToFloatViaDouble(Type v, double scale)	{ return UInt4ToFloat4ViaDouble(v, scale); }
+	static Type FromFloatTruncated(FloatOps::Type v)				{ return Float4TruncateToUInt4(v); }
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct UInt8Ops
+{
+	typedef UInt8 Type;
+	typedef Float8Ops FloatOps;
+	static constexpr int WIDTH = 8;
+
+	static Type Load(unsigned int const* values)					{ return UInt8LoadUnaligned(values); }
+	static void Store(unsigned int* out_values, Type v)				{ UInt8StoreUnaligned(out_values, v); }
+	static Type Splat(unsigned int value)							{ return UInt8Splat(value); }
+	static Type Sequence(unsigned int first)
+	{
+		unsigned int values[8] = { first, first + 1, first + 2, first + 3, first + 4, first + 5, first + 6, first + 7 };
+		return UInt8LoadUnaligned(values);
+	}
+	static Type Add(Type a, Type b)									{ return UInt8Add(a, b); }
+	static Type Sub(Type a, Type b)									{ return UInt8Sub(a, b); }
+	static Type Mul(Type a, Type b)									{ return UInt8Mul(a, b); }
+	static Type Xor(Type a, Type b)									{ return UInt8Xor(a, b); }
+	static Type And(Type a, Type b)									{ return UInt8And(a, b); }
+	static Type Or(Type a, Type b)									{ return UInt8Or(a, b); }
+	template<int BITS> static Type ShiftRight(Type v)				{ return UInt8ShiftRight<BITS>(v); }
+	template<int BITS> static Type ShiftLeft(Type v)				{ return UInt8ShiftLeft<BITS>(v); }
+	static FloatOps::Type ToFloat(Type v)							{ return UInt8ToFloat8(v); }
+	static FloatOps::Type ToFloatViaDouble(Type v, double scale)	{ return UInt8ToFloat8ViaDouble(v, scale); }
+	static Type FromFloatTruncated(FloatOps::Type v)				{ return Float8TruncateToUInt8(v); }
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct UInt1Ops
+{
+	typedef unsigned int Type;
+	typedef Float1Ops FloatOps;
+	static constexpr int WIDTH = 1;
+
+	static Type Load(unsigned int const* values)					{ return *values; }
+	static void Store(unsigned int* out_values, Type v)				{ *out_values = v; }
+	static Type Splat(unsigned int value)							{ return value; }
+	static Type Sequence(unsigned int first)						{ return first; }
+	static Type Add(Type a, Type b)									{ return a + b; }
+	static Type Sub(Type a, Type b)									{ return a - b; }
+	static Type Mul(Type a, Type b)									{ return a * b; }
+	static Type Xor(Type a, Type b)									{ return a ^ b; }
+	static Type And(Type a, Type b)									{ return a & b; }
+	static Type Or(Type a, Type b)									{ return a | b; }
+	template<int BITS> static Type ShiftRight(Type v)				{ return v >> BITS; }
+	template<int BITS> static Type ShiftLeft(Type v)				{ return v << BITS; }
+	static FloatOps::Type ToFloat(Type v)							{ return static_cast<float>(static_cast<int>(v)); }
+	static FloatOps::Type ToFloatViaDouble(Type v, double scale)	{ return static_cast<float>(scale * static_cast<double>(v)); }
+	static Type FromFloatTruncated(FloatOps::Type v)				{ return static_cast<unsigned int>(static_cast<int>(v)); }
+};
@@ -0,0 +1,554 @@
+#include "Engine/Math/SoftwareOcclusionBuffer.hpp"
+#include "Engine/Math/Vec4.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/SIMDUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/JobSystem/JobSystem.hpp"
+#include "Engine/JobSystem/Job.hpp"
+
+#include <float.h>
+#include <math.h>
+
+//------------------------------------------------------------------------------------------------------------------
+#if defined(ENGINE_SIMD_AVX2)
+typedef Float8Ops OcclusionOps;
+#else
+typedef Float4Ops OcclusionOps;
+#endif
+
+typedef OcclusionOps::Type		OcclusionLane;
+
+constexpr int OCCLUSION_LANES = OcclusionOps::WIDTH;
+
+// Below this many binned occluder polygons per job, rasterizing on the calling thread is quicker than waking workers.
+constexpr int MIN_TILE_OCCLUDERS_PER_JOB = 64;
+
+//------------------------------------------------------------------------------------------------------------------
+class OcclusionTileJob : public Job
+{
+public:
+	virtual void Execute() override
+	{
+		m_buffer->RasterizeTiles(m_firstTile, m_tileStride);
+	}
+
+public:
+	SoftwareOcclusionBuffer*	m_buffer = nullptr;
+	int							m_firstTile = 0;
+	int							m_tileStride = 1;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+SoftwareOcclusionBuffer::SoftwareOcclusionBuffer(int width, int height)
+	: m_width(width)
+	, m_height(height)
+{
+	GUARANTEE_OR_DIE(width > 0 && width % TILE_WIDTH == 0, "SoftwareOcclusionBuffer width must be a multiple of TILE_WIDTH");
+	GUARANTEE_OR_DIE(height > 0 && height % TILE_HEIGHT == 0, "SoftwareOcclusionBuffer height must be a multiple of TILE_HEIGHT");
+
+	m_numTilesX = width / TILE_WIDTH;
+	m_numTilesY = height / TILE_HEIGHT;
+	m_numBlocksX = width / BLOCK_SIZE;
+
+	m_depths.resize(width * height, 1.f);
+	m_blockMaxDepths.resize((width / BLOCK_SIZE) * (height / BLOCK_SIZE), 1.f);
+	m_tileOccluders.resize(m_numTilesX * m_numTilesY);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void SoftwareOcclusionBuffer::BeginFrame(Mat44 const& worldToClip)
+{
+	m_worldToClip = worldToClip;
+	m_occluders.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void SoftwareOcclusionBuffer::AddOccluder(std::vector<Vec3> const& positions, std::vector<unsigned int> const& indexes, Mat44 const& localToWorld)
+{
+	Mat44 transform = m_worldToClip;
+	transform.Append(localToWorld);
+
+	std::vector<Vec4> clipPositions;
+	clipPositions.reserve(positions.size());
+	for(int vertIndex = 0; vertIndex < static_cast<int>(positions.size()); ++vertIndex)
+	{
+		clipPositions.push_back(transform.TransformHomogeneous3D(Vec4(positions[vertIndex], 1.f)));
+	}
+
+	for(int index = 0; index + 2 < static_cast<int>(indexes.size()); index += 3)
+	{
+		Vec4 const triangle[3] = { clipPositions[indexes[index]], clipPositions[indexes[index + 1]], clipPositions[indexes[index + 2]] };
+		AddClipSpacePolygon(triangle, 3);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Each face goes in as one quad rather than two triangles, so no open seam runs across the middle of it.
+void SoftwareOcclusionBuffer::AddOccluder(AABB3 const& worldBounds)
+{
+	static int const s_boxFaces[6][4] =
+	{
+		{ 0, 1, 3, 2 },		// -x
+		{ 4, 6, 7, 5 },		// +x
+		{ 0, 4, 5, 1 },		// -y
+		{ 2, 3, 7, 6 },		// +y
+		{ 0, 2, 6, 4 },		// -z
+		{ 1, 5, 7, 3 },		// +z
+	};
+
+	Vec4 clipCorners[8];
+	for(int corner = 0; corner < 8; ++corner)
+	{
+		Vec3 position((corner & 4) ? worldBounds.m_maxs.x : worldBounds.m_mins.x, (corner & 2) ? worldBounds.m_maxs.y : worldBounds.m_mins.y, (corner & 1) ? worldBounds.m_maxs.z : worldBounds.m_mins.z);
+		clipCorners[corner] = m_worldToClip.TransformHomogeneous3D(Vec4(position, 1.f));
+	}
+
+	for(int face = 0; face < 6; ++face)
+	{
+		Vec4 const quad[4] = { clipCorners[s_boxFaces[face][0]], clipCorners[s_boxFaces[face][1]], clipCorners[s_boxFaces[face][2]], clipCorners[s_boxFaces[face][3]] };
+		AddClipSpacePolygon(quad, 4);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// D3D clip space: -w <= x <= w, -w <= y <= w, 0 <= z <= w. Polygons (convex, 3 or 4 corners) entirely outside one side
+// are dropped; the rest are clipped against the near plane only, since the rasterizer clamps to the screen and depth
+// beyond 1 never wins.
+void SoftwareOcclusionBuffer::AddClipSpacePolygon(Vec4 const* clipCorners, int numCorners)
+{
+	int outsideBits = 0x3F;
+	for(int corner = 0; corner < numCorners; ++corner)
+	{
+		Vec4 const& clip = clipCorners[corner];
+		int cornerBits = (clip.x < -clip.w ? 1 : 0) | (clip.x > clip.w ? 2 : 0) | (clip.y < -clip.w ? 4 : 0) |
+						 (clip.y > clip.w ? 8 : 0) | (clip.z < 0.f ? 16 : 0) | (clip.z > clip.w ? 32 : 0);
+		outsideBits &= cornerBits;
+	}
+
+	if(outsideBits != 0)
+	{
+		return;
+	}
+
+	// Sutherland-Hodgman against z >= 0; one plane adds at most one corner
+	Vec4 polygon[MAX_OCCLUDER_EDGES + 1];
+	int numPolygonCorners = 0;
+	for(int corner = 0; corner < numCorners; ++corner)
+	{
+		Vec4 const& current = clipCorners[corner];
+		Vec4 const& next = clipCorners[(corner + 1) % numCorners];
+		if(current.z >= 0.f)
+		{
+			polygon[numPolygonCorners++] = current;
+		}
+
+		if((current.z >= 0.f) != (next.z >= 0.f))
+		{
+			float fraction = current.z / (current.z - next.z);
+			polygon[numPolygonCorners++] = current + (next - current) * fraction;
+		}
+	}
+
+	Vec3 screenCorners[MAX_OCCLUDER_EDGES + 1];
+	for(int corner = 0; corner < numPolygonCorners; ++corner)
+	{
+		Vec4 const& clip = polygon[corner];
+		float invW = 1.f / clip.w;
+		screenCorners[corner] = Vec3((clip.x * invW * 0.5f + 0.5f) * static_cast<float>(m_width), (clip.y * invW * 0.5f + 0.5f) * static_cast<float>(m_height), clip.z * invW);
+	}
+
+	// a quad cut by the near plane can come out with five corners; the extra one goes in as a triangle
+	if(numPolygonCorners > MAX_OCCLUDER_EDGES)
+	{
+		Vec3 const lastTriangle[3] = { screenCorners[0], screenCorners[MAX_OCCLUDER_EDGES - 1], screenCorners[MAX_OCCLUDER_EDGES] };
+		AddScreenPolygon(lastTriangle, 3);
+		numPolygonCorners = MAX_OCCLUDER_EDGES;
+	}
+
+	if(numPolygonCorners >= 3)
+	{
+		AddScreenPolygon(screenCorners, numPolygonCorners);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Edge i runs from corner i to corner i + 1; with the corners counter-clockwise, A * x + B * y + C is non-negative on
+// the inside of every edge. Triangles fill their fourth edge with one that everything is inside. No backface culling:
+// occluders are often single-sided walls seen from either side.
+//
+// The setup is inner-conservative, so the rasterizer can keep testing pixel centers: each edge is pulled in by half a
+// pixel towards its worst corner (the corner with the lowest edge value, 0.5 * (|A| + |B|) below the center), and the
+// depth plane is pushed back by half a pixel the same way. A center that passes then means the whole pixel is covered,
+// and its depth is the farthest the polygon reaches across that pixel.
+void SoftwareOcclusionBuffer::AddScreenPolygon(Vec3 const* screenCorners, int numCorners)
+{
+	Vec3 corners[MAX_OCCLUDER_EDGES];
+	float doubleArea = 0.f;
+	for(int corner = 0; corner < numCorners; ++corner)
+	{
+		Vec3 const& current = screenCorners[corner];
+		Vec3 const& next = screenCorners[(corner + 1) % numCorners];
+		doubleArea += current.x * next.y - next.x * current.y;
+	}
+
+	for(int corner = 0; corner < numCorners; ++corner)
+	{
+		corners[corner] = doubleArea < 0.f ? screenCorners[numCorners - 1 - corner] : screenCorners[corner];
+	}
+	doubleArea = fabsf(doubleArea);
+
+	if(doubleArea < 1e-6f)
+	{
+		return;
+	}
+
+	// pixel i spans [i, i + 1); keep only pixels entirely inside the polygon's bounds
+	float minX = corners[0].x;
+	float minY = corners[0].y;
+	float maxX = corners[0].x;
+	float maxY = corners[0].y;
+	for(int corner = 1; corner < numCorners; ++corner)
+	{
+		minX = GetMin(minX, corners[corner].x);
+		minY = GetMin(minY, corners[corner].y);
+		maxX = GetMax(maxX, corners[corner].x);
+		maxY = GetMax(maxY, corners[corner].y);
+	}
+
+	OccluderPolygon occluder;
+	// clamped before converting: a corner just past the near plane can project millions of pixels away
+	float width = static_cast<float>(m_width);
+	float height = static_cast<float>(m_height);
+	occluder.m_minX = static_cast<int>(ceilf(GetClamped(minX, -1.f, width)));
+	occluder.m_minY = static_cast<int>(ceilf(GetClamped(minY, -1.f, height)));
+	occluder.m_maxX = static_cast<int>(floorf(GetClamped(maxX - 1.f, -1.f, width - 1.f)));
+	occluder.m_maxY = static_cast<int>(floorf(GetClamped(maxY - 1.f, -1.f, height - 1.f)));
+	occluder.m_minX = GetMax(occluder.m_minX, 0);
+	occluder.m_minY = GetMax(occluder.m_minY, 0);
+	if(occluder.m_minX > occluder.m_maxX || occluder.m_minY > occluder.m_maxY)
+	{
+		return;
+	}
+
+	for(int edge = 0; edge < MAX_OCCLUDER_EDGES; ++edge)
+	{
+		if(edge >= numCorners)
+		{
+			occluder.m_edgeA[edge] = 0.f;
+			occluder.m_edgeB[edge] = 0.f;
+			occluder.m_edgeC[edge] = 1.f;
+			continue;
+		}
+
+		Vec3 const& start = corners[edge];
+		Vec3 const& end = corners[(edge + 1) % numCorners];
+		occluder.m_edgeA[edge] = start.y - end.y;
+		occluder.m_edgeB[edge] = end.x - start.x;
+		occluder.m_edgeC[edge] = -(occluder.m_edgeA[edge] * start.x + occluder.m_edgeB[edge] * start.y);
+		occluder.m_edgeC[edge] -= 0.5f * (fabsf(occluder.m_edgeA[edge]) + fabsf(occluder.m_edgeB[edge]));
+	}
+
+	// the polygon is planar, so any three corners give its depth plane; the widest fan triangle is the best conditioned
+	int planeCorner = 2;
+	float planeDoubleArea = 0.f;
+	for(int corner = 2; corner < numCorners; ++corner)
+	{
+		float fanDoubleArea = (corners[corner - 1].x - corners[0].x) * (corners[corner].y - corners[0].y) - (corners[corner - 1].y - corners[0].y) * (corners[corner].x - corners[0].x);
+		if(fanDoubleArea > planeDoubleArea)
+		{
+			planeDoubleArea = fanDoubleArea;
+			planeCorner = corner;
+		}
+	}
+
+	if(planeDoubleArea < 1e-6f)
+	{
+		return;
+	}
+
+	Vec3 const& corner0 = corners[0];
+	Vec3 const& corner1 = corners[planeCorner - 1];
+	Vec3 const& corner2 = corners[planeCorner];
+	float invDoubleArea = 1.f / planeDoubleArea;
+	float deltaZ1 = corner1.z - corner0.z;
+	float deltaZ2 = corner2.z - corner0.z;
+	occluder.m_depthDx = (deltaZ1 * (corner2.y - corner0.y) - deltaZ2 * (corner1.y - corner0.y)) * invDoubleArea;
+	occluder.m_depthDy = (deltaZ2 * (corner1.x - corner0.x) - deltaZ1 * (corner2.x - corner0.x)) * invDoubleArea;
+	occluder.m_depthAtOrigin = corner0.z - occluder.m_depthDx * corner0.x - occluder.m_depthDy * corner0.y;
+	occluder.m_depthAtOrigin += 0.5f * (fabsf(occluder.m_depthDx) + fabsf(occluder.m_depthDy));
+
+	m_occluders.push_back(occluder);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Bins every occluder polygon into the tiles its bounds touch, then rasterizes the tiles. Tiles share no pixels and each one
+// draws its bin in the order the occluders were added, so the buffer is the same however the tiles are split.
+void SoftwareOcclusionBuffer::RasterizeOccluders(JobSystem* jobSystem)
+{
+	for(int tileIndex = 0; tileIndex < static_cast<int>(m_tileOccluders.size()); ++tileIndex)
+	{
+		m_tileOccluders[tileIndex].clear();
+	}
+
+	int numBinned = 0;
+	for(int occluderIndex = 0; occluderIndex < static_cast<int>(m_occluders.size()); ++occluderIndex)
+	{
+		OccluderPolygon const& occluder = m_occluders[occluderIndex];
+		for(int tileY = occluder.m_minY / TILE_HEIGHT; tileY <= occluder.m_maxY / TILE_HEIGHT; ++tileY)
+		{
+			for(int tileX = occluder.m_minX / TILE_WIDTH; tileX <= occluder.m_maxX / TILE_WIDTH; ++tileX)
+			{
+				m_tileOccluders[tileY * m_numTilesX + tileX].push_back(occluderIndex);
+				++numBinned;
+			}
+		}
+	}
+
+	// one job per range of the binned occluder count; each takes every numRanges-th tile, which spreads occluders
+	// bunched in one part of the screen across them
+	int numTiles = m_numTilesX * m_numTilesY;
+	std::vector<int> rangeStarts;
+	SplitIntoJobRanges(0, numBinned, MIN_TILE_OCCLUDERS_PER_JOB, jobSystem, rangeStarts);
+
+	int numRanges = GetMin(static_cast<int>(rangeStarts.size()) - 1, numTiles);
+	if(numRanges == 1)
+	{
+		RasterizeTiles(0, 1);
+		return;
+	}
+
+	std::vector<OcclusionTileJob> jobs(numRanges);
+	for(int rangeIndex = 0; rangeIndex < numRanges; ++rangeIndex)
+	{
+		OcclusionTileJob& job = jobs[rangeIndex];
+		job.m_buffer = this;
+		job.m_firstTile = rangeIndex;
+		job.m_tileStride = numRanges;
+	}
+
+	jobSystem->ExecuteJobsAndWait(jobs);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void SoftwareOcclusionBuffer::RasterizeTiles(int firstTile, int tileStride)
+{
+	int numTiles = m_numTilesX * m_numTilesY;
+	for(int tileIndex = firstTile; tileIndex < numTiles; tileIndex += tileStride)
+	{
+		RasterizeTile(tileIndex);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Walks each binned occluder's bounds within the tile a row at a time, testing a group of pixels per step: a pixel is
+// covered when all four (inset) edge functions at its center are non-negative, and keeps the nearer of its depth and
+// the occluder's farthest depth over the pixel. Tiles are a whole number of groups wide, so a group never straddles two tiles.
+void SoftwareOcclusionBuffer::RasterizeTile(int tileIndex)
+{
+	int tileMinX = (tileIndex % m_numTilesX) * TILE_WIDTH;
+	int tileMinY = (tileIndex / m_numTilesX) * TILE_HEIGHT;
+	int tileMaxX = tileMinX + TILE_WIDTH - 1;
+	int tileMaxY = tileMinY + TILE_HEIGHT - 1;
+
+	for(int y = tileMinY; y <= tileMaxY; ++y)
+	{
+		float* row = &m_depths[y * m_width + tileMinX];
+		for(int x = 0; x < TILE_WIDTH; ++x)
+		{
+			row[x] = 1.f;
+		}
+	}
+
+	float laneOffsets[OCCLUSION_LANES];
+	for(int lane = 0; lane < OCCLUSION_LANES; ++lane)
+	{
+		laneOffsets[lane] = static_cast<float>(lane) + 0.5f;
+	}
+	OcclusionLane laneCenters = OcclusionOps::Load(laneOffsets);
+	OcclusionLane zero = OcclusionOps::Zero();
+
+	std::vector<int> const& tileOccluders = m_tileOccluders[tileIndex];
+	for(int binIndex = 0; binIndex < static_cast<int>(tileOccluders.size()); ++binIndex)
+	{
+		OccluderPolygon const& occluder = m_occluders[tileOccluders[binIndex]];
+		int minX = GetMax(occluder.m_minX, tileMinX) / OCCLUSION_LANES * OCCLUSION_LANES;
+		int maxX = GetMin(occluder.m_maxX, tileMaxX);
+		int minY = GetMax(occluder.m_minY, tileMinY);
+		int maxY = GetMin(occluder.m_maxY, tileMaxY);
+
+		OcclusionLane edgeA0 = OcclusionOps::Splat(occluder.m_edgeA[0]);
+		OcclusionLane edgeA1 = OcclusionOps::Splat(occluder.m_edgeA[1]);
+		OcclusionLane edgeA2 = OcclusionOps::Splat(occluder.m_edgeA[2]);
+		OcclusionLane edgeA3 = OcclusionOps::Splat(occluder.m_edgeA[3]);
+		OcclusionLane depthDx = OcclusionOps::Splat(occluder.m_depthDx);
+
+		for(int y = minY; y <= maxY; ++y)
+		{
+			float centerY = static_cast<float>(y) + 0.5f;
+			OcclusionLane rowEdge0 = OcclusionOps::Splat(occluder.m_edgeB[0] * centerY + occluder.m_edgeC[0]);
+			OcclusionLane rowEdge1 = OcclusionOps::Splat(occluder.m_edgeB[1] * centerY + occluder.m_edgeC[1]);
+			OcclusionLane rowEdge2 = OcclusionOps::Splat(occluder.m_edgeB[2] * centerY + occluder.m_edgeC[2]);
+			OcclusionLane rowEdge3 = OcclusionOps::Splat(occluder.m_edgeB[3] * centerY + occluder.m_edgeC[3]);
+			OcclusionLane rowDepth = OcclusionOps::Splat(occluder.m_depthDy * centerY + occluder.m_depthAtOrigin);
+			float* row = &m_depths[y * m_width];
+
+			for(int x = minX; x <= maxX; x += OCCLUSION_LANES)
+			{
+				OcclusionLane centerX = OcclusionOps::Add(OcclusionOps::Splat(static_cast<float>(x)), laneCenters);
+				OcclusionLane edge0 = OcclusionOps::MulAdd(edgeA0, centerX, rowEdge0);
+				OcclusionLane edge1 = OcclusionOps::MulAdd(edgeA1, centerX, rowEdge1);
+				OcclusionLane edge2 = OcclusionOps::MulAdd(edgeA2, centerX, rowEdge2);
+				OcclusionLane edge3 = OcclusionOps::MulAdd(edgeA3, centerX, rowEdge3);
+				OcclusionLane inside = OcclusionOps::And(OcclusionOps::And(OcclusionOps::CmpGe(edge0, zero), OcclusionOps::CmpGe(edge1, zero)),
+														 OcclusionOps::And(OcclusionOps::CmpGe(edge2, zero), OcclusionOps::CmpGe(edge3, zero)));
+				if(OcclusionOps::GetMaskBits(inside) == 0)
+				{
+					continue;
+				}
+
+				OcclusionLane depth = OcclusionOps::MulAdd(depthDx, centerX, rowDepth);
+				OcclusionLane oldDepth = OcclusionOps::Load(row + x);
+				OcclusionOps::Store(row + x, OcclusionOps::Select(inside, OcclusionOps::Min(oldDepth, depth), oldDepth));
+			}
+		}
+	}
+
+	// hierarchical level: the farthest depth in each block, so one compare can show a whole block hides an object
+	for(int blockY = tileMinY / BLOCK_SIZE; blockY <= tileMaxY / BLOCK_SIZE; ++blockY)
+	{
+		for(int blockX = tileMinX / BLOCK_SIZE; blockX <= tileMaxX / BLOCK_SIZE; ++blockX)
+		{
+			float maxDepth = 0.f;
+			for(int y = blockY * BLOCK_SIZE; y < (blockY + 1) * BLOCK_SIZE; ++y)
+			{
+				float const* row = &m_depths[y * m_width + blockX * BLOCK_SIZE];
+				for(int x = 0; x < BLOCK_SIZE; ++x)
+				{
+					maxDepth = GetMax(maxDepth, row[x]);
+				}
+			}
+			m_blockMaxDepths[blockY * m_numBlocksX + blockX] = maxDepth;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Projects the box's corners and tests its nearest depth against every pixel its screen rectangle touches. The
+// corners are the clip-space min corner plus combinations of the clip-space box edges, 3 transformed vectors instead
+// of 8 points. Called once per frustum survivor, so the corner loop sticks to plain floats and inline compares.
+bool SoftwareOcclusionBuffer::IsAABB3Visible(AABB3 const& worldBounds) const
+{
+	Vec3 dimensions = worldBounds.m_maxs - worldBounds.m_mins;
+	Vec4 clipMins = m_worldToClip.TransformHomogeneous3D(Vec4(worldBounds.m_mins, 1.f));
+	float const* matrix = m_worldToClip.GetAsFloatArray();
+	float clipEdges[3][4];
+	for(int component = 0; component < 4; ++component)
+	{
+		clipEdges[0][component] = matrix[Mat44::Ix + component] * dimensions.x;
+		clipEdges[1][component] = matrix[Mat44::Jx + component] * dimensions.y;
+		clipEdges[2][component] = matrix[Mat44::Kx + component] * dimensions.z;
+	}
+
+	float minX = FLT_MAX;
+	float minY = FLT_MAX;
+	float maxX = -FLT_MAX;
+	float maxY = -FLT_MAX;
+	float nearestDepth = FLT_MAX;
+	for(int corner = 0; corner < 8; ++corner)
+	{
+		float clip[4] = { clipMins.x, clipMins.y, clipMins.z, clipMins.w };
+		for(int axis = 0; axis < 3; ++axis)
+		{
+			if(corner & (4 >> axis))
+			{
+				clip[0] += clipEdges[axis][0];
+				clip[1] += clipEdges[axis][1];
+				clip[2] += clipEdges[axis][2];
+				clip[3] += clipEdges[axis][3];
+			}
+		}
+
+		// reaches the near plane or behind the camera; the projected rectangle means nothing, so assume visible
+		if(clip[2] < 0.f || clip[3] <= 0.f)
+		{
+			return true;
+		}
+
+		float invW = 1.f / clip[3];
+		float screenX = (clip[0] * invW * 0.5f + 0.5f) * static_cast<float>(m_width);
+		float screenY = (clip[1] * invW * 0.5f + 0.5f) * static_cast<float>(m_height);
+		float depth = clip[2] * invW;
+		minX = screenX < minX ? screenX : minX;
+		minY = screenY < minY ? screenY : minY;
+		maxX = screenX > maxX ? screenX : maxX;
+		maxY = screenY > maxY ? screenY : maxY;
+		nearestDepth = depth < nearestDepth ? depth : nearestDepth;
+	}
+
+	// the part of the rectangle off screen cannot be seen anyway, so only the on-screen pixels are tested
+	float width = static_cast<float>(m_width);
+	float height = static_cast<float>(m_height);
+	if(maxX < 0.f || maxY < 0.f || minX >= width || minY >= height)
+	{
+		return false;
+	}
+
+	int minPixelX = static_cast<int>(GetClamped(minX, 0.f, width - 1.f));
+	int minPixelY = static_cast<int>(GetClamped(minY, 0.f, height - 1.f));
+	int maxPixelX = static_cast<int>(GetClamped(maxX, 0.f, width - 1.f));
+	int maxPixelY = static_cast<int>(GetClamped(maxY, 0.f, height - 1.f));
+	return IsPixelRectVisible(minPixelX, minPixelY, maxPixelX, maxPixelY, nearestDepth);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool SoftwareOcclusionBuffer::IsPixelRectVisible(int minX, int minY, int maxX, int maxY, float nearestDepth) const
+{
+	for(int blockY = minY / BLOCK_SIZE; blockY <= maxY / BLOCK_SIZE; ++blockY)
+	{
+		for(int blockX = minX / BLOCK_SIZE; blockX <= maxX / BLOCK_SIZE; ++blockX)
+		{
+			if(nearestDepth > m_blockMaxDepths[blockY * m_numBlocksX + blockX])
+			{
+				continue;
+			}
+
+			// some pixel in the block is at least as far as the object; check the ones the rectangle covers
+			int startX = GetMax(minX, blockX * BLOCK_SIZE);
+			int startY = GetMax(minY, blockY * BLOCK_SIZE);
+			int endX = GetMin(maxX, blockX * BLOCK_SIZE + BLOCK_SIZE - 1);
+			int endY = GetMin(maxY, blockY * BLOCK_SIZE + BLOCK_SIZE - 1);
+			for(int y = startY; y <= endY; ++y)
+			{
+				float const* row = &m_depths[y * m_width];
+				for(int x = startX; x <= endX; ++x)
+				{
+					if(nearestDepth <= row[x])
+					{
+						return true;
+					}
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int SoftwareOcclusionBuffer::CullOccludedAABB3s(AABB3SoA const& boxes, std::vector<int>& inout_visibleIndexes) const
+{
+	int numVisible = 0;
+	for(int listIndex = 0; listIndex < static_cast<int>(inout_visibleIndexes.size()); ++listIndex)
+	{
+		int boxIndex = inout_visibleIndexes[listIndex];
+		AABB3 box(boxes.m_minX[boxIndex], boxes.m_minY[boxIndex], boxes.m_minZ[boxIndex], boxes.m_maxX[boxIndex], boxes.m_maxY[boxIndex], boxes.m_maxZ[boxIndex]);
+		if(IsAABB3Visible(box))
+		{
+			inout_visibleIndexes[numVisible++] = boxIndex;
+		}
+	}
+
+	inout_visibleIndexes.resize(numVisible);
+	return numVisible;
+}
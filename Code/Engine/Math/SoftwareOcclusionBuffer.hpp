@@ -0,0 +1,93 @@
+#pragma once
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
+
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------
+struct AABB3;
+struct Vec4;
+class JobSystem;
+
+//------------------------------------------------------------------------------------------------------------------
+// Low-resolution CPU depth buffer for culling objects hidden behind large occluders (walls, floors, terrain chunks).
+// Each frame: BeginFrame with the camera's world-to-clip transform, AddOccluder the handful of big meshes nearest the
+// camera, RasterizeOccluders, then test the frustum survivors' bounds.
+//
+// Depth is D3D clip z / w, 0 at the near plane and 1 at the far plane; pixel row 0 is the bottom of the screen. The
+// buffer is split into tiles that rasterize independently (on the JobSystem if given), and every 8x8 block keeps the
+// farthest depth it holds so most bounds tests read one value per block instead of 64 pixels.
+//
+// Occluder rasterization is inner-conservative: a pixel is only written when one occluder polygon covers all of it,
+// and it gets the farthest depth that polygon has across the pixel, so nothing is ever reported hidden by a pixel that
+// is partly open. Box occluders go in a face (quad) at a time; the price for meshes is that the seams between their
+// triangles stay open where they cross a pixel diagonally, which only makes the culling a little less aggressive.
+// Bounds that cross the near plane are always reported visible, and bounds entirely off screen never are. Results only
+// depend on the inputs, not on how the tiles were scheduled.
+//------------------------------------------------------------------------------------------------------------------
+class SoftwareOcclusionBuffer
+{
+public:
+	explicit SoftwareOcclusionBuffer(int width = 256, int height = 128);
+	~SoftwareOcclusionBuffer() = default;
+
+	void	BeginFrame(Mat44 const& worldToClip);
+	void	AddOccluder(std::vector<Vec3> const& positions, std::vector<unsigned int> const& indexes, Mat44 const& localToWorld = Mat44());
+	void	AddOccluder(AABB3 const& worldBounds);
+	void	RasterizeOccluders(JobSystem* jobSystem = nullptr);
+
+	bool	IsAABB3Visible(AABB3 const& worldBounds) const;
+
+	// Removes the indexes of occluded boxes from inout_visibleIndexes (typically the output of CullAABB3sToFrustum),
+	// keeping the order of the rest. Returns how many are left.
+	int		CullOccludedAABB3s(AABB3SoA const& boxes, std::vector<int>& inout_visibleIndexes) const;
+
+	int		GetWidth() const							{ return m_width; }
+	int		GetHeight() const							{ return m_height; }
+	int		GetNumOccluderPolygons() const				{ return static_cast<int>(m_occluders.size()); }
+	float	GetDepth(int pixelX, int pixelY) const		{ return m_depths[pixelY * m_width + pixelX]; }
+
+public:
+	static constexpr int TILE_WIDTH = 64;
+	static constexpr int TILE_HEIGHT = 32;
+	static constexpr int BLOCK_SIZE = 8;
+	static constexpr int MAX_OCCLUDER_EDGES = 4;
+
+private:
+	// A convex screen-space polygon (triangle or quad) set up for rasterizing: four edge functions that are non-negative
+	// inside, a depth plane and a pixel bounding box. Everything is in pixel units.
+	struct OccluderPolygon
+	{
+		float	m_edgeA[MAX_OCCLUDER_EDGES];
+		float	m_edgeB[MAX_OCCLUDER_EDGES];
+		float	m_edgeC[MAX_OCCLUDER_EDGES];
+		float	m_depthDx;
+		float	m_depthDy;
+		float	m_depthAtOrigin;
+		int		m_minX;
+		int		m_minY;
+		int		m_maxX;				// inclusive
+		int		m_maxY;
+	};
+
+	friend class OcclusionTileJob;
+
+	void	AddClipSpacePolygon(Vec4 const* clipCorners, int numCorners);
+	void	AddScreenPolygon(Vec3 const* screenCorners, int numCorners);
+	void	RasterizeTiles(int firstTile, int tileStride);
+	void	RasterizeTile(int tileIndex);
+	bool	IsPixelRectVisible(int minX, int minY, int maxX, int maxY, float nearestDepth) const;
+
+private:
+	int								m_width = 0;
+	int								m_height = 0;
+	int								m_numTilesX = 0;
+	int								m_numTilesY = 0;
+	int								m_numBlocksX = 0;
+	Mat44							m_worldToClip;
+	std::vector<float>				m_depths;
+	std::vector<float>				m_blockMaxDepths;
+	std::vector<OccluderPolygon>	m_occluders;
+	std::vector<std::vector<int>>	m_tileOccluders;
+};
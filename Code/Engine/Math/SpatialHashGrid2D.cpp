@@ -0,0 +1,285 @@
+#include "Engine/Math/SpatialHashGrid2D.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <math.h>
+
+//------------------------------------------------------------------------------------------------------------------
+struct SpatialHashGrid2D::DiscOverlap
+{
+	Vec2	m_center;
+	float	m_radius;
+
+	bool operator()(Entry const& entry) const
+	{
+		float radiiSum = m_radius + entry.m_radius;
+		float deltaX = entry.m_x - m_center.x;
+		float deltaY = entry.m_y - m_center.y;
+		return deltaX * deltaX + deltaY * deltaY <= radiiSum * radiiSum;
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct SpatialHashGrid2D::BoxOverlap
+{
+	AABB2 const&	m_box;
+
+	bool operator()(Entry const& entry) const
+	{
+		return IsPointInsideDisc2D(GetNearestPointOnAABB2D(Vec2(entry.m_x, entry.m_y), m_box), Vec2(entry.m_x, entry.m_y), entry.m_radius);
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct SpatialHashGrid2D::PointInside
+{
+	Vec2	m_point;
+
+	bool operator()(Entry const& entry) const
+	{
+		return IsPointInsideDisc2D(m_point, Vec2(entry.m_x, entry.m_y), entry.m_radius);
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct SpatialHashGrid2D::DirectedSectorInside
+{
+	Vec2	m_sectorTip;
+	Vec2	m_sectorForwardNormal;
+	float	m_sectorApertureDegrees;
+	float	m_sectorRadius;
+
+	bool operator()(Entry const& entry) const
+	{
+		return IsPointInsideDirectedSector2D(Vec2(entry.m_x, entry.m_y), m_sectorTip, m_sectorForwardNormal, m_sectorApertureDegrees, m_sectorRadius);
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------
+SpatialHashGrid2D::SpatialHashGrid2D(float cellSize)
+	: m_cellSize(cellSize)
+{
+	GUARANTEE_OR_DIE(cellSize > 0.f, "SpatialHashGrid2D needs a positive cell size");
+	m_invCellSize = 1.f / cellSize;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void SpatialHashGrid2D::Rebuild(std::vector<Vec2> const& discCenters, std::vector<float> const& discRadii)
+{
+	GUARANTEE_OR_DIE(discCenters.size() == discRadii.size(), "SpatialHashGrid2D::Rebuild needs one radius per disc");
+	SortDiscsIntoBuckets(discCenters, discRadii.data(), 0.f);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void SpatialHashGrid2D::Rebuild(std::vector<Vec2> const& discCenters, float discRadius)
+{
+	SortDiscsIntoBuckets(discCenters, nullptr, discRadius);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void SpatialHashGrid2D::Clear()
+{
+	m_bucketStarts.clear();
+	m_entries.clear();
+	m_maxRadius = 0.f;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Counting sort: count the discs per bucket, turn the counts into end offsets, then walk the discs and drop each one
+// just below its bucket's end. That leaves every offset at the start of its bucket.
+void SpatialHashGrid2D::SortDiscsIntoBuckets(std::vector<Vec2> const& discCenters, float const* discRadii, float uniformRadius)
+{
+	int numDiscs = static_cast<int>(discCenters.size());
+
+	// about two buckets per disc keeps collisions between unrelated cells rare
+	int numBuckets = MIN_BUCKETS;
+	while(numBuckets < 2 * numDiscs)
+	{
+		numBuckets *= 2;
+	}
+	m_bucketMask = static_cast<unsigned int>(numBuckets - 1);
+
+	m_bucketStarts.assign(numBuckets + 1, 0);
+	m_discBuckets.resize(numDiscs);
+	m_entries.resize(numDiscs);
+	m_maxRadius = uniformRadius;
+
+	for(int discIndex = 0; discIndex < numDiscs; ++discIndex)
+	{
+		int bucket = GetBucket(GetCellCoord(discCenters[discIndex].x), GetCellCoord(discCenters[discIndex].y));
+		m_discBuckets[discIndex] = bucket;
+		++m_bucketStarts[bucket];
+	}
+
+	int runningTotal = 0;
+	for(int bucket = 0; bucket <= numBuckets; ++bucket)
+	{
+		runningTotal += m_bucketStarts[bucket];
+		m_bucketStarts[bucket] = runningTotal;
+	}
+
+	for(int discIndex = numDiscs - 1; discIndex >= 0; --discIndex)
+	{
+		Vec2 const& center = discCenters[discIndex];
+		float radius = discRadii != nullptr ? discRadii[discIndex] : uniformRadius;
+		m_maxRadius = radius > m_maxRadius ? radius : m_maxRadius;
+
+		Entry& entry = m_entries[--m_bucketStarts[m_discBuckets[discIndex]]];
+		entry.m_x = center.x;
+		entry.m_y = center.y;
+		entry.m_radius = radius;
+		entry.m_cellX = GetCellCoord(center.x);
+		entry.m_cellY = GetCellCoord(center.y);
+		entry.m_discIndex = discIndex;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int SpatialHashGrid2D::GetCellCoord(float coord) const
+{
+	return static_cast<int>(floorf(coord * m_invCellSize));
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int SpatialHashGrid2D::GetBucket(int cellX, int cellY) const
+{
+	unsigned int hash = (static_cast<unsigned int>(cellX) * 92837111u) ^ (static_cast<unsigned int>(cellY) * 689287499u);
+	return static_cast<int>(hash & m_bucketMask);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Widens the box by the largest radius (discs are filed by center only), then tests every disc in the buckets of the
+// cells it covers. A box spanning more cells than there are discs is cheaper to answer by scanning every disc.
+template<typename EntryTestFunc>
+void SpatialHashGrid2D::QueryCandidates(float minX, float minY, float maxX, float maxY, EntryTestFunc const& isEntryAccepted, std::vector<int>& out_discIndexes) const
+{
+	if(m_entries.empty())
+	{
+		return;
+	}
+
+	int minCellX = GetCellCoord(minX - m_maxRadius);
+	int minCellY = GetCellCoord(minY - m_maxRadius);
+	int maxCellX = GetCellCoord(maxX + m_maxRadius);
+	int maxCellY = GetCellCoord(maxY + m_maxRadius);
+
+	float numCells = (static_cast<float>(maxCellX - minCellX) + 1.f) * (static_cast<float>(maxCellY - minCellY) + 1.f);
+	if(numCells > static_cast<float>(m_entries.size()))
+	{
+		for(int entryIndex = 0; entryIndex < static_cast<int>(m_entries.size()); ++entryIndex)
+		{
+			if(isEntryAccepted(m_entries[entryIndex]))
+			{
+				out_discIndexes.push_back(m_entries[entryIndex].m_discIndex);
+			}
+		}
+		return;
+	}
+
+	for(int cellY = minCellY; cellY <= maxCellY; ++cellY)
+	{
+		for(int cellX = minCellX; cellX <= maxCellX; ++cellX)
+		{
+			int bucket = GetBucket(cellX, cellY);
+			int entryEnd = m_bucketStarts[bucket + 1];
+
+			// several cells can share a bucket, so skip discs filed under a different cell
+			for(int entryIndex = m_bucketStarts[bucket]; entryIndex < entryEnd; ++entryIndex)
+			{
+				Entry const& entry = m_entries[entryIndex];
+				if(entry.m_cellX == cellX && entry.m_cellY == cellY && isEntryAccepted(entry))
+				{
+					out_discIndexes.push_back(entry.m_discIndex);
+				}
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Each disc searches the cells within its own radius plus the largest radius, and only pairs with discs stored after
+// it, so every pair is reported once.
+void SpatialHashGrid2D::FindOverlappingPairs(std::vector<SpatialHashPair2D>& out_pairs, float extraDistance) const
+{
+	int numEntries = static_cast<int>(m_entries.size());
+
+	for(int entryIndexA = 0; entryIndexA < numEntries; ++entryIndexA)
+	{
+		Entry const& entryA = m_entries[entryIndexA];
+		float searchRadius = entryA.m_radius + m_maxRadius + extraDistance;
+		int minCellX = GetCellCoord(entryA.m_x - searchRadius);
+		int minCellY = GetCellCoord(entryA.m_y - searchRadius);
+		int maxCellX = GetCellCoord(entryA.m_x + searchRadius);
+		int maxCellY = GetCellCoord(entryA.m_y + searchRadius);
+
+		for(int cellY = minCellY; cellY <= maxCellY; ++cellY)
+		{
+			for(int cellX = minCellX; cellX <= maxCellX; ++cellX)
+			{
+				int bucket = GetBucket(cellX, cellY);
+				int entryEnd = m_bucketStarts[bucket + 1];
+				int entryStart = m_bucketStarts[bucket];
+				entryStart = entryStart > entryIndexA + 1 ? entryStart : entryIndexA + 1;
+
+				for(int entryIndexB = entryStart; entryIndexB < entryEnd; ++entryIndexB)
+				{
+					Entry const& entryB = m_entries[entryIndexB];
+					if(entryB.m_cellX != cellX || entryB.m_cellY != cellY)
+					{
+						continue;
+					}
+
+					float reach = entryA.m_radius + entryB.m_radius + extraDistance;
+					float deltaX = entryB.m_x - entryA.m_x;
+					float deltaY = entryB.m_y - entryA.m_y;
+					if(deltaX * deltaX + deltaY * deltaY > reach * reach)
+					{
+						continue;
+					}
+
+					SpatialHashPair2D pair;
+					pair.m_discA = entryA.m_discIndex < entryB.m_discIndex ? entryA.m_discIndex : entryB.m_discIndex;
+					pair.m_discB = entryA.m_discIndex < entryB.m_discIndex ? entryB.m_discIndex : entryA.m_discIndex;
+					out_pairs.push_back(pair);
+				}
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void SpatialHashGrid2D::QueryDisc(Vec2 const& center, float radius, std::vector<int>& out_discIndexes) const
+{
+	DiscOverlap discOverlap = { center, radius };
+	QueryCandidates(center.x - radius, center.y - radius, center.x + radius, center.y + radius, discOverlap, out_discIndexes);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void SpatialHashGrid2D::QueryAABB2(AABB2 const& box, std::vector<int>& out_discIndexes) const
+{
+	BoxOverlap boxOverlap = { box };
+	QueryCandidates(box.m_mins.x, box.m_mins.y, box.m_maxs.x, box.m_maxs.y, boxOverlap, out_discIndexes);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void SpatialHashGrid2D::QueryPoint(Vec2 const& point, std::vector<int>& out_discIndexes) const
+{
+	PointInside pointInside = { point };
+	QueryCandidates(point.x, point.y, point.x, point.y, pointInside, out_discIndexes);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void SpatialHashGrid2D::QueryOrientedSector(Vec2 const& sectorTip, float sectorForwardDegrees, float sectorApertureDegrees, float sectorRadius, std::vector<int>& out_discIndexes) const
+{
+	Vec2 sectorForwardNormal(CosDegrees(sectorForwardDegrees), SinDegrees(sectorForwardDegrees));
+	QueryDirectedSector(sectorTip, sectorForwardNormal, sectorApertureDegrees, sectorRadius, out_discIndexes);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Only the disc centers are tested against the sector, the same as IsPointInsideDirectedSector2D.
+void SpatialHashGrid2D::QueryDirectedSector(Vec2 const& sectorTip, Vec2 const& sectorForwardNormal, float sectorApertureDegrees, float sectorRadius, std::vector<int>& out_discIndexes) const
+{
+	DirectedSectorInside sectorInside = { sectorTip, sectorForwardNormal, sectorApertureDegrees, sectorRadius };
+	QueryCandidates(sectorTip.x - sectorRadius, sectorTip.y - sectorRadius, sectorTip.x + sectorRadius, sectorTip.y + sectorRadius, sectorInside, out_discIndexes);
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include "Engine/Math/Vec2.hpp"
+
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------
+struct AABB2;
+
+//------------------------------------------------------------------------------------------------------------------
+struct SpatialHashPair2D
+{
+	int m_discA = -1;			// always the lower index
+	int m_discB = -1;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Uniform grid over the infinite plane for many small discs. Each disc is filed under the cell holding its center and
+// cells are hashed into a table of buckets, so the grid needs no world bounds. Rebuild counting-sorts the discs by
+// bucket into one contiguous array; a query walks the few buckets it covers and reads their discs back to back.
+//
+// Rebuild every frame from the current positions; it is linear in the number of discs and does no per-bucket
+// allocation. Pick a cell size around the diameter of a typical disc. Discs much larger than the cells still work,
+// but every query widens its search by the largest radius in the grid.
+//
+// Queries return disc indexes into the arrays given to Rebuild, and are exact:
+//	FindOverlappingPairs	every pair within extraDistance of touching; feed these to PushDiscsOutOfEachOther2D or
+//							BounceDiscOutOfDisc instead of looping over every pair of entities
+//	QueryDisc / QueryAABB2	discs overlapping the shape
+//	QueryPoint				discs containing the point (IsPointInsideDisc2D)
+//	Query*Sector			discs whose center is inside the sector (IsPointInside*Sector2D)
+//
+// The grid is a snapshot: once the pushes move the discs, it is stale until the next Rebuild.
+//------------------------------------------------------------------------------------------------------------------
+class SpatialHashGrid2D
+{
+public:
+	explicit SpatialHashGrid2D(float cellSize);
+	~SpatialHashGrid2D() = default;
+
+	void	Rebuild(std::vector<Vec2> const& discCenters, std::vector<float> const& discRadii);
+	void	Rebuild(std::vector<Vec2> const& discCenters, float discRadius);
+	void	Clear();
+
+	float	GetCellSize() const				{ return m_cellSize; }
+	int		GetNumDiscs() const				{ return static_cast<int>(m_entries.size()); }
+	int		GetNumBuckets() const			{ return static_cast<int>(m_bucketStarts.size()) - 1; }
+
+	void	FindOverlappingPairs(std::vector<SpatialHashPair2D>& out_pairs, float extraDistance = 0.f) const;
+
+	void	QueryDisc(Vec2 const& center, float radius, std::vector<int>& out_discIndexes) const;
+	void	QueryAABB2(AABB2 const& box, std::vector<int>& out_discIndexes) const;
+	void	QueryPoint(Vec2 const& point, std::vector<int>& out_discIndexes) const;
+	void	QueryOrientedSector(Vec2 const& sectorTip, float sectorForwardDegrees, float sectorApertureDegrees, float sectorRadius, std::vector<int>& out_discIndexes) const;
+	void	QueryDirectedSector(Vec2 const& sectorTip, Vec2 const& sectorForwardNormal, float sectorApertureDegrees, float sectorRadius, std::vector<int>& out_discIndexes) const;
+
+public:
+	static constexpr int MIN_BUCKETS = 64;
+
+private:
+	// Everything a query reads for one disc, so a bucket is a single contiguous run.
+	struct Entry
+	{
+		float	m_x;
+		float	m_y;
+		float	m_radius;
+		int		m_cellX;
+		int		m_cellY;
+		int		m_discIndex;
+	};
+
+	struct DiscOverlap;
+	struct BoxOverlap;
+	struct PointInside;
+	struct DirectedSectorInside;
+
+	void	SortDiscsIntoBuckets(std::vector<Vec2> const& discCenters, float const* discRadii, float uniformRadius);
+	int		GetCellCoord(float coord) const;
+	int		GetBucket(int cellX, int cellY) const;
+
+	template<typename EntryTestFunc>
+	void	QueryCandidates(float minX, float minY, float maxX, float maxY, EntryTestFunc const& isEntryAccepted, std::vector<int>& out_discIndexes) const;
+
+private:
+	float				m_cellSize = 1.f;
+	float				m_invCellSize = 1.f;
+	float				m_maxRadius = 0.f;
+	unsigned int		m_bucketMask = 0;
+	std::vector<int>	m_bucketStarts;			// numBuckets + 1; bucket b is [m_bucketStarts[b], m_bucketStarts[b + 1])
+	std::vector<int>	m_discBuckets;			// scratch for Rebuild
+	std::vector<Entry>	m_entries;				// sorted by bucket
+};
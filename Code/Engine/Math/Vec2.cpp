@@ -61,10 +61,11 @@ Vec2 const Vec2::MakeFromPolarRadians(float orientationRadians, float length)
 Vec2 const Vec2::MakeFromPolarDegrees(float orientationDegrees, float length)
 {
 
-	float rcos = length * CosDegrees(orientationDegrees);
-	float rsin = length * SinDegrees(orientationDegrees);
+	float sine;
+	float cosine;
+	SinCosDegrees(orientationDegrees, sine, cosine);
 
-	return Vec2(rcos, rsin);
+	return Vec2(length * cosine, length * sine);
 
 }
 
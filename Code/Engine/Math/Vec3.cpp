@@ -134,9 +134,16 @@ Vec3 const Vec3::MakeFromPolarRadians(float pitchRadians, float yawRadians, floa
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------
 Vec3 const Vec3::MakeFromPolarDegrees(float pitchDegrees, float yawDegrees, float length)
 {
-	float x = length * CosDegrees(pitchDegrees) * CosDegrees(yawDegrees);
-	float y = length * CosDegrees(pitchDegrees) * SinDegrees(yawDegrees);
-	float z = length * SinDegrees(pitchDegrees);
+	float sinPitch;
+	float cosPitch;
+	float sinYaw;
+	float cosYaw;
+	SinCosDegrees(pitchDegrees, sinPitch, cosPitch);
+	SinCosDegrees(yawDegrees, sinYaw, cosYaw);
+
+	float x = length * cosPitch * cosYaw;
+	float y = length * cosPitch * sinYaw;
+	float z = length * sinPitch;
 
 	return Vec3(x, y, z);
 
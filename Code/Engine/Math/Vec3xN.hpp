@@ -0,0 +1,202 @@
+#pragma once
+
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/SIMDUtils.hpp"
+
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------
+// N Vec3s packed as three SoA lanes (all x, all y, all z), so bulk geometry code can be written once with the usual
+// vector operators and run 4 or 8 wide. Comparisons produce lane masks (all bits set or clear) for Select and
+// GetMaskBits; bit i of a mask is lane i.
+//
+//	Vec3x4	SSE / NEON, scalar fallback
+//	Vec3x8	AVX2, or a pair of 4-wide halves on other builds
+//------------------------------------------------------------------------------------------------------------------
+template<typename Ops>
+struct Vec3xN
+{
+public:
+	typedef typename Ops::Type Lane;
+	static constexpr int WIDTH = Ops::WIDTH;
+	static constexpr int ALL_LANES_MASK = (1 << Ops::WIDTH) - 1;
+
+public:
+	Lane m_x;
+	Lane m_y;
+	Lane m_z;
+
+public:
+	Vec3xN() = default;
+	Vec3xN(Lane x, Lane y, Lane z) : m_x(x), m_y(y), m_z(z) {}
+	explicit Vec3xN(Vec3 const& broadcast) : m_x(Ops::Splat(broadcast.x)), m_y(Ops::Splat(broadcast.y)), m_z(Ops::Splat(broadcast.z)) {}
+
+	static Vec3xN	Zero()											{ return Vec3xN(Ops::Zero(), Ops::Zero(), Ops::Zero()); }
+	static Vec3xN	LoadSoA(float const* xs, float const* ys, float const* zs)	{ return Vec3xN(Ops::Load(xs), Ops::Load(ys), Ops::Load(zs)); }
+	void			StoreSoA(float* out_xs, float* out_ys, float* out_zs) const	{ Ops::Store(out_xs, m_x); Ops::Store(out_ys, m_y); Ops::Store(out_zs, m_z); }
+
+	// Gather/scatter against AoS Vec3 arrays. Lanes past the end of the source read as zero and are never written back.
+	static Vec3xN	Gather(std::vector<Vec3> const& points, int startIndex);
+	static Vec3xN	GatherIndexed(std::vector<Vec3> const& points, int const* indices, int numIndices);
+	void			Scatter(std::vector<Vec3>& out_points, int startIndex, int laneMask = ALL_LANES_MASK) const;
+	void			ScatterIndexed(std::vector<Vec3>& out_points, int const* indices, int numIndices, int laneMask = ALL_LANES_MASK) const;
+	Vec3			GetLane(int lane) const;
+
+	Lane			GetLengthSquared() const						{ return Ops::MulAdd(m_x, m_x, Ops::MulAdd(m_y, m_y, Ops::Mul(m_z, m_z))); }
+	Lane			GetLength() const								{ return Ops::Sqrt(GetLengthSquared()); }
+	Vec3xN			GetNormalized() const;							// zero-length lanes stay zero
+
+	Vec3xN			operator+(Vec3xN const& vecToAdd) const			{ return Vec3xN(Ops::Add(m_x, vecToAdd.m_x), Ops::Add(m_y, vecToAdd.m_y), Ops::Add(m_z, vecToAdd.m_z)); }
+	Vec3xN			operator-(Vec3xN const& vecToSubtract) const	{ return Vec3xN(Ops::Sub(m_x, vecToSubtract.m_x), Ops::Sub(m_y, vecToSubtract.m_y), Ops::Sub(m_z, vecToSubtract.m_z)); }
+	Vec3xN			operator-() const								{ return Vec3xN(Ops::Sub(Ops::Zero(), m_x), Ops::Sub(Ops::Zero(), m_y), Ops::Sub(Ops::Zero(), m_z)); }
+	Vec3xN			operator*(Vec3xN const& vecToMultiply) const	{ return Vec3xN(Ops::Mul(m_x, vecToMultiply.m_x), Ops::Mul(m_y, vecToMultiply.m_y), Ops::Mul(m_z, vecToMultiply.m_z)); }
+	Vec3xN			operator*(Lane perLaneScale) const				{ return Vec3xN(Ops::Mul(m_x, perLaneScale), Ops::Mul(m_y, perLaneScale), Ops::Mul(m_z, perLaneScale)); }
+	Vec3xN			operator*(float uniformScale) const				{ return *this * Ops::Splat(uniformScale); }
+	Vec3xN			operator/(Lane perLaneDivisor) const			{ return Vec3xN(Ops::Div(m_x, perLaneDivisor), Ops::Div(m_y, perLaneDivisor), Ops::Div(m_z, perLaneDivisor)); }
+	void			operator+=(Vec3xN const& vecToAdd)				{ *this = *this + vecToAdd; }
+	void			operator-=(Vec3xN const& vecToSubtract)			{ *this = *this - vecToSubtract; }
+	void			operator*=(Lane perLaneScale)					{ *this = *this * perLaneScale; }
+	void			operator*=(float uniformScale)					{ *this = *this * uniformScale; }
+
+	static Vec3xN	Min(Vec3xN const& a, Vec3xN const& b)			{ return Vec3xN(Ops::Min(a.m_x, b.m_x), Ops::Min(a.m_y, b.m_y), Ops::Min(a.m_z, b.m_z)); }
+	static Vec3xN	Max(Vec3xN const& a, Vec3xN const& b)			{ return Vec3xN(Ops::Max(a.m_x, b.m_x), Ops::Max(a.m_y, b.m_y), Ops::Max(a.m_z, b.m_z)); }
+	static Vec3xN	Select(Lane mask, Vec3xN const& ifTrue, Vec3xN const& ifFalse);
+	static Vec3xN	MulAdd(Vec3xN const& a, Lane b, Vec3xN const& c){ return Vec3xN(Ops::MulAdd(a.m_x, b, c.m_x), Ops::MulAdd(a.m_y, b, c.m_y), Ops::MulAdd(a.m_z, b, c.m_z)); }
+
+	static int		GetMaskBits(Lane mask)							{ return Ops::GetMaskBits(mask); }
+	static bool		IsAnyLaneSet(Lane mask)							{ return Ops::GetMaskBits(mask) != 0; }
+	static bool		AreAllLanesSet(Lane mask)						{ return Ops::GetMaskBits(mask) == ALL_LANES_MASK; }
+};
+
+typedef Vec3xN<Float4Ops> Vec3x4;
+typedef Vec3xN<Float8Ops> Vec3x8;
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename Ops>
+inline typename Ops::Type DotProduct3D(Vec3xN<Ops> const& a, Vec3xN<Ops> const& b)
+{
+	return Ops::MulAdd(a.m_x, b.m_x, Ops::MulAdd(a.m_y, b.m_y, Ops::Mul(a.m_z, b.m_z)));
+}
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename Ops>
+inline Vec3xN<Ops> CrossProduct3D(Vec3xN<Ops> const& a, Vec3xN<Ops> const& b)
+{
+	return Vec3xN<Ops>(Ops::Sub(Ops::Mul(a.m_y, b.m_z), Ops::Mul(a.m_z, b.m_y)),
+					   Ops::Sub(Ops::Mul(a.m_z, b.m_x), Ops::Mul(a.m_x, b.m_z)),
+					   Ops::Sub(Ops::Mul(a.m_x, b.m_y), Ops::Mul(a.m_y, b.m_x)));
+}
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename Ops>
+inline Vec3xN<Ops> Vec3xN<Ops>::GetNormalized() const
+{
+	Lane length = GetLength();
+	Lane isNonZero = Ops::CmpGt(length, Ops::Zero());
+	Lane invLength = Ops::Select(isNonZero, Ops::Div(Ops::Splat(1.f), length), Ops::Zero());
+
+	return *this * invLength;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename Ops>
+inline Vec3xN<Ops> Vec3xN<Ops>::Select(Lane mask, Vec3xN const& ifTrue, Vec3xN const& ifFalse)
+{
+	return Vec3xN(Ops::Select(mask, ifTrue.m_x, ifFalse.m_x), Ops::Select(mask, ifTrue.m_y, ifFalse.m_y), Ops::Select(mask, ifTrue.m_z, ifFalse.m_z));
+}
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename Ops>
+inline Vec3xN<Ops> Vec3xN<Ops>::Gather(std::vector<Vec3> const& points, int startIndex)
+{
+	float xs[WIDTH] = {};
+	float ys[WIDTH] = {};
+	float zs[WIDTH] = {};
+
+	int numLanes = static_cast<int>(points.size()) - startIndex;
+	numLanes = numLanes < WIDTH ? numLanes : WIDTH;
+
+	for(int lane = 0; lane < numLanes; ++lane)
+	{
+		Vec3 const& point = points[startIndex + lane];
+		xs[lane] = point.x;
+		ys[lane] = point.y;
+		zs[lane] = point.z;
+	}
+
+	return LoadSoA(xs, ys, zs);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename Ops>
+inline Vec3xN<Ops> Vec3xN<Ops>::GatherIndexed(std::vector<Vec3> const& points, int const* indices, int numIndices)
+{
+	float xs[WIDTH] = {};
+	float ys[WIDTH] = {};
+	float zs[WIDTH] = {};
+
+	int numLanes = numIndices < WIDTH ? numIndices : WIDTH;
+
+	for(int lane = 0; lane < numLanes; ++lane)
+	{
+		Vec3 const& point = points[indices[lane]];
+		xs[lane] = point.x;
+		ys[lane] = point.y;
+		zs[lane] = point.z;
+	}
+
+	return LoadSoA(xs, ys, zs);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename Ops>
+inline void Vec3xN<Ops>::Scatter(std::vector<Vec3>& out_points, int startIndex, int laneMask) const
+{
+	float xs[WIDTH];
+	float ys[WIDTH];
+	float zs[WIDTH];
+	StoreSoA(xs, ys, zs);
+
+	int numLanes = static_cast<int>(out_points.size()) - startIndex;
+	numLanes = numLanes < WIDTH ? numLanes : WIDTH;
+
+	for(int lane = 0; lane < numLanes; ++lane)
+	{
+		if(laneMask & (1 << lane))
+		{
+			out_points[startIndex + lane] = Vec3(xs[lane], ys[lane], zs[lane]);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename Ops>
+inline void Vec3xN<Ops>::ScatterIndexed(std::vector<Vec3>& out_points, int const* indices, int numIndices, int laneMask) const
+{
+	float xs[WIDTH];
+	float ys[WIDTH];
+	float zs[WIDTH];
+	StoreSoA(xs, ys, zs);
+
+	int numLanes = numIndices < WIDTH ? numIndices : WIDTH;
+
+	for(int lane = 0; lane < numLanes; ++lane)
+	{
+		if(laneMask & (1 << lane))
+		{
+			out_points[indices[lane]] = Vec3(xs[lane], ys[lane], zs[lane]);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename Ops>
+inline Vec3 Vec3xN<Ops>::GetLane(int lane) const
+{
+	float xs[WIDTH];
+	float ys[WIDTH];
+	float zs[WIDTH];
+	StoreSoA(xs, ys, zs);
+
+	return Vec3(xs[lane], ys[lane], zs[lane]);
+}
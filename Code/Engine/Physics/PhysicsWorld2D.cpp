@@ -0,0 +1,918 @@
+#include "Engine/Physics/PhysicsWorld2D.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/JobSystem/Job.hpp"
+#include "Engine/JobSystem/JobSystem.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/OBB2.hpp"
+
+#include <algorithm>
+#include <math.h>
+
+//------------------------------------------------------------------------------------------------------------------
+constexpr int MIN_PAIRS_PER_NARROWPHASE_JOB = 1024;
+constexpr int MIN_CONTACTS_PER_SOLVE_JOB = 512;
+constexpr float PI_FLOAT = 3.14159265f;
+constexpr float MAX_BLOCK_CONDITION_NUMBER = 1000.f;
+
+//------------------------------------------------------------------------------------------------------------------
+class PhysicsWorld2DJob : public Job
+{
+public:
+	virtual void Execute() override
+	{
+		if(m_phase == PhysicsWorld2D::JobPhase::NARROWPHASE)
+		{
+			m_world->ComputeContactRange(m_start, m_end);
+		}
+		else
+		{
+			m_world->SolveIslandRange(m_start, m_end);
+		}
+	}
+
+public:
+	PhysicsWorld2D*				m_world = nullptr;
+	PhysicsWorld2D::JobPhase	m_phase = PhysicsWorld2D::JobPhase::NARROWPHASE;
+	int							m_start = 0;
+	int							m_end = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+template<typename ValueType>
+static void RemoveSwapBack(std::vector<ValueType>& values, int index)
+{
+	values[index] = values.back();
+	values.pop_back();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Velocity of a point at offset r from a center spinning at angularVelocity radians per second.
+static Vec2 GetRotationalVelocity(float angularVelocity, Vec2 const& r)
+{
+	return Vec2(-angularVelocity * r.y, angularVelocity * r.x);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+static Vec2 GetContactTangent(Vec2 const& normal)
+{
+	return Vec2(normal.y, -normal.x);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+struct BodyPairKeyLess
+{
+	template<typename PairType>
+	bool operator()(PairType const& pairA, PairType const& pairB) const
+	{
+		return pairA.m_key < pairB.m_key;
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------
+PhysicsWorld2D::PhysicsWorld2D(PhysicsWorld2DConfig const& config)
+	: m_config(config)
+	, m_grid(config.m_broadphaseCellSize)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void PhysicsWorld2D::Startup()
+{
+	GUARANTEE_OR_DIE(m_config.m_broadphaseCellSize > 0.f, "PhysicsWorld2D needs a positive broadphase cell size");
+	GUARANTEE_OR_DIE(m_config.m_numVelocityIterations > 0, "PhysicsWorld2D needs at least one velocity iteration");
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void PhysicsWorld2D::Shutdown()
+{
+	RemoveAllBodies();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void PhysicsWorld2D::Step(float deltaSeconds)
+{
+	if(deltaSeconds <= 0.f)
+	{
+		return;
+	}
+	m_deltaSeconds = deltaSeconds;
+
+	Vec2 gravityImpulse = m_config.m_gravity * deltaSeconds;
+	for(int bodyIndex = 0; bodyIndex < GetNumBodies(); ++bodyIndex)
+	{
+		if(IsDynamic(bodyIndex))
+		{
+			m_linearVelocities[bodyIndex] += gravityImpulse;
+		}
+	}
+
+	FindCandidatePairs();
+	BuildContacts();
+	BuildIslands();
+
+	// consecutive islands are grouped into ranges of roughly equal contact counts
+	int numIslands = GetNumIslands();
+	int numContacts = GetNumContacts();
+	m_rangeStarts.clear();
+	m_rangeStarts.push_back(0);
+	if(numIslands > 0)
+	{
+		std::vector<int> evenSplit;
+		SplitIntoJobRanges(0, numContacts, MIN_CONTACTS_PER_SOLVE_JOB, m_config.m_jobSystem, evenSplit);
+		int numRanges = static_cast<int>(evenSplit.size()) - 1;
+		for(int islandIndex = 1; islandIndex < numIslands; ++islandIndex)
+		{
+			int rangeIndex = static_cast<int>(m_rangeStarts.size());
+			if(rangeIndex < numRanges && m_islandStarts[islandIndex] >= evenSplit[rangeIndex])
+			{
+				m_rangeStarts.push_back(islandIndex);
+			}
+		}
+	}
+	m_rangeStarts.push_back(numIslands);
+	RunJobRanges(JobPhase::SOLVE_ISLANDS, m_rangeStarts);
+
+	IntegratePositions(deltaSeconds);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+PhysicsBodyID2D PhysicsWorld2D::AddBody(PhysicsBodyDefinition2D const& definition)
+{
+	PhysicsBodyID2D bodyID;
+	if(!m_freeIDs.empty())
+	{
+		bodyID = m_freeIDs.back();
+		m_freeIDs.pop_back();
+	}
+	else
+	{
+		bodyID = static_cast<PhysicsBodyID2D>(m_denseIndexes.size());
+		m_denseIndexes.push_back(-1);
+	}
+
+	int bodyIndex = GetNumBodies();
+	m_denseIndexes[bodyID] = bodyIndex;
+
+	float sine;
+	float cosine;
+	SinCosDegrees(definition.m_orientationDegrees, sine, cosine);
+	bool isDisc = definition.m_shapeType == PhysicsShapeType2D::DISC;
+
+	m_bodyIDs.push_back(bodyID);
+	m_positions.push_back(definition.m_position);
+	m_rotations.push_back(Vec2(cosine, sine));
+	m_linearVelocities.push_back(definition.m_linearVelocity);
+	m_angularVelocities.push_back(ConvertDegreesToRadians(definition.m_angularVelocityDegrees));
+	m_inverseMasses.push_back(0.f);
+	m_inverseInertias.push_back(0.f);
+	m_shapeTypes.push_back(definition.m_shapeType);
+	m_shapeExtents.push_back(isDisc ? Vec2(definition.m_radius, definition.m_radius) : definition.m_halfDimensions);
+	m_frictions.push_back(definition.m_friction);
+	m_restitutions.push_back(definition.m_restitution);
+	m_userDatas.push_back(definition.m_userData);
+
+	SetMassFromShape(bodyIndex, definition.m_density);
+	if(!IsDynamic(bodyIndex))
+	{
+		m_linearVelocities[bodyIndex] = Vec2();
+		m_angularVelocities[bodyIndex] = 0.f;
+	}
+
+	return bodyID;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void PhysicsWorld2D::RemoveBody(PhysicsBodyID2D bodyID)
+{
+	int bodyIndex = GetDenseIndex(bodyID);
+
+	RemoveSwapBack(m_bodyIDs, bodyIndex);
+	RemoveSwapBack(m_positions, bodyIndex);
+	RemoveSwapBack(m_rotations, bodyIndex);
+	RemoveSwapBack(m_linearVelocities, bodyIndex);
+	RemoveSwapBack(m_angularVelocities, bodyIndex);
+	RemoveSwapBack(m_inverseMasses, bodyIndex);
+	RemoveSwapBack(m_inverseInertias, bodyIndex);
+	RemoveSwapBack(m_shapeTypes, bodyIndex);
+	RemoveSwapBack(m_shapeExtents, bodyIndex);
+	RemoveSwapBack(m_frictions, bodyIndex);
+	RemoveSwapBack(m_restitutions, bodyIndex);
+	RemoveSwapBack(m_userDatas, bodyIndex);
+
+	if(bodyIndex < GetNumBodies())
+	{
+		m_denseIndexes[m_bodyIDs[bodyIndex]] = bodyIndex;
+	}
+	m_denseIndexes[bodyID] = -1;
+	m_freeIDs.push_back(bodyID);
+
+	// drop its contacts so a new body reusing the ID does not inherit their impulses
+	int numKept = 0;
+	for(int contactIndex = 0; contactIndex < GetNumContacts(); ++contactIndex)
+	{
+		uint64_t key = m_contacts[contactIndex].m_key;
+		if(static_cast<PhysicsBodyID2D>(key >> 32) != bodyID && static_cast<PhysicsBodyID2D>(key & 0xFFFFFFFFu) != bodyID)
+		{
+			m_contacts[numKept++] = m_contacts[contactIndex];
+		}
+	}
+	m_contacts.resize(numKept);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void PhysicsWorld2D::RemoveAllBodies()
+{
+	m_bodyIDs.clear();
+	m_positions.clear();
+	m_rotations.clear();
+	m_linearVelocities.clear();
+	m_angularVelocities.clear();
+	m_inverseMasses.clear();
+	m_inverseInertias.clear();
+	m_shapeTypes.clear();
+	m_shapeExtents.clear();
+	m_frictions.clear();
+	m_restitutions.clear();
+	m_userDatas.clear();
+	m_denseIndexes.clear();
+	m_freeIDs.clear();
+	m_contacts.clear();
+	m_previousContacts.clear();
+	m_islandStarts.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool PhysicsWorld2D::IsBodyValid(PhysicsBodyID2D bodyID) const
+{
+	return bodyID >= 0 && bodyID < static_cast<int>(m_denseIndexes.size()) && m_denseIndexes[bodyID] >= 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool PhysicsWorld2D::IsBodyStatic(PhysicsBodyID2D bodyID) const
+{
+	return !IsDynamic(GetDenseIndex(bodyID));
+}
+
+//------------------------------------------------------------------------------------------------------------------
+Vec2 PhysicsWorld2D::GetPosition(PhysicsBodyID2D bodyID) const
+{
+	return m_positions[GetDenseIndex(bodyID)];
+}
+
+//------------------------------------------------------------------------------------------------------------------
+float PhysicsWorld2D::GetOrientationDegrees(PhysicsBodyID2D bodyID) const
+{
+	Vec2 const& rotation = m_rotations[GetDenseIndex(bodyID)];
+	return ATan2Degrees(rotation.y, rotation.x);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+Vec2 PhysicsWorld2D::GetLinearVelocity(PhysicsBodyID2D bodyID) const
+{
+	return m_linearVelocities[GetDenseIndex(bodyID)];
+}
+
+//------------------------------------------------------------------------------------------------------------------
+float PhysicsWorld2D::GetAngularVelocityDegrees(PhysicsBodyID2D bodyID) const
+{
+	return ConvertRadiansToDegrees(m_angularVelocities[GetDenseIndex(bodyID)]);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void* PhysicsWorld2D::GetUserData(PhysicsBodyID2D bodyID) const
+{
+	return m_userDatas[GetDenseIndex(bodyID)];
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void PhysicsWorld2D::SetTransform(PhysicsBodyID2D bodyID, Vec2 const& position, float orientationDegrees)
+{
+	int bodyIndex = GetDenseIndex(bodyID);
+
+	float sine;
+	float cosine;
+	SinCosDegrees(orientationDegrees, sine, cosine);
+	m_positions[bodyIndex] = position;
+	m_rotations[bodyIndex] = Vec2(cosine, sine);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void PhysicsWorld2D::SetLinearVelocity(PhysicsBodyID2D bodyID, Vec2 const& linearVelocity)
+{
+	int bodyIndex = GetDenseIndex(bodyID);
+	if(IsDynamic(bodyIndex))
+	{
+		m_linearVelocities[bodyIndex] = linearVelocity;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void PhysicsWorld2D::SetAngularVelocityDegrees(PhysicsBodyID2D bodyID, float angularVelocityDegrees)
+{
+	int bodyIndex = GetDenseIndex(bodyID);
+	if(IsDynamic(bodyIndex))
+	{
+		m_angularVelocities[bodyIndex] = ConvertDegreesToRadians(angularVelocityDegrees);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void PhysicsWorld2D::ApplyLinearImpulse(PhysicsBodyID2D bodyID, Vec2 const& impulse, Vec2 const& worldPoint)
+{
+	int bodyIndex = GetDenseIndex(bodyID);
+	m_linearVelocities[bodyIndex] += impulse * m_inverseMasses[bodyIndex];
+	m_angularVelocities[bodyIndex] += m_inverseInertias[bodyIndex] * CrossProduct2D(worldPoint - m_positions[bodyIndex], impulse);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int PhysicsWorld2D::GetDenseIndex(PhysicsBodyID2D bodyID) const
+{
+	GUARANTEE_OR_DIE(IsBodyValid(bodyID), "PhysicsWorld2D was given a body ID that was never added or has been removed");
+	return m_denseIndexes[bodyID];
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void PhysicsWorld2D::SetMassFromShape(int bodyIndex, float density)
+{
+	if(density <= 0.f)
+	{
+		m_inverseMasses[bodyIndex] = 0.f;
+		m_inverseInertias[bodyIndex] = 0.f;
+		return;
+	}
+
+	Vec2 const& extents = m_shapeExtents[bodyIndex];
+	float mass;
+	float inertia;
+	if(m_shapeTypes[bodyIndex] == PhysicsShapeType2D::DISC)
+	{
+		mass = density * PI_FLOAT * extents.x * extents.x;
+		inertia = 0.5f * mass * extents.x * extents.x;
+	}
+	else
+	{
+		mass = density * 4.f * extents.x * extents.y;
+		inertia = mass * ((extents.x * extents.x) + (extents.y * extents.y)) / 3.f;
+	}
+
+	m_inverseMasses[bodyIndex] = 1.f / mass;
+	m_inverseInertias[bodyIndex] = 1.f / inertia;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+float PhysicsWorld2D::GetBoundingRadius(int bodyIndex) const
+{
+	Vec2 const& extents = m_shapeExtents[bodyIndex];
+	return (m_shapeTypes[bodyIndex] == PhysicsShapeType2D::DISC) ? extents.x : extents.GetLength();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Dynamic bodies pair up through the grid. Static bodies are left out of it (a long floor would widen every query)
+// and instead look up the dynamic bodies under their own bounds.
+void PhysicsWorld2D::FindCandidatePairs()
+{
+	m_gridBodyIndexes.clear();
+	m_gridCenters.clear();
+	m_gridRadii.clear();
+	for(int bodyIndex = 0; bodyIndex < GetNumBodies(); ++bodyIndex)
+	{
+		if(IsDynamic(bodyIndex))
+		{
+			m_gridBodyIndexes.push_back(bodyIndex);
+			m_gridCenters.push_back(m_positions[bodyIndex]);
+			m_gridRadii.push_back(GetBoundingRadius(bodyIndex));
+		}
+	}
+
+	m_grid.Rebuild(m_gridCenters, m_gridRadii);
+	m_gridPairs.clear();
+	m_grid.FindOverlappingPairs(m_gridPairs, m_config.m_speculativeDistance);
+
+	m_candidatePairs.clear();
+	for(SpatialHashPair2D const& gridPair : m_gridPairs)
+	{
+		BodyPair2D pair;
+		pair.m_bodyA = m_gridBodyIndexes[gridPair.m_discA];
+		pair.m_bodyB = m_gridBodyIndexes[gridPair.m_discB];
+		m_candidatePairs.push_back(pair);
+	}
+
+	for(int bodyIndex = 0; bodyIndex < GetNumBodies(); ++bodyIndex)
+	{
+		if(IsDynamic(bodyIndex))
+		{
+			continue;
+		}
+
+		Vec2 halfSize = m_shapeExtents[bodyIndex];
+		if(m_shapeTypes[bodyIndex] == PhysicsShapeType2D::BOX)
+		{
+			Vec2 const& rotation = m_rotations[bodyIndex];
+			halfSize = Vec2((fabsf(rotation.x) * halfSize.x) + (fabsf(rotation.y) * halfSize.y), (fabsf(rotation.y) * halfSize.x) + (fabsf(rotation.x) * halfSize.y));
+		}
+		halfSize += Vec2(m_config.m_speculativeDistance, m_config.m_speculativeDistance);
+
+		m_queryResults.clear();
+		m_grid.QueryAABB2(AABB2(m_positions[bodyIndex] - halfSize, m_positions[bodyIndex] + halfSize), m_queryResults);
+		for(int gridIndex : m_queryResults)
+		{
+			BodyPair2D pair;
+			pair.m_bodyA = bodyIndex;
+			pair.m_bodyB = m_gridBodyIndexes[gridIndex];
+			m_candidatePairs.push_back(pair);
+		}
+	}
+
+	// order by body IDs, lower ID as A, so contacts line up with last step's and the results do not depend on the grid
+	for(BodyPair2D& pair : m_candidatePairs)
+	{
+		if(m_bodyIDs[pair.m_bodyA] > m_bodyIDs[pair.m_bodyB])
+		{
+			std::swap(pair.m_bodyA, pair.m_bodyB);
+		}
+		pair.m_key = (static_cast<uint64_t>(m_bodyIDs[pair.m_bodyA]) << 32) | static_cast<uint64_t>(m_bodyIDs[pair.m_bodyB]);
+	}
+	std::sort(m_candidatePairs.begin(), m_candidatePairs.end(), BodyPairKeyLess());
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void PhysicsWorld2D::BuildContacts()
+{
+	int numPairs = static_cast<int>(m_candidatePairs.size());
+	m_candidateManifolds.resize(numPairs);
+	SplitIntoJobRanges(0, numPairs, MIN_PAIRS_PER_NARROWPHASE_JOB, m_config.m_jobSystem, m_rangeStarts);
+	RunJobRanges(JobPhase::NARROWPHASE, m_rangeStarts);
+
+	std::swap(m_previousContacts, m_contacts);
+	m_contacts.clear();
+
+	int previousIndex = 0;
+	int numPrevious = static_cast<int>(m_previousContacts.size());
+	for(int pairIndex = 0; pairIndex < numPairs; ++pairIndex)
+	{
+		ContactManifold2D const& manifold = m_candidateManifolds[pairIndex];
+		if(manifold.m_numPoints == 0)
+		{
+			continue;
+		}
+
+		BodyPair2D const& pair = m_candidatePairs[pairIndex];
+		ContactConstraint2D contact;
+		contact.m_key = pair.m_key;
+		contact.m_bodyA = pair.m_bodyA;
+		contact.m_bodyB = pair.m_bodyB;
+		contact.m_normal = manifold.m_normal;
+		contact.m_friction = sqrtf(m_frictions[pair.m_bodyA] * m_frictions[pair.m_bodyB]);
+		contact.m_restitution = GetMax(m_restitutions[pair.m_bodyA], m_restitutions[pair.m_bodyB]);
+		contact.m_numPoints = manifold.m_numPoints;
+		for(int pointIndex = 0; pointIndex < manifold.m_numPoints; ++pointIndex)
+		{
+			ContactPoint2D const& manifoldPoint = manifold.m_points[pointIndex];
+			ContactPointConstraint2D& point = contact.m_points[pointIndex];
+			point.m_anchorA = manifoldPoint.m_position - m_positions[pair.m_bodyA];
+			point.m_anchorB = manifoldPoint.m_position - m_positions[pair.m_bodyB];
+			point.m_separation = manifoldPoint.m_separation;
+			point.m_featureKey = manifoldPoint.m_featureKey;
+		}
+
+		// both lists are sorted by key, so last step's contact for this pair is found by walking forward
+		while(previousIndex < numPrevious && m_previousContacts[previousIndex].m_key < contact.m_key)
+		{
+			++previousIndex;
+		}
+
+		if(previousIndex < numPrevious && m_previousContacts[previousIndex].m_key == contact.m_key)
+		{
+			ContactConstraint2D const& previous = m_previousContacts[previousIndex];
+			for(int pointIndex = 0; pointIndex < contact.m_numPoints; ++pointIndex)
+			{
+				ContactPointConstraint2D& point = contact.m_points[pointIndex];
+				for(int previousPointIndex = 0; previousPointIndex < previous.m_numPoints; ++previousPointIndex)
+				{
+					if(previous.m_points[previousPointIndex].m_featureKey == point.m_featureKey)
+					{
+						point.m_normalImpulse = previous.m_points[previousPointIndex].m_normalImpulse;
+						point.m_tangentImpulse = previous.m_points[previousPointIndex].m_tangentImpulse;
+						break;
+					}
+				}
+			}
+		}
+
+		m_contacts.push_back(contact);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void PhysicsWorld2D::ComputeContactRange(int firstPair, int endPair)
+{
+	float speculativeDistance = m_config.m_speculativeDistance;
+
+	for(int pairIndex = firstPair; pairIndex < endPair; ++pairIndex)
+	{
+		BodyPair2D const& pair = m_candidatePairs[pairIndex];
+		ContactManifold2D& manifold = m_candidateManifolds[pairIndex];
+		int bodyA = pair.m_bodyA;
+		int bodyB = pair.m_bodyB;
+		bool isDiscA = m_shapeTypes[bodyA] == PhysicsShapeType2D::DISC;
+		bool isDiscB = m_shapeTypes[bodyB] == PhysicsShapeType2D::DISC;
+
+		if(isDiscA && isDiscB)
+		{
+			GetDiscVsDiscManifold2D(m_positions[bodyA], m_shapeExtents[bodyA].x, m_positions[bodyB], m_shapeExtents[bodyB].x, manifold, speculativeDistance);
+		}
+		else if(isDiscA)
+		{
+			OBB2 boxB(m_positions[bodyB], m_rotations[bodyB], m_shapeExtents[bodyB]);
+			GetDiscVsOBB2Manifold2D(m_positions[bodyA], m_shapeExtents[bodyA].x, boxB, manifold, speculativeDistance);
+		}
+		else if(isDiscB)
+		{
+			OBB2 boxA(m_positions[bodyA], m_rotations[bodyA], m_shapeExtents[bodyA]);
+			GetDiscVsOBB2Manifold2D(m_positions[bodyB], m_shapeExtents[bodyB].x, boxA, manifold, speculativeDistance);
+			manifold.m_normal = -manifold.m_normal;
+		}
+		else
+		{
+			OBB2 boxA(m_positions[bodyA], m_rotations[bodyA], m_shapeExtents[bodyA]);
+			OBB2 boxB(m_positions[bodyB], m_rotations[bodyB], m_shapeExtents[bodyB]);
+			GetOBB2VsOBB2Manifold2D(boxA, boxB, manifold, speculativeDistance);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Union-find over the contacts between dynamic bodies, then a counting sort of the contacts by island. Islands are
+// numbered in contact order, which is body ID order, so the grouping is the same every run.
+void PhysicsWorld2D::BuildIslands()
+{
+	int numBodies = GetNumBodies();
+	int numContacts = GetNumContacts();
+
+	m_islandParents.resize(numBodies);
+	for(int bodyIndex = 0; bodyIndex < numBodies; ++bodyIndex)
+	{
+		m_islandParents[bodyIndex] = bodyIndex;
+	}
+
+	for(ContactConstraint2D const& contact : m_contacts)
+	{
+		if(!IsDynamic(contact.m_bodyA) || !IsDynamic(contact.m_bodyB))
+		{
+			continue;
+		}
+
+		int rootA = FindIslandRoot(contact.m_bodyA);
+		int rootB = FindIslandRoot(contact.m_bodyB);
+		if(rootA != rootB)
+		{
+			m_islandParents[GetMax(rootA, rootB)] = GetMin(rootA, rootB);
+		}
+	}
+
+	m_islandIndexes.assign(numBodies, -1);
+	m_contactIslands.resize(numContacts);
+	int numIslands = 0;
+	for(int contactIndex = 0; contactIndex < numContacts; ++contactIndex)
+	{
+		ContactConstraint2D const& contact = m_contacts[contactIndex];
+		int dynamicBody = IsDynamic(contact.m_bodyA) ? contact.m_bodyA : contact.m_bodyB;
+		int root = FindIslandRoot(dynamicBody);
+		if(m_islandIndexes[root] < 0)
+		{
+			m_islandIndexes[root] = numIslands++;
+		}
+		m_contactIslands[contactIndex] = m_islandIndexes[root];
+	}
+
+	m_islandStarts.assign(numIslands + 1, 0);
+	for(int contactIndex = 0; contactIndex < numContacts; ++contactIndex)
+	{
+		++m_islandStarts[m_contactIslands[contactIndex] + 1];
+	}
+	for(int islandIndex = 0; islandIndex < numIslands; ++islandIndex)
+	{
+		m_islandStarts[islandIndex + 1] += m_islandStarts[islandIndex];
+	}
+
+	// m_rangeStarts is free again, so it serves as the per-island write cursor
+	m_rangeStarts.assign(m_islandStarts.begin(), m_islandStarts.end() - 1);
+	m_islandContacts.resize(numContacts);
+	for(int contactIndex = 0; contactIndex < numContacts; ++contactIndex)
+	{
+		m_islandContacts[m_rangeStarts[m_contactIslands[contactIndex]]++] = contactIndex;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int PhysicsWorld2D::FindIslandRoot(int bodyIndex)
+{
+	while(m_islandParents[bodyIndex] != bodyIndex)
+	{
+		m_islandParents[bodyIndex] = m_islandParents[m_islandParents[bodyIndex]];
+		bodyIndex = m_islandParents[bodyIndex];
+	}
+	return bodyIndex;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void PhysicsWorld2D::RunJobRanges(JobPhase phase, std::vector<int> const& rangeStarts)
+{
+	int numRanges = static_cast<int>(rangeStarts.size()) - 1;
+	if(numRanges <= 0)
+	{
+		return;
+	}
+
+	std::vector<PhysicsWorld2DJob> jobs(numRanges);
+	for(int rangeIndex = 0; rangeIndex < numRanges; ++rangeIndex)
+	{
+		PhysicsWorld2DJob& job = jobs[rangeIndex];
+		job.m_world = this;
+		job.m_phase = phase;
+		job.m_start = rangeStarts[rangeIndex];
+		job.m_end = rangeStarts[rangeIndex + 1];
+	}
+
+	if(numRanges == 1)
+	{
+		jobs[0].Execute();
+		return;
+	}
+
+	m_config.m_jobSystem->ExecuteJobsAndWait(jobs);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Islands share no dynamic bodies and static bodies are never written, so ranges of islands can run at the same time.
+void PhysicsWorld2D::SolveIslandRange(int firstIsland, int endIsland)
+{
+	for(int islandIndex = firstIsland; islandIndex < endIsland; ++islandIndex)
+	{
+		int firstContact = m_islandStarts[islandIndex];
+		int endContact = m_islandStarts[islandIndex + 1];
+
+		for(int orderIndex = firstContact; orderIndex < endContact; ++orderIndex)
+		{
+			ContactConstraint2D& contact = m_contacts[m_islandContacts[orderIndex]];
+			PrepareContact(contact);
+			WarmStartContact(contact);
+		}
+
+		for(int iteration = 0; iteration < m_config.m_numVelocityIterations; ++iteration)
+		{
+			for(int orderIndex = firstContact; orderIndex < endContact; ++orderIndex)
+			{
+				SolveContact(m_contacts[m_islandContacts[orderIndex]]);
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Works out each point's effective masses and the normal speed the solver aims for: closing no faster than the gap
+// allows for a speculative point, separating at a fraction of the overlap beyond the allowed penetration otherwise,
+// and at least the bounce speed after a hard enough impact.
+void PhysicsWorld2D::PrepareContact(ContactConstraint2D& contact) const
+{
+	int bodyA = contact.m_bodyA;
+	int bodyB = contact.m_bodyB;
+	float inverseMassA = m_inverseMasses[bodyA];
+	float inverseMassB = m_inverseMasses[bodyB];
+	float inverseInertiaA = m_inverseInertias[bodyA];
+	float inverseInertiaB = m_inverseInertias[bodyB];
+	Vec2 normal = contact.m_normal;
+	Vec2 tangent = GetContactTangent(normal);
+	float inverseDeltaSeconds = 1.f / m_deltaSeconds;
+
+	for(int pointIndex = 0; pointIndex < contact.m_numPoints; ++pointIndex)
+	{
+		ContactPointConstraint2D& point = contact.m_points[pointIndex];
+
+		float anchorACrossNormal = CrossProduct2D(point.m_anchorA, normal);
+		float anchorBCrossNormal = CrossProduct2D(point.m_anchorB, normal);
+		float normalMass = inverseMassA + inverseMassB + (inverseInertiaA * anchorACrossNormal * anchorACrossNormal) + (inverseInertiaB * anchorBCrossNormal * anchorBCrossNormal);
+		point.m_normalMass = (normalMass > 0.f) ? 1.f / normalMass : 0.f;
+
+		float anchorACrossTangent = CrossProduct2D(point.m_anchorA, tangent);
+		float anchorBCrossTangent = CrossProduct2D(point.m_anchorB, tangent);
+		float tangentMass = inverseMassA + inverseMassB + (inverseInertiaA * anchorACrossTangent * anchorACrossTangent) + (inverseInertiaB * anchorBCrossTangent * anchorBCrossTangent);
+		point.m_tangentMass = (tangentMass > 0.f) ? 1.f / tangentMass : 0.f;
+
+		if(point.m_separation > 0.f)
+		{
+			point.m_targetNormalSpeed = -point.m_separation * inverseDeltaSeconds;
+		}
+		else
+		{
+			float correctionSpeed = m_config.m_penetrationCorrection * GetMax(-point.m_separation - m_config.m_allowedPenetration, 0.f) * inverseDeltaSeconds;
+			point.m_targetNormalSpeed = GetMin(correctionSpeed, m_config.m_maxCorrectionSpeed);
+		}
+
+		Vec2 relativeVelocity = m_linearVelocities[bodyB] + GetRotationalVelocity(m_angularVelocities[bodyB], point.m_anchorB)
+							  - m_linearVelocities[bodyA] - GetRotationalVelocity(m_angularVelocities[bodyA], point.m_anchorA);
+		float normalSpeed = DotProduct2D(relativeVelocity, normal);
+		if(normalSpeed < -m_config.m_restitutionThreshold)
+		{
+			point.m_targetNormalSpeed = GetMax(point.m_targetNormalSpeed, -contact.m_restitution * normalSpeed);
+		}
+	}
+
+	// solving two points one after the other always favors the first, which slowly tips over tall stacks
+	contact.m_isBlockSolved = false;
+	if(contact.m_numPoints == 2)
+	{
+		ContactPointConstraint2D const& point1 = contact.m_points[0];
+		ContactPointConstraint2D const& point2 = contact.m_points[1];
+		float anchorA1CrossNormal = CrossProduct2D(point1.m_anchorA, normal);
+		float anchorB1CrossNormal = CrossProduct2D(point1.m_anchorB, normal);
+		float anchorA2CrossNormal = CrossProduct2D(point2.m_anchorA, normal);
+		float anchorB2CrossNormal = CrossProduct2D(point2.m_anchorB, normal);
+
+		float k11 = inverseMassA + inverseMassB + (inverseInertiaA * anchorA1CrossNormal * anchorA1CrossNormal) + (inverseInertiaB * anchorB1CrossNormal * anchorB1CrossNormal);
+		float k22 = inverseMassA + inverseMassB + (inverseInertiaA * anchorA2CrossNormal * anchorA2CrossNormal) + (inverseInertiaB * anchorB2CrossNormal * anchorB2CrossNormal);
+		float k12 = inverseMassA + inverseMassB + (inverseInertiaA * anchorA1CrossNormal * anchorA2CrossNormal) + (inverseInertiaB * anchorB1CrossNormal * anchorB2CrossNormal);
+		float determinant = (k11 * k22) - (k12 * k12);
+
+		// nearly parallel rows (points almost on top of each other) make the inverse meaningless
+		if(k11 * k11 < MAX_BLOCK_CONDITION_NUMBER * determinant)
+		{
+			float inverseDeterminant = 1.f / determinant;
+			contact.m_isBlockSolved = true;
+			contact.m_blockK[0] = k11;
+			contact.m_blockK[1] = k12;
+			contact.m_blockK[2] = k22;
+			contact.m_blockInverseK[0] = k22 * inverseDeterminant;
+			contact.m_blockInverseK[1] = -k12 * inverseDeterminant;
+			contact.m_blockInverseK[2] = k11 * inverseDeterminant;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void PhysicsWorld2D::WarmStartContact(ContactConstraint2D const& contact)
+{
+	int bodyA = contact.m_bodyA;
+	int bodyB = contact.m_bodyB;
+	Vec2 tangent = GetContactTangent(contact.m_normal);
+
+	for(int pointIndex = 0; pointIndex < contact.m_numPoints; ++pointIndex)
+	{
+		ContactPointConstraint2D const& point = contact.m_points[pointIndex];
+		Vec2 impulse = (contact.m_normal * point.m_normalImpulse) + (tangent * point.m_tangentImpulse);
+
+		if(IsDynamic(bodyA))
+		{
+			m_linearVelocities[bodyA] -= impulse * m_inverseMasses[bodyA];
+			m_angularVelocities[bodyA] -= m_inverseInertias[bodyA] * CrossProduct2D(point.m_anchorA, impulse);
+		}
+		if(IsDynamic(bodyB))
+		{
+			m_linearVelocities[bodyB] += impulse * m_inverseMasses[bodyB];
+			m_angularVelocities[bodyB] += m_inverseInertias[bodyB] * CrossProduct2D(point.m_anchorB, impulse);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Friction first, clamped by the normal impulse so far, then the non-penetration impulse, which may only push.
+void PhysicsWorld2D::SolveContact(ContactConstraint2D& contact)
+{
+	int bodyA = contact.m_bodyA;
+	int bodyB = contact.m_bodyB;
+	float inverseMassA = m_inverseMasses[bodyA];
+	float inverseMassB = m_inverseMasses[bodyB];
+	float inverseInertiaA = m_inverseInertias[bodyA];
+	float inverseInertiaB = m_inverseInertias[bodyB];
+	Vec2 linearVelocityA = m_linearVelocities[bodyA];
+	Vec2 linearVelocityB = m_linearVelocities[bodyB];
+	float angularVelocityA = m_angularVelocities[bodyA];
+	float angularVelocityB = m_angularVelocities[bodyB];
+	Vec2 normal = contact.m_normal;
+	Vec2 tangent = GetContactTangent(normal);
+
+	for(int pointIndex = 0; pointIndex < contact.m_numPoints; ++pointIndex)
+	{
+		ContactPointConstraint2D& point = contact.m_points[pointIndex];
+
+		Vec2 relativeVelocity = linearVelocityB + GetRotationalVelocity(angularVelocityB, point.m_anchorB) - linearVelocityA - GetRotationalVelocity(angularVelocityA, point.m_anchorA);
+		float maxFriction = contact.m_friction * point.m_normalImpulse;
+		float newTangentImpulse = GetClamped(point.m_tangentImpulse - (point.m_tangentMass * DotProduct2D(relativeVelocity, tangent)), -maxFriction, maxFriction);
+		Vec2 impulse = tangent * (newTangentImpulse - point.m_tangentImpulse);
+		point.m_tangentImpulse = newTangentImpulse;
+
+		linearVelocityA -= impulse * inverseMassA;
+		angularVelocityA -= inverseInertiaA * CrossProduct2D(point.m_anchorA, impulse);
+		linearVelocityB += impulse * inverseMassB;
+		angularVelocityB += inverseInertiaB * CrossProduct2D(point.m_anchorB, impulse);
+	}
+
+	if(contact.m_isBlockSolved)
+	{
+		SolveContactNormalBlock(contact, linearVelocityA, angularVelocityA, linearVelocityB, angularVelocityB);
+	}
+	else
+	{
+		for(int pointIndex = 0; pointIndex < contact.m_numPoints; ++pointIndex)
+		{
+			ContactPointConstraint2D& point = contact.m_points[pointIndex];
+
+			Vec2 relativeVelocity = linearVelocityB + GetRotationalVelocity(angularVelocityB, point.m_anchorB) - linearVelocityA - GetRotationalVelocity(angularVelocityA, point.m_anchorA);
+			float normalSpeed = DotProduct2D(relativeVelocity, normal);
+			float newNormalImpulse = GetMax(point.m_normalImpulse + (point.m_normalMass * (point.m_targetNormalSpeed - normalSpeed)), 0.f);
+			Vec2 impulse = normal * (newNormalImpulse - point.m_normalImpulse);
+			point.m_normalImpulse = newNormalImpulse;
+
+			linearVelocityA -= impulse * inverseMassA;
+			angularVelocityA -= inverseInertiaA * CrossProduct2D(point.m_anchorA, impulse);
+			linearVelocityB += impulse * inverseMassB;
+			angularVelocityB += inverseInertiaB * CrossProduct2D(point.m_anchorB, impulse);
+		}
+	}
+
+	// a static body may be shared with islands solving on other threads, so it is only ever read
+	if(inverseMassA > 0.f)
+	{
+		m_linearVelocities[bodyA] = linearVelocityA;
+		m_angularVelocities[bodyA] = angularVelocityA;
+	}
+	if(inverseMassB > 0.f)
+	{
+		m_linearVelocities[bodyB] = linearVelocityB;
+		m_angularVelocities[bodyB] = angularVelocityB;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Finds both accumulated normal impulses at once as a 2x2 linear complementarity problem: each impulse is either zero
+// or hits its target speed exactly. The four cases (both pushing, only one pushing, neither) are tried in turn and the
+// first one that is consistent is applied. If none is, which only happens from round-off, the impulses are left alone.
+void PhysicsWorld2D::SolveContactNormalBlock(ContactConstraint2D& contact, Vec2& inout_linearVelocityA, float& inout_angularVelocityA, Vec2& inout_linearVelocityB, float& inout_angularVelocityB) const
+{
+	ContactPointConstraint2D& point1 = contact.m_points[0];
+	ContactPointConstraint2D& point2 = contact.m_points[1];
+	Vec2 normal = contact.m_normal;
+	float const* k = contact.m_blockK;
+	float const* inverseK = contact.m_blockInverseK;
+
+	Vec2 relativeVelocity1 = inout_linearVelocityB + GetRotationalVelocity(inout_angularVelocityB, point1.m_anchorB) - inout_linearVelocityA - GetRotationalVelocity(inout_angularVelocityA, point1.m_anchorA);
+	Vec2 relativeVelocity2 = inout_linearVelocityB + GetRotationalVelocity(inout_angularVelocityB, point2.m_anchorB) - inout_linearVelocityA - GetRotationalVelocity(inout_angularVelocityA, point2.m_anchorA);
+
+	// speed error each point would have with zero total impulse: b = (vn - target) - K * oldImpulse
+	float oldImpulse1 = point1.m_normalImpulse;
+	float oldImpulse2 = point2.m_normalImpulse;
+	float b1 = DotProduct2D(relativeVelocity1, normal) - point1.m_targetNormalSpeed - (k[0] * oldImpulse1) - (k[1] * oldImpulse2);
+	float b2 = DotProduct2D(relativeVelocity2, normal) - point2.m_targetNormalSpeed - (k[1] * oldImpulse1) - (k[2] * oldImpulse2);
+
+	float newImpulse1 = -((inverseK[0] * b1) + (inverseK[1] * b2));
+	float newImpulse2 = -((inverseK[1] * b1) + (inverseK[2] * b2));
+	if(newImpulse1 < 0.f || newImpulse2 < 0.f)
+	{
+		newImpulse1 = -point1.m_normalMass * b1;
+		newImpulse2 = 0.f;
+		if(newImpulse1 < 0.f || (k[1] * newImpulse1) + b2 < 0.f)
+		{
+			newImpulse1 = 0.f;
+			newImpulse2 = -point2.m_normalMass * b2;
+			if(newImpulse2 < 0.f || (k[1] * newImpulse2) + b1 < 0.f)
+			{
+				newImpulse2 = 0.f;
+				if(b1 < 0.f || b2 < 0.f)
+				{
+					return;
+				}
+			}
+		}
+	}
+
+	Vec2 impulse1 = normal * (newImpulse1 - oldImpulse1);
+	Vec2 impulse2 = normal * (newImpulse2 - oldImpulse2);
+	point1.m_normalImpulse = newImpulse1;
+	point2.m_normalImpulse = newImpulse2;
+
+	inout_linearVelocityA -= (impulse1 + impulse2) * m_inverseMasses[contact.m_bodyA];
+	inout_angularVelocityA -= m_inverseInertias[contact.m_bodyA] * (CrossProduct2D(point1.m_anchorA, impulse1) + CrossProduct2D(point2.m_anchorA, impulse2));
+	inout_linearVelocityB += (impulse1 + impulse2) * m_inverseMasses[contact.m_bodyB];
+	inout_angularVelocityB += m_inverseInertias[contact.m_bodyB] * (CrossProduct2D(point1.m_anchorB, impulse1) + CrossProduct2D(point2.m_anchorB, impulse2));
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void PhysicsWorld2D::IntegratePositions(float deltaSeconds)
+{
+	for(int bodyIndex = 0; bodyIndex < GetNumBodies(); ++bodyIndex)
+	{
+		if(!IsDynamic(bodyIndex))
+		{
+			continue;
+		}
+
+		m_positions[bodyIndex] += m_linearVelocities[bodyIndex] * deltaSeconds;
+
+		// rotate (cos, sin) by the small angle and renormalize, which stays accurate for any per-step spin a solver sees
+		float angleDelta = m_angularVelocities[bodyIndex] * deltaSeconds;
+		Vec2 rotation = m_rotations[bodyIndex];
+		rotation = Vec2(rotation.x - (angleDelta * rotation.y), rotation.y + (angleDelta * rotation.x));
+		m_rotations[bodyIndex] = rotation.GetNormalized();
+	}
+}
@@ -0,0 +1,216 @@
+#pragma once
+#include "Engine/Math/ContactManifold2D.hpp"
+#include "Engine/Math/SpatialHashGrid2D.hpp"
+#include "Engine/Math/Vec2.hpp"
+
+#include <stdint.h>
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------
+class JobSystem;
+
+typedef int PhysicsBodyID2D;
+constexpr PhysicsBodyID2D INVALID_PHYSICS_BODY_ID_2D = -1;
+
+//------------------------------------------------------------------------------------------------------------------
+enum class PhysicsShapeType2D : unsigned char
+{
+	DISC,
+	BOX,
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct PhysicsBodyDefinition2D
+{
+	PhysicsShapeType2D	m_shapeType = PhysicsShapeType2D::DISC;
+	Vec2				m_position;
+	float				m_orientationDegrees = 0.f;
+	Vec2				m_linearVelocity;
+	float				m_angularVelocityDegrees = 0.f;
+	float				m_radius = 0.5f;							// discs
+	Vec2				m_halfDimensions = Vec2(0.5f, 0.5f);		// boxes
+	float				m_density = 1.f;							// 0 makes the body static
+	float				m_friction = 0.6f;
+	float				m_restitution = 0.f;
+	void*				m_userData = nullptr;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct PhysicsWorld2DConfig
+{
+	Vec2		m_gravity = Vec2(0.f, -9.8f);
+	int			m_numVelocityIterations = 8;
+	float		m_broadphaseCellSize = 1.f;				// about the diameter of a typical dynamic body
+	float		m_speculativeDistance = 0.02f;			// contacts start this far before the shapes touch
+	float		m_allowedPenetration = 0.005f;			// overlap left alone so resting contacts do not jitter
+	float		m_penetrationCorrection = 0.2f;			// fraction of the remaining overlap pushed apart per step
+	float		m_maxCorrectionSpeed = 3.f;
+	float		m_restitutionThreshold = 1.f;			// slower impacts than this do not bounce
+	JobSystem*	m_jobSystem = nullptr;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Rigid discs and boxes, stepped with a sequential-impulse contact solver.
+//
+// Body state lives in parallel arrays indexed by a dense body index; a PhysicsBodyID2D stays valid until the body is
+// removed, but removing a body moves the last one into its slot, so dense indexes (and the Get*Array views) are only
+// good until the next AddBody or RemoveBody.
+//
+// Each Step:
+//	1. gravity is added to the dynamic bodies' velocities
+//	2. dynamic bodies are filed in a SpatialHashGrid2D by bounding disc; static bodies query it with their bounds
+//	3. each candidate pair gets a ContactManifold2D (on the JobSystem, if configured)
+//	4. impulses from last step's matching contact points are carried over (warm starting)
+//	5. dynamic bodies joined by contacts are grouped into islands; static bodies never join two islands together
+//	6. islands are solved independently (spread across the JobSystem) and positions integrated
+//
+// Islands are the unit of parallelism, so a single pile where everything touches runs on one thread. Results depend
+// only on the bodies and the order they were added, not on how the work was scheduled.
+//------------------------------------------------------------------------------------------------------------------
+class PhysicsWorld2D
+{
+	friend class PhysicsWorld2DJob;
+
+public:
+	explicit PhysicsWorld2D(PhysicsWorld2DConfig const& config);
+	~PhysicsWorld2D() = default;
+
+	void				Startup();
+	void				Shutdown();
+	void				Step(float deltaSeconds);
+
+	PhysicsBodyID2D		AddBody(PhysicsBodyDefinition2D const& definition);
+	void				RemoveBody(PhysicsBodyID2D bodyID);
+	void				RemoveAllBodies();
+
+	bool				IsBodyValid(PhysicsBodyID2D bodyID) const;
+	bool				IsBodyStatic(PhysicsBodyID2D bodyID) const;
+	Vec2				GetPosition(PhysicsBodyID2D bodyID) const;
+	float				GetOrientationDegrees(PhysicsBodyID2D bodyID) const;
+	Vec2				GetLinearVelocity(PhysicsBodyID2D bodyID) const;
+	float				GetAngularVelocityDegrees(PhysicsBodyID2D bodyID) const;
+	void*				GetUserData(PhysicsBodyID2D bodyID) const;
+
+	void				SetTransform(PhysicsBodyID2D bodyID, Vec2 const& position, float orientationDegrees);
+	void				SetLinearVelocity(PhysicsBodyID2D bodyID, Vec2 const& linearVelocity);
+	void				SetAngularVelocityDegrees(PhysicsBodyID2D bodyID, float angularVelocityDegrees);
+	void				ApplyLinearImpulse(PhysicsBodyID2D bodyID, Vec2 const& impulse, Vec2 const& worldPoint);
+
+	Vec2				GetGravity() const							{ return m_config.m_gravity; }
+	void				SetGravity(Vec2 const& gravity)				{ m_config.m_gravity = gravity; }
+
+	int					GetNumBodies() const						{ return static_cast<int>(m_positions.size()); }
+	int					GetNumContacts() const						{ return static_cast<int>(m_contacts.size()); }
+	int					GetNumIslands() const						{ return static_cast<int>(m_islandStarts.size()) - 1; }
+
+	// Dense views for drawing every body in one pass; entry i of each belongs to GetBodyIDArray()[i].
+	std::vector<PhysicsBodyID2D> const&		GetBodyIDArray() const				{ return m_bodyIDs; }
+	std::vector<Vec2> const&				GetPositionArray() const			{ return m_positions; }
+	std::vector<Vec2> const&				GetRotationArray() const			{ return m_rotations; }		// (cos, sin) of each orientation
+	std::vector<PhysicsShapeType2D> const&	GetShapeTypeArray() const			{ return m_shapeTypes; }
+	std::vector<Vec2> const&				GetShapeExtentsArray() const		{ return m_shapeExtents; }	// (radius, radius) or half dimensions
+
+private:
+	struct ContactPointConstraint2D
+	{
+		Vec2	m_anchorA;					// contact point relative to each body's center
+		Vec2	m_anchorB;
+		float	m_separation = 0.f;
+		float	m_normalMass = 0.f;
+		float	m_tangentMass = 0.f;
+		float	m_targetNormalSpeed = 0.f;
+		float	m_normalImpulse = 0.f;
+		float	m_tangentImpulse = 0.f;
+		int		m_featureKey = 0;
+	};
+
+	// One touching pair, sorted by m_key so last step's impulses can be matched in a single pass.
+	struct ContactConstraint2D
+	{
+		uint64_t					m_key = 0;				// lower body ID in the high half
+		int							m_bodyA = -1;			// dense indexes
+		int							m_bodyB = -1;
+		Vec2						m_normal;				// from A toward B
+		float						m_friction = 0.f;
+		float						m_restitution = 0.f;
+		int							m_numPoints = 0;
+		ContactPointConstraint2D	m_points[2];
+		bool						m_isBlockSolved = false;	// both normal impulses solved together
+		float						m_blockK[3] = {};			// K11, K12, K22 of the two-point normal mass matrix
+		float						m_blockInverseK[3] = {};
+	};
+
+	struct BodyPair2D
+	{
+		uint64_t	m_key = 0;
+		int			m_bodyA = -1;
+		int			m_bodyB = -1;
+	};
+
+	enum class JobPhase
+	{
+		NARROWPHASE,
+		SOLVE_ISLANDS,
+	};
+
+	int					GetDenseIndex(PhysicsBodyID2D bodyID) const;
+	bool				IsDynamic(int bodyIndex) const				{ return m_inverseMasses[bodyIndex] > 0.f; }
+	void				SetMassFromShape(int bodyIndex, float density);
+	float				GetBoundingRadius(int bodyIndex) const;
+
+	void				FindCandidatePairs();
+	void				BuildContacts();
+	void				BuildIslands();
+	void				RunJobRanges(JobPhase phase, std::vector<int> const& rangeStarts);
+	void				ComputeContactRange(int firstPair, int endPair);
+	void				SolveIslandRange(int firstIsland, int endIsland);
+	void				PrepareContact(ContactConstraint2D& contact) const;
+	void				WarmStartContact(ContactConstraint2D const& contact);
+	void				SolveContact(ContactConstraint2D& contact);
+	void				SolveContactNormalBlock(ContactConstraint2D& contact, Vec2& inout_linearVelocityA, float& inout_angularVelocityA, Vec2& inout_linearVelocityB, float& inout_angularVelocityB) const;
+	void				IntegratePositions(float deltaSeconds);
+
+	int					FindIslandRoot(int bodyIndex);
+
+private:
+	PhysicsWorld2DConfig					m_config;
+	float									m_deltaSeconds = 0.f;
+
+	// bodies, by dense index
+	std::vector<PhysicsBodyID2D>			m_bodyIDs;
+	std::vector<Vec2>						m_positions;
+	std::vector<Vec2>						m_rotations;
+	std::vector<Vec2>						m_linearVelocities;
+	std::vector<float>						m_angularVelocities;		// radians per second
+	std::vector<float>						m_inverseMasses;
+	std::vector<float>						m_inverseInertias;
+	std::vector<PhysicsShapeType2D>			m_shapeTypes;
+	std::vector<Vec2>						m_shapeExtents;
+	std::vector<float>						m_frictions;
+	std::vector<float>						m_restitutions;
+	std::vector<void*>						m_userDatas;
+
+	// body ID -> dense index, -1 for removed IDs waiting in m_freeIDs
+	std::vector<int>						m_denseIndexes;
+	std::vector<PhysicsBodyID2D>			m_freeIDs;
+
+	// per-step scratch
+	SpatialHashGrid2D						m_grid;
+	std::vector<int>						m_gridBodyIndexes;
+	std::vector<Vec2>						m_gridCenters;
+	std::vector<float>						m_gridRadii;
+	std::vector<SpatialHashPair2D>			m_gridPairs;
+	std::vector<int>						m_queryResults;
+	std::vector<BodyPair2D>					m_candidatePairs;
+	std::vector<ContactManifold2D>			m_candidateManifolds;
+	std::vector<ContactConstraint2D>		m_previousContacts;
+	std::vector<ContactConstraint2D>		m_contacts;
+
+	// islands: contacts m_islandContacts[m_islandStarts[i], m_islandStarts[i + 1]) belong to island i
+	std::vector<int>						m_islandParents;
+	std::vector<int>						m_contactIslands;
+	std::vector<int>						m_islandIndexes;
+	std::vector<int>						m_islandStarts;
+	std::vector<int>						m_islandContacts;
+	std::vector<int>						m_rangeStarts;
+};
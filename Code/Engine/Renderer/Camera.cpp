@@ -1,6 +1,7 @@
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Window/Window.hpp"
 #include "Engine/math/Vec4.hpp"
+#include "Engine/Math/Frustum.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 //------------------------------------------------------------------------------------------------------------------
 void Camera::SetOrthographicView(Vec2 const& bottomLeft, Vec2 const& topRight, float orthoNear, float orthoFar)
@@ -141,6 +142,12 @@ Mat44 Camera::GetWorldToClipTransform() const
 	return transform;
 }
 
+//------------------------------------------------------------------------------------------------------------------
+Frustum Camera::GetWorldFrustum() const
+{
+	return Frustum::MakeFromWorldToClip(GetWorldToClipTransform());
+}
+
 //------------------------------------------------------------------------------------------------------------------
 Vec2 Camera::GetOrthographicBottomLeft() const
 {
@@ -6,6 +6,7 @@
 #include "Engine/Math/EulerAngles.hpp"
 #include "Engine/Math/Mat44.hpp"
 //------------------------------------------------------------------------------------------------------------------
+struct Frustum;
 
 
 //------------------------------------------------------------------------------------------------------------------
@@ -46,6 +47,7 @@ public:
 	Mat44 GetClipToRenderTransform() const;
 
 	Mat44 GetWorldToClipTransform() const;
+	Frustum GetWorldFrustum() const;
 
 	Vec2 GetOrthographicBottomLeft() const;
 	Vec2 GetOrthographicTopRight() const;
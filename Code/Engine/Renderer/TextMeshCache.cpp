@@ -0,0 +1,226 @@
+#include "Engine/Renderer/TextMeshCache.hpp"
+#include "Engine/Math/AABB2.hpp"
+
+#include <functional>
+
+//------------------------------------------------------------------------------------------------------------------
+static void HashCombine(size_t& seed, size_t value)
+{
+	seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TextMeshKey::ComputeHash()
+{
+	size_t hash = std::hash<std::string_view>()(m_text);
+
+	unsigned int tint = (static_cast<unsigned int>(m_tint.r) << 24) | (static_cast<unsigned int>(m_tint.g) << 16) | (static_cast<unsigned int>(m_tint.b) << 8) | m_tint.a;
+
+	HashCombine(hash, std::hash<void const*>()(m_font));
+	HashCombine(hash, std::hash<float>()(m_cellHeight));
+	HashCombine(hash, std::hash<float>()(m_cellAspect));
+	HashCombine(hash, std::hash<unsigned int>()(tint));
+	HashCombine(hash, std::hash<float>()(m_boxDimensions.x));
+	HashCombine(hash, std::hash<float>()(m_boxDimensions.y));
+	HashCombine(hash, std::hash<float>()(m_alignment.x));
+	HashCombine(hash, std::hash<float>()(m_alignment.y));
+	HashCombine(hash, std::hash<int>()(static_cast<int>(m_boxMode)));
+	HashCombine(hash, std::hash<int>()(m_maxGlyphs));
+	HashCombine(hash, std::hash<bool>()(m_isInBox));
+
+	m_hash = hash;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool TextMeshKey::operator==(TextMeshKey const& compare) const
+{
+	return	m_hash			== compare.m_hash			&&
+			m_font			== compare.m_font			&&
+			m_cellHeight	== compare.m_cellHeight		&&
+			m_cellAspect	== compare.m_cellAspect		&&
+			m_tint.r		== compare.m_tint.r			&&
+			m_tint.g		== compare.m_tint.g			&&
+			m_tint.b		== compare.m_tint.b			&&
+			m_tint.a		== compare.m_tint.a			&&
+			m_boxDimensions	== compare.m_boxDimensions	&&
+			m_alignment		== compare.m_alignment		&&
+			m_boxMode		== compare.m_boxMode		&&
+			m_maxGlyphs		== compare.m_maxGlyphs		&&
+			m_isInBox		== compare.m_isInBox		&&
+			m_text			== compare.m_text;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+size_t TextMeshKeyHasher::operator()(TextMeshKey const& key) const
+{
+	return key.m_hash;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+TextMeshCache::TextMeshCache(int maxEntries)
+	: m_maxEntries(maxEntries)
+{
+	m_entriesByKey.reserve(static_cast<size_t>(maxEntries));
+}
+
+//------------------------------------------------------------------------------------------------------------------
+TextMeshCache::~TextMeshCache()
+{
+	Clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TextMeshCache::AddVertsForText2D(std::vector<Vertex_PCU>& vertexArray, BitmapFont& font, Vec2 const& textMins, float cellHeight, std::string const& text, Rgba8 const& tint, float cellAspectScale)
+{
+	if(text.empty())
+	{
+		return;
+	}
+
+	TextMeshKey key;
+	key.m_text			= text;
+	key.m_font			= &font;
+	key.m_cellHeight	= cellHeight;
+	key.m_cellAspect	= cellAspectScale;
+	key.m_tint			= tint;
+	key.m_isInBox		= false;
+	key.ComputeHash();
+
+	std::vector<Vertex_PCU> const& cachedVerts = CreateOrGetVerts(key, font);
+	AppendTranslated(vertexArray, cachedVerts, textMins);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TextMeshCache::AddVertsForTextInBox2D(std::vector<Vertex_PCU>& vertexArray, BitmapFont& font, std::string const& text, AABB2 const& box, float cellHeight, Rgba8 const& tint, float cellAspect, Vec2 const& alignment, TextBoxMode mode, int maxGlyphsToDraw)
+{
+	if(text.empty())
+	{
+		return;
+	}
+
+	TextMeshKey key;
+	key.m_text			= text;
+	key.m_font			= &font;
+	key.m_cellHeight	= cellHeight;
+	key.m_cellAspect	= cellAspect;
+	key.m_tint			= tint;
+	key.m_boxDimensions	= box.GetDimensions();
+	key.m_alignment		= alignment;
+	key.m_boxMode		= mode;
+	key.m_maxGlyphs		= maxGlyphsToDraw;
+	key.m_isInBox		= true;
+	key.ComputeHash();
+
+	std::vector<Vertex_PCU> const& cachedVerts = CreateOrGetVerts(key, font);
+	AppendTranslated(vertexArray, cachedVerts, box.m_mins);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TextMeshCache::Clear()
+{
+	m_entriesByKey.clear();
+	m_entriesByRecency.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TextMeshCache::SetMaxEntries(int maxEntries)
+{
+	m_maxEntries = maxEntries;
+
+	while(static_cast<int>(m_entriesByRecency.size()) > m_maxEntries)
+	{
+		EvictLeastRecentlyUsed();
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int TextMeshCache::GetNumEntries() const
+{
+	return static_cast<int>(m_entriesByRecency.size());
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int TextMeshCache::GetNumHits() const
+{
+	return m_numHits;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int TextMeshCache::GetNumMisses() const
+{
+	return m_numMisses;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TextMeshCache::ResetStats()
+{
+	m_numHits = 0;
+	m_numMisses = 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+std::vector<Vertex_PCU> const& TextMeshCache::CreateOrGetVerts(TextMeshKey const& key, BitmapFont& font)
+{
+	auto found = m_entriesByKey.find(key);
+
+	if(found != m_entriesByKey.end())
+	{
+		// move to the front of the recency list, iterators stay valid
+		m_entriesByRecency.splice(m_entriesByRecency.begin(), m_entriesByRecency, found->second);
+		m_numHits += 1;
+		return found->second->m_verts;
+	}
+
+	m_numMisses += 1;
+
+	if(m_maxEntries > 0 && static_cast<int>(m_entriesByRecency.size()) >= m_maxEntries)
+	{
+		EvictLeastRecentlyUsed();
+	}
+
+	// the text is copied only here, on a miss, and the stored key views the entry's copy
+	m_entriesByRecency.emplace_front();
+	TextMeshEntry& entry = m_entriesByRecency.front();
+	entry.m_text = key.m_text;
+	entry.m_key = key;
+	entry.m_key.m_text = entry.m_text;
+
+	if(key.m_isInBox)
+	{
+		AABB2 boxAtOrigin(Vec2(0.f, 0.f), key.m_boxDimensions);
+		font.AddVertsForTextInBox2D(entry.m_verts, entry.m_text, boxAtOrigin, key.m_cellHeight, key.m_tint, key.m_cellAspect, key.m_alignment, key.m_boxMode, key.m_maxGlyphs);
+	}
+	else
+	{
+		font.AddVertsForText2D(entry.m_verts, Vec2(0.f, 0.f), key.m_cellHeight, entry.m_text, key.m_tint, key.m_cellAspect);
+	}
+
+	m_entriesByKey.emplace(entry.m_key, m_entriesByRecency.begin());
+
+	return entry.m_verts;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TextMeshCache::AppendTranslated(std::vector<Vertex_PCU>& vertexArray, std::vector<Vertex_PCU> const& cachedVerts, Vec2 const& translation) const
+{
+	size_t startIndex = vertexArray.size();
+	vertexArray.insert(vertexArray.end(), cachedVerts.begin(), cachedVerts.end());
+
+	for(size_t vertIndex = startIndex; vertIndex < vertexArray.size(); ++vertIndex)
+	{
+		vertexArray[vertIndex].m_position.x += translation.x;
+		vertexArray[vertIndex].m_position.y += translation.y;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TextMeshCache::EvictLeastRecentlyUsed()
+{
+	if(m_entriesByRecency.empty())
+	{
+		return;
+	}
+
+	m_entriesByKey.erase(m_entriesByRecency.back().m_key);
+	m_entriesByRecency.pop_back();
+}
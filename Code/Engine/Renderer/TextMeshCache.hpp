@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Renderer/BitmapFont.hpp"
+
+#include <climits>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------
+struct AABB2;
+
+//------------------------------------------------------------------------------------------------------------------
+// Everything that changes the glyph layout. Position is not part of the key; cached quads are built at the origin and
+// translated when they are appended.
+//
+// The key does not own its text: a lookup key views the caller's string, and a stored key views the string owned by
+// its cache entry. m_hash covers every field and is computed once by ComputeHash before the key is used.
+struct TextMeshKey
+{
+	size_t				m_hash			= 0;
+	std::string_view	m_text;
+	BitmapFont const*	m_font			= nullptr;
+	float				m_cellHeight	= 0.f;
+	float				m_cellAspect	= 1.f;
+	Rgba8				m_tint			= Rgba8::WHITE;
+	Vec2				m_boxDimensions	= Vec2(0.f, 0.f);
+	Vec2				m_alignment		= Vec2(0.f, 0.f);
+	TextBoxMode			m_boxMode		= OVERRUN;
+	int					m_maxGlyphs		= 0;
+	bool				m_isInBox		= false;
+
+	void ComputeHash();
+	bool operator==(TextMeshKey const& compare) const;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+struct TextMeshKeyHasher
+{
+	size_t operator()(TextMeshKey const& key) const;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// LRU cache of BitmapFont glyph quads. Unchanged lines cost one lookup and a translated copy instead of a full re-layout.
+// Not thread safe; each owner guards its own cache.
+class TextMeshCache
+{
+public:
+	explicit TextMeshCache(int maxEntries = 512);
+	~TextMeshCache();
+
+	void	AddVertsForText2D(std::vector<Vertex_PCU>& vertexArray, BitmapFont& font, Vec2 const& textMins, float cellHeight, std::string const& text, Rgba8 const& tint = Rgba8::WHITE, float cellAspectScale = 1.f);
+	void	AddVertsForTextInBox2D(std::vector<Vertex_PCU>& vertexArray, BitmapFont& font, std::string const& text, AABB2 const& box, float cellHeight, Rgba8 const& tint = Rgba8::WHITE, float cellAspect = 1.f,
+								   Vec2 const& alignment = Vec2(0.5f, 0.5f), TextBoxMode mode = TextBoxMode::SHRINK_TO_FIT, int maxGlyphsToDraw = INT_MAX);
+
+	void	Clear();
+	void	SetMaxEntries(int maxEntries);
+
+	int		GetNumEntries() const;
+	int		GetNumHits() const;
+	int		GetNumMisses() const;
+	void	ResetStats();
+
+private:
+	struct TextMeshEntry
+	{
+		std::string				m_text;		// the only copy; m_key.m_text views it, list nodes never move
+		TextMeshKey				m_key;
+		std::vector<Vertex_PCU>	m_verts;
+	};
+
+	typedef std::list<TextMeshEntry> TextMeshList;
+
+	std::vector<Vertex_PCU> const&	CreateOrGetVerts(TextMeshKey const& key, BitmapFont& font);
+	void							AppendTranslated(std::vector<Vertex_PCU>& vertexArray, std::vector<Vertex_PCU> const& cachedVerts, Vec2 const& translation) const;
+	void							EvictLeastRecentlyUsed();
+
+private:
+	TextMeshList																m_entriesByRecency;
+	std::unordered_map<TextMeshKey, TextMeshList::iterator, TextMeshKeyHasher>	m_entriesByKey;
+	int																			m_maxEntries = 512;
+	int																			m_numHits = 0;
+	int																			m_numMisses = 0;
+};
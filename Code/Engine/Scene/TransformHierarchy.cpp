@@ -0,0 +1,600 @@
+#include "Engine/Scene/TransformHierarchy.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/JobSystem/Job.hpp"
+#include "Engine/JobSystem/JobSystem.hpp"
+#include "Engine/Math/FastTrig.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/SIMDUtils.hpp"
+#include "Engine/Math/Vec3xN.hpp"
+#include "Game/EngineBuildPreferences.hpp"
+
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------
+constexpr int MIN_TRANSFORMS_PER_JOB = 4096;
+
+#if defined(ENGINE_SIMD_AVX2)
+typedef Float8Ops TransformOps;
+#else
+typedef Float4Ops TransformOps;
+#endif
+
+typedef TransformOps::Type			TransformLane;
+typedef Vec3xN<TransformOps>		TransformVec3Lanes;
+
+constexpr int TRANSFORM_LANES = TransformOps::WIDTH;
+
+//------------------------------------------------------------------------------------------------------------------
+class TransformHierarchyJob : public Job
+{
+public:
+	virtual void Execute() override
+	{
+		m_hierarchy->UpdateWorldMatrixRange(m_start, m_end);
+	}
+
+public:
+	TransformHierarchy*		m_hierarchy = nullptr;
+	int						m_start = 0;
+	int						m_end = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Reorders values so entry k is the old entry order[k]; entries left out of order are dropped.
+template<typename ValueType>
+static void PermuteArray(std::vector<ValueType>& values, std::vector<int> const& order)
+{
+	std::vector<ValueType> permuted;
+	permuted.reserve(order.size());
+	for(int oldIndex : order)
+	{
+		permuted.push_back(values[oldIndex]);
+	}
+	values.swap(permuted);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+TransformHierarchy::TransformHierarchy(TransformHierarchyConfig const& config)
+	: m_config(config)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::Startup()
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::Shutdown()
+{
+	DestroyAllTransforms();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::UpdateWorldMatrices()
+{
+	m_numWorldMatricesUpdated = 0;
+
+	if(m_isOrderDirty)
+	{
+		SortByDepth();
+	}
+
+	if(!m_hasDirtyTransforms)
+	{
+		return;
+	}
+
+	GatherDirtyTransforms();
+
+	// a level only reads world matrices from the levels above it, so levels run in order and each is split up
+	int numLevels = static_cast<int>(m_dirtyLevelStarts.size()) - 1;
+	for(int levelIndex = 0; levelIndex < numLevels; ++levelIndex)
+	{
+		SplitIntoJobRanges(m_dirtyLevelStarts[levelIndex], m_dirtyLevelStarts[levelIndex + 1], MIN_TRANSFORMS_PER_JOB, m_config.m_jobSystem, m_rangeStarts, TRANSFORM_LANES);
+		RunJobRanges(m_rangeStarts);
+	}
+
+	for(int transformIndex : m_dirtyIndexes)
+	{
+		m_isLocalDirty[transformIndex] = 0;
+	}
+
+	m_numWorldMatricesUpdated = static_cast<int>(m_dirtyIndexes.size());
+	m_hasDirtyTransforms = false;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+TransformID TransformHierarchy::CreateTransform(TransformID parentID, Vec3 const& position, EulerAngles const& orientation, Vec3 const& scale)
+{
+	int parentIndex = (parentID == INVALID_TRANSFORM_ID) ? -1 : GetDenseIndex(parentID);
+
+	TransformID transformID;
+	if(!m_freeIDs.empty())
+	{
+		transformID = m_freeIDs.back();
+		m_freeIDs.pop_back();
+	}
+	else
+	{
+		transformID = static_cast<TransformID>(m_denseIndexes.size());
+		m_denseIndexes.push_back(-1);
+	}
+
+	int transformIndex = static_cast<int>(m_transformIDs.size());
+	m_denseIndexes[transformID] = transformIndex;
+
+	// appending keeps the arrays sorted as long as nothing already in them is deeper
+	int depth = (parentIndex < 0) ? 0 : m_depths[parentIndex] + 1;
+	if(!m_depths.empty() && depth < m_depths.back())
+	{
+		m_isOrderDirty = true;
+	}
+
+	m_transformIDs.push_back(transformID);
+	m_parents.push_back(parentIndex);
+	m_depths.push_back(depth);
+	m_positionX.push_back(position.x);
+	m_positionY.push_back(position.y);
+	m_positionZ.push_back(position.z);
+	m_yawDegrees.push_back(orientation.m_yawDegrees);
+	m_pitchDegrees.push_back(orientation.m_pitchDegrees);
+	m_rollDegrees.push_back(orientation.m_rollDegrees);
+	m_scaleX.push_back(scale.x);
+	m_scaleY.push_back(scale.y);
+	m_scaleZ.push_back(scale.z);
+	m_isLocalDirty.push_back(0);
+	m_isWorldDirty.push_back(0);
+	m_worldMatrices.push_back(Mat44());
+
+	MarkLocalDirty(transformIndex);
+	return transformID;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::DestroyTransform(TransformID transformID)
+{
+	int transformIndex = GetDenseIndex(transformID);
+
+	m_denseIndexes[transformID] = -1;
+	m_freeIDs.push_back(transformID);
+	m_transformIDs[transformIndex] = INVALID_TRANSFORM_ID;
+
+	DestroyOrphanedTransforms();
+	m_isOrderDirty = true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::DestroyAllTransforms()
+{
+	m_transformIDs.clear();
+	m_parents.clear();
+	m_depths.clear();
+	m_positionX.clear();
+	m_positionY.clear();
+	m_positionZ.clear();
+	m_yawDegrees.clear();
+	m_pitchDegrees.clear();
+	m_rollDegrees.clear();
+	m_scaleX.clear();
+	m_scaleY.clear();
+	m_scaleZ.clear();
+	m_isLocalDirty.clear();
+	m_isWorldDirty.clear();
+	m_worldMatrices.clear();
+	m_denseIndexes.clear();
+	m_freeIDs.clear();
+
+	m_isOrderDirty = false;
+	m_hasDirtyTransforms = false;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+bool TransformHierarchy::IsTransformValid(TransformID transformID) const
+{
+	return transformID >= 0 && transformID < static_cast<int>(m_denseIndexes.size()) && m_denseIndexes[transformID] >= 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+TransformID TransformHierarchy::GetParent(TransformID transformID) const
+{
+	int parentIndex = m_parents[GetDenseIndex(transformID)];
+	return (parentIndex < 0) ? INVALID_TRANSFORM_ID : m_transformIDs[parentIndex];
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::SetParent(TransformID transformID, TransformID parentID)
+{
+	int transformIndex = GetDenseIndex(transformID);
+	int parentIndex = (parentID == INVALID_TRANSFORM_ID) ? -1 : GetDenseIndex(parentID);
+	if(m_parents[transformIndex] == parentIndex)
+	{
+		return;
+	}
+
+	for(int ancestorIndex = parentIndex; ancestorIndex >= 0; ancestorIndex = m_parents[ancestorIndex])
+	{
+		GUARANTEE_OR_DIE(ancestorIndex != transformIndex, "TransformHierarchy cannot parent a transform to itself or to one of its own children");
+	}
+
+	m_parents[transformIndex] = parentIndex;
+	m_isOrderDirty = true;
+	MarkLocalDirty(transformIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+Vec3 TransformHierarchy::GetLocalPosition(TransformID transformID) const
+{
+	int transformIndex = GetDenseIndex(transformID);
+	return Vec3(m_positionX[transformIndex], m_positionY[transformIndex], m_positionZ[transformIndex]);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+EulerAngles TransformHierarchy::GetLocalOrientation(TransformID transformID) const
+{
+	int transformIndex = GetDenseIndex(transformID);
+	return EulerAngles(m_yawDegrees[transformIndex], m_pitchDegrees[transformIndex], m_rollDegrees[transformIndex]);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+Vec3 TransformHierarchy::GetLocalScale(TransformID transformID) const
+{
+	int transformIndex = GetDenseIndex(transformID);
+	return Vec3(m_scaleX[transformIndex], m_scaleY[transformIndex], m_scaleZ[transformIndex]);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::SetLocalPosition(TransformID transformID, Vec3 const& position)
+{
+	int transformIndex = GetDenseIndex(transformID);
+	m_positionX[transformIndex] = position.x;
+	m_positionY[transformIndex] = position.y;
+	m_positionZ[transformIndex] = position.z;
+	MarkLocalDirty(transformIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::SetLocalOrientation(TransformID transformID, EulerAngles const& orientation)
+{
+	int transformIndex = GetDenseIndex(transformID);
+	m_yawDegrees[transformIndex] = orientation.m_yawDegrees;
+	m_pitchDegrees[transformIndex] = orientation.m_pitchDegrees;
+	m_rollDegrees[transformIndex] = orientation.m_rollDegrees;
+	MarkLocalDirty(transformIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::SetLocalScale(TransformID transformID, Vec3 const& scale)
+{
+	int transformIndex = GetDenseIndex(transformID);
+	m_scaleX[transformIndex] = scale.x;
+	m_scaleY[transformIndex] = scale.y;
+	m_scaleZ[transformIndex] = scale.z;
+	MarkLocalDirty(transformIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::SetLocalTransform(TransformID transformID, Vec3 const& position, EulerAngles const& orientation, Vec3 const& scale)
+{
+	SetLocalPosition(transformID, position);
+	SetLocalOrientation(transformID, orientation);
+	SetLocalScale(transformID, scale);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+Mat44 const& TransformHierarchy::GetWorldMatrix(TransformID transformID) const
+{
+	return m_worldMatrices[GetDenseIndex(transformID)];
+}
+
+//------------------------------------------------------------------------------------------------------------------
+Vec3 TransformHierarchy::GetWorldPosition(TransformID transformID) const
+{
+	return m_worldMatrices[GetDenseIndex(transformID)].GetTranslation3D();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+int TransformHierarchy::GetDenseIndex(TransformID transformID) const
+{
+	GUARANTEE_OR_DIE(IsTransformValid(transformID), "TransformHierarchy was given a transform ID that was never created or has been destroyed");
+	return m_denseIndexes[transformID];
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::MarkLocalDirty(int transformIndex)
+{
+	m_isLocalDirty[transformIndex] = 1;
+	m_hasDirtyTransforms = true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Destroys every live transform with a destroyed ancestor. The arrays may not be sorted yet (a child can come before
+// its parent after SetParent), so each transform walks up until it meets an ancestor whose fate is already known.
+void TransformHierarchy::DestroyOrphanedTransforms()
+{
+	enum TransformFate : unsigned char { UNKNOWN, ALIVE, DESTROYED };
+
+	int numSlots = static_cast<int>(m_transformIDs.size());
+	std::vector<TransformFate> fates(numSlots, UNKNOWN);
+	std::vector<int> chain;
+
+	for(int transformIndex = 0; transformIndex < numSlots; ++transformIndex)
+	{
+		chain.clear();
+		int walkIndex = transformIndex;
+		while(walkIndex >= 0 && fates[walkIndex] == UNKNOWN && m_transformIDs[walkIndex] != INVALID_TRANSFORM_ID)
+		{
+			chain.push_back(walkIndex);
+			walkIndex = m_parents[walkIndex];
+		}
+
+		TransformFate fate = ALIVE;
+		if(walkIndex >= 0)
+		{
+			fate = (m_transformIDs[walkIndex] == INVALID_TRANSFORM_ID) ? DESTROYED : fates[walkIndex];
+		}
+
+		for(int chainIndex : chain)
+		{
+			fates[chainIndex] = fate;
+			if(fate == DESTROYED)
+			{
+				TransformID orphanID = m_transformIDs[chainIndex];
+				m_denseIndexes[orphanID] = -1;
+				m_freeIDs.push_back(orphanID);
+				m_transformIDs[chainIndex] = INVALID_TRANSFORM_ID;
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Recomputes every depth, then counting-sorts the live transforms by it. Transforms of equal depth keep their order,
+// so a tree that was only appended to comes out unchanged.
+void TransformHierarchy::SortByDepth()
+{
+	int numSlots = static_cast<int>(m_transformIDs.size());
+	std::vector<int> chain;
+
+	m_depths.assign(numSlots, -1);
+	int maxDepth = -1;
+	for(int transformIndex = 0; transformIndex < numSlots; ++transformIndex)
+	{
+		if(m_transformIDs[transformIndex] == INVALID_TRANSFORM_ID)
+		{
+			continue;
+		}
+
+		chain.clear();
+		int walkIndex = transformIndex;
+		while(walkIndex >= 0 && m_depths[walkIndex] < 0)
+		{
+			chain.push_back(walkIndex);
+			walkIndex = m_parents[walkIndex];
+		}
+
+		int depth = (walkIndex < 0) ? -1 : m_depths[walkIndex];
+		for(int chainIndex = static_cast<int>(chain.size()) - 1; chainIndex >= 0; --chainIndex)
+		{
+			m_depths[chain[chainIndex]] = ++depth;
+		}
+		maxDepth = GetMax(maxDepth, depth);
+	}
+
+	std::vector<int> depthStarts(maxDepth + 2, 0);
+	for(int transformIndex = 0; transformIndex < numSlots; ++transformIndex)
+	{
+		if(m_transformIDs[transformIndex] != INVALID_TRANSFORM_ID)
+		{
+			++depthStarts[m_depths[transformIndex] + 1];
+		}
+	}
+	for(int depth = 1; depth <= maxDepth + 1; ++depth)
+	{
+		depthStarts[depth] += depthStarts[depth - 1];
+	}
+
+	int numTransforms = depthStarts[maxDepth + 1];
+	std::vector<int> order(numTransforms);
+	std::vector<int> newIndexes(numSlots, -1);
+	for(int transformIndex = 0; transformIndex < numSlots; ++transformIndex)
+	{
+		if(m_transformIDs[transformIndex] != INVALID_TRANSFORM_ID)
+		{
+			int newIndex = depthStarts[m_depths[transformIndex]]++;
+			order[newIndex] = transformIndex;
+			newIndexes[transformIndex] = newIndex;
+		}
+	}
+
+	PermuteArray(m_transformIDs, order);
+	PermuteArray(m_parents, order);
+	PermuteArray(m_depths, order);
+	PermuteArray(m_positionX, order);
+	PermuteArray(m_positionY, order);
+	PermuteArray(m_positionZ, order);
+	PermuteArray(m_yawDegrees, order);
+	PermuteArray(m_pitchDegrees, order);
+	PermuteArray(m_rollDegrees, order);
+	PermuteArray(m_scaleX, order);
+	PermuteArray(m_scaleY, order);
+	PermuteArray(m_scaleZ, order);
+	PermuteArray(m_isLocalDirty, order);
+	PermuteArray(m_isWorldDirty, order);
+	PermuteArray(m_worldMatrices, order);
+
+	for(int transformIndex = 0; transformIndex < numTransforms; ++transformIndex)
+	{
+		int& parentIndex = m_parents[transformIndex];
+		parentIndex = (parentIndex < 0) ? -1 : newIndexes[parentIndex];
+		m_denseIndexes[m_transformIDs[transformIndex]] = transformIndex;
+	}
+
+	m_isOrderDirty = false;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// One pass in depth order: a transform's world matrix is stale when its local one changed or its parent's world one
+// is stale. The stale ones are listed level by level.
+void TransformHierarchy::GatherDirtyTransforms()
+{
+	m_dirtyIndexes.clear();
+	m_dirtyLevelStarts.clear();
+
+	int levelDepth = -1;
+	int numTransforms = static_cast<int>(m_transformIDs.size());
+	for(int transformIndex = 0; transformIndex < numTransforms; ++transformIndex)
+	{
+		int parentIndex = m_parents[transformIndex];
+		bool isWorldDirty = m_isLocalDirty[transformIndex] != 0 || (parentIndex >= 0 && m_isWorldDirty[parentIndex] != 0);
+		m_isWorldDirty[transformIndex] = isWorldDirty ? 1 : 0;
+		if(!isWorldDirty)
+		{
+			continue;
+		}
+
+		if(m_depths[transformIndex] != levelDepth)
+		{
+			levelDepth = m_depths[transformIndex];
+			m_dirtyLevelStarts.push_back(static_cast<int>(m_dirtyIndexes.size()));
+		}
+		m_dirtyIndexes.push_back(transformIndex);
+	}
+
+	m_dirtyLevelStarts.push_back(static_cast<int>(m_dirtyIndexes.size()));
+}
+
+//------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::RunJobRanges(std::vector<int> const& rangeStarts)
+{
+	int numRanges = static_cast<int>(rangeStarts.size()) - 1;
+	if(numRanges <= 0)
+	{
+		return;
+	}
+
+	if(numRanges == 1)
+	{
+		UpdateWorldMatrixRange(rangeStarts[0], rangeStarts[1]);
+		return;
+	}
+
+	std::vector<TransformHierarchyJob> jobs(numRanges);
+	for(int rangeIndex = 0; rangeIndex < numRanges; ++rangeIndex)
+	{
+		TransformHierarchyJob& job = jobs[rangeIndex];
+		job.m_hierarchy = this;
+		job.m_start = rangeStarts[rangeIndex];
+		job.m_end = rangeStarts[rangeIndex + 1];
+	}
+
+	m_config.m_jobSystem->ExecuteJobsAndWait(jobs);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// World matrices for m_dirtyIndexes[firstDirty, endDirty), all of one depth. Each group gathers its transforms' local
+// values and parents' world columns into lanes, builds translation * rotation * scale and multiplies by the parent,
+// then writes the matrices back one lane at a time. Unused lanes of the last group compute garbage that is never
+// written.
+void TransformHierarchy::UpdateWorldMatrixRange(int firstDirty, int endDirty)
+{
+	static Mat44 const s_identity;
+	static int const s_parentValueIndexes[12] = { Mat44::Ix, Mat44::Iy, Mat44::Iz, Mat44::Jx, Mat44::Jy, Mat44::Jz, Mat44::Kx, Mat44::Ky, Mat44::Kz, Mat44::Tx, Mat44::Ty, Mat44::Tz };
+
+	for(int first = firstDirty; first < endDirty; first += TRANSFORM_LANES)
+	{
+		int numLanes = GetMin(endDirty - first, TRANSFORM_LANES);
+
+		float angles[3][TRANSFORM_LANES] = {};
+		float sines[3][TRANSFORM_LANES] = {};
+		float cosines[3][TRANSFORM_LANES] = {};
+		float locals[6][TRANSFORM_LANES] = {};
+		float parents[12][TRANSFORM_LANES] = {};
+		for(int lane = 0; lane < numLanes; ++lane)
+		{
+			int transformIndex = m_dirtyIndexes[first + lane];
+			angles[0][lane] = m_yawDegrees[transformIndex];
+			angles[1][lane] = m_pitchDegrees[transformIndex];
+			angles[2][lane] = m_rollDegrees[transformIndex];
+			locals[0][lane] = m_positionX[transformIndex];
+			locals[1][lane] = m_positionY[transformIndex];
+			locals[2][lane] = m_positionZ[transformIndex];
+			locals[3][lane] = m_scaleX[transformIndex];
+			locals[4][lane] = m_scaleY[transformIndex];
+			locals[5][lane] = m_scaleZ[transformIndex];
+
+			int parentIndex = m_parents[transformIndex];
+			float const* parentValues = (parentIndex < 0) ? s_identity.m_values : m_worldMatrices[parentIndex].m_values;
+			for(int column = 0; column < 12; ++column)
+			{
+				parents[column][lane] = parentValues[s_parentValueIndexes[column]];
+			}
+		}
+
+		// the same trig as the MathUtils functions: the polynomial batch only when ENGINE_FAST_TRIG asks for it
+		for(int angleIndex = 0; angleIndex < 3; ++angleIndex)
+		{
+#if defined(ENGINE_FAST_TRIG)
+			SinCosDegreesBatch(numLanes, angles[angleIndex], sines[angleIndex], cosines[angleIndex]);
+#else
+			for(int lane = 0; lane < numLanes; ++lane)
+			{
+				SinCosDegrees(angles[angleIndex][lane], sines[angleIndex][lane], cosines[angleIndex][lane]);
+			}
+#endif
+		}
+
+		TransformLane sinYaw = TransformOps::Load(sines[0]);
+		TransformLane cosYaw = TransformOps::Load(cosines[0]);
+		TransformLane sinPitch = TransformOps::Load(sines[1]);
+		TransformLane cosPitch = TransformOps::Load(cosines[1]);
+		TransformLane sinRoll = TransformOps::Load(sines[2]);
+		TransformLane cosRoll = TransformOps::Load(cosines[2]);
+
+		// columns of Rz(yaw) * Ry(pitch) * Rx(roll), each scaled by its axis
+		TransformLane cosYawSinPitch = TransformOps::Mul(cosYaw, sinPitch);
+		TransformLane sinYawSinPitch = TransformOps::Mul(sinYaw, sinPitch);
+		TransformVec3Lanes localI(TransformOps::Mul(cosYaw, cosPitch), TransformOps::Mul(sinYaw, cosPitch), TransformOps::Sub(TransformOps::Zero(), sinPitch));
+		TransformVec3Lanes localJ(TransformOps::Sub(TransformOps::Mul(cosYawSinPitch, sinRoll), TransformOps::Mul(sinYaw, cosRoll)),
+								  TransformOps::Add(TransformOps::Mul(sinYawSinPitch, sinRoll), TransformOps::Mul(cosYaw, cosRoll)),
+								  TransformOps::Mul(cosPitch, sinRoll));
+		TransformVec3Lanes localK(TransformOps::Add(TransformOps::Mul(cosYawSinPitch, cosRoll), TransformOps::Mul(sinYaw, sinRoll)),
+								  TransformOps::Sub(TransformOps::Mul(sinYawSinPitch, cosRoll), TransformOps::Mul(cosYaw, sinRoll)),
+								  TransformOps::Mul(cosPitch, cosRoll));
+		localI *= TransformOps::Load(locals[3]);
+		localJ *= TransformOps::Load(locals[4]);
+		localK *= TransformOps::Load(locals[5]);
+		TransformVec3Lanes localT = TransformVec3Lanes::LoadSoA(locals[0], locals[1], locals[2]);
+
+		TransformVec3Lanes parentI = TransformVec3Lanes::LoadSoA(parents[0], parents[1], parents[2]);
+		TransformVec3Lanes parentJ = TransformVec3Lanes::LoadSoA(parents[3], parents[4], parents[5]);
+		TransformVec3Lanes parentK = TransformVec3Lanes::LoadSoA(parents[6], parents[7], parents[8]);
+		TransformVec3Lanes parentT = TransformVec3Lanes::LoadSoA(parents[9], parents[10], parents[11]);
+
+		TransformVec3Lanes worldColumns[4] =
+		{
+			(parentI * localI.m_x) + (parentJ * localI.m_y) + (parentK * localI.m_z),
+			(parentI * localJ.m_x) + (parentJ * localJ.m_y) + (parentK * localJ.m_z),
+			(parentI * localK.m_x) + (parentJ * localK.m_y) + (parentK * localK.m_z),
+			(parentI * localT.m_x) + (parentJ * localT.m_y) + (parentK * localT.m_z) + parentT,
+		};
+
+		float world[12][TRANSFORM_LANES];
+		for(int column = 0; column < 4; ++column)
+		{
+			worldColumns[column].StoreSoA(world[3 * column], world[3 * column + 1], world[3 * column + 2]);
+		}
+
+		for(int lane = 0; lane < numLanes; ++lane)
+		{
+			float* values = m_worldMatrices[m_dirtyIndexes[first + lane]].m_values;
+			for(int column = 0; column < 4; ++column)
+			{
+				values[4 * column + 0] = world[3 * column + 0][lane];
+				values[4 * column + 1] = world[3 * column + 1][lane];
+				values[4 * column + 2] = world[3 * column + 2][lane];
+				values[4 * column + 3] = (column == 3) ? 1.f : 0.f;
+			}
+		}
+	}
+}
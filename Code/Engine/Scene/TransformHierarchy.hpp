@@ -0,0 +1,114 @@
+#pragma once
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------
+class JobSystem;
+
+typedef int TransformID;
+constexpr TransformID INVALID_TRANSFORM_ID = -1;
+
+//------------------------------------------------------------------------------------------------------------------
+struct TransformHierarchyConfig
+{
+	JobSystem*	m_jobSystem = nullptr;
+};
+
+//------------------------------------------------------------------------------------------------------------------
+// Parent/child transforms with world matrices kept up to date in one batch per frame.
+//
+// Each transform has a local position, orientation and scale; its world matrix is its parent's world matrix times
+// translation * rotation (yaw about Z, then pitch about Y, then roll about X, as EulerAngles::GetAsMatrix_IFwd_JLeft_KUp)
+// * non-uniform scale. Roots use the identity as their parent.
+//
+// Local transforms live in parallel arrays sorted by depth, so every parent comes before its children. Setting a local
+// value marks that transform dirty; UpdateWorldMatrices then recomputes the world matrices of the dirty transforms and
+// everything under them, and nothing else, so a level full of static props costs one flag check each. Dirty transforms
+// of the same depth do not depend on each other: they are gathered a SIMD group at a time (8 on AVX2 builds, 4
+// otherwise) and, for big levels, split across the JobSystem.
+//
+// Creating a transform deeper than any existing one keeps the arrays sorted; anything else that changes the shape of
+// the tree (SetParent, DestroyTransform, creating a shallow transform after deep ones) re-sorts them on the next
+// update, which is O(n), so prefer building a scene top-down and reparenting rarely.
+//
+// GetWorldMatrix returns the matrix as of the last UpdateWorldMatrices.
+//------------------------------------------------------------------------------------------------------------------
+class TransformHierarchy
+{
+	friend class TransformHierarchyJob;
+
+public:
+	explicit TransformHierarchy(TransformHierarchyConfig const& config);
+	~TransformHierarchy() = default;
+
+	void				Startup();
+	void				Shutdown();
+	void				UpdateWorldMatrices();
+
+	TransformID			CreateTransform(TransformID parentID = INVALID_TRANSFORM_ID, Vec3 const& position = Vec3(), EulerAngles const& orientation = EulerAngles(), Vec3 const& scale = Vec3(1.f, 1.f, 1.f));
+	void				DestroyTransform(TransformID transformID);			// and every transform under it
+	void				DestroyAllTransforms();
+
+	bool				IsTransformValid(TransformID transformID) const;
+	TransformID			GetParent(TransformID transformID) const;
+	void				SetParent(TransformID transformID, TransformID parentID);	// keeps the local transform, so the world one moves
+
+	Vec3				GetLocalPosition(TransformID transformID) const;
+	EulerAngles			GetLocalOrientation(TransformID transformID) const;
+	Vec3				GetLocalScale(TransformID transformID) const;
+	void				SetLocalPosition(TransformID transformID, Vec3 const& position);
+	void				SetLocalOrientation(TransformID transformID, EulerAngles const& orientation);
+	void				SetLocalScale(TransformID transformID, Vec3 const& scale);
+	void				SetLocalTransform(TransformID transformID, Vec3 const& position, EulerAngles const& orientation, Vec3 const& scale);
+
+	Mat44 const&		GetWorldMatrix(TransformID transformID) const;
+	Vec3				GetWorldPosition(TransformID transformID) const;
+
+	int					GetNumTransforms() const					{ return static_cast<int>(m_denseIndexes.size() - m_freeIDs.size()); }
+	int					GetNumWorldMatricesUpdated() const			{ return m_numWorldMatricesUpdated; }	// by the last update
+
+private:
+	int					GetDenseIndex(TransformID transformID) const;
+	void				MarkLocalDirty(int transformIndex);
+	void				DestroyOrphanedTransforms();
+	void				SortByDepth();
+	void				GatherDirtyTransforms();
+	void				RunJobRanges(std::vector<int> const& rangeStarts);
+	void				UpdateWorldMatrixRange(int firstDirty, int endDirty);
+
+private:
+	TransformHierarchyConfig		m_config;
+
+	// transforms, by dense index; destroyed ones keep their slot, with an invalid ID, until the next sort
+	std::vector<TransformID>		m_transformIDs;
+	std::vector<int>				m_parents;					// dense indexes, -1 for roots
+	std::vector<int>				m_depths;
+	std::vector<float>				m_positionX;
+	std::vector<float>				m_positionY;
+	std::vector<float>				m_positionZ;
+	std::vector<float>				m_yawDegrees;
+	std::vector<float>				m_pitchDegrees;
+	std::vector<float>				m_rollDegrees;
+	std::vector<float>				m_scaleX;
+	std::vector<float>				m_scaleY;
+	std::vector<float>				m_scaleZ;
+	std::vector<unsigned char>		m_isLocalDirty;
+	std::vector<unsigned char>		m_isWorldDirty;
+	std::vector<Mat44>				m_worldMatrices;
+
+	// transform ID -> dense index, -1 for destroyed IDs waiting in m_freeIDs
+	std::vector<int>				m_denseIndexes;
+	std::vector<TransformID>		m_freeIDs;
+
+	bool							m_isOrderDirty = false;		// the arrays need sorting by depth again
+	bool							m_hasDirtyTransforms = false;
+	int								m_numWorldMatricesUpdated = 0;
+
+	// per-update scratch: m_dirtyIndexes[m_dirtyLevelStarts[d], m_dirtyLevelStarts[d + 1]) share one depth
+	std::vector<int>				m_dirtyIndexes;
+	std::vector<int>				m_dirtyLevelStarts;
+	std::vector<int>				m_rangeStarts;
+};